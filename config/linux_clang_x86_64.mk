@@ -19,7 +19,7 @@ include config/x86-64-flags.mk
 # -mbranch-cost=5
 
 CPPFLAGS+=-march=haswell -mtune=skylake
-CPPFLAGS+=-DFD_HAS_INT128=1 -DFD_HAS_DOUBLE=1 -DFD_HAS_ALLOCA=1 -DFD_HAS_X86=1 -DFD_HAS_SSE=1 -DFD_HAS_AVX=1
+CPPFLAGS+=-DFD_HAS_INT128=1 -DFD_HAS_DOUBLE=1 -DFD_HAS_ALLOCA=1 -DFD_HAS_X86=1 -DFD_HAS_SSE=1 -DFD_HAS_AVX=1 -DFD_HAS_AESNI=1
 
 FD_HAS_INT128:=1
 FD_HAS_DOUBLE:=1
@@ -27,4 +27,5 @@ FD_HAS_ALLOCA:=1
 FD_HAS_X86:=1
 FD_HAS_SSE:=1
 FD_HAS_AVX:=1
+FD_HAS_AESNI:=1
 
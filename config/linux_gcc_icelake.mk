@@ -11,7 +11,7 @@ include config/with-openssl.mk
 CPPFLAGS+=-fomit-frame-pointer -falign-functions=32 -falign-jumps=32 -falign-labels=32 -falign-loops=32 \
           -march=icelake-server -mtune=icelake-server -mfpmath=sse -mbranch-cost=5 \
 	  -DFD_HAS_INT128=1 -DFD_HAS_DOUBLE=1 -DFD_HAS_ALLOCA=1 -DFD_HAS_X86=1 -DFD_HAS_SSE=1 -DFD_HAS_AVX=1 \
-		-DFD_HAS_SHANI=1 -DFD_HAS_GFNI=1
+		-DFD_HAS_SHANI=1 -DFD_HAS_GFNI=1 -DFD_HAS_AVX512=1 -DFD_HAS_AESNI=1
 
 FD_HAS_INT128:=1
 FD_HAS_DOUBLE:=1
@@ -21,3 +21,5 @@ FD_HAS_SSE:=1
 FD_HAS_AVX:=1
 FD_HAS_SHANI:=1
 FD_HAS_GFNI:=1
+FD_HAS_AESNI:=1
+FD_HAS_AVX512:=1
@@ -280,6 +280,7 @@ static void parse_key_value( config_t *   config,
 
   ENTRY_UINT  ( ., tiles.verify,        receive_buffer_size                                       );
   ENTRY_UINT  ( ., tiles.verify,        mtu                                                       );
+  ENTRY_UINT  ( ., tiles.verify,        signature_cache_size                                      );
 
   ENTRY_UINT  ( ., tiles.pack,          max_pending_transactions                                  );
 
@@ -143,6 +143,7 @@ typedef struct {
     struct {
       uint receive_buffer_size;
       uint mtu;
+      uint signature_cache_size;
     } verify;
 
     struct {
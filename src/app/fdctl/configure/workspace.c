@@ -269,7 +269,8 @@ init( config_t * const config ) {
         ulong1 ( pod, "initial_rx_max_stream_data", 1<<15 );
         break;
       case wksp_verify:
-        cnc( pod, "cnc" );
+        cnc   ( pod, "cnc" );
+        tcache( pod, "tcache", config->tiles.verify.signature_cache_size );
         break;
       case wksp_dedup:
         cnc   ( pod, "cnc",    pod, wksp );
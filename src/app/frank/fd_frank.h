@@ -14,8 +14,13 @@
      BACKP_CNT is same as standard BACKP_CNT
 
      {HA,SV}_FILT_{CNT,SZ} is frank specific and the number of times a
-     transaction was dropped by a verify tile due to failing signature
-     verification. */
+     transaction was dropped by a verify tile due to being a duplicate
+     (HA) or failing signature verification (SV).
+
+     SIG_{PASS,FAIL,DUP}_CNT is frank specific and the number of
+     signatures seen by a verify tile that passed verification, failed
+     verification and were not verified because their transaction was a
+     duplicate respectively. */
 
 #define FD_FRANK_CNC_DIAG_IN_BACKP    FD_CNC_DIAG_IN_BACKP  /* ==0 */
 #define FD_FRANK_CNC_DIAG_BACKP_CNT   FD_CNC_DIAG_BACKP_CNT /* ==1 */
@@ -23,6 +28,9 @@
 #define FD_FRANK_CNC_DIAG_HA_FILT_SZ  (3UL)                 /* " */
 #define FD_FRANK_CNC_DIAG_SV_FILT_CNT (4UL)                 /* ", ideally never */
 #define FD_FRANK_CNC_DIAG_SV_FILT_SZ  (5UL)                 /* " */
+#define FD_FRANK_CNC_DIAG_SIG_PASS_CNT (6UL)                /* updated by verify tile, frequently */
+#define FD_FRANK_CNC_DIAG_SIG_FAIL_CNT (7UL)                /* ", ideally never */
+#define FD_FRANK_CNC_DIAG_SIG_DUP_CNT  (8UL)                /* ", frequently in ha situations, never o.w. */
 
 typedef struct {
    char *        app_name;
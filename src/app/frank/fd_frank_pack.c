@@ -144,6 +144,11 @@ run( fd_frank_args_t * args ) {
   /* Skip bank 0 */
   for( ulong i=0UL; i<bank_cnt; i++ ) join_out( out+i, args->out_pod, i+1UL );
 
+  /* Per bank scheduling arguments and results */
+  ulong        bank_cus      [ FD_FRANK_PACK_MAX_OUT ];
+  fd_txn_p_t * microblock_dst[ FD_FRANK_PACK_MAX_OUT ];
+  ulong        schedule_cnt  [ FD_FRANK_PACK_MAX_OUT ];
+
 
   ulong max_txn_per_microblock = MAX_MICROBLOCK_SZ/sizeof(fd_txn_p_t);
 
@@ -173,6 +178,7 @@ run( fd_frank_args_t * args ) {
 
 
   fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_laddr, pack_depth, gap, max_txn_per_microblock, rng ) );
+  if( FD_UNLIKELY( bank_cnt>fd_pack_gap( pack ) ) ) FD_LOG_ERR(( "pack min-gap %lu smaller than bank count %lu", gap, bank_cnt ));
 
 
   FD_LOG_INFO(( "packing blocks of at most %lu transactions with a parallelism of %lu", max_txn_per_microblock, gap ));
@@ -247,25 +253,27 @@ run( fd_frank_args_t * args ) {
       block_end += block_duration_ticks;
     }
 
-    /* Is it time to schedule the next microblock? */
-    /* for each banking thread, if it has credits */
+    /* Is it time to schedule the next microblocks?  Schedule one for
+       each banking thread that has credits, all at once. */
     for( ulong i=0UL; i<bank_cnt; i++ ) {
       out_state * o = out+i;
-      if( FD_LIKELY( o->out_cr_avail>0UL ) ) { /* optimize for the case we send a microblock */
-        void * microblock_dst = fd_chunk_to_laddr( wksp, o->out_chunk );
-        ulong schedule_cnt = fd_pack_schedule_next_microblock( pack, cus_per_microblock, vote_fraction, microblock_dst );
-        if( FD_LIKELY( schedule_cnt ) ) {
-          ulong tspub  = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
-          ulong chunk  = o->out_chunk;
-          ulong sig    = 0UL;
-          ulong msg_sz = schedule_cnt*sizeof(fd_txn_p_t);
-
-          fd_mcache_publish( o->out_mcache, o->out_depth, o->out_seq, sig, chunk, msg_sz, ctl, 0UL, tspub );
-
-          o->out_chunk = fd_dcache_compact_next( o->out_chunk, msg_sz, o->out_chunk0, o->out_wmark );
-          o->out_seq   = fd_seq_inc( o->out_seq, 1UL );
-          o->out_cr_avail--;
-        }
+      bank_cus      [ i ] = fd_ulong_if( o->out_cr_avail>0UL, cus_per_microblock, 0UL );
+      microblock_dst[ i ] = fd_chunk_to_laddr( wksp, o->out_chunk );
+    }
+    if( FD_LIKELY( fd_pack_schedule_next_microblocks( pack, bank_cnt, bank_cus, vote_fraction, microblock_dst, schedule_cnt ) ) ) {
+      ulong tspub = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
+      for( ulong i=0UL; i<bank_cnt; i++ ) {
+        if( FD_UNLIKELY( !schedule_cnt[ i ] ) ) continue;
+        out_state * o = out+i;
+        ulong chunk  = o->out_chunk;
+        ulong sig    = 0UL;
+        ulong msg_sz = schedule_cnt[ i ]*sizeof(fd_txn_p_t);
+
+        fd_mcache_publish( o->out_mcache, o->out_depth, o->out_seq, sig, chunk, msg_sz, ctl, 0UL, tspub );
+
+        o->out_chunk = fd_dcache_compact_next( o->out_chunk, msg_sz, o->out_chunk0, o->out_wmark );
+        o->out_seq   = fd_seq_inc( o->out_seq, 1UL );
+        o->out_cr_avail--;
       }
     }
     /* Normally, we have an "else, do housekeeping next iteration"
@@ -300,17 +308,18 @@ run( fd_frank_args_t * args ) {
     ulong         sz           = (ulong)mline->sz;
     uchar const * dcache_entry = fd_chunk_to_laddr_const( wksp, mline->chunk );
     ulong         mline_sig    = mline->sig;
-    /* Assume that the dcache entry is:
-         Payload ....... (payload_sz bytes)
-         0 or 1 byte of padding (since alignof(fd_txn) is 2)
-         fd_txn ....... (size computed by fd_txn_footprint)
-         payload_sz  (2B)
-      mline->sz includes all three fields and the padding */
-    ulong payload_sz = *(ushort*)(dcache_entry + sz - sizeof(ushort));
+    /* The dcache entry is a parsed transaction frag (see
+       fd_disco_base.h), so the parsed txn is copied as is.  mline->sz
+       includes the payload, the padding, the fd_txn_t and the trailer,
+       which gives the size of the fd_txn_t without needing to look
+       inside it. */
+    ulong payload_sz = fd_disco_txn_frag_payload_sz( dcache_entry, sz ); /* 0 if not a parsed txn frag */
+    ulong txn_sz     = fd_ulong_if( !!payload_sz, fd_disco_txn_frag_txn_sz( sz, payload_sz ), 0UL );
     uchar    const * payload = dcache_entry;
-    fd_txn_t const * txn     = (fd_txn_t const *)( dcache_entry + fd_ulong_align_up( payload_sz, 2UL ) );
-    fd_memcpy( slot->payload, payload, payload_sz                                                     );
-    fd_memcpy( TXN(slot),     txn,     fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
+    fd_txn_t const * txn     = fd_disco_txn_frag_txn( dcache_entry, payload_sz );
+    fd_memcpy( slot->payload, payload, payload_sz );
+    slot->payload_sz = payload_sz;
+    fd_memcpy( TXN(slot),     txn,     txn_sz     );
     slot->meta = mline_sig;
 
 #if DETAILED_LOGGING
@@ -328,6 +337,13 @@ run( fd_frank_args_t * args ) {
       continue;
     }
 
+    if( FD_UNLIKELY( !payload_sz ) ) { /* Not overrun but not a parsed txn frag either, skip it */
+      fd_pack_insert_txn_cancel( pack, slot );
+      seq   = fd_seq_inc( seq, 1UL );
+      mline = mcache + fd_mcache_line_idx( seq, depth );
+      continue;
+    }
+
     /* Non-speculative pack operations */
     accum_pub_cnt++;
     accum_pub_sz += sz;
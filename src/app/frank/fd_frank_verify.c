@@ -6,6 +6,65 @@
 #include <sys/stat.h>
 #include <linux/unistd.h>
 
+/* verify_prefilter gathers the ha dedup tags of the (up to
+   FD_TCACHE_QUERY_BATCH_MAX) consecutive frags starting at seq that
+   are ready in the in mcache.  The frags are read in place in the in
+   dcache (i.e. without copying them).  On return, tag[i] is the tag of
+   frag seq+i (FD_TCACHE_TAG_NULL if frag seq+i can't be prefiltered,
+   e.g. it is a dummy frag or doesn't look like a transaction), and
+   sz[i], payload_sz[i] and sig_cnt[i] are its frag size, transaction
+   payload size and number of signatures.  Returns the number of frags
+   gathered.  Gathering stops at the first frag that is not ready yet
+   or that was overrun while being read. */
+
+static ulong
+verify_prefilter( fd_frag_meta_t const * mcache,
+                  ulong                  depth,
+                  fd_wksp_t *            wksp,
+                  ulong                  seq,
+                  ulong *                tag,
+                  ulong *                sz,
+                  ulong *                payload_sz,
+                  ulong *                sig_cnt ) {
+  ulong cnt = 0UL;
+  for( ; cnt<FD_TCACHE_QUERY_BATCH_MAX; cnt++ ) {
+    ulong                  seq_i = fd_seq_inc( seq, cnt );
+    fd_frag_meta_t const * mline = mcache + fd_mcache_line_idx( seq_i, depth );
+
+    __m128i seq_sig = fd_frag_meta_seq_sig_query( mline );
+    if( fd_seq_ne( fd_frag_meta_sse0_seq( seq_sig ), seq_i ) ) break; /* not ready yet or overrun */
+
+    ulong tag_i        = FD_TCACHE_TAG_NULL;
+    ulong sz_i         = (ulong)mline->sz;
+    ulong payload_sz_i = 0UL;
+    ulong sig_cnt_i    = 0UL;
+
+    /* Only look at bytes within the frag such that reading a frag that
+       is concurrently being overrun stays in bounds */
+    if( FD_LIKELY( !fd_frag_meta_sse0_sig( seq_sig ) ) ) {
+      uchar const * p = (uchar const *)fd_chunk_to_laddr_const( wksp, mline->chunk );
+      payload_sz_i = fd_disco_txn_frag_payload_sz( p, sz_i );
+      if( FD_LIKELY( payload_sz_i ) ) {
+        fd_txn_t const * txn     = fd_disco_txn_frag_txn( p, payload_sz_i );
+        ulong            sig_off = (ulong)FD_VOLATILE_CONST( txn->signature_off );
+        if( FD_LIKELY( sig_off + sizeof(ulong) <= payload_sz_i ) ) {
+          tag_i     = FD_LOAD( ulong, p + sig_off );
+          sig_cnt_i = (ulong)FD_VOLATILE_CONST( txn->signature_cnt );
+        }
+      }
+    }
+
+    /* Check that we weren't overrun while reading */
+    if( FD_UNLIKELY( fd_seq_ne( fd_frag_meta_seq_query( mline ), seq_i ) ) ) break;
+
+    tag       [ cnt ] = tag_i;
+    sz        [ cnt ] = sz_i;
+    payload_sz[ cnt ] = payload_sz_i;
+    sig_cnt   [ cnt ] = sig_cnt_i;
+  }
+  return cnt;
+}
+
 static void
 run( fd_frank_args_t * args ) {
   /*
@@ -92,6 +151,9 @@ run( fd_frank_args_t * args ) {
   FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ  ] ) = 0UL;
   FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT ] ) = 0UL;
   FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ  ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SIG_PASS_CNT ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SIG_FAIL_CNT ] ) = 0UL;
+  FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SIG_DUP_CNT  ] ) = 0UL;
   FD_COMPILER_MFENCE();
 
   FD_LOG_INFO(( "joining mcache%lu", args->tile_idx ));
@@ -154,11 +216,9 @@ run( fd_frank_args_t * args ) {
   fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
   if( FD_UNLIKELY( !rng ) ) FD_LOG_ERR(( "fd_rng_join failed" ));
 
-  /* FIXME: PROBABLY SHOULD PUT THIS IN WORKSPACE */
-# define TCACHE_DEPTH   (16UL) /* Should be ~1/2-1/4 MAP_CNT */
-# define TCACHE_MAP_CNT (64UL) /* Power of two */
-  uchar tcache_mem[ FD_TCACHE_FOOTPRINT( TCACHE_DEPTH, TCACHE_MAP_CNT ) ] __attribute__((aligned(FD_TCACHE_ALIGN)));
-  fd_tcache_t * tcache  = fd_tcache_join( fd_tcache_new( tcache_mem, TCACHE_DEPTH, TCACHE_MAP_CNT ) );
+  FD_LOG_INFO(( "joining tcache" ));
+  fd_tcache_t * tcache = fd_tcache_join( fd_wksp_pod_map( args->tile_pod, "tcache" ) );
+  if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_join failed" ));
   ulong   tcache_depth   = fd_tcache_depth       ( tcache );
   ulong   tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
   ulong * _tcache_sync   = fd_tcache_oldest_laddr( tcache );
@@ -168,12 +228,26 @@ run( fd_frank_args_t * args ) {
 
   ulong accum_ha_filt_cnt = 0UL; ulong accum_ha_filt_sz = 0UL;
 
+  /* Dedup prefilter batch: frags [pf_seq,pf_seq+pf_cnt) of the in
+     mcache have been looked up in the tcache, bit i of pf_dup is set if
+     frag pf_seq+i was found.  Starts empty. */
+  ulong pf_seq = vin_mcache_seq;
+  ulong pf_cnt = 0UL;
+  int   pf_dup = 0;
+  ulong pf_tag       [ FD_TCACHE_QUERY_BATCH_MAX ];
+  ulong pf_sz        [ FD_TCACHE_QUERY_BATCH_MAX ];
+  ulong pf_payload_sz[ FD_TCACHE_QUERY_BATCH_MAX ];
+  ulong pf_sig_cnt   [ FD_TCACHE_QUERY_BATCH_MAX ];
+
   fd_sha512_t _sha[1];
   fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
   if( FD_UNLIKELY( !sha ) ) FD_LOG_ERR(( "fd_sha512 join failed" ));
 
   ulong accum_sv_filt_cnt = 0UL; ulong accum_sv_filt_sz = 0UL;
 
+  ulong accum_sig_pass_cnt = 0UL; ulong accum_sig_fail_cnt = 0UL; ulong accum_sig_dup_cnt = 0UL;
+  int   sig_err[ FD_TXN_SIG_MAX ];
+
   /* Start verifying */
 
   FD_LOG_INFO(( "verify(%lu) run", args->tile_idx ));
@@ -182,10 +256,6 @@ run( fd_frank_args_t * args ) {
   long then = now;            /* Do housekeeping on first iteration of run loop */
   fd_cnc_signal( cnc, FD_CNC_SIGNAL_RUN );
 
-  ulong sigvfy_pass_cnt =0UL;
-  ulong sigvfy_fail_cnt =0UL;
-  (void)sigvfy_pass_cnt;
-  (void)sigvfy_fail_cnt;
   for(;;) {
 
     /* Do housekeeping at a low rate in the background */
@@ -228,11 +298,17 @@ run( fd_frank_args_t * args ) {
       FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ  ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_HA_FILT_SZ  ] ) + accum_ha_filt_sz;
       FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_CNT ] ) + accum_sv_filt_cnt;
       FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ  ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_SV_FILT_SZ  ] ) + accum_sv_filt_sz;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SIG_PASS_CNT ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_SIG_PASS_CNT ] ) + accum_sig_pass_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SIG_FAIL_CNT ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_SIG_FAIL_CNT ] ) + accum_sig_fail_cnt;
+      FD_VOLATILE( cnc_diag[ FD_FRANK_CNC_DIAG_SIG_DUP_CNT  ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_FRANK_CNC_DIAG_SIG_DUP_CNT  ] ) + accum_sig_dup_cnt;
       FD_COMPILER_MFENCE();
-      accum_ha_filt_cnt = 0UL;
-      accum_ha_filt_sz  = 0UL;
-      accum_sv_filt_cnt = 0UL;
-      accum_sv_filt_sz  = 0UL;
+      accum_ha_filt_cnt  = 0UL;
+      accum_ha_filt_sz   = 0UL;
+      accum_sv_filt_cnt  = 0UL;
+      accum_sv_filt_sz   = 0UL;
+      accum_sig_pass_cnt = 0UL;
+      accum_sig_fail_cnt = 0UL;
+      accum_sig_dup_cnt  = 0UL;
 
       /* Receive command-and-control signals */
       ulong s = fd_cnc_signal_query( cnc );
@@ -290,16 +366,72 @@ run( fd_frank_args_t * args ) {
 
     now = fd_tickcount();
 
+    /* Prefilter duplicates.  If this frag is not covered by the current
+       prefilter batch, look up the tags of this and the following ready
+       frags in the tcache all at once.  Replayed transactions are then
+       dropped here before being copied or verified.  Since the batch is
+       looked up before its frags are inserted, a frag found in the
+       tcache here is dropped even if inserting an earlier frag of the
+       batch evicted its tag in the meantime (and duplicates within the
+       batch are caught by the insert below). */
+    ulong pf_idx = (ulong)fd_seq_diff( vin_mcache_seq, pf_seq );
+    if( FD_UNLIKELY( pf_idx>=pf_cnt ) ) {
+      pf_seq = vin_mcache_seq;
+      pf_cnt = verify_prefilter( vin_mcache, vin_mcache_depth, vin_wksp, pf_seq, pf_tag, pf_sz, pf_payload_sz, pf_sig_cnt );
+      pf_dup = fd_tcache_query_batch( _tcache_map, tcache_map_cnt, pf_tag, pf_cnt );
+      pf_idx = 0UL;
+    }
+
+    if( FD_UNLIKELY( (pf_dup>>pf_idx) & 1 ) ) { /* optimize for the non dup case */
+      vin_accum_pub_cnt++;
+      vin_accum_pub_sz  += pf_sz[ pf_idx ];
+      accum_ha_filt_cnt++;
+      accum_ha_filt_sz  += pf_payload_sz[ pf_idx ];
+      accum_sig_dup_cnt += pf_sig_cnt   [ pf_idx ];
+
+      vin_mcache_seq = fd_seq_inc( vin_mcache_seq, 1UL );
+      vin_mline      = vin_mcache + fd_mcache_line_idx( vin_mcache_seq, vin_mcache_depth );
+      continue;
+    }
+
     /* At this point, we have started receiving frag seq with details in
-       mline at time now.  Speculatively processs it here. */
-    ulong vin_data_sz    = (ulong)vin_mline->sz;
-    uchar *  vin_dcache_chunk_laddr = (uchar *)fd_chunk_to_laddr( vin_wksp, vin_mline->chunk );
-    uchar *  udp_payload = (uchar *)fd_chunk_to_laddr( wksp, chunk );
-    memcpy(udp_payload, vin_dcache_chunk_laddr, vin_data_sz);
-
-    /* Check that we weren't overrun while processing */
-    vin_seq_found = fd_frag_meta_seq_query( vin_mline );
-    if( FD_UNLIKELY( fd_seq_ne( vin_seq_found, vin_mcache_seq ) ) ) {
+       mline at time now.  The frag is a parsed transaction frag (see
+       fd_disco_base.h), so the txn doesn't need to be parsed again.
+       Speculatively process it here, in place in the in dcache.  Only
+       transactions that pass verification get copied into the out
+       dcache.  Since the producer can overrun the frag while we are
+       looking at it, everything read from the frag is read once, bounds
+       checked against the frag size before use and only trusted once we
+       have checked we weren't overrun. */
+    ulong                  vin_frag_seq   = vin_mcache_seq;
+    fd_frag_meta_t const * vin_frag_mline = vin_mline;
+
+    ulong         vin_data_sz = (ulong)vin_mline->sz;
+    uchar const * udp_payload = (uchar const *)fd_chunk_to_laddr_const( vin_wksp, vin_mline->chunk );
+
+    ulong payload_sz = fd_disco_txn_frag_payload_sz( udp_payload, vin_data_sz );
+    ulong sig_cnt    = 0UL;
+    ulong sig_off    = 0UL;
+    ulong acct_off   = 0UL;
+    ulong msg_off    = 0UL;
+    ulong ha_tag     = FD_TCACHE_TAG_NULL;
+    int   txn_ok     = 0;
+    if( FD_LIKELY( payload_sz ) ) {
+      fd_txn_t const * txn = fd_disco_txn_frag_txn( udp_payload, payload_sz );
+      sig_cnt  = (ulong)FD_VOLATILE_CONST( txn->signature_cnt );
+      sig_off  = (ulong)FD_VOLATILE_CONST( txn->signature_off );
+      acct_off = (ulong)FD_VOLATILE_CONST( txn->acct_addr_off );
+      msg_off  = (ulong)FD_VOLATILE_CONST( txn->message_off   );
+      txn_ok   = (!!sig_cnt) & (sig_cnt<=FD_TXN_SIG_MAX) & /* sig_err has room for FD_TXN_SIG_MAX */
+                 (sig_off  + sig_cnt*FD_TXN_SIGNATURE_SZ <= payload_sz) &
+                 (acct_off + sig_cnt*FD_TXN_ACCT_ADDR_SZ <= payload_sz) &
+                 (msg_off                                <= payload_sz);
+      if( FD_LIKELY( txn_ok ) ) ha_tag = FD_LOAD( ulong, udp_payload + sig_off );
+    }
+
+    /* Check that we weren't overrun while parsing */
+    vin_seq_found = fd_frag_meta_seq_query( vin_frag_mline );
+    if( FD_UNLIKELY( fd_seq_ne( vin_seq_found, vin_frag_seq ) ) ) {
       vin_accum_ovrnr_cnt++;
       FD_LOG_INFO(( "verifyin.%lu ovrnr encountered:   vin_mcache_seq=%lu   vin_seq_found=%lu   vin_accum_ovrnr_cnt=%lu", args->tile_idx, vin_mcache_seq, vin_seq_found, vin_accum_ovrnr_cnt ));
       vin_mcache_seq = vin_seq_found;
@@ -314,13 +446,17 @@ run( fd_frank_args_t * args ) {
     vin_mcache_seq   = fd_seq_inc( vin_mcache_seq, 1UL );
     vin_mline = vin_mcache + fd_mcache_line_idx( vin_mcache_seq, vin_mcache_depth );
 
-    ushort payload_sz = *(ushort*) (udp_payload + vin_data_sz - sizeof(ushort));
-    fd_txn_t * txn = (fd_txn_t*) fd_ulong_align_up( (ulong)(udp_payload) + payload_sz, 2UL );
+    if( FD_UNLIKELY( !txn_ok ) ) { /* Doesn't look like a transaction */
+      accum_sv_filt_cnt++;
+      accum_sv_filt_sz += payload_sz;
+      now = fd_tickcount();
+      continue;
+    }
 
-    ulong const * public_key = (ulong const *)(udp_payload + txn->acct_addr_off);
-    ulong const * sig        = (ulong const *)(udp_payload + txn->signature_off);
-    uchar const * msg        = (uchar const *)(udp_payload + txn->message_off);
-    ulong msg_sz             = (ulong)payload_sz - txn->message_off;
+    ulong const * public_key = (ulong const *)(udp_payload + acct_off);
+    ulong const * sig        = (ulong const *)(udp_payload + sig_off);
+    uchar const * msg        = (uchar const *)(udp_payload + msg_off);
+    ulong msg_sz             = payload_sz - msg_off;
 
     /* Sig is already effectively a cryptographically secure hash of
         public_key/private_key and message and sz.  So use this to do a
@@ -336,35 +472,65 @@ run( fd_frank_args_t * args ) {
         are not resigned continuously)  So we just mock this up for the
         time being. */
 
-    ulong ha_tag = *sig;
     int ha_dup;
     FD_TCACHE_INSERT( ha_dup, tcache_oldest, _tcache_ring, tcache_depth, _tcache_map, tcache_map_cnt, ha_tag );
     if( FD_UNLIKELY( ha_dup ) ) { /* optimize for the non dup case */
       accum_ha_filt_cnt++;
-      accum_ha_filt_sz += payload_sz; //WW accum_ha_filt_sz += msg_framing + msg_sz;
+      accum_ha_filt_sz  += payload_sz; //WW accum_ha_filt_sz += msg_framing + msg_sz;
+      accum_sig_dup_cnt += sig_cnt;
       now = fd_tickcount();
       continue;
     }
 
-    /* We appear to have a message to verify.  So verify it.
+    /* We appear to have a message to verify.  So verify it.  The
+       signatures are laid out back to back at signature_off and the
+       signer keys are the first signature_cnt account addresses, so
+       all signatures of the transaction are verified as one batch.
 
        When running synthetic load, the synthetic data will not fail
        at this point so we fake up some configurable rate of errors to
        stress out the monitoring.  (We could also slightly more
        expensively get the same effect by corrupting the udp_payload
-       region before the verify.) */
-
-    int err = fd_ed25519_verify( msg, msg_sz, sig, public_key, sha );
-    if (err) {
-      sigvfy_fail_cnt ++;
-      //FD_LOG_WARNING(( "fd_ed25519_verify failed for mcache[%lu], fail/pass: %lu/%lu",
-      //  vin_seq_found, sigvfy_fail_cnt, sigvfy_pass_cnt ));
+       region before the verify.)
+
+       If we get overrun while verifying, the result is meaningless.
+       This is detected below (a failure is only counted as such if we
+       weren't overrun). */
+
+    int err = fd_ed25519_verify_batch_single_msg( msg, msg_sz, sig, public_key, sig_cnt, sha, sig_err );
+    if( FD_UNLIKELY( err ) ) {
+      if( FD_UNLIKELY( fd_seq_ne( fd_frag_meta_seq_query( vin_frag_mline ), vin_frag_seq ) ) ) {
+        /* Nothing was forwarded (and ha_tag might not even be the
+           frag's real tag), so don't let it dedup retransmits */
+        fd_tcache_remove( _tcache_map, tcache_map_cnt, ha_tag );
+        vin_accum_ovrnr_cnt++;
+        now = fd_tickcount();
+        continue;
+      }
+      ulong sig_fail_cnt = 0UL;
+      for( ulong i=0UL; i<sig_cnt; i++ ) sig_fail_cnt += (ulong)!!sig_err[ i ];
+      accum_sig_pass_cnt += sig_cnt - sig_fail_cnt;
+      accum_sig_fail_cnt += sig_fail_cnt;
+      accum_sv_filt_cnt++;
+      accum_sv_filt_sz   += payload_sz;
       now = fd_tickcount();
       continue;
     }
-    else {
-      sigvfy_pass_cnt ++;
+
+    /* Copy the transaction into the out dcache and check that we
+       weren't overrun while verifying and copying, such that what we
+       forward is exactly what we verified. */
+
+    uchar * out_payload = (uchar *)fd_chunk_to_laddr( wksp, chunk );
+    fd_memcpy( out_payload, udp_payload, vin_data_sz );
+
+    if( FD_UNLIKELY( fd_seq_ne( fd_frag_meta_seq_query( vin_frag_mline ), vin_frag_seq ) ) ) {
+      fd_tcache_remove( _tcache_map, tcache_map_cnt, ha_tag ); /* As above */
+      vin_accum_ovrnr_cnt++;
+      now = fd_tickcount();
+      continue;
     }
+    accum_sig_pass_cnt += sig_cnt;
 
     /* Packet looks superficially good.  Forward it.  If somebody is
        opening multiple connections (which would potentially flow
@@ -0,0 +1,5 @@
+$(call add-hdrs,fd_aes.h)
+$(call add-objs,fd_aes,fd_ballet)
+
+$(call make-unit-test,test_aes,test_aes,fd_ballet fd_util)
+$(call run-unit-test,test_aes)
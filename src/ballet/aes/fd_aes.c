@@ -0,0 +1,534 @@
+#include "fd_aes.h"
+
+#if FD_HAS_AESNI
+#include <x86intrin.h>
+#endif
+
+/* Key expansion (FIPS 197 section 5.2).  This is done once per key so
+   the portable implementation is used on all targets (the AES-NI
+   key generation assist instructions are not any faster in practice
+   for the handful of round keys involved). */
+
+static uchar const fd_aes_sbox[ 256 ] = {
+  0x63,0x7c,0x77,0x7b,0xf2,0x6b,0x6f,0xc5,0x30,0x01,0x67,0x2b,0xfe,0xd7,0xab,0x76,
+  0xca,0x82,0xc9,0x7d,0xfa,0x59,0x47,0xf0,0xad,0xd4,0xa2,0xaf,0x9c,0xa4,0x72,0xc0,
+  0xb7,0xfd,0x93,0x26,0x36,0x3f,0xf7,0xcc,0x34,0xa5,0xe5,0xf1,0x71,0xd8,0x31,0x15,
+  0x04,0xc7,0x23,0xc3,0x18,0x96,0x05,0x9a,0x07,0x12,0x80,0xe2,0xeb,0x27,0xb2,0x75,
+  0x09,0x83,0x2c,0x1a,0x1b,0x6e,0x5a,0xa0,0x52,0x3b,0xd6,0xb3,0x29,0xe3,0x2f,0x84,
+  0x53,0xd1,0x00,0xed,0x20,0xfc,0xb1,0x5b,0x6a,0xcb,0xbe,0x39,0x4a,0x4c,0x58,0xcf,
+  0xd0,0xef,0xaa,0xfb,0x43,0x4d,0x33,0x85,0x45,0xf9,0x02,0x7f,0x50,0x3c,0x9f,0xa8,
+  0x51,0xa3,0x40,0x8f,0x92,0x9d,0x38,0xf5,0xbc,0xb6,0xda,0x21,0x10,0xff,0xf3,0xd2,
+  0xcd,0x0c,0x13,0xec,0x5f,0x97,0x44,0x17,0xc4,0xa7,0x7e,0x3d,0x64,0x5d,0x19,0x73,
+  0x60,0x81,0x4f,0xdc,0x22,0x2a,0x90,0x88,0x46,0xee,0xb8,0x14,0xde,0x5e,0x0b,0xdb,
+  0xe0,0x32,0x3a,0x0a,0x49,0x06,0x24,0x5c,0xc2,0xd3,0xac,0x62,0x91,0x95,0xe4,0x79,
+  0xe7,0xc8,0x37,0x6d,0x8d,0xd5,0x4e,0xa9,0x6c,0x56,0xf4,0xea,0x65,0x7a,0xae,0x08,
+  0xba,0x78,0x25,0x2e,0x1c,0xa6,0xb4,0xc6,0xe8,0xdd,0x74,0x1f,0x4b,0xbd,0x8b,0x8a,
+  0x70,0x3e,0xb5,0x66,0x48,0x03,0xf6,0x0e,0x61,0x35,0x57,0xb9,0x86,0xc1,0x1d,0x9e,
+  0xe1,0xf8,0x98,0x11,0x69,0xd9,0x8e,0x94,0x9b,0x1e,0x87,0xe9,0xce,0x55,0x28,0xdf,
+  0x8c,0xa1,0x89,0x0d,0xbf,0xe6,0x42,0x68,0x41,0x99,0x2d,0x0f,0xb0,0x54,0xbb,0x16
+};
+
+fd_aes_key_t *
+fd_aes_key_init( fd_aes_key_t * key,
+                 void const *   user_key,
+                 ulong          key_sz ) {
+  ulong nk;
+  switch( key_sz ) {
+  case FD_AES_128_KEY_SZ: nk = 4UL; break;
+  case FD_AES_256_KEY_SZ: nk = 8UL; break;
+  default: return NULL;
+  }
+  ulong rounds = nk + 6UL;
+
+  uchar * w    = key->rk[0]; /* Words of the key schedule, indexed [0,4*(rounds+1)) */
+  uchar   rcon = (uchar)1;
+  fd_memcpy( w, user_key, key_sz );
+  for( ulong i=nk; i<4UL*(rounds+1UL); i++ ) {
+    uchar t[4];
+    fd_memcpy( t, w + 4UL*(i-1UL), 4UL );
+    if( !(i%nk) ) {
+      uchar t0 = t[0];
+      t[0] = (uchar)(fd_aes_sbox[ t[1] ] ^ rcon);
+      t[1] = fd_aes_sbox[ t[2] ];
+      t[2] = fd_aes_sbox[ t[3] ];
+      t[3] = fd_aes_sbox[ t0   ];
+      rcon = (uchar)((rcon<<1) ^ ((rcon>>7)*0x1b));
+    } else if( (nk>6UL) & ((i%nk)==4UL) ) {
+      for( ulong j=0UL; j<4UL; j++ ) t[j] = fd_aes_sbox[ t[j] ];
+    }
+    for( ulong j=0UL; j<4UL; j++ ) w[ 4UL*i+j ] = (uchar)(w[ 4UL*(i-nk)+j ] ^ t[j]);
+  }
+  key->rounds = rounds;
+  return key;
+}
+
+/* Each implementation below provides:
+
+   fd_aes_private_block: encrypts one block.
+
+   fd_aes_private_ctr: xors the sz bytes at in with the GCM key stream
+   for iv starting at block counter ctr and writes the result to out.
+
+   fd_aes_gcm_private_hpow_init: computes gcm->hpow from H.
+
+   fd_aes_gcm_private_ghash: updates the GHASH state x (16 bytes, in the
+   implementation's representation, zero is zero in all) with the sz
+   bytes at data, zero padded to a multiple of 16 bytes.
+
+   fd_aes_gcm_private_ghash_out: converts x into the byte order of the
+   standard.  */
+
+#if FD_HAS_AESNI
+
+#define BSWAP_MASK _mm_setr_epi8( 15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0 )
+
+static inline __m128i
+fd_aes_private_block_aesni( __m128i const * rk,
+                            ulong           rounds,
+                            __m128i         b ) {
+  b = _mm_xor_si128( b, rk[0] );
+  for( ulong r=1UL; r<rounds; r++ ) b = _mm_aesenc_si128( b, rk[r] );
+  return _mm_aesenclast_si128( b, rk[rounds] );
+}
+
+static inline void
+fd_aes_private_block( fd_aes_key_t const * key,
+                      uchar *              out,
+                      uchar const *        in ) {
+  _mm_storeu_si128( (__m128i *)out,
+    fd_aes_private_block_aesni( (__m128i const *)key->rk, key->rounds, _mm_loadu_si128( (__m128i const *)in ) ) );
+}
+
+static void
+fd_aes_private_ctr( fd_aes_key_t const * key,
+                    uchar *              out,
+                    uchar const *        in,
+                    ulong                sz,
+                    uchar const *        iv,
+                    uint                 ctr ) {
+  __m128i const * rk     = (__m128i const *)key->rk;
+  ulong           rounds = key->rounds;
+
+  uchar _base[ 16 ] __attribute__((aligned(16)));
+  fd_memcpy( _base, iv, FD_AES_GCM_IV_SZ );
+  FD_STORE( uint, _base+12, 0U );
+  __m128i base = _mm_load_si128( (__m128i const *)_base );
+
+# define CTR_BLOCK(i) _mm_insert_epi32( base, (int)fd_uint_bswap( ctr+(uint)(i) ), 3 )
+
+  /* 8 blocks at a time to cover the latency of aesenc */
+
+  while( sz>=128UL ) {
+    __m128i b0 = _mm_xor_si128( CTR_BLOCK(0), rk[0] );
+    __m128i b1 = _mm_xor_si128( CTR_BLOCK(1), rk[0] );
+    __m128i b2 = _mm_xor_si128( CTR_BLOCK(2), rk[0] );
+    __m128i b3 = _mm_xor_si128( CTR_BLOCK(3), rk[0] );
+    __m128i b4 = _mm_xor_si128( CTR_BLOCK(4), rk[0] );
+    __m128i b5 = _mm_xor_si128( CTR_BLOCK(5), rk[0] );
+    __m128i b6 = _mm_xor_si128( CTR_BLOCK(6), rk[0] );
+    __m128i b7 = _mm_xor_si128( CTR_BLOCK(7), rk[0] );
+    for( ulong r=1UL; r<rounds; r++ ) {
+      __m128i k = rk[r];
+      b0 = _mm_aesenc_si128( b0, k ); b1 = _mm_aesenc_si128( b1, k );
+      b2 = _mm_aesenc_si128( b2, k ); b3 = _mm_aesenc_si128( b3, k );
+      b4 = _mm_aesenc_si128( b4, k ); b5 = _mm_aesenc_si128( b5, k );
+      b6 = _mm_aesenc_si128( b6, k ); b7 = _mm_aesenc_si128( b7, k );
+    }
+    __m128i k = rk[rounds];
+    b0 = _mm_aesenclast_si128( b0, k ); b1 = _mm_aesenclast_si128( b1, k );
+    b2 = _mm_aesenclast_si128( b2, k ); b3 = _mm_aesenclast_si128( b3, k );
+    b4 = _mm_aesenclast_si128( b4, k ); b5 = _mm_aesenclast_si128( b5, k );
+    b6 = _mm_aesenclast_si128( b6, k ); b7 = _mm_aesenclast_si128( b7, k );
+
+    __m128i const * s = (__m128i const *)in;
+    __m128i *       d = (__m128i *)out;
+    _mm_storeu_si128( d+0, _mm_xor_si128( b0, _mm_loadu_si128( s+0 ) ) );
+    _mm_storeu_si128( d+1, _mm_xor_si128( b1, _mm_loadu_si128( s+1 ) ) );
+    _mm_storeu_si128( d+2, _mm_xor_si128( b2, _mm_loadu_si128( s+2 ) ) );
+    _mm_storeu_si128( d+3, _mm_xor_si128( b3, _mm_loadu_si128( s+3 ) ) );
+    _mm_storeu_si128( d+4, _mm_xor_si128( b4, _mm_loadu_si128( s+4 ) ) );
+    _mm_storeu_si128( d+5, _mm_xor_si128( b5, _mm_loadu_si128( s+5 ) ) );
+    _mm_storeu_si128( d+6, _mm_xor_si128( b6, _mm_loadu_si128( s+6 ) ) );
+    _mm_storeu_si128( d+7, _mm_xor_si128( b7, _mm_loadu_si128( s+7 ) ) );
+
+    ctr += 8U; in += 128UL; out += 128UL; sz -= 128UL;
+  }
+
+  while( sz>=16UL ) {
+    __m128i b = fd_aes_private_block_aesni( rk, rounds, CTR_BLOCK(0) );
+    _mm_storeu_si128( (__m128i *)out, _mm_xor_si128( b, _mm_loadu_si128( (__m128i const *)in ) ) );
+    ctr++; in += 16UL; out += 16UL; sz -= 16UL;
+  }
+
+  if( sz ) {
+    uchar ks[ 16 ] __attribute__((aligned(16)));
+    _mm_store_si128( (__m128i *)ks, fd_aes_private_block_aesni( rk, rounds, CTR_BLOCK(0) ) );
+    for( ulong i=0UL; i<sz; i++ ) out[i] = (uchar)(in[i] ^ ks[i]);
+  }
+
+# undef CTR_BLOCK
+}
+
+/* GHASH is computed on byte reflected blocks such that multiplication
+   in GF(2^128) maps onto PCLMULQDQ (see Gueron and Kounavis, "Intel
+   Carry-Less Multiplication Instruction and its Usage for Computing the
+   GCM Mode").  Products are accumulated unreduced as (lo,mid,hi) and
+   reduced once per group of blocks. */
+
+static inline void
+fd_aes_gcm_private_clmul_acc( __m128i   a,
+                              __m128i   b,
+                              __m128i * lo,
+                              __m128i * mid,
+                              __m128i * hi ) {
+  *lo  = _mm_xor_si128( *lo,  _mm_clmulepi64_si128( a, b, 0x00 ) );
+  *hi  = _mm_xor_si128( *hi,  _mm_clmulepi64_si128( a, b, 0x11 ) );
+  *mid = _mm_xor_si128( *mid, _mm_xor_si128( _mm_clmulepi64_si128( a, b, 0x10 ), _mm_clmulepi64_si128( a, b, 0x01 ) ) );
+}
+
+static inline __m128i
+fd_aes_gcm_private_reduce( __m128i lo,
+                           __m128i mid,
+                           __m128i hi ) {
+  __m128i t3 = _mm_xor_si128( lo, _mm_slli_si128( mid, 8 ) );
+  __m128i t6 = _mm_xor_si128( hi, _mm_srli_si128( mid, 8 ) );
+
+  /* Shift the 256-bit product left by one (reflection) */
+
+  __m128i t7 = _mm_srli_epi32( t3, 31 );
+  __m128i t8 = _mm_srli_epi32( t6, 31 );
+  t3 = _mm_slli_epi32( t3, 1 );
+  t6 = _mm_slli_epi32( t6, 1 );
+  __m128i t9 = _mm_srli_si128( t7, 12 );
+  t8 = _mm_slli_si128( t8, 4 );
+  t7 = _mm_slli_si128( t7, 4 );
+  t3 = _mm_or_si128( t3, t7 );
+  t6 = _mm_or_si128( _mm_or_si128( t6, t8 ), t9 );
+
+  /* Reduce modulo x^128 + x^7 + x^2 + x + 1 */
+
+  t7 = _mm_xor_si128( _mm_xor_si128( _mm_slli_epi32( t3, 31 ), _mm_slli_epi32( t3, 30 ) ), _mm_slli_epi32( t3, 25 ) );
+  t8 = _mm_srli_si128( t7, 4 );
+  t7 = _mm_slli_si128( t7, 12 );
+  t3 = _mm_xor_si128( t3, t7 );
+  __m128i t2 = _mm_xor_si128( _mm_xor_si128( _mm_srli_epi32( t3, 1 ), _mm_srli_epi32( t3, 2 ) ), _mm_srli_epi32( t3, 7 ) );
+  t2 = _mm_xor_si128( t2, t8 );
+  t3 = _mm_xor_si128( t3, t2 );
+  return _mm_xor_si128( t6, t3 );
+}
+
+static inline __m128i
+fd_aes_gcm_private_gfmul( __m128i a,
+                          __m128i b ) {
+  __m128i lo = _mm_setzero_si128(); __m128i mid = lo; __m128i hi = lo;
+  fd_aes_gcm_private_clmul_acc( a, b, &lo, &mid, &hi );
+  return fd_aes_gcm_private_reduce( lo, mid, hi );
+}
+
+static void
+fd_aes_gcm_private_hpow_init( fd_aes_gcm_t * gcm,
+                              uchar const *  h ) {
+  __m128i * hpow = (__m128i *)gcm->hpow;
+  __m128i   h1   = _mm_shuffle_epi8( _mm_loadu_si128( (__m128i const *)h ), BSWAP_MASK );
+  __m128i   hn   = h1;
+  hpow[0] = h1;
+  for( ulong i=1UL; i<FD_AES_GCM_PRIVATE_HPOW_CNT; i++ ) {
+    hn      = fd_aes_gcm_private_gfmul( hn, h1 );
+    hpow[i] = hn;
+  }
+}
+
+static void
+fd_aes_gcm_private_ghash( fd_aes_gcm_t const * gcm,
+                          uchar *              _x,
+                          uchar const *        data,
+                          ulong                sz ) {
+  __m128i const * hpow = (__m128i const *)gcm->hpow;
+  __m128i         bswap = BSWAP_MASK;
+  __m128i         x     = _mm_load_si128( (__m128i const *)_x );
+
+  /* 8 blocks per reduction: x' = (x+b0) H^8 + b1 H^7 + ... + b7 H */
+
+  while( sz>=128UL ) {
+    __m128i const * s = (__m128i const *)data;
+    __m128i lo = _mm_setzero_si128(); __m128i mid = lo; __m128i hi = lo;
+    fd_aes_gcm_private_clmul_acc( _mm_xor_si128( x, _mm_shuffle_epi8( _mm_loadu_si128( s+0 ), bswap ) ), hpow[7], &lo, &mid, &hi );
+    fd_aes_gcm_private_clmul_acc( _mm_shuffle_epi8( _mm_loadu_si128( s+1 ), bswap ), hpow[6], &lo, &mid, &hi );
+    fd_aes_gcm_private_clmul_acc( _mm_shuffle_epi8( _mm_loadu_si128( s+2 ), bswap ), hpow[5], &lo, &mid, &hi );
+    fd_aes_gcm_private_clmul_acc( _mm_shuffle_epi8( _mm_loadu_si128( s+3 ), bswap ), hpow[4], &lo, &mid, &hi );
+    fd_aes_gcm_private_clmul_acc( _mm_shuffle_epi8( _mm_loadu_si128( s+4 ), bswap ), hpow[3], &lo, &mid, &hi );
+    fd_aes_gcm_private_clmul_acc( _mm_shuffle_epi8( _mm_loadu_si128( s+5 ), bswap ), hpow[2], &lo, &mid, &hi );
+    fd_aes_gcm_private_clmul_acc( _mm_shuffle_epi8( _mm_loadu_si128( s+6 ), bswap ), hpow[1], &lo, &mid, &hi );
+    fd_aes_gcm_private_clmul_acc( _mm_shuffle_epi8( _mm_loadu_si128( s+7 ), bswap ), hpow[0], &lo, &mid, &hi );
+    x = fd_aes_gcm_private_reduce( lo, mid, hi );
+    data += 128UL; sz -= 128UL;
+  }
+
+  while( sz>=16UL ) {
+    x = fd_aes_gcm_private_gfmul( _mm_xor_si128( x, _mm_shuffle_epi8( _mm_loadu_si128( (__m128i const *)data ), bswap ) ), hpow[0] );
+    data += 16UL; sz -= 16UL;
+  }
+
+  if( sz ) {
+    uchar last[ 16 ] __attribute__((aligned(16)));
+    _mm_store_si128( (__m128i *)last, _mm_setzero_si128() );
+    fd_memcpy( last, data, sz );
+    x = fd_aes_gcm_private_gfmul( _mm_xor_si128( x, _mm_shuffle_epi8( _mm_load_si128( (__m128i const *)last ), bswap ) ), hpow[0] );
+  }
+
+  _mm_store_si128( (__m128i *)_x, x );
+}
+
+static inline void
+fd_aes_gcm_private_ghash_out( uchar *       out,
+                              uchar const * x ) {
+  _mm_storeu_si128( (__m128i *)out, _mm_shuffle_epi8( _mm_load_si128( (__m128i const *)x ), BSWAP_MASK ) );
+}
+
+void
+fd_aes_ecb_encrypt_batch( fd_aes_key_t const * const * key,
+                          void const *         const * in,
+                          void *               const * out,
+                          ulong                        cnt ) {
+  ulong i = 0UL;
+
+  /* Groups of 8 blocks whose keys have the same number of rounds are
+     computed interleaved (the round keys can differ per block). */
+
+  for( ; i+8UL<=cnt; i+=8UL ) {
+    ulong rounds = key[i]->rounds;
+    int   same   = 1;
+    for( ulong j=1UL; j<8UL; j++ ) same &= (key[i+j]->rounds==rounds);
+    if( FD_UNLIKELY( !same ) ) {
+      for( ulong j=0UL; j<8UL; j++ ) fd_aes_private_block( key[i+j], (uchar *)out[i+j], (uchar const *)in[i+j] );
+      continue;
+    }
+
+    __m128i const * k0 = (__m128i const *)key[i+0]->rk; __m128i const * k1 = (__m128i const *)key[i+1]->rk;
+    __m128i const * k2 = (__m128i const *)key[i+2]->rk; __m128i const * k3 = (__m128i const *)key[i+3]->rk;
+    __m128i const * k4 = (__m128i const *)key[i+4]->rk; __m128i const * k5 = (__m128i const *)key[i+5]->rk;
+    __m128i const * k6 = (__m128i const *)key[i+6]->rk; __m128i const * k7 = (__m128i const *)key[i+7]->rk;
+
+    __m128i b0 = _mm_xor_si128( _mm_loadu_si128( (__m128i const *)in[i+0] ), k0[0] );
+    __m128i b1 = _mm_xor_si128( _mm_loadu_si128( (__m128i const *)in[i+1] ), k1[0] );
+    __m128i b2 = _mm_xor_si128( _mm_loadu_si128( (__m128i const *)in[i+2] ), k2[0] );
+    __m128i b3 = _mm_xor_si128( _mm_loadu_si128( (__m128i const *)in[i+3] ), k3[0] );
+    __m128i b4 = _mm_xor_si128( _mm_loadu_si128( (__m128i const *)in[i+4] ), k4[0] );
+    __m128i b5 = _mm_xor_si128( _mm_loadu_si128( (__m128i const *)in[i+5] ), k5[0] );
+    __m128i b6 = _mm_xor_si128( _mm_loadu_si128( (__m128i const *)in[i+6] ), k6[0] );
+    __m128i b7 = _mm_xor_si128( _mm_loadu_si128( (__m128i const *)in[i+7] ), k7[0] );
+    for( ulong r=1UL; r<rounds; r++ ) {
+      b0 = _mm_aesenc_si128( b0, k0[r] ); b1 = _mm_aesenc_si128( b1, k1[r] );
+      b2 = _mm_aesenc_si128( b2, k2[r] ); b3 = _mm_aesenc_si128( b3, k3[r] );
+      b4 = _mm_aesenc_si128( b4, k4[r] ); b5 = _mm_aesenc_si128( b5, k5[r] );
+      b6 = _mm_aesenc_si128( b6, k6[r] ); b7 = _mm_aesenc_si128( b7, k7[r] );
+    }
+    _mm_storeu_si128( (__m128i *)out[i+0], _mm_aesenclast_si128( b0, k0[rounds] ) );
+    _mm_storeu_si128( (__m128i *)out[i+1], _mm_aesenclast_si128( b1, k1[rounds] ) );
+    _mm_storeu_si128( (__m128i *)out[i+2], _mm_aesenclast_si128( b2, k2[rounds] ) );
+    _mm_storeu_si128( (__m128i *)out[i+3], _mm_aesenclast_si128( b3, k3[rounds] ) );
+    _mm_storeu_si128( (__m128i *)out[i+4], _mm_aesenclast_si128( b4, k4[rounds] ) );
+    _mm_storeu_si128( (__m128i *)out[i+5], _mm_aesenclast_si128( b5, k5[rounds] ) );
+    _mm_storeu_si128( (__m128i *)out[i+6], _mm_aesenclast_si128( b6, k6[rounds] ) );
+    _mm_storeu_si128( (__m128i *)out[i+7], _mm_aesenclast_si128( b7, k7[rounds] ) );
+  }
+
+  for( ; i<cnt; i++ ) fd_aes_private_block( key[i], (uchar *)out[i], (uchar const *)in[i] );
+}
+
+#undef BSWAP_MASK
+
+#else /* Portable reference implementation */
+
+static inline uchar fd_aes_private_xtime( uchar a ) { return (uchar)((a<<1) ^ ((a>>7)*0x1b)); }
+
+static void
+fd_aes_private_block( fd_aes_key_t const * key,
+                      uchar *              out,
+                      uchar const *        in ) {
+  ulong rounds = key->rounds;
+  uchar s[ 16 ];
+  for( ulong i=0UL; i<16UL; i++ ) s[i] = (uchar)(in[i] ^ key->rk[0][i]);
+  for( ulong r=1UL; r<=rounds; r++ ) {
+
+    /* SubBytes and ShiftRows (s is column major, row j of column c is
+       s[4c+j]) */
+
+    uchar t[ 16 ];
+    for( ulong c=0UL; c<4UL; c++ )
+      for( ulong j=0UL; j<4UL; j++ ) t[ 4UL*c+j ] = fd_aes_sbox[ s[ 4UL*((c+j)&3UL)+j ] ];
+
+    /* MixColumns (skipped in the last round) */
+
+    if( r<rounds ) {
+      for( ulong c=0UL; c<4UL; c++ ) {
+        uchar a0 = t[4UL*c+0UL]; uchar a1 = t[4UL*c+1UL]; uchar a2 = t[4UL*c+2UL]; uchar a3 = t[4UL*c+3UL];
+        uchar e  = (uchar)(a0 ^ a1 ^ a2 ^ a3);
+        t[4UL*c+0UL] = (uchar)(a0 ^ e ^ fd_aes_private_xtime( (uchar)(a0^a1) ));
+        t[4UL*c+1UL] = (uchar)(a1 ^ e ^ fd_aes_private_xtime( (uchar)(a1^a2) ));
+        t[4UL*c+2UL] = (uchar)(a2 ^ e ^ fd_aes_private_xtime( (uchar)(a2^a3) ));
+        t[4UL*c+3UL] = (uchar)(a3 ^ e ^ fd_aes_private_xtime( (uchar)(a3^a0) ));
+      }
+    }
+
+    for( ulong i=0UL; i<16UL; i++ ) s[i] = (uchar)(t[i] ^ key->rk[r][i]);
+  }
+  fd_memcpy( out, s, 16UL );
+}
+
+static void
+fd_aes_private_ctr( fd_aes_key_t const * key,
+                    uchar *              out,
+                    uchar const *        in,
+                    ulong                sz,
+                    uchar const *        iv,
+                    uint                 ctr ) {
+  uchar cb[ 16 ];
+  uchar ks[ 16 ];
+  fd_memcpy( cb, iv, FD_AES_GCM_IV_SZ );
+  while( sz ) {
+    FD_STORE( uint, cb+12, fd_uint_bswap( ctr ) );
+    fd_aes_private_block( key, ks, cb );
+    ulong n = fd_ulong_min( sz, 16UL );
+    for( ulong i=0UL; i<n; i++ ) out[i] = (uchar)(in[i] ^ ks[i]);
+    ctr++; in += n; out += n; sz -= n;
+  }
+}
+
+static void
+fd_aes_gcm_private_hpow_init( fd_aes_gcm_t * gcm,
+                              uchar const *  h ) {
+  fd_memset( gcm->hpow, 0, sizeof(gcm->hpow) );
+  fd_memcpy( gcm->hpow[0], h, 16UL );
+}
+
+/* Multiplication in GF(2^128) per NIST SP 800-38D algorithm 1 */
+
+static void
+fd_aes_gcm_private_gfmul( uchar *       x,
+                          uchar const * y ) {
+  ulong z_hi = 0UL;                                   ulong z_lo = 0UL;
+  ulong v_hi = fd_ulong_bswap( FD_LOAD( ulong, y ) ); ulong v_lo = fd_ulong_bswap( FD_LOAD( ulong, y+8 ) );
+  for( ulong i=0UL; i<128UL; i++ ) {
+    ulong bit = (ulong)((x[ i>>3 ] >> (7UL-(i&7UL))) & 1U);
+    z_hi ^= v_hi & (-bit);
+    z_lo ^= v_lo & (-bit);
+    ulong lsb = v_lo & 1UL;
+    v_lo = (v_lo>>1) | (v_hi<<63);
+    v_hi = (v_hi>>1) ^ ((-lsb) & 0xe100000000000000UL);
+  }
+  FD_STORE( ulong, x,   fd_ulong_bswap( z_hi ) );
+  FD_STORE( ulong, x+8, fd_ulong_bswap( z_lo ) );
+}
+
+static void
+fd_aes_gcm_private_ghash( fd_aes_gcm_t const * gcm,
+                          uchar *              x,
+                          uchar const *        data,
+                          ulong                sz ) {
+  while( sz ) {
+    ulong n = fd_ulong_min( sz, 16UL );
+    for( ulong i=0UL; i<n; i++ ) x[i] ^= data[i];
+    fd_aes_gcm_private_gfmul( x, gcm->hpow[0] );
+    data += n; sz -= n;
+  }
+}
+
+static inline void
+fd_aes_gcm_private_ghash_out( uchar *       out,
+                              uchar const * x ) {
+  fd_memcpy( out, x, 16UL );
+}
+
+void
+fd_aes_ecb_encrypt_batch( fd_aes_key_t const * const * key,
+                          void const *         const * in,
+                          void *               const * out,
+                          ulong                        cnt ) {
+  for( ulong i=0UL; i<cnt; i++ ) fd_aes_private_block( key[i], (uchar *)out[i], (uchar const *)in[i] );
+}
+
+#endif
+
+void *
+fd_aes_encrypt_block( fd_aes_key_t const * key,
+                      void *               out,
+                      void const *         in ) {
+  fd_aes_private_block( key, (uchar *)out, (uchar const *)in );
+  return out;
+}
+
+fd_aes_gcm_t *
+fd_aes_gcm_init( fd_aes_gcm_t * gcm,
+                 void const *   key,
+                 ulong          key_sz ) {
+  if( FD_UNLIKELY( !fd_aes_key_init( gcm->key, key, key_sz ) ) ) return NULL;
+  uchar h[ 16 ] = {0};
+  fd_aes_private_block( gcm->key, h, h ); /* H = E(K,0^128) */
+  fd_aes_gcm_private_hpow_init( gcm, h );
+  return gcm;
+}
+
+/* fd_aes_gcm_private_tag computes the tag given the GHASH state x over
+   the aad and the ciphertext. */
+
+static void
+fd_aes_gcm_private_tag( fd_aes_gcm_t const * gcm,
+                        uchar *              tag,
+                        uchar *              x,
+                        ulong                aad_sz,
+                        ulong                sz,
+                        uchar const *        iv ) {
+  uchar len[ 16 ];
+  FD_STORE( ulong, len,   fd_ulong_bswap( aad_sz<<3 ) );
+  FD_STORE( ulong, len+8, fd_ulong_bswap( sz    <<3 ) );
+  fd_aes_gcm_private_ghash( gcm, x, len, 16UL );
+
+  uchar s[ 16 ];
+  fd_aes_gcm_private_ghash_out( s, x );
+
+  uchar j0[ 16 ];
+  fd_memcpy( j0, iv, FD_AES_GCM_IV_SZ );
+  FD_STORE( uint, j0+12, fd_uint_bswap( 1U ) );
+  fd_aes_private_block( gcm->key, j0, j0 );
+
+  for( ulong i=0UL; i<16UL; i++ ) tag[i] = (uchar)(s[i] ^ j0[i]);
+}
+
+void
+fd_aes_gcm_encrypt( fd_aes_gcm_t const * gcm,
+                    void *               c,
+                    void const *         p,
+                    ulong                sz,
+                    void const *         iv,
+                    void const *         aad,
+                    ulong                aad_sz,
+                    void *               tag ) {
+  uchar x[ 16 ] __attribute__((aligned(16))) = {0};
+  fd_aes_gcm_private_ghash( gcm, x, (uchar const *)aad, aad_sz );
+  fd_aes_private_ctr( gcm->key, (uchar *)c, (uchar const *)p, sz, (uchar const *)iv, 2U );
+  fd_aes_gcm_private_ghash( gcm, x, (uchar const *)c, sz );
+  fd_aes_gcm_private_tag( gcm, (uchar *)tag, x, aad_sz, sz, (uchar const *)iv );
+}
+
+int
+fd_aes_gcm_decrypt( fd_aes_gcm_t const * gcm,
+                    void *               p,
+                    void const *         c,
+                    ulong                sz,
+                    void const *         iv,
+                    void const *         aad,
+                    ulong                aad_sz,
+                    void const *         tag ) {
+  uchar x[ 16 ] __attribute__((aligned(16))) = {0};
+  fd_aes_gcm_private_ghash( gcm, x, (uchar const *)aad, aad_sz );
+  fd_aes_gcm_private_ghash( gcm, x, (uchar const *)c,   sz     ); /* Before decrypting in place */
+  fd_aes_private_ctr( gcm->key, (uchar *)p, (uchar const *)c, sz, (uchar const *)iv, 2U );
+
+  uchar expected[ 16 ];
+  fd_aes_gcm_private_tag( gcm, expected, x, aad_sz, sz, (uchar const *)iv );
+
+  uchar diff = (uchar)0;
+  for( ulong i=0UL; i<FD_AES_GCM_TAG_SZ; i++ ) diff |= (uchar)(expected[i] ^ ((uchar const *)tag)[i]);
+  return !diff;
+}
@@ -0,0 +1,125 @@
+#ifndef HEADER_fd_src_ballet_aes_fd_aes_h
+#define HEADER_fd_src_ballet_aes_fd_aes_h
+
+/* fd_aes provides AES-128 / AES-256 block encryption (FIPS 197) and
+   AES-GCM authenticated encryption (NIST SP 800-38D) with 96-bit IVs
+   and 128-bit tags, as used by QUIC / TLS 1.3 packet protection
+   (RFC 9001).  Only the encryption direction of the block cipher is
+   provided (GCM and the QUIC header protection only ever encrypt).
+
+   On targets with FD_HAS_AESNI, blocks are computed with AES-NI
+   instructions (8 independent blocks in flight) and GHASH with
+   PCLMULQDQ carry-less multiplies (8 blocks per reduction).  Otherwise,
+   a (slow) portable reference implementation is used.  The portable
+   implementation is not constant time and should not be used for
+   anything beyond testing. */
+
+#include "../fd_ballet_base.h"
+
+#define FD_AES_BLOCK_SZ   (16UL)
+#define FD_AES_128_KEY_SZ (16UL)
+#define FD_AES_256_KEY_SZ (32UL)
+
+#define FD_AES_GCM_IV_SZ  (12UL)
+#define FD_AES_GCM_TAG_SZ (16UL)
+
+/* fd_aes_key_t holds an expanded AES encryption key.  rounds is 10 for
+   AES-128 and 14 for AES-256. */
+
+struct __attribute__((aligned(16))) fd_aes_key {
+  uchar rk[ 15 ][ FD_AES_BLOCK_SZ ]; /* Round keys, indexed [0,rounds] */
+  ulong rounds;
+};
+
+typedef struct fd_aes_key fd_aes_key_t;
+
+/* fd_aes_gcm_t holds an AES-GCM key: the expanded block cipher key and
+   powers of the GHASH key H (in an implementation specific
+   representation). */
+
+#define FD_AES_GCM_PRIVATE_HPOW_CNT (8UL)
+
+struct __attribute__((aligned(16))) fd_aes_gcm {
+  fd_aes_key_t key[1];
+  uchar        hpow[ FD_AES_GCM_PRIVATE_HPOW_CNT ][ FD_AES_BLOCK_SZ ]; /* hpow[i] is H^(i+1) */
+};
+
+typedef struct fd_aes_gcm fd_aes_gcm_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_aes_key_init expands the key_sz byte AES key pointed to by
+   user_key into the key schedule key.  key_sz should be FD_AES_{128,256}_KEY_SZ.
+   Returns key on success and NULL if key_sz is not supported. */
+
+fd_aes_key_t *
+fd_aes_key_init( fd_aes_key_t * key,
+                 void const *   user_key,
+                 ulong          key_sz );
+
+/* fd_aes_encrypt_block encrypts the 16 byte block in with key into the
+   16 byte block out.  In place fine.  Returns out. */
+
+void *
+fd_aes_encrypt_block( fd_aes_key_t const * key,
+                      void *               out,
+                      void const *         in );
+
+/* fd_aes_ecb_encrypt_batch encrypts cnt independent 16 byte blocks:
+   out[i] = AES( key[i], in[i] ) for i in [0,cnt).  Blocks can use
+   different keys.  Blocks are computed several at a time such that
+   the latency of the block cipher is amortized over a batch (e.g. the
+   QUIC header protection masks of a burst of received packets).  In
+   place fine. */
+
+void
+fd_aes_ecb_encrypt_batch( fd_aes_key_t const * const * key,
+                          void const *         const * in,
+                          void *               const * out,
+                          ulong                        cnt );
+
+/* fd_aes_gcm_init initializes gcm with the key_sz byte AES key pointed
+   to by key (key_sz FD_AES_{128,256}_KEY_SZ).  Returns gcm on success
+   and NULL if key_sz is not supported. */
+
+fd_aes_gcm_t *
+fd_aes_gcm_init( fd_aes_gcm_t * gcm,
+                 void const *   key,
+                 ulong          key_sz );
+
+/* fd_aes_gcm_encrypt encrypts the sz byte plaintext p into the sz byte
+   ciphertext c with the FD_AES_GCM_IV_SZ byte iv, authenticating c and
+   the aad_sz byte additional data aad, and writes the
+   FD_AES_GCM_TAG_SZ byte authentication tag into tag.  In place (c==p)
+   fine, other overlap not. */
+
+void
+fd_aes_gcm_encrypt( fd_aes_gcm_t const * gcm,
+                    void *               c,
+                    void const *         p,
+                    ulong                sz,
+                    void const *         iv,
+                    void const *         aad,
+                    ulong                aad_sz,
+                    void *               tag );
+
+/* fd_aes_gcm_decrypt authenticates the sz byte ciphertext c and the
+   aad_sz byte additional data aad against the FD_AES_GCM_TAG_SZ byte
+   tag and decrypts c into the sz byte plaintext p.  Returns 1 on
+   success and 0 if authentication failed (in which case the contents
+   of p are undefined and should not be used).  In place (p==c) fine,
+   other overlap not. */
+
+int
+fd_aes_gcm_decrypt( fd_aes_gcm_t const * gcm,
+                    void *               p,
+                    void const *         c,
+                    ulong                sz,
+                    void const *         iv,
+                    void const *         aad,
+                    ulong                aad_sz,
+                    void const *         tag );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_aes_fd_aes_h */
@@ -0,0 +1,347 @@
+#include "../fd_ballet.h"
+#include "../hex/fd_hex.h"
+
+#if FD_HAS_OPENSSL
+#include <openssl/evp.h>
+#endif
+
+FD_STATIC_ASSERT( FD_AES_BLOCK_SZ  ==16UL, unit_test );
+FD_STATIC_ASSERT( FD_AES_128_KEY_SZ==16UL, unit_test );
+FD_STATIC_ASSERT( FD_AES_256_KEY_SZ==32UL, unit_test );
+FD_STATIC_ASSERT( FD_AES_GCM_IV_SZ ==12UL, unit_test );
+FD_STATIC_ASSERT( FD_AES_GCM_TAG_SZ==16UL, unit_test );
+
+#define HEX(dst,src) do { ulong _n = strlen( src )/2UL; FD_TEST( fd_hex_decode( (dst), (src), _n )==_n ); } while(0)
+
+/* FIPS 197 appendix C */
+
+struct block_vector {
+  char const * key;
+  char const * pt;
+  char const * ct;
+};
+
+static struct block_vector const block_vectors[] = {
+  { "000102030405060708090a0b0c0d0e0f",
+    "00112233445566778899aabbccddeeff", "69c4e0d86a7b0430d8cdb78070b4c55a" },
+  { "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+    "00112233445566778899aabbccddeeff", "8ea2b7ca516745bfeafc49904b496089" },
+  /* RFC 9001 A.2 header protection mask (first 5 bytes) */
+  { "9f50449e04a0e810283a1e9933adedd2",
+    "d1b1c98dd7689fb8ec11d242b123dc9b", "437b9aec36" },
+  {0}
+};
+
+/* The Galois/Counter Mode of Operation (McGrew and Viega), test cases
+   1-4, 13, 14 and 16 */
+
+struct gcm_vector {
+  char const * key;
+  char const * iv;
+  char const * pt;
+  char const * aad;
+  char const * ct;
+  char const * tag;
+};
+
+#define GCM_TC3_PT "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255"
+#define GCM_TC4_PT "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39"
+#define GCM_TC4_AAD "feedfacedeadbeeffeedfacedeadbeefabaddad2"
+
+static struct gcm_vector const gcm_vectors[] = {
+  { "00000000000000000000000000000000", "000000000000000000000000", "", "",
+    "", "58e2fccefa7e3061367f1d57a4e7455a" },
+  { "00000000000000000000000000000000", "000000000000000000000000", "00000000000000000000000000000000", "",
+    "0388dace60b6a392f328c2b971b2fe78", "ab6e47d42cec13bdf53a67b21257bddf" },
+  { "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", GCM_TC3_PT, "",
+    "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985",
+    "4d5c2af327cd64a62cf35abd2ba6fab4" },
+  { "feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", GCM_TC4_PT, GCM_TC4_AAD,
+    "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+    "5bc94fbc3221a5db94fae95ae7121a47" },
+  { "0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000", "", "",
+    "", "530f8afbc74536b9a963b4f1c4cb738b" },
+  { "0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000", "00000000000000000000000000000000", "",
+    "cea7403d4d606b6e074ec5d3baf39d18", "d0d1c8a799996bf0265b98b5d48ab919" },
+  { "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", GCM_TC4_PT, GCM_TC4_AAD,
+    "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+    "76fc6ece0f4e1768cddf8853bb2d551b" },
+  {0}
+};
+
+/* RFC 9001 A.2: the protected client initial packet payload starts
+   with the header protection sample (packet number 2, unprotected
+   header as aad, CRYPTO frame zero padded to 1162 bytes) */
+
+#define RFC9001_KEY    "1f369613dd76d5467730efcbe3b1a22d"
+#define RFC9001_IV     "fa044b2f42a3fd3b46fb255c"
+#define RFC9001_HDR    "c300000001088394c8f03e5157080000449e00000002"
+#define RFC9001_PT     "060040f1010000ed0303ebf8fa56f12939b9584a3896472ec40bb863cfd3e868"
+#define RFC9001_CT_PFX "d1b1c98dd7689fb8ec11d242b123dc9b"
+
+static void
+test_rfc9001( void ) {
+  static uchar key[ 16 ]; static uchar iv[ 12 ]; static uchar hdr[ 22 ];
+  static uchar pt[ 1162 ]; static uchar ct[ 1162 ]; static uchar expected[ sizeof(RFC9001_CT_PFX)/2UL ];
+  HEX( key, RFC9001_KEY ); HEX( iv, RFC9001_IV ); HEX( hdr, RFC9001_HDR );
+  ulong pt_sz = strlen( RFC9001_PT )/2UL; FD_TEST( pt_sz<=sizeof(pt) );
+  HEX( pt, RFC9001_PT );
+  HEX( expected, RFC9001_CT_PFX );
+
+  /* The payload is padded with zeros to 1162 bytes, the nonce is the
+     iv xor the packet number */
+
+  iv[ 11 ] ^= (uchar)2;
+
+  fd_aes_gcm_t gcm[1]; FD_TEST( fd_aes_gcm_init( gcm, key, 16UL )==gcm );
+  uchar tag[ 16 ];
+  fd_aes_gcm_encrypt( gcm, ct, pt, sizeof(pt), iv, hdr, sizeof(hdr), tag );
+  ulong cmp_sz = fd_ulong_min( sizeof(expected), sizeof(ct) );
+  FD_TEST( !memcmp( ct, expected, cmp_sz ) );
+
+  uchar dec[ 1162 ];
+  FD_TEST( fd_aes_gcm_decrypt( gcm, dec, ct, sizeof(ct), iv, hdr, sizeof(hdr), tag )==1 );
+  FD_TEST( !memcmp( dec, pt, sizeof(pt) ) );
+}
+
+static void
+test_vectors( void ) {
+  for( struct block_vector const * v=block_vectors; v->key; v++ ) {
+    uchar key[ 32 ]; uchar pt[ 16 ]; uchar ct[ 16 ]; uchar out[ 16 ];
+    ulong key_sz = strlen( v->key )/2UL;
+    ulong ct_sz  = strlen( v->ct  )/2UL;
+    HEX( key, v->key ); HEX( pt, v->pt ); HEX( ct, v->ct );
+
+    fd_aes_key_t k[1]; FD_TEST( fd_aes_key_init( k, key, key_sz )==k );
+    FD_TEST( k->rounds==(key_sz==16UL ? 10UL : 14UL) );
+    FD_TEST( fd_aes_encrypt_block( k, out, pt )==out );
+    FD_TEST( !memcmp( out, ct, ct_sz ) );
+    fd_memcpy( out, pt, 16UL ); fd_aes_encrypt_block( k, out, out ); /* in place */
+    FD_TEST( !memcmp( out, ct, ct_sz ) );
+  }
+
+  for( struct gcm_vector const * v=gcm_vectors; v->key; v++ ) {
+    uchar key[ 32 ]; uchar iv[ 12 ]; uchar pt[ 64 ]; uchar aad[ 32 ]; uchar ct[ 64 ]; uchar tag[ 16 ];
+    ulong key_sz = strlen( v->key )/2UL;
+    ulong sz     = strlen( v->pt  )/2UL;
+    ulong aad_sz = strlen( v->aad )/2UL;
+    HEX( key, v->key ); HEX( iv, v->iv ); HEX( pt, v->pt ); HEX( aad, v->aad ); HEX( ct, v->ct ); HEX( tag, v->tag );
+
+    fd_aes_gcm_t gcm[1]; FD_TEST( fd_aes_gcm_init( gcm, key, key_sz )==gcm );
+
+    uchar out[ 64 ]; uchar out_tag[ 16 ];
+    fd_aes_gcm_encrypt( gcm, out, pt, sz, iv, aad, aad_sz, out_tag );
+    FD_TEST( !memcmp( out, ct, sz ) );
+    FD_TEST( !memcmp( out_tag, tag, 16UL ) );
+
+    FD_TEST( fd_aes_gcm_decrypt( gcm, out, ct, sz, iv, aad, aad_sz, tag )==1 );
+    FD_TEST( !memcmp( out, pt, sz ) );
+
+    tag[ 15 ] ^= (uchar)1;
+    FD_TEST( fd_aes_gcm_decrypt( gcm, out, ct, sz, iv, aad, aad_sz, tag )==0 );
+  }
+
+  uchar key[ 32 ] = {0};
+  fd_aes_key_t k[1]; fd_aes_gcm_t gcm[1];
+  FD_TEST( !fd_aes_key_init( k,   key, 24UL ) ); /* AES-192 not supported */
+  FD_TEST( !fd_aes_gcm_init( gcm, key,  0UL ) );
+}
+
+#define MSG_MAX (4096UL)
+
+static void
+test_gcm_random( fd_rng_t * rng ) {
+  static uchar pt [ MSG_MAX ];
+  static uchar ct [ MSG_MAX ];
+  static uchar dec[ MSG_MAX ];
+  uchar key[ 32 ]; uchar iv[ 12 ]; uchar aad[ 64 ]; uchar tag[ 16 ];
+
+  for( ulong iter=0UL; iter<4096UL; iter++ ) {
+    ulong key_sz = fd_rng_uint_roll( rng, 2U ) ? 16UL : 32UL;
+    ulong sz     = iter<1024UL ? iter : fd_rng_ulong_roll( rng, MSG_MAX+1UL );
+    ulong aad_sz = fd_rng_ulong_roll( rng, 65UL );
+    for( ulong i=0UL; i<32UL;   i++ ) key[i] = fd_rng_uchar( rng );
+    for( ulong i=0UL; i<12UL;   i++ ) iv [i] = fd_rng_uchar( rng );
+    for( ulong i=0UL; i<aad_sz; i++ ) aad[i] = fd_rng_uchar( rng );
+    for( ulong i=0UL; i<sz;     i++ ) pt [i] = fd_rng_uchar( rng );
+
+    fd_aes_gcm_t gcm[1]; FD_TEST( fd_aes_gcm_init( gcm, key, key_sz )==gcm );
+    fd_aes_gcm_encrypt( gcm, ct, pt, sz, iv, aad, aad_sz, tag );
+
+#   if FD_HAS_OPENSSL
+    do {
+      static uchar ref_ct[ MSG_MAX ];
+      uchar ref_tag[ 16 ];
+      int   len;
+      EVP_CIPHER_CTX * ctx = EVP_CIPHER_CTX_new(); FD_TEST( ctx );
+      FD_TEST( EVP_EncryptInit_ex( ctx, key_sz==16UL ? EVP_aes_128_gcm() : EVP_aes_256_gcm(), NULL, key, iv )==1 );
+      FD_TEST( EVP_EncryptUpdate( ctx, NULL, &len, aad, (int)aad_sz )==1 );
+      FD_TEST( EVP_EncryptUpdate( ctx, ref_ct, &len, pt, (int)sz )==1 );
+      FD_TEST( EVP_EncryptFinal_ex( ctx, ref_ct+len, &len )==1 );
+      FD_TEST( EVP_CIPHER_CTX_ctrl( ctx, EVP_CTRL_GCM_GET_TAG, 16, ref_tag )==1 );
+      EVP_CIPHER_CTX_free( ctx );
+      FD_TEST( !memcmp( ct,  ref_ct,  sz   ) );
+      FD_TEST( !memcmp( tag, ref_tag, 16UL ) );
+    } while(0);
+#   endif
+
+    FD_TEST( fd_aes_gcm_decrypt( gcm, dec, ct, sz, iv, aad, aad_sz, tag )==1 );
+    FD_TEST( !memcmp( dec, pt, sz ) );
+
+    /* In place */
+
+    fd_memcpy( dec, pt, sz );
+    uchar tag2[ 16 ];
+    fd_aes_gcm_encrypt( gcm, dec, dec, sz, iv, aad, aad_sz, tag2 );
+    FD_TEST( !memcmp( dec, ct, sz ) && !memcmp( tag2, tag, 16UL ) );
+    FD_TEST( fd_aes_gcm_decrypt( gcm, dec, dec, sz, iv, aad, aad_sz, tag )==1 );
+    FD_TEST( !memcmp( dec, pt, sz ) );
+
+    /* Corrupt one bit of the ciphertext, aad or tag */
+
+    ulong which = fd_rng_ulong_roll( rng, 3UL );
+    if(      which==0UL && sz     ) ct [ fd_rng_ulong_roll( rng, sz     ) ] ^= (uchar)(1U<<fd_rng_uint_roll( rng, 8U ));
+    else if( which==1UL && aad_sz ) aad[ fd_rng_ulong_roll( rng, aad_sz ) ] ^= (uchar)(1U<<fd_rng_uint_roll( rng, 8U ));
+    else                            tag[ fd_rng_ulong_roll( rng, 16UL   ) ] ^= (uchar)(1U<<fd_rng_uint_roll( rng, 8U ));
+    FD_TEST( fd_aes_gcm_decrypt( gcm, dec, ct, sz, iv, aad, aad_sz, tag )==0 );
+  }
+}
+
+static void
+test_ecb_batch( fd_rng_t * rng ) {
+  fd_aes_key_t keys[ 4 ];
+  for( ulong i=0UL; i<4UL; i++ ) {
+    uchar key[ 32 ];
+    for( ulong j=0UL; j<32UL; j++ ) key[j] = fd_rng_uchar( rng );
+    FD_TEST( fd_aes_key_init( keys+i, key, (i&1UL) ? 32UL : 16UL )==keys+i );
+  }
+
+  for( ulong iter=0UL; iter<1024UL; iter++ ) {
+    ulong cnt = fd_rng_ulong_roll( rng, 65UL );
+    ulong mix = fd_rng_ulong_roll( rng, 3UL ); /* 0: AES-128 only, 1: AES-256 only, 2: mixed */
+
+    fd_aes_key_t const * key[ 64 ];
+    uchar                in [ 64 ][ 16 ];
+    uchar                out[ 64 ][ 16 ];
+    void const *         in_ptr [ 64 ];
+    void *               out_ptr[ 64 ];
+    for( ulong i=0UL; i<cnt; i++ ) {
+      ulong k = mix==2UL ? fd_rng_ulong_roll( rng, 4UL ) : (mix + 2UL*fd_rng_ulong_roll( rng, 2UL ));
+      key[i] = keys + k;
+      for( ulong j=0UL; j<16UL; j++ ) in[i][j] = fd_rng_uchar( rng );
+      in_ptr [i] = in [i];
+      out_ptr[i] = out[i];
+    }
+
+    fd_aes_ecb_encrypt_batch( key, in_ptr, out_ptr, cnt );
+
+    for( ulong i=0UL; i<cnt; i++ ) {
+      uchar ref[ 16 ];
+      fd_aes_encrypt_block( key[i], ref, in[i] );
+      FD_TEST( !memcmp( out[i], ref, 16UL ) );
+    }
+
+    /* In place */
+
+    for( ulong i=0UL; i<cnt; i++ ) out_ptr[i] = in[i];
+    fd_aes_ecb_encrypt_batch( key, in_ptr, out_ptr, cnt );
+    for( ulong i=0UL; i<cnt; i++ ) FD_TEST( !memcmp( out[i], in[i], 16UL ) );
+  }
+}
+
+/* Benchmark the per packet cost of protecting QUIC short header packets
+   with AES-128-GCM: payload encryption plus a header protection mask
+   (computed in batches of 16 packets as a receive / transmit burst
+   would). */
+
+#define BENCH_PKT_SZ    (1200UL)
+#define BENCH_BURST_CNT (16UL)
+
+static void
+bench( fd_rng_t * rng ) {
+  static uchar pkt[ BENCH_BURST_CNT ][ BENCH_PKT_SZ + 16UL ];
+  uchar key[ 16 ]; uchar iv[ 12 ]; uchar hdr[ 20 ];
+  for( ulong i=0UL; i<16UL; i++ ) key[i] = fd_rng_uchar( rng );
+  for( ulong i=0UL; i<12UL; i++ ) iv [i] = fd_rng_uchar( rng );
+  for( ulong i=0UL; i<20UL; i++ ) hdr[i] = fd_rng_uchar( rng );
+  for( ulong i=0UL; i<BENCH_BURST_CNT; i++ ) for( ulong j=0UL; j<BENCH_PKT_SZ; j++ ) pkt[i][j] = fd_rng_uchar( rng );
+
+  fd_aes_gcm_t gcm[1]; FD_TEST( fd_aes_gcm_init( gcm, key, 16UL ) );
+  fd_aes_key_t hp [1]; FD_TEST( fd_aes_key_init( hp, key, 16UL ) );
+
+  fd_aes_key_t const * hp_key [ BENCH_BURST_CNT ];
+  void const *         sample [ BENCH_BURST_CNT ];
+  void *               mask   [ BENCH_BURST_CNT ];
+  uchar                _mask  [ BENCH_BURST_CNT ][ 16 ];
+  for( ulong i=0UL; i<BENCH_BURST_CNT; i++ ) { hp_key[i] = hp; sample[i] = pkt[i] + 4UL; mask[i] = _mask[i]; }
+
+  ulong iter = 4096UL;
+  long  dt   = -fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) {
+    for( ulong i=0UL; i<BENCH_BURST_CNT; i++ ) {
+      FD_STORE( ulong, iv+4, FD_LOAD( ulong, iv+4 ) ^ rem );
+      fd_aes_gcm_encrypt( gcm, pkt[i], pkt[i], BENCH_PKT_SZ, iv, hdr, sizeof(hdr), pkt[i]+BENCH_PKT_SZ );
+    }
+    fd_aes_ecb_encrypt_batch( hp_key, sample, mask, BENCH_BURST_CNT );
+    FD_COMPILER_MFENCE();
+  }
+  dt += fd_log_wallclock();
+  double pkt_cnt = (double)(iter*BENCH_BURST_CNT);
+  double gbps    = (8.*(double)BENCH_PKT_SZ*pkt_cnt) / (double)dt;
+  double mpps    = 1e3*pkt_cnt / (double)dt;
+
+# if FD_HAS_OPENSSL
+  EVP_CIPHER_CTX * ctx    = EVP_CIPHER_CTX_new(); FD_TEST( ctx );
+  EVP_CIPHER_CTX * hp_ctx = EVP_CIPHER_CTX_new(); FD_TEST( hp_ctx );
+  FD_TEST( EVP_EncryptInit_ex( ctx,    EVP_aes_128_gcm(), NULL, key,  NULL )==1 );
+  FD_TEST( EVP_EncryptInit_ex( hp_ctx, EVP_aes_128_ecb(), NULL, key,  NULL )==1 );
+  dt = -fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) {
+    for( ulong i=0UL; i<BENCH_BURST_CNT; i++ ) {
+      int len;
+      FD_STORE( ulong, iv+4, FD_LOAD( ulong, iv+4 ) ^ rem );
+      EVP_EncryptInit_ex( ctx, NULL, NULL, NULL, iv );
+      EVP_EncryptUpdate( ctx, NULL, &len, hdr, (int)sizeof(hdr) );
+      EVP_EncryptUpdate( ctx, pkt[i], &len, pkt[i], (int)BENCH_PKT_SZ );
+      EVP_EncryptFinal_ex( ctx, pkt[i]+len, &len );
+      EVP_CIPHER_CTX_ctrl( ctx, EVP_CTRL_GCM_GET_TAG, 16, pkt[i]+BENCH_PKT_SZ );
+      EVP_EncryptUpdate( hp_ctx, _mask[i], &len, pkt[i]+4UL, 16 );
+    }
+    FD_COMPILER_MFENCE();
+  }
+  dt += fd_log_wallclock();
+  EVP_CIPHER_CTX_free( hp_ctx );
+  EVP_CIPHER_CTX_free( ctx );
+  double ref_gbps = (8.*(double)BENCH_PKT_SZ*pkt_cnt) / (double)dt;
+  double ref_mpps = 1e3*pkt_cnt / (double)dt;
+  FD_LOG_NOTICE(( "AES-128-GCM + header protection, %lu B packets: ~%6.3f Gbps / core, ~%6.3f Mpps / core (OpenSSL EVP ~%6.3f Gbps, ~%6.3f Mpps)",
+                  BENCH_PKT_SZ, gbps, mpps, ref_gbps, ref_mpps ));
+# else
+  FD_LOG_NOTICE(( "AES-128-GCM + header protection, %lu B packets: ~%6.3f Gbps / core, ~%6.3f Mpps / core",
+                  BENCH_PKT_SZ, gbps, mpps ));
+# endif
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_LOG_NOTICE(( "Testing vectors" ));
+  test_vectors();
+  test_rfc9001();
+
+  FD_LOG_NOTICE(( "Testing random messages" ));
+  test_gcm_random( rng );
+  test_ecb_batch ( rng );
+
+  bench( rng );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
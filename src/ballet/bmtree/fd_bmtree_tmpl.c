@@ -31,6 +31,14 @@
      bmt_commit_t * bmt_commit_append   ( bmt_commit_t * bmt, bmt_node_t const * leaf, ulong leaf_cnt );
      uchar *        bmt_commit_fini     ( bmt_commit_t * bmt );
 
+     // Public full tree API
+
+     ulong        bmt_tree_node_cnt( ulong leaf_cnt );
+     bmt_node_t * bmt_tree_build   ( bmt_node_t * tree, ulong leaf_cnt );
+     ulong        bmt_tree_proof   ( bmt_node_t const * tree, ulong leaf_cnt, ulong leaf_idx, bmt_node_t * proof );
+     int          bmt_proof_verify ( bmt_node_t const * leaf, ulong leaf_idx, bmt_node_t const * proof, ulong proof_cnt,
+                                     void const * root );
+
    See comments below for more details.
 
    Widths 20 and 32 are used in the Solana protocol.  Specification:
@@ -56,7 +64,6 @@
         (node) -> (node)
 
    Example derived methods.
-   (TODO not all of them are provided by this header file yet)
 
      4. Construct full tree:
 
@@ -495,6 +502,123 @@ BMTREE_(commit_fini)( BMTREE_(commit_t) * state ) {
   return root->hash;
 }
 
+/* bmtree_tree_node_cnt returns the number of nodes of a binary Merkle
+   tree with leaf_cnt leaves, counting the leaves and the root.  That
+   is, the number of nodes in a tree array (see below). */
+
+FD_FN_CONST static inline ulong
+BMTREE_(tree_node_cnt)( ulong leaf_cnt ) {
+  ulong node_cnt = leaf_cnt;
+  while( leaf_cnt>1UL ) {
+    leaf_cnt  = (leaf_cnt+1UL) >> 1;
+    node_cnt += leaf_cnt;
+  }
+  return node_cnt;
+}
+
+/* bmtree_tree_build computes all the branch nodes of a binary Merkle
+   tree.  A tree array holds the layers of the tree consecutively,
+   bottom up and each layer left to right, such that the leaves are at
+   indices [0,leaf_cnt) and the root is the last node.  On entry,
+   tree[0,leaf_cnt) holds the leaves and tree has room for
+   bmtree_tree_node_cnt( leaf_cnt ) nodes.  On return, the tree array
+   is complete.  Returns a pointer to the root node.  leaf_cnt should be
+   positive.
+
+   Unlike bmtree_commit, which hashes one node pair at a time in a long
+   dependent chain, all the branch nodes of a layer are independent and
+   are hashed in groups of FD_BMTREE_PRIVATE_BATCH_CNT through the
+   fd_sha256_batch API (which computes the hashes of a group in
+   parallel SIMD lanes where supported).  The result is identical to
+   bmtree_commit's. */
+
+#ifndef FD_BMTREE_PRIVATE_BATCH_CNT
+#define FD_BMTREE_PRIVATE_BATCH_CNT (8UL)
+#endif
+
+FD_FN_UNUSED static BMTREE_(node_t) * /* Work around -Winline */
+BMTREE_(tree_build)( BMTREE_(node_t) * tree,
+                     ulong             leaf_cnt ) {
+
+  /* Branch messages are staged like in private_merge (the prefix byte
+     at offset 31 such that the child hashes are AVX aligned for
+     BMTREE_HASH_SZ==32). */
+
+  uchar msg[ FD_BMTREE_PRIVATE_BATCH_CNT ][ 96UL ] __attribute__((aligned(32)));
+  for( ulong lane=0UL; lane<FD_BMTREE_PRIVATE_BATCH_CNT; lane++ ) msg[ lane ][ 31UL ] = (uchar)1;
+
+  uchar _batch[ FD_SHA256_BATCH_FOOTPRINT ] __attribute__((aligned(FD_SHA256_BATCH_ALIGN)));
+
+  BMTREE_(node_t) * layer     = tree;
+  ulong             layer_cnt = leaf_cnt;
+  while( layer_cnt>1UL ) {
+    BMTREE_(node_t) * above     = layer + layer_cnt;
+    ulong             above_cnt = (layer_cnt+1UL) >> 1;
+
+    for( ulong idx0=0UL; idx0<above_cnt; idx0+=FD_BMTREE_PRIVATE_BATCH_CNT ) {
+      ulong               lane_cnt = fd_ulong_min( above_cnt-idx0, FD_BMTREE_PRIVATE_BATCH_CNT );
+      fd_sha256_batch_t * batch    = fd_sha256_batch_init( _batch );
+      for( ulong lane=0UL; lane<lane_cnt; lane++ ) {
+        ulong                   idx = idx0 + lane;
+        BMTREE_(node_t) const * a   = layer + 2UL*idx;
+        BMTREE_(node_t) const * b   = layer + fd_ulong_min( 2UL*idx+1UL, layer_cnt-1UL ); /* 1 child: duplicate it */
+        fd_memcpy( msg[ lane ]+32UL,                a->hash, BMTREE_HASH_SZ );
+        fd_memcpy( msg[ lane ]+32UL+BMTREE_HASH_SZ, b->hash, BMTREE_HASH_SZ );
+        fd_sha256_batch_add( batch, msg[ lane ]+31UL, 1UL+2UL*BMTREE_HASH_SZ, above[ idx ].hash );
+      }
+      fd_sha256_batch_fini( batch );
+    }
+
+    layer     = above;
+    layer_cnt = above_cnt;
+  }
+
+  return layer;
+}
+
+/* bmtree_tree_proof writes the inclusion proof of leaf leaf_idx of the
+   complete tree array tree with leaf_cnt leaves into proof.  The proof
+   is the sibling of the leaf and of each of its ancestors below the
+   root, bottom up (a node with no sibling is its own sibling).  Returns
+   the number of proof nodes written, bmtree_private_depth( leaf_cnt )-1.
+   Assumes leaf_idx<leaf_cnt. */
+
+static inline ulong
+BMTREE_(tree_proof)( BMTREE_(node_t) const * tree,
+                     ulong                   leaf_cnt,
+                     ulong                   leaf_idx,
+                     BMTREE_(node_t) *       proof ) {
+  ulong proof_cnt = 0UL;
+  ulong layer_cnt = leaf_cnt;
+  while( layer_cnt>1UL ) {
+    proof[ proof_cnt++ ] = tree[ fd_ulong_min( leaf_idx ^ 1UL, layer_cnt-1UL ) ];
+    tree      += layer_cnt;
+    layer_cnt  = (layer_cnt+1UL) >> 1;
+    leaf_idx >>= 1;
+  }
+  return proof_cnt;
+}
+
+/* bmtree_proof_verify returns 1 if the proof_cnt node inclusion proof
+   proof shows that leaf is leaf leaf_idx of the tree with root root
+   (the first BMTREE_HASH_SZ bytes of the root hash) and 0 otherwise. */
+
+FD_FN_UNUSED static int /* Work around -Winline */
+BMTREE_(proof_verify)( BMTREE_(node_t) const * leaf,
+                       ulong                   leaf_idx,
+                       BMTREE_(node_t) const * proof,
+                       ulong                   proof_cnt,
+                       void const *            root ) {
+  BMTREE_(node_t) tmp[1];
+  *tmp = *leaf;
+  for( ulong i=0UL; i<proof_cnt; i++ ) {
+    if( leaf_idx & 1UL ) BMTREE_(private_merge)( tmp, proof+i, tmp     );
+    else                 BMTREE_(private_merge)( tmp, tmp,     proof+i );
+    leaf_idx >>= 1;
+  }
+  return (!leaf_idx) & (!memcmp( tmp->hash, root, BMTREE_HASH_SZ ));
+}
+
 FD_PROTOTYPES_END
 
 #undef BMTREE_
@@ -45,6 +45,59 @@ test_bmtree20_commit( ulong        leaf_cnt,
                  leaf_cnt, FD_LOG_HEX20_FMT_ARGS( root ), FD_LOG_HEX20_FMT_ARGS( expected_root ) ));
 }
 
+/* Test full tree construction against the commit calculation and
+   check every inclusion proof */
+
+#define TREE_NODE_MAX (2UL*(1UL<<20)+64UL)
+
+static uchar tree_mem[ TREE_NODE_MAX*32UL ] __attribute__((aligned(32)));
+
+#define TEST_TREE( w )                                                                               \
+static void                                                                                          \
+test_bmtree##w##_tree( fd_rng_t * rng,                                                               \
+                       ulong      leaf_cnt,                                                          \
+                       int        check_proofs ) {                                                   \
+  fd_bmtree##w##_node_t * tree = (fd_bmtree##w##_node_t *)tree_mem;                                  \
+  ulong node_cnt = fd_bmtree##w##_tree_node_cnt( leaf_cnt );                                         \
+  FD_TEST( node_cnt<=TREE_NODE_MAX );                                                                \
+  for( ulong i=0UL; i<leaf_cnt; i++ )                                                                \
+    for( ulong j=0UL; j<32UL; j++ ) tree[ i ].hash[ j ] = fd_rng_uchar( rng );                       \
+                                                                                                     \
+  fd_bmtree##w##_commit_t _commit[1];                                                                \
+  fd_bmtree##w##_commit_t * commit = fd_bmtree##w##_commit_init( _commit );                          \
+  fd_bmtree##w##_commit_append( commit, tree, leaf_cnt );                                            \
+  uchar * expected = fd_bmtree##w##_commit_fini( commit );                                           \
+                                                                                                     \
+  fd_bmtree##w##_node_t * root = fd_bmtree##w##_tree_build( tree, leaf_cnt );                        \
+  FD_TEST( root==tree+node_cnt-1UL );                                                                \
+  FD_TEST( !memcmp( root->hash, expected, FD_BMTREE##w##_HASH_SZ ) );                                \
+                                                                                                     \
+  if( !check_proofs ) return;                                                                        \
+  fd_bmtree##w##_node_t proof[ 64 ];                                                                 \
+  ulong depth = fd_bmtree##w##_private_depth( leaf_cnt );                                            \
+  for( ulong i=0UL; i<leaf_cnt; i++ ) {                                                              \
+    ulong proof_cnt = fd_bmtree##w##_tree_proof( tree, leaf_cnt, i, proof );                         \
+    FD_TEST( proof_cnt==depth-1UL );                                                                 \
+    FD_TEST(  fd_bmtree##w##_proof_verify( tree+i, i, proof, proof_cnt, root->hash ) );              \
+    if( proof_cnt ) {                                                                                \
+      ulong k = fd_rng_ulong_roll( rng, proof_cnt );                                                 \
+      proof[ k ].hash[ fd_rng_ulong_roll( rng, FD_BMTREE##w##_HASH_SZ ) ] ^= (uchar)1;               \
+      FD_TEST( !fd_bmtree##w##_proof_verify( tree+i, i, proof, proof_cnt, root->hash ) );            \
+    }                                                                                                \
+    if( leaf_cnt>1UL ) {                                                                             \
+      fd_bmtree##w##_tree_proof( tree, leaf_cnt, i, proof ); /* Undo corruption */                  \
+      ulong j = (i+1UL+fd_rng_ulong_roll( rng, leaf_cnt-1UL )) % leaf_cnt; /* j!=i */                \
+      FD_TEST( !fd_bmtree##w##_proof_verify( tree+j, i, proof, proof_cnt, root->hash ) ||            \
+               !memcmp( tree[ j ].hash, tree[ i ].hash, FD_BMTREE##w##_HASH_SZ ) );                  \
+    }                                                                                                \
+  }                                                                                                  \
+}
+
+TEST_TREE( 20 )
+TEST_TREE( 32 )
+
+#undef TEST_TREE
+
 static void
 hash_leaf( fd_bmtree32_node_t * leaf,
            char const *         leaf_cstr ) {
@@ -139,6 +192,50 @@ main( int     argc,
                  FD_LOG_HEX16_FMT_ARGS(     root ), FD_LOG_HEX16_FMT_ARGS(     root+16 ),
                  FD_LOG_HEX16_FMT_ARGS( expected ), FD_LOG_HEX16_FMT_ARGS( expected+16 ) ));
 
+  /* Full tree construction matches the spec example ... */
+
+  for( ulong i=0UL; i<leaf_cnt; i++ ) ((fd_bmtree32_node_t *)tree_mem)[ i ] = leaf[ i ];
+  FD_TEST( !memcmp( fd_bmtree32_tree_build( (fd_bmtree32_node_t *)tree_mem, leaf_cnt )->hash, expected, 32UL ) );
+
+  /* ... and the commit calculation, with valid inclusion proofs */
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  for( ulong cnt=1UL; cnt<=300UL; cnt++ ) { test_bmtree20_tree( rng, cnt, 1 ); test_bmtree32_tree( rng, cnt, 1 ); }
+  test_bmtree20_tree( rng, 4097UL, 1 ); test_bmtree32_tree( rng, 4097UL, 1 );
+  for( ulong iter=0UL; iter<16UL; iter++ ) {
+    ulong cnt = 1UL + fd_rng_ulong_roll( rng, 1UL<<20 );
+    test_bmtree20_tree( rng, cnt, 0 ); test_bmtree32_tree( rng, cnt, 0 );
+  }
+  test_bmtree20_tree( rng, 1UL<<20, 0 ); test_bmtree32_tree( rng, 1UL<<20, 0 );
+
+  /* Benchmark commit vs full tree construction */
+
+  for( ulong bench_leaf_cnt=1UL<<10; bench_leaf_cnt<=(1UL<<20); bench_leaf_cnt<<=2 ) {
+    fd_bmtree20_node_t * tree20 = (fd_bmtree20_node_t *)tree_mem;
+    for( ulong i=0UL; i<bench_leaf_cnt; i++ ) FD_STORE( ulong, tree20[ i ].hash, i );
+
+    ulong iter_cnt = fd_ulong_max( (1UL<<22) / bench_leaf_cnt, 1UL );
+
+    long dt_commit = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+      fd_bmtree20_commit_t _commit[1];
+      fd_bmtree20_commit_fini( fd_bmtree20_commit_append( fd_bmtree20_commit_init( _commit ), tree20, bench_leaf_cnt ) );
+    }
+    dt_commit += fd_log_wallclock();
+
+    long dt_tree = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<iter_cnt; iter++ ) fd_bmtree20_tree_build( tree20, bench_leaf_cnt );
+    dt_tree += fd_log_wallclock();
+
+    double leaf_tot = (double)(iter_cnt*bench_leaf_cnt);
+    FD_LOG_NOTICE(( "%7lu leaves: commit ~%7.3f Mleaf/s, tree_build ~%7.3f Mleaf/s (%.2fx)",
+                    bench_leaf_cnt, 1e3*leaf_tot/(double)dt_commit, 1e3*leaf_tot/(double)dt_tree,
+                    (double)dt_commit/(double)dt_tree ));
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
   return 0;
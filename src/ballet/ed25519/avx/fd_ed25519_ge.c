@@ -298,6 +298,83 @@ fd_ed25519_ge_frombytes_vartime_2( fd_ed25519_ge_p3_t * h0, uchar const * s0,
   return FD_ED25519_SUCCESS;
 }
 
+int
+fd_ed25519_ge_frombytes_vartime_4( fd_ed25519_ge_p3_t * h0, uchar const * s0,
+                                   fd_ed25519_ge_p3_t * h1, uchar const * s1,
+                                   fd_ed25519_ge_p3_t * h2, uchar const * s2,
+                                   fd_ed25519_ge_p3_t * h3, uchar const * s3 ) {
+
+  /* Same as fd_ed25519_ge_frombytes_vartime_2 but uses all 4 AVX lanes
+     such that the expensive pow22523 is amortized over 4 points. */
+
+  fd_ed25519_fe_frombytes( h0->Y, s0 ); fd_ed25519_fe_frombytes( h1->Y, s1 );
+  fd_ed25519_fe_frombytes( h2->Y, s2 ); fd_ed25519_fe_frombytes( h3->Y, s3 );
+  fd_ed25519_fe_1        ( h0->Z     ); fd_ed25519_fe_1        ( h1->Z     );
+  fd_ed25519_fe_1        ( h2->Z     ); fd_ed25519_fe_1        ( h3->Z     );
+
+  static long const ldddd[40] __attribute__((aligned(64))) = {
+    (long)(uint)-10913610, (long)(uint)-10913610, (long)(uint)-10913610, (long)(uint)-10913610, /* Do not sign extend */
+    (long)(uint) 13857413, (long)(uint) 13857413, (long)(uint) 13857413, (long)(uint) 13857413, /* " */
+    (long)(uint)-15372611, (long)(uint)-15372611, (long)(uint)-15372611, (long)(uint)-15372611, /* " */
+    (long)(uint)  6949391, (long)(uint)  6949391, (long)(uint)  6949391, (long)(uint)  6949391, /* " */
+    (long)(uint)   114729, (long)(uint)   114729, (long)(uint)   114729, (long)(uint)   114729, /* " */
+    (long)(uint) -8787816, (long)(uint) -8787816, (long)(uint) -8787816, (long)(uint) -8787816, /* " */
+    (long)(uint) -6275908, (long)(uint) -6275908, (long)(uint) -6275908, (long)(uint) -6275908, /* " */
+    (long)(uint) -3247719, (long)(uint) -3247719, (long)(uint) -3247719, (long)(uint) -3247719, /* " */
+    (long)(uint)-18696448, (long)(uint)-18696448, (long)(uint)-18696448, (long)(uint)-18696448, /* " */
+    (long)(uint)-12055116, (long)(uint)-12055116, (long)(uint)-12055116, (long)(uint)-12055116  /* " */
+  };
+
+  long vh[40] __attribute__((aligned(64)));
+  long vu[40] __attribute__((aligned(64)));
+  long vv[40] __attribute__((aligned(64)));
+  long vw[40] __attribute__((aligned(64)));
+
+  fe_avx_ld4( vh, h0->Y, h1->Y, h2->Y, h3->Y );
+
+  fe_avx_sq      ( vu, vh        );
+  fe_avx_mul     ( vv, vu, ldddd );
+  vu[0] -= 1L; vu[1] -= 1L; vu[2] -= 1L; vu[3] -= 1L; /* u = y^2-1 */
+  vv[0] += 1L; vv[1] += 1L; vv[2] += 1L; vv[3] += 1L; /* v = dy^2+1 */
+  fe_avx_sq      ( vw, vv        ); /* vv30 <> vw */
+  fe_avx_mul     ( vw, vw, vv    ); /* v3 = v^3 */
+  fe_avx_sq      ( vh, vw        );
+  fe_avx_mul     ( vh, vh, vv    );
+  fe_avx_mul     ( vh, vh, vu    );
+  fe_avx_pow22523( vh, vh        ); /* x = (uv^7)^((q-5)/8) */
+  fe_avx_mul     ( vh, vh, vw    );
+  fe_avx_mul     ( vh, vh, vu    ); /* x = uv^3(uv^7)^((q-5)/8) */
+
+  fe_avx_sq      ( vw, vh        ); /* vw <> vvxx */
+  fe_avx_mul     ( vw, vw, vv    );
+  fe_avx_sub     ( vv, vw, vu    ); /* vv <> vcheck */
+
+  fd_ed25519_fe_t u    [4]; fe_avx_st4( u+0,   u+1,   u+2,   u+3,   vu );
+  fd_ed25519_fe_t vxx  [4]; fe_avx_st4( vxx+0, vxx+1, vxx+2, vxx+3, vw );
+  fd_ed25519_fe_t check[4]; fe_avx_st4( check+0, check+1, check+2, check+3, vv );
+  fe_avx_st4( h0->X, h1->X, h2->X, h3->X, vh );
+
+  static fd_ed25519_fe_t const sqrtm1[1] = {{
+    { -32595792, -7943725, 9377950, 3500415, 12389472, -272473, -25146209, -2005654, 326686, 11406482 }
+  }};
+
+  fd_ed25519_ge_p3_t * h[4] = { h0, h1, h2, h3 };
+  uchar const *        s[4] = { s0, s1, s2, s3 };
+
+  for( ulong i=0UL; i<4UL; i++ ) {
+    if( fd_ed25519_fe_isnonzero( check+i ) ) { /* unclear prob */
+      fd_ed25519_fe_add( check+i, vxx+i, u+i ); /* vx^2+u */
+      if( FD_UNLIKELY( fd_ed25519_fe_isnonzero( check+i ) ) ) return FD_ED25519_ERR_PUBKEY;
+      fd_ed25519_fe_mul( h[i]->X, h[i]->X, sqrtm1 );
+    }
+    if( fd_ed25519_fe_isnegative( h[i]->X )!=(s[i][31] >> 7) ) fd_ed25519_fe_neg( h[i]->X, h[i]->X ); /* unclear prob */
+  }
+
+  fd_ed25519_fe_mul4( h0->T, h0->X, h0->Y,  h1->T, h1->X, h1->Y,
+                      h2->T, h2->X, h2->Y,  h3->T, h3->X, h3->Y );
+  return FD_ED25519_SUCCESS;
+}
+
 uchar *
 fd_ed25519_ge_tobytes( uchar *                    s,
                        fd_ed25519_ge_p2_t const * h ) {
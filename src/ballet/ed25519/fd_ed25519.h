@@ -100,6 +100,45 @@ fd_ed25519_verify( void const *  msg,
                    void const *  public_key,
                    fd_sha512_t * sha );
 
+/* fd_ed25519_verify_batch_single_msg verifies cnt signatures of the
+   same message, as is the case for the signatures of a multi-signer
+   transaction.  Every signature is checked with exactly the same
+   (strict, cofactorless) equation as fd_ed25519_verify such that the
+   set of accepted signatures is identical to verifying them one at a
+   time.  The batch computes the challenge hashes of the signatures
+   together with the multi-lane SHA-512 batch API and amortizes the
+   point decompression and the final comparison across signatures using
+   the multi-lane field arithmetic where available.
+
+   msg / sz are as in fd_ed25519_verify.  sig is assumed to point to the
+   first byte of a cnt*64 byte memory region holding the signatures
+   back to back and public_key is assumed to point to the first byte of
+   a cnt*32 byte memory region holding the corresponding public keys
+   back to back (this matches the layout of the signatures and the
+   signer account addresses in a Solana transaction).  sha is a handle
+   of a local join to a sha512 calculator.
+
+   err is either NULL or points to a cnt entry int array.  If non-NULL,
+   on return, err[i] will hold the result fd_ed25519_verify would have
+   returned for signature i.  If a batch step fails, the affected
+   signatures are re-verified individually so the failure is
+   attributed to the right signature.
+
+   Returns FD_ED25519_SUCCESS if all signatures verified successfully
+   (cnt==0 trivially succeeds) or the FD_ED25519_ERR_* code of the
+   lowest indexed failing signature otherwise.  Does no input argument
+   checking.  Same interest and sanitization semantics as
+   fd_ed25519_verify. */
+
+int
+fd_ed25519_verify_batch_single_msg( void const *  msg,
+                                    ulong         sz,
+                                    void const *  sig,
+                                    void const *  public_key,
+                                    ulong         cnt,
+                                    fd_sha512_t * sha,
+                                    int *         err );
+
 /* fd_ed25519_strerror converts an FD_ED25519_SUCCESS / FD_ED25519_ERR_*
    code into a human readable cstr.  The lifetime of the returned
    pointer is infinite.  The returned pointer is always to a non-NULL
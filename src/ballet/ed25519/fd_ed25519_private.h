@@ -68,6 +68,18 @@ int
 fd_ed25519_ge_frombytes_vartime_2( fd_ed25519_ge_p3_t * h0, uchar const * s0,   /* 32 */
                                    fd_ed25519_ge_p3_t * h1, uchar const * s1 ); /* 32 */
 
+/* fd_ed25519_ge_frombytes_vartime_4 decompresses 4 points at a time.
+   Returns FD_ED25519_SUCCESS if all 4 points decompressed successfully
+   and FD_ED25519_ERR_PUBKEY if any of them failed (h0..h3 are
+   clobbered in that case and the caller should decompress individually
+   to attribute the failure). */
+
+int
+fd_ed25519_ge_frombytes_vartime_4( fd_ed25519_ge_p3_t * h0, uchar const * s0,   /* 32 */
+                                   fd_ed25519_ge_p3_t * h1, uchar const * s1,   /* 32 */
+                                   fd_ed25519_ge_p3_t * h2, uchar const * s2,   /* 32 */
+                                   fd_ed25519_ge_p3_t * h3, uchar const * s3 ); /* 32 */
+
 int fd_ed25519_ge_p3_is_small_order(fd_ed25519_ge_p3_t * const p);
 
 static inline fd_ed25519_ge_p2_t *
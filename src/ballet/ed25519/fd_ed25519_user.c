@@ -342,31 +342,26 @@ fd_ed25519_sign( void *        sig,
   return sig;
 }
 
-int
-fd_ed25519_verify( void const *  msg,
-                   ulong         sz,
-                   void const *  sig,
-                   void const *  public_key,
-                   fd_sha512_t * sha ) {
-  uchar const * r = (uchar const *)sig;
-  uchar const * s = r + 32;
+#ifndef FD_ED25519_VERIFY_USE_2POINT
+#if FD_ED25519_FE_POW25523_2_FAST
+#define FD_ED25519_VERIFY_USE_2POINT 1
+#else
+#define FD_ED25519_VERIFY_USE_2POINT 0
+#endif
+#endif
 
-# ifndef FD_ED25519_VERIFY_USE_2POINT
-# if FD_ED25519_FE_POW25523_2_FAST
-# define FD_ED25519_VERIFY_USE_2POINT 1
-# else
-# define FD_ED25519_VERIFY_USE_2POINT 0
-# endif
-# endif
+/* fd_ed25519_private_s_check returns FD_ED25519_SUCCESS if the 32-byte
+   little endian scalar s satisfies 0 <= s < L where:
 
-  /* Check 0 <= s < L where:
+     L = 2^252 + 27742317777372353535851937790883648493
 
-       L = 2^252 + 27742317777372353535851937790883648493
+   and FD_ED25519_ERR_SIG otherwise.  If not, the signature is publicly
+   invalid.  Since it's public we can do the check in variable time. */
 
-     If not the signature is publicly invalid.  Since it's public we can
-     do the check in variable time.
+static inline int
+fd_ed25519_private_s_check( uchar const * s ) {
 
-     First check the most significant byte */
+  /* First check the most significant byte */
   /* FIXME: THIS COULD BE DONE 64-BIT AT A TIME FASTER */
 
   if( FD_UNLIKELY( s[31]> 0x10 ) ) return FD_ED25519_ERR_SIG;
@@ -376,7 +371,7 @@ fd_ed25519_verify( void const *  msg,
        the rest */
 
     static uchar const allzeroes[ 15 ];
-    if( memcmp( s+16, allzeroes, 15UL )!=0 ) return 0;
+    if( memcmp( s+16, allzeroes, 15UL )!=0 ) return FD_ED25519_ERR_SIG;
 
     /* 27742317777372353535851937790883648493 in little endian format */
     static uchar const l_low[16] = {
@@ -392,6 +387,22 @@ fd_ed25519_verify( void const *  msg,
     if( FD_UNLIKELY( i<0 ) ) return FD_ED25519_ERR_SIG;
   }
 
+  return FD_ED25519_SUCCESS;
+}
+
+/* fd_ed25519_private_verify_prehashed verifies the signature sig of
+   public_key given the (unreduced) challenge hash
+   h = SHA-512( r || public_key || msg ).  h is clobbered. */
+
+static int
+fd_ed25519_private_verify_prehashed( uchar const * sig,
+                                     uchar const * public_key,
+                                     uchar *       h ) {
+  uchar const * r = sig;
+  uchar const * s = r + 32;
+
+  if( FD_UNLIKELY( fd_ed25519_private_s_check( s ) ) ) return FD_ED25519_ERR_SIG;
+
   fd_ed25519_ge_p3_t A[1];
 
 # if FD_ED25519_VERIFY_USE_2POINT
@@ -408,9 +419,6 @@ fd_ed25519_verify( void const *  msg,
   fd_ed25519_fe_neg( A->X, A->X );
   fd_ed25519_fe_neg( A->T, A->T );
 
-  uchar h[ 64 ];
-  fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
-                  r, 32UL ), public_key, 32UL ), msg, sz ), h );
   fd_ed25519_sc_reduce( h, h );
 
   fd_ed25519_ge_p2_t R[1];
@@ -432,6 +440,160 @@ fd_ed25519_verify( void const *  msg,
 # endif
 }
 
+int
+fd_ed25519_verify( void const *  msg,
+                   ulong         sz,
+                   void const *  sig,
+                   void const *  public_key,
+                   fd_sha512_t * sha ) {
+  uchar const * r = (uchar const *)sig;
+
+  /* Reject a malformed s before paying for the hash */
+
+  if( FD_UNLIKELY( fd_ed25519_private_s_check( r + 32 ) ) ) return FD_ED25519_ERR_SIG;
+
+  uchar h[ 64 ];
+  fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                  r, 32UL ), public_key, 32UL ), msg, sz ), h );
+
+  return fd_ed25519_private_verify_prehashed( r, (uchar const *)public_key, h );
+}
+
+#if FD_ED25519_VERIFY_USE_2POINT
+
+/* fd_ed25519_private_verify_pair verifies two signatures of the same
+   message given their (unreduced) challenge hashes h0 and h1 (both
+   clobbered) with a 4-point decompression and a 4-lane final
+   comparison.  The result for each signature is stored in err0 and
+   err1.  If any of the shared steps fail, falls back to verifying each
+   signature individually such that the failure is attributed to the
+   right signature. */
+
+static void
+fd_ed25519_private_verify_pair( uchar const * sig0,
+                                uchar const * pub0,
+                                uchar *       h0,
+                                uchar const * sig1,
+                                uchar const * pub1,
+                                uchar *       h1,
+                                int *         err0,
+                                int *         err1 ) {
+  uchar const * r0 = sig0; uchar const * s0 = sig0 + 32;
+  uchar const * r1 = sig1; uchar const * s1 = sig1 + 32;
+
+  fd_ed25519_ge_p3_t A0[1]; fd_ed25519_ge_p3_t rD0[1];
+  fd_ed25519_ge_p3_t A1[1]; fd_ed25519_ge_p3_t rD1[1];
+
+  if( FD_UNLIKELY( fd_ed25519_private_s_check( s0 ) | fd_ed25519_private_s_check( s1 )                        ) ||
+      FD_UNLIKELY( fd_ed25519_ge_frombytes_vartime_4( A0, pub0, rD0, r0, A1, pub1, rD1, r1 )                    ) ||
+      FD_UNLIKELY( fd_ed25519_ge_p3_is_small_order( A0  ) | fd_ed25519_ge_p3_is_small_order( A1  ) |
+                   fd_ed25519_ge_p3_is_small_order( rD0 ) | fd_ed25519_ge_p3_is_small_order( rD1 )             ) ) {
+    *err0 = fd_ed25519_private_verify_prehashed( sig0, pub0, h0 );
+    *err1 = fd_ed25519_private_verify_prehashed( sig1, pub1, h1 );
+    return;
+  }
+
+  fd_ed25519_fe_neg( A0->X, A0->X ); fd_ed25519_fe_neg( A0->T, A0->T );
+  fd_ed25519_fe_neg( A1->X, A1->X ); fd_ed25519_fe_neg( A1->T, A1->T );
+
+  fd_ed25519_sc_reduce( h0, h0 );
+  fd_ed25519_sc_reduce( h1, h1 );
+
+  fd_ed25519_ge_p2_t R0[1]; fd_ed25519_ge_double_scalarmult_vartime( R0, h0, A0, s0 );
+  fd_ed25519_ge_p2_t R1[1]; fd_ed25519_ge_double_scalarmult_vartime( R1, h1, A1, s1 );
+
+  /* Comparison (see fd_ed25519_private_verify_prehashed):
+       r.x * R.Z == R.X
+       r.y * R.Z == R.Y */
+
+  fd_ed25519_fe_t x_Z0; fd_ed25519_fe_t y_Z0;
+  fd_ed25519_fe_t x_Z1; fd_ed25519_fe_t y_Z1;
+  fd_ed25519_fe_mul4( &x_Z0, R0->Z, rD0->X, &y_Z0, R0->Z, rD0->Y,
+                      &x_Z1, R1->Z, rD1->X, &y_Z1, R1->Z, rD1->Y );
+  *err0 = (memcmp( &x_Z0, R0->X, 32UL ) | memcmp( &y_Z0, R0->Y, 32UL )) ? FD_ED25519_ERR_MSG : FD_ED25519_SUCCESS;
+  *err1 = (memcmp( &x_Z1, R1->X, 32UL ) | memcmp( &y_Z1, R1->Y, 32UL )) ? FD_ED25519_ERR_MSG : FD_ED25519_SUCCESS;
+}
+
+#endif /* FD_ED25519_VERIFY_USE_2POINT */
+
+/* FD_ED25519_PRIVATE_HASH_BATCH_{CNT,MSG_MAX} control how challenge
+   hashes are computed by fd_ed25519_verify_batch_single_msg.  Up to
+   HASH_BATCH_CNT challenge hashes are computed at a time with the
+   multi-lane SHA-512 batch API.  As the batch API needs each hash
+   input contiguous in memory, r || public_key || msg is staged into a
+   scratch region for messages up to HASH_BATCH_MSG_MAX bytes (the
+   Solana transaction MTU).  Larger messages (and lone signatures) are
+   hashed one signature at a time with sha. */
+
+#define FD_ED25519_PRIVATE_HASH_BATCH_CNT     (8UL)
+#define FD_ED25519_PRIVATE_HASH_BATCH_MSG_MAX (1232UL)
+
+int
+fd_ed25519_verify_batch_single_msg( void const *  msg,
+                                    ulong         sz,
+                                    void const *  sig,
+                                    void const *  public_key,
+                                    ulong         cnt,
+                                    fd_sha512_t * sha,
+                                    int *         err ) {
+  uchar const * sig_i = (uchar const *)sig;
+  uchar const * pub_i = (uchar const *)public_key;
+
+  int   first_err = FD_ED25519_SUCCESS;
+  ulong i         = 0UL;
+
+  uchar h[ FD_ED25519_PRIVATE_HASH_BATCH_CNT ][ 64 ];
+
+  uchar scratch[ FD_ED25519_PRIVATE_HASH_BATCH_CNT*(64UL+FD_ED25519_PRIVATE_HASH_BATCH_MSG_MAX) ];
+  uchar batch_mem[ FD_SHA512_BATCH_FOOTPRINT ] __attribute__((aligned(FD_SHA512_BATCH_ALIGN)));
+
+  while( i<cnt ) {
+    ulong blk_cnt = fd_ulong_min( cnt-i, FD_ED25519_PRIVATE_HASH_BATCH_CNT );
+
+    /* Compute the challenge hashes for this block of signatures */
+
+    if( FD_LIKELY( (blk_cnt>1UL) & (sz<=FD_ED25519_PRIVATE_HASH_BATCH_MSG_MAX) ) ) {
+      fd_sha512_batch_t * batch = fd_sha512_batch_init( batch_mem );
+      uchar * in = scratch;
+      for( ulong j=0UL; j<blk_cnt; j++ ) {
+        fd_memcpy( in,       sig_i + 64UL*j, 32UL );
+        fd_memcpy( in+32UL,  pub_i + 32UL*j, 32UL );
+        fd_memcpy( in+64UL,  msg,            sz   );
+        fd_sha512_batch_add( batch, in, 64UL+sz, h[j] );
+        in += 64UL+sz;
+      }
+      fd_sha512_batch_fini( batch );
+    } else {
+      for( ulong j=0UL; j<blk_cnt; j++ )
+        fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                        sig_i + 64UL*j, 32UL ), pub_i + 32UL*j, 32UL ), msg, sz ), h[j] );
+    }
+
+    /* Verify the signatures of this block */
+
+    ulong j = 0UL;
+
+#   if FD_ED25519_VERIFY_USE_2POINT
+    for( ; j+2UL<=blk_cnt; j+=2UL ) {
+      int err0; int err1;
+      fd_ed25519_private_verify_pair( sig_i, pub_i, h[j], sig_i+64UL, pub_i+32UL, h[j+1UL], &err0, &err1 );
+      if( err ) { err[i] = err0; err[i+1UL] = err1; }
+      if( FD_UNLIKELY( (err0|err1) && !first_err ) ) first_err = err0 ? err0 : err1;
+      sig_i += 128UL; pub_i += 64UL; i += 2UL;
+    }
+#   endif
+
+    for( ; j<blk_cnt; j++ ) {
+      int err_i = fd_ed25519_private_verify_prehashed( sig_i, pub_i, h[j] );
+      if( err ) err[i] = err_i;
+      if( FD_UNLIKELY( err_i && !first_err ) ) first_err = err_i;
+      sig_i += 64UL; pub_i += 32UL; i++;
+    }
+  }
+
+  return first_err;
+}
+
 char const *
 fd_ed25519_strerror( int err ) {
   switch( err ) {
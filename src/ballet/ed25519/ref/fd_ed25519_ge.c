@@ -363,6 +363,15 @@ fd_ed25519_ge_frombytes_vartime_2( fd_ed25519_ge_p3_t * h0, uchar const * s0,
   return FD_ED25519_SUCCESS;
 }
 
+int
+fd_ed25519_ge_frombytes_vartime_4( fd_ed25519_ge_p3_t * h0, uchar const * s0,
+                                   fd_ed25519_ge_p3_t * h1, uchar const * s1,
+                                   fd_ed25519_ge_p3_t * h2, uchar const * s2,
+                                   fd_ed25519_ge_p3_t * h3, uchar const * s3 ) {
+  int err = fd_ed25519_ge_frombytes_vartime_2( h0, s0, h1, s1 ); if( FD_UNLIKELY( err ) ) return err;
+  return    fd_ed25519_ge_frombytes_vartime_2( h2, s2, h3, s3 );
+}
+
 uchar *
 fd_ed25519_ge_tobytes( uchar *                    s,
                        fd_ed25519_ge_p2_t const * h ) {
@@ -778,6 +778,84 @@ test_verify( fd_rng_t *    rng,
   }
 }
 
+#define TEST_VERIFY_BATCH_MAX (8UL)
+
+static void
+test_verify_batch( fd_rng_t *    rng,
+                   fd_sha512_t * sha ) {
+  uchar _msg[ 1024                        ]; uchar * msg = _msg;
+  uchar _pub[   32*TEST_VERIFY_BATCH_MAX ]; uchar * pub = _pub;
+  uchar _sig[   64*TEST_VERIFY_BATCH_MAX ]; uchar * sig = _sig;
+  uchar _prv[   32*TEST_VERIFY_BATCH_MAX ]; uchar * prv = _prv;
+  int   err[       TEST_VERIFY_BATCH_MAX ];
+
+  /* Batch results should match fd_ed25519_verify signature by
+     signature, including under corruption */
+
+  for( ulong rem=2000UL; rem; rem-- ) {
+    ulong sz  = (ulong)fd_rng_uint_roll( rng, 1025U );
+    ulong cnt = (ulong)fd_rng_uint_roll( rng, (uint)TEST_VERIFY_BATCH_MAX+1U );
+    for( ulong b=0UL; b<sz; b++ ) msg[b] = fd_rng_uchar( rng );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      fd_ed25519_public_from_private( pub+32UL*i, fd_rng_b256( rng, prv+32UL*i ), sha );
+      fd_ed25519_sign( sig+64UL*i, msg, sz, pub+32UL*i, prv+32UL*i, sha );
+
+      uint r = fd_rng_uint( rng );
+      if( !(r & 7U) ) {
+        ulong idx = (ulong)fd_rng_uint_roll( rng, 512U );
+        sig[ 64UL*i + (idx>>3) ] = (uchar)(((ulong)sig[ 64UL*i + (idx>>3) ]) ^ (1UL<<(idx & 7UL)));
+      }
+      r >>= 3;
+      if( !(r & 7U) ) {
+        ulong idx = (ulong)fd_rng_uint_roll( rng, 256U );
+        pub[ 32UL*i + (idx>>3) ] = (uchar)(((ulong)pub[ 32UL*i + (idx>>3) ]) ^ (1UL<<(idx & 7UL)));
+      }
+    }
+
+    int first_err = FD_ED25519_SUCCESS;
+    int batch_err = fd_ed25519_verify_batch_single_msg( msg, sz, sig, pub, cnt, sha, err );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      int ref_err = fd_ed25519_verify( msg, sz, sig+64UL*i, pub+32UL*i, sha );
+      FD_TEST( err[i]==ref_err );
+      if( ref_err && !first_err ) first_err = ref_err;
+    }
+    FD_TEST( batch_err==first_err );
+    FD_TEST( fd_ed25519_verify_batch_single_msg( msg, sz, sig, pub, cnt, sha, NULL )==first_err );
+  }
+
+  /* Benchmark against one fd_ed25519_verify per signature */
+
+  ulong sz = 256UL;
+  for( ulong b=0UL; b<sz; b++ ) msg[b] = fd_rng_uchar( rng );
+  for( ulong i=0UL; i<TEST_VERIFY_BATCH_MAX; i++ ) {
+    fd_ed25519_public_from_private( pub+32UL*i, fd_rng_b256( rng, prv+32UL*i ), sha );
+    fd_ed25519_sign( sig+64UL*i, msg, sz, pub+32UL*i, prv+32UL*i, sha );
+  }
+
+  ulong iter = 2000UL;
+  for( ulong cnt=1UL; cnt<=TEST_VERIFY_BATCH_MAX; cnt<<=1 ) {
+    char cstr[128];
+
+    long dt = fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      FD_COMPILER_FORGET( sig ); FD_COMPILER_FORGET( msg ); FD_COMPILER_FORGET( pub ); FD_COMPILER_FORGET( sha );
+      for( ulong i=0UL; i<cnt; i++ ) FD_TEST( !fd_ed25519_verify( msg, sz, sig+64UL*i, pub+32UL*i, sha ) );
+    }
+    dt = fd_log_wallclock() - dt;
+    log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_verify(x%lu)", cnt ), iter*cnt, dt );
+
+    dt = fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      FD_COMPILER_FORGET( sig ); FD_COMPILER_FORGET( msg ); FD_COMPILER_FORGET( pub ); FD_COMPILER_FORGET( sha );
+      FD_TEST( !fd_ed25519_verify_batch_single_msg( msg, sz, sig, pub, cnt, sha, NULL ) );
+    }
+    dt = fd_log_wallclock() - dt;
+    log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_verify_batch(x%lu)", cnt ), iter*cnt, dt );
+  }
+}
+
+#undef TEST_VERIFY_BATCH_MAX
+
 /**********************************************************************/
 
 int
@@ -810,6 +888,7 @@ main( int     argc,
   test_public_from_private( rng, sha );
   test_sign               ( rng, sha );
   test_verify             ( rng, sha );
+  test_verify_batch       ( rng, sha );
 
   fd_sha512_delete( fd_sha512_leave( sha ) );
   fd_rng_delete( fd_rng_leave( rng ) );
@@ -7,7 +7,9 @@
 #include "ed25519/fd_ed25519.h" /* Includes sha512/fd_sha512.h */
 #include "poh/fd_poh.h"         /* Includes sha256/fd_sha256.h */
 #include "shred/fd_shred.h"
+#include "reedsol/fd_reedsol.h"
 #include "bmtree/fd_bmtree.h"   /* Includes sha256/fd_sha256.h */
 #include "blake3/fd_blake3.h"
+#include "aes/fd_aes.h"
 
 #endif /* HEADER_fd_src_ballet_fd_ballet_h */
@@ -0,0 +1,217 @@
+#include "../fd_ballet.h"
+#include "fd_pack.h"
+#include "fd_compute_budget_program.h"
+
+/* bench_pack measures the scheduling throughput of fd_pack with a deep
+   pool of pending transactions.  The pool is kept topped up at
+   --pack-depth transactions by inserting a fresh transaction for each
+   one scheduled.  Transactions have a unique writable fee payer,
+   --write-cnt writable and --read-cnt readonly accounts drawn uniformly
+   from a universe of --acct-cnt accounts, a random compute budget in
+   [--cu-min,--cu-max] and a random priority fee.  Only the time spent
+   in fd_pack_schedule_next_microblock is counted. */
+
+#define TEMPLATE_CNT (4096UL)
+
+static uchar template_payload[ TEMPLATE_CNT ][ FD_TPU_MTU    ];
+static uchar template_txn    [ TEMPLATE_CNT ][ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+static ulong template_sz     [ TEMPLATE_CNT ];
+
+static const char WORK_PROGRAM_ID[ FD_TXN_ACCT_ADDR_SZ ] = "Bench Program Id Consumes CU....";
+
+static fd_txn_p_t out[ 1024 ];
+
+/* make_acct_addr populates addr with the address of account idx of the
+   account universe.  Addresses are pseudo random. */
+
+static void
+make_acct_addr( uchar * addr,
+                ulong   idx ) {
+  for( ulong j=0UL; j<FD_TXN_ACCT_ADDR_SZ/8UL; j++ ) FD_STORE( ulong, addr+8UL*j, fd_ulong_hash( (idx<<2) | j ) );
+}
+
+/* make_template makes a legacy transaction with 1 signature (the fee
+   payer, patched on insert), write_cnt writable accounts, the compute
+   budget program, the work program and read_cnt readonly accounts.
+   The first instruction is a compute budget RequestUnitsDeprecated
+   instruction, the second is an instruction to the work program. */
+
+static void
+make_template( ulong      t,
+               ulong      write_cnt,
+               ulong      read_cnt,
+               ulong      acct_cnt,
+               uint       cu_min,
+               uint       cu_max,
+               fd_rng_t * rng ) {
+  uchar *    p      = template_payload[ t ];
+  uchar *    p_base = p;
+  fd_txn_t * txn    = (fd_txn_t *)template_txn[ t ];
+
+  *(p++) = (uchar)1;
+  memset( p, 0, FD_TXN_SIGNATURE_SZ ); p += FD_TXN_SIGNATURE_SZ;
+
+  txn->transaction_version   = FD_TXN_VLEGACY;
+  txn->signature_cnt         = 1;
+  txn->signature_off         = 1;
+  txn->message_off           = FD_TXN_SIGNATURE_SZ+1UL;
+  txn->readonly_signed_cnt   = 0;
+  txn->readonly_unsigned_cnt = (uchar)(read_cnt + 2UL);
+  txn->acct_addr_cnt         = (ushort)(1UL + write_cnt + 2UL + read_cnt);
+  txn->acct_addr_off         = FD_TXN_SIGNATURE_SZ+1UL;
+
+  /* Fee payer (patched on insert) */
+  memset( p, 0, FD_TXN_ACCT_ADDR_SZ ); p += FD_TXN_ACCT_ADDR_SZ;
+  for( ulong i=0UL; i<write_cnt; i++ ) { make_acct_addr( p, fd_rng_ulong_roll( rng, acct_cnt ) ); p += FD_TXN_ACCT_ADDR_SZ; }
+  fd_memcpy( p, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ ); p += FD_TXN_ACCT_ADDR_SZ;
+  fd_memcpy( p, WORK_PROGRAM_ID,              FD_TXN_ACCT_ADDR_SZ ); p += FD_TXN_ACCT_ADDR_SZ;
+  for( ulong i=0UL; i<read_cnt;  i++ ) { make_acct_addr( p, fd_rng_ulong_roll( rng, acct_cnt ) ); p += FD_TXN_ACCT_ADDR_SZ; }
+
+  txn->recent_blockhash_off         = 0;
+  txn->addr_table_lookup_cnt        = 0;
+  txn->addr_table_adtl_writable_cnt = 0;
+  txn->addr_table_adtl_cnt          = 0;
+  txn->instr_cnt                    = 2;
+
+  uchar prog_start = (uchar)(1UL+write_cnt);
+
+  uint compute = cu_min + fd_rng_uint_roll( rng, cu_max-cu_min+1U );
+  uint rewards = fd_rng_uint_roll( rng, 1000000U );
+
+  txn->instr[ 0 ].program_id = prog_start;
+  txn->instr[ 0 ].acct_cnt   = 0;
+  txn->instr[ 0 ].data_sz    = 9;
+  txn->instr[ 0 ].acct_off   = (ushort)(p - p_base);
+  txn->instr[ 0 ].data_off   = (ushort)(p - p_base);
+  *p = '\0'; fd_memcpy( p+1, &compute, sizeof(uint) ); fd_memcpy( p+5, &rewards, sizeof(uint) );
+  p += 9UL;
+
+  txn->instr[ 1 ].program_id = (uchar)(prog_start + 1);
+  txn->instr[ 1 ].acct_cnt   = 0;
+  txn->instr[ 1 ].data_sz    = 1;
+  txn->instr[ 1 ].acct_off   = (ushort)(p - p_base);
+  txn->instr[ 1 ].data_off   = (ushort)(p - p_base);
+  *(p++) = (uchar)0;
+
+  template_sz[ t ] = (ulong)(p - p_base);
+}
+
+/* insert inserts a copy of a random template with a unique signature
+   and fee payer derived from txn_idx. */
+
+static void
+insert( fd_pack_t * pack,
+        ulong       txn_idx,
+        fd_rng_t *  rng ) {
+  ulong        t    = fd_rng_ulong_roll( rng, TEMPLATE_CNT );
+  fd_txn_p_t * slot = fd_pack_insert_txn_init( pack );
+  fd_txn_t *   txn  = (fd_txn_t *)template_txn[ t ];
+
+  fd_memcpy( slot->payload, template_payload[ t ], template_sz[ t ] );
+  fd_memcpy( TXN(slot),     txn,                   fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
+  slot->payload_sz = template_sz[ t ];
+
+  FD_STORE( ulong, slot->payload + 1UL, txn_idx );
+  make_acct_addr( slot->payload + txn->acct_addr_off, ~txn_idx );
+
+  fd_pack_insert_txn_fini( pack, slot );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz       = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",        NULL, "gigantic" );
+  ulong        page_cnt       = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",       NULL, 0UL        );
+  ulong        numa_idx       = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx",       NULL, fd_shmem_numa_idx( 0UL ) );
+  ulong        pack_depth     = fd_env_strip_cmdline_ulong( &argc, &argv, "--pack-depth",     NULL, 1000000UL  );
+  ulong        gap            = fd_env_strip_cmdline_ulong( &argc, &argv, "--gap",            NULL, 1UL        );
+  ulong        max_txn        = fd_env_strip_cmdline_ulong( &argc, &argv, "--max-txn",        NULL, 31UL       );
+  ulong        acct_cnt       = fd_env_strip_cmdline_ulong( &argc, &argv, "--acct-cnt",       NULL, 100000UL   );
+  ulong        write_cnt      = fd_env_strip_cmdline_ulong( &argc, &argv, "--write-cnt",      NULL, 2UL        );
+  ulong        read_cnt       = fd_env_strip_cmdline_ulong( &argc, &argv, "--read-cnt",       NULL, 2UL        );
+  uint         cu_min         = fd_env_strip_cmdline_uint ( &argc, &argv, "--cu-min",         NULL, 1000U      );
+  uint         cu_max         = fd_env_strip_cmdline_uint ( &argc, &argv, "--cu-max",         NULL, 200000U    );
+  ulong        microblock_cus = fd_env_strip_cmdline_ulong( &argc, &argv, "--microblock-cus", NULL, 1500000UL  );
+  ulong        iter_cnt       = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt",       NULL, 100000UL   );
+  uint         seed           = fd_env_strip_cmdline_uint ( &argc, &argv, "--seed",           NULL, 0U         );
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz                                  ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+  if( FD_UNLIKELY( !max_txn || max_txn>1024UL                ) ) FD_LOG_ERR(( "--max-txn should be in [1,1024]" ));
+  if( FD_UNLIKELY( !acct_cnt                                 ) ) FD_LOG_ERR(( "--acct-cnt should be positive" ));
+  if( FD_UNLIKELY( write_cnt+read_cnt+3UL>FD_TXN_ACCT_ADDR_MAX ) ) FD_LOG_ERR(( "too many accounts per transaction" ));
+  if( FD_UNLIKELY( (cu_min>cu_max) | (cu_max>FD_COMPUTE_BUDGET_MAX_CU_LIMIT) ) ) FD_LOG_ERR(( "bad --cu-min / --cu-max" ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
+
+  ulong footprint = fd_pack_footprint( pack_depth, gap, max_txn );
+  if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "bad --pack-depth / --gap / --max-txn" ));
+  if( !page_cnt ) page_cnt = (footprint + footprint/8UL + FD_SHMEM_HUGE_PAGE_SZ + page_sz - 1UL) / page_sz; /* with room for wksp overhead */
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu) for a %lu byte pack",
+                  page_cnt, _page_sz, numa_idx, footprint ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_pack_align(), footprint, 1UL );
+  if( FD_UNLIKELY( !mem ) ) FD_LOG_ERR(( "workspace too small; increase --page-cnt" ));
+
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( mem, pack_depth, gap, max_txn, rng ) );
+  FD_TEST( pack );
+
+  FD_LOG_NOTICE(( "Making %lu templates (--acct-cnt %lu --write-cnt %lu --read-cnt %lu --cu-min %u --cu-max %u)",
+                  TEMPLATE_CNT, acct_cnt, write_cnt, read_cnt, cu_min, cu_max ));
+  for( ulong t=0UL; t<TEMPLATE_CNT; t++ ) make_template( t, write_cnt, read_cnt, acct_cnt, cu_min, cu_max, rng );
+
+  FD_LOG_NOTICE(( "Filling pack to --pack-depth %lu", pack_depth ));
+  ulong txn_idx = 0UL;
+  long  dt      = -fd_log_wallclock();
+  while( fd_pack_avail_txn_cnt( pack )<pack_depth ) insert( pack, txn_idx++, rng );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "%.3f M insert/s", 1e3*(double)pack_depth/(double)dt ));
+
+  FD_LOG_NOTICE(( "Scheduling (--gap %lu --max-txn %lu --microblock-cus %lu --iter-cnt %lu)",
+                  gap, max_txn, microblock_cus, iter_cnt ));
+
+  ulong microblock_cnt = 0UL;
+  ulong block_cnt      = 0UL;
+  ulong sched_txn_cnt  = 0UL;
+  ulong sched_cus      = 0UL;
+  long  sched_dt       = 0L;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    long tic = fd_log_wallclock();
+    ulong cnt = fd_pack_schedule_next_microblock( pack, microblock_cus, 0.0f, out );
+    sched_dt += fd_log_wallclock() - tic;
+
+    microblock_cnt++;
+    sched_txn_cnt += cnt;
+    for( ulong i=0UL; i<cnt; i++ ) {
+      fd_txn_t * txn = TXN( out+i );
+      /* The compute budget instruction of the template */
+      uint compute; fd_memcpy( &compute, out[i].payload + txn->instr[0].data_off + 1UL, sizeof(uint) );
+      sched_cus += (ulong)compute;
+    }
+
+    /* Block is full (or everything conflicts), start a new one */
+    if( FD_UNLIKELY( !cnt ) ) { fd_pack_end_block( pack ); block_cnt++; }
+
+    for( ulong i=0UL; i<cnt; i++ ) insert( pack, txn_idx++, rng );
+  }
+
+  double ns = (double)sched_dt;
+  FD_LOG_NOTICE(( "%lu microblocks (%lu blocks), %lu txn, %.1f txn/microblock",
+                  microblock_cnt, block_cnt, sched_txn_cnt, (double)sched_txn_cnt/(double)microblock_cnt ));
+  FD_LOG_NOTICE(( "%.3f K microblock/s, %.3f M txn/s, %.3f G requested CU/s scheduled (%.1f ns/microblock)",
+                  1e6*(double)microblock_cnt/ns, 1e3*(double)sched_txn_cnt/ns, (double)sched_cus/ns, ns/(double)microblock_cnt ));
+
+  fd_pack_clear_all( pack );
+  fd_wksp_free_laddr( fd_pack_delete( fd_pack_leave( pack ) ) );
+  fd_wksp_delete_anonymous( wksp );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -10,6 +10,43 @@
    structures. */
 
 
+/* Account conflicts are checked in two stages.  Each account address
+   is hashed to a slot of a direct mapped filter, which records until
+   when any account that maps to the slot is read or written by a
+   transaction in flight.  Checking whether a transaction might conflict
+   with anything in flight takes a hash and a load per account.  If
+   none of its slots are in use, the transaction definitely doesn't
+   conflict.  Otherwise, there is either a real conflict or a hash
+   collision, and the authoritative acct_uses maps are consulted to
+   find out which.  The filter has FD_PACK_FILTER_SPARSITY slots per
+   account that can be in flight at once (max_acct_in_flight), so it
+   stays mostly empty for any gap and max_txn_per_microblock. */
+#ifndef FD_PACK_FILTER_SPARSITY
+#define FD_PACK_FILTER_SPARSITY 4UL
+#endif
+
+/* Similarly, the per-account write cost limit only needs to be checked
+   exactly if the transaction writes an account whose cumulative write
+   cost is within FD_PACK_FILTER_COST_SLACK of the limit or if the
+   transaction itself costs more than FD_PACK_FILTER_COST_SLACK. */
+#define FD_PACK_FILTER_COST_SLACK (FD_PACK_MAX_WRITE_COST_PER_ACCT/4UL)
+
+/* fd_pack_filter_slot_t: A slot of the filter.  Times are in filter
+   microblocks (filter_seq below), which unlike microblock_cnt don't
+   restart with each block, so the filter never needs to be cleared.
+   The comparisons are done modulo 2^32.  A slot that hasn't been
+   touched for 2^31 microblocks can then look in use again, which is
+   only a spurious trip to the maps. */
+struct fd_pack_private_filter_slot {
+  uint r_until;    /* Read by a transaction in flight before this */
+  uint w_until;    /* Written by a transaction in flight before this */
+  uint wcost_hot;  /* filter_block of the last block in which the write
+                      cost of an account mapping here came within
+                      FD_PACK_FILTER_COST_SLACK of the limit */
+};
+typedef struct fd_pack_private_filter_slot fd_pack_filter_slot_t;
+
+
 /* fd_pack_ord_txn_t: An fd_txn_p_t with information required to order
    it by priority */
 struct fd_pack_private_ord_txn {
@@ -126,6 +163,23 @@ typedef struct fd_pack_sig_to_txn fd_pack_sig_to_txn_t;
 
 static const fd_acct_addr_t null_addr = { 0 };
 
+/* fd_pack_private_filter_idx returns the slot of a filter with
+   filter_mask+1 slots that account address acct maps to.  Uses
+   different bytes than the acct_uses map hash so that map collisions
+   and filter collisions are independent. */
+static inline ulong
+fd_pack_private_filter_idx( fd_acct_addr_t acct,
+                            ulong          filter_mask ) {
+  return fd_ulong_hash( fd_ulong_load_8( acct.b+8UL ) ) & filter_mask;
+}
+
+/* fd_pack_private_filter_lg_sz returns the log2 of the number of slots
+   of the filter. */
+FD_FN_CONST static inline int
+fd_pack_private_filter_lg_sz( ulong max_acct_in_flight ) {
+  return fd_ulong_find_msb( fd_ulong_pow2_up( FD_PACK_FILTER_SPARSITY*max_acct_in_flight ) );
+}
+
 #define MAP_NAME              acct_uses
 #define MAP_T                 fd_pack_addr_use_t
 #define MAP_KEY_T             fd_acct_addr_t
@@ -189,6 +243,29 @@ struct fd_pack_private {
   fd_pack_addr_use_t   * write_in_use;
   fd_pack_addr_use_t   * writer_costs;
   fd_pack_sig_to_txn_t * signature_map; /* Stores pointers into pool for deleting by signature */
+
+  /* expire_acct[ (m%gap)*expire_max + i ] for i in [0,expire_cnt[ m%gap ])
+     are the addresses of the accounts that transactions scheduled in
+     microblock m inserted or refreshed in {read,write}_in_use, where
+     expire_max is FD_TXN_ACCT_ADDR_MAX*max_txn_per_microblock.  When
+     microblock m+gap starts, these entries no longer cause conflicts,
+     so they are removed from the maps (unless refreshed since).  This
+     keeps the number of entries in the maps bounded by
+     max_acct_in_flight no matter how many microblocks a block has. */
+  fd_acct_addr_t       * expire_acct;
+  ulong                  expire_cnt[ FD_PACK_MAX_GAP ];
+
+  /* The filter summary (see FD_PACK_FILTER_SPARSITY) of the above
+     maps, with filter_mask+1 slots.  It is a superset of the accounts
+     in use, so it can only produce false conflicts (which are resolved
+     using the maps).  filter_seq is the filter time of the microblock
+     being scheduled, and advances by gap at the end of a block so that
+     everything in flight expires.  filter_block is incremented at the
+     end of each block. */
+  fd_pack_filter_slot_t * filter;
+  ulong                   filter_mask;
+  uint                    filter_seq;
+  uint                    filter_block;
 };
 
 typedef struct fd_pack_private fd_pack_t;
@@ -207,6 +284,7 @@ fd_pack_footprint( ulong pack_depth,
   int lg_uses_tbl_sz = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_acct_in_flight ) );
   int lg_max_txn     = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_txn_per_block  ) );
   int lg_depth       = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*pack_depth         ) );
+  int lg_filter_sz   = fd_pack_private_filter_lg_sz( max_acct_in_flight );
 
   l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, FD_PACK_ALIGN,      sizeof(fd_pack_t)                      );
@@ -215,6 +293,8 @@ fd_pack_footprint( ulong pack_depth,
   l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_uses_tbl_sz )  );
   l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_max_txn     )  );
   l = FD_LAYOUT_APPEND( l, sig2txn_align  (),  sig2txn_footprint  ( lg_depth       )  );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_acct_addr_t), gap*FD_TXN_ACCT_ADDR_MAX*max_txn_per_microblock*sizeof(fd_acct_addr_t) );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_pack_filter_slot_t), sizeof(fd_pack_filter_slot_t)<<lg_filter_sz );
   return FD_LAYOUT_FINI( l, FD_PACK_ALIGN );
 }
 
@@ -233,6 +313,7 @@ fd_pack_new( void *     mem,
   int lg_uses_tbl_sz = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_acct_in_flight ) );
   int lg_max_txn     = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_txn_per_block  ) );
   int lg_depth       = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*pack_depth         ) );
+  int lg_filter_sz   = fd_pack_private_filter_lg_sz( max_acct_in_flight );
 
   FD_SCRATCH_ALLOC_INIT( l, mem );
   /* The pool has one extra element that is used between insert_init and
@@ -243,6 +324,8 @@ fd_pack_new( void *     mem,
   void * _uses_write = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),              acct_uses_footprint( lg_uses_tbl_sz ) );
   void * _writer_cost= FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),              acct_uses_footprint( lg_max_txn     ) );
   void * _sig_map    = FD_SCRATCH_ALLOC_APPEND( l,  sig2txn_align(),                sig2txn_footprint  ( lg_depth       ) );
+  FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_acct_addr_t), gap*FD_TXN_ACCT_ADDR_MAX*max_txn_per_microblock*sizeof(fd_acct_addr_t) );
+  void * _filter     = FD_SCRATCH_ALLOC_APPEND( l,  alignof(fd_pack_filter_slot_t), sizeof(fd_pack_filter_slot_t)<<lg_filter_sz );
 
   pack->pack_depth             = pack_depth;
   pack->gap                    = gap;
@@ -253,6 +336,15 @@ fd_pack_new( void *     mem,
   pack->cumulative_block_cost  = 0UL;
   pack->cumulative_vote_cost   = 0UL;
 
+  for( ulong i=0UL; i<FD_PACK_MAX_GAP; i++ ) pack->expire_cnt[ i ] = 0UL;
+
+  /* Zeroed slots are neither in use (as filter_seq starts at gap) nor
+     hot (as filter_block starts at 1). */
+  fd_memset( _filter, 0, sizeof(fd_pack_filter_slot_t)<<lg_filter_sz );
+  pack->filter_mask  = (1UL<<lg_filter_sz)-1UL;
+  pack->filter_seq   = (uint)gap;
+  pack->filter_block = 1U;
+
   treap_new( (void*)pack->pending,       pack_depth );
   treap_new( (void*)pack->pending_votes, pack_depth );
   for( ulong i=0UL; i<FD_PACK_MAX_GAP; i++ ) treap_new( (void*)(pack->delayed+i), pack_depth );
@@ -285,6 +377,7 @@ fd_pack_join( void * mem ) {
   int lg_uses_tbl_sz = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_acct_in_flight ) );
   int lg_max_txn     = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_txn_per_block  ) );
   int lg_depth       = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*pack_depth         ) );
+  int lg_filter_sz   = fd_pack_private_filter_lg_sz( max_acct_in_flight );
 
 
   pack->pool          = trp_pool_join(  FD_SCRATCH_ALLOC_APPEND( l,  trp_pool_align(),  trp_pool_footprint ( pack_depth+1UL ) ) );
@@ -292,6 +385,10 @@ fd_pack_join( void * mem ) {
   pack->write_in_use  = acct_uses_join( FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(), acct_uses_footprint( lg_uses_tbl_sz ) ) );
   pack->writer_costs  = acct_uses_join( FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(), acct_uses_footprint( lg_max_txn     ) ) );
   pack->signature_map = sig2txn_join(   FD_SCRATCH_ALLOC_APPEND( l,  sig2txn_align(),   sig2txn_footprint  ( lg_depth       ) ) );
+  pack->expire_acct   = (fd_acct_addr_t *)FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_acct_addr_t),
+                                                                  gap*FD_TXN_ACCT_ADDR_MAX*max_txn_per_microblock*sizeof(fd_acct_addr_t) );
+  pack->filter        = (fd_pack_filter_slot_t *)FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_pack_filter_slot_t),
+                                                                         sizeof(fd_pack_filter_slot_t)<<lg_filter_sz );
 
   return pack;
 }
@@ -423,11 +520,62 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
     treap_ele_insert( pack->pending,       ord, pack->pool );
 }
 
+/* fd_pack_private_txn_p_copy copies the transaction in src to dst.
+   Only the bytes that are used are copied: payload_sz bytes of the
+   payload and the footprint of the parsed transaction, rather than the
+   whole ~2.5 kB fd_txn_p_t.  Typical transactions are a few hundred
+   bytes, so this is several times less memory traffic per scheduled
+   transaction. */
+
+static inline void
+fd_pack_private_txn_p_copy( fd_txn_p_t       * dst,
+                            fd_txn_p_t const * src ) {
+  fd_txn_t const * txn = TXN(src);
+  fd_memcpy( dst->payload, src->payload, src->payload_sz                                         );
+  fd_memcpy( TXN(dst),     txn,          fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
+  dst->payload_sz     = src->payload_sz;
+  dst->meta           = src->meta;
+  dst->is_simple_vote = src->is_simple_vote;
+}
+
 typedef struct {
   ulong cus_scheduled;
   ulong txns_scheduled;
 } sched_return_t;
 
+/* fd_pack_private_filter_may_conflict returns 0 if ord definitely
+   doesn't conflict with any account in use and can be scheduled
+   without exceeding any per account write cost limit.  Returns 1 if it
+   might not be, in which case the acct_uses maps must be checked. */
+
+FD_FN_PURE static inline int
+fd_pack_private_filter_may_conflict( fd_pack_t const         * pack,
+                                     fd_pack_ord_txn_t       * ord ) {
+  if( FD_UNLIKELY( ord->compute_est>FD_PACK_FILTER_COST_SLACK ) ) return 1;
+
+  fd_pack_filter_slot_t const * filter = pack->filter;
+  ulong                         mask   = pack->filter_mask;
+  uint                          seq    = pack->filter_seq;
+  uint                          block  = pack->filter_block;
+
+  fd_txn_t *             txn  = TXN(ord->txn);
+  fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, ord->txn->payload );
+
+  int conflict = 0;
+  fd_txn_acct_iter_t ctrl[1];
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    fd_pack_filter_slot_t const * slot = filter + fd_pack_private_filter_idx( acct[i], mask );
+    conflict |= ((int)(slot->r_until-seq)>0) | ((int)(slot->w_until-seq)>0) | (slot->wcost_hot==block);
+  }
+  for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+      i=fd_txn_acct_iter_next( i, ctrl ) ) {
+    fd_pack_filter_slot_t const * slot = filter + fd_pack_private_filter_idx( acct[i], mask );
+    conflict |= ((int)(slot->w_until-seq)>0);
+  }
+  return conflict;
+}
+
 static inline sched_return_t
 fd_pack_schedule_next_microblock_impl( fd_pack_t  * pack,
                                        treap_t    * sched_from,
@@ -464,36 +612,42 @@ fd_pack_schedule_next_microblock_impl( fd_pack_t  * pack,
     }
 
     fd_txn_acct_iter_t ctrl[1];
-    /* Check conflicts between this transactions's writable accounts and
-       current readers */
-    for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
-        i=fd_txn_acct_iter_next( i, ctrl ) ) {
-
-      fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct[i], NULL );
-      if( in_wcost_table && in_wcost_table->total_cost+cur->compute_est > FD_PACK_MAX_WRITE_COST_PER_ACCT ) {
-        /* Can't be scheduled until the next block */
-        delay_until = ULONG_MAX;
-        break;
-      }
 
-      fd_pack_addr_use_t * in_r_table = acct_uses_query( read_in_use, acct[i], NULL );
-      if( in_r_table ) { delay_until = fd_ulong_max( delay_until, in_r_table->in_use_until );
+    /* Most transactions don't conflict with anything in flight, which
+       the filter can confirm cheaply.  Otherwise, find out exactly
+       when this transaction can be scheduled from the maps. */
+    if( fd_pack_private_filter_may_conflict( pack, cur ) ) {
+      /* Check conflicts between this transactions's writable accounts and
+         current readers */
+      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+          i=fd_txn_acct_iter_next( i, ctrl ) ) {
+
+        fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct[i], NULL );
+        if( in_wcost_table && in_wcost_table->total_cost+cur->compute_est > FD_PACK_MAX_WRITE_COST_PER_ACCT ) {
+          /* Can't be scheduled until the next block */
+          delay_until = ULONG_MAX;
+          break;
+        }
+
+        fd_pack_addr_use_t * in_r_table = acct_uses_query( read_in_use, acct[i], NULL );
+        if( in_r_table ) { delay_until = fd_ulong_max( delay_until, in_r_table->in_use_until );
 #if DETAILED_LOGGING
-        FD_LOG_NOTICE(( "Stalling transaction until >= %lu because it writes %i which another transaction taken reads", delay_until, (int)acct[i].b[0] ));
+          FD_LOG_NOTICE(( "Stalling transaction until >= %lu because it writes %i which another transaction taken reads", delay_until, (int)acct[i].b[0] ));
 #endif
+        }
       }
-    }
 
-    /* Check conflicts between all of this transactions's accounts and
-       current writers */
-    for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
-        i=fd_txn_acct_iter_next( i, ctrl ) ) {
+      /* Check conflicts between all of this transactions's accounts and
+         current writers */
+      for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
+          i=fd_txn_acct_iter_next( i, ctrl ) ) {
 
-      fd_pack_addr_use_t * in_w_table = acct_uses_query( write_in_use,  acct[i], NULL );
-      if( in_w_table ) { delay_until = fd_ulong_max( delay_until, in_w_table->in_use_until );
+        fd_pack_addr_use_t * in_w_table = acct_uses_query( write_in_use,  acct[i], NULL );
+        if( in_w_table ) { delay_until = fd_ulong_max( delay_until, in_w_table->in_use_until );
 #if DETAILED_LOGGING
-        FD_LOG_NOTICE(( "Stalling transaction until >= %lu because it reads or writes %i which another transaction taken writes", delay_until, (int)acct[i].b[0] ));
+          FD_LOG_NOTICE(( "Stalling transaction until >= %lu because it reads or writes %i which another transaction taken writes", delay_until, (int)acct[i].b[0] ));
 #endif
+        }
       }
     }
 
@@ -504,10 +658,17 @@ fd_pack_schedule_next_microblock_impl( fd_pack_t  * pack,
       cu_limit -= cur->compute_est;
       txn_limit--;
 
-      *out++ = *cur->txn; /* TODO: this copies more bytes than necessary in most cases */
+      fd_pack_private_txn_p_copy( out++, cur->txn );
 
       ulong in_use_until = pack->microblock_cnt + gap;
 
+      fd_acct_addr_t * expire_acct = pack->expire_acct + (pack->microblock_cnt % gap)*FD_TXN_ACCT_ADDR_MAX*pack->max_txn_per_microblock;
+      ulong *          expire_cnt  = pack->expire_cnt  + (pack->microblock_cnt % gap);
+
+      fd_pack_filter_slot_t * filter       = pack->filter;
+      ulong                   filter_mask  = pack->filter_mask;
+      uint                    filter_until = pack->filter_seq + (uint)gap;
+
       for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
           i=fd_txn_acct_iter_next( i, ctrl ) ) {
         fd_acct_addr_t acct_addr = acct[i];
@@ -515,19 +676,27 @@ fd_pack_schedule_next_microblock_impl( fd_pack_t  * pack,
         fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct_addr, NULL );
         if( !in_wcost_table ) { in_wcost_table = acct_uses_insert( writer_costs, acct_addr );   in_wcost_table->total_cost = 0UL; }
         in_wcost_table->total_cost += cur->compute_est;
+        fd_pack_filter_slot_t * slot = filter + fd_pack_private_filter_idx( acct_addr, filter_mask );
+        slot->w_until = filter_until;
+        if( FD_UNLIKELY( in_wcost_table->total_cost+FD_PACK_FILTER_COST_SLACK > FD_PACK_MAX_WRITE_COST_PER_ACCT ) )
+          slot->wcost_hot = pack->filter_block;
 
         fd_pack_addr_use_t * in_w_table = acct_uses_query( write_in_use,  acct_addr, NULL );
         if( !in_w_table ) in_w_table = acct_uses_insert( write_in_use, acct_addr );
         in_w_table->in_use_until = in_use_until;
+        expire_acct[ (*expire_cnt)++ ] = acct_addr;
 
       }
       for( ulong i=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM, ctrl ); i<fd_txn_acct_iter_end();
           i=fd_txn_acct_iter_next( i, ctrl ) ) {
         fd_acct_addr_t acct_addr = acct[i];
 
+        filter[ fd_pack_private_filter_idx( acct_addr, filter_mask ) ].r_until = filter_until;
+
         fd_pack_addr_use_t * in_r_table = acct_uses_query( read_in_use, acct_addr, NULL );
         if( !in_r_table ) in_r_table = acct_uses_insert( read_in_use, acct_addr );
         in_r_table->in_use_until = in_use_until;
+        expire_acct[ (*expire_cnt)++ ] = acct_addr;
       }
 
       fd_ed25519_sig_t const * sig0 = fd_txn_get_signatures( txn, cur->txn->payload );
@@ -554,6 +723,29 @@ fd_pack_schedule_next_microblock_impl( fd_pack_t  * pack,
 
 
 
+/* fd_pack_private_expire removes the map entries added by microblock
+   pack->microblock_cnt-gap that haven't been refreshed since, as they
+   can no longer cause conflicts.  The expire list of that microblock is
+   then reused for microblock pack->microblock_cnt. */
+
+static void
+fd_pack_private_expire( fd_pack_t * pack ) {
+  ulong                microblock_cnt = pack->microblock_cnt;
+  ulong                slot           = microblock_cnt % pack->gap;
+  fd_acct_addr_t *     expire_acct    = pack->expire_acct + slot*FD_TXN_ACCT_ADDR_MAX*pack->max_txn_per_microblock;
+  ulong                expire_cnt     = pack->expire_cnt[ slot ];
+  fd_pack_addr_use_t * read_in_use    = pack->read_in_use;
+  fd_pack_addr_use_t * write_in_use   = pack->write_in_use;
+
+  for( ulong i=0UL; i<expire_cnt; i++ ) {
+    fd_pack_addr_use_t * in_r_table = acct_uses_query( read_in_use,  expire_acct[ i ], NULL );
+    if( in_r_table && in_r_table->in_use_until<=microblock_cnt ) acct_uses_remove( read_in_use,  in_r_table );
+    fd_pack_addr_use_t * in_w_table = acct_uses_query( write_in_use, expire_acct[ i ], NULL );
+    if( in_w_table && in_w_table->in_use_until<=microblock_cnt ) acct_uses_remove( write_in_use, in_w_table );
+  }
+  pack->expire_cnt[ slot ] = 0UL;
+}
+
 ulong
 fd_pack_schedule_next_microblock( fd_pack_t *  pack,
                                   ulong        total_cus,
@@ -565,6 +757,8 @@ fd_pack_schedule_next_microblock( fd_pack_t *  pack,
      pending so they'll be reconsidered. */
   treap_merge( pack->pending, pack->delayed+(pack->microblock_cnt % FD_PACK_MAX_GAP), pack->pool );
 
+  fd_pack_private_expire( pack );
+
 
   /* TODO: Decide if these are exactly how we want to handle limits */
   total_cus = fd_ulong_min( total_cus, FD_PACK_MAX_COST_PER_BLOCK - pack->cumulative_block_cost );
@@ -605,10 +799,36 @@ fd_pack_schedule_next_microblock( fd_pack_t *  pack,
   pack->cumulative_block_cost += status.cus_scheduled;
 
   pack->microblock_cnt++;
+  pack->filter_seq++;
 
   return scheduled;
 }
 
+ulong
+fd_pack_schedule_next_microblocks( fd_pack_t *          pack,
+                                   ulong                bank_cnt,
+                                   ulong const *        bank_cus,
+                                   float                vote_fraction,
+                                   fd_txn_p_t * const * out,
+                                   ulong *              out_cnt ) {
+  if( FD_UNLIKELY( (bank_cnt<1UL) | (bank_cnt>pack->gap) ) ) {
+    FD_LOG_WARNING(( "bank_cnt %lu not in [1, gap=%lu]", bank_cnt, pack->gap ));
+    for( ulong i=0UL; i<bank_cnt; i++ ) out_cnt[ i ] = 0UL;
+    return 0UL;
+  }
+
+  /* Each of these is scheduled as the next microblock, so accounts used
+     by bank i's microblock stay in use for the following gap-1
+     microblocks, which includes all the other banks' microblocks. */
+  ulong scheduled = 0UL;
+  for( ulong i=0UL; i<bank_cnt; i++ ) {
+    if( FD_UNLIKELY( !bank_cus[ i ] ) ) { out_cnt[ i ] = 0UL; continue; }
+    out_cnt[ i ] = fd_pack_schedule_next_microblock( pack, bank_cus[ i ], vote_fraction, out[ i ] );
+    scheduled   += out_cnt[ i ];
+  }
+  return scheduled;
+}
+
 ulong fd_pack_avail_txn_cnt( fd_pack_t * pack ) { return pack->pending_txn_cnt; }
 ulong fd_pack_gap          ( fd_pack_t * pack ) { return pack->gap;             }
 
@@ -623,6 +843,10 @@ fd_pack_end_block( fd_pack_t * pack ) {
   acct_uses_clear( pack->read_in_use  );
   acct_uses_clear( pack->write_in_use );
   acct_uses_clear( pack->writer_costs );
+
+  for( ulong i=0UL; i<FD_PACK_MAX_GAP; i++ ) pack->expire_cnt[ i ] = 0UL;
+  pack->filter_seq += (uint)pack->gap;
+  pack->filter_block++;
 }
 
 static void
@@ -652,6 +876,10 @@ fd_pack_clear_all( fd_pack_t * pack ) {
   acct_uses_clear( pack->write_in_use );
   acct_uses_clear( pack->writer_costs );
 
+  for( ulong i=0UL; i<FD_PACK_MAX_GAP; i++ ) pack->expire_cnt[ i ] = 0UL;
+  pack->filter_seq += (uint)pack->gap;
+  pack->filter_block++;
+
   sig2txn_clear( pack->signature_map );
 }
 
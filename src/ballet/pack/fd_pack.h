@@ -119,6 +119,10 @@ FD_FN_PURE ulong fd_pack_gap( fd_pack_t * pack );
    The txn pointer passed to _fini or _cancel must come from the most
    recent call to _init.
 
+   Before calling _fini, the caller must populate the payload (and
+   payload_sz, which must be at most FD_TPU_MTU), the parsed
+   transaction (accessed with the TXN macro) and, if used, meta.
+
    The caller of these methods should not retain any read or write
    interest in the transaction after _fini or _cancel have been called.
 
@@ -134,7 +138,11 @@ void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn );
    microblock, which is a set of non-conflicting transactions.
 
    pack must be a local join of a pack object.  Transactions part of the
-   scheduled microblock are copied to out in no particular order.  The
+   scheduled microblock are copied to out in no particular order.  Only
+   the first payload_sz bytes of the payload and the footprint of the
+   parsed transaction of each fd_txn_p_t in out are written (along with
+   payload_sz, meta and is_simple_vote); the remaining bytes are left
+   untouched.  The
    cumulative cost of these transactions will not excede total_cus, and
    the number of transactions will not excede the value of
    max_txn_per_microblock given in fd_pack_new.
@@ -149,6 +157,37 @@ void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn );
 
 ulong fd_pack_schedule_next_microblock( fd_pack_t * pack, ulong total_cus, float vote_fraction, fd_txn_p_t * out );
 
+/* fd_pack_schedule_next_microblocks schedules up to bank_cnt
+   microblocks at once, one for each downstream bank, so that all the
+   banks can execute concurrently.  bank_cnt must be in [1, gap], where
+   gap is the value given in fd_pack_new.
+
+   For each i in [0, bank_cnt), bank_cus[ i ] is the CU budget of bank
+   i's microblock.  Banks with a budget of 0 (e.g. because they are
+   busy) are skipped: they get an empty microblock and don't consume
+   any of the gap.  Otherwise, the transactions of bank i's microblock
+   are copied to out[ i ] (which must have space for
+   max_txn_per_microblock transactions) as in
+   fd_pack_schedule_next_microblock, with total_cus=bank_cus[ i ].  The
+   number of transactions in bank i's microblock is stored in
+   out_cnt[ i ].
+
+   The microblocks are scheduled in bank order as consecutive
+   microblocks, so account uses are tracked exactly as above, and since
+   bank_cnt<=gap, no transaction in any of these microblocks conflicts
+   with a transaction in any other one (or in any of the gap-1
+   microblocks scheduled previously).  Returns the total number of
+   transactions scheduled.  Logs a warning and returns 0 (with
+   out_cnt[ i ]==0 for all i) if bank_cnt is not in [1, gap]. */
+
+ulong
+fd_pack_schedule_next_microblocks( fd_pack_t *          pack,
+                                   ulong                bank_cnt,
+                                   ulong const *        bank_cus,
+                                   float                vote_fraction,
+                                   fd_txn_p_t * const * out,
+                                   ulong *              out_cnt );
+
 /* fd_pack_delete_txn removes a transaction (identified by its first
    signature) from the pool of available transactions.  Returns 1 if the
    transaction was found (and then removed) and 0 if not. */
@@ -164,6 +164,7 @@ make_vote_transaction( ulong i ) {
   p[ 0x45+(i%8) ] = (uchar)(p[ 0x45+(i%8) ] + 1UL + (i/8));
   p[ 0x65+(i%8) ] = (uchar)(p[ 0x65+(i%8) ] + 1UL + (i/8));
   fd_txn_parse( p, sample_vote_sz, txn_scratch[i], NULL );
+  payload_sz[ i ] = sample_vote_sz;
 }
 
 static void
@@ -172,6 +173,7 @@ insert( ulong i,
   fd_txn_p_t * slot       = fd_pack_insert_txn_init( pack );
   fd_txn_t *   txn        = (fd_txn_t*) txn_scratch[ i ];
   fd_memcpy( slot->payload, payload_scratch[ i ], payload_sz[ i ] );
+  slot->payload_sz = payload_sz[ i ];
   fd_memcpy( TXN(slot),     txn,     fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
 
   fd_pack_insert_txn_fini( pack, slot );
@@ -179,6 +181,13 @@ insert( ulong i,
 
 
 
+static ulong
+validate_microblock( fd_pack_t *        pack,
+                     fd_txn_p_t const * results,
+                     ulong              txn_cnt,
+                     ulong              min_rewards,
+                     pack_outcome_t *   outcome );
+
 static void
 schedule_validate_microblock( fd_pack_t * pack,
                               ulong total_cus,
@@ -198,15 +207,30 @@ schedule_validate_microblock( fd_pack_t * pack,
   FD_TEST( txn_cnt >= min_txns );
   FD_TEST( pre_txn_cnt-post_txn_cnt == txn_cnt );
 
+  validate_microblock( pack, outcome->results, txn_cnt, min_rewards, outcome );
+}
+
+/* validate_microblock checks that the txn_cnt transactions in results,
+   which pack scheduled as its next microblock, don't conflict with each
+   other or with the transactions in the previous gap-1 microblocks, and
+   records its accounts in outcome.  Returns the sum of the requested
+   compute of the transactions. */
+static ulong
+validate_microblock( fd_pack_t *        pack,
+                     fd_txn_p_t const * results,
+                     ulong              txn_cnt,
+                     ulong              min_rewards,
+                     pack_outcome_t *   outcome ) {
   ulong total_rewards = 0UL;
+  ulong total_compute = 0UL;
 
 
   aset_t  read_accts = aset_null( );
   aset_t write_accts = aset_null( );
 
   for( ulong i=0UL; i<txn_cnt; i++ ) {
-    fd_txn_p_t * txnp = outcome->results+i;
-    fd_txn_t   * txn  = TXN(txnp);
+    fd_txn_p_t const * txnp = results+i;
+    fd_txn_t         * txn  = TXN(txnp);
 
     fd_compute_budget_program_state_t cbp;
     fd_compute_budget_program_init( &cbp );
@@ -220,6 +244,7 @@ schedule_validate_microblock( fd_pack_t * pack,
     } /* else it's a vote */
 
     total_rewards += rewards;
+    total_compute += compute;
 
     fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, txnp->payload );
     fd_txn_acct_iter_t ctrl[1];
@@ -256,6 +281,7 @@ schedule_validate_microblock( fd_pack_t * pack,
   outcome->w_accts_in_use[ mb ] = write_accts;
 
   outcome->microblock_cnt++;
+  return total_compute;
 }
 
 void test0( void ) {
@@ -406,6 +432,7 @@ void performance_test( void ) {
     fd_txn_p_t * slot       = fd_pack_insert_txn_init( pack );
     fd_txn_t *   txn        = (fd_txn_t*) txn_scratch[ j&1 ];
     fd_memcpy( slot->payload, payload_scratch[ j&1 ], payload_sz[ j&1 ]                                              );
+    slot->payload_sz = payload_sz[ j&1 ];
     fd_memcpy( TXN(slot),     txn,                    fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
 
     fd_pack_insert_txn_fini( pack, slot );
@@ -430,6 +457,7 @@ void heap_overflow_test( void ) {
     fd_txn_p_t * slot       = fd_pack_insert_txn_init( pack );
     fd_txn_t *   txn        = (fd_txn_t*) txn_scratch[ j ];
     fd_memcpy( slot->payload, payload_scratch[ j ], payload_sz[ j ]                                                );
+    slot->payload_sz = payload_sz[ j ];
     fd_memcpy( TXN(slot),     txn,                  fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
 
     fd_pack_insert_txn_fini( pack, slot );
@@ -444,6 +472,7 @@ void heap_overflow_test( void ) {
     fd_txn_p_t * slot       = fd_pack_insert_txn_init( pack );
     fd_txn_t *   txn        = (fd_txn_t*) txn_scratch[ 1UL ];
     fd_memcpy( slot->payload, payload_scratch[ 1UL ], payload_sz[ 1UL ]                                              );
+    slot->payload_sz = payload_sz[ 1UL ];
     fd_memcpy( TXN(slot),     txn,                    fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
 
     fd_pack_insert_txn_fini( pack, slot );
@@ -587,6 +616,68 @@ test_limits( void ) {
   }
 }
 
+static void
+test_multi_bank( void ) {
+  FD_LOG_NOTICE(( "TEST MULTI BANK" ));
+
+  static fd_txn_p_t bank_results[ FD_PACK_MAX_GAP ][ 16UL ];
+  fd_txn_p_t * out   [ FD_PACK_MAX_GAP ];
+  ulong        out_cnt [ FD_PACK_MAX_GAP ];
+  ulong        bank_cus[ FD_PACK_MAX_GAP ];
+  for( ulong i=0UL; i<FD_PACK_MAX_GAP; i++ ) out[ i ] = bank_results[ i ];
+
+  char const accts[] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+  for( ulong bank_cnt=1UL; bank_cnt<=8UL; bank_cnt++ ) {
+    fd_pack_t * pack = init_all( 1024UL, bank_cnt, 16UL, &outcome );
+
+    ulong i=0UL;
+    for( ulong round=0UL; round<64UL; round++ ) {
+      /* Keep pack full of transactions that conflict often */
+      while( fd_pack_avail_txn_cnt( pack )<512UL ) {
+        /* 4 distinct accounts, 2 written and 2 read */
+        ulong a0 = fd_rng_ulong_roll( rng, sizeof(accts)-1UL );
+        ulong a1 = (a0 + 1UL + fd_rng_ulong_roll( rng, 5UL ))%(sizeof(accts)-1UL);
+        ulong a2 = (a0 + 6UL + fd_rng_ulong_roll( rng, 6UL ))%(sizeof(accts)-1UL);
+        ulong a3 = (a0 +12UL + fd_rng_ulong_roll( rng, 6UL ))%(sizeof(accts)-1UL);
+        char writes[3] = { accts[ a0 ], accts[ a2 ], '\0' };
+        char reads [3] = { accts[ a1 ], accts[ a3 ], '\0' };
+        ulong k = i++ % MAX_TEST_TXNS;
+        make_transaction( k, 1000U + fd_rng_uint_roll( rng, 100000U ), 10.0, writes, reads );
+        payload_scratch[ k ][ 1+8 ] = (uchar)(i/MAX_TEST_TXNS); /* Keep signatures unique */
+        insert( k, pack );
+      }
+
+      /* Random per-bank budgets, occasionally 0 for a busy bank */
+      for( ulong b=0UL; b<bank_cnt; b++ ) bank_cus[ b ] = fd_ulong_if( fd_rng_uint_roll( rng, 4U )==0U, 0UL,
+                                                                        100000UL + fd_rng_ulong_roll( rng, 400000UL ) );
+
+      ulong pre_txn_cnt = fd_pack_avail_txn_cnt( pack );
+      ulong sched_cnt   = fd_pack_schedule_next_microblocks( pack, bank_cnt, bank_cus, 0.0f, out, out_cnt );
+      FD_TEST( pre_txn_cnt-fd_pack_avail_txn_cnt( pack )==sched_cnt );
+
+      /* The microblocks of all the banks are outstanding at the same
+         time, so none of them can conflict with another one. */
+      ulong sum = 0UL;
+      for( ulong b=0UL; b<bank_cnt; b++ ) {
+        sum += out_cnt[ b ];
+        if( !bank_cus[ b ] ) { FD_TEST( !out_cnt[ b ] ); continue; }
+        FD_TEST( out_cnt[ b ]<=16UL );
+        FD_TEST( validate_microblock( pack, out[ b ], out_cnt[ b ], 0UL, &outcome )<=bank_cus[ b ] );
+      }
+      FD_TEST( sum==sched_cnt );
+
+      if( !(round%16UL) ) {
+        fd_pack_end_block( pack );
+        outcome.microblock_cnt = 0UL;
+        for( ulong j=0UL; j<FD_PACK_MAX_GAP; j++ ) {
+          outcome.r_accts_in_use[ j ] = aset_null( );
+          outcome.w_accts_in_use[ j ] = aset_null( );
+        }
+      }
+    }
+  }
+}
+
 
 int
 main( int     argc,
@@ -603,6 +694,7 @@ main( int     argc,
   test_delete();
   test_gap();
   test_limits();
+  test_multi_bank();
 
   fd_rng_delete( fd_rng_leave( rng ) );
 
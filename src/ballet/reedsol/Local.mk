@@ -0,0 +1,4 @@
+$(call add-hdrs,fd_reedsol.h)
+$(call add-objs,fd_reedsol,fd_ballet)
+$(call make-unit-test,test_reedsol,test_reedsol,fd_ballet fd_util)
+$(call run-unit-test,test_reedsol,)
@@ -0,0 +1,341 @@
+#include "fd_reedsol.h"
+
+#if FD_HAS_AVX
+#include "../../util/simd/fd_avx.h"
+#endif
+
+FD_STATIC_ASSERT( FD_REEDSOL_ALIGN    ==alignof(fd_reedsol_t), unit_test );
+FD_STATIC_ASSERT( FD_REEDSOL_FOOTPRINT==sizeof (fd_reedsol_t), unit_test );
+
+#include "table/fd_reedsol_gf_tbl.c"
+
+/* fd_reedsol_private_gemm sets out[j][k] = sum_i coef[j][i] in[i][k]
+   over GF(2^8) for j in [0,out_cnt), i in [0,in_cnt) and k in [0,sz).
+   coef rows have a stride of FD_REEDSOL_DATA_SHREDS_MAX.  in_cnt is in
+   [1,FD_REEDSOL_DATA_SHREDS_MAX].  The outputs should not overlap the
+   inputs.  Outputs are computed one at a time, 128 bytes at a time,
+   such that the accumulators stay in registers and the inputs are
+   streamed from cache once per output. */
+
+static void
+fd_reedsol_private_gemm( ulong                 sz,
+                         ulong                 in_cnt,
+                         uchar const * const * in,
+                         ulong                 out_cnt,
+                         uchar * const *       out,
+                         uchar const *         coef ) {
+  uchar const * tbl[ FD_REEDSOL_DATA_SHREDS_MAX ];
+
+  for( ulong j=0UL; j<out_cnt; j++ ) {
+    uchar const * row = coef + j*FD_REEDSOL_DATA_SHREDS_MAX;
+    uchar *       o   = out[j];
+    for( ulong i=0UL; i<in_cnt; i++ ) tbl[i] = fd_reedsol_private_nib[ row[i] ];
+
+    ulong off = 0UL;
+
+#   if FD_HAS_AVX
+    wb_t mask = wb_bcast( (uchar)0x0F );
+
+#   define TBL_LD( t ) _mm256_broadcastsi128_si256( _mm_load_si128( (__m128i const *)(t) ) )
+
+#   define MUL_ACC( a, x ) do {                                                          \
+      wb_t _x = (x);                                                                     \
+      (a) = wb_xor( (a), wb_xor( _mm256_shuffle_epi8( lo, wb_and( _x, mask ) ),          \
+                                 _mm256_shuffle_epi8( hi, wb_shr( _x, 4 )    ) ) );      \
+    } while(0)
+
+    for( ; off+128UL<=sz; off+=128UL ) {
+      wb_t a0 = wb_zero(); wb_t a1 = wb_zero(); wb_t a2 = wb_zero(); wb_t a3 = wb_zero();
+      for( ulong i=0UL; i<in_cnt; i++ ) {
+        wb_t          lo = TBL_LD( tbl[i]       );
+        wb_t          hi = TBL_LD( tbl[i]+16UL );
+        uchar const * p  = in[i] + off;
+        MUL_ACC( a0, wb_ldu( p       ) );
+        MUL_ACC( a1, wb_ldu( p+ 32UL ) );
+        MUL_ACC( a2, wb_ldu( p+ 64UL ) );
+        MUL_ACC( a3, wb_ldu( p+ 96UL ) );
+      }
+      wb_stu( o+off,       a0 );
+      wb_stu( o+off+ 32UL, a1 );
+      wb_stu( o+off+ 64UL, a2 );
+      wb_stu( o+off+ 96UL, a3 );
+    }
+
+    for( ; off+32UL<=sz; off+=32UL ) {
+      wb_t a0 = wb_zero();
+      for( ulong i=0UL; i<in_cnt; i++ ) {
+        wb_t lo = TBL_LD( tbl[i]       );
+        wb_t hi = TBL_LD( tbl[i]+16UL );
+        MUL_ACC( a0, wb_ldu( in[i] + off ) );
+      }
+      wb_stu( o+off, a0 );
+    }
+
+#   undef MUL_ACC
+#   undef TBL_LD
+#   endif
+
+    for( ; off<sz; off++ ) {
+      uint a = 0U;
+      for( ulong i=0UL; i<in_cnt; i++ ) {
+        uint x = (uint)in[i][off];
+        a ^= (uint)tbl[i][ x & 15U ] ^ (uint)tbl[i][ 16U + (x>>4) ];
+      }
+      o[off] = (uchar)a;
+    }
+  }
+}
+
+/* FD_REEDSOL_PRIVATE_ROW_MAX is the stride of the matrices used to
+   solve for erased data shreds.  It holds an augmented row of
+   2*FD_REEDSOL_DATA_SHREDS_MAX bytes rounded up to a multiple of 32. */
+
+#define FD_REEDSOL_PRIVATE_ROW_MAX (160UL)
+
+/* fd_reedsol_private_axpy does y[k] ^= a*x[k] and
+   fd_reedsol_private_scal does x[k] = a*x[k] over GF(2^8) for k in
+   [0,n).  n is a multiple of 32 and x and y are 32 byte aligned. */
+
+static inline void
+fd_reedsol_private_axpy( uchar *       y,
+                         uchar const * x,
+                         uint          a,
+                         ulong         n ) {
+  uchar const * t = fd_reedsol_private_nib[ a ];
+# if FD_HAS_AVX
+  wb_t mask = wb_bcast( (uchar)0x0F );
+  wb_t lo   = _mm256_broadcastsi128_si256( _mm_load_si128( (__m128i const *) t       ) );
+  wb_t hi   = _mm256_broadcastsi128_si256( _mm_load_si128( (__m128i const *)(t+16UL) ) );
+  for( ulong k=0UL; k<n; k+=32UL ) {
+    wb_t v = wb_ld( x+k );
+    wb_st( y+k, wb_xor( wb_ld( y+k ), wb_xor( _mm256_shuffle_epi8( lo, wb_and( v, mask ) ),
+                                              _mm256_shuffle_epi8( hi, wb_shr( v, 4 ) ) ) ) );
+  }
+# else
+  for( ulong k=0UL; k<n; k++ ) y[k] = (uchar)((uint)y[k] ^ (uint)t[ x[k] & 15 ] ^ (uint)t[ 16 + (x[k]>>4) ]);
+# endif
+}
+
+static inline void
+fd_reedsol_private_scal( uchar * x,
+                         uint    a,
+                         ulong   n ) {
+  uchar const * t = fd_reedsol_private_nib[ a ];
+# if FD_HAS_AVX
+  wb_t mask = wb_bcast( (uchar)0x0F );
+  wb_t lo   = _mm256_broadcastsi128_si256( _mm_load_si128( (__m128i const *) t       ) );
+  wb_t hi   = _mm256_broadcastsi128_si256( _mm_load_si128( (__m128i const *)(t+16UL) ) );
+  for( ulong k=0UL; k<n; k+=32UL ) {
+    wb_t v = wb_ld( x+k );
+    wb_st( x+k, wb_xor( _mm256_shuffle_epi8( lo, wb_and( v, mask ) ), _mm256_shuffle_epi8( hi, wb_shr( v, 4 ) ) ) );
+  }
+# else
+  for( ulong k=0UL; k<n; k++ ) x[k] = (uchar)((uint)t[ x[k] & 15 ] ^ (uint)t[ 16 + (x[k]>>4) ]);
+# endif
+}
+
+/* fd_reedsol_private_lagrange_logd sets logd[c], c in [0,d), to the
+   logarithm of prod_{m!=c} (c+m), the denominator of the Lagrange basis
+   polynomial of the point c over the points [0,d).  (Addition in
+   GF(2^8) is xor.) */
+
+static void
+fd_reedsol_private_lagrange_logd( ulong  d,
+                                  uint * logd ) {
+  for( ulong c=0UL; c<d; c++ ) {
+    ulong l = 0UL;
+    for( ulong m=0UL; m<d; m++ ) if( m!=c ) l += (ulong)fd_reedsol_private_log[ c ^ m ];
+    logd[c] = (uint)(l % 255UL);
+  }
+}
+
+/* fd_reedsol_private_lagrange_row sets row[c], c in [0,d), to the value
+   of the Lagrange basis polynomial of the point c over the points
+   [0,d) at the point x in [d,256).  This is the row x of V inv(V_top).
+   logd is as computed by fd_reedsol_private_lagrange_logd. */
+
+static void
+fd_reedsol_private_lagrange_row( ulong        d,
+                                 ulong        x,
+                                 uint const * logd,
+                                 uchar *      row ) {
+  ulong logp = 0UL;
+  for( ulong m=0UL; m<d; m++ ) logp += (ulong)fd_reedsol_private_log[ x ^ m ];
+  logp %= 255UL;
+  for( ulong c=0UL; c<d; c++ ) {
+    ulong l = logp + 2UL*255UL - (ulong)fd_reedsol_private_log[ x ^ c ] - (ulong)logd[c];
+    row[c] = fd_reedsol_private_exp[ l % 255UL ];
+  }
+}
+
+void
+fd_reedsol_encode_fini( fd_reedsol_t * rs ) {
+  ulong d = rs->data_shred_cnt;
+  ulong p = rs->parity_shred_cnt;
+
+  uint  logd[ FD_REEDSOL_DATA_SHREDS_MAX ];
+  uchar coef[ FD_REEDSOL_PARITY_SHREDS_MAX*FD_REEDSOL_DATA_SHREDS_MAX ];
+
+  fd_reedsol_private_lagrange_logd( d, logd );
+  for( ulong j=0UL; j<p; j++ ) fd_reedsol_private_lagrange_row( d, d+j, logd, coef + j*FD_REEDSOL_DATA_SHREDS_MAX );
+
+  fd_reedsol_private_gemm( rs->shred_sz, d, rs->encode.data_shred, p, rs->encode.parity_shred, coef );
+}
+
+/* FD_REEDSOL_PRIVATE_CHECK_SZ is the chunk size used to check received
+   shreds that were not needed for recovery against the recovered FEC
+   set. */
+
+#define FD_REEDSOL_PRIVATE_CHECK_SZ (1024UL)
+
+int
+fd_reedsol_recover_fini( fd_reedsol_t * rs ) {
+  ulong   sz     = rs->shred_sz;
+  ulong   d      = rs->data_shred_cnt;
+  ulong   p      = rs->parity_shred_cnt;
+  uchar * const * shred  = rs->recover.shred;
+  uchar const *   erased = rs->recover.erased;
+
+  ulong rcvd_cnt = 0UL;
+  for( ulong s=0UL; s<d+p; s++ ) rcvd_cnt += (ulong)!erased[s];
+  if( FD_UNLIKELY( rcvd_cnt<d ) ) return FD_REEDSOL_ERR_PARTIAL;
+
+  uint logd[ FD_REEDSOL_DATA_SHREDS_MAX ];
+  fd_reedsol_private_lagrange_logd( d, logd );
+
+  /* Gather the e erased data shreds and the first e received parity
+     shreds.  The remaining received parity shreds are only used to check
+     consistency. */
+
+  ulong era[ FD_REEDSOL_DATA_SHREDS_MAX   ]; ulong era_cnt = 0UL;
+  ulong par[ FD_REEDSOL_PARITY_SHREDS_MAX ]; ulong par_cnt = 0UL;
+  for( ulong c=0UL; c<d; c++ ) if( erased[c] ) era[ era_cnt++ ] = c;
+  for( ulong x=d; (x<d+p) & (par_cnt<era_cnt); x++ ) if( !erased[x] ) par[ par_cnt++ ] = x;
+  ulong e = era_cnt;
+
+  uchar coef[ FD_REEDSOL_PARITY_SHREDS_MAX*FD_REEDSOL_DATA_SHREDS_MAX ];
+
+  if( e ) {
+
+    /* Received parity shred x is sum_c L_c(x) D_c.  Moving the terms
+       of the received data shreds to the left hand side gives e
+       equations in the e erased data shreds, with matrix
+       M[a][b] = L_era[b](par[a]).  Thus D_era = inv(M) ( R_par +
+       L_known D_known ), i.e. the recovered data shreds are linear
+       combinations of the e selected parity shreds (coefficients inv(M))
+       and the d-e received data shreds (coefficients inv(M) L_known). */
+
+    /* The matrix is inverted by Gauss-Jordan elimination on the
+       augmented rows [ M | I ], which live in aug with a stride of
+       FD_REEDSOL_PRIVATE_ROW_MAX and are zero padded to a multiple of 32
+       bytes (w) such that row operations are whole vectors.  M is a
+       square submatrix of the parity rows of the generator of an MDS
+       code and thus always invertible, the check is defensive. */
+
+    uchar lrow[ FD_REEDSOL_DATA_SHREDS_MAX*FD_REEDSOL_PRIVATE_ROW_MAX ] __attribute__((aligned(32))); /* lrow[a][c] = L_c(par[a]) */
+    uchar aug [ FD_REEDSOL_DATA_SHREDS_MAX*FD_REEDSOL_PRIVATE_ROW_MAX ] __attribute__((aligned(32)));
+    uchar tmp [ FD_REEDSOL_PRIVATE_ROW_MAX ] __attribute__((aligned(32)));
+#   define LROW(a) (lrow + (a)*FD_REEDSOL_PRIVATE_ROW_MAX)
+#   define AUG(a)  (aug  + (a)*FD_REEDSOL_PRIVATE_ROW_MAX)
+
+    ulong w  = fd_ulong_align_up( 2UL*e, 32UL );
+    ulong wd = fd_ulong_align_up( d,     32UL );
+    for( ulong a=0UL; a<e; a++ ) {
+      uchar * l = LROW(a);
+      uchar * r = AUG(a);
+      fd_reedsol_private_lagrange_row( d, par[a], logd, l );
+      fd_memset( l+d, 0, wd-d );
+      fd_memset( r,   0, w    );
+      for( ulong b=0UL; b<e; b++ ) r[b] = l[ era[b] ];
+      r[e+a] = (uchar)1;
+    }
+
+    for( ulong col=0UL; col<e; col++ ) {
+      ulong piv = col;
+      while( (piv<e) && !AUG(piv)[col] ) piv++;
+      if( FD_UNLIKELY( piv==e ) ) return FD_REEDSOL_ERR_INCONSISTENT;
+      if( piv!=col ) {
+        fd_memcpy( tmp,      AUG(col), w );
+        fd_memcpy( AUG(col), AUG(piv), w );
+        fd_memcpy( AUG(piv), tmp,      w );
+      }
+      uchar * r = AUG(col);
+      fd_reedsol_private_scal( r, fd_reedsol_private_exp[ 255U - (uint)fd_reedsol_private_log[ r[col] ] ], w );
+      for( ulong a=0UL; a<e; a++ ) if( (a!=col) & (!!AUG(a)[col]) ) fd_reedsol_private_axpy( AUG(a), r, AUG(a)[col], w );
+    }
+
+    uchar const * in[ FD_REEDSOL_DATA_SHREDS_MAX ];
+    uchar *       out[ FD_REEDSOL_DATA_SHREDS_MAX ];
+    ulong         in_cnt = 0UL;
+    for( ulong a=0UL; a<e; a++ ) in[ in_cnt++ ] = shred[ par[a] ];
+    for( ulong c=0UL; c<d; c++ ) if( !erased[c] ) in[ in_cnt++ ] = shred[c];
+
+    for( ulong b=0UL; b<e; b++ ) {
+      uchar const * minv = AUG(b) + e; /* Row b of inv(M) */
+      uchar *       row  = coef + b*FD_REEDSOL_DATA_SHREDS_MAX;
+      out[b] = shred[ era[b] ];
+      fd_memset( tmp, 0, wd );
+      for( ulong a=0UL; a<e; a++ ) {
+        row[a] = minv[a];
+        if( minv[a] ) fd_reedsol_private_axpy( tmp, LROW(a), minv[a], wd );
+      }
+      ulong i = e;
+      for( ulong c=0UL; c<d; c++ ) if( !erased[c] ) row[ i++ ] = tmp[c];
+    }
+
+#   undef AUG
+#   undef LROW
+
+    fd_reedsol_private_gemm( sz, d, in, e, out, coef );
+  }
+
+  /* All data shreds are now available.  Regenerate the erased parity
+     shreds and collect the unused received ones. */
+
+  uchar const * data[ FD_REEDSOL_DATA_SHREDS_MAX ];
+  for( ulong c=0UL; c<d; c++ ) data[c] = shred[c];
+
+  uchar * out[ FD_REEDSOL_PARITY_SHREDS_MAX ]; ulong out_cnt = 0UL;
+  ulong   chk[ FD_REEDSOL_PARITY_SHREDS_MAX ]; ulong chk_cnt = 0UL;
+  ulong   used = 0UL;
+  for( ulong x=d; x<d+p; x++ ) {
+    if( erased[x] ) {
+      fd_reedsol_private_lagrange_row( d, x, logd, coef + out_cnt*FD_REEDSOL_DATA_SHREDS_MAX );
+      out[ out_cnt++ ] = shred[x];
+    } else if( used<e ) {
+      used++;
+    } else {
+      chk[ chk_cnt++ ] = x;
+    }
+  }
+  if( out_cnt ) fd_reedsol_private_gemm( sz, d, data, out_cnt, out, coef );
+
+  /* Check the unused received parity shreds chunk by chunk */
+
+  uchar buf[ FD_REEDSOL_PRIVATE_CHECK_SZ ] __attribute__((aligned(32)));
+  for( ulong k=0UL; k<chk_cnt; k++ ) {
+    uchar row[ FD_REEDSOL_DATA_SHREDS_MAX ];
+    fd_reedsol_private_lagrange_row( d, chk[k], logd, row );
+    for( ulong off=0UL; off<sz; off+=FD_REEDSOL_PRIVATE_CHECK_SZ ) {
+      ulong         chunk_sz = fd_ulong_min( sz-off, FD_REEDSOL_PRIVATE_CHECK_SZ );
+      uchar const * in[ FD_REEDSOL_DATA_SHREDS_MAX ];
+      for( ulong c=0UL; c<d; c++ ) in[c] = data[c] + off;
+      uchar * o = buf;
+      fd_reedsol_private_gemm( chunk_sz, d, in, 1UL, &o, row );
+      if( FD_UNLIKELY( memcmp( buf, shred[ chk[k] ] + off, chunk_sz ) ) ) return FD_REEDSOL_ERR_INCONSISTENT;
+    }
+  }
+
+  return FD_REEDSOL_SUCCESS;
+}
+
+char const *
+fd_reedsol_strerror( int err ) {
+  switch( err ) {
+  case FD_REEDSOL_SUCCESS:          return "success";
+  case FD_REEDSOL_ERR_INCONSISTENT: return "inconsistent";
+  case FD_REEDSOL_ERR_PARTIAL:      return "partial";
+  default: break;
+  }
+  return "unknown";
+}
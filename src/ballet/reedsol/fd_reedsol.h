@@ -0,0 +1,194 @@
+#ifndef HEADER_fd_src_ballet_reedsol_fd_reedsol_h
+#define HEADER_fd_src_ballet_reedsol_fd_reedsol_h
+
+/* fd_reedsol provides APIs for the Reed-Solomon erasure code used by
+   the FEC sets of Solana shreds (see ../shred/fd_shred.h).
+
+   Shreds are treated as vectors of GF(2^8) elements (reduction
+   polynomial x^8+x^4+x^3+x^2+1, i.e. 0x11D, generator 2).  An FEC set
+   of d data shreds and p parity (coding) shreds is systematic: the
+   parity shreds are given by the rows d..d+p-1 of the matrix
+   V inv(V_top) applied to the data shreds, where V[r][c] = r^c is the
+   (d+p) x d Vandermonde matrix and V_top its top d x d block.  This is
+   the same code as the one produced by the reed-solomon-erasure crate
+   used by Solana validators.  Equivalently, the byte at offset k of
+   shred r is the value at the point r of the unique polynomial of
+   degree less than d that takes the values of the bytes at offset k of
+   the data shreds at points 0..d-1, such that any d shreds of the set
+   suffice to reconstruct the others.
+
+   Multiplication by a GF(2^8) constant is done with two 16-entry table
+   lookups (one per nibble) using byte shuffles, 32 bytes at a time when
+   AVX is available. */
+
+#include "../fd_ballet_base.h"
+
+/* FD_REEDSOL_{DATA,PARITY}_SHREDS_MAX give the maximum number of data
+   and parity shreds in an FEC set. */
+
+#define FD_REEDSOL_DATA_SHREDS_MAX   (67UL)
+#define FD_REEDSOL_PARITY_SHREDS_MAX (67UL)
+
+/* FD_REEDSOL_{ALIGN,FOOTPRINT} describe the alignment and footprint of
+   a fd_reedsol_t.  ALIGN is a positive integer power of 2.  FOOTPRINT
+   is a multiple of ALIGN.  These are provided to facilitate compile
+   time declarations. */
+
+#define FD_REEDSOL_ALIGN     (128UL)
+#define FD_REEDSOL_FOOTPRINT (1280UL)
+
+/* FD_REEDSOL_{SUCCESS,ERR_*} give the return values of
+   fd_reedsol_recover_fini.  ERR_INCONSISTENT indicates the received
+   shreds are not consistent with any FEC set (e.g. a corrupt shred).
+   ERR_PARTIAL indicates too few shreds were received to recover the
+   erased ones. */
+
+#define FD_REEDSOL_SUCCESS          ( 0)
+#define FD_REEDSOL_ERR_INCONSISTENT (-1)
+#define FD_REEDSOL_ERR_PARTIAL      (-2)
+
+/* A fd_reedsol_t should be treated as an opaque handle of an encode or
+   recover operation in progress.  (It technically isn't here to
+   facilitate compile time declarations of fd_reedsol_t memory.) */
+
+struct __attribute__((aligned(FD_REEDSOL_ALIGN))) fd_reedsol_private {
+  ulong shred_sz;         /* Size of each shred in bytes */
+  ulong data_shred_cnt;   /* Number of data shreds added, in [0,FD_REEDSOL_DATA_SHREDS_MAX] */
+  ulong parity_shred_cnt; /* Number of parity shreds added, in [0,FD_REEDSOL_PARITY_SHREDS_MAX] */
+
+  union {
+    struct {
+      uchar const * data_shred  [ FD_REEDSOL_DATA_SHREDS_MAX   ];
+      uchar       * parity_shred[ FD_REEDSOL_PARITY_SHREDS_MAX ];
+    } encode;
+
+    struct {
+      uchar * shred [ FD_REEDSOL_DATA_SHREDS_MAX + FD_REEDSOL_PARITY_SHREDS_MAX ]; /* Data shreds then parity shreds */
+      uchar   erased[ FD_REEDSOL_DATA_SHREDS_MAX + FD_REEDSOL_PARITY_SHREDS_MAX ]; /* 1 if the shred is to be recovered */
+    } recover;
+  };
+};
+
+typedef struct fd_reedsol_private fd_reedsol_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST static inline ulong fd_reedsol_align    ( void ) { return FD_REEDSOL_ALIGN;     }
+FD_FN_CONST static inline ulong fd_reedsol_footprint( void ) { return FD_REEDSOL_FOOTPRINT; }
+
+/* fd_reedsol_encode_init starts a Reed-Solomon encode operation for an
+   FEC set of shred_sz byte shreds (a positive value).  mem points to a
+   memory region with suitable alignment and footprint.  Returns mem, as
+   a fd_reedsol_t, which will be used for the rest of the operation. */
+
+static inline fd_reedsol_t *
+fd_reedsol_encode_init( void * mem,
+                        ulong  shred_sz ) {
+  fd_reedsol_t * rs = (fd_reedsol_t *)mem;
+  rs->shred_sz         = shred_sz;
+  rs->data_shred_cnt   = 0UL;
+  rs->parity_shred_cnt = 0UL;
+  return rs;
+}
+
+/* fd_reedsol_encode_add_data_shred adds the shred_sz bytes pointed to
+   by ptr as the next data shred of the FEC set.  At most
+   FD_REEDSOL_DATA_SHREDS_MAX data shreds can be added.  The memory must
+   be readable and unmodified until fini returns.  Returns rs. */
+
+static inline fd_reedsol_t *
+fd_reedsol_encode_add_data_shred( fd_reedsol_t * rs,
+                                  void const *   ptr ) {
+  rs->encode.data_shred[ rs->data_shred_cnt++ ] = (uchar const *)ptr;
+  return rs;
+}
+
+/* fd_reedsol_encode_add_parity_shred adds the shred_sz byte region
+   pointed to by ptr as the destination of the next parity shred of the
+   FEC set.  At most FD_REEDSOL_PARITY_SHREDS_MAX parity shreds can be
+   added.  The memory should not overlap the data shreds and is
+   overwritten by fini.  Returns rs. */
+
+static inline fd_reedsol_t *
+fd_reedsol_encode_add_parity_shred( fd_reedsol_t * rs,
+                                    void *         ptr ) {
+  rs->encode.parity_shred[ rs->parity_shred_cnt++ ] = (uchar *)ptr;
+  return rs;
+}
+
+/* fd_reedsol_encode_fini computes the parity shreds of the FEC set
+   from the data shreds added.  Requires at least one data shred.  On
+   return, the operation is complete and rs no longer has any interest
+   in the shreds or its memory region. */
+
+void
+fd_reedsol_encode_fini( fd_reedsol_t * rs );
+
+/* fd_reedsol_recover_init starts a Reed-Solomon recover operation for
+   an FEC set of shred_sz byte shreds.  Same semantics as
+   fd_reedsol_encode_init otherwise. */
+
+static inline fd_reedsol_t *
+fd_reedsol_recover_init( void * mem,
+                         ulong  shred_sz ) {
+  return fd_reedsol_encode_init( mem, shred_sz );
+}
+
+/* fd_reedsol_recover_add_{rcvd,erased}_shred add the next shred of the
+   FEC set.  is_data indicates whether it is a data shred or a parity
+   shred.  All data shreds must be added, in index order, before the
+   parity shreds, in index order.  ptr points to shred_sz bytes.  For a
+   received shred, it has the shred's contents, which are read but not
+   modified.  For an erased shred, the contents of the region are
+   ignored and will be overwritten with the recovered shred by a
+   successful fini.  The memory must remain valid until fini returns.
+   Returns rs. */
+
+static inline fd_reedsol_t *
+fd_reedsol_recover_add_rcvd_shred( fd_reedsol_t * rs,
+                                   int            is_data,
+                                   void const *   ptr ) {
+  ulong idx = rs->data_shred_cnt + rs->parity_shred_cnt;
+  rs->recover.shred [ idx ] = (uchar *)ptr; /* Not written */
+  rs->recover.erased[ idx ] = (uchar)0;
+  rs->data_shred_cnt   += (ulong)!!is_data;
+  rs->parity_shred_cnt += (ulong) !is_data;
+  return rs;
+}
+
+static inline fd_reedsol_t *
+fd_reedsol_recover_add_erased_shred( fd_reedsol_t * rs,
+                                     int            is_data,
+                                     void *         ptr ) {
+  ulong idx = rs->data_shred_cnt + rs->parity_shred_cnt;
+  rs->recover.shred [ idx ] = (uchar *)ptr;
+  rs->recover.erased[ idx ] = (uchar)1;
+  rs->data_shred_cnt   += (ulong)!!is_data;
+  rs->parity_shred_cnt += (ulong) !is_data;
+  return rs;
+}
+
+/* fd_reedsol_recover_fini recovers the erased shreds of the FEC set
+   from the received ones.  Returns FD_REEDSOL_SUCCESS if the erased
+   shreds were recovered and all received shreds are consistent with
+   them, FD_REEDSOL_ERR_INCONSISTENT if some received shreds are not
+   consistent with the others (the contents of the erased shred regions
+   are then unspecified) and FD_REEDSOL_ERR_PARTIAL if fewer shreds than
+   data shreds were received (the erased shred regions are not
+   modified).  On return, the operation is complete and rs no longer
+   has any interest in the shreds or its memory region. */
+
+int
+fd_reedsol_recover_fini( fd_reedsol_t * rs );
+
+/* fd_reedsol_strerror converts a FD_REEDSOL_SUCCESS / FD_REEDSOL_ERR_*
+   code into a human readable cstr.  The lifetime of the returned
+   pointer is infinite.  The returned pointer is always to a non-NULL
+   cstr. */
+
+FD_FN_CONST char const *
+fd_reedsol_strerror( int err );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_reedsol_fd_reedsol_h */
@@ -0,0 +1,290 @@
+#include "../fd_ballet.h"
+
+FD_STATIC_ASSERT( FD_REEDSOL_ALIGN    ==alignof(fd_reedsol_t), unit_test );
+FD_STATIC_ASSERT( FD_REEDSOL_FOOTPRINT==sizeof (fd_reedsol_t), unit_test );
+
+#define SHRED_MAX (FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX)
+#define SZ_MAX    (1232UL)
+
+/* Scalar reference: GF(2^8) multiplication by shift and add, and the
+   encoding matrix computed as V inv(V_top) by Gauss-Jordan elimination
+   like the reed-solomon-erasure crate does. */
+
+static uchar ref_mul_tbl[ 256 ][ 256 ];
+
+static uchar
+ref_mul_slow( uint a,
+              uint b ) {
+  uint r = 0U;
+  for( int i=0; i<8; i++ ) {
+    if( b & 1U ) r ^= a;
+    b >>= 1;
+    a = (a<<1) ^ ((a & 0x80U) ? 0x11DU : 0U);
+  }
+  return (uchar)r;
+}
+
+static uchar
+ref_pow( uint  a,
+         ulong n ) {
+  uchar r = (uchar)1;
+  for( ulong i=0UL; i<n; i++ ) r = ref_mul_tbl[ r ][ a ];
+  return r;
+}
+
+static uchar
+ref_inv( uint a ) {
+  for( uint b=1U; b<256U; b++ ) if( ref_mul_tbl[ a ][ b ]==(uchar)1 ) return (uchar)b;
+  FD_LOG_ERR(( "no inverse" ));
+  return (uchar)0;
+}
+
+/* ref_encode_matrix sets e[r][c], r in [0,d+p), c in [0,d) */
+
+static void
+ref_encode_matrix( ulong d,
+                   ulong p,
+                   uchar e[ SHRED_MAX ][ FD_REEDSOL_DATA_SHREDS_MAX ] ) {
+  static uchar v   [ SHRED_MAX ][ FD_REEDSOL_DATA_SHREDS_MAX ];
+  static uchar top [ FD_REEDSOL_DATA_SHREDS_MAX ][ FD_REEDSOL_DATA_SHREDS_MAX ];
+  static uchar tinv[ FD_REEDSOL_DATA_SHREDS_MAX ][ FD_REEDSOL_DATA_SHREDS_MAX ];
+
+  for( ulong r=0UL; r<d+p; r++ ) for( ulong c=0UL; c<d; c++ ) v[r][c] = ref_pow( (uint)r, c );
+  for( ulong r=0UL; r<d; r++ ) for( ulong c=0UL; c<d; c++ ) { top[r][c] = v[r][c]; tinv[r][c] = (uchar)(r==c); }
+
+  for( ulong c=0UL; c<d; c++ ) {
+    ulong piv = c; while( !top[piv][c] ) piv++;
+    for( ulong k=0UL; k<d; k++ ) {
+      uchar t = top [c][k]; top [c][k] = top [piv][k]; top [piv][k] = t;
+      /**/  t = tinv[c][k]; tinv[c][k] = tinv[piv][k]; tinv[piv][k] = t;
+    }
+    uchar s = ref_inv( top[c][c] );
+    for( ulong k=0UL; k<d; k++ ) { top[c][k] = ref_mul_tbl[ s ][ top[c][k] ]; tinv[c][k] = ref_mul_tbl[ s ][ tinv[c][k] ]; }
+    for( ulong r=0UL; r<d; r++ ) {
+      uchar f = top[r][c];
+      if( (r==c) | !f ) continue;
+      for( ulong k=0UL; k<d; k++ ) {
+        top [r][k] ^= ref_mul_tbl[ f ][ top [c][k] ];
+        tinv[r][k] ^= ref_mul_tbl[ f ][ tinv[c][k] ];
+      }
+    }
+  }
+
+  for( ulong r=0UL; r<d+p; r++ ) for( ulong c=0UL; c<d; c++ ) {
+    uchar acc = (uchar)0;
+    for( ulong k=0UL; k<d; k++ ) acc ^= ref_mul_tbl[ v[r][k] ][ tinv[k][c] ];
+    e[r][c] = acc;
+  }
+}
+
+static void
+ref_encode( ulong         d,
+            ulong         p,
+            ulong         sz,
+            uchar const   e[ SHRED_MAX ][ FD_REEDSOL_DATA_SHREDS_MAX ],
+            uchar const * data[],
+            uchar *       parity[] ) {
+  for( ulong j=0UL; j<p; j++ ) {
+    uchar const * row = e[ d+j ];
+    for( ulong k=0UL; k<sz; k++ ) {
+      uchar acc = (uchar)0;
+      for( ulong i=0UL; i<d; i++ ) acc ^= ref_mul_tbl[ row[i] ][ data[i][k] ];
+      parity[j][k] = acc;
+    }
+  }
+}
+
+static uchar shred    [ SHRED_MAX ][ SZ_MAX ] __attribute__((aligned(32)));
+static uchar ref      [ SHRED_MAX ][ SZ_MAX ] __attribute__((aligned(32)));
+static uchar emat     [ SHRED_MAX ][ FD_REEDSOL_DATA_SHREDS_MAX ];
+
+static uchar rs_mem[ FD_REEDSOL_FOOTPRINT ] __attribute__((aligned(FD_REEDSOL_ALIGN)));
+
+static void
+test_encode( ulong d,
+             ulong p,
+             ulong sz ) {
+  uchar const * data[ FD_REEDSOL_DATA_SHREDS_MAX ];
+  uchar *       ref_parity[ FD_REEDSOL_PARITY_SHREDS_MAX ];
+  for( ulong i=0UL; i<d; i++ ) data[i] = ref[i];
+  for( ulong j=0UL; j<p; j++ ) ref_parity[j] = ref[d+j];
+  ref_encode( d, p, sz, (uchar const (*)[ FD_REEDSOL_DATA_SHREDS_MAX ])emat, data, ref_parity );
+
+  fd_reedsol_t * rs = fd_reedsol_encode_init( rs_mem, sz );
+  for( ulong i=0UL; i<d; i++ ) fd_reedsol_encode_add_data_shred  ( rs, ref[i]     );
+  for( ulong j=0UL; j<p; j++ ) fd_reedsol_encode_add_parity_shred( rs, shred[d+j] );
+  fd_reedsol_encode_fini( rs );
+
+  for( ulong j=0UL; j<p; j++ ) FD_TEST( !memcmp( shred[d+j], ref[d+j], sz ) );
+}
+
+/* test_recover erases erase_cnt random shreds of the FEC set in ref
+   and checks they are recovered. */
+
+static void
+test_recover( fd_rng_t * rng,
+              ulong      d,
+              ulong      p,
+              ulong      sz,
+              ulong      erase_cnt ) {
+  uchar erased[ SHRED_MAX ];
+  fd_memset( erased, 0, SHRED_MAX );
+  for( ulong k=0UL; k<erase_cnt; k++ ) {
+    ulong s; do s = fd_rng_ulong_roll( rng, d+p ); while( erased[s] );
+    erased[s] = (uchar)1;
+  }
+
+  for( ulong s=0UL; s<d+p; s++ ) {
+    if( erased[s] ) for( ulong k=0UL; k<sz; k++ ) shred[s][k] = fd_rng_uchar( rng );
+    else            fd_memcpy( shred[s], ref[s], sz );
+  }
+
+  fd_reedsol_t * rs = fd_reedsol_recover_init( rs_mem, sz );
+  for( ulong s=0UL; s<d+p; s++ ) {
+    if( erased[s] ) fd_reedsol_recover_add_erased_shred( rs, s<d, shred[s] );
+    else            fd_reedsol_recover_add_rcvd_shred  ( rs, s<d, shred[s] );
+  }
+  int err = fd_reedsol_recover_fini( rs );
+
+  if( erase_cnt>p ) { FD_TEST( err==FD_REEDSOL_ERR_PARTIAL ); return; }
+  FD_TEST( err==FD_REEDSOL_SUCCESS );
+  for( ulong s=0UL; s<d+p; s++ ) FD_TEST( !memcmp( shred[s], ref[s], sz ) );
+
+  /* Corrupt a received shred.  This is detectable if more than d
+     shreds were received. */
+
+  if( erase_cnt<p ) {
+    ulong s; do s = fd_rng_ulong_roll( rng, d+p ); while( erased[s] );
+    shred[s][ fd_rng_ulong_roll( rng, sz ) ] ^= (uchar)(1U + fd_rng_uint_roll( rng, 255U ));
+
+    rs = fd_reedsol_recover_init( rs_mem, sz );
+    for( ulong t=0UL; t<d+p; t++ ) {
+      if( erased[t] ) fd_reedsol_recover_add_erased_shred( rs, t<d, shred[t] );
+      else            fd_reedsol_recover_add_rcvd_shred  ( rs, t<d, shred[t] );
+    }
+    FD_TEST( fd_reedsol_recover_fini( rs )==FD_REEDSOL_ERR_INCONSISTENT );
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_reedsol_align    ()==FD_REEDSOL_ALIGN     );
+  FD_TEST( fd_reedsol_footprint()==FD_REEDSOL_FOOTPRINT );
+
+  FD_TEST( !strcmp( fd_reedsol_strerror( FD_REEDSOL_SUCCESS          ), "success"      ) );
+  FD_TEST( !strcmp( fd_reedsol_strerror( FD_REEDSOL_ERR_INCONSISTENT ), "inconsistent" ) );
+  FD_TEST( !strcmp( fd_reedsol_strerror( FD_REEDSOL_ERR_PARTIAL      ), "partial"      ) );
+  FD_TEST( !strcmp( fd_reedsol_strerror( 1                           ), "unknown"      ) );
+
+  for( uint a=0U; a<256U; a++ ) for( uint b=0U; b<256U; b++ ) ref_mul_tbl[ a ][ b ] = ref_mul_slow( a, b );
+
+  for( ulong s=0UL; s<SHRED_MAX; s++ ) for( ulong k=0UL; k<SZ_MAX; k++ ) ref[s][k] = fd_rng_uchar( rng );
+
+  FD_LOG_NOTICE(( "Testing encode and recover" ));
+
+  static ulong const test_d[] = { 1UL, 2UL, 3UL, 7UL, 16UL, 32UL, 33UL, 50UL, 67UL };
+  static ulong const test_p[] = { 1UL, 2UL, 5UL, 17UL, 32UL, 67UL };
+  static ulong const test_sz[] = { 1UL, 31UL, 32UL, 33UL, 200UL, 1139UL, 1228UL, SZ_MAX };
+
+  for( ulong di=0UL; di<sizeof(test_d)/sizeof(ulong); di++ ) {
+    for( ulong pi=0UL; pi<sizeof(test_p)/sizeof(ulong); pi++ ) {
+      ulong d = test_d[ di ];
+      ulong p = test_p[ pi ];
+      ref_encode_matrix( d, p, emat );
+      for( ulong zi=0UL; zi<sizeof(test_sz)/sizeof(ulong); zi++ ) {
+        ulong sz = test_sz[ zi ];
+        test_encode( d, p, sz );
+        for( ulong rem=4UL; rem; rem-- ) test_recover( rng, d, p, sz, fd_rng_ulong_roll( rng, p+1UL ) );
+        test_recover( rng, d, p, sz, p     ); /* No spare parity */
+        test_recover( rng, d, p, sz, p+1UL ); /* Too many erasures */
+      }
+    }
+  }
+
+  /* Erasing exactly the data shreds */
+
+  for( ulong d=1UL; d<=FD_REEDSOL_DATA_SHREDS_MAX; d++ ) {
+    ulong p  = FD_REEDSOL_PARITY_SHREDS_MAX;
+    ulong sz = 1228UL;
+    ref_encode_matrix( d, p, emat );
+    test_encode( d, p, sz );
+    fd_reedsol_t * rs = fd_reedsol_recover_init( rs_mem, sz );
+    for( ulong s=0UL; s<d;   s++ ) fd_reedsol_recover_add_erased_shred( rs, 1, shred[s] );
+    for( ulong s=d; s<d+p; s++ ) fd_reedsol_recover_add_rcvd_shred  ( rs, 0, shred[s] );
+    FD_TEST( fd_reedsol_recover_fini( rs )==( (d<=p) ? FD_REEDSOL_SUCCESS : FD_REEDSOL_ERR_PARTIAL ) );
+    for( ulong s=0UL; s<d; s++ ) FD_TEST( !memcmp( shred[s], ref[s], sz ) );
+  }
+
+  /* Benchmark against the scalar reference */
+
+  static ulong const bench_d[3] = { 32UL, 32UL, 67UL };
+  static ulong const bench_p[3] = { 32UL, 67UL, 67UL };
+  ulong sz = 1228UL;
+
+  for( ulong bi=0UL; bi<3UL; bi++ ) {
+    ulong d = bench_d[ bi ];
+    ulong p = bench_p[ bi ];
+    ref_encode_matrix( d, p, emat );
+
+    uchar const * data  [ FD_REEDSOL_DATA_SHREDS_MAX   ];
+    uchar *       parity[ FD_REEDSOL_PARITY_SHREDS_MAX ];
+    for( ulong i=0UL; i<d; i++ ) data  [i] = ref  [i];
+    for( ulong j=0UL; j<p; j++ ) parity[j] = shred[d+j];
+
+    ulong iter = 10UL;
+    long  dt   = -fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) ref_encode( d, p, sz, (uchar const (*)[ FD_REEDSOL_DATA_SHREDS_MAX ])emat, data, parity );
+    dt += fd_log_wallclock();
+    double ref_gbps = ((double)(d*sz*iter)) / ((double)dt);
+
+    for( ulong rem=10UL; rem; rem-- ) test_encode( d, p, sz ); /* warmup */
+    iter = 1000UL;
+    dt   = -fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      fd_reedsol_t * rs = fd_reedsol_encode_init( rs_mem, sz );
+      for( ulong i=0UL; i<d; i++ ) fd_reedsol_encode_add_data_shred  ( rs, data[i]   );
+      for( ulong j=0UL; j<p; j++ ) fd_reedsol_encode_add_parity_shred( rs, parity[j] );
+      fd_reedsol_encode_fini( rs );
+    }
+    dt += fd_log_wallclock();
+    double gbps = ((double)(d*sz*iter)) / ((double)dt);
+    FD_LOG_NOTICE(( "encode  %2lu:%2lu sz %4lu: ~%7.3f GB/s of data shreds / core (scalar reference ~%6.3f GB/s)", d, p, sz, gbps, ref_gbps ));
+
+    /* Worst case recover: the first min(d,p) data shreds are erased.
+       Reference recovery is a matrix product of the same shape as an
+       encode of min(d,p) parity shreds, which is what is timed for it. */
+
+    ulong e = fd_ulong_min( d, p );
+    for( ulong j=0UL; j<p; j++ ) fd_memcpy( ref[d+j], shred[d+j], sz );
+    iter = 1000UL;
+    dt   = -fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      fd_reedsol_t * rs = fd_reedsol_recover_init( rs_mem, sz );
+      for( ulong s=0UL; s<d+p; s++ ) {
+        if( s<e ) fd_reedsol_recover_add_erased_shred( rs, s<d, shred[s] );
+        else      fd_reedsol_recover_add_rcvd_shred  ( rs, s<d, s<d ? ref[s] : shred[s] );
+      }
+      FD_TEST( fd_reedsol_recover_fini( rs )==FD_REEDSOL_SUCCESS );
+    }
+    dt += fd_log_wallclock();
+    for( ulong s=0UL; s<e; s++ ) FD_TEST( !memcmp( shred[s], ref[s], sz ) );
+    gbps = ((double)(d*sz*iter)) / ((double)dt);
+    iter = 10UL;
+    dt   = -fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) ref_encode( d, e, sz, (uchar const (*)[ FD_REEDSOL_DATA_SHREDS_MAX ])emat, data, parity );
+    dt += fd_log_wallclock();
+    double ref_rec_gbps = ((double)(d*sz*iter)) / ((double)dt);
+    FD_LOG_NOTICE(( "recover %2lu:%2lu sz %4lu: ~%7.3f GB/s of data shreds / core (scalar reference ~%6.3f GB/s)", d, p, sz, gbps, ref_rec_gbps ));
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -222,17 +222,37 @@ FD_PROTOTYPES_END
 
 #if FD_HAS_AVX /* AVX accelerated batching implementation */
 
+/* When AVX-512 is available, batches are processed 8 messages at a
+   time by fd_sha512_private_batch_avx512 (which falls back to the AVX
+   implementation for small batches).  Otherwise, batches are processed
+   4 messages at a time by fd_sha512_private_batch_avx. */
+
+#if FD_HAS_AVX512
+
+#define FD_SHA512_BATCH_ALIGN     (128UL)
+#define FD_SHA512_BATCH_FOOTPRINT (256UL)
+
+/* This is exposed here to facilitate inlining various operations */
+
+#define FD_SHA512_PRIVATE_BATCH_MAX  (8UL)
+#define FD_SHA512_PRIVATE_BATCH_IMPL fd_sha512_private_batch_avx512
+
+#else
+
 #define FD_SHA512_BATCH_ALIGN     (128UL)
 #define FD_SHA512_BATCH_FOOTPRINT (128UL)
 
 /* This is exposed here to facilitate inlining various operations */
 
-#define FD_SHA512_PRIVATE_BATCH_MAX (4UL)
+#define FD_SHA512_PRIVATE_BATCH_MAX  (4UL)
+#define FD_SHA512_PRIVATE_BATCH_IMPL fd_sha512_private_batch_avx
+
+#endif
 
 struct __attribute__((aligned(FD_SHA512_BATCH_ALIGN))) fd_sha512_private_batch {
-  void const * data[ FD_SHA512_PRIVATE_BATCH_MAX ]; /* AVX aligned */
-  ulong        sz  [ FD_SHA512_PRIVATE_BATCH_MAX ]; /* AVX aligned */
-  void *       hash[ FD_SHA512_PRIVATE_BATCH_MAX ]; /* AVX aligned */
+  void const * data[ FD_SHA512_PRIVATE_BATCH_MAX ]; /* AVX / AVX-512 aligned */
+  ulong        sz  [ FD_SHA512_PRIVATE_BATCH_MAX ]; /* AVX / AVX-512 aligned */
+  void *       hash[ FD_SHA512_PRIVATE_BATCH_MAX ]; /* AVX / AVX-512 aligned */
   ulong        cnt;
 };
 
@@ -243,7 +263,7 @@ FD_PROTOTYPES_BEGIN
 /* Internal use only */
 
 void
-fd_sha512_private_batch_avx( ulong          batch_cnt,    /* In [1,FD_SHA512_PRIVATE_BATCH_MAX] */
+fd_sha512_private_batch_avx( ulong          batch_cnt,    /* In [1,4] */
                              void const *   batch_data,   /* Indexed [0,FD_SHA512_PRIVATE_BATCH_MAX), aligned 32,
                                                              only [0,batch_cnt) used, essentially a msg_t const * const * */
                              ulong const *  batch_sz,     /* Indexed [0,FD_SHA512_PRIVATE_BATCH_MAX), aligned 32,
@@ -251,6 +271,17 @@ fd_sha512_private_batch_avx( ulong          batch_cnt,    /* In [1,FD_SHA512_PRI
                              void * const * batch_hash ); /* Indexed [0,FD_SHA512_PRIVATE_BATCH_MAX), aligned 32,
                                                              only [0,batch_cnt) used */
 
+#if FD_HAS_AVX512
+void
+fd_sha512_private_batch_avx512( ulong          batch_cnt,    /* In [1,FD_SHA512_PRIVATE_BATCH_MAX] */
+                                void const *   batch_data,   /* Indexed [0,FD_SHA512_PRIVATE_BATCH_MAX), aligned 64,
+                                                                only [0,batch_cnt) used, essentially a msg_t const * const * */
+                                ulong const *  batch_sz,     /* Indexed [0,FD_SHA512_PRIVATE_BATCH_MAX), aligned 64,
+                                                                only [0,batch_cnt) used */
+                                void * const * batch_hash ); /* Indexed [0,FD_SHA512_PRIVATE_BATCH_MAX), aligned 64,
+                                                                only [0,batch_cnt) used */
+#endif
+
 FD_FN_CONST static inline ulong fd_sha512_batch_align    ( void ) { return alignof(fd_sha512_batch_t); }
 FD_FN_CONST static inline ulong fd_sha512_batch_footprint( void ) { return sizeof (fd_sha512_batch_t); }
 
@@ -272,7 +303,7 @@ fd_sha512_batch_add( fd_sha512_batch_t * batch,
   batch->hash[ batch_cnt ] = hash;
   batch_cnt++;
   if( FD_UNLIKELY( batch_cnt==FD_SHA512_PRIVATE_BATCH_MAX ) ) {
-    fd_sha512_private_batch_avx( batch_cnt, batch->data, batch->sz, batch->hash );
+    FD_SHA512_PRIVATE_BATCH_IMPL( batch_cnt, batch->data, batch->sz, batch->hash );
     batch_cnt = 0UL;
   }
   batch->cnt = batch_cnt;
@@ -282,7 +313,7 @@ fd_sha512_batch_add( fd_sha512_batch_t * batch,
 static inline void *
 fd_sha512_batch_fini( fd_sha512_batch_t * batch ) {
   ulong batch_cnt = batch->cnt;
-  if( FD_LIKELY( batch_cnt ) ) fd_sha512_private_batch_avx( batch_cnt, batch->data, batch->sz, batch->hash );
+  if( FD_LIKELY( batch_cnt ) ) FD_SHA512_PRIVATE_BATCH_IMPL( batch_cnt, batch->data, batch->sz, batch->hash );
   return (void *)batch;
 }
 
@@ -159,6 +159,33 @@ main( int     argc,
       }
     }
   }
+  /* Batches of 5 to 8 messages (the sizes the AVX-512 implementation
+     handles itself), with lanes of different lengths around block
+     boundaries */
+
+  static ulong const edge_sz[] = { 0UL, 1UL, 111UL, 112UL, 127UL, 128UL, 239UL, 240UL, 255UL, 256UL, 511UL };
+  for( ulong batch_cnt=5UL; batch_cnt<=8UL; batch_cnt++ ) {
+    for( ulong trial_rem=4096UL; trial_rem; trial_rem-- ) {
+      uchar const * data[ BATCH_MAX ];
+      ulong         sz  [ BATCH_MAX ];
+      uchar *       hash[ BATCH_MAX ];
+
+      fd_sha512_batch_t * batch = fd_sha512_batch_init( batch_mem ); FD_TEST( batch );
+      for( ulong batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ ) {
+        sz  [ batch_idx ] = edge_sz[ fd_rng_ulong_roll( rng, sizeof(edge_sz)/sizeof(ulong) ) ];
+        data[ batch_idx ] = data_mem + fd_rng_ulong_roll( rng, DATA_MAX-sz[ batch_idx ]+1UL );
+        hash[ batch_idx ] = hash_mem + batch_idx*64UL;
+        FD_TEST( fd_sha512_batch_add( batch, data[ batch_idx ], sz[ batch_idx ], hash[ batch_idx ] )==batch );
+      }
+      FD_TEST( fd_sha512_batch_fini( batch )==(void *)batch_mem );
+      for( ulong batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ ) {
+        uchar ref_hash[ 64 ];
+        FD_TEST( !memcmp( fd_sha512_hash( data[ batch_idx ], sz[ batch_idx ], ref_hash ), hash[ batch_idx ], 64UL ) );
+      }
+    }
+  }
+  FD_LOG_NOTICE(( "OK: Batches of 5 to 8" ));
+
 # undef DATA_MAX
 # undef BATCH_MAX
 
@@ -0,0 +1,305 @@
+#include "fd_shredder.h"
+
+/* fd_shredder_private_batch_sz gives the total number of shreds of an
+   FEC set with the given number of data shreds, for the last FEC set of
+   a batch.  This matches the erasure batch size table of Solana
+   validators (2 shreds per data shred beyond the table). */
+
+static uchar const fd_shredder_private_batch_sz[ FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS+1UL ] = {
+   0, 18, 20, 22, 23, 25, 27, 28, 30, 32, 33, 35, 36, 38, 39, 41, 42,
+  43, 45, 46, 48, 49, 51, 52, 53, 55, 56, 58, 59, 60, 62, 63, 64
+};
+
+FD_FN_CONST static inline ulong
+fd_shredder_private_parity_cnt( ulong data_cnt ) {
+  return (ulong)fd_shredder_private_batch_sz[ data_cnt ] - data_cnt;
+}
+
+/* fd_shredder_private_merkle_cnt returns the number of Merkle nodes of
+   the shreds of an FEC set with data_cnt data shreds */
+
+FD_FN_CONST static inline ulong
+fd_shredder_private_merkle_cnt( ulong data_cnt ) {
+  return FD_SHREDDER_MERKLE_CNT( data_cnt + fd_shredder_private_parity_cnt( data_cnt ) );
+}
+
+/* fd_shredder_private_last_data_cnt returns the number of data shreds
+   of the last FEC set of a batch, which holds the last sz bytes of the
+   batch, sz in [0,FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ].  Smaller FEC
+   sets have shorter inclusion proofs and thus more payload per shred,
+   so this is at most FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS. */
+
+FD_FN_CONST static ulong
+fd_shredder_private_last_data_cnt( ulong sz ) {
+  ulong d = 1UL;
+  while( d*FD_SHREDDER_PAYLOAD_SZ( fd_shredder_private_merkle_cnt( d ) )<sz ) d++;
+  return d;
+}
+
+FD_STATIC_ASSERT( FD_SHREDDER_ALIGN    ==alignof(fd_shredder_t), unit_test );
+FD_STATIC_ASSERT( FD_SHREDDER_FOOTPRINT==sizeof (fd_shredder_t), unit_test );
+
+void *
+fd_shredder_new( void *       mem,
+                 void const * public_key,
+                 void const * private_key,
+                 ushort       shred_version ) {
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, FD_SHREDDER_ALIGN ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( (!public_key) | (!private_key) ) ) {
+    FD_LOG_WARNING(( "NULL key" ));
+    return NULL;
+  }
+
+  fd_shredder_t * shredder = (fd_shredder_t *)mem;
+  fd_memset( shredder, 0, FD_SHREDDER_FOOTPRINT );
+
+  if( FD_UNLIKELY( !fd_sha512_join( fd_sha512_new( shredder->sha512 ) ) ) ) return NULL;
+
+  shredder->shred_version = (ulong)shred_version;
+  shredder->slot          = ULONG_MAX;
+  fd_memcpy( shredder->public_key,  public_key,  32UL );
+  fd_memcpy( shredder->private_key, private_key, 32UL );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( shredder->magic ) = FD_SHREDDER_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return mem;
+}
+
+fd_shredder_t *
+fd_shredder_join( void * mem ) {
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, FD_SHREDDER_ALIGN ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+
+  fd_shredder_t * shredder = (fd_shredder_t *)mem;
+  if( FD_UNLIKELY( shredder->magic!=FD_SHREDDER_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return shredder;
+}
+
+void *
+fd_shredder_leave( fd_shredder_t * shredder ) {
+  if( FD_UNLIKELY( !shredder ) ) {
+    FD_LOG_WARNING(( "NULL shredder" ));
+    return NULL;
+  }
+  return (void *)shredder;
+}
+
+void *
+fd_shredder_delete( void * mem ) {
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+
+  fd_shredder_t * shredder = (fd_shredder_t *)mem;
+  if( FD_UNLIKELY( shredder->magic!=FD_SHREDDER_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( shredder->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  fd_memset( shredder->private_key, 0, 32UL );
+  fd_sha512_delete( fd_sha512_leave( shredder->sha512 ) );
+  return mem;
+}
+
+ulong
+fd_shredder_count_fec_sets( ulong sz ) {
+  return fd_ulong_max( (sz + FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ - 1UL) / FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ, 1UL );
+}
+
+ulong
+fd_shredder_count_data_shreds( ulong sz ) {
+  ulong normal_cnt = fd_shredder_count_fec_sets( sz ) - 1UL;
+  return normal_cnt*FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS
+       + fd_shredder_private_last_data_cnt( sz - normal_cnt*FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ );
+}
+
+ulong
+fd_shredder_count_parity_shreds( ulong sz ) {
+  ulong normal_cnt = fd_shredder_count_fec_sets( sz ) - 1UL;
+  return normal_cnt*FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS
+       + fd_shredder_private_parity_cnt( fd_shredder_private_last_data_cnt( sz - normal_cnt*FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ ) );
+}
+
+fd_shredder_t *
+fd_shredder_init_batch( fd_shredder_t *               shredder,
+                        void const *                  entry_batch,
+                        ulong                         sz,
+                        ulong                         slot,
+                        fd_entry_batch_meta_t const * meta ) {
+  shredder->entry_batch = (uchar const *)entry_batch;
+  shredder->sz          = sz;
+  shredder->offset      = 0UL;
+  shredder->meta        = *meta;
+
+  if( slot!=shredder->slot ) {
+    shredder->slot              = slot;
+    shredder->data_idx_offset   = 0UL;
+    shredder->parity_idx_offset = 0UL;
+  }
+
+  return shredder;
+}
+
+fd_shredder_t *
+fd_shredder_fini_batch( fd_shredder_t * shredder ) {
+  shredder->entry_batch = NULL;
+  shredder->sz          = 0UL;
+  shredder->offset      = 0UL;
+  return shredder;
+}
+
+/* FD_SHREDDER_PRIVATE_NODE_MAX bounds the number of nodes of the Merkle
+   tree of an FEC set */
+
+#define FD_SHREDDER_PRIVATE_NODE_MAX (2UL*(FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX)+16UL)
+
+fd_fec_set_t *
+fd_shredder_next_fec_set( fd_shredder_t * shredder,
+                          fd_fec_set_t *  result ) {
+  ulong offset = shredder->offset;
+  ulong sz     = shredder->sz;
+
+  /* The first FEC set is produced even if the batch is empty */
+
+  if( FD_UNLIKELY( (offset>=sz) & ((offset>0UL) | (shredder->entry_batch==NULL)) ) ) return NULL;
+
+  ulong rem = sz - offset;
+  ulong d, p;
+  if( FD_LIKELY( rem>FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ ) ) {
+    d = FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS;
+    p = FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS;
+  } else {
+    d = fd_shredder_private_last_data_cnt( rem );
+    p = fd_shredder_private_parity_cnt( d );
+  }
+  int   last_in_batch = (rem<=FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ);
+  ulong merkle_cnt    = FD_SHREDDER_MERKLE_CNT( d+p );
+  ulong merkle_off    = FD_SHRED_SZ - merkle_cnt*FD_SHRED_MERKLE_NODE_SZ;
+  ulong shard_sz      = FD_SHREDDER_SHARD_SZ  ( merkle_cnt );
+  ulong payload_max   = FD_SHREDDER_PAYLOAD_SZ( merkle_cnt );
+
+  ulong fec_set_idx = shredder->data_idx_offset;
+  uchar data_type   = fd_shred_variant( FD_SHRED_TYPE_MERKLE_DATA, (uchar)merkle_cnt );
+  uchar code_type   = fd_shred_variant( FD_SHRED_TYPE_MERKLE_CODE, (uchar)merkle_cnt );
+
+  /* Data shreds: headers and payload, straight from the batch */
+
+  uchar base_flags = (uchar)(shredder->meta.reference_tick & (ulong)FD_SHRED_DATA_REF_TICK_MASK);
+  for( ulong i=0UL; i<d; i++ ) {
+    uchar *      mem   = result->data_shreds[ i ];
+    fd_shred_t * shred = (fd_shred_t *)mem;
+    ulong        pl_sz = fd_ulong_min( sz-offset, payload_max );
+
+    uchar flags = base_flags;
+    if( i==d-1UL ) {
+      flags |= FD_SHRED_DATA_FLAG_FEC_SET_COMPLETE;
+      if( last_in_batch & (!!shredder->meta.block_complete) ) flags |= FD_SHRED_DATA_FLAG_SLOT_COMPLETE;
+    }
+
+    shred->variant         = data_type;
+    shred->slot            = shredder->slot;
+    shred->idx             = (uint  )(fec_set_idx + i);
+    shred->version         = (ushort)shredder->shred_version;
+    shred->fec_set_idx     = (uint  )fec_set_idx;
+    shred->data.parent_off = (ushort)shredder->meta.parent_offset;
+    shred->data.flags      = flags;
+    shred->data.size       = (ushort)(FD_SHRED_DATA_HEADER_SZ + pl_sz);
+
+    if( FD_LIKELY( pl_sz ) ) fd_memcpy( mem + FD_SHRED_DATA_HEADER_SZ, shredder->entry_batch + offset, pl_sz );
+    fd_memset( mem + FD_SHRED_DATA_HEADER_SZ + pl_sz, 0, merkle_off - FD_SHRED_DATA_HEADER_SZ - pl_sz );
+    offset += pl_sz;
+  }
+
+  /* Parity shreds: headers, then Reed-Solomon encode in place */
+
+  fd_reedsol_t * reedsol = fd_reedsol_encode_init( shredder->reedsol, shard_sz );
+  for( ulong i=0UL; i<d; i++ ) fd_reedsol_encode_add_data_shred( reedsol, result->data_shreds[ i ] + FD_ED25519_SIG_SZ );
+  for( ulong j=0UL; j<p; j++ ) {
+    uchar *      mem   = result->parity_shreds[ j ];
+    fd_shred_t * shred = (fd_shred_t *)mem;
+
+    shred->variant       = code_type;
+    shred->slot          = shredder->slot;
+    shred->idx           = (uint  )(shredder->parity_idx_offset + j);
+    shred->version       = (ushort)shredder->shred_version;
+    shred->fec_set_idx   = (uint  )fec_set_idx;
+    shred->code.data_cnt = (ushort)d;
+    shred->code.code_cnt = (ushort)p;
+    shred->code.idx      = (ushort)j;
+
+    fd_reedsol_encode_add_parity_shred( reedsol, mem + FD_SHRED_CODE_HEADER_SZ );
+  }
+  fd_reedsol_encode_fini( reedsol );
+
+  /* Merkle tree.  The leaves are hashed in parallel with the SHA-256
+     batch API.  The leaf prefix byte is written over the last byte of
+     the signature (which is written below), such that each leaf hash
+     is over a contiguous region of its shred. */
+
+  fd_bmtree20_node_t tree[ FD_SHREDDER_PRIVATE_NODE_MAX ];
+  ulong              leaf_cnt = d+p;
+
+  uchar _batch[ FD_SHA256_BATCH_FOOTPRINT ] __attribute__((aligned(FD_SHA256_BATCH_ALIGN)));
+  fd_sha256_batch_t * batch = fd_sha256_batch_init( _batch );
+  for( ulong s=0UL; s<leaf_cnt; s++ ) {
+    uchar * mem = (s<d) ? result->data_shreds[ s ] : result->parity_shreds[ s-d ];
+    mem[ FD_ED25519_SIG_SZ-1UL ] = (uchar)0; /* Leaf hash domain prefix */
+    fd_sha256_batch_add( batch, mem + FD_ED25519_SIG_SZ-1UL, merkle_off - FD_ED25519_SIG_SZ + 1UL, tree[ s ].hash );
+  }
+  fd_sha256_batch_fini( batch );
+
+  fd_bmtree20_node_t const * root = fd_bmtree20_tree_build( tree, leaf_cnt );
+
+  /* Sign the root and write it, the proofs and the signature */
+
+  fd_ed25519_sig_t sig;
+  fd_ed25519_sign( sig, root->hash, FD_SHRED_MERKLE_NODE_SZ, shredder->public_key, shredder->private_key, shredder->sha512 );
+
+  fd_bmtree20_node_t proof[ 16 ];
+  for( ulong s=0UL; s<leaf_cnt; s++ ) {
+    uchar * mem = (s<d) ? result->data_shreds[ s ] : result->parity_shreds[ s-d ];
+    fd_memcpy( mem, sig, FD_ED25519_SIG_SZ );
+    uchar * node = mem + merkle_off;
+    fd_memcpy( node, root->hash, FD_SHRED_MERKLE_NODE_SZ );
+    ulong proof_cnt = fd_bmtree20_tree_proof( tree, leaf_cnt, s, proof );
+    for( ulong l=0UL; l<proof_cnt; l++ ) {
+      node += FD_SHRED_MERKLE_NODE_SZ;
+      fd_memcpy( node, proof[ l ].hash, FD_SHRED_MERKLE_NODE_SZ );
+    }
+  }
+
+  shredder->offset             = fd_ulong_max( offset, 1UL ); /* Marks an empty batch done */
+  shredder->data_idx_offset   += d;
+  shredder->parity_idx_offset += p;
+
+  result->data_shred_cnt   = d;
+  result->parity_shred_cnt = p;
+  return result;
+}
@@ -0,0 +1,187 @@
+#ifndef HEADER_fd_src_ballet_shred_fd_shredder_h
+#define HEADER_fd_src_ballet_shred_fd_shredder_h
+
+/* fd_shredder turns entry batches into signed Merkle shreds (see
+   fd_shred.h for the wire format).
+
+   An entry batch is split into FEC sets.  All FEC sets of a batch but
+   the last have FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS data shreds and
+   as many parity (coding) shreds.  The last FEC set has as few data
+   shreds as can hold the rest of the batch (at least one, such that an
+   empty batch produces an empty data shred) and a number of parity
+   shreds given by the same table Solana validators use.
+
+   Each FEC set is produced in place.  The caller provides a pointer to
+   FD_SHRED_SZ bytes of memory for every shred of the set, typically the
+   local addresses of dcache chunks the shreds will be published from,
+   and the shredder writes the headers, copies the payload directly from
+   the entry batch, computes the parity shreds with fd_reedsol from the
+   data shreds in place, hashes every shred into a fd_bmtree20 Merkle
+   tree, writes the root and inclusion proof into every shred and signs
+   the root once per FEC set.  No intermediate copies of the shreds are
+   made.
+
+   Within a shred, the erasure coded region of a data shred is the
+   FD_SHREDDER_SHARD_SZ bytes following the signature (its headers and
+   payload) and that of a parity shred is the same number of bytes
+   following its headers.  Data shreds are zero padded from the end of
+   their erasure coded region to their Merkle nodes.  The Merkle leaf of
+   a shred is its content from the end of the signature to its Merkle
+   nodes.  The Merkle nodes are the root followed by the inclusion proof
+   of the shred's leaf, bottom up (a node with a single child has its
+   child as the sibling).  Leaves are ordered data shreds first.  The
+   signature of every shred of the set is the signature of the 20 byte
+   root. */
+
+#include "fd_shred.h"
+#include "../reedsol/fd_reedsol.h"
+#include "../bmtree/fd_bmtree.h"
+#include "../ed25519/fd_ed25519.h"
+
+/* FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS is the number of data shreds
+   in every FEC set of an entry batch but the last. */
+
+#define FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS (32UL)
+
+/* FD_SHREDDER_MERKLE_CNT returns the number of Merkle nodes (root and
+   inclusion proof) of the shreds of an FEC set with leaf_cnt shreds in
+   total.  leaf_cnt is in [2,2^15). */
+
+#define FD_SHREDDER_MERKLE_CNT( leaf_cnt ) ((ulong)fd_ulong_find_msb( (leaf_cnt)-1UL ) + 2UL)
+
+/* FD_SHREDDER_SHARD_SZ returns the size of the erasure coded region of
+   the shreds of an FEC set whose shreds have merkle_cnt Merkle nodes.
+   FD_SHREDDER_PAYLOAD_SZ returns the number of entry batch bytes that
+   fit in a data shred of such an FEC set. */
+
+#define FD_SHREDDER_SHARD_SZ( merkle_cnt )   (FD_SHRED_SZ - FD_SHRED_CODE_HEADER_SZ - (merkle_cnt)*FD_SHRED_MERKLE_NODE_SZ)
+#define FD_SHREDDER_PAYLOAD_SZ( merkle_cnt ) (FD_SHREDDER_SHARD_SZ( merkle_cnt ) - (FD_SHRED_DATA_HEADER_SZ - FD_ED25519_SIG_SZ))
+
+/* FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ is the number of entry batch
+   bytes carried by a normal FEC set. */
+
+#define FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ \
+  (FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS*FD_SHREDDER_PAYLOAD_SZ( FD_SHREDDER_MERKLE_CNT( 2UL*FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS ) ))
+
+#define FD_SHREDDER_ALIGN     (128UL)
+#define FD_SHREDDER_FOOTPRINT (1792UL)
+
+#define FD_SHREDDER_MAGIC (0xf17eda2ce5badd00UL) /* firedancer shredder version 0 */
+
+/* A fd_entry_batch_meta_t describes the entry batch being shredded */
+
+struct fd_entry_batch_meta {
+  ulong parent_offset;  /* Slot number difference to the parent block, in [1,USHORT_MAX] */
+  ulong reference_tick; /* Tick of the slot the batch refers to, in [0,FD_SHRED_DATA_REF_TICK_MASK] */
+  int   block_complete; /* Non-zero if this is the last entry batch of the slot */
+};
+
+typedef struct fd_entry_batch_meta fd_entry_batch_meta_t;
+
+/* A fd_fec_set_t gives the memory of the shreds of an FEC set.  The
+   caller sets data_shreds and parity_shreds to FD_SHRED_SZ byte regions
+   (the first fd_shredder_count_{data,parity}_shreds entries of each are
+   used) and fd_shredder_next_fec_set sets the counts. */
+
+struct fd_fec_set {
+  ulong   data_shred_cnt;
+  ulong   parity_shred_cnt;
+  uchar * data_shreds  [ FD_REEDSOL_DATA_SHREDS_MAX   ];
+  uchar * parity_shreds[ FD_REEDSOL_PARITY_SHREDS_MAX ];
+};
+
+typedef struct fd_fec_set fd_fec_set_t;
+
+struct __attribute__((aligned(FD_SHREDDER_ALIGN))) fd_shredder_private {
+  fd_sha512_t  sha512 [1]; /* Used for signing */
+  fd_reedsol_t reedsol[1];
+
+  ulong magic;             /* ==FD_SHREDDER_MAGIC */
+  ulong shred_version;
+
+  /* Current entry batch */
+
+  uchar const *         entry_batch;
+  ulong                 sz;
+  ulong                 offset;       /* Bytes of the batch shredded so far */
+  fd_entry_batch_meta_t meta;
+
+  /* Position in the slot */
+
+  ulong slot;
+  ulong data_idx_offset;   /* Index of the next data shred of the slot */
+  ulong parity_idx_offset; /* Index of the next parity shred of the slot */
+
+  uchar public_key [ 32 ];
+  uchar private_key[ 32 ];
+};
+
+typedef struct fd_shredder_private fd_shredder_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST static inline ulong fd_shredder_align    ( void ) { return FD_SHREDDER_ALIGN;     }
+FD_FN_CONST static inline ulong fd_shredder_footprint( void ) { return FD_SHREDDER_FOOTPRINT; }
+
+/* fd_shredder_new formats an unused memory region with suitable
+   alignment and footprint for use as a shredder.  Shreds will be signed
+   with the ed25519 key pair public_key / private_key (32 bytes each,
+   copied; the shredder memory holds the private key until deleted) and
+   tagged with shred_version.  Returns mem on success and NULL on
+   failure (logs details).  fd_shredder_join joins the caller to a
+   shredder.  fd_shredder_leave leaves a current local join.
+   fd_shredder_delete unformats the memory region, erasing the key. */
+
+void *
+fd_shredder_new( void *       mem,
+                 void const * public_key,
+                 void const * private_key,
+                 ushort       shred_version );
+
+fd_shredder_t *
+fd_shredder_join( void * mem );
+
+void *
+fd_shredder_leave( fd_shredder_t * shredder );
+
+void *
+fd_shredder_delete( void * mem );
+
+/* fd_shredder_count_{fec_sets,data_shreds,parity_shreds} return the
+   number of FEC sets, data shreds and parity shreds produced by
+   shredding an entry batch of sz bytes. */
+
+FD_FN_CONST ulong fd_shredder_count_fec_sets    ( ulong sz );
+FD_FN_CONST ulong fd_shredder_count_data_shreds ( ulong sz );
+FD_FN_CONST ulong fd_shredder_count_parity_shreds( ulong sz );
+
+/* fd_shredder_init_batch starts shredding the sz byte entry batch
+   pointed to by entry_batch (sz==0 fine) as part of slot.  The batch
+   must remain valid and unmodified until fd_shredder_fini_batch.  If
+   slot differs from the slot of the previous batch, shred indices
+   restart at zero.  Returns shredder. */
+
+fd_shredder_t *
+fd_shredder_init_batch( fd_shredder_t *               shredder,
+                        void const *                  entry_batch,
+                        ulong                         sz,
+                        ulong                         slot,
+                        fd_entry_batch_meta_t const * meta );
+
+/* fd_shredder_next_fec_set produces the next FEC set of the current
+   batch into the shred memory given by result (see fd_fec_set_t).
+   Returns result on success and NULL if the whole batch has been
+   shredded. */
+
+fd_fec_set_t *
+fd_shredder_next_fec_set( fd_shredder_t * shredder,
+                          fd_fec_set_t *  result );
+
+/* fd_shredder_fini_batch ends the current batch.  Returns shredder. */
+
+fd_shredder_t *
+fd_shredder_fini_batch( fd_shredder_t * shredder );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_shred_fd_shredder_h */
@@ -0,0 +1,276 @@
+#include "fd_shredder.h"
+
+FD_STATIC_ASSERT( FD_SHREDDER_ALIGN    ==alignof(fd_shredder_t), unit_test );
+FD_STATIC_ASSERT( FD_SHREDDER_FOOTPRINT==sizeof (fd_shredder_t), unit_test );
+
+/* Shreds are produced into a dcache-like region: consecutive 64 byte
+   aligned slots of FD_SHRED_SZ rounded up to 64 bytes. */
+
+#define SLOT_SZ   (1280UL)
+#define SLOT_CNT  (FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX)
+#define BATCH_MAX (1UL<<20)
+
+static uchar slots[ SLOT_CNT*SLOT_SZ ] __attribute__((aligned(64)));
+static uchar batch[ BATCH_MAX ];
+static uchar rebuilt[ BATCH_MAX ];
+static uchar saved[ SLOT_CNT ][ FD_SHRED_SZ ];
+
+static uchar shredder_mem[ FD_SHREDDER_FOOTPRINT ] __attribute__((aligned(FD_SHREDDER_ALIGN)));
+static uchar reedsol_mem [ FD_REEDSOL_FOOTPRINT  ] __attribute__((aligned(FD_REEDSOL_ALIGN )));
+static uchar commit_mem  [ FD_BMTREE20_COMMIT_FOOTPRINT ] __attribute__((aligned(FD_BMTREE20_COMMIT_ALIGN)));
+
+static fd_fec_set_t *
+fec_set_init( fd_fec_set_t * set ) {
+  for( ulong i=0UL; i<FD_REEDSOL_DATA_SHREDS_MAX;   i++ ) set->data_shreds  [ i ] = slots + i*SLOT_SZ;
+  for( ulong j=0UL; j<FD_REEDSOL_PARITY_SHREDS_MAX; j++ ) set->parity_shreds[ j ] = slots + (FD_REEDSOL_DATA_SHREDS_MAX+j)*SLOT_SZ;
+  return set;
+}
+
+/* check_fec_set validates every shred of set, appends its payload to
+   rebuilt at *rebuilt_sz and checks erased data shreds can be recovered
+   from the parity shreds. */
+
+static void
+check_fec_set( fd_rng_t *           rng,
+               fd_fec_set_t const * set,
+               ulong                slot,
+               ulong                data_idx,
+               ulong                parity_idx,
+               int                  last_in_batch,
+               fd_entry_batch_meta_t const * meta,
+               uchar const *        public_key,
+               fd_sha512_t *        sha,
+               ulong *              rebuilt_sz ) {
+  ulong d        = set->data_shred_cnt;
+  ulong p        = set->parity_shred_cnt;
+  ulong leaf_cnt = d+p;
+  FD_TEST( (1UL<=d) & (d<=FD_SHREDDER_NORMAL_FEC_SET_DATA_SHREDS) & (1UL<=p) & (p<=FD_REEDSOL_PARITY_SHREDS_MAX) );
+
+  ulong merkle_cnt = FD_SHREDDER_MERKLE_CNT( leaf_cnt );
+  ulong merkle_off = FD_SHRED_SZ - merkle_cnt*FD_SHRED_MERKLE_NODE_SZ;
+  ulong shard_sz   = FD_SHREDDER_SHARD_SZ( merkle_cnt );
+
+  /* Recompute the root with the incremental commitment */
+
+  fd_bmtree20_commit_t * commit = fd_bmtree20_commit_init( commit_mem );
+  for( ulong s=0UL; s<leaf_cnt; s++ ) {
+    uchar const * mem = (s<d) ? set->data_shreds[ s ] : set->parity_shreds[ s-d ];
+    fd_bmtree20_node_t leaf[1];
+    fd_bmtree20_hash_leaf( leaf, mem+FD_ED25519_SIG_SZ, merkle_off-FD_ED25519_SIG_SZ );
+    fd_bmtree20_commit_append( commit, leaf, 1UL );
+  }
+  uchar root[ FD_SHRED_MERKLE_NODE_SZ ];
+  fd_memcpy( root, fd_bmtree20_commit_fini( commit ), FD_SHRED_MERKLE_NODE_SZ );
+
+  uchar const * sig0 = set->data_shreds[ 0 ];
+  FD_TEST( fd_ed25519_verify( root, FD_SHRED_MERKLE_NODE_SZ, sig0, public_key, sha )==FD_ED25519_SUCCESS );
+
+  for( ulong s=0UL; s<leaf_cnt; s++ ) {
+    int                is_data = s<d;
+    uchar const *      mem     = is_data ? set->data_shreds[ s ] : set->parity_shreds[ s-d ];
+    fd_shred_t const * shred   = fd_shred_parse( mem );
+    FD_TEST( shred );
+    FD_TEST( fd_shred_type( shred->variant )==(is_data ? FD_SHRED_TYPE_MERKLE_DATA : FD_SHRED_TYPE_MERKLE_CODE) );
+    FD_TEST( fd_shred_merkle_cnt( shred->variant )==merkle_cnt );
+    FD_TEST( fd_shred_merkle_off( shred->variant )==merkle_off );
+    FD_TEST( !memcmp( mem, sig0, FD_ED25519_SIG_SZ ) );
+    FD_TEST( shred->slot==slot );
+    FD_TEST( shred->version==(ushort)4321 );
+    FD_TEST( shred->fec_set_idx==(uint)data_idx );
+
+    /* Walk the inclusion proof up to the root */
+
+    fd_shred_merkle_t const * nodes = fd_shred_merkle_nodes( shred );
+    FD_TEST( !memcmp( nodes[0], root, FD_SHRED_MERKLE_NODE_SZ ) );
+    fd_bmtree20_node_t cur[1]; fd_bmtree20_node_t sib[1];
+    fd_bmtree20_hash_leaf( cur, mem+FD_ED25519_SIG_SZ, merkle_off-FD_ED25519_SIG_SZ );
+    ulong k = s;
+    for( ulong l=1UL; l<merkle_cnt; l++ ) {
+      fd_memcpy( sib->hash, nodes[l], FD_SHRED_MERKLE_NODE_SZ );
+      if( k & 1UL ) fd_bmtree20_private_merge( cur, sib, cur );
+      else          fd_bmtree20_private_merge( cur, cur, sib );
+      k >>= 1;
+    }
+    FD_TEST( !memcmp( cur->hash, root, FD_SHRED_MERKLE_NODE_SZ ) );
+
+    if( is_data ) {
+      FD_TEST( shred->idx==(uint)(data_idx+s) );
+      FD_TEST( shred->data.parent_off==(ushort)meta->parent_offset );
+      uchar flags = (uchar)meta->reference_tick;
+      if( s==d-1UL ) {
+        flags |= FD_SHRED_DATA_FLAG_FEC_SET_COMPLETE;
+        if( last_in_batch && meta->block_complete ) flags |= FD_SHRED_DATA_FLAG_SLOT_COMPLETE;
+      }
+      FD_TEST( shred->data.flags==flags );
+      ulong pl_sz = (ulong)shred->data.size - FD_SHRED_DATA_HEADER_SZ;
+      FD_TEST( pl_sz<=FD_SHREDDER_PAYLOAD_SZ( merkle_cnt ) );
+      FD_TEST( (s==d-1UL) || pl_sz==FD_SHREDDER_PAYLOAD_SZ( merkle_cnt ) );
+      fd_memcpy( rebuilt + *rebuilt_sz, fd_shred_data_payload( shred ), pl_sz );
+      *rebuilt_sz += pl_sz;
+    } else {
+      FD_TEST( shred->idx==(uint)(parity_idx+s-d) );
+      FD_TEST( shred->code.data_cnt==(ushort)d );
+      FD_TEST( shred->code.code_cnt==(ushort)p );
+      FD_TEST( shred->code.idx==(ushort)(s-d) );
+    }
+  }
+
+  /* Erase up to p random shreds and recover them */
+
+  for( ulong s=0UL; s<leaf_cnt; s++ ) fd_memcpy( saved[ s ], (s<d) ? set->data_shreds[ s ] : set->parity_shreds[ s-d ], FD_SHRED_SZ );
+
+  uchar erased[ SLOT_CNT ];
+  fd_memset( erased, 0, SLOT_CNT );
+  ulong erase_cnt = fd_rng_ulong_roll( rng, p+1UL );
+  for( ulong e=0UL; e<erase_cnt; e++ ) {
+    ulong s; do s = fd_rng_ulong_roll( rng, leaf_cnt ); while( erased[ s ] );
+    erased[ s ] = (uchar)1;
+    fd_memset( saved[ s ], 0xA5, FD_SHRED_SZ );
+  }
+
+  fd_reedsol_t * rs = fd_reedsol_recover_init( reedsol_mem, shard_sz );
+  for( ulong s=0UL; s<leaf_cnt; s++ ) {
+    ulong   hdr = (s<d) ? FD_ED25519_SIG_SZ : FD_SHRED_CODE_HEADER_SZ;
+    uchar * shard = saved[ s ] + hdr;
+    if( erased[ s ] ) fd_reedsol_recover_add_erased_shred( rs, s<d, shard );
+    else              fd_reedsol_recover_add_rcvd_shred  ( rs, s<d, shard );
+  }
+  FD_TEST( fd_reedsol_recover_fini( rs )==FD_REEDSOL_SUCCESS );
+  for( ulong s=0UL; s<leaf_cnt; s++ ) {
+    ulong         hdr = (s<d) ? FD_ED25519_SIG_SZ : FD_SHRED_CODE_HEADER_SZ;
+    uchar const * mem = (s<d) ? set->data_shreds[ s ] : set->parity_shreds[ s-d ];
+    FD_TEST( !memcmp( saved[ s ]+hdr, mem+hdr, shard_sz ) );
+  }
+}
+
+static void
+test_batch( fd_rng_t *      rng,
+            fd_shredder_t * shredder,
+            fd_sha512_t *   sha,
+            uchar const *   public_key,
+            ulong           slot,
+            ulong           sz,
+            ulong *         data_idx,
+            ulong *         parity_idx ) {
+  for( ulong b=0UL; b<sz; b++ ) batch[ b ] = fd_rng_uchar( rng );
+
+  fd_entry_batch_meta_t meta[1] = {{
+    .parent_offset  = 1UL + fd_rng_ulong_roll( rng, 100UL ),
+    .reference_tick = fd_rng_ulong_roll( rng, 64UL ),
+    .block_complete = (int)fd_rng_uint_roll( rng, 2U )
+  }};
+
+  fd_fec_set_t set[1]; fec_set_init( set );
+
+  FD_TEST( fd_shredder_init_batch( shredder, batch, sz, slot, meta )==shredder );
+  ulong fec_set_cnt   = fd_shredder_count_fec_sets     ( sz );
+  ulong data_cnt      = fd_shredder_count_data_shreds  ( sz );
+  ulong parity_cnt    = fd_shredder_count_parity_shreds( sz );
+  ulong rebuilt_sz    = 0UL;
+  ulong set_cnt       = 0UL;
+  ulong data_cnt_seen = 0UL;
+  ulong par_cnt_seen  = 0UL;
+  while( fd_shredder_next_fec_set( shredder, set ) ) {
+    set_cnt++;
+    check_fec_set( rng, set, slot, *data_idx, *parity_idx, set_cnt==fec_set_cnt, meta, public_key, sha, &rebuilt_sz );
+    *data_idx      += set->data_shred_cnt;
+    *parity_idx    += set->parity_shred_cnt;
+    data_cnt_seen  += set->data_shred_cnt;
+    par_cnt_seen   += set->parity_shred_cnt;
+    fec_set_init( set );
+  }
+  FD_TEST( fd_shredder_fini_batch( shredder )==shredder );
+
+  FD_TEST( set_cnt      ==fec_set_cnt );
+  FD_TEST( data_cnt_seen==data_cnt    );
+  FD_TEST( par_cnt_seen ==parity_cnt  );
+  FD_TEST( rebuilt_sz   ==sz          );
+  FD_TEST( !memcmp( rebuilt, batch, sz ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+
+  uchar private_key[ 32 ];
+  uchar public_key [ 32 ];
+  for( ulong b=0UL; b<32UL; b++ ) private_key[ b ] = fd_rng_uchar( rng );
+  fd_ed25519_public_from_private( public_key, private_key, sha );
+
+  FD_TEST( fd_shredder_align    ()==FD_SHREDDER_ALIGN     );
+  FD_TEST( fd_shredder_footprint()==FD_SHREDDER_FOOTPRINT );
+
+  FD_TEST( !fd_shredder_new( NULL,             public_key, private_key, (ushort)4321 ) );
+  FD_TEST( !fd_shredder_new( shredder_mem+1UL, public_key, private_key, (ushort)4321 ) );
+  FD_TEST( !fd_shredder_new( shredder_mem,     NULL,       private_key, (ushort)4321 ) );
+  FD_TEST( !fd_shredder_join( shredder_mem ) );
+
+  fd_shredder_t * shredder = fd_shredder_join( fd_shredder_new( shredder_mem, public_key, private_key, (ushort)4321 ) );
+  FD_TEST( shredder );
+
+  /* Normal FEC sets are 32:32 */
+
+  FD_TEST( FD_SHREDDER_MERKLE_CNT( 64UL )==7UL );
+  FD_TEST( fd_shredder_count_fec_sets     ( FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ     )==1UL  );
+  FD_TEST( fd_shredder_count_fec_sets     ( FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ+1UL )==2UL  );
+  FD_TEST( fd_shredder_count_data_shreds  ( FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ     )==32UL );
+  FD_TEST( fd_shredder_count_parity_shreds( FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ     )==32UL );
+  FD_TEST( fd_shredder_count_data_shreds  ( 0UL )==1UL  );
+  FD_TEST( fd_shredder_count_parity_shreds( 0UL )==17UL );
+
+  FD_LOG_NOTICE(( "Testing shredding" ));
+
+  ulong data_idx   = 0UL;
+  ulong parity_idx = 0UL;
+  ulong slot       = 1000UL;
+  ulong normal     = FD_SHREDDER_NORMAL_FEC_SET_PAYLOAD_SZ;
+  ulong const test_sz[] = { 0UL, 1UL, 975UL, 976UL, 995UL, 996UL, 5000UL, normal-1UL, normal, normal+1UL, 3UL*normal+777UL, 100000UL };
+  for( ulong i=0UL; i<sizeof(test_sz)/sizeof(ulong); i++ )
+    test_batch( rng, shredder, sha, public_key, slot, test_sz[ i ], &data_idx, &parity_idx );
+
+  /* A new slot restarts the shred indices */
+
+  slot++; data_idx = 0UL; parity_idx = 0UL;
+  for( ulong rem=20UL; rem; rem-- ) {
+    test_batch( rng, shredder, sha, public_key, slot, fd_rng_ulong_roll( rng, 4UL*normal ), &data_idx, &parity_idx );
+    if( fd_rng_uint_roll( rng, 4U )==0U ) { slot++; data_idx = 0UL; parity_idx = 0UL; }
+  }
+
+  /* Benchmark */
+
+  for( ulong b=0UL; b<BATCH_MAX; b++ ) batch[ b ] = fd_rng_uchar( rng );
+  fd_entry_batch_meta_t meta[1] = {{ .parent_offset = 1UL, .reference_tick = 0UL, .block_complete = 0 }};
+  fd_fec_set_t set[1]; fec_set_init( set );
+
+  static ulong const bench_sz[3] = { 10000UL, 65536UL, BATCH_MAX };
+  for( ulong i=0UL; i<3UL; i++ ) {
+    ulong sz   = bench_sz[ i ];
+    ulong iter = fd_ulong_max( (4UL<<20) / sz, 2UL );
+    ulong shred_cnt = iter*( fd_shredder_count_data_shreds( sz ) + fd_shredder_count_parity_shreds( sz ) );
+    long  dt   = -fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      fd_shredder_init_batch( shredder, batch, sz, slot, meta );
+      while( fd_shredder_next_fec_set( shredder, set ) ) {}
+      fd_shredder_fini_batch( shredder );
+    }
+    dt += fd_log_wallclock();
+    FD_LOG_NOTICE(( "batch sz %7lu: ~%8.0f shreds/s / core, ~%6.3f Gbps of entry data / core",
+                    sz, (double)shred_cnt*1e9/(double)dt, (double)(8UL*sz*iter)/(double)dt ));
+  }
+
+  FD_TEST( fd_shredder_leave( shredder )==(void *)shredder_mem );
+  FD_TEST( fd_shredder_delete( shredder_mem )==(void *)shredder_mem );
+  FD_TEST( !fd_shredder_join( shredder_mem ) );
+
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
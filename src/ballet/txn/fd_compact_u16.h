@@ -18,6 +18,9 @@
    and not exported more widely. */
 
 #include "../fd_ballet_base.h"
+#if FD_HAS_AVX512
+#include "../../util/simd/fd_avx512.h"
+#endif
 
 
 FD_PROTOTYPES_BEGIN
@@ -88,5 +91,36 @@ fd_cu16_dec( uchar const * buf,
   return sz;
 }
 
+#if FD_HAS_AVX512
+
+/* fd_cu16_dec_wwv: Decodes the compact-u16 in the low 3 bytes of each
+   lane of w.  This is a branch free vectorization of fd_cu16_dec_sz /
+   fd_cu16_dec_fixed.  Returns the decoded values and sets *_sz to the
+   encoded sizes (lanes that are not a legally encoded compact-u16 in at
+   most 3 bytes get a size of 0, like fd_cu16_dec_sz). */
+static inline wwv_t
+fd_cu16_dec_wwv( wwv_t   w,
+                 wwv_t * _sz ) {
+  wwv_t b0 = wwv_and( w,              wwv_bcast( 0xFFUL ) );
+  wwv_t b1 = wwv_and( wwv_shr( w,  8 ), wwv_bcast( 0xFFUL ) );
+  wwv_t b2 = wwv_and( wwv_shr( w, 16 ), wwv_bcast( 0xFFUL ) );
+
+  wwc_t c0 = wwv_to_wwc( wwv_and( b0, wwv_bcast( 0x80UL ) ) ); /* b0 is continued */
+  wwc_t c1 = wwv_to_wwc( wwv_and( b1, wwv_bcast( 0x80UL ) ) ); /* b1 is continued */
+  wwc_t sz1 = wwc_not( c0 );
+  wwc_t sz2 = wwc_and( c0, wwc_andnot( c1, wwv_to_wwc( b1 ) ) );                               /* minimal */
+  wwc_t sz3 = wwc_and( wwc_and( c0, c1 ),
+                       wwc_andnot( wwv_to_wwc( wwv_and( b2, wwv_bcast( 0xFCUL ) ) ), wwv_to_wwc( b2 ) ) ); /* minimal, <2^16 */
+
+  *_sz = wwv_if( sz1, wwv_one(), wwv_if( sz2, wwv_bcast( 2UL ), wwv_if( sz3, wwv_bcast( 3UL ), wwv_zero() ) ) );
+
+  wwv_t lo = wwv_and( b0, wwv_bcast( 0x7FUL ) );
+  wwv_t v2 = wwv_add( lo, wwv_shl( b1, 7 ) );
+  wwv_t v3 = wwv_add( wwv_add( lo, wwv_shl( wwv_and( b1, wwv_bcast( 0x7FUL ) ), 7 ) ), wwv_shl( b2, 14 ) );
+  return wwv_if( sz1, b0, wwv_if( sz2, v2, v3 ) );
+}
+
+#endif /* FD_HAS_AVX512 */
+
 FD_PROTOTYPES_END
 #endif /* HEADER_fd_src_ballet_txn_fd_compact_u16_h */
@@ -634,6 +634,26 @@ static inline ulong FD_FN_CONST fd_txn_acct_iter_end( void ) { return FD_TXN_ACC
    since it refers to byte ranges inside the payload. */
 ulong fd_txn_parse( uchar const * payload, ulong payload_sz, void * out_buf, fd_txn_parse_counters_t * counters_opt );
 
+/* fd_txn_parse_batch: Parses the cnt transactions payload[j] (each
+   payload_sz[j] bytes) into out_buf[j], with the same requirements as
+   fd_txn_parse for each.  out_sz[j] is set to what fd_txn_parse would
+   have returned for transaction j, and the contents of out_buf[j] and
+   the counters (if counters_opt is non-NULL) are exactly the same as a
+   sequence of fd_txn_parse calls in order j=0,1,...,cnt-1.  Returns the
+   number of transactions that parsed successfully.
+
+   On targets with AVX-512, the fixed size part of the transaction
+   (everything up to the instruction count) is parsed 8 transactions at
+   a time, which is where most of the parse time of typical small
+   transactions and most malformed spam goes. */
+ulong
+fd_txn_parse_batch( uchar const * const *     payload,
+                    ulong const *             payload_sz,
+                    void * const *            out_buf,
+                    ulong *                   out_sz,
+                    ulong                     cnt,
+                    fd_txn_parse_counters_t * counters_opt );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_txn_fd_txn_h */
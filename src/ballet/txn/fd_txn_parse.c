@@ -1,7 +1,141 @@
 #include "fd_txn.h"
 #include "fd_compact_u16.h"
+#if FD_HAS_AVX512
+#include "../../util/simd/fd_avx512.h"
+#endif
+
+/* Increment counters and return immediately if cond is false. */
+#define CHECK( cond )  do {                                                                                   \
+  if( FD_UNLIKELY( !(cond) ) ) {                                                                              \
+    if( FD_LIKELY( counters_opt ) ) {                                                                         \
+      counters_opt->failure_ring[ ( counters_opt->failure_cnt++ )%FD_TXN_PARSE_COUNTERS_RING_SZ ] = __LINE__; \
+    }                                                                                                         \
+    return 0UL;                                                                                               \
+  }                                                                                                           \
+} while( 0 )
+/* CHECK that it is safe to read at least n more bytes assuming i is the
+   current location. n is untrusted and could trigger overflow, so don't do
+   i+n<=payload_sz */
+#define CHECK_LEFT( n ) CHECK( (n)<=(payload_sz-i) )
+/* READ_CHECKED_COMPACT_U16 safely reads a compact-u16 from the indicated
+   location in the payload.  It stores the resulting value in the ushort
+   variable called var_name.  It stores the size in out_sz. */
+#define READ_CHECKED_COMPACT_U16( out_sz, var_name, where )               \
+  do {                                                                    \
+    ulong _where = (where);                                               \
+    ulong _out_sz = fd_cu16_dec_sz( payload+_where, payload_sz-_where );  \
+    CHECK( _out_sz );                                                     \
+    (var_name) = fd_cu16_dec_fixed( payload+_where, _out_sz );            \
+    (out_sz)   = _out_sz;                                                 \
+  } while( 0 )
+
+/* Minimal instr has 1B for program id, 1B acct_addr list, 1B for no data */
+#define MIN_INSTR_SZ (3UL)
+
+/* fd_txn_parse_tail parses everything after the instruction count (the
+   instructions, the address table lookups and the final validation).
+   parsed has all the fields up to and including instr_cnt assigned and
+   i is the offset of the first instruction.  It follows the same
+   discipline as fd_txn_parse (see below) and is shared by fd_txn_parse
+   and fd_txn_parse_batch such that both produce identical results
+   (including the counters). */
+
+static inline ulong
+fd_txn_parse_tail( uchar const             * payload,
+                   ulong                     payload_sz,
+                   fd_txn_t                * parsed,
+                   ulong                     i,
+                   fd_txn_parse_counters_t * counters_opt ) {
+  /* A temporary for storing the return value of fd_cu16_dec_sz */
+  ulong bytes_consumed = 0UL;
+
+  uchar  transaction_version = parsed->transaction_version;
+  ushort acct_addr_cnt       = parsed->acct_addr_cnt;
+  ushort instr_cnt           = parsed->instr_cnt;
+
+  for( ulong j=0UL; j<instr_cnt; j++ ) {
+    ushort acct_cnt = (ushort)0;
+    ushort data_sz  = (ushort)0;
+    CHECK_LEFT( MIN_INSTR_SZ                    );   uchar program_id     = payload[ i ];     i++;
+    READ_CHECKED_COMPACT_U16( bytes_consumed,             acct_cnt,                  i );     i+=bytes_consumed;
+    CHECK_LEFT( acct_cnt                        );   ulong acct_off       =          i  ;     i+=acct_cnt;
+    READ_CHECKED_COMPACT_U16( bytes_consumed,             data_sz,                   i );     i+=bytes_consumed;
+    CHECK_LEFT( data_sz                         );   ulong data_off       =          i  ;     i+=data_sz;
+
+    /* Account 0 is the fee payer and the program can't be the fee payer.
+       The fee payer account must be owned by the system program, but the
+       program must be an executable account and the system program is not
+       permitted to own any executable account.
+       As of https://github.com/solana-labs/solana/issues/25034, the program ID
+       can't come from a table. */
+    CHECK( (0UL < (ulong)program_id) & ((ulong)program_id < (ulong)acct_addr_cnt) );
 
+    parsed->instr[ j ].program_id          = program_id;
+    parsed->instr[ j ]._padding_reserved_1 = (uchar)0;
+    parsed->instr[ j ].acct_cnt            = acct_cnt;
+    parsed->instr[ j ].data_sz             = data_sz;
+    /* By our invariant, i<size when it was copied into acct_off and data_off,
+       and size<=USHORT_MAX from above, so this cast is safe */
+    parsed->instr[ j ].acct_off            = (ushort)acct_off;
+    parsed->instr[ j ].data_off            = (ushort)data_off;
+  }
 
+  ushort addr_table_cnt               = 0;
+  ulong  addr_table_adtl_writable_cnt = 0;
+  ulong  addr_table_adtl_cnt          = 0;
+
+  /* parsed->instr_cnt set above, so calling get_address_tables is safe */
+  fd_txn_acct_addr_lut_t * address_tables = fd_txn_get_address_tables( parsed );
+  if( FD_LIKELY( transaction_version==FD_TXN_V0 ) ) {
+  #define MIN_ADDR_LUT_SIZE (34UL)
+    READ_CHECKED_COMPACT_U16( bytes_consumed,             addr_table_cnt,            i );     i+=bytes_consumed;
+    CHECK( addr_table_cnt <= FD_TXN_ADDR_TABLE_LOOKUP_MAX );
+    CHECK_LEFT( MIN_ADDR_LUT_SIZE*addr_table_cnt );
+
+    for( ulong j=0; j<addr_table_cnt; j++ ) {
+      CHECK_LEFT( FD_TXN_ACCT_ADDR_SZ           );   ulong addr_off       =          i  ;     i+=FD_TXN_ACCT_ADDR_SZ;
+
+      ushort writable_cnt = 0;
+      ushort readonly_cnt = 0;
+      READ_CHECKED_COMPACT_U16( bytes_consumed,            writable_cnt,             i );     i+=bytes_consumed;
+      CHECK_LEFT( writable_cnt                  );   ulong writable_off   =          i  ;     i+=writable_cnt;
+      READ_CHECKED_COMPACT_U16( bytes_consumed,            readonly_cnt,             i );     i+=bytes_consumed;
+      CHECK_LEFT( readonly_cnt                  );   ulong readonly_off   =          i  ;     i+=readonly_cnt;
+
+      CHECK( writable_cnt<=FD_TXN_ACCT_ADDR_MAX-acct_addr_cnt ); /* implies <256 */
+      CHECK( readonly_cnt<=FD_TXN_ACCT_ADDR_MAX-acct_addr_cnt );
+      address_tables[ j ].addr_off      = (ushort)addr_off;
+      address_tables[ j ].writable_cnt  = (uchar )writable_cnt;
+      address_tables[ j ].readonly_cnt  = (uchar )readonly_cnt;
+      address_tables[ j ].writable_off  = (ushort)writable_off;
+      address_tables[ j ].readonly_off  = (ushort)readonly_off;
+
+      addr_table_adtl_writable_cnt += (ulong)writable_cnt;
+      addr_table_adtl_cnt          += (ulong)writable_cnt + (ulong)readonly_cnt;
+    }
+  }
+  #undef MIN_ADDR_LUT_SIZE
+  /* Check for leftover bytes */
+  CHECK( i==payload_sz );
+
+  CHECK( acct_addr_cnt+addr_table_adtl_cnt<=FD_TXN_ACCT_ADDR_MAX ); /* implies addr_table_adtl_cnt<256 */
+
+
+  /* Final validation that all the account address indices are in range */
+  for( ulong j=0; j<instr_cnt; j++ ) {
+    for( ulong k=0; k<parsed->instr[ j ].acct_cnt; k++ ) {
+      CHECK( payload[ parsed->instr[ j ].acct_off + k ] < acct_addr_cnt + addr_table_adtl_cnt );
+    }
+  }
+  /* Assign final variables */
+  parsed->addr_table_lookup_cnt         = (uchar)addr_table_cnt;
+  parsed->addr_table_adtl_writable_cnt  = (uchar)addr_table_adtl_writable_cnt;
+  parsed->addr_table_adtl_cnt           = (uchar)addr_table_adtl_cnt;
+  parsed->_padding_reserved_1           = (uchar)0;
+
+  if( FD_LIKELY( counters_opt ) ) counters_opt->success_cnt++;
+  return fd_txn_footprint( instr_cnt, addr_table_cnt );
+}
 
 ulong
 fd_txn_parse( uchar const             * payload,
@@ -43,33 +177,6 @@ fd_txn_parse( uchar const             * payload,
   /* A temporary for storing the return value of fd_cu16_dec_sz */
   ulong bytes_consumed = 0UL;
 
-  /* Increment counters and return immediately if cond is false. */
-  #define CHECK( cond )  do {                                                                                   \
-    if( FD_UNLIKELY( !(cond) ) ) {                                                                              \
-      if( FD_LIKELY( counters_opt ) ) {                                                                         \
-        counters_opt->failure_ring[ ( counters_opt->failure_cnt++ )%FD_TXN_PARSE_COUNTERS_RING_SZ ] = __LINE__; \
-      }                                                                                                         \
-      return 0UL;                                                                                               \
-    }                                                                                                           \
-  } while( 0 )
-  /* CHECK that it is safe to read at least n more bytes assuming i is the
-     current location. n is untrusted and could trigger overflow, so don't do
-     i+n<=payload_sz */
-  #define CHECK_LEFT( n ) CHECK( (n)<=(payload_sz-i) )
-  /* READ_CHECKED_COMPACT_U16 safely reads a compact-u16 from the indicated
-     location in the payload.  It stores the resulting value in the ushort
-     variable called var_name.  It stores the size in out_sz. */
-  #define READ_CHECKED_COMPACT_U16( out_sz, var_name, where )               \
-    do {                                                                    \
-      ulong _where = (where);                                               \
-      ulong _out_sz = fd_cu16_dec_sz( payload+_where, payload_sz-_where );  \
-      CHECK( _out_sz );                                                     \
-      (var_name) = fd_cu16_dec_fixed( payload+_where, _out_sz );            \
-      (out_sz)   = _out_sz;                                                 \
-    } while( 0 )
-
-  /* Minimal instr has 1B for program id, 1B acct_addr list, 1B for no data */
-  #define MIN_INSTR_SZ (3UL)
   CHECK( payload_sz<=FD_TXN_MTU );
 
   /* The documentation sometimes calls this field a compact-u16 and sometimes a u8.
@@ -131,92 +238,178 @@ fd_txn_parse( uchar const             * payload,
      addr_table_adtl_cnt, _padding_reserved_1 later */
   parsed->instr_cnt                     = instr_cnt;
 
+  return fd_txn_parse_tail( payload, payload_sz, parsed, i, counters_opt );
+}
 
-  for( ulong j=0UL; j<instr_cnt; j++ ) {
-    ushort acct_cnt = (ushort)0;
-    ushort data_sz  = (ushort)0;
-    CHECK_LEFT( MIN_INSTR_SZ                    );   uchar program_id     = payload[ i ];     i++;
-    READ_CHECKED_COMPACT_U16( bytes_consumed,             acct_cnt,                  i );     i+=bytes_consumed;
-    CHECK_LEFT( acct_cnt                        );   ulong acct_off       =          i  ;     i+=acct_cnt;
-    READ_CHECKED_COMPACT_U16( bytes_consumed,             data_sz,                   i );     i+=bytes_consumed;
-    CHECK_LEFT( data_sz                         );   ulong data_off       =          i  ;     i+=data_sz;
-
-    /* Account 0 is the fee payer and the program can't be the fee payer.
-       The fee payer account must be owned by the system program, but the
-       program must be an executable account and the system program is not
-       permitted to own any executable account.
-       As of https://github.com/solana-labs/solana/issues/25034, the program ID
-       can't come from a table. */
-    CHECK( (0UL < (ulong)program_id) & ((ulong)program_id < (ulong)acct_addr_cnt) );
-
-    parsed->instr[ j ].program_id          = program_id;
-    parsed->instr[ j ]._padding_reserved_1 = (uchar)0;
-    parsed->instr[ j ].acct_cnt            = acct_cnt;
-    parsed->instr[ j ].data_sz             = data_sz;
-    /* By our invariant, i<size when it was copied into acct_off and data_off,
-       and size<=USHORT_MAX from above, so this cast is safe */
-    parsed->instr[ j ].acct_off            = (ushort)acct_off;
-    parsed->instr[ j ].data_off            = (ushort)data_off;
-  }
-  #undef MIN_INSTR_SIZE
-
-  ushort addr_table_cnt               = 0;
-  ulong  addr_table_adtl_writable_cnt = 0;
-  ulong  addr_table_adtl_cnt          = 0;
-
-  /* parsed->instr_cnt set above, so calling get_address_tables is safe */
-  fd_txn_acct_addr_lut_t * address_tables = fd_txn_get_address_tables( parsed );
-  if( FD_LIKELY( transaction_version==FD_TXN_V0 ) ) {
-  #define MIN_ADDR_LUT_SIZE (34UL)
-    READ_CHECKED_COMPACT_U16( bytes_consumed,             addr_table_cnt,            i );     i+=bytes_consumed;
-    CHECK( addr_table_cnt <= FD_TXN_ADDR_TABLE_LOOKUP_MAX );
-    CHECK_LEFT( MIN_ADDR_LUT_SIZE*addr_table_cnt );
+#if FD_HAS_AVX512
+
+/* fd_txn_parse_private_gather loads the 8 bytes at p+off (as a little
+   endian ulong) for the lanes in m.  Other lanes are zero and are not
+   accessed. */
+
+#define fd_txn_parse_private_gather( m, p, off ) \
+  _mm512_mask_i64gather_epi64( wwv_zero(), (m), wwv_add( (p), (off) ), NULL, 1 )
+
+/* fd_txn_parse_private_hdr8 parses the transaction header (everything
+   up to and including instr_cnt, the first part of fd_txn_parse) of 8
+   transactions in parallel.  It does exactly the same checks as
+   fd_txn_parse, but only trusts 8 byte loads that fit within the
+   payload, such that lanes whose headers are too close to the end of
+   the payload are treated as if they failed (they get processed by the
+   scalar parser).  Returns the mask of lanes that passed.  On return,
+   hdr[k][lane] holds the header fields of the lanes that passed. */
+
+#define HDR_SIG_CNT     (0)
+#define HDR_MSG_OFF     (1)
+#define HDR_VERSION     (2)
+#define HDR_RO_SIGNED   (3)
+#define HDR_RO_UNSIGNED (4)
+#define HDR_ACCT_CNT    (5)
+#define HDR_ACCT_OFF    (6)
+#define HDR_INSTR_CNT   (7)
+#define HDR_I           (8)
+#define HDR_CNT         (9)
+
+static int
+fd_txn_parse_private_hdr8( wwv_t p,
+                           wwv_t sz,
+                           ulong hdr[ HDR_CNT ][ 8 ] ) {
+  wwc_t ok = wwc_not( wwv_gt( sz, wwv_bcast( FD_TXN_MTU ) ) ) & wwc_not( wwv_lt( sz, wwv_bcast( 8UL ) ) );
+
+  wwv_t w0      = fd_txn_parse_private_gather( ok, p, wwv_zero() );
+  wwv_t sig_cnt = wwv_and( w0, wwv_bcast( 0xFFUL ) );
+  ok &= wwc_not( wwv_lt( sig_cnt, wwv_one() ) ) & wwc_not( wwv_gt( sig_cnt, wwv_bcast( FD_TXN_SIG_MAX ) ) );
+
+  wwv_t msg_off = wwv_add( wwv_one(), wwv_shl( sig_cnt, 6 ) ); /* 1 + FD_TXN_SIGNATURE_SZ*sig_cnt */
+  ok &= wwc_not( wwv_gt( wwv_add( msg_off, wwv_bcast( 8UL ) ), sz ) );
+
+  wwv_t w1  = fd_txn_parse_private_gather( ok, p, msg_off );
+  wwc_t ver = wwv_to_wwc( wwv_and( w1, wwv_bcast( 0x80UL ) ) );
+  ok &= wwc_not( ver ) | wwv_eq( wwv_and( w1, wwv_bcast( 0x7FUL ) ), wwv_bcast( (ulong)FD_TXN_V0 ) );
+
+  /* For versioned txns, skip the version byte such that the rest of
+     the header is at the same place in w for both formats */
+  wwv_t w = wwv_if( ver, wwv_shr( w1, 8 ), w1 );
+  ok &= wwv_eq( wwv_and( w, wwv_bcast( 0xFFUL ) ), sig_cnt );
+  wwv_t ro_signed   = wwv_and( wwv_shr( w,  8 ), wwv_bcast( 0xFFUL ) );
+  wwv_t ro_unsigned = wwv_and( wwv_shr( w, 16 ), wwv_bcast( 0xFFUL ) );
+  ok &= wwv_lt( ro_signed, sig_cnt );
+
+  wwv_t cu_sz;
+  wwv_t acct_cnt = fd_cu16_dec_wwv( wwv_shr( w, 24 ), &cu_sz );
+  ok &= wwv_to_wwc( cu_sz );
+  ok &= wwc_not( wwv_gt( sig_cnt, acct_cnt ) ) & wwc_not( wwv_gt( acct_cnt, wwv_bcast( FD_TXN_ACCT_ADDR_MAX ) ) );
+  ok &= wwc_not( wwv_gt( wwv_add( sig_cnt, ro_unsigned ), acct_cnt ) );
+
+  wwv_t acct_off = wwv_add( wwv_add( msg_off, wwv_if( ver, wwv_bcast( 4UL ), wwv_bcast( 3UL ) ) ), cu_sz );
+  wwv_t i        = wwv_add( wwv_add( acct_off, wwv_shl( acct_cnt, 5 ) ), wwv_bcast( FD_TXN_BLOCKHASH_SZ ) );
+  ok &= wwc_not( wwv_gt( wwv_add( i, wwv_bcast( 8UL ) ), sz ) );
+
+  wwv_t w2        = fd_txn_parse_private_gather( ok, p, i );
+  wwv_t instr_cnt = fd_cu16_dec_wwv( w2, &cu_sz );
+  ok &= wwv_to_wwc( cu_sz );
+  i = wwv_add( i, cu_sz );
+  ok &= wwc_not( wwv_gt( instr_cnt, wwv_bcast( FD_TXN_INSTR_MAX ) ) );
+  ok &= wwc_not( wwv_gt( wwv_add( wwv_shl( instr_cnt, 1 ), instr_cnt ) /* MIN_INSTR_SZ*instr_cnt */, wwv_sub( sz, i ) ) );
+  ok &= wwv_gt( acct_cnt, wwv_if( wwv_to_wwc( instr_cnt ), wwv_one(), wwv_zero() ) );
+
+  wwv_st( hdr[ HDR_SIG_CNT     ], sig_cnt                                                           );
+  wwv_st( hdr[ HDR_MSG_OFF     ], msg_off                                                           );
+  wwv_st( hdr[ HDR_VERSION     ], wwv_if( ver, wwv_bcast( (ulong)FD_TXN_V0 ), wwv_bcast( (ulong)FD_TXN_VLEGACY ) ) );
+  wwv_st( hdr[ HDR_RO_SIGNED   ], ro_signed                                                         );
+  wwv_st( hdr[ HDR_RO_UNSIGNED ], ro_unsigned                                                       );
+  wwv_st( hdr[ HDR_ACCT_CNT    ], acct_cnt                                                          );
+  wwv_st( hdr[ HDR_ACCT_OFF    ], acct_off                                                          );
+  wwv_st( hdr[ HDR_INSTR_CNT   ], instr_cnt                                                         );
+  wwv_st( hdr[ HDR_I           ], i                                                                 );
+  return wwc_pack( ok );
+}
 
-    for( ulong j=0; j<addr_table_cnt; j++ ) {
-      CHECK_LEFT( FD_TXN_ACCT_ADDR_SZ           );   ulong addr_off       =          i  ;     i+=FD_TXN_ACCT_ADDR_SZ;
+#undef fd_txn_parse_private_gather
 
-      ushort writable_cnt = 0;
-      ushort readonly_cnt = 0;
-      READ_CHECKED_COMPACT_U16( bytes_consumed,            writable_cnt,             i );     i+=bytes_consumed;
-      CHECK_LEFT( writable_cnt                  );   ulong writable_off   =          i  ;     i+=writable_cnt;
-      READ_CHECKED_COMPACT_U16( bytes_consumed,            readonly_cnt,             i );     i+=bytes_consumed;
-      CHECK_LEFT( readonly_cnt                  );   ulong readonly_off   =          i  ;     i+=readonly_cnt;
+#endif /* FD_HAS_AVX512 */
 
-      CHECK( writable_cnt<=FD_TXN_ACCT_ADDR_MAX-acct_addr_cnt ); /* implies <256 */
-      CHECK( readonly_cnt<=FD_TXN_ACCT_ADDR_MAX-acct_addr_cnt );
-      address_tables[ j ].addr_off      = (ushort)addr_off;
-      address_tables[ j ].writable_cnt  = (uchar )writable_cnt;
-      address_tables[ j ].readonly_cnt  = (uchar )readonly_cnt;
-      address_tables[ j ].writable_off  = (ushort)writable_off;
-      address_tables[ j ].readonly_off  = (ushort)readonly_off;
+ulong
+fd_txn_parse_batch( uchar const * const *     payload,
+                    ulong const *             payload_sz,
+                    void * const *            out_buf,
+                    ulong *                   out_sz,
+                    ulong                     cnt,
+                    fd_txn_parse_counters_t * counters_opt ) {
+  ulong ok_cnt = 0UL;
+
+# if FD_HAS_AVX512
+
+  /* Parse the headers 8 transactions at a time and then finish the
+     lanes in order (such that the counters are accumulated in the same
+     order as with a sequence of fd_txn_parse calls).  Lanes that failed
+     the vectorized header parse are redone with the scalar parser (which
+     also gives them the exact same failure accounting). */
+
+  ulong _p  [ 8 ] __attribute__((aligned(64)));
+  ulong _sz [ 8 ] __attribute__((aligned(64)));
+  ulong hdr [ HDR_CNT ][ 8 ] __attribute__((aligned(64)));
+
+  for( ulong j0=0UL; j0<cnt; j0+=8UL ) {
+    ulong lane_cnt = fd_ulong_min( cnt-j0, 8UL );
+    for( ulong lane=0UL; lane<8UL; lane++ ) { /* Unused lanes fail the sz check and are never accessed */
+      _p [ lane ] = lane<lane_cnt ? (ulong)payload[ j0+lane ] : 0UL;
+      _sz[ lane ] = lane<lane_cnt ?       payload_sz[ j0+lane ] : 0UL;
+    }
 
-      addr_table_adtl_writable_cnt += (ulong)writable_cnt;
-      addr_table_adtl_cnt          += (ulong)writable_cnt + (ulong)readonly_cnt;
+    int fast = fd_txn_parse_private_hdr8( wwv_ld( _p ), wwv_ld( _sz ), hdr );
+
+    for( ulong lane=0UL; lane<lane_cnt; lane++ ) {
+      ulong j = j0+lane;
+      ulong sz;
+      if( FD_LIKELY( (fast>>lane) & 1 ) ) {
+        fd_txn_t * parsed = (fd_txn_t *)out_buf[ j ];
+        parsed->transaction_version   = (uchar )hdr[ HDR_VERSION     ][ lane ];
+        parsed->signature_cnt         = (uchar )hdr[ HDR_SIG_CNT     ][ lane ];
+        parsed->signature_off         = (ushort)1;
+        parsed->message_off           = (ushort)hdr[ HDR_MSG_OFF     ][ lane ];
+        parsed->readonly_signed_cnt   = (uchar )hdr[ HDR_RO_SIGNED   ][ lane ];
+        parsed->readonly_unsigned_cnt = (uchar )hdr[ HDR_RO_UNSIGNED ][ lane ];
+        parsed->acct_addr_cnt         = (ushort)hdr[ HDR_ACCT_CNT    ][ lane ];
+        parsed->acct_addr_off         = (ushort)hdr[ HDR_ACCT_OFF    ][ lane ];
+        parsed->recent_blockhash_off  = (ushort)(hdr[ HDR_ACCT_OFF ][ lane ] + FD_TXN_ACCT_ADDR_SZ*hdr[ HDR_ACCT_CNT ][ lane ]);
+        parsed->instr_cnt             = (ushort)hdr[ HDR_INSTR_CNT   ][ lane ];
+        sz = fd_txn_parse_tail( payload[ j ], payload_sz[ j ], parsed, hdr[ HDR_I ][ lane ], counters_opt );
+      } else {
+        sz = fd_txn_parse( payload[ j ], payload_sz[ j ], out_buf[ j ], counters_opt );
+      }
+      out_sz[ j ] = sz;
+      ok_cnt += (ulong)!!sz;
     }
   }
-  #undef MIN_ADDR_LUT_SIZE
-  /* Check for leftover bytes */
-  CHECK( i==payload_sz );
-
-  CHECK( acct_addr_cnt+addr_table_adtl_cnt<=FD_TXN_ACCT_ADDR_MAX ); /* implies addr_table_adtl_cnt<256 */
 
+# else
 
-  /* Final validation that all the account address indices are in range */
-  for( ulong j=0; j<instr_cnt; j++ ) {
-    for( ulong k=0; k<parsed->instr[ j ].acct_cnt; k++ ) {
-      CHECK( payload[ parsed->instr[ j ].acct_off + k ] < acct_addr_cnt + addr_table_adtl_cnt );
-    }
+  for( ulong j=0UL; j<cnt; j++ ) {
+    ulong sz = fd_txn_parse( payload[ j ], payload_sz[ j ], out_buf[ j ], counters_opt );
+    out_sz[ j ] = sz;
+    ok_cnt += (ulong)!!sz;
   }
-  /* Assign final variables */
-  parsed->addr_table_lookup_cnt         = (uchar)addr_table_cnt;
-  parsed->addr_table_adtl_writable_cnt  = (uchar)addr_table_adtl_writable_cnt;
-  parsed->addr_table_adtl_cnt           = (uchar)addr_table_adtl_cnt;
-  parsed->_padding_reserved_1           = (uchar)0;
 
-  if( FD_LIKELY( counters_opt ) ) counters_opt->success_cnt++;
-  return fd_txn_footprint( instr_cnt, addr_table_cnt );
+# endif
 
-  #undef CHECK
-  #undef CHECK_LEFT
-  #undef READ_CHECKED_COMPACT_U16
+  return ok_cnt;
 }
+
+#if FD_HAS_AVX512
+#undef HDR_SIG_CNT
+#undef HDR_MSG_OFF
+#undef HDR_VERSION
+#undef HDR_RO_SIGNED
+#undef HDR_RO_UNSIGNED
+#undef HDR_ACCT_CNT
+#undef HDR_ACCT_OFF
+#undef HDR_INSTR_CNT
+#undef HDR_I
+#undef HDR_CNT
+#endif
+
+#undef MIN_INSTR_SZ
+#undef CHECK
+#undef CHECK_LEFT
+#undef READ_CHECKED_COMPACT_U16
@@ -34,5 +34,32 @@ LLVMFuzzerTestOneInput( uchar const * data,
     FD_TEST( fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt )<=FD_TXN_MAX_SZ );
   }
 
+  /* The batch parser must agree exactly with the scalar parser.  Batch
+     the input with its truncations (covering lanes that fail at every
+     possible point of the header). */
+
+# define BATCH_CNT (11UL)
+  static uchar __attribute__((aligned((alignof(fd_txn_t))))) batch_buf[ BATCH_CNT ][ FD_TXN_MAX_SZ ];
+  uchar const * payload   [ BATCH_CNT ];
+  ulong         payload_sz[ BATCH_CNT ];
+  void *        out       [ BATCH_CNT ];
+  ulong         out_sz    [ BATCH_CNT ];
+  for( ulong j=0UL; j<BATCH_CNT; j++ ) {
+    payload   [ j ] = data;
+    payload_sz[ j ] = size - fd_ulong_min( size, j );
+    out       [ j ] = batch_buf[ j ];
+  }
+
+  fd_txn_parse_counters_t batch_counters = {0};
+  fd_txn_parse_counters_t ref_counters   = {0};
+  fd_txn_parse_batch( payload, payload_sz, out, out_sz, BATCH_CNT, &batch_counters );
+  for( ulong j=0UL; j<BATCH_CNT; j++ ) {
+    ulong ref_sz = fd_txn_parse( payload[ j ], payload_sz[ j ], txn_buf, &ref_counters );
+    FD_TEST( out_sz[ j ]==ref_sz );
+    FD_TEST( !memcmp( batch_buf[ j ], txn_buf, ref_sz ) );
+  }
+  FD_TEST( !memcmp( &batch_counters, &ref_counters, sizeof(fd_txn_parse_counters_t) ) );
+# undef BATCH_CNT
+
   return 0;
 }
@@ -57,6 +57,26 @@ main( int     argc,
   for( ulong i = 0UL;          i <=  USHORT_MAX; i++ )    FD_TEST(  found[ i ] );
   for( ulong i = USHORT_MAX+1; i < TEST_U16_MAX; i++ )    FD_TEST( !found[ i ] );
 
+#if FD_HAS_AVX512
+  /* fd_cu16_dec_wwv matches fd_cu16_dec on every 3 byte pattern,
+     whatever follows it in the lane */
+
+  for( ulong i = 0UL; i < (1UL<<24); i += 8UL ) {
+    ulong lane[ 8 ];
+    for( ulong k = 0UL; k < 8UL; k++ ) lane[ k ] = (i+k) | (fd_rng_ulong( rng ) << 24);
+    wwv_t sz;
+    wwv_t val = fd_cu16_dec_wwv( wwv_ldu( lane ), &sz );
+    ulong lane_sz [ 8 ]; wwv_stu( lane_sz,  sz  );
+    ulong lane_val[ 8 ]; wwv_stu( lane_val, val );
+    for( ulong k = 0UL; k < 8UL; k++ ) {
+      ushort result   = (ushort)0;
+      ulong  consumed = fd_cu16_dec( (uchar const *)&lane[ k ], 3UL, &result );
+      FD_TEST( lane_sz[ k ]==consumed );
+      if( consumed ) FD_TEST( lane_val[ k ]==(ulong)result );
+    }
+  }
+#endif
+
   fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE(( "pass" ));
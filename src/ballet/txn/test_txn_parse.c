@@ -232,6 +232,75 @@ void test_performance( uchar const * payload,
   FD_LOG_NOTICE(( "Average time per parse: %f ns", (double)(end-start)/(double)test_count ));
 }
 
+/* test_batch checks fd_txn_parse_batch gives exactly the same results
+   (sizes, parsed txns and counters) as a sequence of fd_txn_parse calls
+   on batches of fixtures, truncated fixtures and random mutations of
+   the fixtures.  Batch sizes are chosen to exercise partial batches. */
+
+#define BATCH_MAX (19UL)
+
+uchar batch_payload[ BATCH_MAX ][ FD_TXN_MTU    ];
+uchar batch_out    [ BATCH_MAX ][ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
+
+void test_batch( uchar const * const * fixture,
+                 ulong const *         fixture_sz,
+                 ulong                 fixture_cnt,
+                 fd_rng_t *            rng ) {
+  uchar const * payload   [ BATCH_MAX ];
+  ulong         payload_sz[ BATCH_MAX ];
+  void *        out       [ BATCH_MAX ];
+  ulong         out_sz    [ BATCH_MAX ];
+
+  for( ulong iter=0UL; iter<100000UL; iter++ ) {
+    ulong cnt = fd_rng_ulong_roll( rng, BATCH_MAX+1UL );
+    for( ulong j=0UL; j<cnt; j++ ) {
+      ulong f  = fd_rng_ulong_roll( rng, fixture_cnt );
+      ulong sz = fixture_sz[ f ];
+      fd_memcpy( batch_payload[ j ], fixture[ f ], sz );
+      switch( fd_rng_uint_roll( rng, 4U ) ) {
+      case 0U: break;                                                       /* As is */
+      case 1U: sz = fd_rng_ulong_roll( rng, sz+1UL ); break;                /* Truncated */
+      case 2U: batch_payload[ j ][ fd_rng_ulong_roll( rng, fd_ulong_min( sz, 128UL ) ) ] = fd_rng_uchar( rng ); break; /* Header mutation */
+      default: batch_payload[ j ][ fd_rng_ulong_roll( rng, sz ) ] = fd_rng_uchar( rng ); break;                      /* Any mutation */
+      }
+      payload   [ j ] = batch_payload[ j ];
+      payload_sz[ j ] = sz;
+      out       [ j ] = batch_out[ j ];
+    }
+
+    fd_txn_parse_counters_t batch_counters = {0};
+    fd_txn_parse_counters_t ref_counters   = {0};
+    ulong ok_cnt = fd_txn_parse_batch( payload, payload_sz, out, out_sz, cnt, &batch_counters );
+
+    ulong ref_ok_cnt = 0UL;
+    for( ulong j=0UL; j<cnt; j++ ) {
+      ulong ref_sz = fd_txn_parse( payload[ j ], payload_sz[ j ], test_buf, &ref_counters );
+      FD_TEST( out_sz[ j ]==ref_sz );
+      FD_TEST( !memcmp( batch_out[ j ], test_buf, ref_sz ) );
+      ref_ok_cnt += (ulong)!!ref_sz;
+    }
+    FD_TEST( ok_cnt==ref_ok_cnt );
+    FD_TEST( !memcmp( &batch_counters, &ref_counters, sizeof(fd_txn_parse_counters_t) ) );
+  }
+}
+
+void test_performance_batch( uchar const * payload,
+                             ulong sz ) {
+  const ulong test_count = 1000000;
+  uchar const * p [ 16 ];
+  ulong         p_sz[ 16 ];
+  void *        o [ 16 ];
+  ulong         o_sz[ 16 ];
+  for( ulong j=0UL; j<16UL; j++ ) { p[ j ] = payload; p_sz[ j ] = sz; o[ j ] = batch_out[ j ]; }
+  long start = fd_log_wallclock( );
+  for( ulong i = 0; i < test_count; i+=16UL ) {
+    FD_TEST( fd_txn_parse_batch( p, p_sz, o, o_sz, 16UL, NULL )==16UL );
+  }
+  long end = fd_log_wallclock( );
+  FD_LOG_NOTICE(( "Average time per batch parse: %f ns (%f Mtxn/s/core)", (double)(end-start)/(double)test_count,
+                  (double)test_count*1e3/(double)(end-start) ));
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -244,10 +313,18 @@ main( int     argc,
 
   test_performance( transaction1, transaction1_sz );
   test_performance( transaction2, transaction2_sz );
+  test_performance_batch( transaction1, transaction1_sz );
+  test_performance_batch( transaction2, transaction2_sz );
 
   test_mutate( transaction1, transaction1_sz );
   test_mutate( transaction2, transaction2_sz );
 
+  uchar const * fixture   [ 6 ] = { transaction1,    transaction2,    transaction3,
+                                    transaction4,    transaction5,    transaction6    };
+  ulong         fixture_sz[ 6 ] = { transaction1_sz, transaction2_sz, transaction3_sz,
+                                    transaction4_sz, transaction5_sz, transaction6_sz };
+  test_batch( fixture, fixture_sz, 6UL, rng );
+
   fd_memset( out_buf+FD_TXN_MAX_SZ, RED_ZONE_VAL, RED_ZONE_SZ );
   fd_asan_poison( out_buf+FD_TXN_MAX_SZ, RED_ZONE_SZ );
 
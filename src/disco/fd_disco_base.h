@@ -2,13 +2,109 @@
 #define HEADER_fd_src_disco_fd_disco_base_h
 
 #include "../tango/fd_tango.h"
+#include "../ballet/txn/fd_txn.h"
 
-//FD_PROTOTYPES_BEGIN
+/* Parsed transaction frags ********************************************
 
-/* This is currently just a stub in anticipation of future common tile
-   functionality */
+   Transactions received over TPU are parsed exactly once, at the edge
+   (e.g. by the QUIC tile when a stream completes), and then flow
+   through verify and dedup to pack as "parsed transaction frags".  The
+   dcache chunk of a parsed transaction frag is laid out as:
 
-//FD_PROTOTYPES_END
+     [ payload    ] (payload_sz bytes, the serialized txn as received)
+     [ pad        ] (0 or 1 bytes, align the fd_txn_t to 2)
+     [ fd_txn_t   ] (txn_sz bytes, as returned by fd_txn_parse)
+     [ payload_sz ] (2 bytes, little endian ushort)
 
-#endif /* HEADER_fd_src_disco_fd_disco_base_h */
+   The frag sz published in the mcache covers all of the above.  As the
+   trailer is at a fixed offset from the end of the frag, consumers can
+   locate the parsed txn without re-parsing the payload.  Malformed
+   transactions are never published.
+
+   A consumer reading a frag in place (such that it could be overrun
+   by the producer at any time) should treat everything it reads as
+   untrusted until it has checked it wasn't overrun, e.g. use
+   fd_disco_txn_frag_payload_sz to validate the trailer before using
+   the other accessors. */
+
+/* FD_DISCO_TXN_FRAG_MTU is the max size of a parsed transaction frag */
+
+#define FD_DISCO_TXN_FRAG_MTU (FD_TXN_MTU + 1UL + FD_TXN_MAX_SZ + 2UL)
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_disco_txn_frag_txn_off returns the offset of the fd_txn_t in a
+   parsed transaction frag with the given payload_sz. */
+
+FD_FN_CONST static inline ulong
+fd_disco_txn_frag_txn_off( ulong payload_sz ) {
+  return fd_ulong_align_up( payload_sz, 2UL );
+}
+
+/* fd_disco_txn_frag_sz returns the size of a parsed transaction frag
+   for a payload_sz byte transaction whose fd_txn_t is txn_sz bytes. */
+
+FD_FN_CONST static inline ulong
+fd_disco_txn_frag_sz( ulong payload_sz,
+                      ulong txn_sz ) {
+  return fd_disco_txn_frag_txn_off( payload_sz ) + txn_sz + sizeof(ushort);
+}
 
+/* fd_disco_txn_frag_payload_sz returns the payload_sz of the parsed
+   transaction frag at frag with size frag_sz.  Returns 0 if frag_sz is
+   inconsistent with the trailer (i.e. frag is not a parsed transaction
+   frag).  On success, payload_sz is in [1,FD_TXN_MTU] and the fd_txn_t
+   size (see fd_disco_txn_frag_txn_sz) is in
+   [sizeof(fd_txn_t),FD_TXN_MAX_SZ]. */
+
+FD_FN_PURE static inline ulong
+fd_disco_txn_frag_payload_sz( uchar const * frag,
+                              ulong         frag_sz ) {
+  if( FD_UNLIKELY( (frag_sz<sizeof(ushort)) | (frag_sz>FD_DISCO_TXN_FRAG_MTU) ) ) return 0UL;
+  ulong payload_sz = (ulong)FD_LOAD( ushort, frag + frag_sz - sizeof(ushort) );
+  ulong txn_off    = fd_disco_txn_frag_txn_off( payload_sz );
+  if( FD_UNLIKELY( (!payload_sz) | (payload_sz>FD_TXN_MTU) ) ) return 0UL;
+  if( FD_UNLIKELY( txn_off+sizeof(fd_txn_t)+sizeof(ushort)>frag_sz ) ) return 0UL;
+  if( FD_UNLIKELY( frag_sz-sizeof(ushort)-txn_off>FD_TXN_MAX_SZ    ) ) return 0UL;
+  return payload_sz;
+}
+
+/* fd_disco_txn_frag_txn returns a pointer to the fd_txn_t of the parsed
+   transaction frag at frag with the given payload_sz.
+   fd_disco_txn_frag_txn_sz returns its size given the frag size. */
+
+FD_FN_CONST static inline fd_txn_t const *
+fd_disco_txn_frag_txn( uchar const * frag,
+                       ulong         payload_sz ) {
+  return (fd_txn_t const *)(frag + fd_disco_txn_frag_txn_off( payload_sz ));
+}
+
+FD_FN_CONST static inline ulong
+fd_disco_txn_frag_txn_sz( ulong frag_sz,
+                          ulong payload_sz ) {
+  return frag_sz - sizeof(ushort) - fd_disco_txn_frag_txn_off( payload_sz );
+}
+
+/* fd_disco_txn_frag_parse turns the payload_sz byte serialized
+   transaction at frag into a parsed transaction frag in place.  frag
+   must have room for at least FD_DISCO_TXN_FRAG_MTU bytes.  Returns
+   the size of the resulting frag on success and 0 if the transaction
+   is malformed (in which case frag should not be published).  If
+   counters_opt is non-NULL, parse counters are accumulated into it
+   (see fd_txn_parse). */
+
+static inline ulong
+fd_disco_txn_frag_parse( uchar *                   frag,
+                         ulong                     payload_sz,
+                         fd_txn_parse_counters_t * counters_opt ) {
+  if( FD_UNLIKELY( (!payload_sz) | (payload_sz>FD_TXN_MTU) ) ) return 0UL;
+  ulong txn_off = fd_disco_txn_frag_txn_off( payload_sz );
+  ulong txn_sz  = fd_txn_parse( frag, payload_sz, frag + txn_off, counters_opt );
+  if( FD_UNLIKELY( !txn_sz ) ) return 0UL;
+  FD_STORE( ushort, frag + txn_off + txn_sz, (ushort)payload_sz );
+  return fd_disco_txn_frag_sz( payload_sz, txn_sz );
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_disco_fd_disco_base_h */
@@ -22,6 +22,11 @@
    forms a complete txn.  This requires the dcache mtu to be at least
    that of the largest allowed serialized txn size.
 
+   Each txn is parsed once, when its stream completes.  Malformed txns
+   are dropped right there, and the others are published as parsed
+   transaction frags (see fd_disco_base.h) such that downstream tiles
+   don't need to parse them again.
+
    To facilitate defragmentation, the fd_quic tile stores non-standard
    stream information in the dcache's application region.  (An array of
    fd_quic_tpu_msg_ctx_t)
@@ -46,8 +51,9 @@
 /* FD_TPU_MTU is the max serialized byte size of a txn sent over TPU. */
 #define FD_TPU_MTU (1232UL)
 
-/* FD_TPU_DCACHE_MTU is the max size of a dcache entry */
-#define FD_TPU_DCACHE_MTU (FD_TPU_MTU + FD_TXN_MAX_SZ + 2UL)
+/* FD_TPU_DCACHE_MTU is the max size of a dcache entry.  Each entry
+   holds a parsed transaction frag (see fd_disco_base.h). */
+#define FD_TPU_DCACHE_MTU FD_DISCO_TXN_FRAG_MTU
 
 /* An fd_quic_tile will use the cnc application region to accumulate
    the following tile specific counters:
@@ -57,18 +63,20 @@
      TPU_PUB_SZ         is the number of txn bytes ingested by the QUIC server
      TPU_CONN_LIVE_CNT  is the number of currently open QUIC conns
      TPU_CONN_SEQ       is the sequence number of the last QUIC conn opened
+     TPU_PARSE_FAIL_CNT is the number of malformed txns dropped by the QUIC server
 
-   As such, the cnc app region must be at least 64B in size.
+   As such, the cnc app region must be at least 128B in size.
 
    Except for IN_BACKP, none of the diagnostics are cleared at
    tile startup (as such that they can be accumulated over multiple
    runs).  Clearing is up to monitoring scripts. */
 
-#define FD_QUIC_CNC_DIAG_CHUNK_IDX         ( 6UL) /* On 1st cache line of app region, updated by producer, frequently */
-#define FD_QUIC_CNC_DIAG_TPU_PUB_CNT       ( 7UL) /* ", frequently */
-#define FD_QUIC_CNC_DIAG_TPU_PUB_SZ        ( 8UL) /* ", frequently */
-#define FD_QUIC_CNC_DIAG_TPU_CONN_LIVE_CNT ( 9UL) /* ", frequently */
-#define FD_QUIC_CNC_DIAG_TPU_CONN_SEQ      (10UL) /* ", frequently */
+#define FD_QUIC_CNC_DIAG_CHUNK_IDX          ( 6UL) /* On 1st cache line of app region, updated by producer, frequently */
+#define FD_QUIC_CNC_DIAG_TPU_PUB_CNT        ( 7UL) /* ", frequently */
+#define FD_QUIC_CNC_DIAG_TPU_PUB_SZ         ( 8UL) /* ", frequently */
+#define FD_QUIC_CNC_DIAG_TPU_CONN_LIVE_CNT  ( 9UL) /* ", frequently */
+#define FD_QUIC_CNC_DIAG_TPU_CONN_SEQ       (10UL) /* ", frequently */
+#define FD_QUIC_CNC_DIAG_TPU_PARSE_FAIL_CNT (11UL) /* ", frequently */
 
 /* fd_quic_tpu_msg_ctx_t is the message context of a txn being received
    by the QUIC tile over the TPU protocol. It is used to detect dcache
@@ -63,10 +63,15 @@ struct fd_quic_tpu_ctx {
 
   fd_quic_tpu_msg_ctx_t ** pubq;
 
+  /* txn parser */
+
+  fd_txn_parse_counters_t txn_parse_counters;
+
   /* meta */
 
   ulong   cnc_diag_tpu_conn_live_cnt;
   ulong   cnc_diag_tpu_conn_seq;
+  ulong   cnc_diag_tpu_parse_fail_cnt;
 };
 typedef struct fd_quic_tpu_ctx fd_quic_tpu_ctx_t;
 
@@ -235,6 +240,20 @@ fd_tpu_stream_notify( fd_quic_stream_t * stream,
   if( FD_UNLIKELY( msg_ctx->conn_id != conn_id || msg_ctx->stream_id != stream_id ) )
     return;  /* overrun */
 
+  /* Parse the txn in place, turning the dcache entry into a parsed
+     transaction frag (see fd_disco_base.h).  Malformed txns are
+     dropped here such that they never reach downstream tiles.  On
+     success, msg_ctx->sz becomes the size of the frag. */
+
+  ulong frag_sz = fd_disco_txn_frag_parse( msg_ctx->data, (ulong)msg_ctx->sz, &ctx->txn_parse_counters );
+  if( FD_UNLIKELY( !frag_sz ) ) {
+    FD_LOG_DEBUG(( "fd_txn_parse(sz=%u) failed", msg_ctx->sz ));
+    ctx->cnc_diag_tpu_parse_fail_cnt++;
+    ctx->inflight_streams -= 1;
+    return;  /* invalid txn (terminate conn?) */
+  }
+  msg_ctx->sz = (uint)frag_sz;
+
   /* Mark message as completed */
 
   msg_ctx->stream_id = ULONG_MAX;
@@ -293,9 +312,6 @@ fd_quic_tile( fd_cnc_t *         cnc,
 
   ulong mtu = FD_TPU_DCACHE_MTU;
 
-  /* txn parser */
-  fd_txn_parse_counters_t txn_parse_counters = {0};
-
   do {
 
     FD_LOG_INFO(( "Booting quic" ));
@@ -315,7 +331,7 @@ fd_quic_tile( fd_cnc_t *         cnc,
     /* cnc state init */
 
     if( FD_UNLIKELY( !cnc ) ) { FD_LOG_WARNING(( "NULL cnc" )); return 1; }
-    if( FD_UNLIKELY( fd_cnc_app_sz( cnc )<64UL ) ) { FD_LOG_WARNING(( "cnc app sz must be at least 64" )); return 1; }
+    if( FD_UNLIKELY( fd_cnc_app_sz( cnc )<128UL ) ) { FD_LOG_WARNING(( "cnc app sz must be at least 128" )); return 1; }
     if( FD_UNLIKELY( fd_cnc_signal_query( cnc )!=FD_CNC_SIGNAL_BOOT ) ) { FD_LOG_WARNING(( "already booted" )); return 1; }
 
     cnc_diag = (ulong *)fd_cnc_app_laddr( cnc );
@@ -426,14 +442,16 @@ fd_quic_tile( fd_cnc_t *         cnc,
 
       fd_cnc_heartbeat( cnc, now );
       FD_COMPILER_MFENCE();
-      cnc_diag[ FD_QUIC_CNC_DIAG_CHUNK_IDX         ]  = chunk;
-      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_PUB_CNT       ] += cnc_diag_tpu_pub_cnt;
-      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_PUB_SZ        ] += cnc_diag_tpu_pub_sz;
-      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_CONN_LIVE_CNT ]  = quic_ctx.cnc_diag_tpu_conn_live_cnt;
-      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_CONN_SEQ      ]  = quic_ctx.cnc_diag_tpu_conn_seq;
+      cnc_diag[ FD_QUIC_CNC_DIAG_CHUNK_IDX          ]  = chunk;
+      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_PUB_CNT        ] += cnc_diag_tpu_pub_cnt;
+      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_PUB_SZ         ] += cnc_diag_tpu_pub_sz;
+      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_CONN_LIVE_CNT  ]  = quic_ctx.cnc_diag_tpu_conn_live_cnt;
+      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_CONN_SEQ       ]  = quic_ctx.cnc_diag_tpu_conn_seq;
+      cnc_diag[ FD_QUIC_CNC_DIAG_TPU_PARSE_FAIL_CNT ] += quic_ctx.cnc_diag_tpu_parse_fail_cnt;
       FD_COMPILER_MFENCE();
       cnc_diag_tpu_pub_cnt = 0UL;
       cnc_diag_tpu_pub_sz  = 0UL;
+      quic_ctx.cnc_diag_tpu_parse_fail_cnt = 0UL;
 
       /* Receive command-and-control signals */
       ulong s = fd_cnc_signal_query( cnc );
@@ -464,51 +482,11 @@ fd_quic_tile( fd_cnc_t *         cnc,
       if( FD_UNLIKELY( msg->stream_id != ULONG_MAX ) )
         continue;  /* overrun */
 
-      /* Get byte slice backing serialized txn data */
-
-      uchar * txn    = msg->data;
-      ulong   txn_sz = msg->sz;
-
-      FD_TEST( txn_sz<=1232UL );
-
-      /* At this point dcache only contains raw payload of txn.
-         Beyond end of txn, but within bounds of msg layout, add a trailer
-         describing the txn layout.
-
-         [ payload      ] (txn_sz bytes)
-         [ pad-align 2B ] (? bytes)
-         [ fd_txn_t     ] (? bytes)
-         [ payload_sz   ] (2B) */
-
-      /* Ensure sufficient space to store trailer */
-
-      void * txn_t = (void *)( fd_ulong_align_up( (ulong)msg->data + txn_sz, 2UL ) );
-      if( FD_UNLIKELY( (mtu - ((ulong)txn_t - (ulong)msg->data)) < (FD_TXN_MAX_SZ+2UL) ) ) {
-        FD_LOG_WARNING(( "dcache entry too small" ));
-        continue;
-      }
-
-      /* Parse transaction */
-
-      ulong txn_t_sz = fd_txn_parse( txn, txn_sz, txn_t, &txn_parse_counters );
-      if( txn_t_sz==0 ) {
-        FD_LOG_DEBUG(( "fd_txn_parse(sz=%lu) failed", txn_sz ));
-        continue; /* invalid txn (terminate conn?) */
-      }
-
-      /* Write payload_sz */
-
-      ushort * payload_sz = (ushort *)( (ulong)txn_t + txn_t_sz );
-      *payload_sz = (ushort)txn_sz;
-
-      /* End of message */
-
-      void * msg_end = (void *)( (ulong)payload_sz + 2UL );
-
-      /* Create mcache entry */
+      /* Create mcache entry.  The dcache entry already holds a parsed
+         transaction frag (see fd_tpu_stream_notify). */
 
       ulong chunk  = fd_laddr_to_chunk( base, msg->data );
-      ulong sz     = (ulong)msg_end - (ulong)msg->data;
+      ulong sz     = (ulong)msg->sz;
       ulong sig    = 0; /* A non-dummy entry representing a finished transaction */
       ulong ctl    = fd_frag_meta_ctl( tx_idx, 1 /* som */, 1 /* eom */, 0 /* err */ );
       ulong tsorig = msg->tsorig;
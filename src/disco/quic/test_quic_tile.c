@@ -267,9 +267,9 @@ int main( int     argc,
   cfg->wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
   FD_TEST( cfg->wksp );
 
-  FD_LOG_NOTICE(( "Creating tx cnc (app_sz 64, type 0, heartbeat0 %li)", hb0 ));
-  cfg->tx_cnc = fd_cnc_join( fd_cnc_new( fd_wksp_alloc_laddr( cfg->wksp, fd_cnc_align(), fd_cnc_footprint( 64UL ), 1UL ),
-                             64UL, 0UL, hb0 ) );
+  FD_LOG_NOTICE(( "Creating tx cnc (app_sz 128, type 0, heartbeat0 %li)", hb0 ));
+  cfg->tx_cnc = fd_cnc_join( fd_cnc_new( fd_wksp_alloc_laddr( cfg->wksp, fd_cnc_align(), fd_cnc_footprint( 128UL ), 1UL ),
+                             128UL, 0UL, hb0 ) );
   FD_TEST( cfg->tx_cnc );
 
   FD_LOG_NOTICE(( "Creating tx mcache (--tx-depth %lu, app_sz 0, seq0 %lu)", tx_depth, seq0 ));
@@ -291,9 +291,9 @@ int main( int     argc,
   cfg->tx_lazy   = tx_lazy;
   cfg->tx_seed   = rng_seq++;
 
-  FD_LOG_NOTICE(( "Creating rx cnc (app_sz 64, type 1, heartbeat0 %li)", hb0 ));
-  cfg->rx_cnc = fd_cnc_join( fd_cnc_new( fd_wksp_alloc_laddr( cfg->wksp, fd_cnc_align(), fd_cnc_footprint( 64UL ), 1UL ),
-                                         64UL, 1UL, hb0 ) );
+  FD_LOG_NOTICE(( "Creating rx cnc (app_sz 128, type 1, heartbeat0 %li)", hb0 ));
+  cfg->rx_cnc = fd_cnc_join( fd_cnc_new( fd_wksp_alloc_laddr( cfg->wksp, fd_cnc_align(), fd_cnc_footprint( 128UL ), 1UL ),
+                                         128UL, 1UL, hb0 ) );
   FD_TEST( cfg->rx_cnc );
 
   FD_LOG_NOTICE(( "Creating rx fseq (seq0 %lu)", seq0 ));
@@ -1,5 +1,48 @@
 #include "fd_disco.h"
 
+FD_IMPORT_BINARY( transaction1, "src/ballet/txn/fixtures/transaction1.bin" );
+FD_IMPORT_BINARY( transaction2, "src/ballet/txn/fixtures/transaction2.bin" );
+FD_IMPORT_BINARY( transaction3, "src/ballet/txn/fixtures/transaction3.bin" );
+FD_IMPORT_BINARY( transaction4, "src/ballet/txn/fixtures/transaction4.bin" );
+FD_IMPORT_BINARY( transaction5, "src/ballet/txn/fixtures/transaction5.bin" ); /* Not a valid txn */
+FD_IMPORT_BINARY( transaction6, "src/ballet/txn/fixtures/transaction6.bin" );
+
+static uchar frag[ FD_DISCO_TXN_FRAG_MTU ] __attribute__((aligned(64)));
+static uchar ref [ FD_TXN_MAX_SZ         ] __attribute__((aligned(64)));
+
+static void
+test_txn_frag( uchar const * payload,
+               ulong         payload_sz ) {
+  ulong ref_sz = fd_txn_parse( payload, payload_sz, ref, NULL );
+
+  memset( frag, 0xCC, FD_DISCO_TXN_FRAG_MTU );
+  memcpy( frag, payload, payload_sz );
+  ulong frag_sz = fd_disco_txn_frag_parse( frag, payload_sz, NULL );
+
+  if( !ref_sz ) { FD_TEST( !frag_sz ); return; }
+
+  FD_TEST( frag_sz==fd_disco_txn_frag_sz( payload_sz, ref_sz ) );
+  FD_TEST( frag_sz<=FD_DISCO_TXN_FRAG_MTU );
+  FD_TEST( !memcmp( frag, payload, payload_sz ) );
+  FD_TEST( fd_disco_txn_frag_payload_sz( frag, frag_sz )==payload_sz );
+
+  fd_txn_t const * txn = fd_disco_txn_frag_txn( frag, payload_sz );
+  FD_TEST( fd_ulong_is_aligned( (ulong)txn, 2UL ) );
+  FD_TEST( fd_disco_txn_frag_txn_sz( frag_sz, payload_sz )==ref_sz );
+  FD_TEST( fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt )==ref_sz );
+  FD_TEST( !memcmp( txn, ref, ref_sz ) );
+
+  /* Inconsistent frag sizes are rejected (or at least described
+     consistently) */
+  for( ulong sz=0UL; sz<frag_sz; sz++ ) {
+    ulong _payload_sz = fd_disco_txn_frag_payload_sz( frag, sz );
+    if( !_payload_sz ) continue;
+    ulong txn_sz = fd_disco_txn_frag_txn_sz( sz, _payload_sz );
+    FD_TEST( (txn_sz>=sizeof(fd_txn_t)) & (txn_sz<=FD_TXN_MAX_SZ) );
+    FD_TEST( fd_disco_txn_frag_txn_off( _payload_sz ) + txn_sz + sizeof(ushort)==sz );
+  }
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -7,7 +50,93 @@ main( int     argc,
 
   fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
 
-  /* This is currently just a stub in anticipation of future tests */
+  ulong bench_cnt = 1000000UL;
+
+  uchar const * txn_payload[6] = { transaction1,    transaction2,    transaction3,
+                                   transaction4,    transaction5,    transaction6    };
+  ulong         txn_sz     [6] = { transaction1_sz, transaction2_sz, transaction3_sz,
+                                   transaction4_sz, transaction5_sz, transaction6_sz };
+
+  FD_TEST( fd_disco_txn_frag_txn_off( 0UL )==0UL );
+  FD_TEST( fd_disco_txn_frag_txn_off( 1UL )==2UL );
+  FD_TEST( fd_disco_txn_frag_txn_off( 2UL )==2UL );
+  FD_TEST( fd_disco_txn_frag_sz( FD_TXN_MTU-1UL, FD_TXN_MAX_SZ )<=FD_DISCO_TXN_FRAG_MTU );
+
+  FD_TEST( !fd_disco_txn_frag_parse( frag, 0UL,            NULL ) );
+  FD_TEST( !fd_disco_txn_frag_parse( frag, FD_TXN_MTU+1UL, NULL ) );
+  FD_TEST( !fd_disco_txn_frag_payload_sz( frag, 0UL                       ) );
+  FD_TEST( !fd_disco_txn_frag_payload_sz( frag, 1UL                       ) );
+  FD_TEST( !fd_disco_txn_frag_payload_sz( frag, FD_DISCO_TXN_FRAG_MTU+1UL ) );
+
+  /* Valid txns round trip, the invalid one is rejected, as are all
+     truncations of all of them */
+
+  for( ulong i=0UL; i<6UL; i++ ) {
+    test_txn_frag( txn_payload[i], txn_sz[i] );
+    for( ulong sz=1UL; sz<txn_sz[i]; sz++ ) test_txn_frag( txn_payload[i], sz );
+  }
+  FD_TEST( !fd_txn_parse( transaction5, transaction5_sz, ref, NULL ) );
+
+  /* Random garbage (single byte corruptions of valid txns and random
+     bytes) is either rejected or round trips */
+
+  uchar buf[ FD_TXN_MTU ];
+  for( ulong iter=0UL; iter<100000UL; iter++ ) {
+    ulong i  = fd_rng_ulong_roll( rng, 6UL );
+    ulong sz = txn_sz[i];
+    memcpy( buf, txn_payload[i], sz );
+    buf[ fd_rng_ulong_roll( rng, sz ) ] = fd_rng_uchar( rng );
+    test_txn_frag( buf, sz );
+
+    sz = 1UL + fd_rng_ulong_roll( rng, FD_TXN_MTU );
+    for( ulong j=0UL; j<sz; j++ ) buf[j] = fd_rng_uchar( rng );
+    test_txn_frag( buf, sz );
+  }
+
+  /* Benchmark building parsed txn frags at the edge for well formed
+     txns and rejecting malformed spam */
+
+  do {
+    long dt = -fd_log_wallclock();
+    ulong ok_cnt = 0UL;
+    for( ulong iter=0UL; iter<bench_cnt; iter++ ) {
+      memcpy( frag, transaction2, transaction2_sz );
+      ok_cnt += (ulong)!!fd_disco_txn_frag_parse( frag, transaction2_sz, NULL );
+    }
+    dt += fd_log_wallclock();
+    FD_TEST( ok_cnt==bench_cnt );
+    FD_LOG_NOTICE(( "well formed:     %.3f Mtxn/s (%.3f ns/txn)", (double)bench_cnt*1e3/(double)dt, (double)dt/(double)bench_cnt ));
+  } while(0);
+
+  do {
+    /* Spam a flood of random bytes (typically rejected on the first
+       few bytes) */
+    for( ulong j=0UL; j<FD_TXN_MTU; j++ ) buf[j] = fd_rng_uchar( rng );
+    long dt = -fd_log_wallclock();
+    ulong ok_cnt = 0UL;
+    for( ulong iter=0UL; iter<bench_cnt; iter++ ) {
+      ulong sz = FD_TXN_MTU - (iter & 255UL);
+      memcpy( frag, buf, sz );
+      frag[ iter & 63UL ] = (uchar)iter;
+      ok_cnt += (ulong)!!fd_disco_txn_frag_parse( frag, sz, NULL );
+    }
+    dt += fd_log_wallclock();
+    FD_LOG_NOTICE(( "random spam:     %.3f Mtxn/s (%.3f ns/txn, %lu accepted)", (double)bench_cnt*1e3/(double)dt, (double)dt/(double)bench_cnt, ok_cnt ));
+  } while(0);
+
+  do {
+    /* Spam truncated copies of a valid txn (rejected only at the end
+       of the parse, worst case for the parser) */
+    long dt = -fd_log_wallclock();
+    ulong ok_cnt = 0UL;
+    for( ulong iter=0UL; iter<bench_cnt; iter++ ) {
+      memcpy( frag, transaction2, transaction2_sz );
+      ok_cnt += (ulong)!!fd_disco_txn_frag_parse( frag, transaction2_sz-1UL, NULL );
+    }
+    dt += fd_log_wallclock();
+    FD_TEST( !ok_cnt );
+    FD_LOG_NOTICE(( "truncated spam:  %.3f Mtxn/s (%.3f ns/txn)", (double)bench_cnt*1e3/(double)dt, (double)dt/(double)bench_cnt ));
+  } while(0);
 
   fd_rng_delete( fd_rng_leave( rng ) );
 
@@ -15,4 +144,3 @@ main( int     argc,
   fd_halt();
   return 0;
 }
-
@@ -1,4 +1,7 @@
 ifdef FD_HAS_INT128
 $(call add-hdrs,fd_bincode.h fd_types.h fd_types_custom.h)
 $(call add-objs,fd_types,fd_flamenco)
+$(call make-unit-test,test_types_footprint,test_types_footprint,fd_flamenco fd_ballet fd_util)
+$(call run-unit-test,test_types_footprint)
+$(call make-unit-test,bench_types_decode,bench_types_decode,fd_flamenco fd_ballet fd_util)
 endif
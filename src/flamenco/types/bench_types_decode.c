@@ -0,0 +1,186 @@
+#include "fd_types.h"
+#include <stdlib.h>
+
+/* Compares decoding a snapshot manifest with one allocator call per
+   vector, map, option and string to decoding it into a single arena
+   sized by fd_solana_manifest_decode_footprint. */
+
+static ulong malloc_cnt;
+
+static char *
+bench_malloc( void * arg,
+              ulong  align,
+              ulong  len ) {
+  (void)arg;
+  malloc_cnt++;
+  return aligned_alloc( align, fd_ulong_align_up( fd_ulong_max( len, 1UL ), align ) );
+}
+
+static void
+bench_free( void * arg,
+            void * ptr ) {
+  (void)arg;
+  free( ptr );
+}
+
+/* Builds a manifest with the shape of a mainnet one: storages for
+   slot_cnt slots and vote_cnt vote accounts */
+
+static void
+manifest_init( fd_solana_manifest_t * m,
+               ulong                  slot_cnt,
+               ulong                  vote_cnt,
+               ulong                  vote_data_sz,
+               fd_rng_t *             rng ) {
+  fd_memset( m, 0, sizeof(fd_solana_manifest_t) );
+  fd_solana_manifest_new( m );
+
+  fd_deserializable_versioned_bank_t * bank = &m->bank;
+
+  bank->ancestors_len = 512UL;
+  bank->ancestors     = (fd_slot_pair_t *)bench_malloc( NULL, FD_SLOT_PAIR_ALIGN, bank->ancestors_len*FD_SLOT_PAIR_FOOTPRINT );
+  for( ulong i=0UL; i<bank->ancestors_len; i++ ) {
+    bank->ancestors[i].slot = slot_cnt-i;
+    bank->ancestors[i].val  = fd_rng_ulong( rng );
+  }
+
+  fd_vote_accounts_t * va = &bank->stakes.vote_accounts;
+  va->vote_accounts_len = vote_cnt;
+  va->vote_accounts     = (fd_vote_accounts_pair_t *)bench_malloc( NULL, FD_VOTE_ACCOUNTS_PAIR_ALIGN, vote_cnt*FD_VOTE_ACCOUNTS_PAIR_FOOTPRINT );
+  for( ulong i=0UL; i<vote_cnt; i++ ) {
+    fd_vote_accounts_pair_t * p = va->vote_accounts + i;
+    fd_memset( p, 0, sizeof(fd_vote_accounts_pair_t) );
+    for( ulong j=0UL; j<4UL; j++ ) p->key.ul[j] = fd_rng_ulong( rng );
+    p->stake          = fd_rng_ulong( rng );
+    p->value.lamports = fd_rng_ulong( rng );
+    p->value.data_len = vote_data_sz;
+    p->value.data     = (uchar *)bench_malloc( NULL, 8UL, vote_data_sz );
+    for( ulong j=0UL; j<vote_data_sz; j++ ) p->value.data[j] = fd_rng_uchar( rng );
+  }
+
+  fd_solana_accounts_db_fields_t * adb = &m->accounts_db;
+  adb->storages_pool = fd_slot_account_pair_t_map_alloc( bench_malloc, NULL, slot_cnt );
+  adb->storages_root = NULL;
+  for( ulong i=0UL; i<slot_cnt; i++ ) {
+    fd_slot_account_pair_t_mapnode_t * node = fd_slot_account_pair_t_map_acquire( adb->storages_pool );
+    node->elem.slot          = i;
+    node->elem.accounts_pool = fd_serializable_account_storage_entry_t_map_alloc( bench_malloc, NULL, 1UL );
+    node->elem.accounts_root = NULL;
+    fd_serializable_account_storage_entry_t_mapnode_t * acc = fd_serializable_account_storage_entry_t_map_acquire( node->elem.accounts_pool );
+    acc->elem.id                   = i;
+    acc->elem.accounts_current_len = fd_rng_ulong_roll( rng, 100000UL );
+    fd_serializable_account_storage_entry_t_map_insert( node->elem.accounts_pool, &node->elem.accounts_root, acc );
+    fd_slot_account_pair_t_map_insert( adb->storages_pool, &adb->storages_root, node );
+  }
+}
+
+static void
+manifest_check( fd_solana_manifest_t const * a,
+                fd_solana_manifest_t const * b ) {
+  FD_TEST( a->bank.ancestors_len==b->bank.ancestors_len );
+  FD_TEST( !memcmp( a->bank.ancestors, b->bank.ancestors, a->bank.ancestors_len*sizeof(fd_slot_pair_t) ) );
+  fd_vote_accounts_t const * va = &a->bank.stakes.vote_accounts;
+  fd_vote_accounts_t const * vb = &b->bank.stakes.vote_accounts;
+  FD_TEST( va->vote_accounts_len==vb->vote_accounts_len );
+  for( ulong i=0UL; i<va->vote_accounts_len; i++ ) {
+    FD_TEST( va->vote_accounts[i].value.data_len==vb->vote_accounts[i].value.data_len );
+    FD_TEST( !memcmp( va->vote_accounts[i].value.data, vb->vote_accounts[i].value.data, va->vote_accounts[i].value.data_len ) );
+  }
+  FD_TEST( fd_slot_account_pair_t_map_size( a->accounts_db.storages_pool, a->accounts_db.storages_root )==
+           fd_slot_account_pair_t_map_size( b->accounts_db.storages_pool, b->accounts_db.storages_root ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong slot_cnt     = fd_env_strip_cmdline_ulong( &argc, &argv, "--slot-cnt",     NULL, 400000UL );
+  ulong vote_cnt     = fd_env_strip_cmdline_ulong( &argc, &argv, "--vote-cnt",     NULL,   3000UL );
+  ulong vote_data_sz = fd_env_strip_cmdline_ulong( &argc, &argv, "--vote-data-sz", NULL,   3762UL );
+  ulong iter_cnt     = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt",     NULL,     10UL );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  fd_bincode_destroy_ctx_t destroy = { .freef = bench_free, .freef_arg = NULL };
+
+  /* Encode a synthetic manifest */
+
+  static fd_solana_manifest_t ref[1];
+  manifest_init( ref, slot_cnt, vote_cnt, vote_data_sz, rng );
+
+  ulong   buf_max = 2UL*fd_solana_manifest_size( ref ) + 4096UL; /* size is not exact for all types */
+  uchar * buf     = (uchar *)malloc( buf_max );
+  FD_TEST( buf );
+  fd_bincode_encode_ctx_t ectx = { .data = buf, .dataend = buf+buf_max };
+  FD_TEST( fd_solana_manifest_encode( ref, &ectx )==FD_BINCODE_SUCCESS );
+  ulong buf_sz = (ulong)ectx.data - (ulong)buf;
+  FD_LOG_NOTICE(( "manifest: %lu slots, %lu vote accounts, %lu bytes encoded", slot_cnt, vote_cnt, buf_sz ));
+
+  /* The footprint pass rejects truncated input */
+
+  ulong total_sz = 0UL;
+  fd_bincode_decode_ctx_t ctx = { .data = buf, .dataend = buf+buf_sz-1UL };
+  FD_TEST( fd_solana_manifest_decode_footprint( &ctx, &total_sz )==FD_BINCODE_ERR_UNDERFLOW );
+
+  /* Decoding with one allocation per collection */
+
+  static fd_solana_manifest_t m[1];
+  malloc_cnt = 0UL;
+  long dt_malloc = 0L;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    malloc_cnt = 0UL;
+    dt_malloc -= fd_log_wallclock();
+    ctx = (fd_bincode_decode_ctx_t){ .data = buf, .dataend = buf+buf_sz, .allocf = bench_malloc, .allocf_arg = NULL };
+    fd_solana_manifest_new( m );
+    FD_TEST( fd_solana_manifest_decode( m, &ctx )==FD_BINCODE_SUCCESS );
+    fd_solana_manifest_destroy( m, &destroy );
+    dt_malloc += fd_log_wallclock();
+  }
+  ulong alloc_cnt = malloc_cnt;
+
+  /* Footprint pass and decoding into one arena.  The arena is reused
+     across iterations like a long lived decoder would. */
+
+  ulong  arena_max = 0UL;
+  void * mem       = NULL;
+  long dt_arena = 0L;
+  long dt_fp    = 0L;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    dt_arena -= fd_log_wallclock();
+    dt_fp    -= fd_log_wallclock();
+    total_sz = 0UL;
+    ctx = (fd_bincode_decode_ctx_t){ .data = buf, .dataend = buf+buf_sz };
+    FD_TEST( fd_solana_manifest_decode_footprint( &ctx, &total_sz )==FD_BINCODE_SUCCESS );
+    FD_TEST( ctx.data==buf+buf_sz );
+    dt_fp    += fd_log_wallclock();
+
+    if( FD_UNLIKELY( total_sz>arena_max ) ) {
+      free( mem );
+      arena_max = fd_ulong_align_up( total_sz, FD_BINCODE_ARENA_ALIGN );
+      mem       = aligned_alloc( FD_BINCODE_ARENA_ALIGN, arena_max );
+      FD_TEST( mem );
+    }
+    fd_bincode_arena_t arena[1];
+    fd_bincode_arena_init( arena, mem, total_sz );
+    ctx = (fd_bincode_decode_ctx_t){ .data = buf, .dataend = buf+buf_sz, .allocf = fd_bincode_arena_alloc, .allocf_arg = arena };
+    fd_solana_manifest_new( m );
+    FD_TEST( fd_solana_manifest_decode( m, &ctx )==FD_BINCODE_SUCCESS );
+    FD_TEST( arena->off==total_sz ); /* The footprint is exact */
+    dt_arena += fd_log_wallclock();
+    if( iter==0UL ) manifest_check( ref, m );
+  }
+  free( mem );
+
+  FD_LOG_NOTICE(( "per allocation: %.3f ms/decode (%lu allocations)", 1e-6*(double)dt_malloc/(double)iter_cnt, alloc_cnt ));
+  FD_LOG_NOTICE(( "single arena:   %.3f ms/decode (footprint pass %.3f ms, arena %lu bytes)",
+                  1e-6*(double)dt_arena/(double)iter_cnt, 1e-6*(double)dt_fp/(double)iter_cnt, total_sz ));
+
+  fd_solana_manifest_destroy( ref, &destroy );
+  free( buf );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -361,5 +361,105 @@ fd_bincode_varint_encode( ulong                     val,
   }
 }
 
+/* Single arena decoding
+
+   The generated fd_{type}_decode_footprint functions validate an
+   encoded value without decoding it and compute the exact number of
+   bytes fd_{type}_decode will request from its allocator for it.  This
+   allows decoding large values (e.g. a snapshot manifest) into one
+   arena allocated upfront, instead of with one allocator call per
+   vector, map, option and string:
+
+     fd_bincode_decode_ctx_t ctx = { .data = buf, .dataend = buf+sz };
+     ulong total_sz = 0UL;
+     if( fd_solana_manifest_decode_footprint( &ctx, &total_sz ) ) ... invalid ...
+
+     fd_bincode_arena_t arena[1];
+     fd_bincode_arena_init( arena, aligned_alloc( FD_BINCODE_ARENA_ALIGN, total_sz ), total_sz );
+     ctx = (fd_bincode_decode_ctx_t){ .data = buf, .dataend = buf+sz,
+                                      .allocf = fd_bincode_arena_alloc, .allocf_arg = arena };
+     fd_solana_manifest_decode( manifest, &ctx ); ... cannot fail ...
+
+   The decoded value is released by freeing the arena as a whole (or
+   with fd_bincode_arena_free as freef of the destroy ctx, which does
+   nothing). */
+
+#define FD_BINCODE_ARENA_ALIGN (128UL) /* Largest alignment requested by any decoder */
+
+struct fd_bincode_arena {
+  uchar * mem; /* Base of the arena, aligned FD_BINCODE_ARENA_ALIGN */
+  ulong   sz;  /* Size of the arena */
+  ulong   off; /* Bytes used so far */
+};
+typedef struct fd_bincode_arena fd_bincode_arena_t;
+
+static inline fd_bincode_arena_t *
+fd_bincode_arena_init( fd_bincode_arena_t * arena,
+                       void *               mem,
+                       ulong                sz ) {
+  arena->mem = (uchar *)mem;
+  arena->sz  = sz;
+  arena->off = 0UL;
+  return arena;
+}
+
+/* fd_bincode_arena_alloc is an fd_alloc_fun_t that bump allocates
+   from the fd_bincode_arena_t pointed to by arg.  The arena is sized by
+   the decode_footprint pass, so running out of it is a bug. */
+
+static inline char *
+fd_bincode_arena_alloc( void * arg,
+                        ulong  align,
+                        ulong  len ) {
+  fd_bincode_arena_t * arena = (fd_bincode_arena_t *)arg;
+  ulong off = fd_ulong_align_up( arena->off, align );
+  if( FD_UNLIKELY( (align>FD_BINCODE_ARENA_ALIGN) | (off>arena->sz) | (len>arena->sz-off) ) )
+    FD_LOG_CRIT(( "arena exhausted (align %lu, len %lu, off %lu, sz %lu)", align, len, arena->off, arena->sz ));
+  arena->off = off + len;
+  return (char *)( arena->mem + off );
+}
+
+static inline void
+fd_bincode_arena_free( FD_FN_UNUSED void * arg,
+                       FD_FN_UNUSED void * ptr ) {}
+
+/* fd_bincode_footprint_alloc accounts for an allocation of cnt
+   elements of sz bytes aligned to align in *total_sz, in the same way
+   as fd_bincode_arena_alloc would place it. */
+
+static inline int
+fd_bincode_footprint_alloc( ulong * total_sz,
+                            ulong   align,
+                            ulong   sz,
+                            ulong   cnt ) {
+  ulong off = fd_ulong_align_up( *total_sz, align );
+  if( FD_UNLIKELY( off<*total_sz || ( sz && cnt>(ULONG_MAX-off)/sz ) ) ) /* overflow */
+    return FD_BINCODE_ERR_UNDERFLOW;
+  *total_sz = off + sz*cnt;
+  return FD_BINCODE_SUCCESS;
+}
+
+/* fd_bincode_skip_decode validates that sz more bytes can be decoded
+   and skips them. */
+
+static inline int
+fd_bincode_skip_decode( ulong                     sz,
+                        fd_bincode_decode_ctx_t * ctx ) {
+  if( FD_UNLIKELY( sz>(ulong)ctx->dataend-(ulong)ctx->data ) )
+    return FD_BINCODE_ERR_UNDERFLOW;
+  ctx->data = (uchar const *)ctx->data + sz;
+  return FD_BINCODE_SUCCESS;
+}
+
+/* fd_bincode_len_check returns FD_BINCODE_ERR_UNDERFLOW if a collection
+   of len elements, none of which encodes to less than a byte, cannot
+   fit in the rest of the buffer.  This bounds the footprint of any
+   decoded value by a small multiple of the encoded size. */
+
+static inline int
+fd_bincode_len_check( ulong                           len,
+                      fd_bincode_decode_ctx_t const * ctx ) {
+  return len>(ulong)ctx->dataend-(ulong)ctx->data ? FD_BINCODE_ERR_UNDERFLOW : FD_BINCODE_SUCCESS;
+}
 
 #endif /* HEADER_fd_src_util_encoders_fd_bincode_h */
@@ -19,6 +19,12 @@ int fd_fee_calculator_decode(fd_fee_calculator_t* self, fd_bincode_decode_ctx_t
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_fee_calculator_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_fee_calculator_new(fd_fee_calculator_t* self) {
 }
 void fd_fee_calculator_destroy(fd_fee_calculator_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -52,6 +58,16 @@ int fd_hash_age_decode(fd_hash_age_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_hash_age_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_fee_calculator_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_hash_age_new(fd_hash_age_t* self) {
   fd_fee_calculator_new(&self->fee_calculator);
 }
@@ -93,6 +109,14 @@ int fd_hash_hash_age_pair_decode(fd_hash_hash_age_pair_t* self, fd_bincode_decod
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_hash_hash_age_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_age_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_hash_hash_age_pair_new(fd_hash_hash_age_pair_t* self) {
   fd_hash_new(&self->key);
   fd_hash_age_new(&self->val);
@@ -157,6 +181,38 @@ int fd_block_hash_queue_decode(fd_block_hash_queue_t* self, fd_bincode_decode_ct
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_block_hash_queue_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, FD_HASH_ALIGN, FD_HASH_FOOTPRINT, 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_hash_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  ulong ages_len;
+  err = fd_bincode_uint64_decode(&ages_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(ages_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (ages_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_HASH_HASH_AGE_PAIR_ALIGN, FD_HASH_HASH_AGE_PAIR_FOOTPRINT, ages_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < ages_len; ++i) {
+      err = fd_hash_hash_age_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_block_hash_queue_new(fd_block_hash_queue_t* self) {
   self->last_hash = NULL;
   self->ages = NULL;
@@ -242,6 +298,20 @@ int fd_epoch_schedule_decode(fd_epoch_schedule_t* self, fd_bincode_decode_ctx_t
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_epoch_schedule_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_epoch_schedule_new(fd_epoch_schedule_t* self) {
 }
 void fd_epoch_schedule_destroy(fd_epoch_schedule_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -295,6 +365,20 @@ int fd_fee_rate_governor_decode(fd_fee_rate_governor_t* self, fd_bincode_decode_
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_fee_rate_governor_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_fee_rate_governor_new(fd_fee_rate_governor_t* self) {
 }
 void fd_fee_rate_governor_destroy(fd_fee_rate_governor_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -342,6 +426,14 @@ int fd_slot_pair_decode(fd_slot_pair_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_slot_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_slot_pair_new(fd_slot_pair_t* self) {
 }
 void fd_slot_pair_destroy(fd_slot_pair_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -386,6 +478,23 @@ int fd_hard_forks_decode(fd_hard_forks_t* self, fd_bincode_decode_ctx_t * ctx) {
     self->hard_forks = NULL;
   return FD_BINCODE_SUCCESS;
 }
+int fd_hard_forks_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ulong hard_forks_len;
+  err = fd_bincode_uint64_decode(&hard_forks_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(hard_forks_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (hard_forks_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_SLOT_PAIR_ALIGN, FD_SLOT_PAIR_FOOTPRINT, hard_forks_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < hard_forks_len; ++i) {
+      err = fd_slot_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_hard_forks_new(fd_hard_forks_t* self) {
   self->hard_forks = NULL;
 }
@@ -445,6 +554,22 @@ int fd_inflation_decode(fd_inflation_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_inflation_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_inflation_new(fd_inflation_t* self) {
 }
 void fd_inflation_destroy(fd_inflation_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -498,6 +623,16 @@ int fd_rent_decode(fd_rent_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_rent_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_rent_new(fd_rent_t* self) {
 }
 void fd_rent_destroy(fd_rent_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -541,6 +676,18 @@ int fd_rent_collector_decode(fd_rent_collector_t* self, fd_bincode_decode_ctx_t
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_rent_collector_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_epoch_schedule_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_rent_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_rent_collector_new(fd_rent_collector_t* self) {
   fd_epoch_schedule_new(&self->epoch_schedule);
   fd_rent_new(&self->rent);
@@ -590,6 +737,16 @@ int fd_stake_history_entry_decode(fd_stake_history_entry_t* self, fd_bincode_dec
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stake_history_entry_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stake_history_entry_new(fd_stake_history_entry_t* self) {
 }
 void fd_stake_history_entry_destroy(fd_stake_history_entry_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -629,6 +786,14 @@ int fd_stake_history_epochentry_pair_decode(fd_stake_history_epochentry_pair_t*
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stake_history_epochentry_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_stake_history_entry_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stake_history_epochentry_pair_new(fd_stake_history_epochentry_pair_t* self) {
   fd_stake_history_entry_new(&self->entry);
 }
@@ -675,6 +840,23 @@ int fd_stake_history_decode(fd_stake_history_t* self, fd_bincode_decode_ctx_t *
     self->entries = NULL;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stake_history_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ulong entries_len;
+  err = fd_bincode_uint64_decode(&entries_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(entries_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (entries_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_STAKE_HISTORY_EPOCHENTRY_PAIR_ALIGN, FD_STAKE_HISTORY_EPOCHENTRY_PAIR_FOOTPRINT, entries_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < entries_len; ++i) {
+      err = fd_stake_history_epochentry_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stake_history_new(fd_stake_history_t* self) {
   self->entries = NULL;
 }
@@ -738,6 +920,29 @@ int fd_solana_account_decode(fd_solana_account_t* self, fd_bincode_decode_ctx_t
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_solana_account_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong data_len;
+  err = fd_bincode_uint64_decode(&data_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(data_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (data_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, 8UL, 1UL, data_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    err = fd_bincode_skip_decode(data_len, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_solana_account_new(fd_solana_account_t* self) {
   self->data = NULL;
   fd_pubkey_new(&self->owner);
@@ -799,6 +1004,16 @@ int fd_vote_accounts_pair_decode(fd_vote_accounts_pair_t* self, fd_bincode_decod
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_accounts_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_solana_account_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_accounts_pair_new(fd_vote_accounts_pair_t* self) {
   fd_pubkey_new(&self->key);
   fd_solana_account_new(&self->value);
@@ -851,6 +1066,23 @@ int fd_vote_accounts_decode(fd_vote_accounts_t* self, fd_bincode_decode_ctx_t *
     self->vote_accounts = NULL;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_accounts_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ulong vote_accounts_len;
+  err = fd_bincode_uint64_decode(&vote_accounts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(vote_accounts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (vote_accounts_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_VOTE_ACCOUNTS_PAIR_ALIGN, FD_VOTE_ACCOUNTS_PAIR_FOOTPRINT, vote_accounts_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < vote_accounts_len; ++i) {
+      err = fd_vote_accounts_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_accounts_new(fd_vote_accounts_t* self) {
   self->vote_accounts = NULL;
 }
@@ -908,6 +1140,20 @@ int fd_delegation_decode(fd_delegation_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_delegation_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_delegation_new(fd_delegation_t* self) {
   fd_pubkey_new(&self->voter_pubkey);
 }
@@ -957,6 +1203,14 @@ int fd_delegation_pair_decode(fd_delegation_pair_t* self, fd_bincode_decode_ctx_
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_delegation_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_delegation_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_delegation_pair_new(fd_delegation_pair_t* self) {
   fd_pubkey_new(&self->account);
   fd_delegation_new(&self->delegation);
@@ -1011,6 +1265,30 @@ int fd_stakes_decode(fd_stakes_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stakes_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_vote_accounts_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, deq_fd_delegation_pair_t_align(), deq_fd_delegation_pair_t_footprint(), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong stake_delegations_len;
+  err = fd_bincode_uint64_decode(&stake_delegations_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(stake_delegations_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( stake_delegations_len > 35UL ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  for (ulong i = 0; i < stake_delegations_len; ++i) {
+    err = fd_delegation_pair_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_stake_history_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stakes_new(fd_stakes_t* self) {
   fd_vote_accounts_new(&self->vote_accounts);
   self->stake_delegations = NULL;
@@ -1100,6 +1378,20 @@ int fd_bank_incremental_snapshot_persistence_decode(fd_bank_incremental_snapshot
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_bank_incremental_snapshot_persistence_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_bank_incremental_snapshot_persistence_new(fd_bank_incremental_snapshot_persistence_t* self) {
   fd_hash_new(&self->full_hash);
   fd_hash_new(&self->incremental_hash);
@@ -1162,6 +1454,25 @@ int fd_node_vote_accounts_decode(fd_node_vote_accounts_t* self, fd_bincode_decod
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_node_vote_accounts_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ulong vote_accounts_len;
+  err = fd_bincode_uint64_decode(&vote_accounts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(vote_accounts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (vote_accounts_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_PUBKEY_ALIGN, FD_PUBKEY_FOOTPRINT, vote_accounts_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < vote_accounts_len; ++i) {
+      err = fd_pubkey_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_node_vote_accounts_new(fd_node_vote_accounts_t* self) {
   self->vote_accounts = NULL;
 }
@@ -1217,6 +1528,14 @@ int fd_pubkey_node_vote_accounts_pair_decode(fd_pubkey_node_vote_accounts_pair_t
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_pubkey_node_vote_accounts_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_node_vote_accounts_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_pubkey_node_vote_accounts_pair_new(fd_pubkey_node_vote_accounts_pair_t* self) {
   fd_pubkey_new(&self->key);
   fd_node_vote_accounts_new(&self->value);
@@ -1256,6 +1575,14 @@ int fd_pubkey_pubkey_pair_decode(fd_pubkey_pubkey_pair_t* self, fd_bincode_decod
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_pubkey_pubkey_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_pubkey_pubkey_pair_new(fd_pubkey_pubkey_pair_t* self) {
   fd_pubkey_new(&self->key);
   fd_pubkey_new(&self->value);
@@ -1321,6 +1648,40 @@ int fd_epoch_stakes_decode(fd_epoch_stakes_t* self, fd_bincode_decode_ctx_t * ct
     self->epoch_authorized_voters = NULL;
   return FD_BINCODE_SUCCESS;
 }
+int fd_epoch_stakes_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_stakes_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong node_id_to_vote_accounts_len;
+  err = fd_bincode_uint64_decode(&node_id_to_vote_accounts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(node_id_to_vote_accounts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (node_id_to_vote_accounts_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_PUBKEY_NODE_VOTE_ACCOUNTS_PAIR_ALIGN, FD_PUBKEY_NODE_VOTE_ACCOUNTS_PAIR_FOOTPRINT, node_id_to_vote_accounts_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < node_id_to_vote_accounts_len; ++i) {
+      err = fd_pubkey_node_vote_accounts_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  ulong epoch_authorized_voters_len;
+  err = fd_bincode_uint64_decode(&epoch_authorized_voters_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(epoch_authorized_voters_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (epoch_authorized_voters_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_PUBKEY_PUBKEY_PAIR_ALIGN, FD_PUBKEY_PUBKEY_PAIR_FOOTPRINT, epoch_authorized_voters_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < epoch_authorized_voters_len; ++i) {
+      err = fd_pubkey_pubkey_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_epoch_stakes_new(fd_epoch_stakes_t* self) {
   fd_stakes_new(&self->stakes);
   self->node_id_to_vote_accounts = NULL;
@@ -1406,6 +1767,14 @@ int fd_epoch_epoch_stakes_pair_decode(fd_epoch_epoch_stakes_pair_t* self, fd_bin
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_epoch_epoch_stakes_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_epoch_stakes_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_epoch_epoch_stakes_pair_new(fd_epoch_epoch_stakes_pair_t* self) {
   fd_epoch_stakes_new(&self->value);
 }
@@ -1443,6 +1812,14 @@ int fd_pubkey_u64_pair_decode(fd_pubkey_u64_pair_t* self, fd_bincode_decode_ctx_
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_pubkey_u64_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_pubkey_u64_pair_new(fd_pubkey_u64_pair_t* self) {
   fd_pubkey_new(&self->_0);
 }
@@ -1515,6 +1892,49 @@ int fd_unused_accounts_decode(fd_unused_accounts_t* self, fd_bincode_decode_ctx_
     self->unused3 = NULL;
   return FD_BINCODE_SUCCESS;
 }
+int fd_unused_accounts_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ulong unused1_len;
+  err = fd_bincode_uint64_decode(&unused1_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(unused1_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (unused1_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_PUBKEY_ALIGN, FD_PUBKEY_FOOTPRINT, unused1_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < unused1_len; ++i) {
+      err = fd_pubkey_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  ulong unused2_len;
+  err = fd_bincode_uint64_decode(&unused2_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(unused2_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (unused2_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_PUBKEY_ALIGN, FD_PUBKEY_FOOTPRINT, unused2_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < unused2_len; ++i) {
+      err = fd_pubkey_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  ulong unused3_len;
+  err = fd_bincode_uint64_decode(&unused3_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(unused3_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (unused3_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_PUBKEY_U64_PAIR_ALIGN, FD_PUBKEY_U64_PAIR_FOOTPRINT, unused3_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < unused3_len; ++i) {
+      err = fd_pubkey_u64_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_unused_accounts_new(fd_unused_accounts_t* self) {
   self->unused1 = NULL;
   self->unused2 = NULL;
@@ -1705,24 +2125,123 @@ int fd_deserializable_versioned_bank_decode(fd_deserializable_versioned_bank_t*
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
-void fd_deserializable_versioned_bank_new(fd_deserializable_versioned_bank_t* self) {
-  fd_block_hash_queue_new(&self->blockhash_queue);
-  self->ancestors = NULL;
-  fd_hash_new(&self->hash);
-  fd_hash_new(&self->parent_hash);
-  fd_hard_forks_new(&self->hard_forks);
-  self->hashes_per_tick = NULL;
-  fd_pubkey_new(&self->collector_id);
-  fd_fee_calculator_new(&self->fee_calculator);
-  fd_fee_rate_governor_new(&self->fee_rate_governor);
-  fd_rent_collector_new(&self->rent_collector);
-  fd_epoch_schedule_new(&self->epoch_schedule);
-  fd_inflation_new(&self->inflation);
-  fd_stakes_new(&self->stakes);
-  fd_unused_accounts_new(&self->unused_accounts);
-  self->epoch_stakes = NULL;
-}
-void fd_deserializable_versioned_bank_destroy(fd_deserializable_versioned_bank_t* self, fd_bincode_destroy_ctx_t * ctx) {
+int fd_deserializable_versioned_bank_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_block_hash_queue_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong ancestors_len;
+  err = fd_bincode_uint64_decode(&ancestors_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(ancestors_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (ancestors_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_SLOT_PAIR_ALIGN, FD_SLOT_PAIR_FOOTPRINT, ancestors_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < ancestors_len; ++i) {
+      err = fd_slot_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hard_forks_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uint128), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_fee_calculator_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_fee_rate_governor_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_rent_collector_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_epoch_schedule_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_inflation_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_stakes_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_unused_accounts_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong epoch_stakes_len;
+  err = fd_bincode_uint64_decode(&epoch_stakes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(epoch_stakes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (epoch_stakes_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_EPOCH_EPOCH_STAKES_PAIR_ALIGN, FD_EPOCH_EPOCH_STAKES_PAIR_FOOTPRINT, epoch_stakes_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < epoch_stakes_len; ++i) {
+      err = fd_epoch_epoch_stakes_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_bincode_skip_decode(sizeof(char), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
+void fd_deserializable_versioned_bank_new(fd_deserializable_versioned_bank_t* self) {
+  fd_block_hash_queue_new(&self->blockhash_queue);
+  self->ancestors = NULL;
+  fd_hash_new(&self->hash);
+  fd_hash_new(&self->parent_hash);
+  fd_hard_forks_new(&self->hard_forks);
+  self->hashes_per_tick = NULL;
+  fd_pubkey_new(&self->collector_id);
+  fd_fee_calculator_new(&self->fee_calculator);
+  fd_fee_rate_governor_new(&self->fee_rate_governor);
+  fd_rent_collector_new(&self->rent_collector);
+  fd_epoch_schedule_new(&self->epoch_schedule);
+  fd_inflation_new(&self->inflation);
+  fd_stakes_new(&self->stakes);
+  fd_unused_accounts_new(&self->unused_accounts);
+  self->epoch_stakes = NULL;
+}
+void fd_deserializable_versioned_bank_destroy(fd_deserializable_versioned_bank_t* self, fd_bincode_destroy_ctx_t * ctx) {
   fd_block_hash_queue_destroy(&self->blockhash_queue, ctx);
   if (NULL != self->ancestors) {
     for (ulong i = 0; i < self->ancestors_len; ++i)
@@ -1939,6 +2458,14 @@ int fd_serializable_account_storage_entry_decode(fd_serializable_account_storage
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_serializable_account_storage_entry_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_serializable_account_storage_entry_new(fd_serializable_account_storage_entry_t* self) {
 }
 void fd_serializable_account_storage_entry_destroy(fd_serializable_account_storage_entry_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -1980,6 +2507,20 @@ int fd_bank_hash_stats_decode(fd_bank_hash_stats_t* self, fd_bincode_decode_ctx_
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_bank_hash_stats_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_bank_hash_stats_new(fd_bank_hash_stats_t* self) {
 }
 void fd_bank_hash_stats_destroy(fd_bank_hash_stats_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -2029,6 +2570,16 @@ int fd_bank_hash_info_decode(fd_bank_hash_info_t* self, fd_bincode_decode_ctx_t
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_bank_hash_info_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bank_hash_stats_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_bank_hash_info_new(fd_bank_hash_info_t* self) {
   fd_hash_new(&self->hash);
   fd_hash_new(&self->snapshot_hash);
@@ -2084,6 +2635,23 @@ int fd_slot_account_pair_decode(fd_slot_account_pair_t* self, fd_bincode_decode_
   }
   return FD_BINCODE_SUCCESS;
 }
+int fd_slot_account_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong accounts_len;
+  err = fd_bincode_uint64_decode(&accounts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(accounts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, fd_serializable_account_storage_entry_t_map_align(), fd_serializable_account_storage_entry_t_map_footprint(accounts_len), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  for (ulong i = 0; i < accounts_len; ++i) {
+    err = fd_serializable_account_storage_entry_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_slot_account_pair_new(fd_slot_account_pair_t* self) {
   self->accounts_pool = NULL;
   self->accounts_root = NULL;
@@ -2135,6 +2703,14 @@ int fd_slot_map_pair_decode(fd_slot_map_pair_t* self, fd_bincode_decode_ctx_t *
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_slot_map_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_slot_map_pair_new(fd_slot_map_pair_t* self) {
   fd_hash_new(&self->hash);
 }
@@ -2209,6 +2785,51 @@ int fd_solana_accounts_db_fields_decode(fd_solana_accounts_db_fields_t* self, fd
     self->historical_roots_with_hash = NULL;
   return FD_BINCODE_SUCCESS;
 }
+int fd_solana_accounts_db_fields_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ulong storages_len;
+  err = fd_bincode_uint64_decode(&storages_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(storages_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, fd_slot_account_pair_t_map_align(), fd_slot_account_pair_t_map_footprint(storages_len), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  for (ulong i = 0; i < storages_len; ++i) {
+    err = fd_slot_account_pair_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bank_hash_info_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong historical_roots_len;
+  err = fd_bincode_uint64_decode(&historical_roots_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(historical_roots_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (historical_roots_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), historical_roots_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    err = fd_bincode_skip_decode(sizeof(ulong)*historical_roots_len, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  ulong historical_roots_with_hash_len;
+  err = fd_bincode_uint64_decode(&historical_roots_with_hash_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(historical_roots_with_hash_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (historical_roots_with_hash_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_SLOT_MAP_PAIR_ALIGN, FD_SLOT_MAP_PAIR_FOOTPRINT, historical_roots_with_hash_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < historical_roots_with_hash_len; ++i) {
+      err = fd_slot_map_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_solana_accounts_db_fields_new(fd_solana_accounts_db_fields_t* self) {
   self->storages_pool = NULL;
   self->storages_root = NULL;
@@ -2316,6 +2937,16 @@ int fd_solana_manifest_decode(fd_solana_manifest_t* self, fd_bincode_decode_ctx_
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_solana_manifest_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_deserializable_versioned_bank_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_solana_accounts_db_fields_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_solana_manifest_new(fd_solana_manifest_t* self) {
   fd_deserializable_versioned_bank_new(&self->bank);
   fd_solana_accounts_db_fields_new(&self->accounts_db);
@@ -2359,6 +2990,14 @@ int fd_rust_duration_decode(fd_rust_duration_t* self, fd_bincode_decode_ctx_t *
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_rust_duration_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uint), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_rust_duration_new(fd_rust_duration_t* self) {
 }
 void fd_rust_duration_destroy(fd_rust_duration_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -2414,6 +3053,34 @@ int fd_poh_config_decode(fd_poh_config_t* self, fd_bincode_decode_ctx_t * ctx) {
   }
   return FD_BINCODE_SUCCESS;
 }
+int fd_poh_config_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_rust_duration_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_poh_config_new(fd_poh_config_t* self) {
   fd_rust_duration_new(&self->target_tick_duration);
   self->target_tick_count = NULL;
@@ -2490,6 +3157,19 @@ int fd_string_pubkey_pair_decode(fd_string_pubkey_pair_t* self, fd_bincode_decod
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_string_pubkey_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ulong slen;
+  err = fd_bincode_uint64_decode(&slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, 1UL, slen + 1, 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_string_pubkey_pair_new(fd_string_pubkey_pair_t* self) {
   self->string = NULL;
   fd_pubkey_new(&self->pubkey);
@@ -2535,6 +3215,14 @@ int fd_pubkey_account_pair_decode(fd_pubkey_account_pair_t* self, fd_bincode_dec
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_pubkey_account_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_solana_account_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_pubkey_account_pair_new(fd_pubkey_account_pair_t* self) {
   fd_pubkey_new(&self->key);
   fd_solana_account_new(&self->account);
@@ -2629,6 +3317,69 @@ int fd_genesis_solana_decode(fd_genesis_solana_t* self, fd_bincode_decode_ctx_t
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_genesis_solana_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong accounts_len;
+  err = fd_bincode_uint64_decode(&accounts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(accounts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (accounts_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_PUBKEY_ACCOUNT_PAIR_ALIGN, FD_PUBKEY_ACCOUNT_PAIR_FOOTPRINT, accounts_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < accounts_len; ++i) {
+      err = fd_pubkey_account_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  ulong native_instruction_processors_len;
+  err = fd_bincode_uint64_decode(&native_instruction_processors_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(native_instruction_processors_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (native_instruction_processors_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_STRING_PUBKEY_PAIR_ALIGN, FD_STRING_PUBKEY_PAIR_FOOTPRINT, native_instruction_processors_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < native_instruction_processors_len; ++i) {
+      err = fd_string_pubkey_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  ulong rewards_pools_len;
+  err = fd_bincode_uint64_decode(&rewards_pools_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(rewards_pools_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (rewards_pools_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_PUBKEY_ACCOUNT_PAIR_ALIGN, FD_PUBKEY_ACCOUNT_PAIR_FOOTPRINT, rewards_pools_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < rewards_pools_len; ++i) {
+      err = fd_pubkey_account_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_poh_config_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_fee_rate_governor_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_rent_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_inflation_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_epoch_schedule_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uint), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_genesis_solana_new(fd_genesis_solana_t* self) {
   self->accounts = NULL;
   self->native_instruction_processors = NULL;
@@ -2788,6 +3539,24 @@ int fd_secp256k1_signature_offsets_decode(fd_secp256k1_signature_offsets_t* self
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_secp256k1_signature_offsets_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ushort), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ushort), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ushort), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ushort), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_secp256k1_signature_offsets_new(fd_secp256k1_signature_offsets_t* self) {
 }
 void fd_secp256k1_signature_offsets_destroy(fd_secp256k1_signature_offsets_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -2849,6 +3618,20 @@ int fd_sol_sysvar_clock_decode(fd_sol_sysvar_clock_t* self, fd_bincode_decode_ct
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_sol_sysvar_clock_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(long), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(long), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_sol_sysvar_clock_new(fd_sol_sysvar_clock_t* self) {
 }
 void fd_sol_sysvar_clock_destroy(fd_sol_sysvar_clock_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -2896,6 +3679,14 @@ int fd_vote_lockout_decode(fd_vote_lockout_t* self, fd_bincode_decode_ctx_t * ct
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_lockout_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uint), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_lockout_new(fd_vote_lockout_t* self) {
 }
 void fd_vote_lockout_destroy(fd_vote_lockout_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -2931,6 +3722,17 @@ int fd_compact_vote_lockout_decode(fd_compact_vote_lockout_t* self, fd_bincode_d
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_compact_vote_lockout_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  {
+    ulong v;
+    err = fd_bincode_varint_decode(&v, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_compact_vote_lockout_new(fd_compact_vote_lockout_t* self) {
 }
 void fd_compact_vote_lockout_destroy(fd_compact_vote_lockout_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -2966,6 +3768,14 @@ int fd_vote_authorized_voter_decode(fd_vote_authorized_voter_t* self, fd_bincode
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_authorized_voter_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_authorized_voter_new(fd_vote_authorized_voter_t* self) {
   fd_pubkey_new(&self->pubkey);
 }
@@ -3005,6 +3815,16 @@ int fd_vote_prior_voter_decode(fd_vote_prior_voter_t* self, fd_bincode_decode_ct
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_prior_voter_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_prior_voter_new(fd_vote_prior_voter_t* self) {
   fd_pubkey_new(&self->pubkey);
 }
@@ -3050,6 +3870,18 @@ int fd_vote_prior_voter_0_23_5_decode(fd_vote_prior_voter_0_23_5_t* self, fd_bin
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_prior_voter_0_23_5_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_prior_voter_0_23_5_new(fd_vote_prior_voter_0_23_5_t* self) {
   fd_pubkey_new(&self->pubkey);
 }
@@ -3097,6 +3929,16 @@ int fd_vote_epoch_credits_decode(fd_vote_epoch_credits_t* self, fd_bincode_decod
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_epoch_credits_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_epoch_credits_new(fd_vote_epoch_credits_t* self) {
 }
 void fd_vote_epoch_credits_destroy(fd_vote_epoch_credits_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -3136,6 +3978,14 @@ int fd_vote_historical_authorized_voter_decode(fd_vote_historical_authorized_vot
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_historical_authorized_voter_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_historical_authorized_voter_new(fd_vote_historical_authorized_voter_t* self) {
   fd_pubkey_new(&self->pubkey);
 }
@@ -3173,6 +4023,14 @@ int fd_vote_block_timestamp_decode(fd_vote_block_timestamp_t* self, fd_bincode_d
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_block_timestamp_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_block_timestamp_new(fd_vote_block_timestamp_t* self) {
 }
 void fd_vote_block_timestamp_destroy(fd_vote_block_timestamp_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -3212,6 +4070,18 @@ int fd_vote_prior_voters_decode(fd_vote_prior_voters_t* self, fd_bincode_decode_
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_prior_voters_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  for (ulong i = 0; i < 32; ++i) {
+    err = fd_vote_prior_voter_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_prior_voters_new(fd_vote_prior_voters_t* self) {
   for (ulong i = 0; i < 32; ++i)
     fd_vote_prior_voter_new(self->buf + i);
@@ -3263,6 +4133,18 @@ int fd_vote_prior_voters_0_23_5_decode(fd_vote_prior_voters_0_23_5_t* self, fd_b
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_prior_voters_0_23_5_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  for (ulong i = 0; i < 32; ++i) {
+    err = fd_vote_prior_voter_0_23_5_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_prior_voters_0_23_5_new(fd_vote_prior_voters_0_23_5_t* self) {
   for (ulong i = 0; i < 32; ++i)
     fd_vote_prior_voter_0_23_5_new(self->buf + i);
@@ -3301,30 +4183,82 @@ int fd_vote_prior_voters_0_23_5_encode(fd_vote_prior_voters_0_23_5_t const * sel
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
-
-int fd_vote_state_0_23_5_decode(fd_vote_state_0_23_5_t* self, fd_bincode_decode_ctx_t * ctx) {
+
+int fd_vote_state_0_23_5_decode(fd_vote_state_0_23_5_t* self, fd_bincode_decode_ctx_t * ctx) {
+  int err;
+  err = fd_pubkey_decode(&self->voting_node, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode(&self->authorized_voter, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_uint64_decode(&self->authorized_voter_epoch, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_vote_prior_voters_0_23_5_decode(&self->prior_voters, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode(&self->authorized_withdrawer, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_uint8_decode(&self->commission, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  self->votes = deq_fd_vote_lockout_t_alloc( ctx->allocf, ctx->allocf_arg );
+  ulong votes_len;
+  err = fd_bincode_uint64_decode(&votes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( votes_len > deq_fd_vote_lockout_t_max(self->votes) ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  for (ulong i = 0; i < votes_len; ++i) {
+    fd_vote_lockout_t * elem = deq_fd_vote_lockout_t_push_tail_nocopy(self->votes);
+    fd_vote_lockout_new(elem);
+    err = fd_vote_lockout_decode(elem, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      self->saved_root_slot = (ulong*)(*ctx->allocf)(ctx->allocf_arg, 8, sizeof(ulong));
+      err = fd_bincode_uint64_decode(self->saved_root_slot, ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    } else
+      self->saved_root_slot = NULL;
+  }
+  self->epoch_credits = deq_fd_vote_epoch_credits_t_alloc( ctx->allocf, ctx->allocf_arg );
+  ulong epoch_credits_len;
+  err = fd_bincode_uint64_decode(&epoch_credits_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( epoch_credits_len > deq_fd_vote_epoch_credits_t_max(self->epoch_credits) ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  for (ulong i = 0; i < epoch_credits_len; ++i) {
+    fd_vote_epoch_credits_t * elem = deq_fd_vote_epoch_credits_t_push_tail_nocopy(self->epoch_credits);
+    fd_vote_epoch_credits_new(elem);
+    err = fd_vote_epoch_credits_decode(elem, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  err = fd_vote_block_timestamp_decode(&self->latest_timestamp, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_vote_state_0_23_5_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
   int err;
-  err = fd_pubkey_decode(&self->voting_node, ctx);
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
   if ( FD_UNLIKELY(err) ) return err;
-  err = fd_pubkey_decode(&self->authorized_voter, ctx);
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
   if ( FD_UNLIKELY(err) ) return err;
-  err = fd_bincode_uint64_decode(&self->authorized_voter_epoch, ctx);
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
   if ( FD_UNLIKELY(err) ) return err;
-  err = fd_vote_prior_voters_0_23_5_decode(&self->prior_voters, ctx);
+  err = fd_vote_prior_voters_0_23_5_decode_footprint(ctx, total_sz);
   if ( FD_UNLIKELY(err) ) return err;
-  err = fd_pubkey_decode(&self->authorized_withdrawer, ctx);
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
   if ( FD_UNLIKELY(err) ) return err;
-  err = fd_bincode_uint8_decode(&self->commission, ctx);
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, deq_fd_vote_lockout_t_align(), deq_fd_vote_lockout_t_footprint(), 1UL);
   if ( FD_UNLIKELY(err) ) return err;
-  self->votes = deq_fd_vote_lockout_t_alloc( ctx->allocf, ctx->allocf_arg );
   ulong votes_len;
   err = fd_bincode_uint64_decode(&votes_len, ctx);
   if ( FD_UNLIKELY(err) ) return err;
-  if ( votes_len > deq_fd_vote_lockout_t_max(self->votes) ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  err = fd_bincode_len_check(votes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( votes_len > 35UL ) return FD_BINCODE_ERR_SMALL_DEQUE;
   for (ulong i = 0; i < votes_len; ++i) {
-    fd_vote_lockout_t * elem = deq_fd_vote_lockout_t_push_tail_nocopy(self->votes);
-    fd_vote_lockout_new(elem);
-    err = fd_vote_lockout_decode(elem, ctx);
+    err = fd_vote_lockout_decode_footprint(ctx, total_sz);
     if ( FD_UNLIKELY(err) ) return err;
   }
   {
@@ -3332,24 +4266,25 @@ int fd_vote_state_0_23_5_decode(fd_vote_state_0_23_5_t* self, fd_bincode_decode_
     err = fd_bincode_option_decode(&o, ctx);
     if ( FD_UNLIKELY(err) ) return err;
     if (o) {
-      self->saved_root_slot = (ulong*)(*ctx->allocf)(ctx->allocf_arg, 8, sizeof(ulong));
-      err = fd_bincode_uint64_decode(self->saved_root_slot, ctx);
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
       if ( FD_UNLIKELY(err) ) return err;
-    } else
-      self->saved_root_slot = NULL;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
   }
-  self->epoch_credits = deq_fd_vote_epoch_credits_t_alloc( ctx->allocf, ctx->allocf_arg );
+  err = fd_bincode_footprint_alloc(total_sz, deq_fd_vote_epoch_credits_t_align(), deq_fd_vote_epoch_credits_t_footprint(), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
   ulong epoch_credits_len;
   err = fd_bincode_uint64_decode(&epoch_credits_len, ctx);
   if ( FD_UNLIKELY(err) ) return err;
-  if ( epoch_credits_len > deq_fd_vote_epoch_credits_t_max(self->epoch_credits) ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  err = fd_bincode_len_check(epoch_credits_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( epoch_credits_len > 35UL ) return FD_BINCODE_ERR_SMALL_DEQUE;
   for (ulong i = 0; i < epoch_credits_len; ++i) {
-    fd_vote_epoch_credits_t * elem = deq_fd_vote_epoch_credits_t_push_tail_nocopy(self->epoch_credits);
-    fd_vote_epoch_credits_new(elem);
-    err = fd_vote_epoch_credits_decode(elem, ctx);
+    err = fd_vote_epoch_credits_decode_footprint(ctx, total_sz);
     if ( FD_UNLIKELY(err) ) return err;
   }
-  err = fd_vote_block_timestamp_decode(&self->latest_timestamp, ctx);
+  err = fd_vote_block_timestamp_decode_footprint(ctx, total_sz);
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
@@ -3559,6 +4494,67 @@ int fd_vote_state_decode(fd_vote_state_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_state_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, deq_fd_vote_lockout_t_align(), deq_fd_vote_lockout_t_footprint(), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong votes_len;
+  err = fd_bincode_uint64_decode(&votes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(votes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( votes_len > 35UL ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  for (ulong i = 0; i < votes_len; ++i) {
+    err = fd_vote_lockout_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_bincode_footprint_alloc(total_sz, deq_fd_vote_historical_authorized_voter_t_align(), deq_fd_vote_historical_authorized_voter_t_footprint(), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong authorized_voters_len;
+  err = fd_bincode_uint64_decode(&authorized_voters_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(authorized_voters_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( authorized_voters_len > 35UL ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  for (ulong i = 0; i < authorized_voters_len; ++i) {
+    err = fd_vote_historical_authorized_voter_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  err = fd_vote_prior_voters_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, deq_fd_vote_epoch_credits_t_align(), deq_fd_vote_epoch_credits_t_footprint(), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong epoch_credits_len;
+  err = fd_bincode_uint64_decode(&epoch_credits_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(epoch_credits_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( epoch_credits_len > 35UL ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  for (ulong i = 0; i < epoch_credits_len; ++i) {
+    err = fd_vote_epoch_credits_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  err = fd_vote_block_timestamp_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_state_new(fd_vote_state_t* self) {
   fd_pubkey_new(&self->voting_node);
   fd_pubkey_new(&self->authorized_withdrawer);
@@ -3758,6 +4754,24 @@ int fd_vote_state_versioned_decode(fd_vote_state_versioned_t* self, fd_bincode_d
   if ( FD_UNLIKELY(err) ) return err;
   return fd_vote_state_versioned_inner_decode(&self->inner, self->discriminant, ctx);
 }
+int fd_vote_state_versioned_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return fd_vote_state_0_23_5_decode_footprint(ctx, total_sz);
+  }
+  case 1: {
+    return fd_vote_state_decode_footprint(ctx, total_sz);
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_vote_state_versioned_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_vote_state_versioned_inner_decode_footprint(discriminant, ctx, total_sz);
+}
 void fd_vote_state_versioned_inner_new(fd_vote_state_versioned_inner_t* self, uint discriminant) {
   switch (discriminant) {
   case 0: {
@@ -3877,6 +4891,47 @@ int fd_vote_state_update_decode(fd_vote_state_update_t* self, fd_bincode_decode_
   }
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_state_update_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ulong lockouts_len;
+  err = fd_bincode_uint64_decode(&lockouts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(lockouts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (lockouts_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_VOTE_LOCKOUT_ALIGN, FD_VOTE_LOCKOUT_FOOTPRINT, lockouts_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < lockouts_len; ++i) {
+      err = fd_vote_lockout_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_state_update_new(fd_vote_state_update_t* self) {
   self->lockouts = NULL;
   self->proposed_root = NULL;
@@ -3996,6 +5051,38 @@ int fd_compact_vote_state_update_decode(fd_compact_vote_state_update_t* self, fd
   }
   return FD_BINCODE_SUCCESS;
 }
+int fd_compact_vote_state_update_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  ushort lockouts_len;
+  err = fd_bincode_compact_u16_decode(&lockouts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(lockouts_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (lockouts_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_COMPACT_VOTE_LOCKOUT_ALIGN, FD_COMPACT_VOTE_LOCKOUT_FOOTPRINT, lockouts_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < lockouts_len; ++i) {
+      err = fd_compact_vote_lockout_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_compact_vote_state_update_new(fd_compact_vote_state_update_t* self) {
   self->lockouts = NULL;
   fd_hash_new(&self->hash);
@@ -4076,6 +5163,14 @@ int fd_compact_vote_state_update_switch_decode(fd_compact_vote_state_update_swit
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_compact_vote_state_update_switch_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_compact_vote_state_update_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_compact_vote_state_update_switch_new(fd_compact_vote_state_update_switch_t* self) {
   fd_compact_vote_state_update_new(&self->compact_vote_state_update);
   fd_hash_new(&self->hash);
@@ -4121,6 +5216,21 @@ int fd_slot_history_inner_decode(fd_slot_history_inner_t* self, fd_bincode_decod
     self->blocks = NULL;
   return FD_BINCODE_SUCCESS;
 }
+int fd_slot_history_inner_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ulong blocks_len;
+  err = fd_bincode_uint64_decode(&blocks_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(blocks_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (blocks_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), blocks_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    err = fd_bincode_skip_decode(sizeof(ulong)*blocks_len, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_slot_history_inner_new(fd_slot_history_inner_t* self) {
   self->blocks = NULL;
 }
@@ -4178,6 +5288,23 @@ int fd_slot_history_bitvec_decode(fd_slot_history_bitvec_t* self, fd_bincode_dec
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_slot_history_bitvec_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, FD_SLOT_HISTORY_INNER_ALIGN, FD_SLOT_HISTORY_INNER_FOOTPRINT, 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_slot_history_inner_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_slot_history_bitvec_new(fd_slot_history_bitvec_t* self) {
   self->bits = NULL;
 }
@@ -4229,6 +5356,14 @@ int fd_slot_history_decode(fd_slot_history_t* self, fd_bincode_decode_ctx_t * ct
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_slot_history_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_slot_history_bitvec_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_slot_history_new(fd_slot_history_t* self) {
   fd_slot_history_bitvec_new(&self->bits);
 }
@@ -4266,6 +5401,14 @@ int fd_slot_hash_decode(fd_slot_hash_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_slot_hash_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_slot_hash_new(fd_slot_hash_t* self) {
   fd_hash_new(&self->hash);
 }
@@ -4310,6 +5453,22 @@ int fd_slot_hashes_decode(fd_slot_hashes_t* self, fd_bincode_decode_ctx_t * ctx)
   }
   return FD_BINCODE_SUCCESS;
 }
+int fd_slot_hashes_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_footprint_alloc(total_sz, deq_fd_slot_hash_t_align(), deq_fd_slot_hash_t_footprint(), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong hashes_len;
+  err = fd_bincode_uint64_decode(&hashes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(hashes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( hashes_len > 35UL ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  for (ulong i = 0; i < hashes_len; ++i) {
+    err = fd_slot_hash_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_slot_hashes_new(fd_slot_hashes_t* self) {
   self->hashes = NULL;
 }
@@ -4373,6 +5532,14 @@ int fd_block_block_hash_entry_decode(fd_block_block_hash_entry_t* self, fd_binco
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_block_block_hash_entry_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_fee_calculator_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_block_block_hash_entry_new(fd_block_block_hash_entry_t* self) {
   fd_hash_new(&self->blockhash);
   fd_fee_calculator_new(&self->fee_calculator);
@@ -4419,6 +5586,22 @@ int fd_recent_block_hashes_decode(fd_recent_block_hashes_t* self, fd_bincode_dec
   }
   return FD_BINCODE_SUCCESS;
 }
+int fd_recent_block_hashes_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_footprint_alloc(total_sz, deq_fd_block_block_hash_entry_t_align(), deq_fd_block_block_hash_entry_t_footprint(), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong hashes_len;
+  err = fd_bincode_uint64_decode(&hashes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(hashes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( hashes_len > 150UL ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  for (ulong i = 0; i < hashes_len; ++i) {
+    err = fd_block_block_hash_entry_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_recent_block_hashes_new(fd_recent_block_hashes_t* self) {
   self->hashes = NULL;
 }
@@ -4512,6 +5695,46 @@ int fd_slot_meta_decode(fd_slot_meta_t* self, fd_bincode_decode_ctx_t * ctx) {
     self->entry_end_indexes = NULL;
   return FD_BINCODE_SUCCESS;
 }
+int fd_slot_meta_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong next_slot_len;
+  err = fd_bincode_uint64_decode(&next_slot_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(next_slot_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (next_slot_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), next_slot_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    err = fd_bincode_skip_decode(sizeof(ulong)*next_slot_len, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong entry_end_indexes_len;
+  err = fd_bincode_uint64_decode(&entry_end_indexes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(entry_end_indexes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (entry_end_indexes_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(uint), entry_end_indexes_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    err = fd_bincode_skip_decode(sizeof(uint)*entry_end_indexes_len, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_slot_meta_new(fd_slot_meta_t* self) {
   self->next_slot = NULL;
   self->entry_end_indexes = NULL;
@@ -4607,6 +5830,14 @@ int fd_slot_meta_meta_decode(fd_slot_meta_meta_t* self, fd_bincode_decode_ctx_t
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_slot_meta_meta_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_slot_meta_meta_new(fd_slot_meta_meta_t* self) {
 }
 void fd_slot_meta_meta_destroy(fd_slot_meta_meta_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -4644,6 +5875,16 @@ int fd_clock_timestamp_vote_decode(fd_clock_timestamp_vote_t* self, fd_bincode_d
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_clock_timestamp_vote_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(long), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_clock_timestamp_vote_new(fd_clock_timestamp_vote_t* self) {
   fd_pubkey_new(&self->pubkey);
 }
@@ -4692,6 +5933,22 @@ int fd_clock_timestamp_votes_decode(fd_clock_timestamp_votes_t* self, fd_bincode
   }
   return FD_BINCODE_SUCCESS;
 }
+int fd_clock_timestamp_votes_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_footprint_alloc(total_sz, deq_fd_clock_timestamp_vote_t_align(), deq_fd_clock_timestamp_vote_t_footprint(), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong votes_len;
+  err = fd_bincode_uint64_decode(&votes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(votes_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( votes_len > 35UL ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  for (ulong i = 0; i < votes_len; ++i) {
+    err = fd_clock_timestamp_vote_decode_footprint(ctx, total_sz);
+    if ( FD_UNLIKELY(err) ) return err;
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_clock_timestamp_votes_new(fd_clock_timestamp_votes_t* self) {
   self->votes = NULL;
 }
@@ -4753,6 +6010,12 @@ int fd_sysvar_fees_decode(fd_sysvar_fees_t* self, fd_bincode_decode_ctx_t * ctx)
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_sysvar_fees_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_fee_calculator_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_sysvar_fees_new(fd_sysvar_fees_t* self) {
   fd_fee_calculator_new(&self->fee_calculator);
 }
@@ -4786,6 +6049,14 @@ int fd_config_keys_pair_decode(fd_config_keys_pair_t* self, fd_bincode_decode_ct
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_config_keys_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_config_keys_pair_new(fd_config_keys_pair_t* self) {
   fd_pubkey_new(&self->key);
 }
@@ -4828,11 +6099,32 @@ int fd_stake_config_decode(fd_stake_config_t* self, fd_bincode_decode_ctx_t * ct
       err = fd_config_keys_pair_decode(self->config_keys + i, ctx);
       if ( FD_UNLIKELY(err) ) return err;
     }
-  } else
-    self->config_keys = NULL;
-  err = fd_bincode_double_decode(&self->warmup_cooldown_rate, ctx);
+  } else
+    self->config_keys = NULL;
+  err = fd_bincode_double_decode(&self->warmup_cooldown_rate, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_uint8_decode(&self->slash_penalty, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_stake_config_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ushort config_keys_len;
+  err = fd_bincode_compact_u16_decode(&config_keys_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(config_keys_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (config_keys_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_CONFIG_KEYS_PAIR_ALIGN, FD_CONFIG_KEYS_PAIR_FOOTPRINT, config_keys_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < config_keys_len; ++i) {
+      err = fd_config_keys_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  err = fd_bincode_skip_decode(sizeof(double), ctx);
   if ( FD_UNLIKELY(err) ) return err;
-  err = fd_bincode_uint8_decode(&self->slash_penalty, ctx);
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
@@ -4899,6 +6191,18 @@ int fd_firedancer_banks_decode(fd_firedancer_banks_t* self, fd_bincode_decode_ct
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_firedancer_banks_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_deserializable_versioned_bank_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_stakes_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_recent_block_hashes_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_clock_timestamp_votes_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_firedancer_banks_new(fd_firedancer_banks_t* self) {
   fd_deserializable_versioned_bank_new(&self->solana_bank);
   fd_stakes_new(&self->stakes);
@@ -4969,6 +6273,33 @@ int fd_vote_decode(fd_vote_t* self, fd_bincode_decode_ctx_t * ctx) {
   }
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_footprint_alloc(total_sz, deq_ulong_align(), deq_ulong_footprint(), 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong slots_len;
+  err = fd_bincode_uint64_decode(&slots_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(slots_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if ( slots_len > 35UL ) return FD_BINCODE_ERR_SMALL_DEQUE;
+  err = fd_bincode_skip_decode(sizeof(ulong)*slots_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_new(fd_vote_t* self) {
   self->slots = NULL;
   fd_hash_new(&self->hash);
@@ -5053,6 +6384,18 @@ int fd_vote_init_decode(fd_vote_init_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_init_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_init_new(fd_vote_init_t* self) {
   fd_pubkey_new(&self->node_pubkey);
   fd_pubkey_new(&self->authorized_voter);
@@ -5119,6 +6462,24 @@ int fd_vote_authorize_decode(fd_vote_authorize_t* self, fd_bincode_decode_ctx_t
   if ( FD_UNLIKELY(err) ) return err;
   return fd_vote_authorize_inner_decode(&self->inner, self->discriminant, ctx);
 }
+int fd_vote_authorize_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 1: {
+    return FD_BINCODE_SUCCESS;
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_vote_authorize_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_vote_authorize_inner_decode_footprint(discriminant, ctx, total_sz);
+}
 void fd_vote_authorize_inner_new(fd_vote_authorize_inner_t* self, uint discriminant) {
   switch (discriminant) {
   case 0: {
@@ -5180,6 +6541,14 @@ int fd_vote_authorize_pubkey_decode(fd_vote_authorize_pubkey_t* self, fd_bincode
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_authorize_pubkey_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_vote_authorize_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_authorize_pubkey_new(fd_vote_authorize_pubkey_t* self) {
   fd_pubkey_new(&self->pubkey);
   fd_vote_authorize_new(&self->vote_authorize);
@@ -5219,6 +6588,14 @@ int fd_vote_switch_decode(fd_vote_switch_t* self, fd_bincode_decode_ctx_t * ctx)
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_switch_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_vote_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_switch_new(fd_vote_switch_t* self) {
   fd_vote_new(&self->vote);
   fd_hash_new(&self->hash);
@@ -5258,6 +6635,14 @@ int fd_update_vote_state_switch_decode(fd_update_vote_state_switch_t* self, fd_b
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_update_vote_state_switch_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_vote_state_update_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_update_vote_state_switch_new(fd_update_vote_state_switch_t* self) {
   fd_vote_state_update_new(&self->vote_state_update);
   fd_hash_new(&self->hash);
@@ -5306,6 +6691,23 @@ int fd_vote_authorize_with_seed_args_decode(fd_vote_authorize_with_seed_args_t*
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_authorize_with_seed_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_vote_authorize_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong slen;
+  err = fd_bincode_uint64_decode(&slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, 1UL, slen + 1, 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_authorize_with_seed_args_new(fd_vote_authorize_with_seed_args_t* self) {
   fd_vote_authorize_new(&self->authorization_type);
   fd_pubkey_new(&self->current_authority_derived_key_owner);
@@ -5370,6 +6772,21 @@ int fd_vote_authorize_checked_with_seed_args_decode(fd_vote_authorize_checked_wi
   self->current_authority_derived_key_seed[slen] = '\0';
   return FD_BINCODE_SUCCESS;
 }
+int fd_vote_authorize_checked_with_seed_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_vote_authorize_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong slen;
+  err = fd_bincode_uint64_decode(&slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, 1UL, slen + 1, 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_vote_authorize_checked_with_seed_args_new(fd_vote_authorize_checked_with_seed_args_t* self) {
   fd_vote_authorize_new(&self->authorization_type);
   fd_pubkey_new(&self->current_authority_derived_key_owner);
@@ -5514,6 +6931,64 @@ int fd_vote_instruction_decode(fd_vote_instruction_t* self, fd_bincode_decode_ct
   if ( FD_UNLIKELY(err) ) return err;
   return fd_vote_instruction_inner_decode(&self->inner, self->discriminant, ctx);
 }
+int fd_vote_instruction_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return fd_vote_init_decode_footprint(ctx, total_sz);
+  }
+  case 1: {
+    return fd_vote_authorize_pubkey_decode_footprint(ctx, total_sz);
+  }
+  case 2: {
+    return fd_vote_decode_footprint(ctx, total_sz);
+  }
+  case 3: {
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+    return FD_BINCODE_SUCCESS;
+  }
+  case 4: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 5: {
+  err = fd_bincode_skip_decode(sizeof(uchar), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+    return FD_BINCODE_SUCCESS;
+  }
+  case 6: {
+    return fd_vote_switch_decode_footprint(ctx, total_sz);
+  }
+  case 7: {
+    return fd_vote_authorize_decode_footprint(ctx, total_sz);
+  }
+  case 8: {
+    return fd_vote_state_update_decode_footprint(ctx, total_sz);
+  }
+  case 9: {
+    return fd_update_vote_state_switch_decode_footprint(ctx, total_sz);
+  }
+  case 10: {
+    return fd_vote_authorize_with_seed_args_decode_footprint(ctx, total_sz);
+  }
+  case 11: {
+    return fd_vote_authorize_checked_with_seed_args_decode_footprint(ctx, total_sz);
+  }
+  case 12: {
+    return fd_compact_vote_state_update_decode_footprint(ctx, total_sz);
+  }
+  case 13: {
+    return fd_compact_vote_state_update_switch_decode_footprint(ctx, total_sz);
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_vote_instruction_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_vote_instruction_inner_decode_footprint(discriminant, ctx, total_sz);
+}
 void fd_vote_instruction_inner_new(fd_vote_instruction_inner_t* self, uint discriminant) {
   switch (discriminant) {
   case 0: {
@@ -5791,6 +7266,16 @@ int fd_system_program_instruction_create_account_decode(fd_system_program_instru
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_system_program_instruction_create_account_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_system_program_instruction_create_account_new(fd_system_program_instruction_create_account_t* self) {
   fd_pubkey_new(&self->owner);
 }
@@ -5843,6 +7328,25 @@ int fd_system_program_instruction_create_account_with_seed_decode(fd_system_prog
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_system_program_instruction_create_account_with_seed_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong slen;
+  err = fd_bincode_uint64_decode(&slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, 1UL, slen + 1, 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_system_program_instruction_create_account_with_seed_new(fd_system_program_instruction_create_account_with_seed_t* self) {
   fd_pubkey_new(&self->base);
   self->seed = NULL;
@@ -5911,6 +7415,23 @@ int fd_system_program_instruction_allocate_with_seed_decode(fd_system_program_in
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_system_program_instruction_allocate_with_seed_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong slen;
+  err = fd_bincode_uint64_decode(&slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, 1UL, slen + 1, 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_system_program_instruction_allocate_with_seed_new(fd_system_program_instruction_allocate_with_seed_t* self) {
   fd_pubkey_new(&self->base);
   self->seed = NULL;
@@ -5973,6 +7494,21 @@ int fd_system_program_instruction_assign_with_seed_decode(fd_system_program_inst
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_system_program_instruction_assign_with_seed_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong slen;
+  err = fd_bincode_uint64_decode(&slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, 1UL, slen + 1, 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_system_program_instruction_assign_with_seed_new(fd_system_program_instruction_assign_with_seed_t* self) {
   fd_pubkey_new(&self->base);
   self->seed = NULL;
@@ -6031,6 +7567,21 @@ int fd_system_program_instruction_transfer_with_seed_decode(fd_system_program_in
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_system_program_instruction_transfer_with_seed_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong slen;
+  err = fd_bincode_uint64_decode(&slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, 1UL, slen + 1, 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_system_program_instruction_transfer_with_seed_new(fd_system_program_instruction_transfer_with_seed_t* self) {
   self->from_seed = NULL;
   fd_pubkey_new(&self->from_owner);
@@ -6169,6 +7720,63 @@ int fd_system_program_instruction_decode(fd_system_program_instruction_t* self,
   if ( FD_UNLIKELY(err) ) return err;
   return fd_system_program_instruction_inner_decode(&self->inner, self->discriminant, ctx);
 }
+int fd_system_program_instruction_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return fd_system_program_instruction_create_account_decode_footprint(ctx, total_sz);
+  }
+  case 1: {
+    return fd_pubkey_decode_footprint(ctx, total_sz);
+  }
+  case 2: {
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+    return FD_BINCODE_SUCCESS;
+  }
+  case 3: {
+    return fd_system_program_instruction_create_account_with_seed_decode_footprint(ctx, total_sz);
+  }
+  case 4: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 5: {
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+    return FD_BINCODE_SUCCESS;
+  }
+  case 6: {
+    return fd_pubkey_decode_footprint(ctx, total_sz);
+  }
+  case 7: {
+    return fd_pubkey_decode_footprint(ctx, total_sz);
+  }
+  case 8: {
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+    return FD_BINCODE_SUCCESS;
+  }
+  case 9: {
+    return fd_system_program_instruction_allocate_with_seed_decode_footprint(ctx, total_sz);
+  }
+  case 10: {
+    return fd_system_program_instruction_assign_with_seed_decode_footprint(ctx, total_sz);
+  }
+  case 11: {
+    return fd_system_program_instruction_transfer_with_seed_decode_footprint(ctx, total_sz);
+  }
+  case 12: {
+    return FD_BINCODE_SUCCESS;
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_system_program_instruction_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_system_program_instruction_inner_decode_footprint(discriminant, ctx, total_sz);
+}
 void fd_system_program_instruction_inner_new(fd_system_program_instruction_inner_t* self, uint discriminant) {
   switch (discriminant) {
   case 0: {
@@ -6433,9 +8041,47 @@ FD_FN_PURE uchar fd_system_error_is_nonce_blockhash_not_expired(fd_system_error_
 FD_FN_PURE uchar fd_system_error_is_nonce_unexpected_blockhash_value(fd_system_error_t const * self) {
   return self->discriminant == 8;
 }
-void fd_system_error_inner_new(fd_system_error_inner_t* self, uint discriminant);
-int fd_system_error_inner_decode(fd_system_error_inner_t* self, uint discriminant, fd_bincode_decode_ctx_t * ctx) {
-  fd_system_error_inner_new(self, discriminant);
+void fd_system_error_inner_new(fd_system_error_inner_t* self, uint discriminant);
+int fd_system_error_inner_decode(fd_system_error_inner_t* self, uint discriminant, fd_bincode_decode_ctx_t * ctx) {
+  fd_system_error_inner_new(self, discriminant);
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 1: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 2: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 3: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 4: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 5: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 6: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 7: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 8: {
+    return FD_BINCODE_SUCCESS;
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_system_error_decode(fd_system_error_t* self, fd_bincode_decode_ctx_t * ctx) {
+  int err = fd_bincode_uint32_decode(&self->discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_system_error_inner_decode(&self->inner, self->discriminant, ctx);
+}
+int fd_system_error_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
   int err;
   switch (discriminant) {
   case 0: {
@@ -6468,10 +8114,11 @@ int fd_system_error_inner_decode(fd_system_error_inner_t* self, uint discriminan
   default: return FD_BINCODE_ERR_ENCODING;
   }
 }
-int fd_system_error_decode(fd_system_error_t* self, fd_bincode_decode_ctx_t * ctx) {
-  int err = fd_bincode_uint32_decode(&self->discriminant, ctx);
+int fd_system_error_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
   if ( FD_UNLIKELY(err) ) return err;
-  return fd_system_error_inner_decode(&self->inner, self->discriminant, ctx);
+  return fd_system_error_inner_decode_footprint(discriminant, ctx, total_sz);
 }
 void fd_system_error_inner_new(fd_system_error_inner_t* self, uint discriminant) {
   switch (discriminant) {
@@ -6576,6 +8223,14 @@ int fd_stake_authorized_decode(fd_stake_authorized_t* self, fd_bincode_decode_ct
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stake_authorized_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stake_authorized_new(fd_stake_authorized_t* self) {
   fd_pubkey_new(&self->staker);
   fd_pubkey_new(&self->withdrawer);
@@ -6617,6 +8272,16 @@ int fd_stake_lockup_decode(fd_stake_lockup_t* self, fd_bincode_decode_ctx_t * ct
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stake_lockup_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stake_lockup_new(fd_stake_lockup_t* self) {
   fd_pubkey_new(&self->custodian);
 }
@@ -6658,6 +8323,14 @@ int fd_stake_instruction_initialize_decode(fd_stake_instruction_initialize_t* se
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stake_instruction_initialize_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_stake_authorized_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stake_instruction_initialize_new(fd_stake_instruction_initialize_t* self) {
   fd_stake_authorized_new(&self->authorized);
   fd_pubkey_new(&self->lockup);
@@ -6714,6 +8387,24 @@ int fd_stake_authorize_decode(fd_stake_authorize_t* self, fd_bincode_decode_ctx_
   if ( FD_UNLIKELY(err) ) return err;
   return fd_stake_authorize_inner_decode(&self->inner, self->discriminant, ctx);
 }
+int fd_stake_authorize_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 1: {
+    return FD_BINCODE_SUCCESS;
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_stake_authorize_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_stake_authorize_inner_decode_footprint(discriminant, ctx, total_sz);
+}
 void fd_stake_authorize_inner_new(fd_stake_authorize_inner_t* self, uint discriminant) {
   switch (discriminant) {
   case 0: {
@@ -6775,6 +8466,14 @@ int fd_stake_instruction_authorize_decode(fd_stake_instruction_authorize_t* self
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stake_instruction_authorize_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_stake_authorize_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stake_instruction_authorize_new(fd_stake_instruction_authorize_t* self) {
   fd_pubkey_new(&self->pubkey);
   fd_stake_authorize_new(&self->stake_authorize);
@@ -6844,6 +8543,43 @@ int fd_lockup_args_decode(fd_lockup_args_t* self, fd_bincode_decode_ctx_t * ctx)
   }
   return FD_BINCODE_SUCCESS;
 }
+int fd_lockup_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, FD_PUBKEY_ALIGN, FD_PUBKEY_FOOTPRINT, 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_pubkey_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_lockup_args_new(fd_lockup_args_t* self) {
   self->unix_timestamp = NULL;
   self->epoch = NULL;
@@ -6938,6 +8674,23 @@ int fd_authorize_with_seed_args_decode(fd_authorize_with_seed_args_t* self, fd_b
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_authorize_with_seed_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_stake_authorize_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong slen;
+  err = fd_bincode_uint64_decode(&slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, 1UL, slen + 1, 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_authorize_with_seed_args_new(fd_authorize_with_seed_args_t* self) {
   fd_pubkey_new(&self->new_authorized_pubkey);
   fd_stake_authorize_new(&self->stake_authorize);
@@ -7002,6 +8755,21 @@ int fd_authorize_checked_with_seed_args_decode(fd_authorize_checked_with_seed_ar
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_authorize_checked_with_seed_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_stake_authorize_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  ulong slen;
+  err = fd_bincode_uint64_decode(&slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(slen, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_footprint_alloc(total_sz, 1UL, slen + 1, 1UL);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_authorize_checked_with_seed_args_new(fd_authorize_checked_with_seed_args_t* self) {
   fd_stake_authorize_new(&self->stake_authorize);
   self->authority_seed = NULL;
@@ -7071,6 +8839,32 @@ int fd_lockup_checked_args_decode(fd_lockup_checked_args_t* self, fd_bincode_dec
   }
   return FD_BINCODE_SUCCESS;
 }
+int fd_lockup_checked_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  {
+    unsigned char o;
+    err = fd_bincode_option_decode(&o, ctx);
+    if ( FD_UNLIKELY(err) ) return err;
+    if (o) {
+      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);
+      if ( FD_UNLIKELY(err) ) return err;
+      err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_lockup_checked_args_new(fd_lockup_checked_args_t* self) {
   self->unix_timestamp = NULL;
   self->epoch = NULL;
@@ -7223,6 +9017,61 @@ int fd_stake_instruction_decode(fd_stake_instruction_t* self, fd_bincode_decode_
   if ( FD_UNLIKELY(err) ) return err;
   return fd_stake_instruction_inner_decode(&self->inner, self->discriminant, ctx);
 }
+int fd_stake_instruction_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return fd_stake_instruction_initialize_decode_footprint(ctx, total_sz);
+  }
+  case 1: {
+    return fd_stake_instruction_authorize_decode_footprint(ctx, total_sz);
+  }
+  case 2: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 3: {
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+    return FD_BINCODE_SUCCESS;
+  }
+  case 4: {
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+    return FD_BINCODE_SUCCESS;
+  }
+  case 5: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 6: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 7: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 8: {
+    return fd_authorize_with_seed_args_decode_footprint(ctx, total_sz);
+  }
+  case 9: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 10: {
+    return fd_stake_authorize_decode_footprint(ctx, total_sz);
+  }
+  case 11: {
+    return fd_authorize_checked_with_seed_args_decode_footprint(ctx, total_sz);
+  }
+  case 12: {
+    return fd_lockup_checked_args_decode_footprint(ctx, total_sz);
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_stake_instruction_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_stake_instruction_inner_decode_footprint(discriminant, ctx, total_sz);
+}
 void fd_stake_instruction_inner_new(fd_stake_instruction_inner_t* self, uint discriminant) {
   switch (discriminant) {
   case 0: {
@@ -7439,6 +9288,16 @@ int fd_stake_state_meta_decode(fd_stake_state_meta_t* self, fd_bincode_decode_ct
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stake_state_meta_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_stake_authorized_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_stake_lockup_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stake_state_meta_new(fd_stake_state_meta_t* self) {
   fd_stake_authorized_new(&self->authorized);
   fd_stake_lockup_new(&self->lockup);
@@ -7482,6 +9341,14 @@ int fd_stake_decode(fd_stake_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stake_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_delegation_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stake_new(fd_stake_t* self) {
   fd_delegation_new(&self->delegation);
 }
@@ -7519,6 +9386,14 @@ int fd_stake_state_stake_decode(fd_stake_state_stake_t* self, fd_bincode_decode_
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_stake_state_stake_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_stake_state_meta_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_stake_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_stake_state_stake_new(fd_stake_state_stake_t* self) {
   fd_stake_state_meta_new(&self->meta);
   fd_stake_new(&self->stake);
@@ -7587,6 +9462,30 @@ int fd_stake_state_decode(fd_stake_state_t* self, fd_bincode_decode_ctx_t * ctx)
   if ( FD_UNLIKELY(err) ) return err;
   return fd_stake_state_inner_decode(&self->inner, self->discriminant, ctx);
 }
+int fd_stake_state_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 1: {
+    return fd_stake_state_meta_decode_footprint(ctx, total_sz);
+  }
+  case 2: {
+    return fd_stake_state_stake_decode_footprint(ctx, total_sz);
+  }
+  case 3: {
+    return FD_BINCODE_SUCCESS;
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_stake_state_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_stake_state_inner_decode_footprint(discriminant, ctx, total_sz);
+}
 void fd_stake_state_inner_new(fd_stake_state_inner_t* self, uint discriminant) {
   switch (discriminant) {
   case 0: {
@@ -7687,6 +9586,16 @@ int fd_nonce_data_decode(fd_nonce_data_t* self, fd_bincode_decode_ctx_t * ctx) {
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_nonce_data_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_pubkey_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_hash_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_fee_calculator_decode_footprint(ctx, total_sz);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_nonce_data_new(fd_nonce_data_t* self) {
   fd_pubkey_new(&self->authority);
   fd_hash_new(&self->durable_nonce);
@@ -7749,6 +9658,24 @@ int fd_nonce_state_decode(fd_nonce_state_t* self, fd_bincode_decode_ctx_t * ctx)
   if ( FD_UNLIKELY(err) ) return err;
   return fd_nonce_state_inner_decode(&self->inner, self->discriminant, ctx);
 }
+int fd_nonce_state_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return FD_BINCODE_SUCCESS;
+  }
+  case 1: {
+    return fd_nonce_data_decode_footprint(ctx, total_sz);
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_nonce_state_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_nonce_state_inner_decode_footprint(discriminant, ctx, total_sz);
+}
 void fd_nonce_state_inner_new(fd_nonce_state_inner_t* self, uint discriminant) {
   switch (discriminant) {
   case 0: {
@@ -7841,6 +9768,24 @@ int fd_nonce_state_versions_decode(fd_nonce_state_versions_t* self, fd_bincode_d
   if ( FD_UNLIKELY(err) ) return err;
   return fd_nonce_state_versions_inner_decode(&self->inner, self->discriminant, ctx);
 }
+int fd_nonce_state_versions_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return fd_nonce_state_decode_footprint(ctx, total_sz);
+  }
+  case 1: {
+    return fd_nonce_state_decode_footprint(ctx, total_sz);
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_nonce_state_versions_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_nonce_state_versions_inner_decode_footprint(discriminant, ctx, total_sz);
+}
 void fd_nonce_state_versions_inner_new(fd_nonce_state_versions_inner_t* self, uint discriminant) {
   switch (discriminant) {
   case 0: {
@@ -7927,6 +9872,14 @@ int fd_compute_budget_program_instruction_request_units_deprecated_decode(fd_com
   if ( FD_UNLIKELY(err) ) return err;
   return FD_BINCODE_SUCCESS;
 }
+int fd_compute_budget_program_instruction_request_units_deprecated_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  err = fd_bincode_skip_decode(sizeof(uint), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_skip_decode(sizeof(uint), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return FD_BINCODE_SUCCESS;
+}
 void fd_compute_budget_program_instruction_request_units_deprecated_new(fd_compute_budget_program_instruction_request_units_deprecated_t* self) {
 }
 void fd_compute_budget_program_instruction_request_units_deprecated_destroy(fd_compute_budget_program_instruction_request_units_deprecated_t* self, fd_bincode_destroy_ctx_t * ctx) {
@@ -7997,6 +9950,36 @@ int fd_compute_budget_program_instruction_decode(fd_compute_budget_program_instr
   if ( FD_UNLIKELY(err) ) return err;
   return fd_compute_budget_program_instruction_inner_decode(&self->inner, self->discriminant, ctx);
 }
+int fd_compute_budget_program_instruction_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  switch (discriminant) {
+  case 0: {
+    return fd_compute_budget_program_instruction_request_units_deprecated_decode_footprint(ctx, total_sz);
+  }
+  case 1: {
+  err = fd_bincode_skip_decode(sizeof(uint), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+    return FD_BINCODE_SUCCESS;
+  }
+  case 2: {
+  err = fd_bincode_skip_decode(sizeof(uint), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+    return FD_BINCODE_SUCCESS;
+  }
+  case 3: {
+  err = fd_bincode_skip_decode(sizeof(ulong), ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+    return FD_BINCODE_SUCCESS;
+  }
+  default: return FD_BINCODE_ERR_ENCODING;
+  }
+}
+int fd_compute_budget_program_instruction_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  uint discriminant;
+  int err = fd_bincode_uint32_decode(&discriminant, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  return fd_compute_budget_program_instruction_inner_decode_footprint(discriminant, ctx, total_sz);
+}
 void fd_compute_budget_program_instruction_inner_new(fd_compute_budget_program_instruction_inner_t* self, uint discriminant) {
   switch (discriminant) {
   case 0: {
@@ -8120,6 +10103,23 @@ int fd_config_keys_decode(fd_config_keys_t* self, fd_bincode_decode_ctx_t * ctx)
     self->keys = NULL;
   return FD_BINCODE_SUCCESS;
 }
+int fd_config_keys_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {
+  int err;
+  ushort keys_len;
+  err = fd_bincode_compact_u16_decode(&keys_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  err = fd_bincode_len_check(keys_len, ctx);
+  if ( FD_UNLIKELY(err) ) return err;
+  if (keys_len != 0) {
+    err = fd_bincode_footprint_alloc(total_sz, FD_CONFIG_KEYS_PAIR_ALIGN, FD_CONFIG_KEYS_PAIR_FOOTPRINT, keys_len);
+    if ( FD_UNLIKELY(err) ) return err;
+    for (ulong i = 0; i < keys_len; ++i) {
+      err = fd_config_keys_pair_decode_footprint(ctx, total_sz);
+      if ( FD_UNLIKELY(err) ) return err;
+    }
+  }
+  return FD_BINCODE_SUCCESS;
+}
 void fd_config_keys_new(fd_config_keys_t* self) {
   self->keys = NULL;
 }
@@ -1402,6 +1402,7 @@ FD_PROTOTYPES_BEGIN
 
 void fd_fee_calculator_new(fd_fee_calculator_t* self);
 int fd_fee_calculator_decode(fd_fee_calculator_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_fee_calculator_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_fee_calculator_encode(fd_fee_calculator_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_fee_calculator_destroy(fd_fee_calculator_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_fee_calculator_walk(fd_fee_calculator_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1409,6 +1410,7 @@ ulong fd_fee_calculator_size(fd_fee_calculator_t const * self);
 
 void fd_hash_age_new(fd_hash_age_t* self);
 int fd_hash_age_decode(fd_hash_age_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_hash_age_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_hash_age_encode(fd_hash_age_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_hash_age_destroy(fd_hash_age_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_hash_age_walk(fd_hash_age_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1416,6 +1418,7 @@ ulong fd_hash_age_size(fd_hash_age_t const * self);
 
 void fd_hash_hash_age_pair_new(fd_hash_hash_age_pair_t* self);
 int fd_hash_hash_age_pair_decode(fd_hash_hash_age_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_hash_hash_age_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_hash_hash_age_pair_encode(fd_hash_hash_age_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_hash_hash_age_pair_destroy(fd_hash_hash_age_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_hash_hash_age_pair_walk(fd_hash_hash_age_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1423,6 +1426,7 @@ ulong fd_hash_hash_age_pair_size(fd_hash_hash_age_pair_t const * self);
 
 void fd_block_hash_queue_new(fd_block_hash_queue_t* self);
 int fd_block_hash_queue_decode(fd_block_hash_queue_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_block_hash_queue_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_block_hash_queue_encode(fd_block_hash_queue_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_block_hash_queue_destroy(fd_block_hash_queue_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_block_hash_queue_walk(fd_block_hash_queue_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1430,6 +1434,7 @@ ulong fd_block_hash_queue_size(fd_block_hash_queue_t const * self);
 
 void fd_epoch_schedule_new(fd_epoch_schedule_t* self);
 int fd_epoch_schedule_decode(fd_epoch_schedule_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_epoch_schedule_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_epoch_schedule_encode(fd_epoch_schedule_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_epoch_schedule_destroy(fd_epoch_schedule_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_epoch_schedule_walk(fd_epoch_schedule_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1437,6 +1442,7 @@ ulong fd_epoch_schedule_size(fd_epoch_schedule_t const * self);
 
 void fd_fee_rate_governor_new(fd_fee_rate_governor_t* self);
 int fd_fee_rate_governor_decode(fd_fee_rate_governor_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_fee_rate_governor_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_fee_rate_governor_encode(fd_fee_rate_governor_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_fee_rate_governor_destroy(fd_fee_rate_governor_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_fee_rate_governor_walk(fd_fee_rate_governor_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1444,6 +1450,7 @@ ulong fd_fee_rate_governor_size(fd_fee_rate_governor_t const * self);
 
 void fd_slot_pair_new(fd_slot_pair_t* self);
 int fd_slot_pair_decode(fd_slot_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_slot_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_slot_pair_encode(fd_slot_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_slot_pair_destroy(fd_slot_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_slot_pair_walk(fd_slot_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1451,6 +1458,7 @@ ulong fd_slot_pair_size(fd_slot_pair_t const * self);
 
 void fd_hard_forks_new(fd_hard_forks_t* self);
 int fd_hard_forks_decode(fd_hard_forks_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_hard_forks_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_hard_forks_encode(fd_hard_forks_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_hard_forks_destroy(fd_hard_forks_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_hard_forks_walk(fd_hard_forks_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1458,6 +1466,7 @@ ulong fd_hard_forks_size(fd_hard_forks_t const * self);
 
 void fd_inflation_new(fd_inflation_t* self);
 int fd_inflation_decode(fd_inflation_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_inflation_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_inflation_encode(fd_inflation_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_inflation_destroy(fd_inflation_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_inflation_walk(fd_inflation_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1465,6 +1474,7 @@ ulong fd_inflation_size(fd_inflation_t const * self);
 
 void fd_rent_new(fd_rent_t* self);
 int fd_rent_decode(fd_rent_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_rent_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_rent_encode(fd_rent_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_rent_destroy(fd_rent_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_rent_walk(fd_rent_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1472,6 +1482,7 @@ ulong fd_rent_size(fd_rent_t const * self);
 
 void fd_rent_collector_new(fd_rent_collector_t* self);
 int fd_rent_collector_decode(fd_rent_collector_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_rent_collector_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_rent_collector_encode(fd_rent_collector_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_rent_collector_destroy(fd_rent_collector_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_rent_collector_walk(fd_rent_collector_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1479,6 +1490,7 @@ ulong fd_rent_collector_size(fd_rent_collector_t const * self);
 
 void fd_stake_history_entry_new(fd_stake_history_entry_t* self);
 int fd_stake_history_entry_decode(fd_stake_history_entry_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_history_entry_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_history_entry_encode(fd_stake_history_entry_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_history_entry_destroy(fd_stake_history_entry_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_history_entry_walk(fd_stake_history_entry_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1486,6 +1498,7 @@ ulong fd_stake_history_entry_size(fd_stake_history_entry_t const * self);
 
 void fd_stake_history_epochentry_pair_new(fd_stake_history_epochentry_pair_t* self);
 int fd_stake_history_epochentry_pair_decode(fd_stake_history_epochentry_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_history_epochentry_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_history_epochentry_pair_encode(fd_stake_history_epochentry_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_history_epochentry_pair_destroy(fd_stake_history_epochentry_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_history_epochentry_pair_walk(fd_stake_history_epochentry_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1493,6 +1506,7 @@ ulong fd_stake_history_epochentry_pair_size(fd_stake_history_epochentry_pair_t c
 
 void fd_stake_history_new(fd_stake_history_t* self);
 int fd_stake_history_decode(fd_stake_history_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_history_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_history_encode(fd_stake_history_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_history_destroy(fd_stake_history_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_history_walk(fd_stake_history_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1500,6 +1514,7 @@ ulong fd_stake_history_size(fd_stake_history_t const * self);
 
 void fd_solana_account_new(fd_solana_account_t* self);
 int fd_solana_account_decode(fd_solana_account_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_solana_account_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_solana_account_encode(fd_solana_account_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_solana_account_destroy(fd_solana_account_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_solana_account_walk(fd_solana_account_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1507,6 +1522,7 @@ ulong fd_solana_account_size(fd_solana_account_t const * self);
 
 void fd_vote_accounts_pair_new(fd_vote_accounts_pair_t* self);
 int fd_vote_accounts_pair_decode(fd_vote_accounts_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_accounts_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_accounts_pair_encode(fd_vote_accounts_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_accounts_pair_destroy(fd_vote_accounts_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_accounts_pair_walk(fd_vote_accounts_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1514,6 +1530,7 @@ ulong fd_vote_accounts_pair_size(fd_vote_accounts_pair_t const * self);
 
 void fd_vote_accounts_new(fd_vote_accounts_t* self);
 int fd_vote_accounts_decode(fd_vote_accounts_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_accounts_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_accounts_encode(fd_vote_accounts_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_accounts_destroy(fd_vote_accounts_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_accounts_walk(fd_vote_accounts_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1521,6 +1538,7 @@ ulong fd_vote_accounts_size(fd_vote_accounts_t const * self);
 
 void fd_delegation_new(fd_delegation_t* self);
 int fd_delegation_decode(fd_delegation_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_delegation_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_delegation_encode(fd_delegation_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_delegation_destroy(fd_delegation_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_delegation_walk(fd_delegation_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1528,6 +1546,7 @@ ulong fd_delegation_size(fd_delegation_t const * self);
 
 void fd_delegation_pair_new(fd_delegation_pair_t* self);
 int fd_delegation_pair_decode(fd_delegation_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_delegation_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_delegation_pair_encode(fd_delegation_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_delegation_pair_destroy(fd_delegation_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_delegation_pair_walk(fd_delegation_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1535,6 +1554,7 @@ ulong fd_delegation_pair_size(fd_delegation_pair_t const * self);
 
 void fd_stakes_new(fd_stakes_t* self);
 int fd_stakes_decode(fd_stakes_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stakes_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stakes_encode(fd_stakes_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stakes_destroy(fd_stakes_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stakes_walk(fd_stakes_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1542,6 +1562,7 @@ ulong fd_stakes_size(fd_stakes_t const * self);
 
 void fd_bank_incremental_snapshot_persistence_new(fd_bank_incremental_snapshot_persistence_t* self);
 int fd_bank_incremental_snapshot_persistence_decode(fd_bank_incremental_snapshot_persistence_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_bank_incremental_snapshot_persistence_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_bank_incremental_snapshot_persistence_encode(fd_bank_incremental_snapshot_persistence_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_bank_incremental_snapshot_persistence_destroy(fd_bank_incremental_snapshot_persistence_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_bank_incremental_snapshot_persistence_walk(fd_bank_incremental_snapshot_persistence_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1549,6 +1570,7 @@ ulong fd_bank_incremental_snapshot_persistence_size(fd_bank_incremental_snapshot
 
 void fd_node_vote_accounts_new(fd_node_vote_accounts_t* self);
 int fd_node_vote_accounts_decode(fd_node_vote_accounts_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_node_vote_accounts_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_node_vote_accounts_encode(fd_node_vote_accounts_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_node_vote_accounts_destroy(fd_node_vote_accounts_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_node_vote_accounts_walk(fd_node_vote_accounts_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1556,6 +1578,7 @@ ulong fd_node_vote_accounts_size(fd_node_vote_accounts_t const * self);
 
 void fd_pubkey_node_vote_accounts_pair_new(fd_pubkey_node_vote_accounts_pair_t* self);
 int fd_pubkey_node_vote_accounts_pair_decode(fd_pubkey_node_vote_accounts_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_pubkey_node_vote_accounts_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_pubkey_node_vote_accounts_pair_encode(fd_pubkey_node_vote_accounts_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_pubkey_node_vote_accounts_pair_destroy(fd_pubkey_node_vote_accounts_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_pubkey_node_vote_accounts_pair_walk(fd_pubkey_node_vote_accounts_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1563,6 +1586,7 @@ ulong fd_pubkey_node_vote_accounts_pair_size(fd_pubkey_node_vote_accounts_pair_t
 
 void fd_pubkey_pubkey_pair_new(fd_pubkey_pubkey_pair_t* self);
 int fd_pubkey_pubkey_pair_decode(fd_pubkey_pubkey_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_pubkey_pubkey_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_pubkey_pubkey_pair_encode(fd_pubkey_pubkey_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_pubkey_pubkey_pair_destroy(fd_pubkey_pubkey_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_pubkey_pubkey_pair_walk(fd_pubkey_pubkey_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1570,6 +1594,7 @@ ulong fd_pubkey_pubkey_pair_size(fd_pubkey_pubkey_pair_t const * self);
 
 void fd_epoch_stakes_new(fd_epoch_stakes_t* self);
 int fd_epoch_stakes_decode(fd_epoch_stakes_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_epoch_stakes_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_epoch_stakes_encode(fd_epoch_stakes_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_epoch_stakes_destroy(fd_epoch_stakes_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_epoch_stakes_walk(fd_epoch_stakes_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1577,6 +1602,7 @@ ulong fd_epoch_stakes_size(fd_epoch_stakes_t const * self);
 
 void fd_epoch_epoch_stakes_pair_new(fd_epoch_epoch_stakes_pair_t* self);
 int fd_epoch_epoch_stakes_pair_decode(fd_epoch_epoch_stakes_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_epoch_epoch_stakes_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_epoch_epoch_stakes_pair_encode(fd_epoch_epoch_stakes_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_epoch_epoch_stakes_pair_destroy(fd_epoch_epoch_stakes_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_epoch_epoch_stakes_pair_walk(fd_epoch_epoch_stakes_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1584,6 +1610,7 @@ ulong fd_epoch_epoch_stakes_pair_size(fd_epoch_epoch_stakes_pair_t const * self)
 
 void fd_pubkey_u64_pair_new(fd_pubkey_u64_pair_t* self);
 int fd_pubkey_u64_pair_decode(fd_pubkey_u64_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_pubkey_u64_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_pubkey_u64_pair_encode(fd_pubkey_u64_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_pubkey_u64_pair_destroy(fd_pubkey_u64_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_pubkey_u64_pair_walk(fd_pubkey_u64_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1591,6 +1618,7 @@ ulong fd_pubkey_u64_pair_size(fd_pubkey_u64_pair_t const * self);
 
 void fd_unused_accounts_new(fd_unused_accounts_t* self);
 int fd_unused_accounts_decode(fd_unused_accounts_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_unused_accounts_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_unused_accounts_encode(fd_unused_accounts_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_unused_accounts_destroy(fd_unused_accounts_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_unused_accounts_walk(fd_unused_accounts_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1598,6 +1626,7 @@ ulong fd_unused_accounts_size(fd_unused_accounts_t const * self);
 
 void fd_deserializable_versioned_bank_new(fd_deserializable_versioned_bank_t* self);
 int fd_deserializable_versioned_bank_decode(fd_deserializable_versioned_bank_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_deserializable_versioned_bank_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_deserializable_versioned_bank_encode(fd_deserializable_versioned_bank_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_deserializable_versioned_bank_destroy(fd_deserializable_versioned_bank_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_deserializable_versioned_bank_walk(fd_deserializable_versioned_bank_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1605,6 +1634,7 @@ ulong fd_deserializable_versioned_bank_size(fd_deserializable_versioned_bank_t c
 
 void fd_serializable_account_storage_entry_new(fd_serializable_account_storage_entry_t* self);
 int fd_serializable_account_storage_entry_decode(fd_serializable_account_storage_entry_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_serializable_account_storage_entry_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_serializable_account_storage_entry_encode(fd_serializable_account_storage_entry_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_serializable_account_storage_entry_destroy(fd_serializable_account_storage_entry_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_serializable_account_storage_entry_walk(fd_serializable_account_storage_entry_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1612,6 +1642,7 @@ ulong fd_serializable_account_storage_entry_size(fd_serializable_account_storage
 
 void fd_bank_hash_stats_new(fd_bank_hash_stats_t* self);
 int fd_bank_hash_stats_decode(fd_bank_hash_stats_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_bank_hash_stats_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_bank_hash_stats_encode(fd_bank_hash_stats_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_bank_hash_stats_destroy(fd_bank_hash_stats_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_bank_hash_stats_walk(fd_bank_hash_stats_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1619,6 +1650,7 @@ ulong fd_bank_hash_stats_size(fd_bank_hash_stats_t const * self);
 
 void fd_bank_hash_info_new(fd_bank_hash_info_t* self);
 int fd_bank_hash_info_decode(fd_bank_hash_info_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_bank_hash_info_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_bank_hash_info_encode(fd_bank_hash_info_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_bank_hash_info_destroy(fd_bank_hash_info_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_bank_hash_info_walk(fd_bank_hash_info_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1626,6 +1658,7 @@ ulong fd_bank_hash_info_size(fd_bank_hash_info_t const * self);
 
 void fd_slot_account_pair_new(fd_slot_account_pair_t* self);
 int fd_slot_account_pair_decode(fd_slot_account_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_slot_account_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_slot_account_pair_encode(fd_slot_account_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_slot_account_pair_destroy(fd_slot_account_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_slot_account_pair_walk(fd_slot_account_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1633,6 +1666,7 @@ ulong fd_slot_account_pair_size(fd_slot_account_pair_t const * self);
 
 void fd_slot_map_pair_new(fd_slot_map_pair_t* self);
 int fd_slot_map_pair_decode(fd_slot_map_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_slot_map_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_slot_map_pair_encode(fd_slot_map_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_slot_map_pair_destroy(fd_slot_map_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_slot_map_pair_walk(fd_slot_map_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1640,6 +1674,7 @@ ulong fd_slot_map_pair_size(fd_slot_map_pair_t const * self);
 
 void fd_solana_accounts_db_fields_new(fd_solana_accounts_db_fields_t* self);
 int fd_solana_accounts_db_fields_decode(fd_solana_accounts_db_fields_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_solana_accounts_db_fields_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_solana_accounts_db_fields_encode(fd_solana_accounts_db_fields_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_solana_accounts_db_fields_destroy(fd_solana_accounts_db_fields_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_solana_accounts_db_fields_walk(fd_solana_accounts_db_fields_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1647,6 +1682,7 @@ ulong fd_solana_accounts_db_fields_size(fd_solana_accounts_db_fields_t const * s
 
 void fd_solana_manifest_new(fd_solana_manifest_t* self);
 int fd_solana_manifest_decode(fd_solana_manifest_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_solana_manifest_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_solana_manifest_encode(fd_solana_manifest_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_solana_manifest_destroy(fd_solana_manifest_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_solana_manifest_walk(fd_solana_manifest_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1654,6 +1690,7 @@ ulong fd_solana_manifest_size(fd_solana_manifest_t const * self);
 
 void fd_rust_duration_new(fd_rust_duration_t* self);
 int fd_rust_duration_decode(fd_rust_duration_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_rust_duration_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_rust_duration_encode(fd_rust_duration_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_rust_duration_destroy(fd_rust_duration_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_rust_duration_walk(fd_rust_duration_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1661,6 +1698,7 @@ ulong fd_rust_duration_size(fd_rust_duration_t const * self);
 
 void fd_poh_config_new(fd_poh_config_t* self);
 int fd_poh_config_decode(fd_poh_config_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_poh_config_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_poh_config_encode(fd_poh_config_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_poh_config_destroy(fd_poh_config_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_poh_config_walk(fd_poh_config_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1668,6 +1706,7 @@ ulong fd_poh_config_size(fd_poh_config_t const * self);
 
 void fd_string_pubkey_pair_new(fd_string_pubkey_pair_t* self);
 int fd_string_pubkey_pair_decode(fd_string_pubkey_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_string_pubkey_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_string_pubkey_pair_encode(fd_string_pubkey_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_string_pubkey_pair_destroy(fd_string_pubkey_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_string_pubkey_pair_walk(fd_string_pubkey_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1675,6 +1714,7 @@ ulong fd_string_pubkey_pair_size(fd_string_pubkey_pair_t const * self);
 
 void fd_pubkey_account_pair_new(fd_pubkey_account_pair_t* self);
 int fd_pubkey_account_pair_decode(fd_pubkey_account_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_pubkey_account_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_pubkey_account_pair_encode(fd_pubkey_account_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_pubkey_account_pair_destroy(fd_pubkey_account_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_pubkey_account_pair_walk(fd_pubkey_account_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1682,6 +1722,7 @@ ulong fd_pubkey_account_pair_size(fd_pubkey_account_pair_t const * self);
 
 void fd_genesis_solana_new(fd_genesis_solana_t* self);
 int fd_genesis_solana_decode(fd_genesis_solana_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_genesis_solana_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_genesis_solana_encode(fd_genesis_solana_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_genesis_solana_destroy(fd_genesis_solana_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_genesis_solana_walk(fd_genesis_solana_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1689,6 +1730,7 @@ ulong fd_genesis_solana_size(fd_genesis_solana_t const * self);
 
 void fd_secp256k1_signature_offsets_new(fd_secp256k1_signature_offsets_t* self);
 int fd_secp256k1_signature_offsets_decode(fd_secp256k1_signature_offsets_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_secp256k1_signature_offsets_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_secp256k1_signature_offsets_encode(fd_secp256k1_signature_offsets_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_secp256k1_signature_offsets_destroy(fd_secp256k1_signature_offsets_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_secp256k1_signature_offsets_walk(fd_secp256k1_signature_offsets_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1696,6 +1738,7 @@ ulong fd_secp256k1_signature_offsets_size(fd_secp256k1_signature_offsets_t const
 
 void fd_sol_sysvar_clock_new(fd_sol_sysvar_clock_t* self);
 int fd_sol_sysvar_clock_decode(fd_sol_sysvar_clock_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_sol_sysvar_clock_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_sol_sysvar_clock_encode(fd_sol_sysvar_clock_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_sol_sysvar_clock_destroy(fd_sol_sysvar_clock_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_sol_sysvar_clock_walk(fd_sol_sysvar_clock_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1703,6 +1746,7 @@ ulong fd_sol_sysvar_clock_size(fd_sol_sysvar_clock_t const * self);
 
 void fd_vote_lockout_new(fd_vote_lockout_t* self);
 int fd_vote_lockout_decode(fd_vote_lockout_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_lockout_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_lockout_encode(fd_vote_lockout_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_lockout_destroy(fd_vote_lockout_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_lockout_walk(fd_vote_lockout_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1710,6 +1754,7 @@ ulong fd_vote_lockout_size(fd_vote_lockout_t const * self);
 
 void fd_compact_vote_lockout_new(fd_compact_vote_lockout_t* self);
 int fd_compact_vote_lockout_decode(fd_compact_vote_lockout_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_compact_vote_lockout_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_compact_vote_lockout_encode(fd_compact_vote_lockout_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_compact_vote_lockout_destroy(fd_compact_vote_lockout_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_compact_vote_lockout_walk(fd_compact_vote_lockout_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1717,6 +1762,7 @@ ulong fd_compact_vote_lockout_size(fd_compact_vote_lockout_t const * self);
 
 void fd_vote_authorized_voter_new(fd_vote_authorized_voter_t* self);
 int fd_vote_authorized_voter_decode(fd_vote_authorized_voter_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_authorized_voter_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_authorized_voter_encode(fd_vote_authorized_voter_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_authorized_voter_destroy(fd_vote_authorized_voter_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_authorized_voter_walk(fd_vote_authorized_voter_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1724,6 +1770,7 @@ ulong fd_vote_authorized_voter_size(fd_vote_authorized_voter_t const * self);
 
 void fd_vote_prior_voter_new(fd_vote_prior_voter_t* self);
 int fd_vote_prior_voter_decode(fd_vote_prior_voter_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_prior_voter_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_prior_voter_encode(fd_vote_prior_voter_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_prior_voter_destroy(fd_vote_prior_voter_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_prior_voter_walk(fd_vote_prior_voter_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1731,6 +1778,7 @@ ulong fd_vote_prior_voter_size(fd_vote_prior_voter_t const * self);
 
 void fd_vote_prior_voter_0_23_5_new(fd_vote_prior_voter_0_23_5_t* self);
 int fd_vote_prior_voter_0_23_5_decode(fd_vote_prior_voter_0_23_5_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_prior_voter_0_23_5_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_prior_voter_0_23_5_encode(fd_vote_prior_voter_0_23_5_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_prior_voter_0_23_5_destroy(fd_vote_prior_voter_0_23_5_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_prior_voter_0_23_5_walk(fd_vote_prior_voter_0_23_5_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1738,6 +1786,7 @@ ulong fd_vote_prior_voter_0_23_5_size(fd_vote_prior_voter_0_23_5_t const * self)
 
 void fd_vote_epoch_credits_new(fd_vote_epoch_credits_t* self);
 int fd_vote_epoch_credits_decode(fd_vote_epoch_credits_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_epoch_credits_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_epoch_credits_encode(fd_vote_epoch_credits_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_epoch_credits_destroy(fd_vote_epoch_credits_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_epoch_credits_walk(fd_vote_epoch_credits_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1745,6 +1794,7 @@ ulong fd_vote_epoch_credits_size(fd_vote_epoch_credits_t const * self);
 
 void fd_vote_historical_authorized_voter_new(fd_vote_historical_authorized_voter_t* self);
 int fd_vote_historical_authorized_voter_decode(fd_vote_historical_authorized_voter_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_historical_authorized_voter_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_historical_authorized_voter_encode(fd_vote_historical_authorized_voter_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_historical_authorized_voter_destroy(fd_vote_historical_authorized_voter_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_historical_authorized_voter_walk(fd_vote_historical_authorized_voter_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1752,6 +1802,7 @@ ulong fd_vote_historical_authorized_voter_size(fd_vote_historical_authorized_vot
 
 void fd_vote_block_timestamp_new(fd_vote_block_timestamp_t* self);
 int fd_vote_block_timestamp_decode(fd_vote_block_timestamp_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_block_timestamp_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_block_timestamp_encode(fd_vote_block_timestamp_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_block_timestamp_destroy(fd_vote_block_timestamp_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_block_timestamp_walk(fd_vote_block_timestamp_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1759,6 +1810,7 @@ ulong fd_vote_block_timestamp_size(fd_vote_block_timestamp_t const * self);
 
 void fd_vote_prior_voters_new(fd_vote_prior_voters_t* self);
 int fd_vote_prior_voters_decode(fd_vote_prior_voters_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_prior_voters_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_prior_voters_encode(fd_vote_prior_voters_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_prior_voters_destroy(fd_vote_prior_voters_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_prior_voters_walk(fd_vote_prior_voters_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1766,6 +1818,7 @@ ulong fd_vote_prior_voters_size(fd_vote_prior_voters_t const * self);
 
 void fd_vote_prior_voters_0_23_5_new(fd_vote_prior_voters_0_23_5_t* self);
 int fd_vote_prior_voters_0_23_5_decode(fd_vote_prior_voters_0_23_5_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_prior_voters_0_23_5_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_prior_voters_0_23_5_encode(fd_vote_prior_voters_0_23_5_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_prior_voters_0_23_5_destroy(fd_vote_prior_voters_0_23_5_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_prior_voters_0_23_5_walk(fd_vote_prior_voters_0_23_5_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1773,6 +1826,7 @@ ulong fd_vote_prior_voters_0_23_5_size(fd_vote_prior_voters_0_23_5_t const * sel
 
 void fd_vote_state_0_23_5_new(fd_vote_state_0_23_5_t* self);
 int fd_vote_state_0_23_5_decode(fd_vote_state_0_23_5_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_state_0_23_5_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_state_0_23_5_encode(fd_vote_state_0_23_5_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_state_0_23_5_destroy(fd_vote_state_0_23_5_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_state_0_23_5_walk(fd_vote_state_0_23_5_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1780,6 +1834,7 @@ ulong fd_vote_state_0_23_5_size(fd_vote_state_0_23_5_t const * self);
 
 void fd_vote_state_new(fd_vote_state_t* self);
 int fd_vote_state_decode(fd_vote_state_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_state_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_state_encode(fd_vote_state_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_state_destroy(fd_vote_state_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_state_walk(fd_vote_state_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1787,6 +1842,7 @@ ulong fd_vote_state_size(fd_vote_state_t const * self);
 
 void fd_vote_state_versioned_new(fd_vote_state_versioned_t* self);
 int fd_vote_state_versioned_decode(fd_vote_state_versioned_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_state_versioned_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_state_versioned_encode(fd_vote_state_versioned_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_state_versioned_destroy(fd_vote_state_versioned_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_state_versioned_walk(fd_vote_state_versioned_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1800,6 +1856,7 @@ fd_vote_state_versioned_enum_current = 1,
 }; 
 void fd_vote_state_update_new(fd_vote_state_update_t* self);
 int fd_vote_state_update_decode(fd_vote_state_update_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_state_update_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_state_update_encode(fd_vote_state_update_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_state_update_destroy(fd_vote_state_update_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_state_update_walk(fd_vote_state_update_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1807,6 +1864,7 @@ ulong fd_vote_state_update_size(fd_vote_state_update_t const * self);
 
 void fd_compact_vote_state_update_new(fd_compact_vote_state_update_t* self);
 int fd_compact_vote_state_update_decode(fd_compact_vote_state_update_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_compact_vote_state_update_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_compact_vote_state_update_encode(fd_compact_vote_state_update_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_compact_vote_state_update_destroy(fd_compact_vote_state_update_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_compact_vote_state_update_walk(fd_compact_vote_state_update_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1814,6 +1872,7 @@ ulong fd_compact_vote_state_update_size(fd_compact_vote_state_update_t const * s
 
 void fd_compact_vote_state_update_switch_new(fd_compact_vote_state_update_switch_t* self);
 int fd_compact_vote_state_update_switch_decode(fd_compact_vote_state_update_switch_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_compact_vote_state_update_switch_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_compact_vote_state_update_switch_encode(fd_compact_vote_state_update_switch_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_compact_vote_state_update_switch_destroy(fd_compact_vote_state_update_switch_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_compact_vote_state_update_switch_walk(fd_compact_vote_state_update_switch_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1821,6 +1880,7 @@ ulong fd_compact_vote_state_update_switch_size(fd_compact_vote_state_update_swit
 
 void fd_slot_history_inner_new(fd_slot_history_inner_t* self);
 int fd_slot_history_inner_decode(fd_slot_history_inner_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_slot_history_inner_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_slot_history_inner_encode(fd_slot_history_inner_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_slot_history_inner_destroy(fd_slot_history_inner_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_slot_history_inner_walk(fd_slot_history_inner_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1828,6 +1888,7 @@ ulong fd_slot_history_inner_size(fd_slot_history_inner_t const * self);
 
 void fd_slot_history_bitvec_new(fd_slot_history_bitvec_t* self);
 int fd_slot_history_bitvec_decode(fd_slot_history_bitvec_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_slot_history_bitvec_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_slot_history_bitvec_encode(fd_slot_history_bitvec_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_slot_history_bitvec_destroy(fd_slot_history_bitvec_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_slot_history_bitvec_walk(fd_slot_history_bitvec_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1835,6 +1896,7 @@ ulong fd_slot_history_bitvec_size(fd_slot_history_bitvec_t const * self);
 
 void fd_slot_history_new(fd_slot_history_t* self);
 int fd_slot_history_decode(fd_slot_history_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_slot_history_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_slot_history_encode(fd_slot_history_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_slot_history_destroy(fd_slot_history_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_slot_history_walk(fd_slot_history_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1842,6 +1904,7 @@ ulong fd_slot_history_size(fd_slot_history_t const * self);
 
 void fd_slot_hash_new(fd_slot_hash_t* self);
 int fd_slot_hash_decode(fd_slot_hash_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_slot_hash_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_slot_hash_encode(fd_slot_hash_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_slot_hash_destroy(fd_slot_hash_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_slot_hash_walk(fd_slot_hash_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1849,6 +1912,7 @@ ulong fd_slot_hash_size(fd_slot_hash_t const * self);
 
 void fd_slot_hashes_new(fd_slot_hashes_t* self);
 int fd_slot_hashes_decode(fd_slot_hashes_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_slot_hashes_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_slot_hashes_encode(fd_slot_hashes_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_slot_hashes_destroy(fd_slot_hashes_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_slot_hashes_walk(fd_slot_hashes_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1856,6 +1920,7 @@ ulong fd_slot_hashes_size(fd_slot_hashes_t const * self);
 
 void fd_block_block_hash_entry_new(fd_block_block_hash_entry_t* self);
 int fd_block_block_hash_entry_decode(fd_block_block_hash_entry_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_block_block_hash_entry_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_block_block_hash_entry_encode(fd_block_block_hash_entry_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_block_block_hash_entry_destroy(fd_block_block_hash_entry_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_block_block_hash_entry_walk(fd_block_block_hash_entry_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1863,6 +1928,7 @@ ulong fd_block_block_hash_entry_size(fd_block_block_hash_entry_t const * self);
 
 void fd_recent_block_hashes_new(fd_recent_block_hashes_t* self);
 int fd_recent_block_hashes_decode(fd_recent_block_hashes_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_recent_block_hashes_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_recent_block_hashes_encode(fd_recent_block_hashes_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_recent_block_hashes_destroy(fd_recent_block_hashes_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_recent_block_hashes_walk(fd_recent_block_hashes_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1870,6 +1936,7 @@ ulong fd_recent_block_hashes_size(fd_recent_block_hashes_t const * self);
 
 void fd_slot_meta_new(fd_slot_meta_t* self);
 int fd_slot_meta_decode(fd_slot_meta_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_slot_meta_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_slot_meta_encode(fd_slot_meta_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_slot_meta_destroy(fd_slot_meta_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_slot_meta_walk(fd_slot_meta_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1877,6 +1944,7 @@ ulong fd_slot_meta_size(fd_slot_meta_t const * self);
 
 void fd_slot_meta_meta_new(fd_slot_meta_meta_t* self);
 int fd_slot_meta_meta_decode(fd_slot_meta_meta_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_slot_meta_meta_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_slot_meta_meta_encode(fd_slot_meta_meta_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_slot_meta_meta_destroy(fd_slot_meta_meta_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_slot_meta_meta_walk(fd_slot_meta_meta_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1884,6 +1952,7 @@ ulong fd_slot_meta_meta_size(fd_slot_meta_meta_t const * self);
 
 void fd_clock_timestamp_vote_new(fd_clock_timestamp_vote_t* self);
 int fd_clock_timestamp_vote_decode(fd_clock_timestamp_vote_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_clock_timestamp_vote_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_clock_timestamp_vote_encode(fd_clock_timestamp_vote_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_clock_timestamp_vote_destroy(fd_clock_timestamp_vote_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_clock_timestamp_vote_walk(fd_clock_timestamp_vote_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1891,6 +1960,7 @@ ulong fd_clock_timestamp_vote_size(fd_clock_timestamp_vote_t const * self);
 
 void fd_clock_timestamp_votes_new(fd_clock_timestamp_votes_t* self);
 int fd_clock_timestamp_votes_decode(fd_clock_timestamp_votes_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_clock_timestamp_votes_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_clock_timestamp_votes_encode(fd_clock_timestamp_votes_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_clock_timestamp_votes_destroy(fd_clock_timestamp_votes_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_clock_timestamp_votes_walk(fd_clock_timestamp_votes_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1898,6 +1968,7 @@ ulong fd_clock_timestamp_votes_size(fd_clock_timestamp_votes_t const * self);
 
 void fd_sysvar_fees_new(fd_sysvar_fees_t* self);
 int fd_sysvar_fees_decode(fd_sysvar_fees_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_sysvar_fees_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_sysvar_fees_encode(fd_sysvar_fees_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_sysvar_fees_destroy(fd_sysvar_fees_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_sysvar_fees_walk(fd_sysvar_fees_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1905,6 +1976,7 @@ ulong fd_sysvar_fees_size(fd_sysvar_fees_t const * self);
 
 void fd_config_keys_pair_new(fd_config_keys_pair_t* self);
 int fd_config_keys_pair_decode(fd_config_keys_pair_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_config_keys_pair_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_config_keys_pair_encode(fd_config_keys_pair_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_config_keys_pair_destroy(fd_config_keys_pair_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_config_keys_pair_walk(fd_config_keys_pair_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1912,6 +1984,7 @@ ulong fd_config_keys_pair_size(fd_config_keys_pair_t const * self);
 
 void fd_stake_config_new(fd_stake_config_t* self);
 int fd_stake_config_decode(fd_stake_config_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_config_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_config_encode(fd_stake_config_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_config_destroy(fd_stake_config_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_config_walk(fd_stake_config_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1919,6 +1992,7 @@ ulong fd_stake_config_size(fd_stake_config_t const * self);
 
 void fd_firedancer_banks_new(fd_firedancer_banks_t* self);
 int fd_firedancer_banks_decode(fd_firedancer_banks_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_firedancer_banks_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_firedancer_banks_encode(fd_firedancer_banks_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_firedancer_banks_destroy(fd_firedancer_banks_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_firedancer_banks_walk(fd_firedancer_banks_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1926,6 +2000,7 @@ ulong fd_firedancer_banks_size(fd_firedancer_banks_t const * self);
 
 void fd_vote_new(fd_vote_t* self);
 int fd_vote_decode(fd_vote_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_encode(fd_vote_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_destroy(fd_vote_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_walk(fd_vote_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1933,6 +2008,7 @@ ulong fd_vote_size(fd_vote_t const * self);
 
 void fd_vote_init_new(fd_vote_init_t* self);
 int fd_vote_init_decode(fd_vote_init_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_init_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_init_encode(fd_vote_init_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_init_destroy(fd_vote_init_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_init_walk(fd_vote_init_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1940,6 +2016,7 @@ ulong fd_vote_init_size(fd_vote_init_t const * self);
 
 void fd_vote_authorize_new(fd_vote_authorize_t* self);
 int fd_vote_authorize_decode(fd_vote_authorize_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_authorize_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_authorize_encode(fd_vote_authorize_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_authorize_destroy(fd_vote_authorize_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_authorize_walk(fd_vote_authorize_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1953,6 +2030,7 @@ fd_vote_authorize_enum_withdrawer = 1,
 }; 
 void fd_vote_authorize_pubkey_new(fd_vote_authorize_pubkey_t* self);
 int fd_vote_authorize_pubkey_decode(fd_vote_authorize_pubkey_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_authorize_pubkey_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_authorize_pubkey_encode(fd_vote_authorize_pubkey_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_authorize_pubkey_destroy(fd_vote_authorize_pubkey_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_authorize_pubkey_walk(fd_vote_authorize_pubkey_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1960,6 +2038,7 @@ ulong fd_vote_authorize_pubkey_size(fd_vote_authorize_pubkey_t const * self);
 
 void fd_vote_switch_new(fd_vote_switch_t* self);
 int fd_vote_switch_decode(fd_vote_switch_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_switch_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_switch_encode(fd_vote_switch_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_switch_destroy(fd_vote_switch_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_switch_walk(fd_vote_switch_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1967,6 +2046,7 @@ ulong fd_vote_switch_size(fd_vote_switch_t const * self);
 
 void fd_update_vote_state_switch_new(fd_update_vote_state_switch_t* self);
 int fd_update_vote_state_switch_decode(fd_update_vote_state_switch_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_update_vote_state_switch_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_update_vote_state_switch_encode(fd_update_vote_state_switch_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_update_vote_state_switch_destroy(fd_update_vote_state_switch_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_update_vote_state_switch_walk(fd_update_vote_state_switch_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1974,6 +2054,7 @@ ulong fd_update_vote_state_switch_size(fd_update_vote_state_switch_t const * sel
 
 void fd_vote_authorize_with_seed_args_new(fd_vote_authorize_with_seed_args_t* self);
 int fd_vote_authorize_with_seed_args_decode(fd_vote_authorize_with_seed_args_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_authorize_with_seed_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_authorize_with_seed_args_encode(fd_vote_authorize_with_seed_args_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_authorize_with_seed_args_destroy(fd_vote_authorize_with_seed_args_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_authorize_with_seed_args_walk(fd_vote_authorize_with_seed_args_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1981,6 +2062,7 @@ ulong fd_vote_authorize_with_seed_args_size(fd_vote_authorize_with_seed_args_t c
 
 void fd_vote_authorize_checked_with_seed_args_new(fd_vote_authorize_checked_with_seed_args_t* self);
 int fd_vote_authorize_checked_with_seed_args_decode(fd_vote_authorize_checked_with_seed_args_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_authorize_checked_with_seed_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_authorize_checked_with_seed_args_encode(fd_vote_authorize_checked_with_seed_args_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_authorize_checked_with_seed_args_destroy(fd_vote_authorize_checked_with_seed_args_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_authorize_checked_with_seed_args_walk(fd_vote_authorize_checked_with_seed_args_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -1988,6 +2070,7 @@ ulong fd_vote_authorize_checked_with_seed_args_size(fd_vote_authorize_checked_wi
 
 void fd_vote_instruction_new(fd_vote_instruction_t* self);
 int fd_vote_instruction_decode(fd_vote_instruction_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_vote_instruction_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_vote_instruction_encode(fd_vote_instruction_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_vote_instruction_destroy(fd_vote_instruction_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_vote_instruction_walk(fd_vote_instruction_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2025,6 +2108,7 @@ fd_vote_instruction_enum_compact_update_vote_state_switch = 13,
 }; 
 void fd_system_program_instruction_create_account_new(fd_system_program_instruction_create_account_t* self);
 int fd_system_program_instruction_create_account_decode(fd_system_program_instruction_create_account_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_system_program_instruction_create_account_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_system_program_instruction_create_account_encode(fd_system_program_instruction_create_account_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_system_program_instruction_create_account_destroy(fd_system_program_instruction_create_account_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_system_program_instruction_create_account_walk(fd_system_program_instruction_create_account_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2032,6 +2116,7 @@ ulong fd_system_program_instruction_create_account_size(fd_system_program_instru
 
 void fd_system_program_instruction_create_account_with_seed_new(fd_system_program_instruction_create_account_with_seed_t* self);
 int fd_system_program_instruction_create_account_with_seed_decode(fd_system_program_instruction_create_account_with_seed_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_system_program_instruction_create_account_with_seed_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_system_program_instruction_create_account_with_seed_encode(fd_system_program_instruction_create_account_with_seed_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_system_program_instruction_create_account_with_seed_destroy(fd_system_program_instruction_create_account_with_seed_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_system_program_instruction_create_account_with_seed_walk(fd_system_program_instruction_create_account_with_seed_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2039,6 +2124,7 @@ ulong fd_system_program_instruction_create_account_with_seed_size(fd_system_prog
 
 void fd_system_program_instruction_allocate_with_seed_new(fd_system_program_instruction_allocate_with_seed_t* self);
 int fd_system_program_instruction_allocate_with_seed_decode(fd_system_program_instruction_allocate_with_seed_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_system_program_instruction_allocate_with_seed_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_system_program_instruction_allocate_with_seed_encode(fd_system_program_instruction_allocate_with_seed_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_system_program_instruction_allocate_with_seed_destroy(fd_system_program_instruction_allocate_with_seed_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_system_program_instruction_allocate_with_seed_walk(fd_system_program_instruction_allocate_with_seed_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2046,6 +2132,7 @@ ulong fd_system_program_instruction_allocate_with_seed_size(fd_system_program_in
 
 void fd_system_program_instruction_assign_with_seed_new(fd_system_program_instruction_assign_with_seed_t* self);
 int fd_system_program_instruction_assign_with_seed_decode(fd_system_program_instruction_assign_with_seed_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_system_program_instruction_assign_with_seed_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_system_program_instruction_assign_with_seed_encode(fd_system_program_instruction_assign_with_seed_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_system_program_instruction_assign_with_seed_destroy(fd_system_program_instruction_assign_with_seed_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_system_program_instruction_assign_with_seed_walk(fd_system_program_instruction_assign_with_seed_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2053,6 +2140,7 @@ ulong fd_system_program_instruction_assign_with_seed_size(fd_system_program_inst
 
 void fd_system_program_instruction_transfer_with_seed_new(fd_system_program_instruction_transfer_with_seed_t* self);
 int fd_system_program_instruction_transfer_with_seed_decode(fd_system_program_instruction_transfer_with_seed_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_system_program_instruction_transfer_with_seed_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_system_program_instruction_transfer_with_seed_encode(fd_system_program_instruction_transfer_with_seed_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_system_program_instruction_transfer_with_seed_destroy(fd_system_program_instruction_transfer_with_seed_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_system_program_instruction_transfer_with_seed_walk(fd_system_program_instruction_transfer_with_seed_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2060,6 +2148,7 @@ ulong fd_system_program_instruction_transfer_with_seed_size(fd_system_program_in
 
 void fd_system_program_instruction_new(fd_system_program_instruction_t* self);
 int fd_system_program_instruction_decode(fd_system_program_instruction_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_system_program_instruction_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_system_program_instruction_encode(fd_system_program_instruction_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_system_program_instruction_destroy(fd_system_program_instruction_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_system_program_instruction_walk(fd_system_program_instruction_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2095,6 +2184,7 @@ fd_system_program_instruction_enum_upgrade_nonce_account = 12,
 }; 
 void fd_system_error_new(fd_system_error_t* self);
 int fd_system_error_decode(fd_system_error_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_system_error_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_system_error_encode(fd_system_error_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_system_error_destroy(fd_system_error_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_system_error_walk(fd_system_error_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2122,6 +2212,7 @@ fd_system_error_enum_nonce_unexpected_blockhash_value = 8,
 }; 
 void fd_stake_authorized_new(fd_stake_authorized_t* self);
 int fd_stake_authorized_decode(fd_stake_authorized_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_authorized_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_authorized_encode(fd_stake_authorized_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_authorized_destroy(fd_stake_authorized_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_authorized_walk(fd_stake_authorized_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2129,6 +2220,7 @@ ulong fd_stake_authorized_size(fd_stake_authorized_t const * self);
 
 void fd_stake_lockup_new(fd_stake_lockup_t* self);
 int fd_stake_lockup_decode(fd_stake_lockup_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_lockup_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_lockup_encode(fd_stake_lockup_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_lockup_destroy(fd_stake_lockup_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_lockup_walk(fd_stake_lockup_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2136,6 +2228,7 @@ ulong fd_stake_lockup_size(fd_stake_lockup_t const * self);
 
 void fd_stake_instruction_initialize_new(fd_stake_instruction_initialize_t* self);
 int fd_stake_instruction_initialize_decode(fd_stake_instruction_initialize_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_instruction_initialize_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_instruction_initialize_encode(fd_stake_instruction_initialize_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_instruction_initialize_destroy(fd_stake_instruction_initialize_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_instruction_initialize_walk(fd_stake_instruction_initialize_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2143,6 +2236,7 @@ ulong fd_stake_instruction_initialize_size(fd_stake_instruction_initialize_t con
 
 void fd_stake_authorize_new(fd_stake_authorize_t* self);
 int fd_stake_authorize_decode(fd_stake_authorize_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_authorize_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_authorize_encode(fd_stake_authorize_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_authorize_destroy(fd_stake_authorize_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_authorize_walk(fd_stake_authorize_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2156,6 +2250,7 @@ fd_stake_authorize_enum_withdrawer = 1,
 }; 
 void fd_stake_instruction_authorize_new(fd_stake_instruction_authorize_t* self);
 int fd_stake_instruction_authorize_decode(fd_stake_instruction_authorize_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_instruction_authorize_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_instruction_authorize_encode(fd_stake_instruction_authorize_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_instruction_authorize_destroy(fd_stake_instruction_authorize_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_instruction_authorize_walk(fd_stake_instruction_authorize_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2163,6 +2258,7 @@ ulong fd_stake_instruction_authorize_size(fd_stake_instruction_authorize_t const
 
 void fd_lockup_args_new(fd_lockup_args_t* self);
 int fd_lockup_args_decode(fd_lockup_args_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_lockup_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_lockup_args_encode(fd_lockup_args_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_lockup_args_destroy(fd_lockup_args_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_lockup_args_walk(fd_lockup_args_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2170,6 +2266,7 @@ ulong fd_lockup_args_size(fd_lockup_args_t const * self);
 
 void fd_authorize_with_seed_args_new(fd_authorize_with_seed_args_t* self);
 int fd_authorize_with_seed_args_decode(fd_authorize_with_seed_args_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_authorize_with_seed_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_authorize_with_seed_args_encode(fd_authorize_with_seed_args_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_authorize_with_seed_args_destroy(fd_authorize_with_seed_args_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_authorize_with_seed_args_walk(fd_authorize_with_seed_args_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2177,6 +2274,7 @@ ulong fd_authorize_with_seed_args_size(fd_authorize_with_seed_args_t const * sel
 
 void fd_authorize_checked_with_seed_args_new(fd_authorize_checked_with_seed_args_t* self);
 int fd_authorize_checked_with_seed_args_decode(fd_authorize_checked_with_seed_args_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_authorize_checked_with_seed_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_authorize_checked_with_seed_args_encode(fd_authorize_checked_with_seed_args_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_authorize_checked_with_seed_args_destroy(fd_authorize_checked_with_seed_args_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_authorize_checked_with_seed_args_walk(fd_authorize_checked_with_seed_args_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2184,6 +2282,7 @@ ulong fd_authorize_checked_with_seed_args_size(fd_authorize_checked_with_seed_ar
 
 void fd_lockup_checked_args_new(fd_lockup_checked_args_t* self);
 int fd_lockup_checked_args_decode(fd_lockup_checked_args_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_lockup_checked_args_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_lockup_checked_args_encode(fd_lockup_checked_args_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_lockup_checked_args_destroy(fd_lockup_checked_args_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_lockup_checked_args_walk(fd_lockup_checked_args_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2191,6 +2290,7 @@ ulong fd_lockup_checked_args_size(fd_lockup_checked_args_t const * self);
 
 void fd_stake_instruction_new(fd_stake_instruction_t* self);
 int fd_stake_instruction_decode(fd_stake_instruction_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_instruction_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_instruction_encode(fd_stake_instruction_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_instruction_destroy(fd_stake_instruction_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_instruction_walk(fd_stake_instruction_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2226,6 +2326,7 @@ fd_stake_instruction_enum_set_lockup_checked = 12,
 }; 
 void fd_stake_state_meta_new(fd_stake_state_meta_t* self);
 int fd_stake_state_meta_decode(fd_stake_state_meta_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_state_meta_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_state_meta_encode(fd_stake_state_meta_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_state_meta_destroy(fd_stake_state_meta_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_state_meta_walk(fd_stake_state_meta_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2233,6 +2334,7 @@ ulong fd_stake_state_meta_size(fd_stake_state_meta_t const * self);
 
 void fd_stake_new(fd_stake_t* self);
 int fd_stake_decode(fd_stake_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_encode(fd_stake_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_destroy(fd_stake_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_walk(fd_stake_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2240,6 +2342,7 @@ ulong fd_stake_size(fd_stake_t const * self);
 
 void fd_stake_state_stake_new(fd_stake_state_stake_t* self);
 int fd_stake_state_stake_decode(fd_stake_state_stake_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_state_stake_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_state_stake_encode(fd_stake_state_stake_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_state_stake_destroy(fd_stake_state_stake_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_state_stake_walk(fd_stake_state_stake_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2247,6 +2350,7 @@ ulong fd_stake_state_stake_size(fd_stake_state_stake_t const * self);
 
 void fd_stake_state_new(fd_stake_state_t* self);
 int fd_stake_state_decode(fd_stake_state_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_stake_state_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_stake_state_encode(fd_stake_state_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_stake_state_destroy(fd_stake_state_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_stake_state_walk(fd_stake_state_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2264,6 +2368,7 @@ fd_stake_state_enum_rewards_pool = 3,
 }; 
 void fd_nonce_data_new(fd_nonce_data_t* self);
 int fd_nonce_data_decode(fd_nonce_data_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_nonce_data_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_nonce_data_encode(fd_nonce_data_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_nonce_data_destroy(fd_nonce_data_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_nonce_data_walk(fd_nonce_data_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2271,6 +2376,7 @@ ulong fd_nonce_data_size(fd_nonce_data_t const * self);
 
 void fd_nonce_state_new(fd_nonce_state_t* self);
 int fd_nonce_state_decode(fd_nonce_state_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_nonce_state_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_nonce_state_encode(fd_nonce_state_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_nonce_state_destroy(fd_nonce_state_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_nonce_state_walk(fd_nonce_state_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2284,6 +2390,7 @@ fd_nonce_state_enum_initialized = 1,
 }; 
 void fd_nonce_state_versions_new(fd_nonce_state_versions_t* self);
 int fd_nonce_state_versions_decode(fd_nonce_state_versions_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_nonce_state_versions_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_nonce_state_versions_encode(fd_nonce_state_versions_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_nonce_state_versions_destroy(fd_nonce_state_versions_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_nonce_state_versions_walk(fd_nonce_state_versions_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2297,6 +2404,7 @@ fd_nonce_state_versions_enum_current = 1,
 }; 
 void fd_compute_budget_program_instruction_request_units_deprecated_new(fd_compute_budget_program_instruction_request_units_deprecated_t* self);
 int fd_compute_budget_program_instruction_request_units_deprecated_decode(fd_compute_budget_program_instruction_request_units_deprecated_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_compute_budget_program_instruction_request_units_deprecated_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_compute_budget_program_instruction_request_units_deprecated_encode(fd_compute_budget_program_instruction_request_units_deprecated_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_compute_budget_program_instruction_request_units_deprecated_destroy(fd_compute_budget_program_instruction_request_units_deprecated_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_compute_budget_program_instruction_request_units_deprecated_walk(fd_compute_budget_program_instruction_request_units_deprecated_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2304,6 +2412,7 @@ ulong fd_compute_budget_program_instruction_request_units_deprecated_size(fd_com
 
 void fd_compute_budget_program_instruction_new(fd_compute_budget_program_instruction_t* self);
 int fd_compute_budget_program_instruction_decode(fd_compute_budget_program_instruction_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_compute_budget_program_instruction_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_compute_budget_program_instruction_encode(fd_compute_budget_program_instruction_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_compute_budget_program_instruction_destroy(fd_compute_budget_program_instruction_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_compute_budget_program_instruction_walk(fd_compute_budget_program_instruction_t* self, fd_walk_fun_t fun, const char *name, int level);
@@ -2321,6 +2430,7 @@ fd_compute_budget_program_instruction_enum_set_compute_unit_price = 3,
 }; 
 void fd_config_keys_new(fd_config_keys_t* self);
 int fd_config_keys_decode(fd_config_keys_t* self, fd_bincode_decode_ctx_t * ctx);
+int fd_config_keys_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);
 int fd_config_keys_encode(fd_config_keys_t const * self, fd_bincode_encode_ctx_t * ctx);
 void fd_config_keys_destroy(fd_config_keys_t* self, fd_bincode_destroy_ctx_t * ctx);
 void fd_config_keys_walk(fd_config_keys_t* self, fd_walk_fun_t fun, const char *name, int level);
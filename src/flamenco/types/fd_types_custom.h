@@ -34,6 +34,11 @@ int fd_hash_decode(fd_hash_t* self, fd_bincode_decode_ctx_t * ctx) {
   return fd_bincode_bytes_decode(&self->hash[0], sizeof(self->hash), ctx);
 }
 
+static inline
+int fd_hash_decode_footprint(fd_bincode_decode_ctx_t * ctx, FD_FN_UNUSED ulong * total_sz) {
+  return fd_bincode_skip_decode(sizeof(fd_hash_t), ctx);
+}
+
 static inline
 void fd_hash_destroy(FD_FN_UNUSED fd_hash_t const * self, FD_FN_UNUSED fd_bincode_destroy_ctx_t * ctx) {
 }
@@ -58,6 +63,7 @@ void fd_hash_walk(FD_FN_UNUSED fd_hash_t* self, FD_FN_UNUSED fd_walk_fun_t fun,
 
 #define fd_pubkey_new(_x)                fd_hash_new(_x)
 #define fd_pubkey_decode(_x,_y)          fd_hash_decode(_x, _y)
+#define fd_pubkey_decode_footprint(_x, _y) fd_hash_decode_footprint(_x, _y)
 #define fd_pubkey_encode(_x, _y)         fd_hash_encode(_x, _y)
 #define fd_pubkey_destroy(_x, _y)        fd_hash_destroy(_x, _y)
 #define fd_pubkey_size(_x)               fd_hash_size(_x)
@@ -20,13 +20,21 @@ for extra in json_object["extra_header"]:
 print("", file=header)
 
 print("#include \"" + sys.argv[1] + "\"", file=body)
-
+print("", file=body)
+print("/* FIXME: Temporary scaffolding */", file=body)
+print("#pragma GCC diagnostic push", file=body)
 print("#pragma GCC diagnostic ignored \"-Wunused-parameter\"", file=body)
 print("#pragma GCC diagnostic ignored \"-Wunused-variable\"", file=body)
+print("#if FD_USING_GCC==1 /* Clang doesn't understand these options */", file=body)
+print("#pragma GCC diagnostic ignored \"-Wsuggest-attribute=const\"", file=body)
+print("#pragma GCC diagnostic ignored \"-Wsuggest-attribute=pure\"", file=body)
+print("#endif", file=body)
+print("", file=body)
 
 print("#ifdef _DISABLE_OPTIMIZATION", file=body)
 print("#pragma GCC optimize (\"O0\")", file=body)
 print("#endif", file=body)
+print("", file=body)
 
 type_map = {
     "int64_t": "long",
@@ -286,6 +294,145 @@ fields_body_decode = {
     "map" :               lambda n, f: do_map_body_decode(n, f),
 }
 
+# decode_footprint
+
+def is_uchar(e):
+    return e == "unsigned char" or e == "uchar"
+
+def is_ulong(e):
+    return e == "ulong" or e == "unsigned long"
+
+def is_uint(e):
+    return e == "uint" or e == "unsigned int"
+
+def do_len_footprint(n, f):
+    if "modifier" in f and f["modifier"] == "compact":
+        print("  ushort " + f["name"] + "_len;", file=body)
+        print("  err = fd_bincode_compact_u16_decode(&" + f["name"] + "_len, ctx);", file=body)
+    else:
+        print("  ulong " + f["name"] + "_len;", file=body)
+        print("  err = fd_bincode_uint64_decode(&" + f["name"] + "_len, ctx);", file=body)
+    print("  if ( FD_UNLIKELY(err) ) return err;", file=body)
+    print("  err = fd_bincode_len_check(" + f["name"] + "_len, ctx);", file=body)
+    print("  if ( FD_UNLIKELY(err) ) return err;", file=body)
+
+def do_elems_footprint(n, f, cnt, indent):
+    if is_uchar(f["element"]):
+        print(indent + "err = fd_bincode_skip_decode(" + cnt + ", ctx);", file=body)
+    elif is_ulong(f["element"]):
+        print(indent + "err = fd_bincode_skip_decode(sizeof(ulong)*" + cnt + ", ctx);", file=body)
+    elif is_uint(f["element"]):
+        print(indent + "err = fd_bincode_skip_decode(sizeof(uint)*" + cnt + ", ctx);", file=body)
+    else:
+        print(indent + "for (ulong i = 0; i < " + cnt + "; ++i) {", file=body)
+        print(indent + "  err = " + n + "_" + f["element"] + "_decode_footprint(ctx, total_sz);", file=body)
+        print(indent + "  if ( FD_UNLIKELY(err) ) return err;", file=body)
+        print(indent + "}", file=body)
+        return
+    print(indent + "if ( FD_UNLIKELY(err) ) return err;", file=body)
+
+def do_vector_body_decode_footprint(n, f):
+    do_len_footprint(n, f)
+    print("  if (" + f["name"] + "_len != 0) {", file=body)
+    if is_uchar(f["element"]):
+        print("    err = fd_bincode_footprint_alloc(total_sz, 8UL, 1UL, " + f["name"] + "_len);", file=body)
+    elif is_ulong(f["element"]):
+        print("    err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), " + f["name"] + "_len);", file=body)
+    elif is_uint(f["element"]):
+        print("    err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(uint), " + f["name"] + "_len);", file=body)
+    else:
+        el = (n + "_" + f["element"]).upper()
+        print("    err = fd_bincode_footprint_alloc(total_sz, " + el + "_ALIGN, " + el + "_FOOTPRINT, " + f["name"] + "_len);", file=body)
+    print("    if ( FD_UNLIKELY(err) ) return err;", file=body)
+    do_elems_footprint(n, f, f["name"] + "_len", "    ")
+    print("  }", file=body)
+
+def do_deque_body_decode_footprint(n, f):
+    print("  err = fd_bincode_footprint_alloc(total_sz, " + deque_prefix(n, f) + "_align(), " + deque_prefix(n, f) + "_footprint(), 1UL);", file=body)
+    print("  if ( FD_UNLIKELY(err) ) return err;", file=body)
+    do_len_footprint(n, f)
+    print("  if ( " + f["name"] + "_len > " + str(deque_max[deque_elem_type(n, f)]) + "UL ) return FD_BINCODE_ERR_SMALL_DEQUE;", file=body)
+    do_elems_footprint(n, f, f["name"] + "_len", "  ")
+
+def do_map_body_decode_footprint(n, f):
+    mapname = deque_elem_type(n, f) + "_map"
+    do_len_footprint(n, f)
+    print("  err = fd_bincode_footprint_alloc(total_sz, " + mapname + "_align(), " + mapname + "_footprint(" + f["name"] + "_len), 1UL);", file=body)
+    print("  if ( FD_UNLIKELY(err) ) return err;", file=body)
+    print("  for (ulong i = 0; i < " + f["name"] + "_len; ++i) {", file=body)
+    print("    err = " + n + "_" + f["element"] + "_decode_footprint(ctx, total_sz);", file=body)
+    print("    if ( FD_UNLIKELY(err) ) return err;", file=body)
+    print("  }", file=body)
+
+def do_array_body_decode_footprint(n, f):
+    do_elems_footprint(n, f, f["length"], "  ")
+
+def do_option_body_decode_footprint(n, f):
+    print("  {", file=body)
+    print("    unsigned char o;", file=body)
+    print("    err = fd_bincode_option_decode(&o, ctx);", file=body)
+    print("    if ( FD_UNLIKELY(err) ) return err;", file=body)
+    print("    if (o) {", file=body)
+    if is_ulong(f["element"]):
+        print("      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(ulong), 1UL);", file=body)
+        print("      if ( FD_UNLIKELY(err) ) return err;", file=body)
+        print("      err = fd_bincode_skip_decode(sizeof(ulong), ctx);", file=body)
+    elif is_uint(f["element"]):
+        print("      err = fd_bincode_footprint_alloc(total_sz, 8UL, sizeof(uint), 1UL);", file=body)
+        print("      if ( FD_UNLIKELY(err) ) return err;", file=body)
+        print("      err = fd_bincode_skip_decode(sizeof(uint), ctx);", file=body)
+    else:
+        el = (n + "_" + f["element"]).upper()
+        print("      err = fd_bincode_footprint_alloc(total_sz, " + el + "_ALIGN, " + el + "_FOOTPRINT, 1UL);", file=body)
+        print("      if ( FD_UNLIKELY(err) ) return err;", file=body)
+        print("      err = " + n + "_" + f["element"] + "_decode_footprint(ctx, total_sz);", file=body)
+    print("      if ( FD_UNLIKELY(err) ) return err;", file=body)
+    print("    }", file=body)
+    print("  }", file=body)
+
+def do_string_decode_footprint(n, f):
+    print("  ulong slen;", file=body)
+    print("  err = fd_bincode_uint64_decode(&slen, ctx);", file=body)
+    print("  if ( FD_UNLIKELY(err) ) return err;", file=body)
+    print("  err = fd_bincode_skip_decode(slen, ctx);", file=body)
+    print("  if ( FD_UNLIKELY(err) ) return err;", file=body)
+    print("  err = fd_bincode_footprint_alloc(total_sz, 1UL, slen + 1, 1UL);", file=body)
+    print("  if ( FD_UNLIKELY(err) ) return err;", file=body)
+
+def do_ulong_decode_footprint(n, f):
+    if "modifier" in f and f["modifier"] == "varint":
+        print("  {", file=body)
+        print("    ulong v;", file=body)
+        print("    err = fd_bincode_varint_decode(&v, ctx);", file=body)
+        print("    if ( FD_UNLIKELY(err) ) return err;", file=body)
+        print("  }", file=body)
+    else:
+        print("  err = fd_bincode_skip_decode(sizeof(ulong), ctx);", file=body)
+        print("  if ( FD_UNLIKELY(err) ) return err;", file=body)
+
+def do_skip_decode_footprint(sz):
+    return lambda n, f: print("  err = fd_bincode_skip_decode(" + sz + ", ctx);\n  if ( FD_UNLIKELY(err) ) return err;", file=body)
+
+fields_body_decode_footprint = {
+    "char" :              do_skip_decode_footprint("sizeof(char)"),
+    "char*" :             lambda n, f: do_string_decode_footprint(n, f),
+    "char[32]" :          do_skip_decode_footprint("32UL"),
+    "char[7]" :           do_skip_decode_footprint("7UL"),
+    "double" :            do_skip_decode_footprint("sizeof(double)"),
+    "long" :              do_skip_decode_footprint("sizeof(long)"),
+    "uint" :              do_skip_decode_footprint("sizeof(uint)"),
+    "uint128" :           do_skip_decode_footprint("sizeof(uint128)"),
+    "unsigned char" :     do_skip_decode_footprint("sizeof(uchar)"),
+    "unsigned char[32]" : do_skip_decode_footprint("32UL"),
+    "unsigned long" :     lambda n, f: do_ulong_decode_footprint(n, f),
+    "ushort" :            do_skip_decode_footprint("sizeof(ushort)"),
+    "vector" :            lambda n, f: do_vector_body_decode_footprint(n, f),
+    "deque":              lambda n, f: do_deque_body_decode_footprint(n, f),
+    "array":              lambda n, f: do_array_body_decode_footprint(n, f),
+    "option" :            lambda n, f: do_option_body_decode_footprint(n, f),
+    "map" :               lambda n, f: do_map_body_decode_footprint(n, f),
+}
+
 # encode
 
 def do_vector_body_encode(n, f):
@@ -815,6 +962,7 @@ for entry in entries:
 
 # Generate one instance of the fd_deque.c template for each unique element type.
 deque_element_types = set()
+deque_max = dict()
 
 map_element_types = dict()
 
@@ -842,6 +990,7 @@ for entry in entries:
               print("}", file=header)
 
               deque_element_types.add(element_type)
+              deque_max[element_type] = f["max"]
 
           if f["type"] == "map":
             element_type = deque_elem_type(namespace, f)
@@ -934,6 +1083,7 @@ for entry in entries:
 
     print("void " + n + "_new(" + n + "_t* self);", file=header)
     print("int " + n + "_decode(" + n + "_t* self, fd_bincode_decode_ctx_t * ctx);", file=header)
+    print("int " + n + "_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz);", file=header)
     print("int " + n + "_encode(" + n + "_t const * self, fd_bincode_encode_ctx_t * ctx);", file=header)
     print("void " + n + "_destroy(" + n + "_t* self, fd_bincode_destroy_ctx_t * ctx);", file=header)
     print("void " + n + "_walk(" + n + "_t* self, fd_walk_fun_t fun, const char *name, int level);", file=header)
@@ -994,6 +1144,43 @@ for entry in entries:
       print("  return FD_BINCODE_SUCCESS;", file=body)
       print("}", file=body)
 
+    if entry["type"] == "enum":
+        print("int " + n + "_inner_decode_footprint(uint discriminant, fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {", file=body)
+        print("  int err;", file=body)
+        print("  switch (discriminant) {", file=body)
+        for i, v in enumerate(entry["variants"]):
+            print("  case "+ str(i) +": {", file=body)
+            if "type" in v:
+                if v["type"] in fields_body_decode_footprint:
+                    fields_body_decode_footprint[v["type"]](namespace, v)
+                    print("    return FD_BINCODE_SUCCESS;", file=body)
+                else:
+                    print("    return " + namespace + "_" + v["type"] + "_decode_footprint(ctx, total_sz);", file=body)
+            else:
+                print("    return FD_BINCODE_SUCCESS;", file=body)
+            print("  }", file=body)
+        print("  default: return FD_BINCODE_ERR_ENCODING;", file=body);
+        print("  }", file=body)
+        print("}", file=body)
+
+        print("int " + n + "_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {", file=body)
+        print("  uint discriminant;", file=body)
+        print("  int err = fd_bincode_uint32_decode(&discriminant, ctx);", file=body)
+        print("  if ( FD_UNLIKELY(err) ) return err;", file=body)
+        print("  return " + n + "_inner_decode_footprint(discriminant, ctx, total_sz);", file=body)
+        print("}", file=body)
+    else:
+      print("int " + n + "_decode_footprint(fd_bincode_decode_ctx_t * ctx, ulong * total_sz) {", file=body)
+      print("  int err;", file=body)
+      for f in entry["fields"]:
+          if f["type"] in fields_body_decode_footprint:
+              fields_body_decode_footprint[f["type"]](namespace, f)
+          else:
+              print("  err = " + namespace + "_" + f["type"] + "_decode_footprint(ctx, total_sz);", file=body)
+              print("  if ( FD_UNLIKELY(err) ) return err;", file=body)
+      print("  return FD_BINCODE_SUCCESS;", file=body)
+      print("}", file=body)
+
     if entry["type"] == "enum":
       print("void " + n + "_inner_new(" + n + "_inner_t* self, uint discriminant) {", file=body)
       print("  switch (discriminant) {", file=body)
@@ -1152,6 +1339,10 @@ for (element_type,key) in map_element_types.items():
     print(f"  return (long)(left->elem.{key} - right->elem.{key});", file=body)
     print(f"}}", file=body)
 
+print("", file=body)
+print("/* FIXME: SEE ABOVE PUSH */", file=body)
+print("#pragma GCC diagnostic pop", file=body)
+
 print("FD_PROTOTYPES_END", file=header)
 print("", file=header)
 print("#endif // HEADER_" + json_object["name"].upper(), file=header)
@@ -0,0 +1,176 @@
+#include "fd_types.h"
+
+/* Checks for a few generated types (vectors, options, strings, nested
+   vectors and redblack maps of maps) that fd_{type}_decode_footprint
+   accepts an encoded value, that decoding it into an arena of exactly
+   that footprint uses the whole arena and reproduces the value, and
+   that the footprint pass rejects every truncation of the encoding. */
+
+static uchar build_mem[ 1UL<<20 ] __attribute__((aligned(FD_BINCODE_ARENA_ALIGN)));
+static uchar dec_mem  [ 1UL<<20 ] __attribute__((aligned(FD_BINCODE_ARENA_ALIGN)));
+static uchar enc      [ 1UL<<16 ];
+static uchar enc2     [ 1UL<<16 ];
+
+/* Test values are built in build_mem */
+
+static fd_bincode_arena_t build[1];
+
+static void *
+test_alloc( ulong align,
+            ulong sz ) {
+  return fd_bincode_arena_alloc( build, align, sz );
+}
+
+#define TEST_FOOTPRINT( T, val ) do {                                                                       \
+    fd_bincode_encode_ctx_t ectx = { .data = enc, .dataend = enc+sizeof(enc) };                             \
+    FD_TEST( T##_encode( (val), &ectx )==FD_BINCODE_SUCCESS );                                              \
+    ulong enc_sz = (ulong)ectx.data - (ulong)enc;                                                           \
+                                                                                                            \
+    ulong total_sz = 0UL;                                                                                   \
+    fd_bincode_decode_ctx_t dctx = { .data = enc, .dataend = enc+enc_sz };                                  \
+    FD_TEST( T##_decode_footprint( &dctx, &total_sz )==FD_BINCODE_SUCCESS );                                \
+    FD_TEST( dctx.data==enc+enc_sz );                                                                       \
+    FD_TEST( total_sz<=sizeof(dec_mem) );                                                                   \
+                                                                                                            \
+    fd_bincode_arena_t arena[1];                                                                            \
+    fd_bincode_arena_init( arena, dec_mem, total_sz );                                                      \
+    T##_t out[1];                                                                                           \
+    T##_new( out );                                                                                         \
+    dctx = (fd_bincode_decode_ctx_t){ .data = enc, .dataend = enc+enc_sz,                                   \
+                                      .allocf = fd_bincode_arena_alloc, .allocf_arg = arena };              \
+    FD_TEST( T##_decode( out, &dctx )==FD_BINCODE_SUCCESS );                                                \
+    FD_TEST( arena->off==total_sz );                                                                        \
+                                                                                                            \
+    ectx = (fd_bincode_encode_ctx_t){ .data = enc2, .dataend = enc2+sizeof(enc2) };                         \
+    FD_TEST( T##_encode( out, &ectx )==FD_BINCODE_SUCCESS );                                                \
+    FD_TEST( (ulong)ectx.data - (ulong)enc2==enc_sz );                                                      \
+    FD_TEST( !memcmp( enc, enc2, enc_sz ) );                                                                \
+                                                                                                            \
+    for( ulong sz=0UL; sz<enc_sz; sz++ ) {                                                                  \
+      ulong trunc_sz = 0UL;                                                                                 \
+      dctx = (fd_bincode_decode_ctx_t){ .data = enc, .dataend = enc+sz };                                   \
+      FD_TEST( T##_decode_footprint( &dctx, &trunc_sz )!=FD_BINCODE_SUCCESS );                              \
+    }                                                                                                       \
+                                                                                                            \
+    FD_LOG_NOTICE(( "%-56s %6lu bytes encoded, %6lu bytes footprint", #T, enc_sz, total_sz ));              \
+  } while(0)
+
+static void
+test_vote_state_update( fd_rng_t * rng,
+                        int        opt ) {
+  fd_vote_state_update_t v[1];
+  fd_vote_state_update_new( v );
+  v->lockouts_len = 31UL;
+  v->lockouts     = (fd_vote_lockout_t *)test_alloc( FD_VOTE_LOCKOUT_ALIGN, v->lockouts_len*FD_VOTE_LOCKOUT_FOOTPRINT );
+  for( ulong i=0UL; i<v->lockouts_len; i++ ) {
+    v->lockouts[i].slot               = fd_rng_ulong( rng );
+    v->lockouts[i].confirmation_count = fd_rng_uint( rng );
+  }
+  if( opt ) {
+    v->proposed_root  = (ulong *)test_alloc( 8UL, sizeof(ulong) ); *v->proposed_root = fd_rng_ulong( rng );
+    v->timestamp      = (ulong *)test_alloc( 8UL, sizeof(ulong) ); *v->timestamp     = fd_rng_ulong( rng );
+  }
+  for( ulong j=0UL; j<4UL; j++ ) v->hash.ul[j] = fd_rng_ulong( rng );
+  TEST_FOOTPRINT( fd_vote_state_update, v );
+}
+
+static void
+test_create_account_with_seed( fd_rng_t * rng ) {
+  fd_system_program_instruction_create_account_with_seed_t v[1];
+  fd_system_program_instruction_create_account_with_seed_new( v );
+  static char const seed[] = "a seed of a few bytes";
+  v->seed = (char *)test_alloc( 1UL, sizeof(seed) );
+  fd_memcpy( v->seed, seed, sizeof(seed) );
+  v->lamports = fd_rng_ulong( rng );
+  v->space    = fd_rng_ulong( rng );
+  TEST_FOOTPRINT( fd_system_program_instruction_create_account_with_seed, v );
+}
+
+static void
+test_block_hash_queue( fd_rng_t * rng ) {
+  fd_block_hash_queue_t v[1];
+  fd_block_hash_queue_new( v );
+  v->last_hash_index = fd_rng_ulong( rng );
+  v->last_hash       = (fd_hash_t *)test_alloc( 8UL, sizeof(fd_hash_t) );
+  for( ulong j=0UL; j<4UL; j++ ) v->last_hash->ul[j] = fd_rng_ulong( rng );
+  v->ages_len = 17UL;
+  v->ages     = (fd_hash_hash_age_pair_t *)test_alloc( FD_HASH_HASH_AGE_PAIR_ALIGN, v->ages_len*FD_HASH_HASH_AGE_PAIR_FOOTPRINT );
+  fd_memset( v->ages, 0, v->ages_len*FD_HASH_HASH_AGE_PAIR_FOOTPRINT );
+  for( ulong i=0UL; i<v->ages_len; i++ ) {
+    v->ages[i].key.ul[0]      = fd_rng_ulong( rng );
+    v->ages[i].val.hash_index = fd_rng_ulong( rng );
+    v->ages[i].val.timestamp  = fd_rng_ulong( rng );
+  }
+  v->max_age = 300UL;
+  TEST_FOOTPRINT( fd_block_hash_queue, v );
+}
+
+static void
+test_vote_accounts( fd_rng_t * rng ) {
+  fd_vote_accounts_t v[1];
+  fd_vote_accounts_new( v );
+  v->vote_accounts_len = 5UL;
+  v->vote_accounts     = (fd_vote_accounts_pair_t *)test_alloc( FD_VOTE_ACCOUNTS_PAIR_ALIGN, v->vote_accounts_len*FD_VOTE_ACCOUNTS_PAIR_FOOTPRINT );
+  for( ulong i=0UL; i<v->vote_accounts_len; i++ ) {
+    fd_vote_accounts_pair_t * p = v->vote_accounts + i;
+    fd_memset( p, 0, sizeof(fd_vote_accounts_pair_t) );
+    p->key.ul[0]      = fd_rng_ulong( rng );
+    p->stake          = fd_rng_ulong( rng );
+    p->value.lamports = fd_rng_ulong( rng );
+    p->value.data_len = i*37UL; /* Including an empty one */
+    p->value.data     = (uchar *)test_alloc( 8UL, p->value.data_len );
+    for( ulong j=0UL; j<p->value.data_len; j++ ) p->value.data[j] = fd_rng_uchar( rng );
+  }
+  TEST_FOOTPRINT( fd_vote_accounts, v );
+}
+
+static void
+test_accounts_db_fields( fd_rng_t * rng ) {
+  fd_solana_accounts_db_fields_t v[1];
+  fd_memset( v, 0, sizeof(fd_solana_accounts_db_fields_t) ); /* _new leaves lengths alone */
+  fd_solana_accounts_db_fields_new( v );
+  ulong slot_cnt = 9UL;
+  v->storages_pool = fd_slot_account_pair_t_map_alloc( fd_bincode_arena_alloc, build, slot_cnt );
+  v->storages_root = NULL;
+  for( ulong i=0UL; i<slot_cnt; i++ ) {
+    fd_slot_account_pair_t_mapnode_t * node = fd_slot_account_pair_t_map_acquire( v->storages_pool );
+    node->elem.slot          = 1000UL + i;
+    node->elem.accounts_pool = fd_serializable_account_storage_entry_t_map_alloc( fd_bincode_arena_alloc, build, i );
+    node->elem.accounts_root = NULL;
+    for( ulong j=0UL; j<i; j++ ) {
+      fd_serializable_account_storage_entry_t_mapnode_t * acc = fd_serializable_account_storage_entry_t_map_acquire( node->elem.accounts_pool );
+      acc->elem.id                   = j;
+      acc->elem.accounts_current_len = fd_rng_ulong( rng );
+      fd_serializable_account_storage_entry_t_map_insert( node->elem.accounts_pool, &node->elem.accounts_root, acc );
+    }
+    fd_slot_account_pair_t_map_insert( v->storages_pool, &v->storages_root, node );
+  }
+  v->version              = 1UL;
+  v->slot                 = fd_rng_ulong( rng );
+  v->historical_roots_len = 3UL;
+  v->historical_roots     = (ulong *)test_alloc( 8UL, v->historical_roots_len*sizeof(ulong) );
+  for( ulong i=0UL; i<v->historical_roots_len; i++ ) v->historical_roots[i] = fd_rng_ulong( rng );
+  TEST_FOOTPRINT( fd_solana_accounts_db_fields, v );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  fd_bincode_arena_init( build, build_mem, sizeof(build_mem) );
+
+  test_vote_state_update( rng, 0 );
+  test_vote_state_update( rng, 1 );
+  test_create_account_with_seed( rng );
+  test_block_hash_queue( rng );
+  test_vote_accounts( rng );
+  test_accounts_db_fields( rng );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
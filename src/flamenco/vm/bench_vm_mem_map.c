@@ -0,0 +1,134 @@
+#include "../fd_flamenco_base.h"
+#include "fd_vm_interp.h"
+#include "../../ballet/sbpf/fd_sbpf_opcodes.h"
+
+/* bench_vm_mem_map measures the per-access cost of translating VM
+   addresses to host addresses, with the switch based
+   fd_vm_translate_vm_to_host and with the precomputed region table
+   (fd_vm_mem_map_translate), over a batch of --addr-cnt random valid
+   accesses spread over all regions.  It then reports the cost per
+   instruction of a load/store heavy program in the interpreter, which
+   translates through the region table. */
+
+static fd_vm_exec_context_t ctx[1];
+
+static uchar read_only[ 1UL<<16 ];
+static uchar input    [ 1UL<<16 ];
+static uchar heap     [ FD_VM_HEAP_SZ ];
+static ulong sink;
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong addr_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--addr-cnt", NULL, 4096UL );
+  ulong iter_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt", NULL, 10000UL );
+  uint  seed     = fd_env_strip_cmdline_uint ( &argc, &argv, "--seed",     NULL, 0U      );
+
+  if( FD_UNLIKELY( !addr_cnt || addr_cnt>(1UL<<20) ) ) FD_LOG_ERR(( "--addr-cnt should be in [1,2^20]" ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
+
+  ctx->read_only    = read_only;
+  ctx->read_only_sz = sizeof(read_only);
+  ctx->input        = input;
+  ctx->input_sz     = sizeof(input);
+  ctx->heap         = heap;
+  ctx->heap_sz      = sizeof(heap);
+  fd_vm_mem_map_region_tab_init( ctx );
+
+  static ulong vm_addr[ 1UL<<20 ];
+  static ulong sz     [ 1UL<<20 ];
+  static uint  write  [ 1UL<<20 ];
+  for( ulong i=0UL; i<addr_cnt; i++ ) {
+    ulong region = 1UL + fd_rng_ulong_roll( rng, 4UL );
+    sz   [ i ]   = 1UL << fd_rng_uint_roll( rng, 4U );
+    write[ i ]   = region!=1UL && fd_rng_uint_roll( rng, 2U );
+    vm_addr[ i ] = (region<<FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS) | fd_rng_ulong_roll( rng, (1UL<<16) - 16UL );
+  }
+
+  /* Warm up and check that both agree */
+
+  for( ulong i=0UL; i<addr_cnt; i++ ) {
+    void * haddr = NULL;
+    FD_TEST( fd_vm_translate_vm_to_host( ctx, write[i], vm_addr[i], sz[i], &haddr )==FD_VM_MEM_MAP_SUCCESS );
+    FD_TEST( fd_vm_mem_map_translate( ctx, write[i], vm_addr[i], sz[i] )==haddr );
+  }
+
+  ulong sum = 0UL;
+
+  long dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    for( ulong i=0UL; i<addr_cnt; i++ ) {
+      void * haddr = NULL;
+      ulong  err   = fd_vm_translate_vm_to_host( ctx, write[i], vm_addr[i], sz[i], &haddr );
+      FD_COMPILER_FORGET( haddr );
+      sum += (ulong)haddr + err;
+    }
+    FD_COMPILER_MFENCE();
+  }
+  dt += fd_log_wallclock();
+  double ns_switch = (double)dt / ((double)iter_cnt*(double)addr_cnt);
+
+  dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    for( ulong i=0UL; i<addr_cnt; i++ ) {
+      void * haddr = fd_vm_mem_map_translate( ctx, write[i], vm_addr[i], sz[i] );
+      FD_COMPILER_FORGET( haddr );
+      sum += (ulong)haddr;
+    }
+    FD_COMPILER_MFENCE();
+  }
+  dt += fd_log_wallclock();
+  double ns_tab = (double)dt / ((double)iter_cnt*(double)addr_cnt);
+
+  /* Keep the translations live */
+  FD_VOLATILE( sink ) = sum;
+
+  FD_LOG_NOTICE(( "fd_vm_translate_vm_to_host: %.2f ns/access", ns_switch ));
+  FD_LOG_NOTICE(( "fd_vm_mem_map_translate:    %.2f ns/access (%.2fx)", ns_tab, ns_switch/ns_tab ));
+
+  /* A loop that adds a word of the input region to a word of the heap
+     for every word of the heap, i.e. 2 loads and 1 store per 7
+     instructions */
+
+  fd_sbpf_instr_t instrs[] = {
+    FD_SBPF_INSTR( FD_SBPF_OP_LDDW,      FD_SBPF_R1, 0,          0,  0x0      ), /* r1 = heap */
+    FD_SBPF_INSTR( FD_SBPF_OP_ADDL_IMM,  0,          0,          0,  0x3      ),
+    FD_SBPF_INSTR( FD_SBPF_OP_LDDW,      FD_SBPF_R2, 0,          0,  0x0      ), /* r2 = input */
+    FD_SBPF_INSTR( FD_SBPF_OP_ADDL_IMM,  0,          0,          0,  0x4      ),
+    FD_SBPF_INSTR( FD_SBPF_OP_MOV64_IMM, FD_SBPF_R4, 0,          0,  FD_VM_HEAP_SZ/8UL - 1UL ),
+    FD_SBPF_INSTR( FD_SBPF_OP_LDXDW,     FD_SBPF_R3, FD_SBPF_R1, 0,  0        ), /* loop: */
+    FD_SBPF_INSTR( FD_SBPF_OP_LDXDW,     FD_SBPF_R5, FD_SBPF_R2, 0,  0        ),
+    FD_SBPF_INSTR( FD_SBPF_OP_ADD64_REG, FD_SBPF_R3, FD_SBPF_R5, 0,  0        ),
+    FD_SBPF_INSTR( FD_SBPF_OP_STXDW,     FD_SBPF_R1, FD_SBPF_R3, 0,  0        ),
+    FD_SBPF_INSTR( FD_SBPF_OP_ADD64_IMM, FD_SBPF_R1, 0,          0,  8        ),
+    FD_SBPF_INSTR( FD_SBPF_OP_ADD64_IMM, FD_SBPF_R2, 0,          0,  8        ),
+    FD_SBPF_INSTR( FD_SBPF_OP_SUB64_IMM, FD_SBPF_R4, 0,          0,  1        ),
+    FD_SBPF_INSTR( FD_SBPF_OP_JNE_IMM,   FD_SBPF_R4, 0,          -8, 0        ),
+    FD_SBPF_INSTR( FD_SBPF_OP_EXIT,      0,          0,          0,  0        ),
+  };
+  ctx->instrs    = instrs;
+  ctx->instrs_sz = sizeof(instrs)/sizeof(fd_sbpf_instr_t);
+  FD_TEST( fd_vm_context_validate( ctx )==FD_VM_SBPF_VALIDATE_SUCCESS );
+
+  ulong run_cnt = fd_ulong_max( iter_cnt/100UL, 1UL );
+  ulong ic      = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong run=0UL; run<run_cnt; run++ ) {
+    ctx->instruction_counter = 0UL;
+    fd_vm_interp_instrs( ctx );
+    FD_TEST( !ctx->cond_fault );
+    ic += ctx->instruction_counter;
+  }
+  dt += fd_log_wallclock();
+
+  FD_LOG_NOTICE(( "load/store loop: %.2f ns/instr (%lu instructions)", (double)dt/(double)ic, ic ));
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -179,7 +179,7 @@ fd_vm_translate_vm_to_host( fd_vm_exec_context_t *  ctx,
       break;
     case FD_VM_MEM_MAP_HEAP_REGION_START:
       /* Heap memory region */
-      if( end_addr >= FD_VM_HEAP_SZ ) {
+      if( end_addr >= ctx->heap_sz ) {
         return FD_VM_MEM_MAP_ERR_ACC_VIO;
       }
       *host_addr = &ctx->heap[start_addr];
@@ -195,5 +195,41 @@ fd_vm_translate_vm_to_host( fd_vm_exec_context_t *  ctx,
       return FD_VM_MEM_MAP_ERR_ACC_VIO;
   }
 
+  if( write ) fd_vm_mem_map_mark_dirty( ctx, vm_addr, sz );
+
   return FD_VM_MEM_MAP_SUCCESS;
 }
+
+void
+fd_vm_mem_map_region_tab_init( fd_vm_exec_context_t * ctx ) {
+  fd_memset( ctx->region_tab, 0, sizeof(ctx->region_tab) );
+
+  ulong stack_sz = FD_VM_STACK_MAX_DEPTH * FD_VM_STACK_FRAME_WITH_GUARD_SZ;
+  for( ulong write=0UL; write<2UL; write++ ) {
+    fd_vm_mem_region_t * tab = ctx->region_tab[ write ];
+    /* The program region is read-only */
+    if( !write ) tab[ FD_VM_MEM_MAP_PROGRAM_REGION_START>>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS ] = (fd_vm_mem_region_t){ (ulong)ctx->read_only,  ctx->read_only_sz };
+    tab[ FD_VM_MEM_MAP_STACK_REGION_START>>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS ] = (fd_vm_mem_region_t){ (ulong)ctx->stack.data, stack_sz          };
+    tab[ FD_VM_MEM_MAP_HEAP_REGION_START >>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS ] = (fd_vm_mem_region_t){ (ulong)ctx->heap,       ctx->heap_sz      };
+    tab[ FD_VM_MEM_MAP_INPUT_REGION_START>>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS ] = (fd_vm_mem_region_t){ (ulong)ctx->input,      ctx->input_sz     };
+  }
+}
+
+void
+fd_vm_context_reset( fd_vm_exec_context_t * ctx ) {
+  ulong stack_sz = FD_VM_STACK_MAX_DEPTH * FD_VM_STACK_FRAME_WITH_GUARD_SZ;
+  ulong stack_dirty_sz = fd_ulong_min( ctx->dirty_sz[ FD_VM_MEM_MAP_STACK_REGION_START>>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS ], stack_sz     );
+  ulong heap_dirty_sz  = fd_ulong_min( ctx->dirty_sz[ FD_VM_MEM_MAP_HEAP_REGION_START >>FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS ], ctx->heap_sz );
+  fd_memset( ctx->stack.data, 0, stack_dirty_sz );
+  if( ctx->heap ) fd_memset( ctx->heap, 0, heap_dirty_sz );
+  fd_memset( ctx->dirty_sz,      0, sizeof(ctx->dirty_sz)      );
+  fd_memset( ctx->register_file, 0, sizeof(ctx->register_file) );
+
+  ctx->program_counter     = 0UL;
+  ctx->instruction_counter = 0UL;
+  ctx->cond_fault          = 0UL;
+  ctx->heap_alloc_off      = 0UL;
+  ctx->stack.stack_pointer = 0UL;
+  ctx->stack.frames_used   = 0UL;
+  fd_vm_log_collector_init( &ctx->log_collector );
+}
@@ -32,11 +32,28 @@
 #define FD_VM_MEM_MAP_REGION_SZ              (0x0FFFFFFFFUL)
 #define FD_VM_MEM_MAP_REGION_MASK            (~FD_VM_MEM_MAP_REGION_SZ)
 #define FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS  (32)
-#define FD_VM_HEAP_SZ (64*1024)
+#define FD_VM_HEAP_SZ (64*1024)       /* Default size of the heap region */
+#define FD_VM_HEAP_SZ_MAX (256*1024)  /* Largest heap that can be requested for an invocation */
 
 #define FD_VM_MEM_MAP_SUCCESS       (0)
 #define FD_VM_MEM_MAP_ERR_ACC_VIO   (1)
 
+/* FD_VM_MEM_MAP_REGION_TAB_CNT is the number of entries per access type
+   in the region table of a context.  Regions with a larger index are
+   never mapped.  Must be a power of 2 larger than the index of the last
+   region above. */
+#define FD_VM_MEM_MAP_REGION_TAB_CNT (8UL)
+
+/* fd_vm_mem_region_t describes where a memory region of the VM lives in
+   the host address space.  An access of sz bytes at offset off in the
+   region is valid iff off+sz<sz of the region (as checked by
+   fd_vm_translate_vm_to_host).  Unmapped regions have a sz of 0. */
+struct fd_vm_mem_region {
+  ulong haddr; /* Host address of the start of the region */
+  ulong sz;    /* Bound on the end of an access in the region */
+};
+typedef struct fd_vm_mem_region fd_vm_mem_region_t;
+
 /* Foward definition of fd_vm_sbpf_exec_context_t. */
 struct fd_vm_exec_context;
 typedef struct fd_vm_exec_context fd_vm_exec_context_t;
@@ -46,7 +63,6 @@ typedef struct fd_vm_exec_context fd_vm_exec_context_t;
    value is a status code for the syscall. */
 typedef ulong (*fd_vm_syscall_fn_ptr_t)(fd_vm_exec_context_t * ctx, ulong arg0, ulong arg1, ulong arg2, ulong arg3, ulong arg4, ulong * ret);
 
-// FIXME: THE HEAP IS RESIZEABLE AT INVOCATION ~~ugh~~
 /* The sBPF execution context. This is the primary data structure that is evolved before, during
    and after contract execution. */
 struct fd_vm_exec_context {
@@ -71,8 +87,12 @@ struct fd_vm_exec_context {
   ulong         read_only_sz;         /* The read-only memory region size */
   uchar *       input;                /* The program input memory region */
   ulong         input_sz;             /* The program input memory region size */
+  uchar *       heap;                 /* The heap memory region, resizable at invocation */
+  ulong         heap_sz;              /* The heap memory region size, at most FD_VM_HEAP_SZ_MAX */
+  ulong         heap_alloc_off;       /* The offset of the next allocation of the bump allocator syscall */
+  fd_vm_mem_region_t region_tab[2][FD_VM_MEM_MAP_REGION_TAB_CNT]; /* Indexed [write][region], see fd_vm_mem_map_region_tab_init */
+  ulong         dirty_sz[FD_VM_MEM_MAP_REGION_TAB_CNT];           /* Indexed [region], the number of bytes at the start of the region that may have been written */
   fd_vm_stack_t stack;                /* The sBPF call frame stack */
-  uchar         heap[FD_VM_HEAP_SZ];  /* The heap memory allocated by the bump allocator syscall */
 };
 typedef struct fd_vm_exec_context fd_vm_exec_context_t;
 
@@ -101,6 +121,44 @@ ulong fd_vm_translate_vm_to_host( fd_vm_exec_context_t *  ctx,
                                   ulong                   sz,
                                   void * *                host_addr );
 
+/* Precomputes the region table of the context from its memory regions. This must be redone whenever
+   the memory regions of the context change (the interpreter does it every time it starts running a
+   program). */
+void fd_vm_mem_map_region_tab_init( fd_vm_exec_context_t * ctx );
+
+/* Translates an address from the VM address space to the host address space using the precomputed
+   region table of the context. Accepts exactly the same accesses as fd_vm_translate_vm_to_host
+   (write must be 0 or 1), but without a branch per region. Returns the host address on success and
+   NULL on a fault. */
+static inline void *
+fd_vm_mem_map_translate( fd_vm_exec_context_t const * ctx,
+                         ulong                        write,
+                         ulong                        vm_addr,
+                         ulong                        sz ) {
+  ulong region = vm_addr >> FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS;
+  ulong off    = vm_addr &  FD_VM_MEM_MAP_REGION_SZ;
+  fd_vm_mem_region_t const * r = &ctx->region_tab[ write ][ region & (FD_VM_MEM_MAP_REGION_TAB_CNT-1UL) ];
+  int ok = (region<FD_VM_MEM_MAP_REGION_TAB_CNT) & (off+sz<r->sz);
+  return (void *)fd_ulong_if( ok, r->haddr + off, 0UL );
+}
+
+/* Records that the sz bytes at vm_addr, which were successfully translated for writing, may have
+   been written, such that fd_vm_context_reset knows which memory to clear. */
+static inline void
+fd_vm_mem_map_mark_dirty( fd_vm_exec_context_t * ctx,
+                          ulong                  vm_addr,
+                          ulong                  sz ) {
+  ulong * dirty_sz = &ctx->dirty_sz[ (vm_addr >> FD_VM_MEM_MAP_REGION_VIRT_ADDR_BITS) & (FD_VM_MEM_MAP_REGION_TAB_CNT-1UL) ];
+  *dirty_sz = fd_ulong_max( *dirty_sz, (vm_addr & FD_VM_MEM_MAP_REGION_SZ) + sz );
+}
+
+/* Returns the context to the state of a fresh invocation: the registers, counters, fault condition,
+   call stack, log collector and bump allocator are reset, and the parts of the stack and heap
+   regions that may have been written since the last reset are zeroed.  The cost is proportional to
+   the memory the previous invocation actually touched rather than to the size of the regions.  The
+   context should have been zeroed (or reset) once before the first invocation. */
+void fd_vm_context_reset( fd_vm_exec_context_t * ctx );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_flamenco_vm_fd_vm_context_h */
@@ -0,0 +1,202 @@
+#include "fd_vm_context_pool.h"
+#include <stddef.h> /* for offsetof */
+
+struct __attribute__((aligned(FD_VM_CONTEXT_POOL_ALIGN))) fd_vm_context_pool {
+  ulong magic;    /* == FD_VM_CONTEXT_POOL_MAGIC */
+  ulong ctx_max;
+  ulong heap_max;
+  ulong elem_sz;  /* Footprint of a context together with its heap */
+  ulong elem_off; /* Offset of the first context from the pool */
+  ulong free_cnt;
+  ulong free[];   /* Indices of the released contexts, free[0,free_cnt) are valid */
+  /* ctx_max elements (context, then heap) follow at elem_off */
+};
+
+static inline ulong
+fd_vm_context_pool_private_elem_sz( ulong heap_max ) {
+  return fd_ulong_align_up( sizeof(fd_vm_exec_context_t), FD_VM_CONTEXT_POOL_ALIGN )
+       + fd_ulong_align_up( heap_max,                     FD_VM_CONTEXT_POOL_ALIGN );
+}
+
+static inline ulong
+fd_vm_context_pool_private_elem_off( ulong ctx_max ) {
+  return fd_ulong_align_up( sizeof(fd_vm_context_pool_t) + ctx_max*sizeof(ulong), FD_VM_CONTEXT_POOL_ALIGN );
+}
+
+static inline fd_vm_exec_context_t *
+fd_vm_context_pool_private_ctx( fd_vm_context_pool_t * pool,
+                                ulong                  idx ) {
+  return (fd_vm_exec_context_t *)( (ulong)pool + pool->elem_off + idx*pool->elem_sz );
+}
+
+static inline uchar *
+fd_vm_context_pool_private_heap( fd_vm_exec_context_t * ctx ) {
+  return (uchar *)( (ulong)ctx + fd_ulong_align_up( sizeof(fd_vm_exec_context_t), FD_VM_CONTEXT_POOL_ALIGN ) );
+}
+
+ulong
+fd_vm_context_pool_align( void ) {
+  return FD_VM_CONTEXT_POOL_ALIGN;
+}
+
+ulong
+fd_vm_context_pool_footprint( ulong ctx_max,
+                              ulong heap_max ) {
+  if( FD_UNLIKELY( (!ctx_max) | (heap_max>FD_VM_HEAP_SZ_MAX) ) ) return 0UL;
+  ulong elem_sz = fd_vm_context_pool_private_elem_sz( heap_max );
+  if( FD_UNLIKELY( ctx_max>(ULONG_MAX/2UL)/elem_sz ) ) return 0UL; /* overflow */
+  return fd_vm_context_pool_private_elem_off( ctx_max ) + ctx_max*elem_sz;
+}
+
+void *
+fd_vm_context_pool_new( void * shmem,
+                        ulong  ctx_max,
+                        ulong  heap_max ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_vm_context_pool_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_vm_context_pool_footprint( ctx_max, heap_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad ctx_max (%lu) and/or heap_max (%lu)", ctx_max, heap_max ));
+    return NULL;
+  }
+
+  /* This is the only time the whole footprint is touched.  From now on,
+     contexts are only cleared as far as they were used. */
+
+  fd_memset( shmem, 0, footprint );
+
+  fd_vm_context_pool_t * pool = (fd_vm_context_pool_t *)shmem;
+
+  pool->ctx_max  = ctx_max;
+  pool->heap_max = heap_max;
+  pool->elem_sz  = fd_vm_context_pool_private_elem_sz ( heap_max );
+  pool->elem_off = fd_vm_context_pool_private_elem_off( ctx_max  );
+  pool->free_cnt = ctx_max;
+  for( ulong i=0UL; i<ctx_max; i++ ) pool->free[ i ] = ctx_max-1UL-i; /* Hand out contexts in address order */
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( pool->magic ) = FD_VM_CONTEXT_POOL_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_vm_context_pool_t *
+fd_vm_context_pool_join( void * shpool ) {
+
+  if( FD_UNLIKELY( !shpool ) ) {
+    FD_LOG_WARNING(( "NULL shpool" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shpool, fd_vm_context_pool_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shpool" ));
+    return NULL;
+  }
+
+  fd_vm_context_pool_t * pool = (fd_vm_context_pool_t *)shpool;
+  if( FD_UNLIKELY( pool->magic!=FD_VM_CONTEXT_POOL_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return pool;
+}
+
+void *
+fd_vm_context_pool_leave( fd_vm_context_pool_t * pool ) {
+
+  if( FD_UNLIKELY( !pool ) ) {
+    FD_LOG_WARNING(( "NULL pool" ));
+    return NULL;
+  }
+
+  return (void *)pool;
+}
+
+void *
+fd_vm_context_pool_delete( void * shpool ) {
+
+  if( FD_UNLIKELY( !shpool ) ) {
+    FD_LOG_WARNING(( "NULL shpool" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shpool, fd_vm_context_pool_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shpool" ));
+    return NULL;
+  }
+
+  fd_vm_context_pool_t * pool = (fd_vm_context_pool_t *)shpool;
+  if( FD_UNLIKELY( pool->magic!=FD_VM_CONTEXT_POOL_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( pool->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shpool;
+}
+
+ulong fd_vm_context_pool_ctx_max ( fd_vm_context_pool_t const * pool ) { return pool->ctx_max;  }
+ulong fd_vm_context_pool_heap_max( fd_vm_context_pool_t const * pool ) { return pool->heap_max; }
+ulong fd_vm_context_pool_free_cnt( fd_vm_context_pool_t const * pool ) { return pool->free_cnt; }
+
+fd_vm_exec_context_t *
+fd_vm_context_pool_acquire( fd_vm_context_pool_t * pool,
+                            ulong                  heap_sz ) {
+
+  if( FD_UNLIKELY( heap_sz>pool->heap_max ) ) {
+    FD_LOG_WARNING(( "heap_sz (%lu) larger than the heap_max of the pool (%lu)", heap_sz, pool->heap_max ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !pool->free_cnt ) ) return NULL;
+
+  fd_vm_exec_context_t * ctx = fd_vm_context_pool_private_ctx( pool, pool->free[ --pool->free_cnt ] );
+
+  /* The context was reset on release (or zeroed by new), and the heap
+     pointer is set here as the pool might be joined at a different
+     address than the one it was released at */
+
+  ctx->heap    = fd_vm_context_pool_private_heap( ctx );
+  ctx->heap_sz = heap_sz;
+
+  return ctx;
+}
+
+void
+fd_vm_context_pool_release( fd_vm_context_pool_t * pool,
+                            fd_vm_exec_context_t * ctx ) {
+
+  ulong off = (ulong)ctx - (ulong)pool - pool->elem_off;
+  ulong idx = off / pool->elem_sz;
+  if( FD_UNLIKELY( ((ulong)ctx<(ulong)pool+pool->elem_off) | (idx>=pool->ctx_max) | (off!=idx*pool->elem_sz) | (pool->free_cnt>=pool->ctx_max) ) ) {
+    FD_LOG_WARNING(( "ctx not acquired from this pool" ));
+    return;
+  }
+
+  fd_vm_context_reset( ctx );
+
+  /* Clear the fields that the caller set up for the invocation, so that
+     stale pointers into other memory are never reused */
+
+  fd_memset( ctx, 0, offsetof( fd_vm_exec_context_t, register_file ) );
+  ctx->read_only    = NULL;
+  ctx->read_only_sz = 0UL;
+  ctx->input        = NULL;
+  ctx->input_sz     = 0UL;
+
+  pool->free[ pool->free_cnt++ ] = idx;
+}
@@ -0,0 +1,93 @@
+#ifndef HEADER_fd_src_flamenco_vm_fd_vm_context_pool_h
+#define HEADER_fd_src_flamenco_vm_fd_vm_context_pool_h
+
+/* fd_vm_context_pool is a pool of ctx_max preallocated sBPF execution
+   contexts, each with a heap of up to heap_max bytes, that lives in a
+   shared memory region (e.g. a wksp).  Contexts are reused across
+   invocations: releasing a context only zeroes the parts of its stack
+   and heap that the invocation may have written (see
+   fd_vm_context_reset), so the per invocation setup cost is
+   proportional to the memory the previous program actually touched
+   instead of to the ~600 KiB footprint of a context.
+
+   A pool is not safe for concurrent use; each thread that executes
+   programs should have its own. */
+
+#include "fd_vm_context.h"
+
+#define FD_VM_CONTEXT_POOL_ALIGN (128UL)
+#define FD_VM_CONTEXT_POOL_MAGIC (0xf17eda2ce7c7a900UL) /* firedancer vm ctx pool version 0 */
+
+struct fd_vm_context_pool;
+typedef struct fd_vm_context_pool fd_vm_context_pool_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_vm_context_pool_{align,footprint} return the required alignment
+   and footprint of a memory region suitable for use as a pool of
+   ctx_max contexts with heaps of up to heap_max bytes.  footprint
+   returns 0 if ctx_max is zero or heap_max is larger than
+   FD_VM_HEAP_SZ_MAX. */
+
+FD_FN_CONST ulong
+fd_vm_context_pool_align( void );
+
+FD_FN_CONST ulong
+fd_vm_context_pool_footprint( ulong ctx_max,
+                              ulong heap_max );
+
+/* fd_vm_context_pool_new formats an unused memory region for use as a
+   pool.  All contexts start out zeroed and released.  Returns shmem on
+   success and NULL on failure (logs details).
+
+   fd_vm_context_pool_join joins the caller to the pool.  Returns a
+   local handle on success and NULL on failure (logs details).
+
+   fd_vm_context_pool_leave leaves a current local join.
+
+   fd_vm_context_pool_delete unformats a memory region used as a pool.
+   Returns the region on success and NULL on failure (logs details). */
+
+void *
+fd_vm_context_pool_new( void * shmem,
+                        ulong  ctx_max,
+                        ulong  heap_max );
+
+fd_vm_context_pool_t *
+fd_vm_context_pool_join( void * shpool );
+
+void *
+fd_vm_context_pool_leave( fd_vm_context_pool_t * pool );
+
+void *
+fd_vm_context_pool_delete( void * shpool );
+
+/* Accessors */
+
+FD_FN_PURE ulong fd_vm_context_pool_ctx_max ( fd_vm_context_pool_t const * pool );
+FD_FN_PURE ulong fd_vm_context_pool_heap_max( fd_vm_context_pool_t const * pool );
+FD_FN_PURE ulong fd_vm_context_pool_free_cnt( fd_vm_context_pool_t const * pool );
+
+/* fd_vm_context_pool_acquire takes a context out of the pool for an
+   invocation with a heap of heap_sz bytes.  The returned context is in
+   the state left by fd_vm_context_reset, with its heap pointing to
+   heap_sz zeroed bytes; the caller sets up the program, the syscall
+   and call maps and the memory regions before running it.  Returns
+   NULL if heap_sz is larger than the heap_max of the pool (logs
+   details) or if all contexts are in use.  The returned pointer is
+   only valid in the caller's address space. */
+
+fd_vm_exec_context_t *
+fd_vm_context_pool_acquire( fd_vm_context_pool_t * pool,
+                            ulong                  heap_sz );
+
+/* fd_vm_context_pool_release returns a context acquired from pool to
+   it, after zeroing whatever memory the invocation wrote to. */
+
+void
+fd_vm_context_pool_release( fd_vm_context_pool_t * pool,
+                            fd_vm_exec_context_t * ctx );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_vm_fd_vm_context_pool_h */
@@ -10,10 +10,9 @@ static ulong
 fd_vm_mem_map_read_uchar( fd_vm_exec_context_t * ctx,
                           ulong                       vm_addr,
                           ulong *                     val ) {
-  void * vm_mem;
-  ulong translation_res = fd_vm_translate_vm_to_host(ctx, 0, vm_addr, sizeof(uchar), &vm_mem);
-  if( translation_res != FD_VM_MEM_MAP_SUCCESS ) {
-    return translation_res;
+  void * vm_mem = fd_vm_mem_map_translate( ctx, 0UL, vm_addr, sizeof(uchar) );
+  if( FD_UNLIKELY( !vm_mem ) ) {
+    return FD_VM_MEM_MAP_ERR_ACC_VIO;
   }
 
 
@@ -29,10 +28,9 @@ static ulong
 fd_vm_mem_map_read_ushort( fd_vm_exec_context_t *  ctx,
                            ulong                        vm_addr,
                            ulong *                      val ) {
-  void * vm_mem;
-  ulong translation_res = fd_vm_translate_vm_to_host(ctx, 0, vm_addr, sizeof(ushort), &vm_mem);
-  if( translation_res != FD_VM_MEM_MAP_SUCCESS ) {
-    return translation_res;
+  void * vm_mem = fd_vm_mem_map_translate( ctx, 0UL, vm_addr, sizeof(ushort) );
+  if( FD_UNLIKELY( !vm_mem ) ) {
+    return FD_VM_MEM_MAP_ERR_ACC_VIO;
   }
 
   *val = (*(ushort *)vm_mem) & 0xFFFFUL;
@@ -47,10 +45,9 @@ static ulong
 fd_vm_mem_map_read_uint( fd_vm_exec_context_t *  ctx,
                          ulong                        vm_addr,
                          ulong *                      val ) {
-  void * vm_mem;
-  ulong translation_res = fd_vm_translate_vm_to_host(ctx, 0, vm_addr, sizeof(uint), &vm_mem);
-  if( translation_res != FD_VM_MEM_MAP_SUCCESS ) {
-    return translation_res;
+  void * vm_mem = fd_vm_mem_map_translate( ctx, 0UL, vm_addr, sizeof(uint) );
+  if( FD_UNLIKELY( !vm_mem ) ) {
+    return FD_VM_MEM_MAP_ERR_ACC_VIO;
   }
 
   *val = (*(uint *)vm_mem) & 0xFFFFFFFFUL;
@@ -65,10 +62,9 @@ static ulong
 fd_vm_mem_map_read_ulong( fd_vm_exec_context_t * ctx,
                           ulong                       vm_addr,
                           ulong *                     val ) {
-  void * vm_mem;
-  ulong translation_res = fd_vm_translate_vm_to_host(ctx, 0, vm_addr, sizeof(ulong), &vm_mem);
-  if( translation_res != FD_VM_MEM_MAP_SUCCESS ) {
-    return translation_res;
+  void * vm_mem = fd_vm_mem_map_translate( ctx, 0UL, vm_addr, sizeof(ulong) );
+  if( FD_UNLIKELY( !vm_mem ) ) {
+    return FD_VM_MEM_MAP_ERR_ACC_VIO;
   }
 
   *val = *(ulong *)vm_mem;
@@ -83,11 +79,11 @@ static ulong
 fd_vm_mem_map_write_uchar( fd_vm_exec_context_t *  ctx,
                            ulong                        vm_addr,
                            uchar                        val ) {
-  void * vm_mem;
-  ulong translation_res = fd_vm_translate_vm_to_host(ctx, 1, vm_addr, sizeof(uchar), &vm_mem);
-  if( translation_res != FD_VM_MEM_MAP_SUCCESS ) {
-    return translation_res;
+  void * vm_mem = fd_vm_mem_map_translate( ctx, 1UL, vm_addr, sizeof(uchar) );
+  if( FD_UNLIKELY( !vm_mem ) ) {
+    return FD_VM_MEM_MAP_ERR_ACC_VIO;
   }
+  fd_vm_mem_map_mark_dirty( ctx, vm_addr, sizeof(uchar) );
 
   *(uchar *)vm_mem = val;
 
@@ -101,11 +97,11 @@ static ulong
 fd_vm_mem_map_write_ushort( fd_vm_exec_context_t * ctx,
                             ulong                       vm_addr,
                             ushort                      val ) {
-  void * vm_mem;
-  ulong translation_res = fd_vm_translate_vm_to_host(ctx, 1, vm_addr, sizeof(ushort), &vm_mem);
-  if( translation_res != FD_VM_MEM_MAP_SUCCESS) {
-    return translation_res;
+  void * vm_mem = fd_vm_mem_map_translate( ctx, 1UL, vm_addr, sizeof(ushort) );
+  if( FD_UNLIKELY( !vm_mem ) ) {
+    return FD_VM_MEM_MAP_ERR_ACC_VIO;
   }
+  fd_vm_mem_map_mark_dirty( ctx, vm_addr, sizeof(ushort) );
 
   *(ushort *)vm_mem = val;
 
@@ -119,11 +115,11 @@ static ulong
 fd_vm_mem_map_write_uint( fd_vm_exec_context_t * ctx,
                           ulong                       vm_addr,
                           uint                        val ) {
-  void * vm_mem;
-  ulong translation_res = fd_vm_translate_vm_to_host(ctx, 1, vm_addr, sizeof(uint), &vm_mem);
-  if( translation_res != FD_VM_MEM_MAP_SUCCESS) {
-    return translation_res;
+  void * vm_mem = fd_vm_mem_map_translate( ctx, 1UL, vm_addr, sizeof(uint) );
+  if( FD_UNLIKELY( !vm_mem ) ) {
+    return FD_VM_MEM_MAP_ERR_ACC_VIO;
   }
+  fd_vm_mem_map_mark_dirty( ctx, vm_addr, sizeof(uint) );
 
   *(uint *)vm_mem = val;
 
@@ -137,11 +133,11 @@ static ulong
 fd_vm_mem_map_write_ulong( fd_vm_exec_context_t *  ctx,
                           ulong                         vm_addr,
                           ulong                         val ) {
-  void * vm_mem;
-  ulong translation_res = fd_vm_translate_vm_to_host(ctx, 1, vm_addr, sizeof(ulong), &vm_mem);
-  if( translation_res != FD_VM_MEM_MAP_SUCCESS) {
-    return translation_res;
+  void * vm_mem = fd_vm_mem_map_translate( ctx, 1UL, vm_addr, sizeof(ulong) );
+  if( FD_UNLIKELY( !vm_mem ) ) {
+    return FD_VM_MEM_MAP_ERR_ACC_VIO;
   }
+  fd_vm_mem_map_mark_dirty( ctx, vm_addr, sizeof(ulong) );
 
   *(ulong *)vm_mem = val;
 
@@ -154,6 +150,7 @@ fd_vm_interp_instrs( fd_vm_exec_context_t * ctx ) {
   ulong ic = ctx->instruction_counter;
   ulong * register_file = ctx->register_file;
   fd_memset(register_file, 0, sizeof(register_file));
+  fd_vm_mem_map_region_tab_init( ctx );
 
   ulong cond_fault = 0;
 
@@ -200,6 +197,7 @@ fd_vm_interp_instrs_trace( fd_vm_exec_context_t *       ctx,
   ulong ic = ctx->instruction_counter;
   ulong * register_file = ctx->register_file;
   fd_memset( register_file, 0, sizeof(register_file) );
+  fd_vm_mem_map_region_tab_init( ctx );
 
   ulong cond_fault = 0;
 
@@ -238,8 +236,94 @@ JT_END;
 
 #include "fd_jump_tab_teardown.c"
 #undef JMP_TAB_ID
+#undef JMP_TAB_PRE_CASE_CODE
+#undef JMP_TAB_POST_CASE_CODE
+
+  // FIXME: Actual errors!
+  return 0;
+}
+
+/* fd_vm_interp_predecoded_impl runs the program from ctx using prog
+   if prog_out is NULL.  Otherwise, it translates the program into
+   prog_out.  Both are done by the same function because the handler
+   addresses are labels local to it. */
+
+static ulong
+fd_vm_interp_predecoded_impl( fd_vm_exec_context_t *           ctx,
+                              fd_vm_predecoded_instr_t const * prog,
+                              fd_vm_predecoded_instr_t *       prog_out ) {
+#define JMP_TAB_ID interp_predecoded
+#define JMP_TAB_PRE_CASE_CODE
+#define JMP_TAB_POST_CASE_CODE \
+  ic++; \
+  instr = prog[++pc]; \
+  goto *instr.handler;
+#include "fd_jump_tab.c"
+
+  static const void * locs[222] = {
+#include "fd_vm_interp_locs.c"
+  };
+
+  if( prog_out ) {
+    fd_sbpf_instr_t const * instrs    = ctx->instrs;
+    ulong                   instrs_sz = ctx->instrs_sz;
+    for( ulong i=0UL; i<instrs_sz; i++ ) {
+      fd_sbpf_instr_t in = instrs[ i ];
+      void const * handler = in.opcode.raw<222 ? locs[ in.opcode.raw ] : NULL;
+      prog_out[ i ].handler = handler ? handler : &&sigill_interp_predecoded;
+      prog_out[ i ].imm     = in.imm;
+      prog_out[ i ].offset  = in.offset;
+      prog_out[ i ].dst_reg = (uchar)in.dst_reg;
+      prog_out[ i ].src_reg = (uchar)in.src_reg;
+    }
+    return 0;
+  }
+
+  long pc = ctx->entrypoint;
+  ulong ic = ctx->instruction_counter;
+  ulong * register_file = ctx->register_file;
+  fd_memset( register_file, 0, sizeof(ctx->register_file) );
+  fd_vm_mem_map_region_tab_init( ctx );
+
+  ulong cond_fault = 0;
+
+  fd_vm_predecoded_instr_t instr = prog[pc];
+
+  goto *instr.handler;
+
+JT_START;
+  /* Every opcode without a case in the dispatch table is translated to
+     this handler, so running an illegal instruction faults at its pc
+     instead of jumping to NULL. */
+sigill_interp_predecoded:
+  cond_fault = 1;
+  goto JT_RET_LOC;
+#include "fd_vm_interp_dispatch_tab.c"
+JT_END;
+
+  ctx->program_counter = (ulong) pc;
+  ctx->instruction_counter = ic;
+  ctx->cond_fault = cond_fault;
+
+#include "fd_jump_tab_teardown.c"
+#undef JMP_TAB_ID
+#undef JMP_TAB_PRE_CASE_CODE
+#undef JMP_TAB_POST_CASE_CODE
 
   // FIXME: Actual errors!
   return 0;
 }
 
+fd_vm_predecoded_instr_t *
+fd_vm_interp_predecode( fd_vm_exec_context_t const *  ctx,
+                        fd_vm_predecoded_instr_t *    out ) {
+  /* In translation mode, ctx is only read from */
+  fd_vm_interp_predecoded_impl( (fd_vm_exec_context_t *)ctx, NULL, out );
+  return out;
+}
+
+ulong
+fd_vm_interp_instrs_predecoded( fd_vm_exec_context_t *           ctx,
+                                fd_vm_predecoded_instr_t const * prog ) {
+  return fd_vm_interp_predecoded_impl( ctx, prog, NULL );
+}
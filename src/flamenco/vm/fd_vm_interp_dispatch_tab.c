@@ -367,6 +367,7 @@ JT_CASE_END
 JT_CASE_END
 /* 0xc5 */ JT_CASE(0xc5) // FD_BPF_OP_JSLT_IMM
   pc += ((long)register_file[instr.dst_reg] < (long)instr.imm) ? instr.offset : 0;
+JT_CASE_END
 /* 0xc7 */ JT_CASE(0xc7) // FD_BPF_OP_ARSH64_IMM
   register_file[instr.dst_reg] = (ulong)((long)register_file[instr.dst_reg] >> instr.imm);
 JT_CASE_END
@@ -382,7 +383,18 @@ JT_CASE_END
 
 /* 0xd0 - 0xdf */
 /* 0xd4 */ JT_CASE(0xd4) // FD_BPF_OP_END_LE
-  /* On x86_64, the host is LE already */
+  /* On x86_64, the host is LE already, so this only truncates */
+  switch (instr.imm) {
+    case 16:
+      register_file[instr.dst_reg] &= 0xFFFF;
+      break;
+    case 32:
+      register_file[instr.dst_reg] &= 0xFFFFFFFF;
+      break;
+    default:
+      break;
+  }
+JT_CASE_END
 /* 0xd5 */ JT_CASE(0xd5) // FD_BPF_OP_JSLE_IMM
   pc += ((long)register_file[instr.dst_reg] <= (long)instr.imm) ? instr.offset : 0;
 JT_CASE_END
@@ -0,0 +1,839 @@
+#if FD_HAS_HOSTED
+#define _GNU_SOURCE
+#endif
+
+#include "fd_vm_jit.h"
+
+#if FD_HAS_X86 && FD_HAS_HOSTED
+
+#include "../../ballet/sbpf/fd_sbpf_maps.c"
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/* Register assignment of the generated code.  Everything that needs to
+   survive a call into C lives in a callee saved register:
+
+     rbx  &ctx->register_file[0] (sBPF registers are addressed as [rbx+8*r])
+     r12  instruction counter
+     r13  ctx
+     r14  &ctx->region_tab[0][0]
+     r15  pc table (native address of each instruction)
+
+   rax, rcx, rdx and rsi are scratch. */
+
+#define RAX (0)
+#define RCX (1)
+#define RDX (2)
+#define RBX (3)
+#define RSP (4)
+#define RSI (6)
+#define RDI (7)
+#define R12 (12)
+#define R13 (13)
+#define R14 (14)
+#define R15 (15)
+
+#define REG_OFF(r) ((int)(8U*(uint)(r)))
+
+#define CTX_OFF_REGS   ((int)offsetof( fd_vm_exec_context_t, register_file       ))
+#define CTX_OFF_PC     ((int)offsetof( fd_vm_exec_context_t, program_counter     ))
+#define CTX_OFF_IC     ((int)offsetof( fd_vm_exec_context_t, instruction_counter ))
+#define CTX_OFF_FAULT  ((int)offsetof( fd_vm_exec_context_t, cond_fault          ))
+#define CTX_OFF_FRAMES ((int)offsetof( fd_vm_exec_context_t, stack.frames_used   ))
+#define CTX_OFF_DIRTY  ((int)offsetof( fd_vm_exec_context_t, dirty_sz            ))
+
+/* The generated code translates addresses with ctx->region_tab (see
+   fd_vm_mem_map_translate), indexed by the region of the vm address
+   (its upper 32 bits).  FD_VM_JIT_REGION_WRITE is the offset of the
+   table used for writes. */
+
+#define FD_VM_JIT_REGION_WRITE ((int)(FD_VM_MEM_MAP_REGION_TAB_CNT*sizeof(fd_vm_mem_region_t)))
+
+typedef void (*fd_vm_jit_entry_fn_t)( fd_vm_exec_context_t *     ctx,
+                                      fd_vm_mem_region_t const * region,
+                                      ulong                      ic,
+                                      ulong const *              pc_tab,
+                                      ulong                      pc );
+
+struct fd_vm_jit_prog {
+  ulong                map_sz;    /* Size of the mapping that holds this */
+  ulong                code_sz;   /* Bytes of generated code */
+  ulong const *        pc_tab;    /* Indexed [0,instrs_sz], native address of each instruction */
+  fd_vm_jit_entry_fn_t entry;
+};
+
+/* Upper bounds on the number of bytes of code emitted for the shared
+   prologue and epilogue, any single sBPF instruction and any out of
+   line fault stub. */
+
+#define FD_VM_JIT_HDR_CODE_MAX   (256UL)
+#define FD_VM_JIT_INSTR_CODE_MAX (128UL)
+#define FD_VM_JIT_STUB_CODE_MAX  (32UL)
+
+/* Kinds of out of line stubs.  They leave the generated code with the
+   pc of the instruction they belong to and the given fault condition
+   (STUB_FAULT_RAX takes it from the return value of a syscall). */
+
+#define STUB_NONE      (0U)
+#define STUB_EXIT      (1U)
+#define STUB_FAULT     (2U)
+#define STUB_FAULT_RAX (3U)
+
+/* fd_vm_jit_fixup_t records, for one instruction, the jumps that can
+   only be resolved once all code is emitted: a jump to the code of
+   another instruction and up to two jumps to the stub of the
+   instruction.  Offsets are relative to the start of the code (0 is
+   never a valid patch location). */
+
+struct fd_vm_jit_fixup {
+  uint label_patch;
+  uint label_pc;
+  uint stub_patch[2];
+  uint stub_kind;
+  uint stub_cnt;
+};
+typedef struct fd_vm_jit_fixup fd_vm_jit_fixup_t;
+
+/* Instruction encoding helpers.  Each emits an instruction at p and
+   returns a pointer just past it.  opc is one opcode byte or a 0x0f
+   prefixed two byte opcode (e.g. 0x0faf for imul). */
+
+static uchar *
+jit_op( uchar * p,
+        int     w,
+        uint    opc,
+        int     reg,
+        int     index,
+        int     base ) {
+  uint rex = 0x40U | ((uint)w<<3) | (((uint)reg&8U)>>1) | (((uint)index&8U)>>2) | (((uint)base&8U)>>3);
+  if( rex!=0x40U ) *p++ = (uchar)rex;
+  if( opc>0xffU  ) *p++ = (uchar)(opc>>8);
+  *p++ = (uchar)opc;
+  return p;
+}
+
+/* opc reg, rm (both registers) */
+
+static uchar *
+jit_rr( uchar * p,
+        int     w,
+        uint    opc,
+        int     reg,
+        int     rm ) {
+  p = jit_op( p, w, opc, reg, 0, rm );
+  *p++ = (uchar)(0xc0U | (((uint)reg&7U)<<3) | ((uint)rm&7U));
+  return p;
+}
+
+/* opc reg, [base+disp] */
+
+static uchar *
+jit_rm( uchar * p,
+        int     w,
+        uint    opc,
+        int     reg,
+        int     base,
+        int     disp ) {
+  int disp8 = (disp>=-128) & (disp<=127);
+  p = jit_op( p, w, opc, reg, 0, base );
+  *p++ = (uchar)((disp8 ? 0x40U : 0x80U) | (((uint)reg&7U)<<3) | ((uint)base&7U));
+  if( (base&7)==RSP ) *p++ = (uchar)0x24; /* SIB with no index for rsp / r12 */
+  if( disp8 ) *p++ = (uchar)(schar)disp;
+  else      { FD_STORE( int, p, disp ); p += 4; }
+  return p;
+}
+
+/* opc reg, [base+index+disp32] */
+
+static uchar *
+jit_rmi( uchar * p,
+         int     w,
+         uint    opc,
+         int     reg,
+         int     base,
+         int     index,
+         int     disp ) {
+  p = jit_op( p, w, opc, reg, index, base );
+  *p++ = (uchar)(0x84U | (((uint)reg&7U)<<3));
+  *p++ = (uchar)((((uint)index&7U)<<3) | ((uint)base&7U));
+  FD_STORE( int, p, disp ); p += 4;
+  return p;
+}
+
+static uchar *
+jit_imm32( uchar * p,
+           uint    imm ) {
+  FD_STORE( uint, p, imm );
+  return p+4;
+}
+
+/* mov r32, imm32 (zero extends to 64 bits) */
+
+static uchar *
+jit_mov_imm32( uchar * p,
+               int     reg,
+               uint    imm ) {
+  p = jit_op( p, 0, 0xb8U+((uint)reg&7U), 0, 0, reg );
+  return jit_imm32( p, imm );
+}
+
+/* mov r64, imm64 */
+
+static uchar *
+jit_mov_imm64( uchar * p,
+               int     reg,
+               ulong   imm ) {
+  p = jit_op( p, 1, 0xb8U+((uint)reg&7U), 0, 0, reg );
+  FD_STORE( ulong, p, imm );
+  return p+8;
+}
+
+/* jit_jcc emits a jcc rel32 (cc is the condition code nibble) or, for
+   cc<0, a jmp rel32.  The rel32 is the 4 bytes before the returned
+   pointer and is left for the caller to patch. */
+
+static uchar *
+jit_jcc( uchar * p,
+         int     cc ) {
+  if( cc<0 ) *p++ = (uchar)0xe9;
+  else     { *p++ = (uchar)0x0f; *p++ = (uchar)(0x80U | (uint)cc); }
+  return jit_imm32( p, 0U );
+}
+
+static void
+jit_patch( uchar *       rel32,
+           uchar const * target ) {
+  FD_STORE( int, rel32, (int)(target - (rel32+4)) );
+}
+
+#define JIT_EMIT(...) do {                      \
+    static uchar const _b[] = { __VA_ARGS__ };  \
+    fd_memcpy( p, _b, sizeof(_b) );             \
+    p += sizeof(_b);                            \
+  } while(0)
+
+#define CC_B  (0x2)
+#define CC_AE (0x3)
+#define CC_E  (0x4)
+#define CC_NE (0x5)
+#define CC_BE (0x6)
+#define CC_A  (0x7)
+#define CC_L  (0xc)
+#define CC_GE (0xd)
+#define CC_LE (0xe)
+#define CC_G  (0xf)
+
+/* jit_inc_ic emits inc r12.  It is emitted right after an instruction
+   can no longer fault (and before any flags it sets are consumed) such
+   that the instruction counter matches the interpreter. */
+
+static uchar *
+jit_inc_ic( uchar * p ) {
+  return jit_rr( p, 1, 0xff, 0, R12 );
+}
+
+/* jit_jmp_dyn emits a jump to the code of the instruction whose pc is
+   in rax.  A pc outside the program jumps to dyn_oob. */
+
+static uchar *
+jit_jmp_dyn( uchar *       p,
+             ulong         instrs_sz,
+             uchar const * dyn_oob ) {
+  p = jit_op( p, 1, 0x3d, 0, 0, 0 ); p = jit_imm32( p, (uint)instrs_sz ); /* cmp rax, instrs_sz */
+  p = jit_jcc( p, CC_AE ); jit_patch( p-4, dyn_oob );
+  JIT_EMIT( 0x41, 0xff, 0x24, 0xc7 );                                     /* jmp [r15+rax*8] */
+  return p;
+}
+
+/* jit_alu emits an ALU or ALU64 class instruction other than END. */
+
+static uchar *
+jit_alu( uchar *         p,
+         uint            opcode,
+         fd_sbpf_instr_t instr ) {
+  int  w   = (opcode&7U)==7U;
+  int  x   = !!(opcode&8U);
+  uint op  = opcode>>4;
+  int  dst = REG_OFF( instr.dst_reg );
+
+  /* rax = dst, rcx = src.  Immediates are zero extended, as in the
+     interpreter. */
+
+  p = jit_rm( p, 1, 0x8b, RAX, RBX, dst );
+  if( x ) p = jit_rm( p, 1, 0x8b, RCX, RBX, REG_OFF( instr.src_reg ) );
+  else    p = jit_mov_imm32( p, RCX, instr.imm );
+
+  switch( op ) {
+  case 0x0: p = jit_rr( p, w, 0x01,   RCX, RAX ); break; /* add  */
+  case 0x1: p = jit_rr( p, w, 0x29,   RCX, RAX ); break; /* sub  */
+  case 0x2: p = jit_rr( p, w, 0x0faf, RAX, RCX ); break; /* imul */
+  case 0x3:                                              /* div  */
+    if( !x ) {
+      if( !instr.imm ) JIT_EMIT( 0x31, 0xc0 );                         /* xor eax, eax */
+      else if( !w )    JIT_EMIT( 0x31, 0xd2, 0xf7, 0xf1 );             /* xor edx, edx; div ecx */
+      else             JIT_EMIT( 0x48, 0x99, 0x48, 0xf7, 0xf9 );       /* cqo; idiv rcx */
+    } else if( !w ) {
+      JIT_EMIT( 0x85, 0xc9, 0x74, 0x06,                                /* test ecx, ecx; jz 1f */
+                0x31, 0xd2, 0xf7, 0xf1, 0xeb, 0x02,                    /* xor edx, edx; div ecx; jmp 2f */
+                0x31, 0xc0 );                                          /* 1: xor eax, eax; 2: */
+    } else {
+      JIT_EMIT( 0x48, 0x85, 0xc9, 0x74, 0x07,                          /* test rcx, rcx; jz 1f */
+                0x31, 0xd2, 0x48, 0xf7, 0xf1, 0xeb, 0x02,              /* xor edx, edx; div rcx; jmp 2f */
+                0x31, 0xc0 );                                          /* 1: xor eax, eax; 2: */
+    }
+    break;
+  case 0x4: p = jit_rr( p, w, 0x09,   RCX, RAX ); break; /* or   */
+  case 0x5: p = jit_rr( p, w, 0x21,   RCX, RAX ); break; /* and  */
+  case 0x6: p = jit_rr( p, w, 0xd3,   4,   RAX ); break; /* shl  */
+  case 0x7: p = jit_rr( p, w, 0xd3,   5,   RAX ); break; /* shr  */
+  case 0x8: p = jit_rr( p, w, 0xf7,   3,   RAX ); break; /* neg  */
+  case 0x9:                                              /* mod  */
+    if( !x ) {
+      if( !instr.imm ) { if( !w ) JIT_EMIT( 0x89, 0xc0 ); }            /* mov eax, eax */
+      else if( !w )    JIT_EMIT( 0x31, 0xd2, 0xf7, 0xf1, 0x89, 0xd0 ); /* xor edx, edx; div ecx; mov eax, edx */
+      else             JIT_EMIT( 0x31, 0xd2, 0x48, 0xf7, 0xf1,         /* xor edx, edx; div rcx */
+                                 0x48, 0x89, 0xd0 );                   /* mov rax, rdx */
+    } else if( !w ) {
+      JIT_EMIT( 0x85, 0xc9, 0x74, 0x08,                                /* test ecx, ecx; jz 1f */
+                0x31, 0xd2, 0xf7, 0xf1, 0x89, 0xd0, 0xeb, 0x02,        /* xor edx, edx; div ecx; mov eax, edx; jmp 2f */
+                0x89, 0xc0 );                                          /* 1: mov eax, eax; 2: */
+    } else {
+      JIT_EMIT( 0x48, 0x85, 0xc9, 0x74, 0x08,                          /* test rcx, rcx; jz 1f */
+                0x31, 0xd2, 0x48, 0xf7, 0xf1, 0x48, 0x89, 0xd0 );      /* xor edx, edx; div rcx; mov rax, rdx; 1: */
+    }
+    break;
+  case 0xa: p = jit_rr( p, w, 0x31,   RCX, RAX ); break; /* xor  */
+  case 0xb: p = jit_rr( p, w, 0x89,   RCX, RAX ); break; /* mov  */
+  case 0xc: p = jit_rr( p, w, 0xd3,   7,   RAX ); break; /* sar  */
+  default: break;
+  }
+
+  return jit_rm( p, 1, 0x89, RAX, RBX, dst );
+}
+
+/* jit_end emits END_LE (opcode 0xd4) and END_BE (opcode 0xdc). */
+
+static uchar *
+jit_end( uchar *         p,
+         uint            opcode,
+         fd_sbpf_instr_t instr ) {
+  int dst = REG_OFF( instr.dst_reg );
+  int be  = opcode==0xdcU;
+  switch( instr.imm ) {
+  case 16U:
+    p = jit_rm( p, 0, 0x0fb7, RAX, RBX, dst );                         /* movzx eax, word [dst] */
+    if( be ) JIT_EMIT( 0x66, 0xc1, 0xc0, 0x08, 0x0f, 0xb7, 0xc0 );     /* rol ax, 8; movzx eax, ax */
+    break;
+  case 32U:
+    p = jit_rm( p, 0, 0x8b, RAX, RBX, dst );                           /* mov eax, [dst] */
+    if( be ) JIT_EMIT( 0x0f, 0xc8 );                                   /* bswap eax */
+    break;
+  case 64U:
+    if( !be ) return p;
+    p = jit_rm( p, 1, 0x8b, RAX, RBX, dst );
+    JIT_EMIT( 0x48, 0x0f, 0xc8 );                                      /* bswap rax */
+    break;
+  default:
+    return p;
+  }
+  return jit_rm( p, 1, 0x89, RAX, RBX, dst );
+}
+
+/* jit_xlat emits the translation of the sz byte access at the vm
+   address in rax into a host address in rcx, exactly as checked by
+   fd_vm_translate_vm_to_host.  On an access violation, it jumps to the
+   stub of the instruction (the two jumps are recorded in fixup). */
+
+static uchar *
+jit_xlat( uchar *             p,
+          uchar const *       code,
+          uint                sz,
+          int                 write,
+          fd_vm_jit_fixup_t * fixup ) {
+  int tab = write ? FD_VM_JIT_REGION_WRITE : 0;
+  JIT_EMIT( 0x48, 0x89, 0xc2,                                          /* mov rdx, rax */
+            0x48, 0xc1, 0xea, 0x20,                                    /* shr rdx, 32 */
+            0x48, 0x83, 0xfa, FD_VM_MEM_MAP_REGION_TAB_CNT-1UL );      /* cmp rdx, 7 */
+  p = jit_jcc( p, CC_A );    fixup->stub_patch[ fixup->stub_cnt++ ] = (uint)(p-4-code);
+  JIT_EMIT( 0x89, 0xc1 );                                              /* mov ecx, eax */
+  p = jit_rm( p, 1, 0x8d, RSI, RCX, (int)sz );                         /* lea rsi, [rcx+sz] */
+  JIT_EMIT( 0x48, 0xc1, 0xe2, 0x04 );                                  /* shl rdx, 4 */
+  p = jit_rmi( p, 1, 0x3b, RSI, R14, RDX, tab+8 );                     /* cmp rsi, [r14+rdx+limit] */
+  p = jit_jcc( p, CC_AE );   fixup->stub_patch[ fixup->stub_cnt++ ] = (uint)(p-4-code);
+  p = jit_rmi( p, 1, 0x03, RCX, R14, RDX, tab   );                     /* add rcx, [r14+rdx+base] */
+  fixup->stub_kind = STUB_FAULT;
+  return p;
+}
+
+/* jit_mark_dirty emits, right after the jit_xlat of a write, the
+   equivalent of fd_vm_mem_map_mark_dirty: it raises the dirty high
+   water mark of the region (rdx/16) to the end of the access (rsi). */
+
+static uchar *
+jit_mark_dirty( uchar * p ) {
+  JIT_EMIT( 0x48, 0xd1, 0xea );                                        /* shr rdx, 1 */
+  p = jit_rmi( p, 1, 0x3b, RSI, R13, RDX, CTX_OFF_DIRTY );             /* cmp rsi, [r13+rdx+dirty_sz] */
+  JIT_EMIT( 0x76, 0x08 );                                              /* jbe 1f */
+  p = jit_rmi( p, 1, 0x89, RSI, R13, RDX, CTX_OFF_DIRTY );             /* mov [r13+rdx+dirty_sz], rsi; 1: */
+  return p;
+}
+
+/* jit_mem emits a LDX, ST or STX class instruction. */
+
+static uchar *
+jit_mem( uchar *             p,
+         uchar const *       code,
+         uint                opcode,
+         fd_sbpf_instr_t     instr,
+         fd_vm_jit_fixup_t * fixup ) {
+  uint cls = opcode&7U;
+  static uchar const sz_tab[4] = { 4, 2, 1, 8 }; /* W, H, B, DW */
+  uint sz  = sz_tab[ (opcode>>3)&3U ];
+
+  /* rax = vm address */
+
+  p = jit_rm( p, 1, 0x8b, RAX, RBX, REG_OFF( cls==1U ? instr.src_reg : instr.dst_reg ) );
+  if( instr.offset ) { p = jit_op( p, 1, 0x05, 0, 0, 0 ); p = jit_imm32( p, (uint)(int)instr.offset ); } /* add rax, simm32 */
+
+  p = jit_xlat( p, code, sz, cls!=1U, fixup );
+  if( cls!=1U ) p = jit_mark_dirty( p );
+
+  switch( cls ) {
+  case 1U: /* LDX */
+    switch( sz ) {
+    case 1U: p = jit_rm( p, 0, 0x0fb6, RAX, RCX, 0 ); break;
+    case 2U: p = jit_rm( p, 0, 0x0fb7, RAX, RCX, 0 ); break;
+    case 4U: p = jit_rm( p, 0, 0x8b,   RAX, RCX, 0 ); break;
+    default: p = jit_rm( p, 1, 0x8b,   RAX, RCX, 0 ); break;
+    }
+    p = jit_rm( p, 1, 0x89, RAX, RBX, REG_OFF( instr.dst_reg ) );
+    break;
+  case 2U: /* ST */
+    switch( sz ) {
+    case 1U: p = jit_rm( p, 0, 0xc6, 0, RCX, 0 ); *p++ = (uchar)instr.imm; break;
+    case 2U: *p++ = (uchar)0x66; p = jit_rm( p, 0, 0xc7, 0, RCX, 0 ); FD_STORE( ushort, p, (ushort)instr.imm ); p += 2; break;
+    case 4U: p = jit_rm( p, 0, 0xc7, 0, RCX, 0 ); p = jit_imm32( p, instr.imm ); break;
+    default: p = jit_mov_imm32( p, RAX, instr.imm ); p = jit_rm( p, 1, 0x89, RAX, RCX, 0 ); break;
+    }
+    break;
+  default: /* STX */
+    p = jit_rm( p, 1, 0x8b, RAX, RBX, REG_OFF( instr.src_reg ) );
+    switch( sz ) {
+    case 1U: p = jit_rm( p, 0, 0x88, RAX, RCX, 0 ); break;
+    case 2U: *p++ = (uchar)0x66; p = jit_rm( p, 0, 0x89, RAX, RCX, 0 ); break;
+    case 4U: p = jit_rm( p, 0, 0x89, RAX, RCX, 0 ); break;
+    default: p = jit_rm( p, 1, 0x89, RAX, RCX, 0 ); break;
+    }
+    break;
+  }
+  return p;
+}
+
+/* jit_call_c emits a call to the C function fn (the arguments are
+   expected in place and the stack is 16 byte aligned in the body of the
+   generated code). */
+
+static uchar *
+jit_call_c( uchar * p,
+            ulong   fn ) {
+  p = jit_mov_imm64( p, RAX, fn );
+  JIT_EMIT( 0xff, 0xd0 );                                              /* call rax */
+  return p;
+}
+
+/* Helpers called by the generated code for the parts of calls and
+   returns that need the shadow stack.  These mirror the interpreter. */
+
+static void
+fd_vm_jit_private_push( fd_vm_exec_context_t * ctx,
+                        ulong                  pc ) {
+  // FIXME: stack overflow fault (as in the interpreter).
+  fd_vm_stack_push( &ctx->stack, pc, &ctx->register_file[6] );
+}
+
+static ulong
+fd_vm_jit_private_pop( fd_vm_exec_context_t * ctx ) {
+  ulong pc = 0UL;
+  fd_vm_stack_pop( &ctx->stack, &pc, &ctx->register_file[6] );
+  return pc;
+}
+
+/* fd_vm_jit_private_call_reg implements CALL_REG for the instruction
+   at pc.  Stores the updated pc and the fault condition in ctx and
+   returns the fault condition. */
+
+static ulong
+fd_vm_jit_private_call_reg( fd_vm_exec_context_t * ctx,
+                            ulong                  _pc,
+                            ulong                  imm ) {
+  ulong * register_file = ctx->register_file;
+  long    pc            = (long)_pc;
+  ulong   cond_fault    = 0UL;
+
+  if( FD_UNLIKELY( imm>=11UL ) ) {
+    cond_fault = 1UL;
+  } else {
+    ulong call_addr  = register_file[imm];
+    ulong mem_region = call_addr & FD_VM_MEM_MAP_REGION_MASK;
+    if( mem_region==FD_VM_MEM_MAP_PROGRAM_REGION_START ) {
+      ulong start_addr = call_addr & FD_VM_MEM_MAP_REGION_SZ;
+      register_file[10] += 0x2000;
+      cond_fault = fd_vm_stack_push( &ctx->stack, (ulong)pc, &register_file[6] );
+      pc = (long)((start_addr / 8UL)-1);
+      pc -= (long)ctx->instrs_offset;
+    } else {
+      fd_sbpf_syscalls_t * syscall_entry = ctx->syscall_map ? fd_sbpf_syscalls_query( ctx->syscall_map, (uint)register_file[imm], NULL ) : NULL;
+      if( syscall_entry==NULL ) {
+        fd_sbpf_calldests_t * calldest_entry = ctx->local_call_map ? fd_sbpf_calldests_query( ctx->local_call_map, register_file[imm], NULL ) : NULL;
+        if( calldest_entry!=NULL ) {
+          register_file[10] += 0x2000;
+          cond_fault = fd_vm_stack_push( &ctx->stack, (ulong)pc, &register_file[6] );
+          pc = (long)(calldest_entry->pc-1);
+        } else {
+          cond_fault = 1UL;
+        }
+      } else {
+        /* Note: arg0 is r2, as in the interpreter */
+        cond_fault = ((fd_vm_syscall_fn_ptr_t)( syscall_entry->func_ptr ))(ctx, register_file[2], register_file[2], register_file[3], register_file[4], register_file[5], &register_file[0]);
+      }
+    }
+  }
+
+  ctx->program_counter = (ulong)pc;
+  ctx->cond_fault      = cond_fault;
+  return cond_fault;
+}
+
+fd_vm_jit_prog_t *
+fd_vm_jit_compile( fd_vm_exec_context_t const * ctx ) {
+
+  ulong instrs_sz = ctx->instrs_sz;
+  if( FD_UNLIKELY( (!instrs_sz) | (instrs_sz>FD_VM_JIT_INSTRS_MAX) ) ) {
+    FD_LOG_WARNING(( "unsupported program size (%lu instructions)", instrs_sz ));
+    return NULL;
+  }
+
+  ulong page_sz  = FD_SHMEM_NORMAL_PAGE_SZ;
+  ulong tab_off  = fd_ulong_align_up( sizeof(fd_vm_jit_prog_t), 64UL );
+  ulong code_off = fd_ulong_align_up( tab_off + (instrs_sz+1UL)*sizeof(ulong), 64UL );
+  ulong code_max = FD_VM_JIT_HDR_CODE_MAX + (instrs_sz+1UL)*(FD_VM_JIT_INSTR_CODE_MAX+FD_VM_JIT_STUB_CODE_MAX);
+  ulong map_sz   = fd_ulong_align_up( code_off + code_max, page_sz );
+  ulong fixup_sz = fd_ulong_align_up( instrs_sz*sizeof(fd_vm_jit_fixup_t), page_sz );
+
+  uchar * mem = mmap( NULL, map_sz, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0 );
+  if( FD_UNLIKELY( mem==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(NULL,%lu KiB) failed (%i-%s)", map_sz>>10, errno, strerror( errno ) ));
+    return NULL;
+  }
+
+  fd_vm_jit_fixup_t * fixup = mmap( NULL, fixup_sz, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0 );
+  if( FD_UNLIKELY( fixup==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(NULL,%lu KiB) failed (%i-%s)", fixup_sz>>10, errno, strerror( errno ) ));
+    munmap( mem, map_sz );
+    return NULL;
+  }
+
+  fd_vm_jit_prog_t * prog = (fd_vm_jit_prog_t *)mem;
+  ulong *            tab  = (ulong *)(mem + tab_off);
+  uchar *            code = mem + code_off;
+  uchar *            p    = code;
+
+  fd_sbpf_instr_t const * instrs = ctx->instrs;
+
+  /* Shared epilogue: stores the instruction counter and returns.  The
+     pc and fault condition are stored by whoever jumps here. */
+
+  uchar const * epilogue = p;
+  p = jit_rm( p, 1, 0x89, R12, R13, CTX_OFF_IC );                      /* mov [r13+ic], r12 */
+  JIT_EMIT( 0x48, 0x83, 0xc4, 0x08,                                    /* add rsp, 8 */
+            0x41, 0x5f, 0x41, 0x5e, 0x41, 0x5d, 0x41, 0x5c,            /* pop r15; pop r14; pop r13; pop r12 */
+            0x5d, 0x5b, 0xc3 );                                        /* pop rbp; pop rbx; ret */
+
+  /* Dynamic jumps to a pc outside the program (from the entrypoint,
+     CALL_REG or EXIT) land here with the pc in rax. */
+
+  uchar const * dyn_oob = p;
+  p = jit_rm( p, 1, 0x89, RAX, R13, CTX_OFF_PC );                      /* mov [r13+pc], rax */
+  p = jit_rm( p, 1, 0xc7, 0,   R13, CTX_OFF_FAULT ); p = jit_imm32( p, 1U );
+  p = jit_jcc( p, -1 ); jit_patch( p-4, epilogue );
+
+  /* Entry point (see fd_vm_jit_entry_fn_t) */
+
+  uchar const * entry = p;
+  JIT_EMIT( 0x53, 0x55, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57, /* push rbx, rbp, r12, r13, r14, r15 */
+            0x48, 0x83, 0xec, 0x08 );                                   /* sub rsp, 8 */
+  p = jit_rr( p, 1, 0x89, RDI, R13 );                                  /* mov r13, rdi */
+  p = jit_rr( p, 1, 0x89, RSI, R14 );                                  /* mov r14, rsi */
+  p = jit_rr( p, 1, 0x89, RDX, R12 );                                  /* mov r12, rdx */
+  p = jit_rr( p, 1, 0x89, RCX, R15 );                                  /* mov r15, rcx */
+  p = jit_rm( p, 1, 0x8d, RBX, R13, CTX_OFF_REGS );                    /* lea rbx, [r13+register_file] */
+  JIT_EMIT( 0x4c, 0x89, 0xc0 );                                        /* mov rax, r8 */
+  p = jit_jmp_dyn( p, instrs_sz, dyn_oob );
+
+  /* Program body */
+
+  for( ulong pc=0UL; pc<instrs_sz; pc++ ) {
+    fd_sbpf_instr_t     instr  = instrs[pc];
+    uint                opcode = instr.opcode.raw;
+    fd_vm_jit_fixup_t * fx     = &fixup[pc];
+    uchar const *       start  = p;
+
+    tab[pc] = (ulong)(p - code);
+
+    /* Jump targets relative to this instruction, as computed by the
+       interpreter (which increments pc after every instruction). */
+
+    long target = (long)pc + 1L + (long)instr.offset;
+
+    switch( opcode ) {
+
+    /* ALU and ALU64 (0x00 is the second half of an LDQ, which the
+       interpreter executes as ADD_IMM if it ever gets there) */
+
+    case 0x00: opcode = 0x04U; __attribute__((fallthrough));
+    case 0x04: case 0x0c: case 0x14: case 0x1c: case 0x24: case 0x2c: case 0x34: case 0x3c:
+    case 0x44: case 0x4c: case 0x54: case 0x5c: case 0x64: case 0x6c: case 0x74: case 0x7c:
+    case 0x84: case 0x94: case 0x9c: case 0xa4: case 0xac: case 0xb4: case 0xbc: case 0xc4: case 0xcc:
+    case 0x07: case 0x0f: case 0x17: case 0x1f: case 0x27: case 0x2f: case 0x37: case 0x3f:
+    case 0x47: case 0x4f: case 0x57: case 0x5f: case 0x67: case 0x6f: case 0x77: case 0x7f:
+    case 0x87: case 0x97: case 0x9f: case 0xa7: case 0xaf: case 0xb7: case 0xbf: case 0xc7: case 0xcf:
+      p = jit_alu( p, opcode, instr );
+      p = jit_inc_ic( p );
+      break;
+
+    case 0xd4: case 0xdc: /* END_LE, END_BE */
+      p = jit_end( p, opcode, instr );
+      p = jit_inc_ic( p );
+      break;
+
+    case 0x18: { /* LDQ */
+      if( FD_UNLIKELY( pc+1UL>=instrs_sz ) ) {
+        FD_LOG_WARNING(( "incomplete LDQ at pc %lu", pc ));
+        goto fail;
+      }
+      ulong imm = (ulong)instr.imm | ((ulong)instrs[pc+1UL].imm << 32);
+      p = jit_mov_imm64( p, RAX, imm );
+      p = jit_rm( p, 1, 0x89, RAX, RBX, REG_OFF( instr.dst_reg ) );
+      p = jit_inc_ic( p );
+      p = jit_jcc( p, -1 );
+      target = (long)pc + 2L;
+      fx->label_patch = (uint)(p-4-code); fx->label_pc = (uint)target;
+      break;
+    }
+
+    /* Memory */
+
+    case 0x61: case 0x69: case 0x71: case 0x79: /* LDX */
+    case 0x62: case 0x6a: case 0x72: case 0x7a: /* ST  */
+    case 0x63: case 0x6b: case 0x73: case 0x7b: /* STX */
+      p = jit_mem( p, code, opcode, instr, fx );
+      p = jit_inc_ic( p );
+      break;
+
+    /* Jumps */
+
+    case 0x05: /* JA */
+      if( FD_UNLIKELY( (target<0L) | (target>(long)instrs_sz) ) ) goto bad_jump;
+      p = jit_inc_ic( p );
+      p = jit_jcc( p, -1 );
+      fx->label_patch = (uint)(p-4-code); fx->label_pc = (uint)target;
+      break;
+
+    case 0x15: case 0x1d: case 0x25: case 0x2d: case 0x35: case 0x3d: case 0x45: case 0x4d:
+    case 0x55: case 0x5d: case 0x65: case 0x6d: case 0x75: case 0x7d: case 0xa5: case 0xad:
+    case 0xb5: case 0xbd: case 0xc5: case 0xcd: case 0xd5: case 0xdd: {
+      static schar const cc_tab[16] = {
+        -1, CC_E, CC_A, CC_AE, CC_NE, CC_NE, CC_G, CC_GE, -1, -1, CC_B, CC_BE, CC_L, CC_LE, -1, -1
+      };
+      if( FD_UNLIKELY( (target<0L) | (target>(long)instrs_sz) ) ) goto bad_jump;
+      p = jit_rm( p, 1, 0x8b, RAX, RBX, REG_OFF( instr.dst_reg ) );
+      if( opcode&8U )        p = jit_rm( p, 1, 0x8b, RCX, RBX, REG_OFF( instr.src_reg ) );
+      else if( opcode==0x65) { p = jit_rr( p, 1, 0xc7, 0, RCX ); p = jit_imm32( p, instr.imm ); } /* JSGT_IMM sign extends */
+      else                   p = jit_mov_imm32( p, RCX, instr.imm );
+      p = jit_inc_ic( p );
+      p = jit_rr( p, 1, (opcode>>4)==0x4U ? 0x85U : 0x39U, RCX, RAX ); /* test / cmp rax, rcx */
+      p = jit_jcc( p, cc_tab[ opcode>>4 ] );
+      fx->label_patch = (uint)(p-4-code); fx->label_pc = (uint)target;
+      break;
+    }
+
+    case 0x85: { /* CALL_IMM */
+      if( instr.imm<instrs_sz ) {
+        p = jit_inc_ic( p );
+        p = jit_jcc( p, -1 );
+        fx->label_patch = (uint)(p-4-code); fx->label_pc = instr.imm+1U;
+        break;
+      }
+      fd_sbpf_syscalls_t * syscall = ctx->syscall_map ? fd_sbpf_syscalls_query( ctx->syscall_map, instr.imm, NULL ) : NULL;
+      if( syscall ) {
+        p = jit_rr( p, 1, 0x89, R13, RDI );                            /* mov rdi, r13 */
+        p = jit_rm( p, 1, 0x8b, RSI, RBX, REG_OFF( 1 ) );              /* rsi..r9 = r1..r5 */
+        p = jit_rm( p, 1, 0x8b, RDX, RBX, REG_OFF( 2 ) );
+        p = jit_rm( p, 1, 0x8b, RCX, RBX, REG_OFF( 3 ) );
+        p = jit_rm( p, 1, 0x8b, 8,   RBX, REG_OFF( 4 ) );
+        p = jit_rm( p, 1, 0x8b, 9,   RBX, REG_OFF( 5 ) );
+        JIT_EMIT( 0x48, 0x83, 0xec, 0x10 );                            /* sub rsp, 16 */
+        p = jit_rm( p, 1, 0x89, RBX, RSP, 0 );                         /* mov [rsp], rbx (&r0) */
+        p = jit_call_c( p, (ulong)syscall->func_ptr );
+        JIT_EMIT( 0x48, 0x83, 0xc4, 0x10,                              /* add rsp, 16 */
+                  0x48, 0x85, 0xc0 );                                  /* test rax, rax */
+        p = jit_jcc( p, CC_NE );
+        fx->stub_patch[ fx->stub_cnt++ ] = (uint)(p-4-code); fx->stub_kind = STUB_FAULT_RAX;
+        p = jit_inc_ic( p );
+        break;
+      }
+      fd_sbpf_calldests_t * calldest = ctx->local_call_map ? fd_sbpf_calldests_query( ctx->local_call_map, instr.imm, NULL ) : NULL;
+      if( calldest ) {
+        p = jit_rm( p, 1, 0x81, 0, RBX, REG_OFF( 10 ) ); p = jit_imm32( p, 0x2000U ); /* add r10, 0x2000 */
+        p = jit_rr( p, 1, 0x89, R13, RDI );
+        p = jit_mov_imm32( p, RSI, (uint)pc );
+        p = jit_call_c( p, (ulong)fd_vm_jit_private_push );
+        p = jit_inc_ic( p );
+        p = jit_jcc( p, -1 );
+        fx->label_patch = (uint)(p-4-code); fx->label_pc = (uint)fd_ulong_min( calldest->pc, instrs_sz );
+        break;
+      }
+      /* Unknown function */
+      p = jit_jcc( p, -1 );
+      fx->stub_patch[ fx->stub_cnt++ ] = (uint)(p-4-code); fx->stub_kind = STUB_FAULT;
+      break;
+    }
+
+    case 0x8d: /* CALL_REG */
+      p = jit_rr( p, 1, 0x89, R13, RDI );
+      p = jit_mov_imm32( p, RSI, (uint)pc );
+      p = jit_mov_imm32( p, RDX, instr.imm );
+      p = jit_call_c( p, (ulong)fd_vm_jit_private_call_reg );
+      JIT_EMIT( 0x48, 0x85, 0xc0 );                                    /* test rax, rax */
+      p = jit_jcc( p, CC_NE ); jit_patch( p-4, epilogue );
+      p = jit_inc_ic( p );
+      p = jit_rm( p, 1, 0x8b, RAX, R13, CTX_OFF_PC );
+      JIT_EMIT( 0x48, 0xff, 0xc0 );                                    /* inc rax */
+      p = jit_jmp_dyn( p, instrs_sz, dyn_oob );
+      break;
+
+    case 0x95: /* EXIT */
+      p = jit_rm( p, 1, 0x81, 5, RBX, REG_OFF( 10 ) ); p = jit_imm32( p, 0x2000U ); /* sub r10, 0x2000 */
+      p = jit_rm( p, 1, 0x83, 7, R13, CTX_OFF_FRAMES ); *p++ = (uchar)0;           /* cmp [r13+frames_used], 0 */
+      p = jit_jcc( p, CC_E );
+      fx->stub_patch[ fx->stub_cnt++ ] = (uint)(p-4-code); fx->stub_kind = STUB_EXIT;
+      p = jit_rr( p, 1, 0x89, R13, RDI );
+      p = jit_call_c( p, (ulong)fd_vm_jit_private_pop );
+      p = jit_inc_ic( p );
+      JIT_EMIT( 0x48, 0xff, 0xc0 );                                    /* inc rax */
+      p = jit_jmp_dyn( p, instrs_sz, dyn_oob );
+      break;
+
+    default:
+      /* Not an instruction the interpreter implements */
+      p = jit_jcc( p, -1 );
+      fx->stub_patch[ fx->stub_cnt++ ] = (uint)(p-4-code); fx->stub_kind = STUB_FAULT;
+      break;
+    }
+
+    if( FD_UNLIKELY( (ulong)(p-start)>FD_VM_JIT_INSTR_CODE_MAX ) )
+      FD_LOG_CRIT(( "code for instruction 0x%02x too large (%lu bytes)", opcode, (ulong)(p-start) ));
+    continue;
+
+  bad_jump:
+    FD_LOG_WARNING(( "jump out of bounds at pc %lu", pc ));
+    goto fail;
+  }
+
+  /* Running past the end of the program faults */
+
+  tab[instrs_sz] = (ulong)(p - code);
+  p = jit_rm( p, 1, 0xc7, 0, R13, CTX_OFF_PC    ); p = jit_imm32( p, (uint)instrs_sz );
+  p = jit_rm( p, 1, 0xc7, 0, R13, CTX_OFF_FAULT ); p = jit_imm32( p, 1U );
+  p = jit_jcc( p, -1 ); jit_patch( p-4, epilogue );
+
+  /* Out of line stubs and jumps between instructions */
+
+  for( ulong pc=0UL; pc<instrs_sz; pc++ ) {
+    fd_vm_jit_fixup_t const * fx = &fixup[pc];
+    if( fx->label_patch ) jit_patch( code + fx->label_patch, code + tab[ fx->label_pc ] );
+    if( fx->stub_kind==STUB_NONE ) continue;
+
+    uchar const * stub = p;
+    if( fx->stub_kind==STUB_FAULT_RAX ) {
+      p = jit_rm( p, 1, 0x89, RAX, R13, CTX_OFF_FAULT );
+    } else {
+      p = jit_rm( p, 1, 0xc7, 0, R13, CTX_OFF_FAULT ); p = jit_imm32( p, fx->stub_kind==STUB_FAULT );
+    }
+    p = jit_rm( p, 1, 0xc7, 0, R13, CTX_OFF_PC ); p = jit_imm32( p, (uint)pc );
+    p = jit_jcc( p, -1 ); jit_patch( p-4, epilogue );
+    for( uint i=0U; i<fx->stub_cnt; i++ ) jit_patch( code + fx->stub_patch[i], stub );
+  }
+
+  for( ulong pc=0UL; pc<=instrs_sz; pc++ ) tab[pc] = (ulong)code + tab[pc];
+
+  ulong code_sz = (ulong)(p - code);
+  if( FD_UNLIKELY( code_sz>code_max ) ) FD_LOG_CRIT(( "generated code overflowed its buffer" ));
+
+  if( FD_UNLIKELY( munmap( fixup, fixup_sz ) ) )
+    FD_LOG_WARNING(( "munmap failed (%i-%s); attempting to continue", errno, strerror( errno ) ));
+
+  /* Release the unused tail and make the code executable */
+
+  ulong used_sz = fd_ulong_align_up( code_off + code_sz, page_sz );
+  if( used_sz<map_sz ) {
+    if( FD_UNLIKELY( munmap( mem+used_sz, map_sz-used_sz ) ) )
+      FD_LOG_WARNING(( "munmap failed (%i-%s); attempting to continue", errno, strerror( errno ) ));
+    else
+      map_sz = used_sz;
+  }
+
+  prog->map_sz  = map_sz;
+  prog->code_sz = code_sz;
+  prog->pc_tab  = tab;
+  union { void const * p; fd_vm_jit_entry_fn_t fn; } e = { .p = entry };
+  prog->entry   = e.fn;
+
+  if( FD_UNLIKELY( mprotect( mem, map_sz, PROT_READ|PROT_EXEC ) ) ) {
+    FD_LOG_WARNING(( "mprotect failed (%i-%s)", errno, strerror( errno ) ));
+    munmap( mem, map_sz );
+    return NULL;
+  }
+
+  return prog;
+
+fail:
+  munmap( fixup, fixup_sz );
+  munmap( mem,   map_sz   );
+  return NULL;
+}
+
+ulong
+fd_vm_jit_exec( fd_vm_exec_context_t *   ctx,
+                fd_vm_jit_prog_t const * prog ) {
+
+  fd_vm_mem_map_region_tab_init( ctx );
+
+  /* As in the interpreter, only r0 is cleared */
+  ctx->register_file[0] = 0UL;
+  ctx->cond_fault       = 0UL;
+
+  prog->entry( ctx, ctx->region_tab[0], ctx->instruction_counter, prog->pc_tab, (ulong)ctx->entrypoint );
+
+  /* Stores raise ctx->dirty_sz themselves (see jit_mark_dirty) */
+
+  // FIXME: Actual errors!
+  return 0UL;
+}
+
+ulong
+fd_vm_jit_code_sz( fd_vm_jit_prog_t const * prog ) {
+  return prog->code_sz;
+}
+
+void
+fd_vm_jit_delete( fd_vm_jit_prog_t * prog ) {
+  if( FD_UNLIKELY( !prog ) ) return;
+  if( FD_UNLIKELY( munmap( prog, prog->map_sz ) ) )
+    FD_LOG_WARNING(( "munmap failed (%i-%s)", errno, strerror( errno ) ));
+}
+
+#endif /* FD_HAS_X86 && FD_HAS_HOSTED */
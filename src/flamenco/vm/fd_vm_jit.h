@@ -0,0 +1,75 @@
+#ifndef HEADER_fd_src_flamenco_vm_fd_vm_jit_h
+#define HEADER_fd_src_flamenco_vm_fd_vm_jit_h
+
+/* fd_vm_jit translates a validated sBPF program into x86-64 machine
+   code, as an alternative to fd_vm_interp_instrs for programs that are
+   run many times.
+
+   The generated code executes with exactly the semantics of the
+   interpreter: the sBPF register file stays in ctx->register_file,
+   ctx->instruction_counter is advanced by one for every instruction
+   that completes, every load and store is checked against the same
+   regions (and with the same bounds) as fd_vm_translate_vm_to_host,
+   and calls into syscalls go through the same fd_vm_syscall_fn_ptr_t
+   handlers that are registered in ctx->syscall_map.  On return, the
+   program counter, instruction counter, register file and fault
+   condition in ctx are the same as the interpreter would have left
+   them.
+
+   The compiled code lives in its own anonymous mapping, which is never
+   writable and executable at the same time.  This requires a hosted
+   x86-64 target. */
+
+#include "fd_vm_context.h"
+
+/* FD_VM_JIT_INSTRS_MAX is the largest number of instructions in a
+   program that fd_vm_jit_compile will translate.  This keeps the size
+   of the generated code bounded (a few hundred MiB in the worst case)
+   and every pc representable as an imm32. */
+
+#define FD_VM_JIT_INSTRS_MAX (1UL<<22)
+
+struct fd_vm_jit_prog;
+typedef struct fd_vm_jit_prog fd_vm_jit_prog_t;
+
+FD_PROTOTYPES_BEGIN
+
+#if FD_HAS_X86 && FD_HAS_HOSTED
+
+/* fd_vm_jit_compile translates the ctx->instrs_sz instructions of the
+   program in ctx (which should have passed fd_vm_context_validate) to
+   native code.  Calls to syscalls and local functions by immediate are
+   resolved against ctx->syscall_map and ctx->local_call_map at this
+   point, so the maps should not change while the program is in use.
+   Returns a handle to the compiled program on success and NULL on
+   failure (logs details). */
+
+fd_vm_jit_prog_t *
+fd_vm_jit_compile( fd_vm_exec_context_t const * ctx );
+
+/* fd_vm_jit_exec runs the compiled program prog (as returned by
+   fd_vm_jit_compile for ctx's program) from ctx->entrypoint until
+   completion or a fault occurs.  The result is the same as that of
+   fd_vm_interp_instrs.  Returns success or an error/fault code. */
+
+ulong
+fd_vm_jit_exec( fd_vm_exec_context_t *   ctx,
+                fd_vm_jit_prog_t const * prog );
+
+/* fd_vm_jit_code_sz returns the number of bytes of machine code
+   generated for prog. */
+
+FD_FN_PURE ulong
+fd_vm_jit_code_sz( fd_vm_jit_prog_t const * prog );
+
+/* fd_vm_jit_delete releases the memory of a compiled program.  prog
+   must not be in use by any fd_vm_jit_exec. */
+
+void
+fd_vm_jit_delete( fd_vm_jit_prog_t * prog );
+
+#endif /* FD_HAS_X86 && FD_HAS_HOSTED */
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_vm_fd_vm_jit_h */
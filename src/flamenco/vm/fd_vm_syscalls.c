@@ -491,17 +491,38 @@ fd_vm_syscall_sol_invoke_signed_rust(
   return FD_VM_SYSCALL_ERR_UNIMPLEMENTED;
 }
 
+/* sol_alloc_free_ is the bump allocator of the heap region: a call
+   with a zero free_addr returns the VM address of sz bytes of the heap
+   aligned to 8 (or 0 if the heap is exhausted), and frees are ignored.
+   The heap is zeroed between invocations (see fd_vm_context_reset), so
+   allocations always start out zeroed. */
+
 ulong
 fd_vm_syscall_sol_alloc_free(
-    FD_FN_UNUSED void * _ctx,
-    FD_FN_UNUSED ulong arg0,
-    FD_FN_UNUSED ulong arg1,
+    void * _ctx,
+    ulong sz,
+    ulong free_addr,
     FD_FN_UNUSED ulong arg2,
     FD_FN_UNUSED ulong arg3,
     FD_FN_UNUSED ulong arg4,
-    FD_FN_UNUSED ulong * ret
+    ulong * ret
 ) {
-  return FD_VM_SYSCALL_ERR_UNIMPLEMENTED;
+  fd_vm_exec_context_t * ctx = (fd_vm_exec_context_t *) _ctx;
+
+  if( free_addr ) {
+    *ret = 0UL;
+    return FD_VM_SYSCALL_SUCCESS;
+  }
+
+  ulong off = fd_ulong_align_up( ctx->heap_alloc_off, 8UL );
+  if( off>ctx->heap_sz || sz>ctx->heap_sz-off ) {
+    *ret = 0UL;
+    return FD_VM_SYSCALL_SUCCESS;
+  }
+
+  ctx->heap_alloc_off = off + sz;
+  *ret = FD_VM_MEM_MAP_HEAP_REGION_START + off;
+  return FD_VM_SYSCALL_SUCCESS;
 }
 
 ulong
@@ -153,6 +153,9 @@ read_input_file( char const * input_path, ulong * _input_sz ) {
   return input_buf;
 }
 
+/* The heap region of the programs run by the tool */
+static uchar heap[ FD_VM_HEAP_SZ ];
+
 int cmd_trace( char const * bin_path, char const * input_path ) {
 
   fd_vm_tool_prog_t tool_prog;
@@ -178,6 +181,8 @@ int cmd_trace( char const * bin_path, char const * input_path ) {
     .input               = input,
     .input_sz            = input_sz,
     .read_only           = (uchar *)fd_type_pun_const(tool_prog.prog->rodata),
+    .heap                = heap,
+    .heap_sz             = FD_VM_HEAP_SZ,
     .read_only_sz        = tool_prog.prog->rodata_sz
   };
 
@@ -247,6 +252,8 @@ int cmd_run( char const * bin_path, char const * input_path ) {
     .input               = input,
     .input_sz            = input_sz,
     .read_only           = (uchar *)fd_type_pun_const(tool_prog.prog->rodata),
+    .heap                = heap,
+    .heap_sz             = FD_VM_HEAP_SZ,
     .read_only_sz        = tool_prog.prog->rodata_sz
   };
 
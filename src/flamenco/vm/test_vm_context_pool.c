@@ -0,0 +1,169 @@
+#include "../fd_flamenco_base.h"
+#include "fd_vm_context_pool.h"
+#include "fd_vm_interp.h"
+#include "fd_vm_syscalls.h"
+#include "../../ballet/murmur3/fd_murmur3.h"
+#include "../../ballet/sbpf/fd_sbpf_maps.c"
+#include "../../ballet/sbpf/fd_sbpf_opcodes.h"
+
+#define CTX_MAX  (4UL)
+#define HEAP_MAX (FD_VM_HEAP_SZ_MAX)
+
+static uchar syscalls_mem[ sizeof(fd_sbpf_syscalls_t) << 12 ] __attribute__((aligned(64)));
+
+/* A program that allocates 100 bytes and then 8 more with the bump
+   allocator, writes to both allocations and to the top of its stack
+   frame, and returns the address of the second allocation */
+
+static fd_sbpf_instr_t prog[] = {
+  FD_SBPF_INSTR( FD_SBPF_OP_MOV64_IMM, FD_SBPF_R1, 0,          0,   100          ),
+  FD_SBPF_INSTR( FD_SBPF_OP_MOV64_IMM, FD_SBPF_R2, 0,          0,   0            ),
+  FD_SBPF_INSTR( FD_SBPF_OP_CALL_IMM,  0,          0,          0,   0x83f00e8f   ), /* sol_alloc_free_ */
+  FD_SBPF_INSTR( FD_SBPF_OP_MOV64_REG, FD_SBPF_R6, FD_SBPF_R0, 0,   0            ),
+  FD_SBPF_INSTR( FD_SBPF_OP_STDW,      FD_SBPF_R6, 0,          96,  0x11223344   ),
+  FD_SBPF_INSTR( FD_SBPF_OP_MOV64_IMM, FD_SBPF_R1, 0,          0,   8            ),
+  FD_SBPF_INSTR( FD_SBPF_OP_MOV64_IMM, FD_SBPF_R2, 0,          0,   0            ),
+  FD_SBPF_INSTR( FD_SBPF_OP_CALL_IMM,  0,          0,          0,   0x83f00e8f   ), /* sol_alloc_free_ */
+  FD_SBPF_INSTR( FD_SBPF_OP_STXDW,     FD_SBPF_R0, FD_SBPF_R6, 0,   0            ),
+  FD_SBPF_INSTR( FD_SBPF_OP_STXDW,     FD_SBPF_R10,FD_SBPF_R6, -8,  0            ),
+  FD_SBPF_INSTR( FD_SBPF_OP_EXIT,      0,          0,          0,   0            ),
+};
+
+static void
+run_prog( fd_vm_exec_context_t * ctx,
+          fd_sbpf_syscalls_t *   syscalls ) {
+  ctx->instrs            = prog;
+  ctx->instrs_sz         = sizeof(prog)/sizeof(fd_sbpf_instr_t);
+  ctx->syscall_map       = syscalls;
+  ctx->register_file[10] = FD_VM_MEM_MAP_STACK_REGION_START + 0x1000;
+  FD_TEST( fd_vm_context_validate( ctx )==FD_VM_SBPF_VALIDATE_SUCCESS );
+  fd_vm_interp_instrs( ctx );
+}
+
+static int
+is_zero( uchar const * p,
+         ulong         sz ) {
+  for( ulong i=0UL; i<sz; i++ ) if( p[i] ) return 0;
+  return 1;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "normal" );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 4096UL   );
+  ulong        iter_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt", NULL, 10000UL  );
+
+  FD_TEST( !fd_vm_context_pool_footprint( 0UL,     HEAP_MAX     ) );
+  FD_TEST( !fd_vm_context_pool_footprint( CTX_MAX, HEAP_MAX+1UL ) );
+  FD_TEST(  fd_vm_context_pool_footprint( CTX_MAX, 0UL          ) );
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, fd_log_cpu_id(), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  ulong footprint = fd_vm_context_pool_footprint( CTX_MAX, HEAP_MAX );
+  FD_LOG_NOTICE(( "Creating pool (ctx_max %lu, heap_max %lu, footprint %lu)", CTX_MAX, (ulong)HEAP_MAX, footprint ));
+  void *                 mem  = fd_wksp_alloc_laddr( wksp, fd_vm_context_pool_align(), footprint, 1UL );  FD_TEST( mem  );
+  fd_vm_context_pool_t * pool = fd_vm_context_pool_join( fd_vm_context_pool_new( mem, CTX_MAX, HEAP_MAX ) ); FD_TEST( pool );
+
+  FD_TEST( fd_vm_context_pool_ctx_max ( pool )==CTX_MAX  );
+  FD_TEST( fd_vm_context_pool_heap_max( pool )==HEAP_MAX );
+  FD_TEST( fd_vm_context_pool_free_cnt( pool )==CTX_MAX  );
+
+  fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_join( fd_sbpf_syscalls_new( syscalls_mem ) );
+  fd_vm_register_syscall( syscalls, "sol_alloc_free_", fd_vm_syscall_sol_alloc_free );
+
+  /* Acquiring */
+
+  FD_TEST( !fd_vm_context_pool_acquire( pool, HEAP_MAX+1UL ) );
+
+  fd_vm_exec_context_t * ctxs[ CTX_MAX ];
+  for( ulong i=0UL; i<CTX_MAX; i++ ) {
+    ctxs[i] = fd_vm_context_pool_acquire( pool, FD_VM_HEAP_SZ );
+    FD_TEST( ctxs[i] );
+    FD_TEST( ctxs[i]->heap_sz==FD_VM_HEAP_SZ );
+    FD_TEST( fd_ulong_is_aligned( (ulong)ctxs[i]->heap, FD_VM_CONTEXT_POOL_ALIGN ) );
+    for( ulong j=0UL; j<i; j++ ) FD_TEST( ctxs[i]!=ctxs[j] );
+  }
+  FD_TEST( !fd_vm_context_pool_acquire( pool, FD_VM_HEAP_SZ ) );
+  FD_TEST( !fd_vm_context_pool_free_cnt( pool ) );
+  for( ulong i=0UL; i<CTX_MAX; i++ ) fd_vm_context_pool_release( pool, ctxs[i] );
+  FD_TEST( fd_vm_context_pool_free_cnt( pool )==CTX_MAX );
+
+  /* The bump allocator and lazy clearing */
+
+  fd_vm_exec_context_t * ctx = fd_vm_context_pool_acquire( pool, FD_VM_HEAP_SZ );
+  run_prog( ctx, syscalls );
+  FD_TEST( !ctx->cond_fault );
+  FD_TEST( ctx->register_file[0]==FD_VM_MEM_MAP_HEAP_REGION_START+104UL ); /* 100 rounded up to 8 */
+  FD_TEST( ctx->heap_alloc_off==112UL );
+  FD_TEST( FD_LOAD( ulong, ctx->heap+ 96UL )==0x11223344UL );
+  FD_TEST( FD_LOAD( ulong, ctx->heap+104UL )==FD_VM_MEM_MAP_HEAP_REGION_START        );
+  FD_TEST( FD_LOAD( ulong, ctx->stack.data+0x1000UL-8UL )==FD_VM_MEM_MAP_HEAP_REGION_START );
+  FD_TEST( ctx->dirty_sz[ FD_VM_MEM_MAP_HEAP_REGION_START >>32 ]==112UL   );
+  FD_TEST( ctx->dirty_sz[ FD_VM_MEM_MAP_STACK_REGION_START>>32 ]==0x1000UL );
+
+  /* A syscall writing past the end of what the program wrote to */
+  void * haddr = NULL;
+  FD_TEST( fd_vm_translate_vm_to_host( ctx, 1U, FD_VM_MEM_MAP_HEAP_REGION_START+1000UL, 24UL, &haddr )==FD_VM_MEM_MAP_SUCCESS );
+  fd_memset( haddr, 0xff, 24UL );
+  FD_TEST( ctx->dirty_sz[ FD_VM_MEM_MAP_HEAP_REGION_START>>32 ]==1024UL );
+
+  /* The heap can be exhausted */
+  ulong ret = 1UL;
+  FD_TEST( fd_vm_syscall_sol_alloc_free( ctx, FD_VM_HEAP_SZ, 0UL, 0UL, 0UL, 0UL, &ret )==FD_VM_SYSCALL_SUCCESS && !ret );
+  FD_TEST( fd_vm_syscall_sol_alloc_free( ctx, FD_VM_HEAP_SZ-112UL, 0UL, 0UL, 0UL, 0UL, &ret )==FD_VM_SYSCALL_SUCCESS );
+  FD_TEST( ret==FD_VM_MEM_MAP_HEAP_REGION_START+112UL );
+  FD_TEST( fd_vm_syscall_sol_alloc_free( ctx, 0UL, 0UL, 0UL, 0UL, 0UL, &ret )==FD_VM_SYSCALL_SUCCESS );
+  FD_TEST( ret==FD_VM_MEM_MAP_HEAP_REGION_START+FD_VM_HEAP_SZ );
+  FD_TEST( fd_vm_syscall_sol_alloc_free( ctx, 1UL, 0UL, 0UL, 0UL, 0UL, &ret )==FD_VM_SYSCALL_SUCCESS && !ret );
+  FD_TEST( fd_vm_syscall_sol_alloc_free( ctx, 8UL, 1UL, 0UL, 0UL, 0UL, &ret )==FD_VM_SYSCALL_SUCCESS && !ret ); /* free */
+
+  fd_vm_context_pool_release( pool, ctx );
+
+  /* Released contexts come back fully zeroed, even with a larger heap */
+
+  FD_TEST( fd_vm_context_pool_acquire( pool, HEAP_MAX )==ctx );
+  FD_TEST( is_zero( ctx->heap,       HEAP_MAX                  ) );
+  FD_TEST( is_zero( ctx->stack.data, sizeof(ctx->stack.data)   ) );
+  FD_TEST( is_zero( (uchar const *)ctx->register_file, sizeof(ctx->register_file) ) );
+  FD_TEST( is_zero( (uchar const *)ctx->dirty_sz,      sizeof(ctx->dirty_sz)      ) );
+  FD_TEST( !ctx->heap_alloc_off && !ctx->instruction_counter && !ctx->instrs && !ctx->syscall_map );
+
+  /* Per invocation setup cost, compared to clearing a whole context */
+
+  long dt = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fd_vm_context_pool_release( pool, ctx );
+    ctx = fd_vm_context_pool_acquire( pool, FD_VM_HEAP_SZ );
+    run_prog( ctx, syscalls );
+  }
+  dt += fd_log_wallclock();
+  FD_TEST( ctx->register_file[0]==FD_VM_MEM_MAP_HEAP_REGION_START+104UL );
+
+  long dt_clear = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fd_memset( ctx->stack.data, 0, sizeof(ctx->stack.data) );
+    fd_memset( ctx->heap,       0, FD_VM_HEAP_SZ           );
+    FD_COMPILER_MFENCE();
+    run_prog( ctx, syscalls );
+  }
+  dt_clear += fd_log_wallclock();
+
+  FD_LOG_NOTICE(( "pooled: %.1f ns/invocation, cleared: %.1f ns/invocation",
+                  (double)dt/(double)iter_cnt, (double)dt_clear/(double)iter_cnt ));
+
+  fd_vm_context_pool_release( pool, ctx );
+  FD_TEST( fd_vm_context_pool_free_cnt( pool )==CTX_MAX );
+
+  fd_sbpf_syscalls_delete( fd_sbpf_syscalls_leave( syscalls ) );
+  FD_TEST( fd_vm_context_pool_delete( fd_vm_context_pool_leave( pool ) )==mem );
+  fd_wksp_free_laddr( mem );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
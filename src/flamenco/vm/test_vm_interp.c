@@ -1,7 +1,10 @@
 #include "../fd_flamenco_base.h"
 #include "fd_vm_interp.h"
+#include "fd_vm_jit.h"
 #include "fd_vm_syscalls.h"
 #include "../../ballet/base58/fd_base58.h"
+#include "../../ballet/murmur3/fd_murmur3.h"
+#include "../../ballet/sbpf/fd_sbpf_maps.c"
 #include "../../ballet/sbpf/fd_sbpf_opcodes.h"
 
 #include <stdlib.h>
@@ -20,6 +23,8 @@ test_program_success( char *                test_case_name,
 
   fd_sbpf_syscalls_t syscalls;
 
+  static uchar heap[ 3 ][ FD_VM_HEAP_SZ ];
+
   fd_vm_exec_context_t ctx = {
     .entrypoint = 0,
     .program_counter = 0,
@@ -27,6 +32,8 @@ test_program_success( char *                test_case_name,
     .instrs = instrs,
     .instrs_sz = instrs_sz,
     .syscall_map = &syscalls,
+    .heap = heap[0],
+    .heap_sz = FD_VM_HEAP_SZ,
   };
 
   fd_vm_register_syscall( ctx.syscall_map, "accumulator", accumulator_syscall );
@@ -49,6 +56,74 @@ test_program_success( char *                test_case_name,
   FD_LOG_NOTICE(( "Time: %ldns", dt ));
   FD_LOG_NOTICE(( "Time/Instr: %f ns", (double)dt / (double)ctx.instruction_counter ));
   FD_LOG_NOTICE(( "Mega Instr/Sec: %f", 1000.0 * ((double)ctx.instruction_counter / (double) dt)));
+
+  /* Run the program again with the pre-decoded interpreter, which
+     should produce exactly the same result */
+  fd_vm_predecoded_instr_t * prog = aligned_alloc( alignof(fd_vm_predecoded_instr_t), sizeof(fd_vm_predecoded_instr_t) * instrs_sz );
+  FD_TEST( prog );
+
+  fd_vm_exec_context_t ctx2 = {
+    .entrypoint = 0,
+    .program_counter = 0,
+    .instruction_counter = 0,
+    .instrs = instrs,
+    .instrs_sz = instrs_sz,
+    .syscall_map = &syscalls,
+    .heap = heap[1],
+    .heap_sz = FD_VM_HEAP_SZ,
+  };
+
+  long dt_predecode = -fd_log_wallclock();
+  FD_TEST( fd_vm_interp_predecode( &ctx2, prog )==prog );
+  dt_predecode += fd_log_wallclock();
+
+  long dt2 = -fd_log_wallclock();
+  fd_vm_interp_instrs_predecoded( &ctx2, prog );
+  dt2 += fd_log_wallclock();
+
+  FD_TEST( ctx2.register_file[0]==ctx.register_file[0] );
+  FD_TEST( ctx2.program_counter==ctx.program_counter );
+  FD_TEST( ctx2.instruction_counter==ctx.instruction_counter );
+  FD_TEST( ctx2.cond_fault==ctx.cond_fault );
+  FD_LOG_NOTICE(( "Pre-decoded: Time: %ldns (+%ldns to pre-decode)", dt2, dt_predecode ));
+  FD_LOG_NOTICE(( "Pre-decoded: Mega Instr/Sec: %f (%.2fx)", 1000.0 * ((double)ctx2.instruction_counter / (double) dt2), (double)dt/(double)dt2 ));
+
+  free( prog );
+
+#if FD_HAS_X86 && FD_HAS_HOSTED
+  /* And once more compiled to native code, which should also leave the
+     whole register file and the instruction counter the same */
+  if( instrs_sz<=FD_VM_JIT_INSTRS_MAX ) {
+    fd_vm_exec_context_t ctx3 = {
+      .entrypoint = 0,
+      .program_counter = 0,
+      .instruction_counter = 0,
+      .instrs = instrs,
+      .instrs_sz = instrs_sz,
+      .syscall_map = &syscalls,
+      .heap = heap[2],
+      .heap_sz = FD_VM_HEAP_SZ,
+    };
+
+    long dt_compile = -fd_log_wallclock();
+    fd_vm_jit_prog_t * jit = fd_vm_jit_compile( &ctx3 );
+    dt_compile += fd_log_wallclock();
+    FD_TEST( jit );
+
+    long dt3 = -fd_log_wallclock();
+    fd_vm_jit_exec( &ctx3, jit );
+    dt3 += fd_log_wallclock();
+
+    FD_TEST( !memcmp( ctx3.register_file, ctx.register_file, sizeof(ctx.register_file) ) );
+    FD_TEST( ctx3.program_counter==ctx.program_counter );
+    FD_TEST( ctx3.instruction_counter==ctx.instruction_counter );
+    FD_TEST( ctx3.cond_fault==ctx.cond_fault );
+    FD_LOG_NOTICE(( "JIT: Time: %ldns (+%ldns to compile %lu bytes)", dt3, dt_compile, fd_vm_jit_code_sz( jit ) ));
+    FD_LOG_NOTICE(( "JIT: Mega Instr/Sec: %f (%.2fx)", 1000.0 * ((double)ctx3.instruction_counter / (double) dt3), (double)dt/(double)dt3 ));
+
+    fd_vm_jit_delete( jit );
+  }
+#endif
 }
 
 #define TEST_PROGRAM_SUCCESS(test_case_name, expected_result, instrs_sz, ...) { \
@@ -138,6 +213,235 @@ generate_random_alu64_instrs( fd_rng_t * rng, fd_sbpf_instr_t * instrs, ulong in
   instrs[instrs_sz-1].opcode.raw = FD_SBPF_OP_EXIT;
 }
 
+/* test_predecoded_sigill checks that the pre-decoded interpreter clears
+   the whole register file on entry and that an opcode without a handler
+   (unassigned or past the end of the jump table) faults at its pc. */
+
+static void
+test_predecoded_sigill( void ) {
+  static uchar heap[ FD_VM_HEAP_SZ ];
+  static uchar const illegal[3] = { 0x01, 0xde, 0xff };
+
+  for( ulong j=0UL; j<3UL; j++ ) {
+    fd_sbpf_instr_t instrs[3] = {
+      FD_SBPF_INSTR(FD_SBPF_OP_MOV_IMM, FD_SBPF_R0, 0, 0, 7),
+      FD_SBPF_INSTR(illegal[j],         FD_SBPF_R1, 0, 0, 0),
+      FD_SBPF_INSTR(FD_SBPF_OP_EXIT,    0,          0, 0, 0),
+    };
+    fd_vm_predecoded_instr_t prog[3];
+
+    fd_vm_exec_context_t ctx = {
+      .instrs    = instrs,
+      .instrs_sz = 3UL,
+      .heap      = heap,
+      .heap_sz   = FD_VM_HEAP_SZ,
+    };
+    for( ulong r=0UL; r<11UL; r++ ) ctx.register_file[r] = 0x1234UL + r;
+
+    FD_TEST( fd_vm_interp_predecode( &ctx, prog )==prog );
+    for( ulong i=0UL; i<3UL; i++ ) FD_TEST( prog[i].handler );
+    fd_vm_interp_instrs_predecoded( &ctx, prog );
+
+    FD_TEST( ctx.cond_fault==1UL );
+    FD_TEST( ctx.program_counter==1UL );
+    FD_TEST( ctx.instruction_counter==1UL );
+    FD_TEST( ctx.register_file[0]==7UL );
+    for( ulong r=1UL; r<11UL; r++ ) FD_TEST( !ctx.register_file[r] );
+  }
+}
+
+/* test_mem_map_translate checks that translating through the region
+   table accepts and rejects exactly the same accesses as
+   fd_vm_translate_vm_to_host, including those right at the ends of
+   regions and those outside of any region. */
+
+static fd_vm_exec_context_t mem_map_ctx;
+
+static void
+test_mem_map_translate( fd_rng_t * rng ) {
+  static uchar read_only[ 1000 ];
+  static uchar input    [  500 ];
+  static uchar heap     [ FD_VM_HEAP_SZ ];
+
+  fd_vm_exec_context_t * ctx = &mem_map_ctx;
+  ctx->read_only    = read_only;
+  ctx->read_only_sz = sizeof(read_only);
+  ctx->input        = input;
+  ctx->input_sz     = sizeof(input);
+  ctx->heap         = heap;
+  ctx->heap_sz      = sizeof(heap);
+  fd_vm_mem_map_region_tab_init( ctx );
+
+  ulong region_sz[ 5 ] = { 0UL, sizeof(read_only), FD_VM_STACK_MAX_DEPTH*FD_VM_STACK_FRAME_WITH_GUARD_SZ, FD_VM_HEAP_SZ, sizeof(input) };
+
+  ulong ok_cnt = 0UL;
+  for( ulong iter=0UL; iter<1000000UL; iter++ ) {
+    ulong region = fd_rng_ulong_roll( rng, 10UL );
+    ulong sz     = fd_rng_uint_roll( rng, 4U ) ? (1UL<<fd_rng_uint_roll( rng, 4U )) : fd_rng_ulong_roll( rng, 100UL );
+    ulong write  = fd_rng_ulong_roll( rng, 2UL );
+    ulong off;
+    switch( fd_rng_uint_roll( rng, 3U ) ) {
+    case 0U:  off = region<5UL ? region_sz[ region ] - fd_ulong_min( region_sz[ region ], fd_rng_ulong_roll( rng, 16UL ) ) : 0UL; break;
+    case 1U:  off = fd_rng_ulong_roll( rng, 1UL<<17 ); break;
+    default:  off = fd_rng_uint( rng ); break;
+    }
+    if( !fd_rng_uint_roll( rng, 64U ) ) region = fd_rng_ulong( rng ) >> 32;
+    ulong vm_addr = (region<<32) | off;
+
+    void * expected  = NULL;
+    ulong  res       = fd_vm_translate_vm_to_host( ctx, (uint)write, vm_addr, sz, &expected );
+    void * haddr     = fd_vm_mem_map_translate( ctx, write, vm_addr, sz );
+    if( res==FD_VM_MEM_MAP_SUCCESS ) {
+      FD_TEST( haddr==expected );
+      ok_cnt++;
+    } else {
+      FD_TEST( !haddr );
+    }
+  }
+  FD_LOG_NOTICE(( "mem map translate: %lu of 1000000 accesses valid", ok_cnt ));
+}
+
+#if FD_HAS_X86 && FD_HAS_HOSTED
+
+/* test_jit_differential runs random programs, mixing all ALU ops,
+   forward jumps, 64-bit loads, syscalls and heap loads and stores that
+   occasionally run past the end of the heap, under the interpreter and
+   compiled to native code, and checks that both leave the same register
+   file, pc, instruction counter, fault condition, heap and dirty memory
+   high water marks behind. */
+
+static fd_vm_exec_context_t diff_ctx[2];
+static uchar                diff_heap[2][ FD_VM_HEAP_SZ ];
+
+static void
+test_jit_differential( fd_rng_t * rng,
+                       ulong      iter_cnt ) {
+
+  static uchar syscalls_mem[ sizeof(fd_sbpf_syscalls_t) << 12 ] __attribute__((aligned(64)));
+  FD_TEST( sizeof(syscalls_mem)>=fd_sbpf_syscalls_footprint() );
+  fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_join( fd_sbpf_syscalls_new( syscalls_mem ) );
+  fd_vm_register_syscall( syscalls, "accumulator", accumulator_syscall );
+  uint accumulator_id = fd_murmur3_32( "accumulator", 11UL, 0U );
+
+  uchar alu_ops[] = {
+    FD_SBPF_OP_ADD_IMM,   FD_SBPF_OP_ADD_REG,   FD_SBPF_OP_SUB_IMM,   FD_SBPF_OP_SUB_REG,
+    FD_SBPF_OP_MUL_IMM,   FD_SBPF_OP_MUL_REG,   FD_SBPF_OP_DIV_IMM,   FD_SBPF_OP_DIV_REG,
+    FD_SBPF_OP_OR_IMM,    FD_SBPF_OP_OR_REG,    FD_SBPF_OP_AND_IMM,   FD_SBPF_OP_AND_REG,
+    FD_SBPF_OP_LSH_IMM,   FD_SBPF_OP_LSH_REG,   FD_SBPF_OP_RSH_IMM,   FD_SBPF_OP_RSH_REG,
+    FD_SBPF_OP_NEG,       FD_SBPF_OP_MOD_IMM,   FD_SBPF_OP_MOD_REG,   FD_SBPF_OP_XOR_IMM,
+    FD_SBPF_OP_XOR_REG,   FD_SBPF_OP_MOV_IMM,   FD_SBPF_OP_MOV_REG,   FD_SBPF_OP_ARSH_IMM,
+    FD_SBPF_OP_ARSH_REG,  FD_SBPF_OP_END_LE,    FD_SBPF_OP_END_BE,
+    FD_SBPF_OP_ADD64_IMM, FD_SBPF_OP_ADD64_REG, FD_SBPF_OP_SUB64_IMM, FD_SBPF_OP_SUB64_REG,
+    FD_SBPF_OP_MUL64_IMM, FD_SBPF_OP_MUL64_REG, FD_SBPF_OP_DIV64_IMM, FD_SBPF_OP_DIV64_REG,
+    FD_SBPF_OP_OR64_IMM,  FD_SBPF_OP_OR64_REG,  FD_SBPF_OP_AND64_IMM, FD_SBPF_OP_AND64_REG,
+    FD_SBPF_OP_LSH64_IMM, FD_SBPF_OP_LSH64_REG, FD_SBPF_OP_RSH64_IMM, FD_SBPF_OP_RSH64_REG,
+    FD_SBPF_OP_NEG64,     FD_SBPF_OP_MOD64_IMM, FD_SBPF_OP_MOD64_REG, FD_SBPF_OP_XOR64_IMM,
+    FD_SBPF_OP_XOR64_REG, FD_SBPF_OP_MOV64_IMM, FD_SBPF_OP_MOV64_REG, FD_SBPF_OP_ARSH64_IMM,
+    FD_SBPF_OP_ARSH64_REG,
+  };
+  uchar jmp_ops[] = {
+    FD_SBPF_OP_JA,        FD_SBPF_OP_JEQ_IMM,   FD_SBPF_OP_JEQ_REG,   FD_SBPF_OP_JGT_IMM,
+    FD_SBPF_OP_JGT_REG,   FD_SBPF_OP_JGE_IMM,   FD_SBPF_OP_JGE_REG,   FD_SBPF_OP_JSET_IMM,
+    FD_SBPF_OP_JSET_REG,  FD_SBPF_OP_JNE_IMM,   FD_SBPF_OP_JNE_REG,   FD_SBPF_OP_JSGT_IMM,
+    FD_SBPF_OP_JSGT_REG,  FD_SBPF_OP_JSGE_IMM,  FD_SBPF_OP_JSGE_REG,  FD_SBPF_OP_JLT_IMM,
+    FD_SBPF_OP_JLT_REG,   FD_SBPF_OP_JLE_IMM,   FD_SBPF_OP_JLE_REG,   FD_SBPF_OP_JSLT_IMM,
+    FD_SBPF_OP_JSLT_REG,  FD_SBPF_OP_JSLE_IMM,  FD_SBPF_OP_JSLE_REG,
+  };
+  uchar mem_ops[] = {
+    FD_SBPF_OP_LDXB, FD_SBPF_OP_LDXH, FD_SBPF_OP_LDXW, FD_SBPF_OP_LDXDW,
+    FD_SBPF_OP_STB,  FD_SBPF_OP_STH,  FD_SBPF_OP_STW,  FD_SBPF_OP_STDW,
+    FD_SBPF_OP_STXB, FD_SBPF_OP_STXH, FD_SBPF_OP_STXW, FD_SBPF_OP_STXDW,
+  };
+  uint imms[] = { 0U, 1U, 7U, 16U, 31U, 32U, 63U, 64U, 0x7fffffffU, 0x80000000U, 0xffffffffU };
+
+# define INSTRS_SZ (256UL)
+  fd_sbpf_instr_t instrs[ INSTRS_SZ ];
+
+  ulong fault_cnt = 0UL;
+  ulong ic_sum    = 0UL;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+
+    /* r1 points to the middle of the heap, such that every 16-bit
+       offset from it is either in the heap or just past its end */
+
+    fd_memset( instrs, 0, sizeof(instrs) );
+    instrs[0] = (fd_sbpf_instr_t)FD_SBPF_INSTR( FD_SBPF_OP_LDDW,     FD_SBPF_R1, 0, 0, 0x8000 );
+    instrs[1] = (fd_sbpf_instr_t)FD_SBPF_INSTR( FD_SBPF_OP_ADDL_IMM, 0,          0, 0, 0x3    );
+
+    for( ulong i=2UL; i<INSTRS_SZ-1UL; i++ ) {
+      fd_sbpf_instr_t * instr = &instrs[i];
+      uint kind = fd_rng_uint_roll( rng, 16U );
+      uint dst = fd_rng_uint_roll( rng, 10U );
+      instr->dst_reg = (uchar)( dst==FD_SBPF_R1 ? FD_SBPF_R0 : dst ) & 0xFU; /* r1 stays the heap pointer */
+      instr->src_reg = (uchar)fd_rng_uint_roll( rng, 11U ) & 0xFU;
+      instr->imm     = fd_rng_uint_roll( rng, 4U ) ? imms[ fd_rng_uint_roll( rng, sizeof(imms)/sizeof(uint) ) ] : fd_rng_uint( rng );
+
+      if( kind<9U ) {
+        instr->opcode.raw = alu_ops[ fd_rng_uint_roll( rng, sizeof(alu_ops) ) ];
+        if( instr->opcode.raw==FD_SBPF_OP_END_LE || instr->opcode.raw==FD_SBPF_OP_END_BE )
+          instr->imm = 16U << fd_rng_uint_roll( rng, 3U );
+      } else if( kind<12U ) {
+        instr->opcode.raw = jmp_ops[ fd_rng_uint_roll( rng, sizeof(jmp_ops) ) ];
+        instr->offset     = (short)fd_rng_uint_roll( rng, (uint)fd_ulong_min( 16UL, INSTRS_SZ-1UL-i ) );
+      } else if( kind<15U ) {
+        instr->opcode.raw = mem_ops[ fd_rng_uint_roll( rng, sizeof(mem_ops) ) ];
+        if( instr->opcode.raw & 0x2 ) instr->dst_reg = FD_SBPF_R1;  /* ST and STX address via dst */
+        else                          instr->src_reg = FD_SBPF_R1;  /* LDX addresses via src */
+        if( !fd_rng_uint_roll( rng, 64U ) ) instr->offset = (short)(0x7ff8 + fd_rng_uint_roll( rng, 8U ));
+        else                                instr->offset = (short)(fd_rng_uint_roll( rng, 512U ) - 256U);
+      } else if( i+2UL<INSTRS_SZ && fd_rng_uint_roll( rng, 2U ) ) {
+        instr->opcode.raw = FD_SBPF_OP_LDDW;
+        instrs[i+1] = (fd_sbpf_instr_t)FD_SBPF_INSTR( FD_SBPF_OP_ADDL_IMM, 0, 0, 0, fd_rng_uint( rng ) );
+        i++;
+      } else {
+        instr->opcode.raw = FD_SBPF_OP_CALL_IMM;
+        instr->imm        = accumulator_id;
+      }
+    }
+    instrs[INSTRS_SZ-1UL] = (fd_sbpf_instr_t)FD_SBPF_INSTR( FD_SBPF_OP_EXIT, 0, 0, 0, 0 );
+
+    for( ulong j=0UL; j<2UL; j++ ) {
+      fd_vm_exec_context_t * ctx = &diff_ctx[j];
+      fd_memset( ctx, 0, sizeof(fd_vm_exec_context_t) );
+      ctx->instrs      = instrs;
+      ctx->instrs_sz   = INSTRS_SZ;
+      ctx->syscall_map = syscalls;
+      ctx->heap        = diff_heap[j];
+      ctx->heap_sz     = FD_VM_HEAP_SZ;
+      fd_memset( diff_heap[j], 0, FD_VM_HEAP_SZ );
+    }
+
+    fd_vm_interp_instrs( &diff_ctx[0] );
+
+    fd_vm_jit_prog_t * jit = fd_vm_jit_compile( &diff_ctx[1] );
+    FD_TEST( jit );
+    fd_vm_jit_exec( &diff_ctx[1], jit );
+    fd_vm_jit_delete( jit );
+
+    fd_vm_exec_context_t const * a = &diff_ctx[0];
+    fd_vm_exec_context_t const * b = &diff_ctx[1];
+    for( ulong r=0UL; r<11UL; r++ ) {
+      if( FD_UNLIKELY( a->register_file[r]!=b->register_file[r] ) )
+        FD_LOG_ERR(( "iter %lu: r%lu mismatch (interp 0x%lx, jit 0x%lx, pc %lu)", iter, r, a->register_file[r], b->register_file[r], a->program_counter ));
+    }
+    FD_TEST( a->program_counter    ==b->program_counter     );
+    FD_TEST( a->instruction_counter==b->instruction_counter );
+    FD_TEST( a->cond_fault         ==b->cond_fault          );
+    FD_TEST( !memcmp( a->heap, b->heap, FD_VM_HEAP_SZ )     );
+    FD_TEST( !memcmp( a->dirty_sz, b->dirty_sz, sizeof(a->dirty_sz) ) );
+
+    fault_cnt += !!a->cond_fault;
+    ic_sum    += a->instruction_counter;
+  }
+# undef INSTRS_SZ
+
+  FD_LOG_NOTICE(( "JIT differential: %lu programs, %lu instructions executed, %lu faulted", iter_cnt, ic_sum, fault_cnt ));
+
+  fd_sbpf_syscalls_delete( fd_sbpf_syscalls_leave( syscalls ) );
+}
+
+#endif /* FD_HAS_X86 && FD_HAS_HOSTED */
+
 int
 main( int     argc,
       char ** argv ) {
@@ -819,6 +1123,14 @@ main( int     argc,
     FD_SBPF_INSTR(FD_SBPF_OP_EXIT,      0,      0,      0, 0),
   );
 
+  test_mem_map_translate( rng );
+
+  test_predecoded_sigill();
+
+#if FD_HAS_X86 && FD_HAS_HOSTED
+  test_jit_differential( rng, 4096UL );
+#endif
+
   ulong instrs_sz = 128*1024*1024;
   fd_sbpf_instr_t * instrs = malloc( sizeof(fd_sbpf_instr_t) * instrs_sz );
 
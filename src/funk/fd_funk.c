@@ -117,6 +117,18 @@ fd_funk_new( void * shmem,
     return NULL;
   }
 
+  fd_funk_rec_cache_entry_t * rec_cache = (fd_funk_rec_cache_entry_t *)
+    fd_wksp_alloc_laddr( wksp, FD_FUNK_REC_CACHE_ALIGN, FD_FUNK_REC_CACHE_FOOTPRINT, wksp_tag );
+  if( FD_UNLIKELY( !rec_cache ) ) {
+    FD_LOG_WARNING(( "rec cache too large for workspace" ));
+    fd_wksp_free_laddr( fd_alloc_delete( fd_alloc_leave( alloc ) ) );
+    fd_wksp_free_laddr( fd_funk_rec_map_delete( fd_funk_rec_map_leave( rec_map ) ) );
+    fd_wksp_free_laddr( fd_funk_txn_map_delete( fd_funk_txn_map_leave( txn_map ) ) );
+    return NULL;
+  }
+
+  fd_memset( rec_cache, 0, FD_FUNK_REC_CACHE_FOOTPRINT ); /* All entries stale */
+
   fd_memset( funk, 0, fd_funk_footprint() );
 
   funk->funk_gaddr = fd_wksp_gaddr_fast( wksp, funk );
@@ -139,6 +151,18 @@ fd_funk_new( void * shmem,
 
   funk->alloc_gaddr = fd_wksp_gaddr_fast( wksp, alloc ); /* Note that this persists the join until delete */
 
+  funk->slab_gaddr = 0UL;
+
+  funk->rec_cache_gaddr = fd_wksp_gaddr_fast( wksp, rec_cache );
+  funk->rec_cache_gen   = 1UL;
+
+  funk->rec_lock   = 0UL;
+  funk->rec_rm_seq = 0UL;
+
+  funk->pub_log_gaddr = 0UL;
+  funk->pub_log_depth = 0UL;
+  funk->pub_log_seq   = 0UL;
+
   FD_COMPILER_MFENCE();
   FD_VOLATILE( funk->magic ) = FD_FUNK_MAGIC;
   FD_COMPILER_MFENCE();
@@ -212,6 +236,9 @@ fd_funk_delete( void * shfunk ) {
 
   /* Free all value resources here */
 
+  fd_funk_val_slab_fini( funk );
+  fd_wksp_free_laddr( fd_funk_rec_cache( funk, wksp ) );
+  if( funk->pub_log_gaddr ) fd_wksp_free_laddr( fd_funk_pub_log( funk, wksp ) ); /* A fd_funk_persist was not deleted */
   fd_wksp_free_laddr( fd_alloc_delete       ( fd_alloc_leave       ( fd_funk_alloc  ( funk, wksp ) ) ) );
   fd_wksp_free_laddr( fd_funk_rec_map_delete( fd_funk_rec_map_leave( fd_funk_rec_map( funk, wksp ) ) ) );
   fd_wksp_free_laddr( fd_funk_txn_map_delete( fd_funk_txn_map_leave( fd_funk_txn_map( funk, wksp ) ) ) );
@@ -332,8 +359,29 @@ fd_funk_verify( fd_funk_t * funk ) {
   fd_alloc_t * alloc = fd_funk_alloc( funk, wksp );
   TEST( alloc );
 
+  ulong slab_gaddr = funk->slab_gaddr;
+  if( slab_gaddr ) TEST( fd_wksp_tag( wksp, slab_gaddr )==wksp_tag );
+
   TEST( !fd_funk_val_verify( funk ) );
 
+  /* Test record cache */
+
+  ulong rec_cache_gaddr = funk->rec_cache_gaddr;
+  TEST( rec_cache_gaddr );
+  TEST( fd_wksp_tag( wksp, rec_cache_gaddr )==wksp_tag );
+  TEST( funk->rec_cache_gen );
+
+  /* Test publish log */
+
+  ulong pub_log_gaddr = funk->pub_log_gaddr;
+  ulong pub_log_depth = funk->pub_log_depth;
+  if( pub_log_gaddr ) {
+    TEST( fd_ulong_is_pow2( pub_log_depth ) );
+    TEST( fd_wksp_tag( wksp, pub_log_gaddr )==wksp_tag );
+  } else {
+    TEST( !pub_log_depth );
+  }
+
 # undef TEST
 
   return FD_FUNK_SUCCESS;
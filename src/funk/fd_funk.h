@@ -253,6 +253,45 @@ struct __attribute__((aligned(FD_FUNK_ALIGN))) fd_funk_private {
 
   ulong alloc_gaddr; /* Non-zero wksp gaddr with tag wksp tag */
 
+  /* The value slabs optionally hold small record values in fixed size
+     slots instead of fd_alloc allocations (see fd_funk_val_slab_config
+     in fd_funk_val.h).  slab_gaddr is the wksp gaddr of the
+     fd_funk_val_slab_t describing the size classes. */
+
+  ulong slab_gaddr; /* Wksp gaddr with tag wksp_tag, 0 if no value slabs */
+
+  /* The record cache memoizes the results of global record queries
+     (see FD_FUNK_REC_CACHE_SET_CNT in fd_funk_rec.h).  It is an array
+     of FD_FUNK_REC_CACHE_SET_CNT sets of FD_FUNK_REC_CACHE_WAY_CNT
+     entries.  Entries are only valid if filled during generation
+     rec_cache_gen. */
+
+  ulong rec_cache_gaddr; /* Non-zero wksp gaddr with tag wksp tag */
+  ulong rec_cache_gen;   /* Current cache generation, positive */
+
+  /* rec_lock serializes the record map, the record lists of the
+     transactions and the record cache between threads that are
+     concurrently doing record operations (see fd_funk_rec.h).  It is 0
+     when unlocked and 1 when locked.  rec_rm_seq is incremented under
+     the lock whenever a record operation unmaps an element of the
+     record map, which is the only change that can make a concurrent
+     unlocked walk of a map chain miss a key (see
+     fd_funk_rec_query_global_relock). */
+
+  ulong rec_lock;
+  ulong rec_rm_seq;
+
+  /* The publish log is an optional ring of pub_log_depth entries that
+     records the keys of records of the last published transaction as
+     they are created, modified or erased (see fd_funk_pub_log_append).
+     It exists only while a fd_funk_persist is attached to the funk.
+     pub_log_seq is the sequence number of the next entry (it only
+     advances while a log is attached). */
+
+  ulong pub_log_gaddr; /* Wksp gaddr with tag wksp_tag, 0 if no publish log */
+  ulong pub_log_depth; /* Positive integer power of 2 if pub_log_gaddr is non-zero, 0 otherwise */
+  ulong pub_log_seq;   /* Sequence number of the next publish log entry */
+
   /* Padding to FD_FUNK_ALIGN here */
 };
 
@@ -416,6 +455,89 @@ fd_funk_rec_map( fd_funk_t * funk,       /* Assumes current local join */
   return (fd_funk_rec_t *)fd_wksp_laddr_fast( wksp, funk->rec_map_gaddr );
 }
 
+/* fd_funk_rec_cache returns a pointer in the caller's address space to
+   the funk's record cache. */
+
+FD_FN_PURE static inline fd_funk_rec_cache_entry_t * /* Lifetime is that of the local join */
+fd_funk_rec_cache( fd_funk_t * funk,                 /* Assumes current local join */
+                   fd_wksp_t * wksp ) {              /* Assumes wksp == fd_funk_wksp( funk ) */
+  return (fd_funk_rec_cache_entry_t *)fd_wksp_laddr_fast( wksp, funk->rec_cache_gaddr );
+}
+
+/* fd_funk_rec_cache_invalidate invalidates all entries of the funk's
+   record cache.  This is done internally whenever transactions are
+   published, merged or cancelled.  Assumes funk is a current local
+   join. */
+
+static inline void fd_funk_rec_cache_invalidate( fd_funk_t * funk ) { funk->rec_cache_gen++; }
+
+/* fd_funk_rec_lock acquires the funk's record lock and
+   fd_funk_rec_unlock releases it.  The lock is held by record
+   operations while they update the record map, the transaction record
+   lists and the record cache, by transaction operations while they
+   update the record map and by fd_funk_persist while it reads records
+   of the last published transaction.  It is not recursive.  These are
+   for internal use; assumes funk is a current local join. */
+
+static inline void
+fd_funk_rec_lock( fd_funk_t * funk ) {
+# if FD_HAS_ATOMIC
+  FD_COMPILER_MFENCE();
+  for(;;) {
+    if( FD_LIKELY( !FD_VOLATILE_CONST( funk->rec_lock ) && !FD_ATOMIC_CAS( &funk->rec_lock, 0UL, 1UL ) ) ) break;
+    FD_SPIN_PAUSE();
+  }
+  FD_COMPILER_MFENCE();
+# else
+  (void)funk;
+# endif
+}
+
+static inline void
+fd_funk_rec_unlock( fd_funk_t * funk ) {
+# if FD_HAS_ATOMIC
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( funk->rec_lock ) = 0UL;
+  FD_COMPILER_MFENCE();
+# else
+  (void)funk;
+# endif
+}
+
+/* fd_funk_pub_log returns a pointer in the caller's address space to
+   the funk's publish log or NULL if it has none. */
+
+FD_FN_PURE static inline fd_funk_pub_log_entry_t * /* Lifetime is that of the local join and the log */
+fd_funk_pub_log( fd_funk_t * funk,                 /* Assumes current local join */
+                 fd_wksp_t * wksp ) {              /* Assumes wksp == fd_funk_wksp( funk ) */
+  ulong gaddr = funk->pub_log_gaddr;
+  if( FD_LIKELY( !gaddr ) ) return NULL;
+  return (fd_funk_pub_log_entry_t *)fd_wksp_laddr_fast( wksp, gaddr );
+}
+
+/* fd_funk_pub_log_append appends an entry for key with the given flags
+   to the publish log if the funk has one.  This is done internally
+   whenever a record of the last published transaction is created (by
+   insert or publish), modified (by fd_funk_rec_modify or publish) or
+   erased (by remove or publish).  The caller should hold the record
+   lock.  Entries older than pub_log_depth are overwritten; a reader
+   that falls that far behind detects it from the sequence numbers. */
+
+static inline void
+fd_funk_pub_log_append( fd_funk_t *               funk,
+                        fd_wksp_t *               wksp,
+                        fd_funk_rec_key_t const * key,
+                        ulong                     flags ) {
+  fd_funk_pub_log_entry_t * log = fd_funk_pub_log( funk, wksp );
+  if( FD_LIKELY( !log ) ) return;
+  ulong seq = funk->pub_log_seq;
+  funk->pub_log_seq = seq+1UL;
+  fd_funk_pub_log_entry_t * entry = log + (seq & (funk->pub_log_depth-1UL));
+  fd_funk_rec_key_copy( &entry->key, key );
+  entry->seq   = seq;
+  entry->flags = flags;
+}
+
 /* fd_funk_last_publish_rec_{head,tail} returns a pointer in the
    caller's address space to {oldest,young} record (by creation) of all
    records in the last published transaction, NULL if the last published
@@ -448,6 +570,18 @@ fd_funk_alloc( fd_funk_t * funk,       /* Assumes current local join */
   return (fd_alloc_t *)fd_wksp_laddr_fast( wksp, funk->alloc_gaddr );
 }
 
+/* fd_funk_val_slab returns a pointer in the caller's address space to
+   the funk's value slab size class table or NULL if it has no value
+   slabs. */
+
+FD_FN_PURE static inline fd_funk_val_slab_t * /* Lifetime is that of the local join and the slab configuration */
+fd_funk_val_slab( fd_funk_t * funk,           /* Assumes current local join */
+                  fd_wksp_t * wksp ) {        /* Assumes wksp == fd_funk_wksp( funk ) */
+  ulong gaddr = funk->slab_gaddr;
+  if( FD_LIKELY( !gaddr ) ) return NULL;
+  return (fd_funk_val_slab_t *)fd_wksp_laddr_fast( wksp, gaddr );
+}
+
 /* Operations */
 
 /* fd_funk_descendant returns the funk's youngest descendant that has no
@@ -11,6 +11,7 @@ fd_funk_strerror( int err ) {
   case FD_FUNK_ERR_TXN:    return "txn";
   case FD_FUNK_ERR_REC:    return "rec";
   case FD_FUNK_ERR_MEM:    return "mem";
+  case FD_FUNK_ERR_IO:     return "io";
   default: break;
   }
   return "unknown";
@@ -0,0 +1,708 @@
+#include "fd_funk_persist.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#define FD_FUNK_PERSIST_HASH_SEED (0xf17eda2ce7f5e5edUL)
+
+struct __attribute__((aligned(FD_FUNK_PERSIST_ALIGN))) fd_funk_persist_private {
+  ulong magic;   /* ==FD_FUNK_PERSIST_MAGIC */
+  ulong buf_max; /* Size of the write buffer that follows this structure */
+
+  /* These are only meaningful while attached */
+
+  fd_funk_t * funk;          /* Local join of the funk being persisted, NULL if detached */
+  int         fd;            /* File being written */
+  ulong       file_off;      /* File offset of the next block */
+  ulong       blk_seq;       /* Sequence number of the next block */
+  ulong       log_seq;       /* Publish log sequence number of the next entry to write */
+  int         ckpt;          /* 0 if no checkpoint in progress, 1 if one should be started, 2 if scanning */
+  ulong       ckpt_iter;     /* Record map iterator of the next record to scan */
+  int         blk_ready;     /* 1 if the write buffer holds a block that still has to be written */
+  ulong       blk_erase_cnt; /* Erased records in that block */
+  ulong       blk_data_sz;   /* Key and value bytes in that block */
+
+  fd_funk_persist_stats_t stats[1];
+
+  /* Padding to FD_FUNK_PERSIST_ALIGN, buf_max bytes write buffer follows */
+};
+
+static inline uchar *
+fd_funk_persist_private_buf( fd_funk_persist_t * persist ) {
+  return (uchar *)(persist+1);
+}
+
+/* fd_funk_persist_private_blk_hash returns the hash of a block whose
+   header is at blk, with the records following it. */
+
+static ulong
+fd_funk_persist_private_blk_hash( fd_funk_persist_blk_t * blk ) {
+  ulong hash = blk->hash;
+  blk->hash = 0UL;
+  ulong ret = fd_hash( FD_FUNK_PERSIST_HASH_SEED, blk, sizeof(fd_funk_persist_blk_t) + blk->data_sz );
+  blk->hash = hash;
+  return ret;
+}
+
+/* fd_funk_persist_private_emit appends a record to the block being
+   built in buf at *_off.  Returns 1 on success and 0 if the record does
+   not fit in the buf_max bytes of buf. */
+
+static inline int
+fd_funk_persist_private_emit( uchar *                   buf,
+                              ulong                     buf_max,
+                              ulong *                   _off,
+                              fd_funk_rec_key_t const * key,
+                              void const *              val,
+                              ulong                     val_sz,
+                              ulong                     flags ) {
+  ulong off    = *_off;
+  ulong rec_sz = fd_ulong_align_up( FD_FUNK_PERSIST_REC_HDR_SZ + val_sz, 8UL );
+  if( FD_UNLIKELY( rec_sz > buf_max-off ) ) return 0;
+
+  uchar * p = buf + off;
+  fd_memcpy( p, key, FD_FUNK_REC_KEY_FOOTPRINT );
+  FD_STORE( uint, p + FD_FUNK_REC_KEY_FOOTPRINT,     (uint)val_sz );
+  FD_STORE( uint, p + FD_FUNK_REC_KEY_FOOTPRINT+4UL, (uint)flags  );
+  p += FD_FUNK_PERSIST_REC_HDR_SZ;
+  if( val_sz ) fd_memcpy( p, val, val_sz );
+  fd_memset( p + val_sz, 0, rec_sz - FD_FUNK_PERSIST_REC_HDR_SZ - val_sz );
+
+  *_off = off + rec_sz;
+  return 1;
+}
+
+/* fd_funk_persist_private_{write,read} write / read sz bytes at file
+   offset off, retrying on partial transfers and interrupts.  Return 0
+   on success, 1 if read hit the end of the file and an errno on
+   failure. */
+
+static int
+fd_funk_persist_private_write( int          fd,
+                               void const * buf,
+                               ulong        sz,
+                               ulong        off ) {
+  while( sz ) {
+    long cnt = (long)pwrite( fd, buf, sz, (off_t)off );
+    if( FD_UNLIKELY( cnt<=0L ) ) {
+      if( FD_LIKELY( cnt<0L && errno==EINTR ) ) continue;
+      return cnt<0L ? errno : EIO;
+    }
+    buf  = (uchar const *)buf + cnt;
+    sz  -= (ulong)cnt;
+    off += (ulong)cnt;
+  }
+  return 0;
+}
+
+static int
+fd_funk_persist_private_read( int    fd,
+                              void * buf,
+                              ulong  sz,
+                              ulong  off ) {
+  while( sz ) {
+    long cnt = (long)pread( fd, buf, sz, (off_t)off );
+    if( FD_UNLIKELY( cnt<=0L ) ) {
+      if( FD_LIKELY( !cnt ) ) return 1;
+      if( FD_LIKELY( errno==EINTR ) ) continue;
+      return errno;
+    }
+    buf  = (uchar *)buf + cnt;
+    sz  -= (ulong)cnt;
+    off += (ulong)cnt;
+  }
+  return 0;
+}
+
+ulong
+fd_funk_persist_align( void ) {
+  return FD_FUNK_PERSIST_ALIGN;
+}
+
+ulong
+fd_funk_persist_footprint( ulong buf_max ) {
+  if( FD_UNLIKELY( (!fd_ulong_is_aligned( buf_max, FD_FUNK_PERSIST_ALIGN )) | (buf_max<FD_FUNK_PERSIST_BUF_MIN) |
+                   (buf_max>(ULONG_MAX/2UL)) ) ) return 0UL;
+  return sizeof(fd_funk_persist_t) + buf_max;
+}
+
+void *
+fd_funk_persist_new( void * shmem,
+                     ulong  buf_max ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_funk_persist_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_funk_persist_footprint( buf_max ) ) ) {
+    FD_LOG_WARNING(( "bad buf_max" ));
+    return NULL;
+  }
+
+  fd_funk_persist_t * persist = (fd_funk_persist_t *)shmem;
+
+  fd_memset( persist, 0, sizeof(fd_funk_persist_t) );
+
+  persist->buf_max = buf_max;
+  persist->funk    = NULL;
+  persist->fd      = -1;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( persist->magic ) = FD_FUNK_PERSIST_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_funk_persist_t *
+fd_funk_persist_join( void * shpersist ) {
+
+  if( FD_UNLIKELY( !shpersist ) ) {
+    FD_LOG_WARNING(( "NULL shpersist" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shpersist, fd_funk_persist_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shpersist" ));
+    return NULL;
+  }
+
+  fd_funk_persist_t * persist = (fd_funk_persist_t *)shpersist;
+
+  if( FD_UNLIKELY( persist->magic!=FD_FUNK_PERSIST_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return persist;
+}
+
+void *
+fd_funk_persist_leave( fd_funk_persist_t * persist ) {
+
+  if( FD_UNLIKELY( !persist ) ) {
+    FD_LOG_WARNING(( "NULL persist" ));
+    return NULL;
+  }
+
+  return (void *)persist;
+}
+
+void *
+fd_funk_persist_delete( void * shpersist ) {
+
+  if( FD_UNLIKELY( !shpersist ) ) {
+    FD_LOG_WARNING(( "NULL shpersist" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shpersist, fd_funk_persist_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shpersist" ));
+    return NULL;
+  }
+
+  fd_funk_persist_t * persist = (fd_funk_persist_t *)shpersist;
+
+  if( FD_UNLIKELY( persist->magic!=FD_FUNK_PERSIST_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( persist->funk ) ) {
+    FD_LOG_WARNING(( "persist is attached" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( persist->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shpersist;
+}
+
+int
+fd_funk_persist_attach( fd_funk_persist_t * persist,
+                        fd_funk_t *         funk,
+                        ulong               log_depth,
+                        int                 fd,
+                        ulong               file_off,
+                        ulong               blk_seq ) {
+
+  if( FD_UNLIKELY( !persist ) ) {
+    FD_LOG_WARNING(( "NULL persist" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( persist->funk ) ) {
+    FD_LOG_WARNING(( "persist is already attached" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( !funk ) ) {
+    FD_LOG_WARNING(( "NULL funk" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( (!fd_ulong_is_pow2( log_depth )) | (log_depth>(ULONG_MAX/2UL)/sizeof(fd_funk_pub_log_entry_t)) ) ) {
+    FD_LOG_WARNING(( "bad log_depth" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( (fd<0) | (!fd_ulong_is_aligned( file_off, FD_FUNK_PERSIST_ALIGN )) ) ) {
+    FD_LOG_WARNING(( "bad fd or file_off" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( funk->pub_log_gaddr ) ) {
+    FD_LOG_WARNING(( "funk already has a persister" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+
+  fd_funk_pub_log_entry_t * log = (fd_funk_pub_log_entry_t *)
+    fd_wksp_alloc_laddr( wksp, FD_FUNK_PUB_LOG_ALIGN, log_depth*sizeof(fd_funk_pub_log_entry_t), funk->wksp_tag );
+  if( FD_UNLIKELY( !log ) ) {
+    FD_LOG_WARNING(( "log_depth too large for workspace" ));
+    return FD_FUNK_ERR_MEM;
+  }
+
+  fd_funk_rec_lock( funk );
+  funk->pub_log_depth = log_depth;
+  funk->pub_log_gaddr = fd_wksp_gaddr_fast( wksp, log );
+  persist->log_seq    = funk->pub_log_seq;
+  fd_funk_rec_unlock( funk );
+
+  persist->funk      = funk;
+  persist->fd        = fd;
+  persist->file_off  = file_off;
+  persist->blk_seq   = blk_seq;
+  persist->ckpt      = 1;
+  persist->ckpt_iter = 0UL;
+  persist->blk_ready = 0;
+
+  return FD_FUNK_SUCCESS;
+}
+
+void
+fd_funk_persist_detach( fd_funk_persist_t * persist ) {
+
+  if( FD_UNLIKELY( (!persist) || (!persist->funk) ) ) {
+    FD_LOG_WARNING(( "NULL or detached persist" ));
+    return;
+  }
+
+  fd_funk_t * funk = persist->funk;
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+
+  fd_funk_pub_log_entry_t * log = fd_funk_pub_log( funk, wksp );
+
+  fd_funk_rec_lock( funk );
+  funk->pub_log_gaddr = 0UL;
+  funk->pub_log_depth = 0UL;
+  fd_funk_rec_unlock( funk );
+
+  fd_wksp_free_laddr( log );
+
+  persist->funk      = NULL;
+  persist->fd        = -1;
+  persist->blk_ready = 0;
+}
+
+/* fd_funk_persist_private_fill builds the next block in the write
+   buffer and marks it ready to be written, if there is anything to
+   write.  (The first and last blocks of a checkpoint are written even
+   if they have no records.) */
+
+static void
+fd_funk_persist_private_fill( fd_funk_persist_t * persist ) {
+
+  fd_funk_t *     funk    = persist->funk;
+  fd_wksp_t *     wksp    = fd_funk_wksp( funk );
+  fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
+
+  uchar *                 buf     = fd_funk_persist_private_buf( persist );
+  ulong                   buf_max = persist->buf_max;
+  fd_funk_persist_blk_t * blk     = (fd_funk_persist_blk_t *)buf;
+
+  ulong off       = sizeof(fd_funk_persist_blk_t);
+  ulong rec_cnt   = 0UL;
+  ulong erase_cnt = 0UL;
+  ulong data_sz   = 0UL;
+  ulong flags     = 0UL;
+  ulong lock_off  = off; /* Buffer offset when the lock was last acquired */
+
+  fd_funk_rec_lock( funk );
+
+  ulong log_seq = persist->log_seq;
+  ulong pub_seq = funk->pub_log_seq;
+
+  /* If we fell behind the log, entries were overwritten and the only
+     way to catch up is a checkpoint */
+
+  if( FD_UNLIKELY( (!persist->ckpt) & ((pub_seq-log_seq)>funk->pub_log_depth) ) ) persist->ckpt = 1;
+
+  if( FD_UNLIKELY( persist->ckpt==1 ) ) {
+    flags             |= FD_FUNK_PERSIST_BLK_FLAG_CKPT_BEGIN;
+    persist->ckpt      = 2;
+    persist->ckpt_iter = fd_funk_rec_map_iter_init( rec_map );
+    log_seq            = pub_seq; /* The scan covers everything logged so far */
+    persist->stats->ckpt_cnt++;
+  }
+
+  if( FD_UNLIKELY( persist->ckpt==2 ) ) {
+
+    /* Scan the record map from where the last poll left off.  The
+       record there might have been removed since in which case its
+       slot is free (or reused by another record).  Note that map
+       iterators remain valid while the map is modified. */
+
+    ulong iter = persist->ckpt_iter;
+    if( !fd_funk_rec_map_iter_done( rec_map, iter ) ) {
+      fd_funk_rec_t const * rec = fd_funk_rec_map_iter_ele_const( rec_map, iter );
+      if( FD_UNLIKELY( fd_funk_rec_map_query_const( rec_map, fd_funk_rec_pair( rec ), NULL )!=rec ) )
+        iter = fd_funk_rec_map_iter_next( rec_map, iter );
+    }
+
+    for( ; !fd_funk_rec_map_iter_done( rec_map, iter ); iter = fd_funk_rec_map_iter_next( rec_map, iter ) ) {
+      fd_funk_rec_t const * rec = fd_funk_rec_map_iter_ele_const( rec_map, iter );
+      if( !fd_funk_txn_idx_is_null( fd_funk_txn_idx( rec->txn_cidx ) ) ) continue; /* In-prep record */
+      ulong val_sz = fd_funk_val_sz( rec );
+      if( FD_UNLIKELY( !fd_funk_persist_private_emit( buf, buf_max, &off, fd_funk_rec_key( rec ),
+                                                      fd_funk_val_const( rec, wksp ), val_sz, 0UL ) ) ) break;
+      rec_cnt++;
+      data_sz += FD_FUNK_REC_KEY_FOOTPRINT + val_sz;
+
+      /* Records after iter are read again under the lock and the ones
+         inserted behind it while unlocked are in the publish log */
+
+      if( FD_UNLIKELY( off-lock_off>=FD_FUNK_PERSIST_LOCK_SZ ) ) {
+        fd_funk_rec_unlock( funk );
+        FD_SPIN_PAUSE();
+        fd_funk_rec_lock( funk );
+        lock_off = off;
+      }
+    }
+
+    persist->ckpt_iter = iter;
+
+    if( fd_funk_rec_map_iter_done( rec_map, iter ) ) {
+      flags         |= FD_FUNK_PERSIST_BLK_FLAG_CKPT_END;
+      persist->ckpt  = 0;
+    }
+
+  } else {
+
+    /* Write the current version of the records logged since the last
+       poll.  A record logged multiple times is written each time
+       (with its latest value). */
+
+    fd_funk_pub_log_entry_t const * log  = fd_funk_pub_log( funk, wksp );
+    ulong                           mask = funk->pub_log_depth - 1UL;
+
+    fd_funk_xid_key_pair_t pair[1];
+    for( ; log_seq!=pub_seq; log_seq++ ) {
+      fd_funk_pub_log_entry_t const * entry = log + (log_seq & mask);
+      fd_funk_xid_key_pair_init( pair, fd_funk_root( funk ), &entry->key );
+      fd_funk_rec_t const * rec = fd_funk_rec_map_query_const( rec_map, pair, NULL );
+      if( FD_LIKELY( rec ) ) {
+        ulong val_sz = fd_funk_val_sz( rec );
+        if( FD_UNLIKELY( !fd_funk_persist_private_emit( buf, buf_max, &off, &entry->key,
+                                                        fd_funk_val_const( rec, wksp ), val_sz, 0UL ) ) ) break;
+        data_sz += FD_FUNK_REC_KEY_FOOTPRINT + val_sz;
+      } else {
+        if( FD_UNLIKELY( !fd_funk_persist_private_emit( buf, buf_max, &off, &entry->key,
+                                                        NULL, 0UL, FD_FUNK_REC_FLAG_ERASE ) ) ) break;
+        data_sz += FD_FUNK_REC_KEY_FOOTPRINT;
+        erase_cnt++;
+      }
+      rec_cnt++;
+
+      /* If the entries still to write were overwritten while unlocked,
+         stop here and catch up with a checkpoint on the next poll */
+
+      if( FD_UNLIKELY( off-lock_off>=FD_FUNK_PERSIST_LOCK_SZ ) ) {
+        fd_funk_rec_unlock( funk );
+        FD_SPIN_PAUSE();
+        fd_funk_rec_lock( funk );
+        lock_off = off;
+        if( FD_UNLIKELY( (funk->pub_log_seq-(log_seq+1UL))>funk->pub_log_depth ) ) {
+          log_seq++;
+          persist->ckpt = 1;
+          break;
+        }
+      }
+    }
+
+  }
+
+  persist->log_seq = log_seq;
+
+  fd_funk_rec_unlock( funk );
+
+  if( FD_UNLIKELY( (!rec_cnt) & (!flags) ) ) return; /* Nothing to write */
+
+  ulong sz = fd_ulong_align_up( off, FD_FUNK_PERSIST_ALIGN );
+  fd_memset( buf + off, 0, sz - off );
+
+  blk->magic    = FD_FUNK_PERSIST_BLK_MAGIC;
+  blk->seq      = persist->blk_seq;
+  blk->sz       = sz;
+  blk->data_sz  = off - sizeof(fd_funk_persist_blk_t);
+  blk->rec_cnt  = rec_cnt;
+  blk->flags    = flags;
+  blk->hash     = 0UL;
+  blk->reserved = 0UL;
+  blk->hash     = fd_funk_persist_private_blk_hash( blk );
+
+  persist->blk_ready     = 1;
+  persist->blk_erase_cnt = erase_cnt;
+  persist->blk_data_sz   = data_sz;
+}
+
+int
+fd_funk_persist_poll( fd_funk_persist_t * persist,
+                      ulong *             opt_rec_cnt ) {
+
+  if( opt_rec_cnt ) *opt_rec_cnt = 0UL;
+
+  if( FD_LIKELY( !persist->blk_ready ) ) {
+    fd_funk_persist_private_fill( persist );
+    if( FD_LIKELY( !persist->blk_ready ) ) return FD_FUNK_SUCCESS;
+  }
+
+  fd_funk_persist_blk_t const * blk = (fd_funk_persist_blk_t const *)fd_funk_persist_private_buf( persist );
+
+  int err = fd_funk_persist_private_write( persist->fd, blk, blk->sz, persist->file_off );
+  if( FD_UNLIKELY( err ) ) {
+    FD_LOG_WARNING(( "write of block %lu at offset %lu failed (%i-%s)", blk->seq, persist->file_off, err, strerror( err ) ));
+    return FD_FUNK_ERR_IO;
+  }
+
+  persist->blk_ready  = 0;
+  persist->file_off  += blk->sz;
+  persist->blk_seq++;
+
+  fd_funk_persist_stats_t * stats = persist->stats;
+  stats->blk_cnt++;
+  stats->rec_cnt   += blk->rec_cnt;
+  stats->erase_cnt += persist->blk_erase_cnt;
+  stats->data_sz   += persist->blk_data_sz;
+  stats->write_sz  += blk->sz;
+
+  if( opt_rec_cnt ) *opt_rec_cnt = blk->rec_cnt;
+  return FD_FUNK_SUCCESS;
+}
+
+int
+fd_funk_persist_pending( fd_funk_persist_t const * persist ) {
+  return persist->blk_ready | persist->ckpt | (persist->log_seq!=FD_VOLATILE_CONST( persist->funk->pub_log_seq ));
+}
+
+fd_funk_persist_stats_t const *
+fd_funk_persist_stats( fd_funk_persist_t const * persist ) {
+  return persist->stats;
+}
+
+/* fd_funk_persist_private_blk_ok returns 1 if the block header at blk
+   read from offset off looks like block seq of a file replayed with a
+   buf_max buffer and 0 otherwise */
+
+static inline int
+fd_funk_persist_private_blk_ok( fd_funk_persist_blk_t const * blk,
+                                ulong                         seq,
+                                ulong                         buf_max ) {
+  return (blk->magic==FD_FUNK_PERSIST_BLK_MAGIC) & (blk->seq==seq) &
+         (blk->sz>=FD_FUNK_PERSIST_ALIGN) & (blk->sz<=buf_max) & fd_ulong_is_aligned( blk->sz, FD_FUNK_PERSIST_ALIGN ) &
+         (blk->data_sz<=blk->sz-sizeof(fd_funk_persist_blk_t));
+}
+
+/* fd_funk_persist_private_apply applies the records of the block at
+   blk (which has been validated) to the last published transaction of
+   funk.  Returns FD_FUNK_SUCCESS on success and a FD_FUNK_ERR_* code on
+   failure. */
+
+static int
+fd_funk_persist_private_apply( fd_funk_t *                      funk,
+                               fd_funk_persist_blk_t const *    blk,
+                               fd_funk_persist_restore_info_t * info ) {
+
+  fd_wksp_t *  wksp  = fd_funk_wksp( funk );
+  fd_alloc_t * alloc = fd_funk_alloc( funk, wksp );
+
+  uchar const * p   = (uchar const *)(blk+1);
+  uchar const * end = p + blk->data_sz;
+
+  for( ulong rec_rem=blk->rec_cnt; rec_rem; rec_rem-- ) {
+
+    if( FD_UNLIKELY( (ulong)(end-p)<FD_FUNK_PERSIST_REC_HDR_SZ ) ) return FD_FUNK_ERR_IO;
+
+    fd_funk_rec_key_t key[1]; fd_memcpy( key, p, FD_FUNK_REC_KEY_FOOTPRINT );
+    ulong val_sz = (ulong)FD_LOAD( uint, p + FD_FUNK_REC_KEY_FOOTPRINT     );
+    ulong flags  = (ulong)FD_LOAD( uint, p + FD_FUNK_REC_KEY_FOOTPRINT+4UL );
+    uchar const * val = p + FD_FUNK_PERSIST_REC_HDR_SZ;
+
+    ulong rec_sz = fd_ulong_align_up( FD_FUNK_PERSIST_REC_HDR_SZ + val_sz, 8UL );
+    if( FD_UNLIKELY( (val_sz>FD_FUNK_REC_VAL_MAX) | (rec_sz>(ulong)(end-p)) ) ) return FD_FUNK_ERR_IO;
+
+    if( flags & FD_FUNK_REC_FLAG_ERASE ) {
+
+      fd_funk_rec_t const * rec = fd_funk_rec_query( funk, NULL, key );
+      if( rec ) {
+        int err = fd_funk_rec_remove( funk, fd_funk_rec_modify( funk, rec ), 1 );
+        if( FD_UNLIKELY( err ) ) return err;
+      }
+      info->erase_cnt++;
+
+    } else {
+
+      int err;
+      fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, NULL, key, val_sz, &err );
+      if( FD_UNLIKELY( !rec ) ) return err;
+      if( fd_funk_val_sz( rec )>val_sz ) {
+        rec = fd_funk_val_truncate( rec, val_sz, alloc, wksp, &err );
+        if( FD_UNLIKELY( !rec ) ) return err;
+      }
+      if( val_sz ) fd_memcpy( fd_funk_val( rec, wksp ), val, val_sz );
+
+    }
+
+    info->rec_cnt++;
+    p += rec_sz;
+  }
+
+  return FD_FUNK_SUCCESS;
+}
+
+int
+fd_funk_persist_restore( fd_funk_t *                      funk,
+                         int                              fd,
+                         void *                           buf,
+                         ulong                            buf_max,
+                         fd_funk_persist_restore_info_t * opt_info ) {
+
+  if( FD_UNLIKELY( (!funk) | (fd<0) | (!buf) ) ) {
+    FD_LOG_WARNING(( "NULL funk, bad fd or NULL buf" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( (!fd_ulong_is_aligned( (ulong)buf, FD_FUNK_PERSIST_ALIGN )) |
+                   (!fd_ulong_is_aligned( buf_max, FD_FUNK_PERSIST_ALIGN )) | (!buf_max) ) ) {
+    FD_LOG_WARNING(( "misaligned buf or bad buf_max" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( fd_funk_last_publish_is_frozen( funk ) ) ) {
+    FD_LOG_WARNING(( "last published transaction is frozen" ));
+    return FD_FUNK_ERR_FROZEN;
+  }
+
+  fd_funk_persist_restore_info_t info[1];
+  fd_memset( info, 0, sizeof(fd_funk_persist_restore_info_t) );
+
+  fd_funk_persist_blk_t * blk = (fd_funk_persist_blk_t *)buf;
+
+  /* Find the last complete checkpoint.  Only the headers of blocks are
+     read, except for blocks that end a checkpoint which are read fully
+     to make sure they were not torn. */
+
+  ulong off      = 0UL;
+  ulong seq      = 0UL;
+  ulong cand_off = ULONG_MAX; ulong cand_seq = 0UL; /* Last checkpoint begin */
+  ulong ckpt_off = ULONG_MAX; ulong ckpt_seq = 0UL; /* Begin of the last complete checkpoint */
+  ulong ckpt_end = 0UL;                             /* End of the last complete checkpoint */
+  for(;;) {
+    int err = fd_funk_persist_private_read( fd, blk, FD_FUNK_PERSIST_ALIGN, off );
+    if( FD_UNLIKELY( err ) ) {
+      if( FD_UNLIKELY( err!=1 ) ) {
+        FD_LOG_WARNING(( "read at offset %lu failed (%i-%s)", off, err, strerror( err ) ));
+        return FD_FUNK_ERR_IO;
+      }
+      break;
+    }
+    info->read_sz += FD_FUNK_PERSIST_ALIGN;
+    if( FD_UNLIKELY( !fd_funk_persist_private_blk_ok( blk, seq, buf_max ) ) ) break;
+
+    if( blk->flags & FD_FUNK_PERSIST_BLK_FLAG_CKPT_BEGIN ) { cand_off = off; cand_seq = seq; }
+
+    if( (blk->flags & FD_FUNK_PERSIST_BLK_FLAG_CKPT_END) && cand_off!=ULONG_MAX ) {
+      ulong sz = blk->sz;
+      if( sz>FD_FUNK_PERSIST_ALIGN ) {
+        err = fd_funk_persist_private_read( fd, (uchar *)buf + FD_FUNK_PERSIST_ALIGN, sz-FD_FUNK_PERSIST_ALIGN, off+FD_FUNK_PERSIST_ALIGN );
+        if( FD_UNLIKELY( err ) ) break;
+        info->read_sz += sz-FD_FUNK_PERSIST_ALIGN;
+      }
+      if( FD_UNLIKELY( fd_funk_persist_private_blk_hash( blk )!=blk->hash ) ) break;
+      ckpt_off = cand_off;
+      ckpt_seq = cand_seq;
+      ckpt_end = off + sz;
+    }
+
+    off += blk->sz;
+    seq++;
+  }
+  ulong scan_end = off;
+
+  if( FD_UNLIKELY( ckpt_off==ULONG_MAX ) ) {
+    FD_LOG_WARNING(( "no complete checkpoint found" ));
+    return FD_FUNK_ERR_IO;
+  }
+
+  /* Replay from the checkpoint.  If a later checkpoint was started but
+     not completed, its blocks are only part of a scan (records erased
+     since the scan started are still in them), so stop where it
+     begins. */
+
+  ulong replay_end = ( (cand_off!=ULONG_MAX) & (cand_off>ckpt_off) ) ? cand_off : scan_end;
+
+  off = ckpt_off;
+  seq = ckpt_seq;
+  while( off<replay_end ) {
+    int err = fd_funk_persist_private_read( fd, blk, FD_FUNK_PERSIST_ALIGN, off );
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "read at offset %lu failed (%i-%s)", off, err, err==1 ? "unexpected end of file" : strerror( err ) ));
+      return FD_FUNK_ERR_IO;
+    }
+    ulong sz = blk->sz;
+    if( sz>FD_FUNK_PERSIST_ALIGN ) {
+      err = fd_funk_persist_private_read( fd, (uchar *)buf + FD_FUNK_PERSIST_ALIGN, sz-FD_FUNK_PERSIST_ALIGN, off+FD_FUNK_PERSIST_ALIGN );
+      if( FD_UNLIKELY( err ) ) {
+        if( FD_LIKELY( (err==1) & (off>=ckpt_end) ) ) break; /* Torn tail */
+        FD_LOG_WARNING(( "read at offset %lu failed (%i-%s)", off, err, err==1 ? "unexpected end of file" : strerror( err ) ));
+        return FD_FUNK_ERR_IO;
+      }
+    }
+    info->read_sz += sz;
+
+    if( FD_UNLIKELY( fd_funk_persist_private_blk_hash( blk )!=blk->hash ) ) {
+      if( FD_UNLIKELY( off<ckpt_end ) ) {
+        FD_LOG_WARNING(( "corrupt block %lu at offset %lu in the checkpoint", seq, off ));
+        return FD_FUNK_ERR_IO;
+      }
+      break; /* Torn tail */
+    }
+
+    err = fd_funk_persist_private_apply( funk, blk, info );
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "replay of block %lu at offset %lu failed (%i-%s)", seq, off, err, fd_funk_strerror( err ) ));
+      return err;
+    }
+
+    info->blk_cnt++;
+    off += sz;
+    seq++;
+  }
+
+  info->end_off = off;
+  info->blk_seq = seq;
+
+  if( opt_info ) *opt_info = *info;
+  return FD_FUNK_SUCCESS;
+}
@@ -0,0 +1,247 @@
+#ifndef HEADER_fd_src_funk_fd_funk_persist_h
+#define HEADER_fd_src_funk_fd_funk_persist_h
+
+/* fd_funk_persist incrementally writes the records of the last
+   published transaction of a funk to an append-only file in the
+   background and rebuilds a funk from such a file.
+
+   A persister attaches a publish log to the funk (see
+   fd_funk_pub_log_append in fd_funk.h) that records the keys of
+   published records as they are created, modified or erased.  Each
+   fd_funk_persist_poll copies the current values of as many logged
+   records as fit into its write buffer under the funk's record lock
+   (releasing it between records every FD_FUNK_PERSIST_LOCK_SZ bytes
+   copied) and appends the buffer to the file as a single checksummed
+   block with one write.  Blocks are multiples of
+   FD_FUNK_PERSIST_ALIGN bytes and are written from an
+   FD_FUNK_PERSIST_ALIGN aligned buffer at FD_FUNK_PERSIST_ALIGN aligned
+   file offsets, so the file can (and should) be opened with O_DIRECT.
+   As such, a persistence tile can poll concurrently with transaction
+   and record operations on the funk done by other tiles; it only
+   contends with them on the record lock for short bursts while
+   copying.
+
+   When a persister is attached, and whenever it falls more than
+   log_depth entries behind the publish log, it writes a checkpoint: a
+   scan of all records of the last published transaction delimited by
+   blocks flagged CKPT_BEGIN and CKPT_END.  Updates published while the
+   scan is in progress are logged and written after it.  Restoring
+   replays the file from the start of the last complete checkpoint and
+   stops at the first incomplete or corrupt block (e.g. a block torn by
+   a crash mid write) or at the start of a later checkpoint that was
+   not completed.  Files are never rewritten; compacting a file is
+   done by restoring it and attaching a persister to a new file.
+
+   A block is a fd_funk_persist_blk_t followed by rec_cnt records and
+   zero padding.  A record is the 64 byte record key, a uint val_sz, a
+   uint flags (FD_FUNK_REC_FLAG_ERASE if the record was erased, in which
+   case val_sz is 0) and val_sz bytes of value, zero padded to a
+   multiple of 8 bytes.  All integers are little endian.
+
+   Values of records of the last published transaction modified in
+   place (only possible while it has no in-preparation children) are
+   captured by the first poll after the fd_funk_rec_modify that
+   returned them.  Call fd_funk_rec_modify again after writing to the
+   value to have the final value persisted. */
+
+#include "fd_funk.h"
+
+/* FD_FUNK_PERSIST_ALIGN is the alignment of the write buffer, block
+   sizes and block file offsets.  This is compatible with O_DIRECT on
+   typical block devices. */
+
+#define FD_FUNK_PERSIST_ALIGN (4096UL)
+
+/* FD_FUNK_PERSIST_LOCK_SZ bounds the record bytes a poll copies per
+   hold of the funk's record lock.  Once that many were copied, the
+   lock is released and reacquired between two records. */
+
+#define FD_FUNK_PERSIST_LOCK_SZ (65536UL)
+
+#define FD_FUNK_PERSIST_MAGIC     (0xf17eda2ce7f5e500UL) /* firedancer funk persist version 0 */
+#define FD_FUNK_PERSIST_BLK_MAGIC (0xf17eda2ce7f5eb00UL) /* firedancer funk persist block version 0 */
+
+/* FD_FUNK_PERSIST_BLK_FLAG_* are flags of a block */
+
+#define FD_FUNK_PERSIST_BLK_FLAG_CKPT_BEGIN (1UL<<0) /* First block of a checkpoint */
+#define FD_FUNK_PERSIST_BLK_FLAG_CKPT_END   (1UL<<1) /* Last block of a checkpoint (can be the first block too) */
+
+/* FD_FUNK_PERSIST_REC_HDR_SZ is the size of a record before its value */
+
+#define FD_FUNK_PERSIST_REC_HDR_SZ (FD_FUNK_REC_KEY_FOOTPRINT+8UL)
+
+/* FD_FUNK_PERSIST_BUF_MIN is the smallest write buffer that can hold a
+   block with a record of the largest value funk supports. */
+
+#define FD_FUNK_PERSIST_BUF_MIN \
+  FD_ULONG_ALIGN_UP( sizeof(fd_funk_persist_blk_t)+FD_FUNK_PERSIST_REC_HDR_SZ+FD_FUNK_REC_VAL_MAX, FD_FUNK_PERSIST_ALIGN )
+
+struct fd_funk_persist_blk {
+  ulong magic;   /* ==FD_FUNK_PERSIST_BLK_MAGIC */
+  ulong seq;     /* Block sequence number, blocks of a file are numbered consecutively from 0 */
+  ulong sz;      /* Block size in bytes (including this header and the padding), positive multiple of FD_FUNK_PERSIST_ALIGN */
+  ulong data_sz; /* Bytes of records that follow this header */
+  ulong rec_cnt; /* Number of records in the block */
+  ulong flags;   /* FD_FUNK_PERSIST_BLK_FLAG_* */
+  ulong hash;    /* fd_hash of this header (with hash zero) and the records */
+  ulong reserved;
+};
+
+typedef struct fd_funk_persist_blk fd_funk_persist_blk_t;
+
+/* A fd_funk_persist_stats_t gives cumulative statistics of a persister.
+   data_sz counts the key and value bytes of the records written, such
+   that write_sz/data_sz is the write amplification of the persister
+   (including the checkpoints). */
+
+struct fd_funk_persist_stats {
+  ulong blk_cnt;   /* Blocks written */
+  ulong rec_cnt;   /* Records written (incl erased records) */
+  ulong erase_cnt; /* Erased records written */
+  ulong ckpt_cnt;  /* Checkpoints started */
+  ulong data_sz;   /* Key and value bytes of records written */
+  ulong write_sz;  /* Bytes written to the file */
+};
+
+typedef struct fd_funk_persist_stats fd_funk_persist_stats_t;
+
+/* A fd_funk_persist_restore_info_t describes the outcome of a restore */
+
+struct fd_funk_persist_restore_info {
+  ulong blk_cnt;   /* Blocks replayed */
+  ulong rec_cnt;   /* Records replayed (incl erased records) */
+  ulong erase_cnt; /* Erased records replayed */
+  ulong read_sz;   /* Bytes read from the file */
+  ulong end_off;   /* File offset of the end of the last valid block */
+  ulong blk_seq;   /* Sequence number of the block that would follow the last valid block */
+};
+
+typedef struct fd_funk_persist_restore_info fd_funk_persist_restore_info_t;
+
+struct fd_funk_persist_private;
+typedef struct fd_funk_persist_private fd_funk_persist_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_funk_persist_{align,footprint} return the alignment and footprint
+   of a memory region suitable for use as a persister with a write
+   buffer of buf_max bytes.  footprint returns 0 if buf_max is not a
+   multiple of FD_FUNK_PERSIST_ALIGN or is less than
+   FD_FUNK_PERSIST_BUF_MIN. */
+
+FD_FN_CONST ulong
+fd_funk_persist_align( void );
+
+FD_FN_CONST ulong
+fd_funk_persist_footprint( ulong buf_max );
+
+/* fd_funk_persist_new formats an unused memory region for use as a
+   persister.  Returns shmem on success and NULL on failure (logs
+   details).  fd_funk_persist_join joins the caller to the persister,
+   returning a local handle on success and NULL on failure (logs
+   details).  fd_funk_persist_leave leaves a current local join.
+   fd_funk_persist_delete unformats a memory region used as a detached
+   persister.  Returns shmem on success and NULL on failure (logs
+   details).  A persister holds a file descriptor and a local funk join
+   while attached and should only be used by the process that attached
+   it. */
+
+void *
+fd_funk_persist_new( void * shmem,
+                     ulong  buf_max );
+
+fd_funk_persist_t *
+fd_funk_persist_join( void * shpersist );
+
+void *
+fd_funk_persist_leave( fd_funk_persist_t * persist );
+
+void *
+fd_funk_persist_delete( void * shpersist );
+
+/* fd_funk_persist_attach starts persisting funk to the file open for
+   writing as fd.  log_depth is the number of entries of the publish log
+   to allocate in the funk's wksp (a positive integer power of 2; it
+   should comfortably exceed the number of records published between
+   two polls to avoid checkpoints).  The first block is written at
+   offset file_off with sequence number blk_seq (0 and 0 for a new file,
+   or the end_off and blk_seq of a restore to append to a restored
+   file).  The first polls write a checkpoint.  Returns FD_FUNK_SUCCESS
+   on success and a FD_FUNK_ERR_* code on failure (logs details).
+   Reasons for failure include bad arguments, the funk already has a
+   persister (ERR_INVAL) and the wksp being too small for the log
+   (ERR_MEM).  Assumes no concurrent transaction operations on funk.
+
+   fd_funk_persist_detach stops persisting, frees the publish log and
+   returns the persister to the detached state.  Blocks not yet written
+   are discarded; poll until fd_funk_persist_pending is zero first to
+   have everything published so far on disk.  The caller remains
+   responsible for closing the file.  Assumes no concurrent transaction
+   operations on funk.  A persister should be detached before its funk
+   is deleted. */
+
+int
+fd_funk_persist_attach( fd_funk_persist_t * persist,
+                        fd_funk_t *         funk,
+                        ulong               log_depth,
+                        int                 fd,
+                        ulong               file_off,
+                        ulong               blk_seq );
+
+void
+fd_funk_persist_detach( fd_funk_persist_t * persist );
+
+/* fd_funk_persist_poll writes at most one block with the records
+   logged since the last poll (or, if a checkpoint is in progress, the
+   next chunk of the checkpoint scan).  Returns FD_FUNK_SUCCESS if a
+   block was written or there was nothing to write and FD_FUNK_ERR_IO if
+   the write failed (logs details, the block will be retried on the
+   next poll).  On return, if opt_rec_cnt is non-NULL, *opt_rec_cnt has
+   the number of records in the block written (0 if none).  Assumes the
+   persister is attached. */
+
+int
+fd_funk_persist_poll( fd_funk_persist_t * persist,
+                      ulong *             opt_rec_cnt );
+
+/* fd_funk_persist_pending returns 0 if all changes to the last
+   published transaction logged so far have been written and non-zero
+   otherwise.  Only meaningful if there are no concurrent operations on
+   the funk. */
+
+FD_FN_PURE int
+fd_funk_persist_pending( fd_funk_persist_t const * persist );
+
+/* fd_funk_persist_stats returns the statistics of the persister.  The
+   lifetime of the returned pointer is that of the local join. */
+
+FD_FN_CONST fd_funk_persist_stats_t const *
+fd_funk_persist_stats( fd_funk_persist_t const * persist );
+
+/* fd_funk_persist_restore rebuilds the last published transaction of
+   funk from the file open for reading as fd.  buf is a scratch buffer
+   of buf_max bytes aligned to FD_FUNK_PERSIST_ALIGN, where buf_max is
+   at least the buf_max of the persister that wrote the file.  The
+   records of the last complete checkpoint and the blocks that follow it
+   are applied to the last published transaction of funk (which is
+   expected to be empty and must not be frozen).  Replay stops at the
+   end of the file, the first block that is incomplete, corrupt or out
+   of sequence or the first block of a checkpoint that was not
+   completed (such that a persister attached at end_off overwrites it).  Returns FD_FUNK_SUCCESS on success and a FD_FUNK_ERR_*
+   code on failure (logs details).  Reasons for failure include bad
+   arguments, a frozen last published transaction (ERR_FROZEN), a read
+   error or no complete checkpoint (ERR_IO) and funk running out of
+   records (ERR_REC) or value memory (ERR_MEM).  If opt_info is
+   non-NULL, on success, *opt_info describes the restore.  Assumes no
+   concurrent operations on funk. */
+
+int
+fd_funk_persist_restore( fd_funk_t *                      funk,
+                         int                              fd,
+                         void *                           buf,
+                         ulong                            buf_max,
+                         fd_funk_persist_restore_info_t * opt_info );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_funk_fd_funk_persist_h */
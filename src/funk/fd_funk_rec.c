@@ -14,16 +14,43 @@
 #define MAP_IMPL_STYLE        2
 #include "../util/tmpl/fd_map_giant.c"
 
+/* The fd_funk_rec_*_locked functions below assume the caller holds
+   the funk's record lock (see fd_funk_rec_lock). */
+
+/* fd_funk_rec_alloc returns a join to the funk's allocator that uses
+   the caller's tile index as the concurrency group hint, such that
+   value allocations done concurrently by different tiles mostly use
+   different superblocks. */
+
+static inline fd_alloc_t *
+fd_funk_rec_alloc( fd_funk_t * funk,
+                   fd_wksp_t * wksp ) {
+  return fd_alloc_join_cgroup_hint_set( fd_funk_alloc( funk, wksp ), fd_tile_idx() );
+}
+
+static fd_funk_rec_t const *
+fd_funk_rec_query_locked( fd_funk_t *               funk,
+                          fd_funk_txn_t const *     txn,
+                          fd_funk_rec_key_t const * key ) {
+
+  if( FD_UNLIKELY( !key ) ) return NULL;
+
+  fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, txn ? fd_funk_txn_xid( txn ) : fd_funk_root( funk ), key );
+
+  return fd_funk_rec_map_query_const( fd_funk_rec_map( funk, fd_funk_wksp( funk ) ), pair, NULL );
+}
+
 fd_funk_rec_t const *
 fd_funk_rec_query( fd_funk_t *               funk,
                    fd_funk_txn_t const *     txn,
                    fd_funk_rec_key_t const * key ) {
 
-  if( FD_UNLIKELY( (!funk) | (!key) ) ) return NULL;
+  if( FD_UNLIKELY( !funk ) ) return NULL;
 
-  fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, txn ? fd_funk_txn_xid( txn ) : fd_funk_root( funk ), key );
-
-  return fd_funk_rec_map_query( fd_funk_rec_map( funk, fd_funk_wksp( funk ) ), pair, NULL );
+  fd_funk_rec_lock( funk );
+  fd_funk_rec_t const * rec = fd_funk_rec_query_locked( funk, txn, key );
+  fd_funk_rec_unlock( funk );
+  return rec;
 }
 
 fd_funk_rec_t const *
@@ -37,42 +64,154 @@ fd_funk_rec_query_const( fd_funk_t *               funk,
   return fd_funk_rec_map_query_const( fd_funk_rec_map( funk, fd_funk_wksp( funk ) ), pair, NULL );
 }
 
-fd_funk_rec_t const *
-fd_funk_rec_query_global( fd_funk_t *               funk,
-                          fd_funk_txn_t const *     txn,
-                          fd_funk_rec_key_t const * key ) {
+/* fd_funk_rec_cache_set returns the set of the record cache that holds
+   the entries for key. */
 
-  if( FD_UNLIKELY( (!funk) | (!key) ) ) return NULL;
+static inline fd_funk_rec_cache_entry_t *
+fd_funk_rec_cache_set( fd_funk_t *               funk,
+                       fd_wksp_t *               wksp,
+                       fd_funk_rec_key_t const * key ) {
+  ulong set_idx = fd_funk_rec_key_hash( key, funk->seed ) & (FD_FUNK_REC_CACHE_SET_CNT-1UL);
+  return fd_funk_rec_cache( funk, wksp ) + set_idx*FD_FUNK_REC_CACHE_WAY_CNT;
+}
+
+/* fd_funk_rec_cache_query returns the cache entry for the global query
+   of key in transaction txn_idx or NULL if there is no such entry. */
+
+static inline fd_funk_rec_cache_entry_t const *
+fd_funk_rec_cache_query( fd_funk_rec_cache_entry_t const * set,
+                         ulong                             gen,
+                         ulong                             txn_idx,
+                         fd_funk_rec_key_t const *         key ) {
+  for( ulong way=0UL; way<FD_FUNK_REC_CACHE_WAY_CNT; way++ ) {
+    fd_funk_rec_cache_entry_t const * entry = set + way;
+    if( (entry->gen==gen) & (fd_funk_txn_idx( entry->txn_cidx )==txn_idx) && fd_funk_rec_key_eq( &entry->key, key ) ) return entry;
+  }
+  return NULL;
+}
+
+/* fd_funk_rec_cache_evict invalidates all cache entries for key.  This
+   needs to be done whenever a (xid,key) pair is mapped or unmapped
+   outside of transaction publish, merge and cancel. */
+
+static void
+fd_funk_rec_cache_evict( fd_funk_t *               funk,
+                         fd_wksp_t *               wksp,
+                         fd_funk_rec_key_t const * key ) {
+  fd_funk_rec_cache_entry_t * set = fd_funk_rec_cache_set( funk, wksp, key );
+  for( ulong way=0UL; way<FD_FUNK_REC_CACHE_WAY_CNT; way++ )
+    if( fd_funk_rec_key_eq( &set[ way ].key, key ) ) set[ way ].gen = 0UL;
+}
+
+/* fd_funk_rec_query_global_private queries txn (which has been
+   validated) and its in-prep ancestors for key the slow way.  The map
+   is only read (see fd_funk_rec_query_const). */
+
+static inline fd_funk_rec_t const *
+fd_funk_rec_query_global_private( fd_funk_t *               funk,
+                                  fd_funk_rec_t *           rec_map,
+                                  fd_funk_txn_t *           txn_map,
+                                  fd_funk_txn_t const *     txn,
+                                  fd_funk_rec_key_t const * key ) {
+
+  /* TODO: const correct and/or fortify? */
+  do {
+    fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_txn_xid( txn ), key );
+    fd_funk_rec_t const * rec = fd_funk_rec_map_query_const( rec_map, pair, NULL );
+    if( FD_LIKELY( rec ) ) return rec;
+    txn = fd_funk_txn_parent( (fd_funk_txn_t *)txn, txn_map );
+  } while( FD_UNLIKELY( txn ) );
+
+  /* Query the last published transaction */
+
+  fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_root( funk ), key );
+  return fd_funk_rec_map_query_const( rec_map, pair, NULL );
+}
+
+/* fd_funk_rec_query_global_relock is fd_funk_rec_query_global for a
+   caller that holds the record lock.  On a cache miss, the lock is
+   released for the ancestor walk, which is O(in_prep_ancestor_cnt) map
+   queries, and retaken to fill the cache before returning.  The walk
+   is safe without the lock because transaction operations don't run
+   concurrently with record operations (so the ancestry is stable), no
+   other thread operates on key (so the answer can't change), record
+   operations only do const queries of the map (so chains are never
+   reordered) and inserts make an element reachable only once its key
+   and next are set.  A remove could move the element the walk is on to
+   the free stack, and the walk would then miss key, so the walk is
+   redone under the lock if rec_rm_seq changed in the meantime.  The
+   caller should not rely on anything else it looked at under the lock
+   before the call. */
+
+static fd_funk_rec_t const *
+fd_funk_rec_query_global_relock( fd_funk_t *               funk,
+                                 fd_funk_txn_t const *     txn,
+                                 fd_funk_rec_key_t const * key ) {
+
+  if( FD_UNLIKELY( !key ) ) return NULL;
 
   fd_wksp_t * wksp = fd_funk_wksp( funk );
 
   fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
 
-  if( txn ) { /* Query txn and its in-prep ancestors */
+  if( !txn ) { /* Query the last published transaction */
+    fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_root( funk ), key );
+    return fd_funk_rec_map_query_const( rec_map, pair, NULL );
+  }
 
-    fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
+  /* Query txn and its in-prep ancestors */
 
-    ulong txn_max = funk->txn_max;
+  fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
 
-    ulong txn_idx = (ulong)(txn - txn_map);
+  ulong txn_max = funk->txn_max;
 
-    if( FD_UNLIKELY( (txn_idx>=txn_max) /* Out of map (incl NULL) */ | (txn!=(txn_map+txn_idx)) /* Bad alignment */ ) )
-      return NULL;
+  ulong txn_idx = (ulong)(txn - txn_map);
 
-    /* TODO: const correct and/or fortify? */
-    do {
-      fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_txn_xid( txn ), key );
-      fd_funk_rec_t const * rec = fd_funk_rec_map_query( rec_map, pair, NULL );
-      if( FD_LIKELY( rec ) ) return rec;
-      txn = fd_funk_txn_parent( (fd_funk_txn_t *)txn, txn_map );
-    } while( FD_UNLIKELY( txn ) );
+  if( FD_UNLIKELY( (txn_idx>=txn_max) /* Out of map (incl NULL) */ | (txn!=(txn_map+txn_idx)) /* Bad alignment */ ) )
+    return NULL;
 
+  ulong                       gen   = funk->rec_cache_gen;
+  fd_funk_rec_cache_entry_t * set   = fd_funk_rec_cache_set( funk, wksp, key );
+  fd_funk_rec_cache_entry_t * entry = (fd_funk_rec_cache_entry_t *)fd_funk_rec_cache_query( set, gen, txn_idx, key );
+  if( FD_LIKELY( entry ) ) { /* Cache hit, opt for repeated queries */
+    ulong rec_idx = entry->rec_idx;
+    if( fd_funk_rec_idx_is_null( rec_idx ) ) return NULL;
+    if( FD_UNLIKELY( rec_idx>=funk->rec_max ) ) FD_LOG_CRIT(( "memory corruption detected (bad idx)" ));
+    return rec_map + rec_idx;
   }
 
-  /* Query the last published transaction */
+  ulong rm_seq = funk->rec_rm_seq;
+  fd_funk_rec_unlock( funk );
+  fd_funk_rec_t const * rec = fd_funk_rec_query_global_private( funk, rec_map, txn_map, txn, key );
+  fd_funk_rec_lock( funk );
+  if( FD_UNLIKELY( funk->rec_rm_seq!=rm_seq ) ) rec = fd_funk_rec_query_global_private( funk, rec_map, txn_map, txn, key );
 
-  fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_root( funk ), key );
-  return fd_funk_rec_map_query( rec_map, pair, NULL );
+  /* Fill the first stale way of the set or, if none, evict the way
+     selected by txn_idx */
+
+  ulong way = txn_idx & (FD_FUNK_REC_CACHE_WAY_CNT-1UL);
+  for( ulong i=0UL; i<FD_FUNK_REC_CACHE_WAY_CNT; i++ ) if( set[ i ].gen!=gen ) { way = i; break; }
+
+  entry = set + way;
+  fd_funk_rec_key_copy( &entry->key, key );
+  entry->gen      = gen;
+  entry->rec_idx  = rec ? (ulong)(rec - rec_map) : FD_FUNK_REC_IDX_NULL;
+  entry->txn_cidx = fd_funk_txn_cidx( txn_idx );
+
+  return rec;
+}
+
+fd_funk_rec_t const *
+fd_funk_rec_query_global( fd_funk_t *               funk,
+                          fd_funk_txn_t const *     txn,
+                          fd_funk_rec_key_t const * key ) {
+
+  if( FD_UNLIKELY( !funk ) ) return NULL;
+
+  fd_funk_rec_lock( funk );
+  fd_funk_rec_t const * rec = fd_funk_rec_query_global_relock( funk, txn, key );
+  fd_funk_rec_unlock( funk );
+  return rec;
 }
 
 fd_funk_rec_t const *
@@ -86,38 +225,39 @@ fd_funk_rec_query_global_const( fd_funk_t *               funk,
 
   fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
 
-  if( txn ) { /* Query txn and its in-prep ancestors */
+  if( !txn ) { /* Query the last published transaction */
+    fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_root( funk ), key );
+    return fd_funk_rec_map_query_const( rec_map, pair, NULL );
+  }
 
-    fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
+  /* Query txn and its in-prep ancestors */
 
-    ulong txn_max = funk->txn_max;
+  fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
 
-    ulong txn_idx = (ulong)(txn - txn_map);
+  ulong txn_max = funk->txn_max;
 
-    if( FD_UNLIKELY( (txn_idx>=txn_max) /* Out of map (incl NULL) */ | (txn!=(txn_map+txn_idx)) /* Bad alignment */ ) )
-      return NULL;
+  ulong txn_idx = (ulong)(txn - txn_map);
 
-    /* TODO: const correct and/or fortify? */
-    do {
-      fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_txn_xid( txn ), key );
-      fd_funk_rec_t const * rec = fd_funk_rec_map_query_const( rec_map, pair, NULL );
-      if( FD_LIKELY( rec ) ) return rec;
-      txn = fd_funk_txn_parent( (fd_funk_txn_t *)txn, txn_map );
-    } while( FD_UNLIKELY( txn ) );
+  if( FD_UNLIKELY( (txn_idx>=txn_max) /* Out of map (incl NULL) */ | (txn!=(txn_map+txn_idx)) /* Bad alignment */ ) )
+    return NULL;
 
-  }
+  /* The cache is only read here so that concurrent queries are safe */
 
-  /* Query the last published transaction */
+  fd_funk_rec_cache_entry_t const * entry =
+    fd_funk_rec_cache_query( fd_funk_rec_cache_set( funk, wksp, key ), funk->rec_cache_gen, txn_idx, key );
+  if( FD_LIKELY( entry ) ) {
+    ulong rec_idx = entry->rec_idx;
+    if( fd_funk_rec_idx_is_null( rec_idx ) ) return NULL;
+    if( FD_UNLIKELY( rec_idx>=funk->rec_max ) ) FD_LOG_CRIT(( "memory corruption detected (bad idx)" ));
+    return rec_map + rec_idx;
+  }
 
-  fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_root( funk ), key );
-  return fd_funk_rec_map_query_const( rec_map, pair, NULL );
+  return fd_funk_rec_query_global_private( funk, rec_map, txn_map, txn, key );
 }
 
-int
-fd_funk_rec_test( fd_funk_t *           funk,
-                  fd_funk_rec_t const * rec ) {
-
-  if( FD_UNLIKELY( !funk ) ) return FD_FUNK_ERR_INVAL;
+static int
+fd_funk_rec_test_locked( fd_funk_t *           funk,
+                         fd_funk_rec_t const * rec ) {
 
   fd_wksp_t * wksp = fd_funk_wksp( funk );
 
@@ -152,11 +292,23 @@ fd_funk_rec_test( fd_funk_t *           funk,
   return FD_FUNK_SUCCESS;
 }
 
-fd_funk_rec_t *
-fd_funk_rec_modify( fd_funk_t *           funk,
-                    fd_funk_rec_t const * rec ) {
+int
+fd_funk_rec_test( fd_funk_t *           funk,
+                  fd_funk_rec_t const * rec ) {
+
+  if( FD_UNLIKELY( !funk ) ) return FD_FUNK_ERR_INVAL;
+
+  fd_funk_rec_lock( funk );
+  int err = fd_funk_rec_test_locked( funk, rec );
+  fd_funk_rec_unlock( funk );
+  return err;
+}
 
-  if( FD_UNLIKELY( (!funk) | (!rec) ) ) return NULL;
+static fd_funk_rec_t *
+fd_funk_rec_modify_locked( fd_funk_t *           funk,
+                           fd_funk_rec_t const * rec ) {
+
+  if( FD_UNLIKELY( !rec ) ) return NULL;
 
   fd_wksp_t * wksp = fd_funk_wksp( funk );
 
@@ -169,7 +321,7 @@ fd_funk_rec_modify( fd_funk_t *           funk,
   if( FD_UNLIKELY( (rec_idx>=rec_max) /* Out of map (incl NULL) */ | (rec!=(rec_map+rec_idx)) /* Bad alignment */ ) )
     return NULL;
 
-  if( FD_UNLIKELY( rec!=fd_funk_rec_map_query( rec_map, fd_funk_rec_pair( rec ), NULL ) ) ) return NULL; /* Not live */
+  if( FD_UNLIKELY( rec!=fd_funk_rec_map_query_const( rec_map, fd_funk_rec_pair( rec ), NULL ) ) ) return NULL; /* Not live */
 
   ulong txn_idx = fd_funk_txn_idx( rec->txn_cidx );
 
@@ -177,6 +329,8 @@ fd_funk_rec_modify( fd_funk_t *           funk,
 
     if( FD_UNLIKELY( fd_funk_last_publish_is_frozen( funk ) ) ) return NULL;
 
+    fd_funk_pub_log_append( funk, wksp, fd_funk_rec_key( rec ), 0UL );
+
   } else { /* Modifying an in-prep tranaction */
 
     fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
@@ -191,14 +345,25 @@ fd_funk_rec_modify( fd_funk_t *           funk,
   return (fd_funk_rec_t *)rec;
 }
 
-fd_funk_rec_t const *
-fd_funk_rec_insert( fd_funk_t *               funk,
-                    fd_funk_txn_t *           txn,
-                    fd_funk_rec_key_t const * key,
-                    int *                     opt_err ) {
+fd_funk_rec_t *
+fd_funk_rec_modify( fd_funk_t *           funk,
+                    fd_funk_rec_t const * rec ) {
+
+  if( FD_UNLIKELY( !funk ) ) return NULL;
 
-  if( FD_UNLIKELY( (!funk) |     /* NULL funk */
-                   (!key ) ) ) { /* NULL key */
+  fd_funk_rec_lock( funk );
+  fd_funk_rec_t * mod = fd_funk_rec_modify_locked( funk, rec );
+  fd_funk_rec_unlock( funk );
+  return mod;
+}
+
+static fd_funk_rec_t const *
+fd_funk_rec_insert_locked( fd_funk_t *               funk,
+                           fd_funk_txn_t *           txn,
+                           fd_funk_rec_key_t const * key,
+                           int *                     opt_err ) {
+
+  if( FD_UNLIKELY( !key ) ) {
     fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_INVAL );
     return NULL;
   }
@@ -232,7 +397,7 @@ fd_funk_rec_insert( fd_funk_t *               funk,
 
     fd_funk_xid_key_pair_init( pair, fd_funk_root( funk ), key );
 
-    fd_funk_rec_t * rec = fd_funk_rec_map_query( rec_map, pair, NULL );
+    fd_funk_rec_t * rec = (fd_funk_rec_t *)fd_funk_rec_map_query_const( rec_map, pair, NULL );
 
     if( FD_UNLIKELY( rec ) ) { /* Already a record present */
       if( FD_UNLIKELY( rec->flags & FD_FUNK_REC_FLAG_ERASE ) ) FD_LOG_CRIT(( "memory corruption detected (bad flags)" ));
@@ -240,6 +405,8 @@ fd_funk_rec_insert( fd_funk_t *               funk,
       return NULL;
     }
 
+    fd_funk_pub_log_append( funk, wksp, key, 0UL );
+
   } else { /* Modifying in-prep */
 
     fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
@@ -267,7 +434,7 @@ fd_funk_rec_insert( fd_funk_t *               funk,
 
     fd_funk_xid_key_pair_init( pair, fd_funk_txn_xid( txn ), key );
 
-    fd_funk_rec_t * rec = fd_funk_rec_map_query( rec_map, pair, NULL );
+    fd_funk_rec_t * rec = (fd_funk_rec_t *)fd_funk_rec_map_query_const( rec_map, pair, NULL );
 
     if( FD_UNLIKELY( rec ) ) { /* Already a record present */
 
@@ -302,6 +469,8 @@ fd_funk_rec_insert( fd_funk_t *               funk,
   ulong           rec_idx = (ulong)(rec - rec_map);
   if( FD_UNLIKELY( rec_idx>=rec_max ) ) FD_LOG_CRIT(( "memory corruption detected (bad idx)" ));
 
+  fd_funk_rec_cache_evict( funk, wksp, key ); /* Global queries for key from txn or its descendants now resolve to rec */
+
   ulong rec_prev_idx = *_rec_tail_idx;
 
   int first_born = fd_funk_rec_idx_is_null( rec_prev_idx );
@@ -329,12 +498,27 @@ fd_funk_rec_insert( fd_funk_t *               funk,
   return rec;
 }
 
-int
-fd_funk_rec_remove( fd_funk_t *     funk,
-                    fd_funk_rec_t * rec,
-                    int             erase ) {
+fd_funk_rec_t const *
+fd_funk_rec_insert( fd_funk_t *               funk,
+                    fd_funk_txn_t *           txn,
+                    fd_funk_rec_key_t const * key,
+                    int *                     opt_err ) {
 
-  if( FD_UNLIKELY( !funk ) ) return FD_FUNK_ERR_INVAL;
+  if( FD_UNLIKELY( !funk ) ) {
+    fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_INVAL );
+    return NULL;
+  }
+
+  fd_funk_rec_lock( funk );
+  fd_funk_rec_t const * rec = fd_funk_rec_insert_locked( funk, txn, key, opt_err );
+  fd_funk_rec_unlock( funk );
+  return rec;
+}
+
+static int
+fd_funk_rec_remove_locked( fd_funk_t *     funk,
+                           fd_funk_rec_t * rec,
+                           int             erase ) {
 
   fd_wksp_t * wksp = fd_funk_wksp( funk );
 
@@ -372,6 +556,8 @@ fd_funk_rec_remove( fd_funk_t *     funk,
     _rec_head_idx = &funk->rec_head_idx;
     _rec_tail_idx = &funk->rec_tail_idx;
 
+    fd_funk_pub_log_append( funk, wksp, fd_funk_rec_key( rec ), FD_FUNK_REC_FLAG_ERASE );
+
   } else { /* Removing from in-prep transaction */
 
     fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
@@ -409,7 +595,7 @@ fd_funk_rec_remove( fd_funk_t *     funk,
         ulong parent_idx = fd_funk_txn_idx( txn_map[ cur_idx ].parent_cidx );
         if( FD_LIKELY( fd_funk_txn_idx_is_null( parent_idx ) ) ) { /* Parent txn is last published, opt for shallow */
 
-          fd_funk_rec_t const * erase_rec = fd_funk_rec_query( funk, NULL, fd_funk_rec_key( rec ) );
+          fd_funk_rec_t const * erase_rec = fd_funk_rec_query_locked( funk, NULL, fd_funk_rec_key( rec ) );
           if( FD_UNLIKELY( !erase_rec ) ) break; /* No ancestor has this record, can free immediately, opt no flicker */
 
           /* Record is available in last published ... this remove
@@ -420,7 +606,7 @@ fd_funk_rec_remove( fd_funk_t *     funk,
           if( FD_UNLIKELY( erase_rec->flags & FD_FUNK_REC_FLAG_ERASE ) ) FD_LOG_CRIT(( "memory corruption detected (bad flags)" ));
 
           rec->flags |= FD_FUNK_REC_FLAG_ERASE;
-          fd_funk_val_flush( rec, fd_funk_alloc( funk, wksp ), wksp ); /* TODO: consider testing wksp_gaddr has wksp_tag? */
+          fd_funk_val_flush( rec, fd_funk_rec_alloc( funk, wksp ), wksp ); /* TODO: consider testing wksp_gaddr has wksp_tag? */
           return FD_FUNK_SUCCESS;
 
         }
@@ -428,7 +614,7 @@ fd_funk_rec_remove( fd_funk_t *     funk,
         if( FD_UNLIKELY( parent_idx>=txn_max            ) ) FD_LOG_CRIT(( "memory corruption detected (bad idx)" ));
         if( FD_UNLIKELY( txn_map[ parent_idx ].tag==tag ) ) FD_LOG_CRIT(( "memory corruption detected (cycle)" ));
 
-        fd_funk_rec_t const * erase_rec = fd_funk_rec_query( funk, &txn_map[ parent_idx ], fd_funk_rec_key( rec ) );
+        fd_funk_rec_t const * erase_rec = fd_funk_rec_query_locked( funk, &txn_map[ parent_idx ], fd_funk_rec_key( rec ) );
         if( FD_LIKELY( erase_rec ) ) { /* Opt for shallow */
 
           /* Record is available in an in-prep ancestor ... this remove
@@ -456,7 +642,7 @@ fd_funk_rec_remove( fd_funk_t *     funk,
              record. */
 
           rec->flags |= FD_FUNK_REC_FLAG_ERASE;
-          fd_funk_val_flush( rec, fd_funk_alloc( funk, wksp ), wksp ); /* TODO: consider testing wksp_gaddr has wksp_tag? */
+          fd_funk_val_flush( rec, fd_funk_rec_alloc( funk, wksp ), wksp ); /* TODO: consider testing wksp_gaddr has wksp_tag? */
           return FD_FUNK_SUCCESS;
         }
 
@@ -478,7 +664,7 @@ fd_funk_rec_remove( fd_funk_t *     funk,
   /* Flush the value, remove the record from its list, and unmap the
      record */
 
-  fd_funk_val_flush( rec, fd_funk_alloc( funk, wksp ), wksp ); /* TODO: consider testing wksp_gaddr has wksp_tag? */
+  fd_funk_val_flush( rec, fd_funk_rec_alloc( funk, wksp ), wksp ); /* TODO: consider testing wksp_gaddr has wksp_tag? */
 
   ulong prev_idx = rec->prev_idx;
   ulong next_idx = rec->next_idx;
@@ -496,53 +682,91 @@ fd_funk_rec_remove( fd_funk_t *     funk,
   if( next_null ) *_rec_tail_idx               = prev_idx;
   else            rec_map[ next_idx ].prev_idx = prev_idx;
 
+  fd_funk_rec_cache_evict( funk, wksp, fd_funk_rec_key( rec ) );
+
   fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( rec ) );
+  funk->rec_rm_seq++;
 
   return FD_FUNK_SUCCESS;
 }
 
+int
+fd_funk_rec_remove( fd_funk_t *     funk,
+                    fd_funk_rec_t * rec,
+                    int             erase ) {
+
+  if( FD_UNLIKELY( !funk ) ) return FD_FUNK_ERR_INVAL;
+
+  fd_funk_rec_lock( funk );
+  int err = fd_funk_rec_remove_locked( funk, rec, erase );
+  fd_funk_rec_unlock( funk );
+  return err;
+}
+
 fd_funk_rec_t *
 fd_funk_rec_write_prepare( fd_funk_t *               funk,
                            fd_funk_txn_t *           txn,
                            fd_funk_rec_key_t const * key,
                            ulong                     min_val_size,
                            int *                     opt_err ) {
-  
+
+  if( FD_UNLIKELY( !funk ) ) {
+    fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_INVAL );
+    return NULL;
+  }
+
   fd_wksp_t * wksp = fd_funk_wksp( funk );
-  
-  fd_funk_rec_t * rec = NULL;
-  fd_funk_rec_t const * rec_con = fd_funk_rec_query_global( funk, txn, key );
-  if ( rec_con ) {
-    /* We have an incarnation of the record */
-    if ( txn == fd_funk_rec_txn( rec_con,  fd_funk_txn_map( funk, wksp ) ) ) {
-      /* The record is already in the right transaction */
-      rec = fd_funk_rec_modify( funk, rec_con );
-      if ( !rec ) {
-        fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_FROZEN );
-        return NULL;
-      }
 
-    } else {
-      /* Copy the record into the transaction */
-      rec = fd_funk_rec_modify( funk, fd_funk_rec_insert( funk, txn, key, opt_err ) );
-      if ( !rec )
-        return NULL;
-      rec = fd_funk_val_copy( rec, fd_funk_val_const(rec_con, wksp), fd_funk_val_sz(rec_con), 
-        fd_ulong_max( fd_funk_val_sz(rec_con), min_val_size ), fd_funk_alloc( funk, wksp ), wksp, opt_err );
-      if ( !rec )
-        return NULL;
-    }
+  /* Find or create the record in txn under the lock.  The value is
+     copied and resized after releasing it, such that concurrent writers
+     of different records only serialize on the metadata updates. */
 
+  fd_funk_rec_lock( funk );
+
+  fd_funk_rec_t *       rec      = NULL;
+  fd_funk_rec_t const * copy_rec = NULL;
+  fd_funk_rec_t const * rec_con  = fd_funk_rec_query_global_relock( funk, txn, key );
+  if( rec_con && txn==fd_funk_rec_txn( rec_con, fd_funk_txn_map( funk, wksp ) ) ) {
+    /* The record is already in the right transaction */
+    rec = fd_funk_rec_modify_locked( funk, rec_con );
+    if( !rec ) fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_FROZEN );
   } else {
-    /* Create a new record */
-    rec = fd_funk_rec_modify( funk, fd_funk_rec_insert( funk, txn, key, opt_err ) );
-    if ( !rec )
-      return NULL;
+    /* Create a new record, copying the ancestor incarnation if any */
+    rec      = fd_funk_rec_modify_locked( funk, fd_funk_rec_insert_locked( funk, txn, key, opt_err ) );
+    copy_rec = rec_con;
+  }
+
+  fd_funk_rec_unlock( funk );
+
+  if( FD_UNLIKELY( !rec ) ) return NULL;
+
+  fd_alloc_t * alloc = fd_funk_rec_alloc( funk, wksp );
+
+  /* If the record has no value yet and the value it is about to get
+     fits in one of the funk's value slabs, give it a slab slot.  The
+     copy and truncate below then happen in place. */
+
+  if( FD_LIKELY( !rec->val_max ) ) {
+    ulong val_sz = copy_rec ? fd_ulong_max( fd_funk_val_sz( copy_rec ), min_val_size ) : min_val_size;
+    ulong val_max;
+    uchar * val = (uchar *)fd_funk_val_slab_acquire( funk, val_sz, &val_max );
+    if( val ) {
+      if( !copy_rec ) fd_memset( val, 0, val_max ); /* The copy below clears the slot otherwise */
+      rec->val_max   = (uint)val_max;
+      rec->val_gaddr = fd_wksp_gaddr_fast( wksp, val );
+      rec->flags    |= FD_FUNK_REC_FLAG_SLAB;
+    }
+  }
+
+  if( copy_rec ) {
+    rec = fd_funk_val_copy( rec, fd_funk_val_const( copy_rec, wksp ), fd_funk_val_sz( copy_rec ),
+                            fd_ulong_max( fd_funk_val_sz( copy_rec ), min_val_size ), alloc, wksp, opt_err );
+    if( FD_UNLIKELY( !rec ) ) return NULL;
   }
 
   /* Grow the record to the right size */
-  if ( fd_funk_val_sz( rec ) < min_val_size )
-    rec = fd_funk_val_truncate( rec, min_val_size, fd_funk_alloc( funk, wksp ), wksp, opt_err );
+  if( fd_funk_val_sz( rec ) < min_val_size )
+    rec = fd_funk_val_truncate( rec, min_val_size, alloc, wksp, opt_err );
 
   return rec;
 }
@@ -27,11 +27,36 @@
 
 #define FD_FUNK_REC_FLAG_ERASE (1UL<<0)
 
+/* - SLAB indicates the record value is a slot of one of the funk's
+   value slabs (see fd_funk_val_slab_config) rather than a fd_alloc
+   allocation.  It travels with the value metadata and is cleared when
+   the value is flushed or moved out of the slab.  Internal use only. */
+
+#define FD_FUNK_REC_FLAG_SLAB (1UL<<1)
+
 /* FD_FUNK_REC_IDX_NULL gives the map record idx value used to represent
    NULL.  This value also set a limit on how large rec_max can be. */
 
 #define FD_FUNK_REC_IDX_NULL (ULONG_MAX)
 
+/* FD_FUNK_REC_CACHE_{SET_CNT,WAY_CNT} give the geometry of the record
+   cache used to accelerate fd_funk_rec_query_global.  The cache is a
+   set associative table indexed by the record key hash whose entries
+   memoize the result of a global query for a (txn,key) pair, including
+   queries that found nothing.  Entries are stamped with the funk's
+   cache generation.  Publishing, merging or cancelling a transaction
+   starts a new generation (invalidating all entries) while inserting or
+   removing a record only evicts the entries for its key (which all live
+   in the same set).  As such, a global query that hits costs O(1)
+   regardless of how many in-preparation ancestors txn has.  SET_CNT
+   and WAY_CNT should be positive integer powers of 2. */
+
+#define FD_FUNK_REC_CACHE_SET_CNT (1024UL)
+#define FD_FUNK_REC_CACHE_WAY_CNT (4UL)
+
+#define FD_FUNK_REC_CACHE_ALIGN     (128UL)
+#define FD_FUNK_REC_CACHE_FOOTPRINT (FD_FUNK_REC_CACHE_SET_CNT*FD_FUNK_REC_CACHE_WAY_CNT*sizeof(fd_funk_rec_cache_entry_t))
+
 /* A fd_funk_rec_t describes a funk record. */
 
 struct fd_funk_rec {
@@ -56,8 +81,9 @@ struct fd_funk_rec {
   uint  val_sz;    /* Num bytes in record value, in [0,val_max] */
   uint  val_max;   /* Max byte  in record value, in [0,FD_FUNK_REC_VAL_MAX], 0 if erase flag set or val_gaddr is 0 */
   ulong val_gaddr; /* Wksp gaddr on record value if any, 0 if erase flag set or val_max is 0
-                      If non-zero, the region [val_gaddr,val_gaddr+val_max) will be a current fd_alloc allocation (such that it is
-                      has tag wksp_tag) and the owner of the region will be the record.  IMPORTANT! HAS NO GUARANTEED ALIGNMENT! */
+                      If non-zero, the region [val_gaddr,val_gaddr+val_max) will be a current fd_alloc allocation or, if the SLAB
+                      flag is set, a value slab slot (such that it is has tag wksp_tag) and the owner of the region will be the
+                      record.  IMPORTANT! HAS NO GUARANTEED ALIGNMENT! */
 
   /* Padding to FD_FUNK_REC_ALIGN here (TODO: consider using self index
      in the structures to accelerate indexing computations if padding
@@ -66,6 +92,30 @@ struct fd_funk_rec {
 
 typedef struct fd_funk_rec fd_funk_rec_t;
 
+/* A fd_funk_rec_cache_entry_t is an entry of the record cache. */
+
+struct fd_funk_rec_cache_entry {
+  fd_funk_rec_key_t key;      /* Key queried */
+  ulong             gen;      /* Cache generation when this entry was filled, entry is stale if not the funk's current one */
+  ulong             rec_idx;  /* Record map index of the query result, FD_FUNK_REC_IDX_NULL if there was no such record */
+  uint              txn_cidx; /* Compressed transaction map index of the queried transaction */
+};
+
+typedef struct fd_funk_rec_cache_entry fd_funk_rec_cache_entry_t;
+
+/* A fd_funk_pub_log_entry_t is an entry of the publish log (see
+   fd_funk_pub_log_append in fd_funk.h). */
+
+struct fd_funk_pub_log_entry {
+  fd_funk_rec_key_t key;   /* Key of a record of the last published transaction that was created, modified or erased */
+  ulong             seq;   /* Publish log sequence number of this entry */
+  ulong             flags; /* FD_FUNK_REC_FLAG_ERASE if the record was erased, 0 otherwise */
+};
+
+typedef struct fd_funk_pub_log_entry fd_funk_pub_log_entry_t;
+
+#define FD_FUNK_PUB_LOG_ALIGN (128UL)
+
 /* fd_funk_rec_map allows for indexing records by their (xid,key) pair.
    It is used to store all records of the last published transaction and
    the records being updated for a transaction that is in-preparation.
@@ -110,6 +160,25 @@ FD_FN_PURE static inline ulong fd_funk_rec_cnt( fd_funk_rec_t const * map ) { re
 
 FD_FN_PURE static inline int fd_funk_rec_is_full( fd_funk_rec_t const * map ) { return fd_funk_rec_map_is_full( map ); }
 
+/* Record operations can be done concurrently by multiple threads,
+   potentially distributed over multiple processes, on the same funk
+   provided they operate on disjoint keys and no transaction operations
+   (prepare, publish, cancel, merge, etc) are done concurrently with
+   them.  That is, multiple tiles can insert and write records into the
+   same unfrozen in-preparation transaction in parallel.
+   fd_funk_rec_{query,query_global,test,modify,insert,remove} and
+   fd_funk_rec_write_prepare serialize their updates of the record map,
+   the transaction record lists and the record cache with a funk wide
+   lock that is held for a short O(1) critical section.  The ancestor
+   walk of a global query that misses the record cache is done without
+   the lock (and redone under it in the rare case a record was removed
+   concurrently).  Record values are allocated, copied and resized
+   outside of that lock (using the caller's tile index as the fd_alloc
+   cgroup hint), so writes of large values to different records proceed
+   in parallel.
+   fd_funk_rec_query_const and fd_funk_rec_query_global_const do not
+   take the lock and are only safe concurrently with each other. */
+
 /* fd_funk_rec_query queries the in-preparation transaction pointed to
    by txn for the record whose key matches the key pointed to by key.
    If txn is NULL, the query will be done for the funk's last published
@@ -127,8 +196,8 @@ FD_FN_PURE static inline int fd_funk_rec_is_full( fd_funk_rec_t const * map ) {
    Assumes funk is a current local join (NULL returns NULL), txn is NULL
    or points to an in-preparation transaction in the caller's address
    space, key points to a record key in the caller's address space (NULL
-   returns NULL), and no concurrent operations on funk, txn or key.
-   funk retains no interest in key.  The funk retains ownership of any
+   returns NULL), and no concurrent operations on txn or key (see
+   above).  funk retains no interest in key.  The funk retains ownership of any
    returned record.  The record value metadata will be updated whenever
    the record value modified.
 
@@ -150,9 +219,13 @@ FD_FN_PURE static inline int fd_funk_rec_is_full( fd_funk_rec_t const * map ) {
    discard an erase for an unfrozen in-preparation transaction.)  In
    such cases, the record will have no value resources in use.
 
-   These are a reasonably fast O(in_prep_ancestor_cnt). */
+   These are a reasonably fast O(in_prep_ancestor_cnt) on the first
+   query of a (txn,key) pair and fast O(1) for repeated queries of it
+   (see FD_FUNK_REC_CACHE_SET_CNT above).  Only fd_funk_rec_query_global
+   fills the cache (it is fine to use fd_funk_rec_query_global_const
+   concurrently as it only reads it). */
 
-FD_FN_PURE fd_funk_rec_t const *
+fd_funk_rec_t const *
 fd_funk_rec_query( fd_funk_t *               funk,
                    fd_funk_txn_t const *     txn,
                    fd_funk_rec_key_t const * key );
@@ -162,7 +235,7 @@ fd_funk_rec_query_const( fd_funk_t *               funk,
                          fd_funk_txn_t const *     txn,
                          fd_funk_rec_key_t const * key );
 
-FD_FN_PURE fd_funk_rec_t const *
+fd_funk_rec_t const *
 fd_funk_rec_query_global( fd_funk_t *               funk,
                           fd_funk_txn_t const *     txn,
                           fd_funk_rec_key_t const * key );
@@ -194,7 +267,7 @@ fd_funk_rec_query_global_const( fd_funk_t *               funk,
 
    This is a reasonably fast O(1). */
 
-FD_FN_PURE int
+int
 fd_funk_rec_test( fd_funk_t *           funk,
                   fd_funk_rec_t const * rec );
 
@@ -283,13 +356,13 @@ fd_funk_txn_rec_tail( fd_funk_txn_t const * txn,        /* Assumes an in-prepara
 
    Assumes funk is a current local join (NULL returns NULL), rec is a
    pointer in the caller's address space to a fd_funk_rec_t (NULL
-   returns NULL), and no concurrent operations on funk or rec.  The funk
+   returns NULL), and no concurrent operations on rec.  The funk
    retains ownership of rec.  The record value metadata will be updated
    whenever the record value modified.
 
    This is a reasonably fast O(1). */
 
-FD_FN_PURE fd_funk_rec_t *
+fd_funk_rec_t *
 fd_funk_rec_modify( fd_funk_t *           funk,
                     fd_funk_rec_t const * rec );
 
@@ -334,8 +407,8 @@ fd_funk_rec_modify( fd_funk_t *           funk,
    Assumes funk is a current local join (NULL returns NULL), txn is NULL
    or points to an in-preparation transaction in the caller's address
    space, key points to a record key in the caller's address space (NULL
-   returns NULL), and no concurrent operations on funk, txn or key.
-   funk retains no interest in key or opt_err.  The funk retains
+   returns NULL), and no concurrent operations on txn or key (see
+   above).  funk retains no interest in key or opt_err.  The funk retains
    ownership of txn and any returned record.  The record value metadata
    will be updated whenever the record value modified.
 
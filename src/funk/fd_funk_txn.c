@@ -189,6 +189,8 @@ fd_funk_txn_cancel_childless( fd_funk_t *     funk,
   fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
   ulong           rec_max = funk->rec_max;
 
+  fd_funk_rec_lock( funk );
+
   ulong rec_idx = map[ txn_idx ].rec_head_idx;
   while( !fd_funk_rec_idx_is_null( rec_idx ) ) {
 
@@ -206,6 +208,8 @@ fd_funk_txn_cancel_childless( fd_funk_t *     funk,
     rec_idx = next_idx;
   }
 
+  fd_funk_rec_unlock( funk );
+
   /* Leave the family */
 
   ulong sibling_prev_idx = fd_funk_txn_idx( map[ txn_idx ].sibling_prev_cidx );
@@ -240,6 +244,8 @@ fd_funk_txn_cancel_childless( fd_funk_t *     funk,
   }
 
   fd_funk_txn_map_remove( map, fd_funk_txn_xid( &map[ txn_idx ] ) );
+
+  fd_funk_rec_cache_invalidate( funk ); /* txn_idx might get reused by a new transaction */
 }
 
 /* fd_funk_txn_cancel_family cancels a transaction and all its
@@ -598,6 +604,7 @@ fd_funk_txn_update( ulong *                   _dst_rec_head_idx, /* Pointer to t
       ulong val_sz    = (ulong)rec_map[ rec_idx ].val_sz;
       ulong val_max   = (ulong)rec_map[ rec_idx ].val_max;
       ulong val_gaddr = rec_map[ rec_idx ].val_gaddr;
+      ulong val_flags = rec_map[ rec_idx ].flags & FD_FUNK_REC_FLAG_SLAB;
 
       fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( &rec_map[ rec_idx ] ) );
 
@@ -629,6 +636,7 @@ fd_funk_txn_update( ulong *                   _dst_rec_head_idx, /* Pointer to t
       dst_rec->val_sz    = (uint)val_sz;
       dst_rec->val_max   = (uint)val_max;
       dst_rec->val_gaddr = val_gaddr;
+      dst_rec->flags     = (dst_rec->flags & ~FD_FUNK_REC_FLAG_SLAB) | val_flags;
 
     }
 
@@ -641,24 +649,260 @@ fd_funk_txn_update( ulong *                   _dst_rec_head_idx, /* Pointer to t
   txn_map[ txn_idx ].rec_tail_idx = FD_FUNK_REC_IDX_NULL;
 }
 
+/* fd_funk_txn_update_para is fd_funk_txn_update specialized for
+   applying the records of a child of funk to the last published
+   transaction with the help of tpool workers [t0,t1).  The caller is
+   worker t0.  Returns 1 if the updates were applied and 0 if txn_idx
+   has too few records to be worth it or the scratch space could not be
+   allocated (in which case nothing was changed and the caller should
+   use fd_funk_txn_update).
+
+   This runs in three passes.  The first (serial) collects the records
+   of txn_idx into an array with the same validation as
+   fd_funk_txn_update.  The second (parallel) looks up the published
+   version of each record and does the value work: the published value
+   superseded by an update or erase is freed and an update's value is
+   moved zero-copy into the published record.  As keys are unique
+   within a transaction, workers never touch the same published record.
+   The lookups use fd_funk_rec_map_query_const (a non-const map query
+   moves the found element to the head of its chain and thus writes the
+   map) such that nothing writes the record map during this pass and
+   the lookups can run concurrently.  The last pass (serial, in transaction order)
+   does the record map and record list surgery that can't be done
+   concurrently.  The result is identical to fd_funk_txn_update. */
+
+#define FD_FUNK_TXN_PUBLISH_PARA_MIN (4096UL)
+
+struct fd_funk_txn_update_para_ele {
+  ulong src_idx; /* Record of the transaction being published */
+  ulong dst_idx; /* Its published version, FD_FUNK_REC_IDX_NULL if none */
+};
+
+typedef struct fd_funk_txn_update_para_ele fd_funk_txn_update_para_ele_t;
+
+struct fd_funk_txn_update_para_args {
+  fd_funk_t *                     funk;
+  fd_wksp_t *                     wksp;
+  fd_funk_rec_t *                 rec_map;
+  fd_funk_txn_update_para_ele_t * ele;
+};
+
+typedef struct fd_funk_txn_update_para_args fd_funk_txn_update_para_args_t;
+
+static void
+fd_funk_txn_update_para_task( void * tpool,
+                              ulong  t0,     ulong t1,
+                              void * _args,
+                              void * reduce, ulong stride,
+                              ulong  l0,     ulong l1,
+                              ulong  m0,     ulong m1,
+                              ulong  n0,     ulong n1 ) {
+  (void)tpool; (void)t0; (void)t1; (void)reduce; (void)stride; (void)l0; (void)l1; (void)n1;
+
+  fd_funk_txn_update_para_args_t * args = (fd_funk_txn_update_para_args_t *)_args;
+
+  fd_funk_t *                     funk    = args->funk;
+  fd_wksp_t *                     wksp    = args->wksp;
+  fd_funk_rec_t *                 rec_map = args->rec_map;
+  fd_funk_txn_update_para_ele_t * ele     = args->ele;
+  fd_funk_txn_xid_t const *       root    = fd_funk_root( funk );
+  fd_alloc_t *                    alloc   = fd_alloc_join_cgroup_hint_set( fd_funk_alloc( funk, wksp ), n0 );
+
+  for( ulong i=m0; i<m1; i++ ) {
+    fd_funk_rec_t * rec = rec_map + ele[i].src_idx;
+
+    fd_funk_xid_key_pair_t dst_pair[1]; fd_funk_xid_key_pair_init( dst_pair, root, fd_funk_rec_key( rec ) );
+    /* Note: query_const as the non-const query moves the found element
+       to the head of its chain (i.e. writes the map) */
+    fd_funk_rec_t * dst_rec = (fd_funk_rec_t *)fd_funk_rec_map_query_const( rec_map, dst_pair, NULL );
+
+    if( FD_UNLIKELY( rec->flags & FD_FUNK_REC_FLAG_ERASE ) ) { /* Erase a published key */
+
+      /* As in fd_funk_txn_update, an erase published into the last
+         published transaction must have something to erase */
+
+      if( FD_UNLIKELY( !dst_rec ) ) FD_LOG_CRIT(( "memory corruption detected (bad ancestor)" ));
+      fd_funk_val_flush( dst_rec, alloc, wksp );
+
+    } else if( dst_rec ) { /* Update a published key */
+
+      fd_funk_val_flush( dst_rec, alloc, wksp );
+      dst_rec->val_sz    = rec->val_sz;
+      dst_rec->val_max   = rec->val_max;
+      dst_rec->val_gaddr = rec->val_gaddr;
+      dst_rec->flags    |= rec->flags & FD_FUNK_REC_FLAG_SLAB;
+      fd_funk_val_init( rec );
+
+    } /* else create a published key, done in the serial pass */
+
+    ele[i].dst_idx = dst_rec ? (ulong)(dst_rec - rec_map) : FD_FUNK_REC_IDX_NULL;
+  }
+}
+
+static int
+fd_funk_txn_update_para( fd_funk_t *     funk,
+                         ulong           txn_idx,
+                         fd_funk_txn_t * txn_map,
+                         fd_funk_rec_t * rec_map,
+                         fd_wksp_t *     wksp,
+                         fd_tpool_t *    tpool,
+                         ulong           t0,
+                         ulong           t1 ) {
+
+  ulong rec_max = funk->rec_max;
+
+  /* Count the records (validating the list) and bail if small */
+
+  ulong rec_cnt = 0UL;
+  ulong rec_idx = txn_map[ txn_idx ].rec_head_idx;
+  while( !fd_funk_rec_idx_is_null( rec_idx ) ) {
+    if( FD_UNLIKELY( (rec_idx>=rec_max) | (rec_cnt>=rec_max) ) ) FD_LOG_CRIT(( "memory corruption detected (bad idx or cycle)" ));
+    rec_cnt++;
+    rec_idx = rec_map[ rec_idx ].next_idx;
+  }
+
+  if( FD_LIKELY( rec_cnt<FD_FUNK_TXN_PUBLISH_PARA_MIN ) ) return 0;
+
+  fd_alloc_t * alloc = fd_funk_alloc( funk, wksp );
+
+  fd_funk_txn_update_para_ele_t * ele = (fd_funk_txn_update_para_ele_t *)
+    fd_alloc_malloc( alloc, alignof(fd_funk_txn_update_para_ele_t), rec_cnt*sizeof(fd_funk_txn_update_para_ele_t) );
+  if( FD_UNLIKELY( !ele ) ) return 0;
+
+  /* Collect.  As in fd_funk_txn_update, txn_cidx is repurposed as a
+     loop detector. */
+
+  rec_idx = txn_map[ txn_idx ].rec_head_idx;
+  for( ulong i=0UL; i<rec_cnt; i++ ) {
+    if( FD_UNLIKELY( fd_funk_txn_idx( rec_map[ rec_idx ].txn_cidx )!=txn_idx ) )
+      FD_LOG_CRIT(( "memory corruption detected (cycle or bad idx)" ));
+    rec_map[ rec_idx ].txn_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+    ele[i].src_idx = rec_idx;
+    rec_idx = rec_map[ rec_idx ].next_idx;
+  }
+
+  /* Look up and replace the published versions in parallel */
+
+  fd_funk_txn_update_para_args_t args[1];
+  args->funk    = funk;
+  args->wksp    = wksp;
+  args->rec_map = rec_map;
+  args->ele     = ele;
+
+  fd_tpool_exec_all_batch( tpool, t0, t1, fd_funk_txn_update_para_task, tpool, args, NULL, 0UL, 0UL, rec_cnt );
+
+  /* Update the record map and the published record list in
+     transaction order */
+
+  fd_funk_txn_xid_t const * root = fd_funk_root( funk );
+
+  for( ulong i=0UL; i<rec_cnt; i++ ) {
+    fd_funk_rec_t * rec     = rec_map + ele[i].src_idx;
+    ulong           dst_idx = ele[i].dst_idx;
+
+    if( FD_UNLIKELY( rec->flags & FD_FUNK_REC_FLAG_ERASE ) ) { /* Erase a published key (value already flushed) */
+
+      fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( rec ) );
+
+      fd_funk_rec_t * dst_rec  = rec_map + dst_idx;
+      ulong           prev_idx = dst_rec->prev_idx;
+      ulong           next_idx = dst_rec->next_idx;
+
+      if( FD_UNLIKELY( fd_funk_rec_idx_is_null( prev_idx ) ) ) funk->rec_head_idx         = next_idx;
+      else                                                     rec_map[ prev_idx ].next_idx = next_idx;
+
+      if( FD_UNLIKELY( fd_funk_rec_idx_is_null( next_idx ) ) ) funk->rec_tail_idx         = prev_idx;
+      else                                                     rec_map[ next_idx ].prev_idx = prev_idx;
+
+      fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( dst_rec ) );
+
+    } else if( FD_LIKELY( !fd_funk_rec_idx_is_null( dst_idx ) ) ) { /* Update a published key (value already moved) */
+
+      fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( rec ) );
+
+    } else { /* Create a published key */
+
+      ulong val_sz    = (ulong)rec->val_sz;
+      ulong val_max   = (ulong)rec->val_max;
+      ulong val_gaddr = rec->val_gaddr;
+      ulong val_flags = rec->flags & FD_FUNK_REC_FLAG_SLAB;
+
+      fd_funk_xid_key_pair_t dst_pair[1]; fd_funk_xid_key_pair_init( dst_pair, root, fd_funk_rec_key( rec ) );
+
+      fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( rec ) );
+
+      fd_funk_rec_t * dst_rec      = fd_funk_rec_map_insert( rec_map, dst_pair ); /* Guaranteed to succeed due to above remove */
+      ulong           dst_rec_idx  = (ulong)(dst_rec - rec_map);
+      ulong           dst_prev_idx = funk->rec_tail_idx;
+
+      dst_rec->prev_idx = dst_prev_idx;
+      dst_rec->next_idx = FD_FUNK_REC_IDX_NULL;
+      dst_rec->txn_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+      dst_rec->tag      = 0U;
+
+      if( fd_funk_rec_idx_is_null( dst_prev_idx ) ) funk->rec_head_idx               = dst_rec_idx;
+      else                                          rec_map[ dst_prev_idx ].next_idx = dst_rec_idx;
+
+      funk->rec_tail_idx = dst_rec_idx;
+
+      dst_rec->val_sz    = (uint)val_sz;
+      dst_rec->val_max   = (uint)val_max;
+      dst_rec->val_gaddr = val_gaddr;
+      dst_rec->flags     = (dst_rec->flags & ~FD_FUNK_REC_FLAG_SLAB) | val_flags;
+
+    }
+  }
+
+  txn_map[ txn_idx ].rec_head_idx = FD_FUNK_REC_IDX_NULL;
+  txn_map[ txn_idx ].rec_tail_idx = FD_FUNK_REC_IDX_NULL;
+
+  fd_alloc_free( alloc, ele );
+  return 1;
+}
+
 /* fd_funk_txn_publish_funk_child publishes a transaction that is known
    to be a child of funk.  Callers have already validated our input
    arguments.  Returns FD_FUNK_SUCCESS on success and an FD_FUNK_ERR_*
    code on failure.  (There are currently no failure cases but the
-   plumbing is there if value handling requires it at some point.) */
+   plumbing is there if value handling requires it at some point.)  If
+   tpool is non-NULL, large transactions are applied with the help of
+   tpool workers (t0,t1). */
 
 static int
 fd_funk_txn_publish_funk_child( fd_funk_t *     funk,
                                 fd_funk_txn_t * map,
                                 ulong           txn_max,
                                 ulong           tag,
-                                ulong           txn_idx ) {
+                                ulong           txn_idx,
+                                fd_tpool_t *    tpool,
+                                ulong           t0,
+                                ulong           t1 ) {
 
-  /* Apply the updates in txn to the last published transactions */
+  /* Apply the updates in txn to the last published transactions,
+     logging the keys they touch for fd_funk_persist */
 
-  fd_wksp_t * wksp = fd_funk_wksp( funk );
-  fd_funk_txn_update( &funk->rec_head_idx, &funk->rec_tail_idx, FD_FUNK_TXN_IDX_NULL, fd_funk_root( funk ),
-                      txn_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_alloc( funk, wksp ), wksp );
+  fd_funk_rec_cache_invalidate( funk );
+
+  fd_wksp_t *     wksp    = fd_funk_wksp( funk );
+  fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
+
+  fd_funk_rec_lock( funk );
+
+  if( FD_UNLIKELY( funk->pub_log_gaddr ) ) {
+    ulong rec_max = funk->rec_max;
+    ulong rec_idx = map[ txn_idx ].rec_head_idx;
+    for( ulong rem=rec_max; !fd_funk_rec_idx_is_null( rec_idx ); rem-- ) {
+      if( FD_UNLIKELY( (rec_idx>=rec_max) | (!rem) ) ) FD_LOG_CRIT(( "memory corruption detected (bad idx or cycle)" ));
+      fd_funk_pub_log_append( funk, wksp, fd_funk_rec_key( &rec_map[ rec_idx ] ), rec_map[ rec_idx ].flags & FD_FUNK_REC_FLAG_ERASE );
+      rec_idx = rec_map[ rec_idx ].next_idx;
+    }
+  }
+
+  if( FD_LIKELY( (!tpool) || (t1-t0)<2UL || !fd_funk_txn_update_para( funk, txn_idx, map, rec_map, wksp, tpool, t0, t1 ) ) )
+    fd_funk_txn_update( &funk->rec_head_idx, &funk->rec_tail_idx, FD_FUNK_TXN_IDX_NULL, fd_funk_root( funk ),
+                        txn_idx, funk->rec_max, map, rec_map, fd_funk_alloc( funk, wksp ), wksp );
+
+  fd_funk_rec_unlock( funk );
 
   /* Cancel all competing transaction histories */
 
@@ -694,10 +938,13 @@ fd_funk_txn_publish_funk_child( fd_funk_t *     funk,
   return FD_FUNK_SUCCESS;
 }
 
-ulong
-fd_funk_txn_publish( fd_funk_t *     funk,
-                     fd_funk_txn_t * txn,
-                     int             verbose ) {
+static ulong
+fd_funk_txn_publish_private( fd_funk_t *     funk,
+                             fd_funk_txn_t * txn,
+                             fd_tpool_t *    tpool,
+                             ulong           t0,
+                             ulong           t1,
+                             int             verbose ) {
 
   if( FD_UNLIKELY( !funk ) ) {
     if( FD_UNLIKELY( verbose ) ) FD_LOG_WARNING(( "NULL funk" ));
@@ -758,7 +1005,7 @@ fd_funk_txn_publish( fd_funk_t *     funk,
        each publish as txn and its sibligns we potentially visited in a
        previous iteration of this loop. */
 
-    if( FD_UNLIKELY( fd_funk_txn_publish_funk_child( funk, map, txn_max, funk->cycle_tag++, txn_idx ) ) ) break;
+    if( FD_UNLIKELY( fd_funk_txn_publish_funk_child( funk, map, txn_max, funk->cycle_tag++, txn_idx, tpool, t0, t1 ) ) ) break;
     publish_cnt++;
 
     txn_idx = publish_stack_idx;
@@ -769,6 +1016,27 @@ fd_funk_txn_publish( fd_funk_t *     funk,
   return publish_cnt;
 }
 
+ulong
+fd_funk_txn_publish( fd_funk_t *     funk,
+                     fd_funk_txn_t * txn,
+                     int             verbose ) {
+  return fd_funk_txn_publish_private( funk, txn, NULL, 0UL, 0UL, verbose );
+}
+
+ulong
+fd_funk_txn_publish_tpool( fd_funk_t *     funk,
+                           fd_funk_txn_t * txn,
+                           fd_tpool_t *    tpool,
+                           ulong           t0,
+                           ulong           t1,
+                           int             verbose ) {
+  if( FD_UNLIKELY( (!tpool) || (t0>=t1) || (t1>fd_tpool_worker_cnt( tpool )) ) ) {
+    if( FD_UNLIKELY( verbose ) ) FD_LOG_WARNING(( "NULL tpool or bad worker range" ));
+    return 0UL;
+  }
+  return fd_funk_txn_publish_private( funk, txn, tpool, t0, t1, verbose );
+}
+
 int
 fd_funk_txn_merge( fd_funk_t *     funk,
                    fd_funk_txn_t * txn,
@@ -808,8 +1076,12 @@ fd_funk_txn_merge( fd_funk_t *     funk,
 
   /* Merge records from child into parent */
 
+  fd_funk_rec_cache_invalidate( funk );
+
+  fd_funk_rec_lock( funk );
   fd_funk_txn_update( &map[ parent_idx ].rec_head_idx, &map[ parent_idx ].rec_tail_idx, parent_idx, &map[ parent_idx ].xid,
                       txn_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_alloc( funk, wksp ), wksp );
+  fd_funk_rec_unlock( funk );
 
   /* At this point, the record list for the child is empty.  Erase the
      child.  This is easy because we know it is an only child. */
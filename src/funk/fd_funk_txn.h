@@ -393,6 +393,27 @@ fd_funk_txn_publish( fd_funk_t *     funk,
                      fd_funk_txn_t * txn,
                      int             verbose );
 
+/* fd_funk_txn_publish_tpool is fd_funk_txn_publish but uses tpool
+   worker threads [t0,t1) to apply the record updates of large
+   transactions to the last published transaction.  The caller acts as
+   worker t0 and should not be one of the workers (t0,t1), which should
+   be idle on entry.  The superseded published values are looked up and
+   freed (and updated values moved into place) in parallel; the record
+   map and record list updates remain serial.  Transactions with few
+   records (or if the scratch space for the parallel pass cannot be
+   allocated from the funk's allocator) are applied serially.  The
+   result, including the order of published records, is identical to
+   fd_funk_txn_publish.  Additional reasons for failure include NULL
+   tpool and a bad worker range. */
+
+ulong
+fd_funk_txn_publish_tpool( fd_funk_t *     funk,
+                           fd_funk_txn_t * txn,
+                           fd_tpool_t *    tpool,
+                           ulong           t0,
+                           ulong           t1,
+                           int             verbose );
+
 /* fd_funk_txn_merge merges a child transaction into its parent. The
    intention is to support gathering small, short-term transactions
    into a large transaction. Strictly speaking, this API isn't
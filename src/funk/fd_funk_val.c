@@ -1,5 +1,65 @@
 #include "fd_funk.h"
 
+/* A fd_funk_val_slab_chunk_t is the header of a value slab chunk.  The
+   chunk is a FD_FUNK_VAL_SLAB_CHUNK_SZ aligned wksp allocation of
+   FD_FUNK_VAL_SLAB_CHUNK_SZ bytes, such that the header of the chunk
+   holding a slot can be found from the slot's gaddr alone.  slot_cnt
+   slots of the class's val_max bytes follow the header. */
+
+struct fd_funk_val_slab_chunk {
+  ulong class_gaddr; /* Wksp gaddr of the fd_funk_val_slab_class_t of this chunk */
+  ulong next_gaddr;  /* Wksp gaddr of the previously allocated chunk of the class, 0 if none */
+  ulong slot_cnt;    /* Number of slots in this chunk */
+};
+
+typedef struct fd_funk_val_slab_chunk fd_funk_val_slab_chunk_t;
+
+FD_STATIC_ASSERT( sizeof(fd_funk_val_slab_chunk_t)<=FD_FUNK_VAL_SLAB_CHUNK_HDR_SZ, layout );
+
+static inline void
+fd_funk_val_slab_lock( fd_funk_val_slab_class_t * cls ) {
+# if FD_HAS_ATOMIC
+  FD_COMPILER_MFENCE();
+  for(;;) {
+    if( FD_LIKELY( !FD_VOLATILE_CONST( cls->lock ) && !FD_ATOMIC_CAS( &cls->lock, 0UL, 1UL ) ) ) break;
+    FD_SPIN_PAUSE();
+  }
+  FD_COMPILER_MFENCE();
+# else
+  (void)cls;
+# endif
+}
+
+static inline void
+fd_funk_val_slab_unlock( fd_funk_val_slab_class_t * cls ) {
+# if FD_HAS_ATOMIC
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cls->lock ) = 0UL;
+  FD_COMPILER_MFENCE();
+# else
+  (void)cls;
+# endif
+}
+
+/* fd_funk_val_free frees the value allocation val of rec (NULL is a
+   no-op), returning it to its slab or to alloc as appropriate, and
+   clears the record's slab flag.  Assumes the caller has already
+   switched rec's value metadata to something else. */
+
+static inline void
+fd_funk_val_free( fd_funk_rec_t * rec,
+                  uchar *         val,
+                  fd_alloc_t *    alloc,
+                  fd_wksp_t *     wksp ) {
+  if( !val ) return;
+  if( rec->flags & FD_FUNK_REC_FLAG_SLAB ) {
+    rec->flags &= ~FD_FUNK_REC_FLAG_SLAB;
+    fd_funk_val_slab_release( wksp, fd_wksp_gaddr_fast( wksp, val ) );
+  } else {
+    fd_alloc_free( alloc, val );
+  }
+}
+
 fd_funk_rec_t *
 fd_funk_val_copy( fd_funk_rec_t * rec,
                   void const *    data,
@@ -42,6 +102,15 @@ fd_funk_val_copy( fd_funk_rec_t * rec,
 
     fd_funk_val_flush( rec, alloc, wksp );
 
+  } else if( (!!(rec->flags & FD_FUNK_REC_FLAG_SLAB)) & (sz_est<=val_max) ) {
+
+    /* The value is in a slab slot that can accommodate sz_est.  Do the
+       copy in place and clear out trailing padding. */
+
+    if( FD_LIKELY( sz ) ) fd_memcpy( val, data, sz );
+    fd_memset( val + sz, 0, val_max - sz );
+    rec->val_sz = (uint)sz;
+
   } else {
 
     /* User requested to allocate at least sz_est for value.  Allocate
@@ -67,7 +136,7 @@ fd_funk_val_copy( fd_funk_rec_t * rec,
       rec->val_max   = (uint)fd_ulong_min( new_val_max, FD_FUNK_REC_VAL_MAX );
       rec->val_gaddr = fd_wksp_gaddr_fast( wksp, new_val );
 
-      if( val ) fd_alloc_free( alloc, val );
+      fd_funk_val_free( rec, val, alloc, wksp );
       val = new_val;
 
     }
@@ -149,7 +218,7 @@ fd_funk_val_append( fd_funk_rec_t * rec,
 
     if( val_sz ) fd_memcpy( new_val, val, val_sz ); /* Copy the existing val */
     fd_memset( new_val + val_sz, 0, new_val_max - val_sz ); /* Clear out trailing padding to be on the safe side */
-    fd_alloc_free( alloc, val ); /* Free the old val */
+    fd_funk_val_free( rec, val, alloc, wksp ); /* Free the old val */
 
     rec->val_max   = (uint)fd_ulong_min( new_val_max, FD_FUNK_REC_VAL_MAX );
     rec->val_gaddr = fd_wksp_gaddr_fast( wksp, new_val );
@@ -192,6 +261,15 @@ fd_funk_val_truncate( fd_funk_rec_t * rec,
 
     fd_funk_val_flush( rec, alloc, wksp );
 
+  } else if( (!!(rec->flags & FD_FUNK_REC_FLAG_SLAB)) & (new_val_sz<=(ulong)rec->val_max) ) {
+
+    /* The value is in a slab slot that can hold new_val_sz bytes.
+       Resize in place.  Trailing padding was cleared out previously
+       so we only need to clear out the bytes dropped by a shrink. */
+
+    if( new_val_sz < val_sz ) fd_memset( (uchar *)fd_wksp_laddr_fast( wksp, rec->val_gaddr ) + new_val_sz, 0, val_sz - new_val_sz );
+    rec->val_sz = (uint)new_val_sz;
+
   } else if( FD_LIKELY( new_val_sz > val_sz ) ) {
 
     /* User requested to increase the value size.  We presume they are
@@ -213,7 +291,7 @@ fd_funk_val_truncate( fd_funk_rec_t * rec,
 
     if( val_sz ) fd_memcpy( new_val, val, val_sz ); /* Copy the existing value */
     fd_memset( new_val + val_sz, 0, new_val_max - val_sz ); /* Clear out trailing padding to be on the safe side */
-    if( val ) fd_alloc_free( alloc, val ); /* Free the old value (if any) */
+    fd_funk_val_free( rec, val, alloc, wksp ); /* Free the old value (if any) */
 
     rec->val_sz    = (uint)new_val_sz;
     rec->val_max   = (uint)fd_ulong_min( new_val_max, FD_FUNK_REC_VAL_MAX );
@@ -246,7 +324,7 @@ fd_funk_val_truncate( fd_funk_rec_t * rec,
 
       fd_memcpy( new_val, val, new_val_sz ); /* Copy the (truncated) existing value */
       fd_memset( new_val + new_val_sz, 0, new_val_max - new_val_sz ); /* Clear out the trailing padding to be on the safe side */
-      if( val ) fd_alloc_free( alloc, val ); /* Free the old value (if any) */
+      fd_funk_val_free( rec, val, alloc, wksp ); /* Free the old value (if any) */
 
       rec->val_sz    = (uint)new_val_sz;
       rec->val_max   = (uint)fd_ulong_min( new_val_max, FD_FUNK_REC_VAL_MAX );
@@ -260,6 +338,158 @@ fd_funk_val_truncate( fd_funk_rec_t * rec,
   return rec;
 }
 
+int
+fd_funk_val_slab_config( fd_funk_t *   funk,
+                         ulong const * val_max,
+                         ulong         class_cnt ) {
+
+  if( FD_UNLIKELY( !funk ) ) {
+    FD_LOG_WARNING(( "NULL funk" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( (class_cnt>FD_FUNK_VAL_SLAB_CLASS_MAX) || (class_cnt && !val_max) ) ) {
+    FD_LOG_WARNING(( "bad class_cnt" ));
+    return FD_FUNK_ERR_INVAL;
+  }
+
+  for( ulong class_idx=0UL; class_idx<class_cnt; class_idx++ ) {
+    ulong sz = val_max[ class_idx ];
+    if( FD_UNLIKELY( (!fd_ulong_is_aligned( sz, 8UL )) | (sz<8UL) | (sz>FD_FUNK_VAL_SLAB_VAL_MAX) |
+                     ((!!class_idx) && (sz<=val_max[ class_idx-1UL ])) ) ) {
+      FD_LOG_WARNING(( "bad val_max[%lu]", class_idx ));
+      return FD_FUNK_ERR_INVAL;
+    }
+  }
+
+  fd_wksp_t *          wksp = fd_funk_wksp( funk );
+  fd_funk_val_slab_t * slab = fd_funk_val_slab( funk, wksp );
+
+  if( slab ) {
+    for( ulong class_idx=0UL; class_idx<slab->class_cnt; class_idx++ ) {
+      if( FD_UNLIKELY( slab->class[ class_idx ].used_cnt ) ) {
+        FD_LOG_WARNING(( "slab values in use" ));
+        return FD_FUNK_ERR_INVAL;
+      }
+    }
+  }
+
+  fd_funk_val_slab_t * new_slab = NULL;
+  if( class_cnt ) {
+    new_slab = (fd_funk_val_slab_t *)
+      fd_wksp_alloc_laddr( wksp, alignof(fd_funk_val_slab_t), sizeof(fd_funk_val_slab_t), funk->wksp_tag );
+    if( FD_UNLIKELY( !new_slab ) ) {
+      FD_LOG_WARNING(( "slab class table too large for workspace" ));
+      return FD_FUNK_ERR_MEM;
+    }
+    fd_memset( new_slab, 0, sizeof(fd_funk_val_slab_t) );
+    new_slab->class_cnt = class_cnt;
+    for( ulong class_idx=0UL; class_idx<class_cnt; class_idx++ ) new_slab->class[ class_idx ].val_max = val_max[ class_idx ];
+  }
+
+  fd_funk_val_slab_fini( funk );
+  funk->slab_gaddr = new_slab ? fd_wksp_gaddr_fast( wksp, new_slab ) : 0UL;
+
+  return FD_FUNK_SUCCESS;
+}
+
+void *
+fd_funk_val_slab_acquire( fd_funk_t * funk,
+                          ulong       sz,
+                          ulong *     _val_max ) {
+  fd_wksp_t *          wksp = fd_funk_wksp( funk );
+  fd_funk_val_slab_t * slab = fd_funk_val_slab( funk, wksp );
+  if( FD_LIKELY( (!slab) | (!sz) ) ) return NULL;
+
+  /* Find the smallest class that fits (there are only a handful) */
+
+  ulong class_cnt = slab->class_cnt;
+  ulong class_idx = 0UL;
+  while( (class_idx<class_cnt) && (slab->class[ class_idx ].val_max<sz) ) class_idx++;
+  if( FD_UNLIKELY( class_idx==class_cnt ) ) return NULL;
+
+  fd_funk_val_slab_class_t * cls     = slab->class + class_idx;
+  ulong                      val_max = cls->val_max;
+
+  fd_funk_val_slab_lock( cls );
+
+  ulong val_gaddr = cls->free_gaddr;
+
+  if( FD_UNLIKELY( !val_gaddr ) ) {
+
+    /* The class is out of slots.  Carve a new chunk into slots and push
+       them onto the free stack such that they are popped in address
+       order. */
+
+    ulong chunk_gaddr = fd_wksp_alloc( wksp, FD_FUNK_VAL_SLAB_CHUNK_SZ, FD_FUNK_VAL_SLAB_CHUNK_SZ, funk->wksp_tag );
+    if( FD_UNLIKELY( !chunk_gaddr ) ) {
+      fd_funk_val_slab_unlock( cls );
+      return NULL;
+    }
+
+    ulong slot_cnt = (FD_FUNK_VAL_SLAB_CHUNK_SZ - FD_FUNK_VAL_SLAB_CHUNK_HDR_SZ) / val_max;
+
+    fd_funk_val_slab_chunk_t * chunk = (fd_funk_val_slab_chunk_t *)fd_wksp_laddr_fast( wksp, chunk_gaddr );
+    chunk->class_gaddr = fd_wksp_gaddr_fast( wksp, cls );
+    chunk->next_gaddr  = cls->chunk_gaddr;
+    chunk->slot_cnt    = slot_cnt;
+
+    ulong slot_gaddr = chunk_gaddr + FD_FUNK_VAL_SLAB_CHUNK_HDR_SZ + slot_cnt*val_max;
+    for( ulong slot_idx=0UL; slot_idx<slot_cnt; slot_idx++ ) {
+      slot_gaddr -= val_max;
+      *(ulong *)fd_wksp_laddr_fast( wksp, slot_gaddr ) = val_gaddr;
+      val_gaddr = slot_gaddr;
+    }
+
+    cls->chunk_gaddr = chunk_gaddr;
+    cls->chunk_cnt++;
+    cls->slot_cnt += slot_cnt;
+
+  }
+
+  void * val = fd_wksp_laddr_fast( wksp, val_gaddr );
+  cls->free_gaddr = *(ulong const *)val;
+  cls->used_cnt++;
+
+  fd_funk_val_slab_unlock( cls );
+
+  *_val_max = val_max;
+  return val;
+}
+
+void
+fd_funk_val_slab_release( fd_wksp_t * wksp,
+                          ulong       val_gaddr ) {
+  fd_funk_val_slab_chunk_t const * chunk = (fd_funk_val_slab_chunk_t const *)
+    fd_wksp_laddr_fast( wksp, fd_ulong_align_dn( val_gaddr, FD_FUNK_VAL_SLAB_CHUNK_SZ ) );
+  fd_funk_val_slab_class_t * cls = (fd_funk_val_slab_class_t *)fd_wksp_laddr_fast( wksp, chunk->class_gaddr );
+
+  fd_funk_val_slab_lock( cls );
+  *(ulong *)fd_wksp_laddr_fast( wksp, val_gaddr ) = cls->free_gaddr;
+  cls->free_gaddr = val_gaddr;
+  cls->used_cnt--;
+  fd_funk_val_slab_unlock( cls );
+}
+
+void
+fd_funk_val_slab_fini( fd_funk_t * funk ) {
+  fd_wksp_t *          wksp = fd_funk_wksp( funk );
+  fd_funk_val_slab_t * slab = fd_funk_val_slab( funk, wksp );
+  if( !slab ) return;
+
+  for( ulong class_idx=0UL; class_idx<slab->class_cnt; class_idx++ ) {
+    ulong chunk_gaddr = slab->class[ class_idx ].chunk_gaddr;
+    while( chunk_gaddr ) {
+      ulong next_gaddr = ((fd_funk_val_slab_chunk_t const *)fd_wksp_laddr_fast( wksp, chunk_gaddr ))->next_gaddr;
+      fd_wksp_free( wksp, chunk_gaddr );
+      chunk_gaddr = next_gaddr;
+    }
+  }
+
+  fd_wksp_free_laddr( slab );
+  funk->slab_gaddr = 0UL;
+}
+
 int
 fd_funk_val_verify( fd_funk_t * funk ) {
   fd_wksp_t *     wksp     = fd_funk_wksp( funk );          /* Previously verified */
@@ -272,6 +502,42 @@ fd_funk_val_verify( fd_funk_t * funk ) {
     if( FD_UNLIKELY( !(c) ) ) { FD_LOG_WARNING(( "FAIL: %s", #c )); return FD_FUNK_ERR_INVAL; } \
   } while(0)
 
+  /* Verify the slab classes and their chunk lists */
+
+  fd_funk_val_slab_t * slab      = fd_funk_val_slab( funk, wksp );
+  ulong                class_cnt = slab ? slab->class_cnt : 0UL;
+  ulong                used_cnt[ FD_FUNK_VAL_SLAB_CLASS_MAX ];
+
+  if( slab ) {
+    TEST( (1UL<=class_cnt) & (class_cnt<=FD_FUNK_VAL_SLAB_CLASS_MAX) );
+    for( ulong class_idx=0UL; class_idx<class_cnt; class_idx++ ) {
+      fd_funk_val_slab_class_t const * cls = slab->class + class_idx;
+      ulong val_max = cls->val_max;
+      TEST( fd_ulong_is_aligned( val_max, 8UL ) & (8UL<=val_max) & (val_max<=FD_FUNK_VAL_SLAB_VAL_MAX) );
+      if( class_idx ) TEST( val_max>slab->class[ class_idx-1UL ].val_max );
+      TEST( cls->used_cnt<=cls->slot_cnt );
+
+      ulong chunk_cnt   = 0UL;
+      ulong slot_cnt    = 0UL;
+      ulong chunk_gaddr = cls->chunk_gaddr;
+      while( chunk_gaddr ) {
+        TEST( chunk_cnt<cls->chunk_cnt ); /* Detects cycles too */
+        TEST( fd_ulong_is_aligned( chunk_gaddr, FD_FUNK_VAL_SLAB_CHUNK_SZ ) );
+        TEST( fd_wksp_tag( wksp, chunk_gaddr )==wksp_tag );
+        fd_funk_val_slab_chunk_t const * chunk = (fd_funk_val_slab_chunk_t const *)fd_wksp_laddr_fast( wksp, chunk_gaddr );
+        TEST( chunk->class_gaddr==fd_wksp_gaddr_fast( wksp, cls ) );
+        TEST( chunk->slot_cnt==(FD_FUNK_VAL_SLAB_CHUNK_SZ-FD_FUNK_VAL_SLAB_CHUNK_HDR_SZ)/val_max );
+        slot_cnt   += chunk->slot_cnt;
+        chunk_cnt++;
+        chunk_gaddr = chunk->next_gaddr;
+      }
+      TEST( chunk_cnt==cls->chunk_cnt );
+      TEST( slot_cnt ==cls->slot_cnt  );
+
+      used_cnt[ class_idx ] = 0UL;
+    }
+  }
+
   /* Iterate over all records in use */
 
   for( fd_funk_rec_map_iter_t iter = fd_funk_rec_map_iter_init( rec_map );
@@ -289,7 +555,21 @@ fd_funk_val_verify( fd_funk_t * funk ) {
 
     TEST( val_sz<=val_max );
 
-    if( rec->flags & FD_FUNK_REC_FLAG_ERASE ) {
+    if( rec->flags & FD_FUNK_REC_FLAG_SLAB ) {
+      TEST( !(rec->flags & FD_FUNK_REC_FLAG_ERASE) );
+      TEST( slab );
+      TEST( val_gaddr );
+      TEST( fd_wksp_tag( wksp, val_gaddr )==wksp_tag );
+      ulong chunk_gaddr = fd_ulong_align_dn( val_gaddr, FD_FUNK_VAL_SLAB_CHUNK_SZ );
+      fd_funk_val_slab_chunk_t const * chunk = (fd_funk_val_slab_chunk_t const *)fd_wksp_laddr_fast( wksp, chunk_gaddr );
+      ulong class_idx = (ulong)( (fd_funk_val_slab_class_t const *)fd_wksp_laddr_fast( wksp, chunk->class_gaddr ) - slab->class );
+      TEST( class_idx<class_cnt );
+      TEST( chunk->class_gaddr==fd_wksp_gaddr_fast( wksp, slab->class + class_idx ) );
+      TEST( val_max==slab->class[ class_idx ].val_max );
+      ulong slot_off = val_gaddr - chunk_gaddr - FD_FUNK_VAL_SLAB_CHUNK_HDR_SZ;
+      TEST( (slot_off<chunk->slot_cnt*val_max) && !(slot_off % val_max) );
+      used_cnt[ class_idx ]++;
+    } else if( rec->flags & FD_FUNK_REC_FLAG_ERASE ) {
       TEST( !val_max   );
       TEST( !val_gaddr );
     } else {
@@ -302,6 +582,8 @@ fd_funk_val_verify( fd_funk_t * funk ) {
     }
   }
 
+  for( ulong class_idx=0UL; class_idx<class_cnt; class_idx++ ) TEST( used_cnt[ class_idx ]==slab->class[ class_idx ].used_cnt );
+
 # undef TEST
 
   return FD_FUNK_SUCCESS;
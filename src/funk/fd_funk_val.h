@@ -11,6 +11,56 @@
 
 #define FD_FUNK_REC_VAL_MAX (10UL<<20) /* 10 MiB */
 
+/* Small record values (e.g. the 165 byte token accounts that make up
+   most of Solana's state) can optionally be held in value slabs instead
+   of individual fd_alloc allocations.  A funk can be configured with up
+   to FD_FUNK_VAL_SLAB_CLASS_MAX size classes (see
+   fd_funk_val_slab_config).  Each class has a slot size (its val_max)
+   and a free stack of slots carved out of FD_FUNK_VAL_SLAB_CHUNK_SZ
+   byte chunks allocated from the funk's wksp (tagged with the funk's
+   wksp_tag) as needed.  A chunk starts with a FD_FUNK_VAL_SLAB_CHUNK_HDR_SZ
+   byte header that locates its class, such that a slot can be freed
+   given only its gaddr.  Slots have no per value header and are packed
+   back to back so a slab value costs exactly its class's val_max bytes
+   of wksp (plus its share of the chunk header).  Chunks are kept until
+   the slabs are reconfigured or the funk is deleted.
+
+   Records created by fd_funk_rec_write_prepare get a slab slot when the
+   value fits in a class.  Thereafter, copy, append and truncate operate
+   on the slot in place as long as the value fits in it and move the
+   value to fd_alloc when it does not.  Values larger than the largest
+   class always use fd_alloc. */
+
+#define FD_FUNK_VAL_SLAB_CLASS_MAX   (16UL)
+#define FD_FUNK_VAL_SLAB_VAL_MAX     (4096UL)
+#define FD_FUNK_VAL_SLAB_CHUNK_SZ    (65536UL)
+#define FD_FUNK_VAL_SLAB_CHUNK_HDR_SZ (64UL)
+
+/* A fd_funk_val_slab_class_t describes a value slab size class.  The
+   details are exposed here to facilitate diagnostics. */
+
+struct __attribute__((aligned(64))) fd_funk_val_slab_class {
+  ulong val_max;     /* Slot size in bytes, multiple of 8 in [8,FD_FUNK_VAL_SLAB_VAL_MAX] */
+  ulong lock;        /* 0 when unlocked, 1 when locked, serializes the below between threads */
+  ulong free_gaddr;  /* Wksp gaddr of the first free slot, 0 if none (a free slot holds the gaddr of the next) */
+  ulong chunk_gaddr; /* Wksp gaddr of the most recently allocated chunk, 0 if none */
+  ulong chunk_cnt;   /* Number of chunks allocated for this class */
+  ulong slot_cnt;    /* Number of slots in those chunks */
+  ulong used_cnt;    /* Number of slots currently holding a record value, in [0,slot_cnt] */
+};
+
+typedef struct fd_funk_val_slab_class fd_funk_val_slab_class_t;
+
+/* A fd_funk_val_slab_t is the table of size classes of a funk.  Classes
+   are ordered by increasing val_max. */
+
+struct __attribute__((aligned(64))) fd_funk_val_slab {
+  ulong                    class_cnt; /* In [1,FD_FUNK_VAL_SLAB_CLASS_MAX] */
+  fd_funk_val_slab_class_t class[ FD_FUNK_VAL_SLAB_CLASS_MAX ];
+};
+
+typedef struct fd_funk_val_slab fd_funk_val_slab_t;
+
 FD_PROTOTYPES_BEGIN
 
 /* Accessors */
@@ -234,6 +284,53 @@ fd_funk_val_truncate( fd_funk_rec_t * rec,        /* Assumed in caller's address
                       fd_wksp_t *     wksp,       /* ==fd_funk_wksp( funk ) where funk is current local join */
                       int *           opt_err );  /* If non-NULL, *opt_err returns operation error code */
 
+/* Value slabs */
+
+/* fd_funk_val_slab_config configures the value slabs of funk to have
+   class_cnt size classes with slot sizes val_max[0],...,val_max[
+   class_cnt-1].  Slot sizes should be strictly increasing multiples of
+   8 in [8,FD_FUNK_VAL_SLAB_VAL_MAX] and class_cnt should be in
+   [0,FD_FUNK_VAL_SLAB_CLASS_MAX].  class_cnt 0 disables the value
+   slabs (the default).  Any existing slabs are discarded, so no record
+   value can be held in a slab at the time of the call (e.g. configure
+   right after fd_funk_new or restoring from a fd_funk_persist file).
+   Returns FD_FUNK_SUCCESS on success and a FD_FUNK_ERR_* code on
+   failure (logs details).  Reasons for failure include bad arguments,
+   slab values in use (ERR_INVAL) and the wksp is too small for the
+   class table (ERR_MEM).  On failure, the slabs are unchanged.  Assumes
+   no concurrent operations on funk. */
+
+int
+fd_funk_val_slab_config( fd_funk_t *   funk,
+                         ulong const * val_max,
+                         ulong         class_cnt );
+
+/* fd_funk_val_slab_acquire returns a pointer in the caller's address
+   space to a free slot of the smallest slab class of funk that can hold
+   sz bytes.  On success, *_val_max holds the slot size.  Returns NULL
+   if funk has no slabs, sz is zero or larger than the largest class,
+   or the wksp is out of memory for a new chunk.  The contents of the
+   slot are arbitrary.  fd_funk_val_slab_release returns the slot at
+   val_gaddr (as previously returned by acquire) to its class.  These
+   are safe to use concurrently and are meant for internal use. */
+
+void *
+fd_funk_val_slab_acquire( fd_funk_t * funk,
+                          ulong       sz,
+                          ulong *     _val_max );
+
+void
+fd_funk_val_slab_release( fd_wksp_t * wksp,
+                          ulong       val_gaddr );
+
+/* fd_funk_val_slab_fini frees all slab resources of funk.  Assumes no
+   record values are held in the slabs (or the records are being
+   discarded too) and no concurrent operations on funk.  Meant for
+   internal use. */
+
+void
+fd_funk_val_slab_fini( fd_funk_t * funk );
+
 /* Misc */
 
 /* fd_funk_val_init sets a record with uninitialized value metadata to
@@ -241,6 +338,7 @@ fd_funk_val_truncate( fd_funk_rec_t * rec,        /* Assumed in caller's address
 
 static inline fd_funk_rec_t *             /* Returns rec */
 fd_funk_val_init( fd_funk_rec_t * rec ) { /* Assumed record in caller's address space with uninitialized value metadata */
+  rec->flags    &= ~FD_FUNK_REC_FLAG_SLAB;
   rec->val_sz    = 0U;
   rec->val_max   = 0U;
   rec->val_gaddr = 0UL;
@@ -255,8 +353,12 @@ fd_funk_val_flush( fd_funk_rec_t * rec,     /* Assumed live funk record in calle
                    fd_alloc_t *    alloc,   /* ==fd_funk_alloc( funk, wksp ) */
                    fd_wksp_t *     wksp ) { /* ==fd_funk_wksp( funk ) where funk is a current local join */
   ulong val_gaddr = rec->val_gaddr;
+  ulong slab      = rec->flags & FD_FUNK_REC_FLAG_SLAB;
   fd_funk_val_init( rec );
-  if( val_gaddr ) fd_alloc_free( alloc, fd_wksp_laddr_fast( wksp, val_gaddr ) );
+  if( val_gaddr ) {
+    if( slab ) fd_funk_val_slab_release( wksp, val_gaddr );
+    else       fd_alloc_free( alloc, fd_wksp_laddr_fast( wksp, val_gaddr ) );
+  }
   return rec;
 }
 
@@ -272,6 +374,7 @@ fd_funk_val_verify( fd_funk_t * funk );
 FD_PROTOTYPES_END
 
 /* TODO: Retune fd_alloc and fd_wksp for Solana record size optimized
-   size classes and transition point to fd_wksp backing. */
+   size classes and transition point to fd_wksp backing (the value
+   slabs above cover the smallest and most common sizes). */
 
 #endif /* HEADER_fd_src_funk_fd_funk_val_h */
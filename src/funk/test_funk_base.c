@@ -8,6 +8,7 @@ FD_STATIC_ASSERT( FD_FUNK_ERR_FROZEN            ==-4,
 FD_STATIC_ASSERT( FD_FUNK_ERR_TXN               ==-5,                              unit_test );
 FD_STATIC_ASSERT( FD_FUNK_ERR_REC               ==-6,                              unit_test );
 FD_STATIC_ASSERT( FD_FUNK_ERR_MEM               ==-7,                              unit_test );
+FD_STATIC_ASSERT( FD_FUNK_ERR_IO                ==-8,                              unit_test );
 
 FD_STATIC_ASSERT( FD_FUNK_REC_KEY_ALIGN         ==32UL,                            unit_test );
 FD_STATIC_ASSERT( FD_FUNK_REC_KEY_FOOTPRINT     ==64UL,                            unit_test );
@@ -76,6 +77,7 @@ main( int     argc,
   FD_TEST( !strcmp( fd_funk_strerror( FD_FUNK_ERR_TXN    ), "txn"     ) );
   FD_TEST( !strcmp( fd_funk_strerror( FD_FUNK_ERR_REC    ), "rec"     ) );
   FD_TEST( !strcmp( fd_funk_strerror( FD_FUNK_ERR_MEM    ), "mem"     ) );
+  FD_TEST( !strcmp( fd_funk_strerror( FD_FUNK_ERR_IO     ), "io"      ) );
   FD_TEST( !strcmp( fd_funk_strerror( 1                  ), "unknown" ) );
 
   for( ulong rem=1000000UL; rem; rem-- ) {
@@ -0,0 +1,381 @@
+#define _GNU_SOURCE /* O_DIRECT */
+#include "fd_funk_persist.h"
+
+#if FD_HAS_HOSTED
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* This tests persisting the last published transaction of a funk and
+   restoring it.  The funk is populated with rec_cnt records, a
+   persister is attached and a number of rounds of transactions that
+   update, erase and insert records are published, with a poll after
+   each publish.  A round with more updates than the publish log holds
+   forces a checkpoint.  The file is then restored into a second funk
+   whose records are compared against the first, including after a torn
+   block or the start of a checkpoint that was not completed was
+   appended to the file.
+
+   The default scale is small.  To measure restore time and write
+   amplification on a production sized state, run with e.g.
+   --rec-cnt 100000000 --upd-cnt 1000000 --page-sz gigantic --page-cnt
+   (enough for two copies of the state). */
+
+static fd_funk_rec_key_t *
+test_key( fd_funk_rec_key_t * key,
+          ulong               idx ) {
+  fd_memset( key, 0, sizeof(fd_funk_rec_key_t) );
+  key->ul[0] = idx;
+  key->ul[1] = fd_ulong_hash( idx );
+  return key;
+}
+
+/* test_write sets the value of key idx in txn to val_sz bytes derived
+   from idx and ver.  Keys erased in txn are left alone (funk does not
+   support writing to a record marked for erase). */
+
+static void
+test_write( fd_funk_t *     funk,
+            fd_funk_txn_t * txn,
+            ulong           idx,
+            ulong           ver,
+            ulong           val_sz ) {
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+  fd_funk_rec_key_t key[1];
+  fd_funk_rec_t const * erec = fd_funk_rec_query( funk, txn, test_key( key, idx ) );
+  if( erec && (erec->flags & FD_FUNK_REC_FLAG_ERASE) ) return;
+  int err;
+  fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key, val_sz, &err );
+  if( FD_UNLIKELY( !rec ) ) FD_LOG_ERR(( "fd_funk_rec_write_prepare failed (%i-%s)", err, fd_funk_strerror( err ) ));
+  if( fd_funk_val_sz( rec )>val_sz ) {
+    rec = fd_funk_val_truncate( rec, val_sz, fd_funk_alloc( funk, wksp ), wksp, &err );
+    if( FD_UNLIKELY( !rec ) ) FD_LOG_ERR(( "fd_funk_val_truncate failed (%i-%s)", err, fd_funk_strerror( err ) ));
+  }
+  fd_memset( fd_funk_val( rec, wksp ), (int)(uchar)(idx ^ ver), val_sz );
+}
+
+/* test_poll polls persist until everything logged is written */
+
+static void
+test_poll( fd_funk_persist_t * persist ) {
+  while( fd_funk_persist_pending( persist ) ) FD_TEST( !fd_funk_persist_poll( persist, NULL ) );
+}
+
+/* test_cmp checks the last published transactions of funk and ref have
+   the same records */
+
+static void
+test_cmp( fd_funk_t * funk,
+          fd_funk_t * ref ) {
+  fd_wksp_t *     wksp        = fd_funk_wksp( funk );
+  fd_wksp_t *     ref_wksp    = fd_funk_wksp( ref );
+  fd_funk_rec_t * ref_rec_map = fd_funk_rec_map( ref, ref_wksp );
+
+  ulong cnt = 0UL;
+  for( fd_funk_rec_map_iter_t iter = fd_funk_rec_map_iter_init( ref_rec_map );
+       !fd_funk_rec_map_iter_done( ref_rec_map, iter );
+       iter = fd_funk_rec_map_iter_next( ref_rec_map, iter ) ) {
+    fd_funk_rec_t const * ref_rec = fd_funk_rec_map_iter_ele_const( ref_rec_map, iter );
+    if( !fd_funk_txn_idx_is_null( fd_funk_txn_idx( ref_rec->txn_cidx ) ) ) continue;
+    fd_funk_rec_t const * rec = fd_funk_rec_query( funk, NULL, fd_funk_rec_key( ref_rec ) );
+    FD_TEST( rec );
+    FD_TEST( fd_funk_val_sz( rec )==fd_funk_val_sz( ref_rec ) );
+    FD_TEST( !memcmp( fd_funk_val_const( rec, wksp ), fd_funk_val_const( ref_rec, ref_wksp ), fd_funk_val_sz( rec ) ) );
+    cnt++;
+  }
+  FD_TEST( fd_funk_rec_cnt( fd_funk_rec_map( funk, wksp ) )==cnt );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",   NULL,      "gigantic" );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",  NULL,             1UL );
+  ulong        near_cpu  = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",  NULL, fd_log_cpu_id() );
+  ulong        wksp_tag  = fd_env_strip_cmdline_ulong( &argc, &argv, "--wksp-tag",  NULL,          1234UL );
+  ulong        seed      = fd_env_strip_cmdline_ulong( &argc, &argv, "--seed",      NULL,          5678UL );
+  ulong        rec_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--rec-cnt",   NULL,         65536UL );
+  ulong        upd_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--upd-cnt",   NULL,          1024UL );
+  ulong        round_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--round-cnt", NULL,            16UL );
+  ulong        val_sz    = fd_env_strip_cmdline_ulong( &argc, &argv, "--val-sz",    NULL,           128UL );
+  ulong        buf_max   = fd_env_strip_cmdline_ulong( &argc, &argv, "--buf-max",   NULL,      16UL<<20 );
+  char const * path      = fd_env_strip_cmdline_cstr ( &argc, &argv, "--path",      NULL,   "/tmp/test_funk_persist.XXXXXX" );
+
+  if( FD_UNLIKELY( (!rec_cnt) | (!upd_cnt) | (upd_cnt>rec_cnt) ) ) FD_LOG_ERR(( "bad --rec-cnt or --upd-cnt" ));
+  if( FD_UNLIKELY( !fd_funk_persist_footprint( buf_max ) ) ) FD_LOG_ERR(( "bad --buf-max" ));
+
+  FD_LOG_NOTICE(( "Using an anonymous local workspace, --page-sz %s, --page-cnt %lu, --near-cpu %lu", _page_sz, page_cnt, near_cpu ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to create wksp" ));
+
+  ulong txn_max = 4UL;
+  ulong rec_max = 2UL*rec_cnt + 2UL*upd_cnt;
+
+  FD_LOG_NOTICE(( "Testing with --wksp-tag %lu --seed %lu --rec-cnt %lu --upd-cnt %lu --round-cnt %lu --val-sz %lu --buf-max %lu",
+                  wksp_tag, seed, rec_cnt, upd_cnt, round_cnt, val_sz, buf_max ));
+
+  fd_funk_t * funk = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                wksp_tag, seed, txn_max, rec_max ) );
+  if( FD_UNLIKELY( !funk ) ) FD_LOG_ERR(( "Unable to create funk" ));
+
+  fd_funk_persist_t * persist = fd_funk_persist_join( fd_funk_persist_new(
+    fd_wksp_alloc_laddr( wksp, fd_funk_persist_align(), fd_funk_persist_footprint( buf_max ), wksp_tag ), buf_max ) );
+  if( FD_UNLIKELY( !persist ) ) FD_LOG_ERR(( "Unable to create persist" ));
+
+  /* Create the file.  O_DIRECT is not supported by all file systems
+     (e.g. tmpfs). */
+
+  char _path[ 4096 ];
+  FD_TEST( strlen( path )<sizeof(_path) );
+  strcpy( _path, path );
+  int fd = mkstemp( _path );
+  if( FD_UNLIKELY( fd<0 ) ) FD_LOG_ERR(( "mkstemp(\"%s\") failed (%i-%s)", path, errno, strerror( errno ) ));
+  if( FD_UNLIKELY( fcntl( fd, F_SETFL, fcntl( fd, F_GETFL ) | O_DIRECT ) ) )
+    FD_LOG_WARNING(( "O_DIRECT not supported for %s (%i-%s), using buffered I/O", _path, errno, strerror( errno ) ));
+  FD_LOG_NOTICE(( "Persisting to %s", _path ));
+
+  /* Populate */
+
+  for( ulong idx=0UL; idx<rec_cnt; idx++ ) test_write( funk, NULL, idx, 0UL, val_sz );
+
+  /* Attach and write the initial checkpoint */
+
+  FD_TEST( fd_funk_persist_attach( NULL,    funk, 1024UL, fd, 0UL, 0UL )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_persist_attach( persist, NULL, 1024UL, fd, 0UL, 0UL )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_persist_attach( persist, funk, 1000UL, fd, 0UL, 0UL )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_persist_attach( persist, funk, 1024UL, -1, 0UL, 0UL )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_persist_attach( persist, funk, 1024UL, fd, 1UL, 0UL )==FD_FUNK_ERR_INVAL );
+
+  ulong log_depth = fd_ulong_pow2_up( 4UL*upd_cnt );
+  FD_TEST( !fd_funk_persist_attach( persist, funk, log_depth, fd, 0UL, 0UL ) );
+  FD_TEST( fd_funk_persist_attach( persist, funk, log_depth, fd, 0UL, 0UL )==FD_FUNK_ERR_INVAL );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  FD_TEST( fd_funk_persist_pending( persist ) );
+  long dt = -fd_log_wallclock();
+  test_poll( persist );
+  dt += fd_log_wallclock();
+
+  fd_funk_persist_stats_t const * stats = fd_funk_persist_stats( persist );
+  FD_TEST( stats->ckpt_cnt==1UL );
+  FD_TEST( stats->rec_cnt ==rec_cnt );
+  FD_LOG_NOTICE(( "checkpoint: %lu records, %lu blocks, %lu bytes in %.3f ms",
+                  stats->rec_cnt, stats->blk_cnt, stats->write_sz, 1e-6*(double)dt ));
+
+  /* Publish rounds of updates, erases and inserts */
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, (uint)seed, 0UL ) );
+
+  ulong write_sz0 = stats->write_sz;
+  ulong chg_sz    = 0UL;
+  ulong next_idx  = rec_cnt;
+  ulong live_cnt  = rec_cnt;
+
+  fd_funk_txn_xid_t xid[1];
+  for( ulong round=0UL; round<round_cnt; round++ ) {
+    fd_memset( xid, 0, sizeof(fd_funk_txn_xid_t) );
+    xid->ul[0] = round+1UL;
+
+    fd_funk_txn_t * parent = fd_funk_txn_prepare( funk, NULL,   xid, 0 ); FD_TEST( parent );
+    xid->ul[1] = 1UL;
+    fd_funk_txn_t * txn    = fd_funk_txn_prepare( funk, parent, xid, 0 ); FD_TEST( txn    );
+
+    for( ulong upd=0UL; upd<upd_cnt; upd++ ) {
+      ulong idx = fd_rng_ulong_roll( rng, next_idx );
+      ulong r   = fd_rng_uint_roll( rng, 8U );
+      fd_funk_rec_key_t key[1];
+      if( r==0U ) { /* Erase */
+        fd_funk_rec_t const * rec = fd_funk_rec_query_global( funk, txn, test_key( key, idx ) );
+        if( rec && !(rec->flags & FD_FUNK_REC_FLAG_ERASE) ) {
+          fd_funk_rec_t * mrec = fd_funk_rec_modify( funk, fd_funk_rec_query( funk, txn, key ) );
+          if( !mrec ) mrec = fd_funk_rec_write_prepare( funk, txn, key, 0UL, NULL );
+          FD_TEST( mrec );
+          FD_TEST( !fd_funk_rec_remove( funk, mrec, 1 ) );
+          chg_sz += FD_FUNK_REC_KEY_FOOTPRINT;
+        }
+      } else if( r==1U ) { /* Insert */
+        test_write( funk, txn, next_idx++, round+1UL, val_sz );
+        chg_sz += FD_FUNK_REC_KEY_FOOTPRINT + val_sz;
+      } else { /* Update, with a varying size */
+        ulong sz = val_sz/2UL + fd_rng_ulong_roll( rng, val_sz+1UL );
+        test_write( funk, txn, idx, round+1UL, sz );
+        chg_sz += FD_FUNK_REC_KEY_FOOTPRINT + sz;
+      }
+    }
+
+    FD_TEST( fd_funk_txn_publish( funk, txn, 1 )==2UL );
+    test_poll( persist );
+    FD_TEST( !fd_funk_verify( funk ) );
+  }
+
+  fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
+  live_cnt = fd_funk_rec_cnt( rec_map );
+  FD_TEST( stats->ckpt_cnt==1UL );
+  FD_LOG_NOTICE(( "%lu rounds: %lu bytes changed, %lu bytes written (%.3f write amplification)",
+                  round_cnt, chg_sz, stats->write_sz-write_sz0, (double)(stats->write_sz-write_sz0)/(double)chg_sz ));
+
+  /* Updates published directly to the root */
+
+  test_write( funk, NULL, 0UL, 1000UL, val_sz );
+  FD_TEST( fd_funk_persist_pending( persist ) );
+  test_poll( persist );
+
+  /* Fall behind the publish log to force a checkpoint */
+
+  for( ulong idx=0UL; idx<2UL*log_depth; idx++ ) test_write( funk, NULL, idx % live_cnt, 2000UL, val_sz/4UL );
+  test_poll( persist );
+  FD_TEST( stats->ckpt_cnt==2UL );
+
+  /* A few more updates after the checkpoint */
+
+  fd_memset( xid, 0, sizeof(fd_funk_txn_xid_t) );
+  xid->ul[0] = round_cnt+1UL;
+  fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, xid, 0 ); FD_TEST( txn );
+  for( ulong upd=0UL; upd<upd_cnt; upd++ ) test_write( funk, txn, fd_rng_ulong_roll( rng, next_idx ), 3000UL, val_sz );
+  FD_TEST( fd_funk_txn_publish( funk, txn, 1 )==1UL );
+  live_cnt = fd_funk_rec_cnt( rec_map );
+  test_poll( persist );
+  FD_TEST( !fd_funk_persist_pending( persist ) );
+
+  FD_LOG_NOTICE(( "total: %lu blocks, %lu records (%lu erased), %lu checkpoints, %lu data bytes, %lu bytes written (%.3f)",
+                  stats->blk_cnt, stats->rec_cnt, stats->erase_cnt, stats->ckpt_cnt, stats->data_sz, stats->write_sz,
+                  (double)stats->write_sz/(double)stats->data_sz ));
+
+  ulong file_sz = stats->write_sz;
+  ulong blk_cnt = stats->blk_cnt;
+
+  fd_funk_persist_detach( persist );
+  FD_TEST( !funk->pub_log_gaddr );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* Restore into a new funk */
+
+  void * buf = fd_wksp_alloc_laddr( wksp, FD_FUNK_PERSIST_ALIGN, buf_max, wksp_tag );
+  FD_TEST( buf );
+
+  fd_funk_t * funk2 = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                 wksp_tag, seed+1UL, txn_max, rec_max ) );
+  FD_TEST( funk2 );
+
+  fd_funk_persist_restore_info_t info[1];
+  dt = -fd_log_wallclock();
+  FD_TEST( !fd_funk_persist_restore( funk2, fd, buf, buf_max, info ) );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "restore: %lu blocks, %lu records (%lu erased), %lu bytes read in %.3f ms (%.3f Mrec/s)",
+                  info->blk_cnt, info->rec_cnt, info->erase_cnt, info->read_sz, 1e-6*(double)dt,
+                  1e3*(double)info->rec_cnt/(double)dt ));
+  FD_TEST( info->end_off==file_sz );
+  FD_TEST( info->blk_seq==blk_cnt );
+  FD_TEST( fd_funk_rec_cnt( fd_funk_rec_map( funk2, wksp ) )==live_cnt );
+  test_cmp( funk2, funk );
+  FD_TEST( !fd_funk_verify( funk2 ) );
+
+  /* A torn block at the end of the file is ignored */
+
+  fd_funk_persist_blk_t * blk = (fd_funk_persist_blk_t *)buf;
+  fd_memset( blk, 0, 2UL*FD_FUNK_PERSIST_ALIGN );
+  blk->magic   = FD_FUNK_PERSIST_BLK_MAGIC;
+  blk->seq     = blk_cnt;
+  blk->sz      = 2UL*FD_FUNK_PERSIST_ALIGN;
+  blk->data_sz = FD_FUNK_PERSIST_REC_HDR_SZ;
+  blk->rec_cnt = 1UL;
+  blk->hash    = 1UL;
+  FD_TEST( pwrite( fd, blk, FD_FUNK_PERSIST_ALIGN, (off_t)file_sz )==(long)FD_FUNK_PERSIST_ALIGN );
+
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk2 ) ) );
+  funk2 = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                     wksp_tag, seed+2UL, txn_max, rec_max ) );
+  FD_TEST( funk2 );
+  FD_TEST( !fd_funk_persist_restore( funk2, fd, buf, buf_max, info ) );
+  FD_TEST( info->end_off==file_sz );
+  FD_TEST( info->blk_seq==blk_cnt );
+  test_cmp( funk2, funk );
+
+  /* Appending to a restored file */
+
+  FD_TEST( !fd_funk_persist_attach( persist, funk2, log_depth, fd, info->end_off, info->blk_seq ) );
+  test_poll( persist );
+  test_write( funk2, NULL, 1UL, 4000UL, val_sz );
+  test_write( funk,  NULL, 1UL, 4000UL, val_sz );
+  test_poll( persist );
+  fd_funk_persist_detach( persist );
+
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk2 ) ) );
+  funk2 = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                     wksp_tag, seed+3UL, txn_max, rec_max ) );
+  FD_TEST( funk2 );
+  FD_TEST( !fd_funk_persist_restore( funk2, fd, buf, buf_max, info ) );
+  FD_TEST( info->blk_seq>blk_cnt );
+  test_cmp( funk2, funk );
+
+  /* A checkpoint that was started but not completed is not replayed.
+     funk2 gets a record of the largest value that was never persisted
+     and a persister with the smallest buffer writes only the first
+     block of a checkpoint of it (that record fills a block alone, so
+     the checkpoint takes at least two). */
+
+  ulong end_off = info->end_off;
+  ulong end_seq = info->blk_seq;
+
+  ulong small_max = FD_FUNK_PERSIST_BUF_MIN;
+  fd_funk_persist_t * small = fd_funk_persist_join( fd_funk_persist_new(
+    fd_wksp_alloc_laddr( wksp, fd_funk_persist_align(), fd_funk_persist_footprint( small_max ), wksp_tag ), small_max ) );
+  FD_TEST( small );
+
+  test_write( funk2, NULL, next_idx, 5000UL, FD_FUNK_REC_VAL_MAX );
+  FD_TEST( !fd_funk_persist_attach( small, funk2, log_depth, fd, end_off, end_seq ) );
+  ulong small_rec_cnt;
+  FD_TEST( !fd_funk_persist_poll( small, &small_rec_cnt ) );
+  FD_TEST( small_rec_cnt );
+  FD_TEST( fd_funk_persist_pending( small ) );
+  fd_funk_persist_detach( small );
+
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk2 ) ) );
+  funk2 = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                     wksp_tag, seed+4UL, txn_max, rec_max ) );
+  FD_TEST( funk2 );
+  FD_TEST( !fd_funk_persist_restore( funk2, fd, buf, buf_max, info ) );
+  FD_TEST( info->end_off==end_off );
+  FD_TEST( info->blk_seq==end_seq );
+  test_cmp( funk2, funk );
+
+  /* A file without a complete checkpoint */
+
+  FD_TEST( !ftruncate( fd, (off_t)FD_FUNK_PERSIST_ALIGN ) );
+  FD_TEST( fd_funk_persist_restore( funk2, fd, buf, buf_max, info )==FD_FUNK_ERR_IO );
+
+  /* Clean up */
+
+  FD_TEST( !close( fd ) );
+  FD_TEST( !unlink( _path ) );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_free_laddr( buf );
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk2 ) ) );
+  fd_wksp_free_laddr( fd_funk_persist_delete( fd_funk_persist_leave( small ) ) );
+  fd_wksp_free_laddr( fd_funk_persist_delete( fd_funk_persist_leave( persist ) ) );
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk ) ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
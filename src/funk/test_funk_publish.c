@@ -0,0 +1,191 @@
+#include "fd_funk.h"
+
+#if FD_HAS_HOSTED
+
+/* This tests and benchmarks fd_funk_txn_publish_tpool.  Two funks are
+   given the same sequence of transactions.  Each transaction updates,
+   creates and erases rec_cnt records of a bounded key space.  One funk
+   publishes serially with fd_funk_txn_publish and the other with
+   fd_funk_txn_publish_tpool, over a range of transaction sizes and
+   worker counts.  After each publish, both funks are verified and
+   their published records are checked to be identical, in the same
+   order.  Publish latencies are reported.  Run with more tiles (e.g.
+   --tile-cpus 1-16) and a larger --rec-max for realistic numbers. */
+
+static fd_funk_rec_key_t *
+test_key( fd_funk_rec_key_t * key,
+          ulong               idx ) {
+  fd_memset( key, 0, sizeof(fd_funk_rec_key_t) );
+  key->ul[0] = idx;
+  key->ul[1] = fd_ulong_hash( idx );
+  return key;
+}
+
+/* test_txn fills txn with rec_cnt updates to keys [key0,key0+rec_cnt)
+   mod key_max.  Every eighth key is erased if it is published. */
+
+static void
+test_txn( fd_funk_t *     funk,
+          fd_funk_txn_t * txn,
+          ulong           key0,
+          ulong           rec_cnt,
+          ulong           key_max,
+          ulong           val_sz,
+          ulong           round ) {
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+  for( ulong j=0UL; j<rec_cnt; j++ ) {
+    ulong idx = (key0 + j) % key_max;
+    fd_funk_rec_key_t key[1]; test_key( key, idx );
+    if( !(j & 7UL) && fd_funk_rec_query( funk, NULL, key ) ) {
+      fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key, 0UL, NULL );
+      FD_TEST( rec );
+      FD_TEST( !fd_funk_rec_remove( funk, rec, 1 ) );
+      continue;
+    }
+    ulong sz = val_sz/2UL + ((idx ^ round) % (val_sz+1UL));
+    int err;
+    fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key, sz, &err );
+    if( FD_UNLIKELY( !rec ) ) FD_LOG_ERR(( "fd_funk_rec_write_prepare failed (%i-%s)", err, fd_funk_strerror( err ) ));
+    fd_memset( fd_funk_val( rec, wksp ), (int)(uchar)(idx + round), fd_funk_val_sz( rec ) );
+  }
+}
+
+/* test_cmp checks the published records of funk and ref match, in
+   order */
+
+static void
+test_cmp( fd_funk_t * funk,
+          fd_funk_t * ref ) {
+  fd_wksp_t *     wksp        = fd_funk_wksp( funk );
+  fd_funk_rec_t * rec_map     = fd_funk_rec_map( funk, wksp );
+  fd_funk_rec_t * ref_rec_map = fd_funk_rec_map( ref, wksp );
+
+  ulong rec_idx     = funk->rec_head_idx;
+  ulong ref_rec_idx = ref->rec_head_idx;
+  while( !fd_funk_rec_idx_is_null( ref_rec_idx ) ) {
+    FD_TEST( !fd_funk_rec_idx_is_null( rec_idx ) );
+    fd_funk_rec_t const * rec     = rec_map     + rec_idx;
+    fd_funk_rec_t const * ref_rec = ref_rec_map + ref_rec_idx;
+    FD_TEST( fd_funk_rec_key_eq( fd_funk_rec_key( rec ), fd_funk_rec_key( ref_rec ) ) );
+    FD_TEST( fd_funk_val_sz( rec )==fd_funk_val_sz( ref_rec ) );
+    FD_TEST( !memcmp( fd_funk_val_const( rec, wksp ), fd_funk_val_const( ref_rec, wksp ), fd_funk_val_sz( rec ) ) );
+    rec_idx     = rec->next_idx;
+    ref_rec_idx = ref_rec->next_idx;
+  }
+  FD_TEST( fd_funk_rec_idx_is_null( rec_idx ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",   NULL,      "gigantic" );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",  NULL,             1UL );
+  ulong        near_cpu = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",  NULL, fd_log_cpu_id() );
+  ulong        wksp_tag = fd_env_strip_cmdline_ulong( &argc, &argv, "--wksp-tag",  NULL,          1234UL );
+  ulong        seed     = fd_env_strip_cmdline_ulong( &argc, &argv, "--seed",      NULL,          5678UL );
+  ulong        rec_min  = fd_env_strip_cmdline_ulong( &argc, &argv, "--rec-min",   NULL,          1024UL );
+  ulong        rec_max  = fd_env_strip_cmdline_ulong( &argc, &argv, "--rec-max",   NULL,         65536UL );
+  ulong        val_sz   = fd_env_strip_cmdline_ulong( &argc, &argv, "--val-sz",    NULL,           128UL );
+  ulong        tile_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--tile-max",  NULL,            16UL );
+
+  tile_max = fd_ulong_min( tile_max, fd_tile_cnt() );
+  if( FD_UNLIKELY( (!rec_min) | (rec_min>rec_max) ) ) FD_LOG_ERR(( "bad --rec-min or --rec-max" ));
+
+  FD_LOG_NOTICE(( "Using an anonymous local workspace, --page-sz %s, --page-cnt %lu, --near-cpu %lu", _page_sz, page_cnt, near_cpu ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to create wksp" ));
+
+  FD_LOG_NOTICE(( "Testing with --wksp-tag %lu --seed %lu --rec-min %lu --rec-max %lu --val-sz %lu --tile-max %lu",
+                  wksp_tag, seed, rec_min, rec_max, val_sz, tile_max ));
+
+  ulong key_max     = 2UL*rec_max;
+  ulong txn_max     = 2UL;
+  ulong funk_rec_max = key_max + rec_max + 1UL;
+
+  fd_funk_t * funk = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                wksp_tag, seed, txn_max, funk_rec_max ) );
+  fd_funk_t * ref  = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                wksp_tag, seed, txn_max, funk_rec_max ) );
+  if( FD_UNLIKELY( (!funk) | (!ref) ) ) FD_LOG_ERR(( "Unable to create funk" ));
+
+  static uchar tpool_mem[ FD_TPOOL_FOOTPRINT(FD_TILE_MAX) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+  fd_tpool_t * tpool = fd_tpool_init( tpool_mem, fd_ulong_max( tile_max, 1UL ) );
+  FD_TEST( tpool );
+  for( ulong tile_idx=1UL; tile_idx<tile_max; tile_idx++ ) FD_TEST( fd_tpool_worker_push( tpool, tile_idx, NULL, 0UL ) );
+
+  /* Bad args */
+
+  fd_funk_txn_xid_t xid[1]; fd_memset( xid, 0, sizeof(fd_funk_txn_xid_t) );
+  xid->ul[0] = 1UL;
+  fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, xid, 0 ); FD_TEST( txn );
+  FD_TEST( !fd_funk_txn_publish_tpool( funk, txn, NULL,  0UL, 1UL,         0 ) );
+  FD_TEST( !fd_funk_txn_publish_tpool( funk, txn, tpool, 1UL, 1UL,         0 ) );
+  FD_TEST( !fd_funk_txn_publish_tpool( funk, txn, tpool, 0UL, tile_max+1UL, 0 ) );
+  FD_TEST( !fd_funk_txn_publish_tpool( NULL, txn, tpool, 0UL, 1UL,         0 ) );
+  FD_TEST( fd_funk_txn_cancel( funk, txn, 0 )==1UL );
+
+  /* Populate both */
+
+  ulong round = 1UL;
+  ulong key0  = 0UL;
+  for( fd_funk_t * f = funk; f; f = (f==funk) ? ref : NULL ) {
+    xid->ul[0] = round;
+    txn = fd_funk_txn_prepare( f, NULL, xid, 0 ); FD_TEST( txn );
+    test_txn( f, txn, key0, key_max, key_max, val_sz, round );
+    FD_TEST( fd_funk_txn_publish( f, txn, 0 )==1UL );
+  }
+  test_cmp( funk, ref );
+
+  for( ulong rec_cnt=rec_min; rec_cnt<=rec_max; rec_cnt<<=1 ) {
+    for( ulong worker_cnt=1UL; worker_cnt<=tile_max; worker_cnt<<=1 ) {
+      round++;
+      key0 += rec_cnt/3UL; /* Vary the mix of updates, creates and erases */
+
+      long dt_ref = 0L;
+      long dt     = 0L;
+      for( fd_funk_t * f = funk; f; f = (f==funk) ? ref : NULL ) {
+        xid->ul[0] = round;
+        txn = fd_funk_txn_prepare( f, NULL, xid, 0 ); FD_TEST( txn );
+        test_txn( f, txn, key0, rec_cnt, key_max, val_sz, round );
+        long t = -fd_log_wallclock();
+        if( f==funk ) FD_TEST( fd_funk_txn_publish_tpool( f, txn, tpool, 0UL, worker_cnt, 1 )==1UL );
+        else          FD_TEST( fd_funk_txn_publish      ( f, txn,                         1 )==1UL );
+        t += fd_log_wallclock();
+        if( f==funk ) dt = t; else dt_ref = t;
+      }
+
+      FD_TEST( !fd_funk_verify( funk ) );
+      FD_TEST( !fd_funk_verify( ref  ) );
+      test_cmp( funk, ref );
+
+      FD_LOG_NOTICE(( "%7lu records, %2lu worker(s): %9.3f us (serial %9.3f us)",
+                      rec_cnt, worker_cnt, 1e-3*(double)dt, 1e-3*(double)dt_ref ));
+    }
+  }
+
+  for( ulong tile_idx=1UL; tile_idx<tile_max; tile_idx++ ) FD_TEST( fd_tpool_worker_pop( tpool ) );
+  FD_TEST( fd_tpool_fini( tpool )==(void *)tpool_mem );
+
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( ref  ) ) );
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk ) ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
@@ -510,6 +510,62 @@ main( int     argc,
   funk_delete( ref );
 
   fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( tst ) ) );
+
+  /* Benchmark global queries of records in the last published
+     transaction from the youngest transaction of a linear fork of
+     depth in-prep transactions (i.e. the worst case of the walk up the
+     ancestors).  The first query of each key walks the ancestors and
+     the repeated ones hit the record cache. */
+
+  do {
+    ulong bench_key_cnt = 64UL;
+    ulong bench_iter    = 64UL;
+
+    fd_funk_t * bench = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                   wksp_tag, seed, 128UL, 1024UL ) );
+    if( FD_UNLIKELY( !bench ) ) FD_LOG_ERR(( "Unable to create bench" ));
+
+    fd_funk_rec_key_t bkey[64];
+    for( ulong k=0UL; k<bench_key_cnt; k++ ) {
+      fd_memset( &bkey[k], 0, sizeof(fd_funk_rec_key_t) );
+      bkey[k].ul[0] = fd_rng_ulong( rng );
+      FD_TEST( fd_funk_rec_insert( bench, NULL, &bkey[k], NULL ) );
+    }
+
+    for( ulong depth=1UL; depth<=64UL; depth<<=1 ) {
+
+      fd_funk_txn_t * root_child = NULL;
+      fd_funk_txn_t * leaf       = NULL;
+      for( ulong d=0UL; d<depth; d++ ) {
+        fd_funk_txn_xid_t bxid[1]; fd_memset( bxid, 0, sizeof(fd_funk_txn_xid_t) ); bxid->ul[0] = (depth<<8) | (d+1UL);
+        leaf = fd_funk_txn_prepare( bench, leaf, bxid, verbose ); FD_TEST( leaf );
+        if( !d ) root_child = leaf;
+      }
+
+      long dt_miss = 0L;
+      long dt_hit  = 0L;
+      for( ulong iter=0UL; iter<bench_iter; iter++ ) {
+        fd_funk_rec_cache_invalidate( bench );
+
+        dt_miss -= fd_log_wallclock();
+        for( ulong k=0UL; k<bench_key_cnt; k++ ) FD_TEST( fd_funk_rec_query_global( bench, leaf, &bkey[k] ) );
+        dt_miss += fd_log_wallclock();
+
+        dt_hit -= fd_log_wallclock();
+        for( ulong k=0UL; k<bench_key_cnt; k++ ) FD_TEST( fd_funk_rec_query_global( bench, leaf, &bkey[k] ) );
+        dt_hit += fd_log_wallclock();
+      }
+
+      double query_cnt = (double)(bench_iter*bench_key_cnt);
+      FD_LOG_NOTICE(( "fork depth %2lu: uncached %7.1f ns/query, cached %5.1f ns/query",
+                      depth, (double)dt_miss/query_cnt, (double)dt_hit/query_cnt ));
+
+      FD_TEST( fd_funk_txn_cancel( bench, root_child, verbose )==depth );
+    }
+
+    FD_TEST( !fd_funk_verify( bench ) );
+    fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( bench ) ) );
+  } while(0);
   if( name ) fd_wksp_detach( wksp );
   else       fd_wksp_delete_anonymous( wksp );
 
@@ -0,0 +1,202 @@
+#include "fd_funk.h"
+
+#if FD_HAS_HOSTED
+
+/* This is a stress test and benchmark for multiple tiles concurrently
+   writing disjoint records into the same in-preparation transaction.
+   Each round, tiles [0,tile_cnt) write rec_cnt records each with
+   fd_funk_rec_write_prepare.  A quarter of the keys have a version in
+   the last published transaction (such that write_prepare copies it)
+   and the rest are new.  After all tiles are done, every record is
+   checked, the funk is verified and the transaction is cancelled.
+   With --slab 1 (the default), the values are held in value slabs
+   (such that the tiles also contend on the slab free stacks). */
+
+static fd_funk_t *     _funk;
+static fd_funk_txn_t * _txn;
+static ulong           _rec_cnt;
+static ulong           _val_sz;
+static ulong           _tile_cnt;
+static ulong           _ready;
+
+static fd_funk_rec_key_t *
+test_key( fd_funk_rec_key_t * key,
+          ulong               tile_idx,
+          ulong               rec_idx ) {
+  fd_memset( key, 0, sizeof(fd_funk_rec_key_t) );
+  key->ul[0] = tile_idx;
+  key->ul[1] = rec_idx;
+  key->ul[2] = fd_ulong_hash( (tile_idx<<32) ^ rec_idx );
+  return key;
+}
+
+static int
+test_main( int     argc,
+           char ** argv ) {
+  (void)argc; (void)argv;
+
+  ulong tile_idx = fd_tile_idx();
+
+  fd_funk_t *     funk     = FD_VOLATILE_CONST( _funk     );
+  fd_funk_txn_t * txn      = FD_VOLATILE_CONST( _txn      );
+  ulong           rec_cnt  = FD_VOLATILE_CONST( _rec_cnt  );
+  ulong           val_sz   = FD_VOLATILE_CONST( _val_sz   );
+  ulong           tile_cnt = FD_VOLATILE_CONST( _tile_cnt );
+
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+
+  /* Start all tiles at the same time */
+
+  FD_ATOMIC_FETCH_AND_ADD( &_ready, 1UL );
+  while( FD_VOLATILE_CONST( _ready )<tile_cnt ) FD_SPIN_PAUSE();
+
+  for( ulong rec_idx=0UL; rec_idx<rec_cnt; rec_idx++ ) {
+    fd_funk_rec_key_t key[1];
+    int err;
+    fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, test_key( key, tile_idx, rec_idx ), val_sz, &err );
+    if( FD_UNLIKELY( !rec ) ) FD_LOG_ERR(( "fd_funk_rec_write_prepare failed (%i-%s)", err, fd_funk_strerror( err ) ));
+    fd_memset( fd_funk_val( rec, wksp ), (int)(uchar)key->ul[2], val_sz );
+  }
+
+  return 0;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * name     = fd_env_strip_cmdline_cstr ( &argc, &argv, "--wksp",      NULL,            NULL );
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",   NULL,      "gigantic" );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",  NULL,             1UL );
+  ulong        near_cpu = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",  NULL, fd_log_cpu_id() );
+  ulong        wksp_tag = fd_env_strip_cmdline_ulong( &argc, &argv, "--wksp-tag",  NULL,          1234UL );
+  ulong        seed     = fd_env_strip_cmdline_ulong( &argc, &argv, "--seed",      NULL,          5678UL );
+  ulong        rec_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--rec-cnt",   NULL,         16384UL );
+  ulong        val_sz   = fd_env_strip_cmdline_ulong( &argc, &argv, "--val-sz",    NULL,           256UL );
+  ulong        tile_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--tile-max",  NULL,            16UL );
+  int          slab     = fd_env_strip_cmdline_int  ( &argc, &argv, "--slab",      NULL,               1 );
+
+  tile_max = fd_ulong_min( tile_max, fd_tile_cnt() );
+  if( FD_UNLIKELY( !tile_max ) ) FD_LOG_ERR(( "--tile-max should be positive" ));
+
+  fd_wksp_t * wksp;
+  if( name ) {
+    FD_LOG_NOTICE(( "Attaching to --wksp %s", name ));
+    wksp = fd_wksp_attach( name );
+  } else {
+    FD_LOG_NOTICE(( "--wksp not specified, using an anonymous local workspace, --page-sz %s, --page-cnt %lu, --near-cpu %lu",
+                    _page_sz, page_cnt, near_cpu ));
+    wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  }
+
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to attach to wksp" ));
+
+  ulong txn_max = 2UL;
+  ulong rec_max = 2UL*tile_max*rec_cnt;
+
+  FD_LOG_NOTICE(( "Testing with --wksp-tag %lu --seed %lu --rec-cnt %lu --val-sz %lu --tile-max %lu --slab %i",
+                  wksp_tag, seed, rec_cnt, val_sz, tile_max, slab ));
+
+  fd_funk_t * funk = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                wksp_tag, seed, txn_max, rec_max ) );
+  if( FD_UNLIKELY( !funk ) ) FD_LOG_ERR(( "Unable to create funk" ));
+
+  if( slab && val_sz>=16UL && val_sz<=FD_FUNK_VAL_SLAB_VAL_MAX ) {
+    ulong class_sz[2] = { fd_ulong_align_up( val_sz/2UL, 8UL ), fd_ulong_align_up( val_sz, 8UL ) };
+    FD_TEST( !fd_funk_val_slab_config( funk, class_sz, 2UL - (ulong)(class_sz[0]==class_sz[1]) ) );
+  }
+
+  fd_funk_rec_t * rec_map = fd_funk_rec_map( funk, wksp );
+
+  /* Publish a version of every fourth key */
+
+  ulong pub_cnt = 0UL;
+  for( ulong tile_idx=0UL; tile_idx<tile_max; tile_idx++ ) {
+    for( ulong rec_idx=0UL; rec_idx<rec_cnt; rec_idx+=4UL ) {
+      fd_funk_rec_key_t key[1];
+      fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, NULL, test_key( key, tile_idx, rec_idx ), val_sz/2UL, NULL );
+      FD_TEST( rec );
+      fd_memset( fd_funk_val( rec, wksp ), 0xff, val_sz/2UL );
+      pub_cnt++;
+    }
+  }
+  FD_TEST( fd_funk_rec_cnt( rec_map )==pub_cnt );
+
+  fd_funk_txn_xid_t xid[1];
+  ulong             round = 0UL;
+
+  for( ulong tile_cnt=1UL; tile_cnt<=tile_max; tile_cnt<<=1 ) {
+
+    fd_memset( xid, 0, sizeof(fd_funk_txn_xid_t) );
+    xid->ul[0] = ++round;
+    fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, xid, 0 );
+    FD_TEST( txn );
+
+    FD_COMPILER_MFENCE();
+    FD_VOLATILE( _funk     ) = funk;
+    FD_VOLATILE( _txn      ) = txn;
+    FD_VOLATILE( _rec_cnt  ) = rec_cnt;
+    FD_VOLATILE( _val_sz   ) = val_sz;
+    FD_VOLATILE( _tile_cnt ) = tile_cnt;
+    FD_VOLATILE( _ready    ) = 0UL;
+    FD_COMPILER_MFENCE();
+
+    long dt = -fd_log_wallclock();
+
+    fd_tile_exec_t * exec[ FD_TILE_MAX ];
+    for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ ) exec[tile_idx] = fd_tile_exec_new( tile_idx, test_main, 0, NULL );
+
+    test_main( 0, NULL );
+
+    for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ ) fd_tile_exec_delete( exec[tile_idx], NULL );
+
+    dt += fd_log_wallclock();
+
+    ulong write_cnt = tile_cnt*rec_cnt;
+    FD_LOG_NOTICE(( "%2lu tile(s): %lu writes in %.3f ms (%.3f Mwrite/s)",
+                    tile_cnt, write_cnt, 1e-6*(double)dt, 1e3*(double)write_cnt/(double)dt ));
+
+    /* Check every record landed in txn with the right value */
+
+    for( ulong tile_idx=0UL; tile_idx<tile_cnt; tile_idx++ ) {
+      for( ulong rec_idx=0UL; rec_idx<rec_cnt; rec_idx++ ) {
+        fd_funk_rec_key_t key[1];
+        fd_funk_rec_t const * rec = fd_funk_rec_query_const( funk, txn, test_key( key, tile_idx, rec_idx ) );
+        FD_TEST( rec );
+        FD_TEST( fd_funk_val_sz( rec )==val_sz );
+        uchar const * val = (uchar const *)fd_funk_val_const( rec, wksp );
+        for( ulong off=0UL; off<val_sz; off++ ) FD_TEST( val[ off ]==(uchar)key->ul[2] );
+      }
+    }
+    FD_TEST( fd_funk_rec_cnt( rec_map )==pub_cnt + write_cnt );
+
+    FD_TEST( !fd_funk_verify( funk ) );
+
+    FD_TEST( fd_funk_txn_cancel( funk, txn, 0 )==1UL );
+    FD_TEST( fd_funk_rec_cnt( rec_map )==pub_cnt );
+  }
+
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk ) ) );
+  if( name ) fd_wksp_detach( wksp );
+  else       fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
@@ -0,0 +1,304 @@
+#include "fd_funk.h"
+
+#if FD_HAS_HOSTED
+
+/* This tests and benchmarks the funk value slabs.  Two funks are given
+   the same token-account-shaped workload (rec_cnt accounts with val_sz
+   byte values, default 165 bytes like a SPL token account): one with
+   value slabs configured and one without.  All accounts are inserted in
+   a transaction that is published and then updated round_cnt times (by
+   fd_funk_rec_write_prepare in a transaction that is published).  The
+   values of both funks are checked to match and the wksp bytes used per
+   record by values and the insert/update throughputs are reported.
+   Then values are resized across the slab classes to exercise moving
+   values in and out of slabs. */
+
+static fd_funk_rec_key_t *
+test_key( fd_funk_rec_key_t * key,
+          ulong               idx ) {
+  fd_memset( key, 0, sizeof(fd_funk_rec_key_t) );
+  key->ul[0] = idx;
+  key->ul[1] = fd_ulong_hash( idx );
+  return key;
+}
+
+static ulong
+test_used_sz( fd_wksp_t * wksp,
+              ulong       wksp_tag ) {
+  fd_wksp_usage_t usage[1];
+  FD_TEST( fd_wksp_usage( wksp, &wksp_tag, 1UL, usage )==usage );
+  return usage->used_sz;
+}
+
+/* test_round writes every account in a new transaction of funk and
+   publishes it.  Returns the time taken in ns. */
+
+static long
+test_round( fd_funk_t * funk,
+            ulong       rec_cnt,
+            ulong       val_sz,
+            ulong       round ) {
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+
+  fd_funk_txn_xid_t xid[1]; fd_memset( xid, 0, sizeof(fd_funk_txn_xid_t) );
+  xid->ul[0] = round;
+
+  long dt = -fd_log_wallclock();
+
+  fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, xid, 0 ); FD_TEST( txn );
+  for( ulong idx=0UL; idx<rec_cnt; idx++ ) {
+    fd_funk_rec_key_t key[1];
+    int err;
+    fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, test_key( key, idx ), val_sz, &err );
+    if( FD_UNLIKELY( !rec ) ) FD_LOG_ERR(( "fd_funk_rec_write_prepare failed (%i-%s)", err, fd_funk_strerror( err ) ));
+    uchar * val = (uchar *)fd_funk_val( rec, wksp );
+    FD_STORE( ulong, val,     idx   ); /* e.g. mint */
+    FD_STORE( ulong, val+64UL, round ); /* e.g. amount */
+  }
+  FD_TEST( fd_funk_txn_publish( funk, txn, 0 )==1UL );
+
+  dt += fd_log_wallclock();
+  return dt;
+}
+
+static void
+test_cmp( fd_funk_t * funk,
+          fd_funk_t * ref,
+          ulong       rec_cnt ) {
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+  for( ulong idx=0UL; idx<rec_cnt; idx++ ) {
+    fd_funk_rec_key_t key[1]; test_key( key, idx );
+    fd_funk_rec_t const * rec     = fd_funk_rec_query( funk, NULL, key ); FD_TEST( rec     );
+    fd_funk_rec_t const * ref_rec = fd_funk_rec_query( ref,  NULL, key ); FD_TEST( ref_rec );
+    FD_TEST( fd_funk_val_sz( rec )==fd_funk_val_sz( ref_rec ) );
+    FD_TEST( !memcmp( fd_funk_val_const( rec, wksp ), fd_funk_val_const( ref_rec, wksp ), fd_funk_val_sz( rec ) ) );
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",   NULL,      "gigantic" );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",  NULL,             1UL );
+  ulong        near_cpu  = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",  NULL, fd_log_cpu_id() );
+  ulong        wksp_tag  = fd_env_strip_cmdline_ulong( &argc, &argv, "--wksp-tag",  NULL,          1234UL );
+  ulong        seed      = fd_env_strip_cmdline_ulong( &argc, &argv, "--seed",      NULL,          5678UL );
+  ulong        rec_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--rec-cnt",   NULL,         65536UL );
+  ulong        val_sz    = fd_env_strip_cmdline_ulong( &argc, &argv, "--val-sz",    NULL,           165UL );
+  ulong        round_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--round-cnt", NULL,             4UL );
+
+  if( FD_UNLIKELY( val_sz<72UL ) ) FD_LOG_ERR(( "--val-sz should be at least 72" ));
+
+  FD_LOG_NOTICE(( "Using an anonymous local workspace, --page-sz %s, --page-cnt %lu, --near-cpu %lu", _page_sz, page_cnt, near_cpu ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  if( FD_UNLIKELY( !wksp ) ) FD_LOG_ERR(( "Unable to create wksp" ));
+
+  FD_LOG_NOTICE(( "Testing with --wksp-tag %lu --seed %lu --rec-cnt %lu --val-sz %lu --round-cnt %lu",
+                  wksp_tag, seed, rec_cnt, val_sz, round_cnt ));
+
+  ulong txn_max = 2UL;
+  ulong rec_max = 2UL*rec_cnt + 1UL;
+
+  ulong ref_tag = wksp_tag;
+  ulong tag     = wksp_tag + 1UL;
+
+  fd_funk_t * ref  = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), ref_tag ),
+                                                ref_tag, seed, txn_max, rec_max ) );
+  fd_funk_t * funk = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), tag ),
+                                                tag, seed, txn_max, rec_max ) );
+  if( FD_UNLIKELY( (!funk) | (!ref) ) ) FD_LOG_ERR(( "Unable to create funk" ));
+
+  /* Bad configs */
+
+  ulong bad0[2] = { 64UL, 64UL  };
+  ulong bad1[1] = { 60UL        };
+  ulong bad2[1] = { FD_FUNK_VAL_SLAB_VAL_MAX+8UL };
+  ulong bad3[1] = { 0UL         };
+  FD_TEST( fd_funk_val_slab_config( NULL, NULL, 0UL                            )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_val_slab_config( funk, NULL, 1UL                            )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_val_slab_config( funk, bad0, 2UL                            )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_val_slab_config( funk, bad1, 1UL                            )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_val_slab_config( funk, bad2, 1UL                            )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_val_slab_config( funk, bad3, 1UL                            )==FD_FUNK_ERR_INVAL );
+  FD_TEST( fd_funk_val_slab_config( funk, bad0, FD_FUNK_VAL_SLAB_CLASS_MAX+1UL )==FD_FUNK_ERR_INVAL );
+  FD_TEST( !fd_funk_val_slab( funk, wksp ) );
+
+  /* Slot sizes covering the common small Solana account sizes (the 165
+     byte token accounts get the 168 byte class) */
+
+  ulong class_sz[6] = { 32UL, 64UL, 128UL, 168UL, 256UL, 512UL };
+  FD_TEST( !fd_funk_val_slab_config( funk, class_sz, 6UL ) );
+  FD_TEST( !fd_funk_val_slab_config( funk, NULL,     0UL ) ); /* Reconfig is fine while unused */
+  FD_TEST( !fd_funk_val_slab( funk, wksp ) );
+  FD_TEST( !fd_funk_val_slab_config( funk, class_sz, 6UL ) );
+  FD_TEST( fd_funk_val_slab( funk, wksp ) );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  ulong ref_used0 = test_used_sz( wksp, ref_tag );
+  ulong used0     = test_used_sz( wksp, tag     );
+
+  /* Insert all the accounts */
+
+  ulong round = 1UL;
+  long  dt_ref = test_round( ref,  rec_cnt, val_sz, round );
+  long  dt     = test_round( funk, rec_cnt, val_sz, round );
+  FD_TEST( !fd_funk_verify( funk ) );
+  FD_TEST( !fd_funk_verify( ref  ) );
+  test_cmp( funk, ref, rec_cnt );
+
+  FD_LOG_NOTICE(( "insert: %.3f Mrec/s with slabs (%.1f value bytes/rec), %.3f Mrec/s without (%.1f value bytes/rec)",
+                  1e3*(double)rec_cnt/(double)dt,     (double)(test_used_sz( wksp, tag     )-used0    )/(double)rec_cnt,
+                  1e3*(double)rec_cnt/(double)dt_ref, (double)(test_used_sz( wksp, ref_tag )-ref_used0)/(double)rec_cnt ));
+
+  /* Update all the accounts */
+
+  dt_ref = 0L;
+  dt     = 0L;
+  for( ulong r=0UL; r<round_cnt; r++ ) {
+    round++;
+    dt_ref += test_round( ref,  rec_cnt, val_sz, round );
+    dt     += test_round( funk, rec_cnt, val_sz, round );
+  }
+  FD_TEST( !fd_funk_verify( funk ) );
+  FD_TEST( !fd_funk_verify( ref  ) );
+  test_cmp( funk, ref, rec_cnt );
+
+  ulong update_cnt = round_cnt*rec_cnt;
+  FD_LOG_NOTICE(( "update: %.3f Mrec/s with slabs (%.1f value bytes/rec), %.3f Mrec/s without (%.1f value bytes/rec)",
+                  1e3*(double)update_cnt/(double)fd_long_max( dt,     1L ),
+                  (double)(test_used_sz( wksp, tag     )-used0    )/(double)rec_cnt,
+                  1e3*(double)update_cnt/(double)fd_long_max( dt_ref, 1L ),
+                  (double)(test_used_sz( wksp, ref_tag )-ref_used0)/(double)rec_cnt ));
+
+  /* Every account is in a slab slot and the slots released by the
+     published updates were reused */
+
+  fd_funk_val_slab_t const * slab = fd_funk_val_slab( funk, wksp );
+  FD_TEST( slab->class[3].used_cnt==((val_sz<=168UL) & (val_sz>128UL) ? rec_cnt : 0UL) );
+  ulong slot_cnt = 0UL;
+  for( ulong class_idx=0UL; class_idx<slab->class_cnt; class_idx++ ) slot_cnt += slab->class[ class_idx ].slot_cnt;
+  ulong slot_per_chunk = (FD_FUNK_VAL_SLAB_CHUNK_SZ-FD_FUNK_VAL_SLAB_CHUNK_HDR_SZ)/168UL;
+  if( (val_sz<=168UL) & (val_sz>128UL) ) FD_TEST( slot_cnt<=2UL*rec_cnt + slot_per_chunk );
+
+  /* In use slabs cannot be reconfigured */
+
+  FD_TEST( fd_funk_val_slab_config( funk, NULL, 0UL )==FD_FUNK_ERR_INVAL );
+
+  /* Resize values in and out of the slabs, in the last published
+     transaction and in a transaction that gets cancelled */
+
+  fd_alloc_t * alloc = fd_funk_alloc( funk, wksp );
+
+  fd_funk_txn_xid_t xid[1]; fd_memset( xid, 0, sizeof(fd_funk_txn_xid_t) );
+  xid->ul[0] = ++round;
+  fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, xid, 0 ); FD_TEST( txn );
+
+  uchar buf[ 1024 ];
+  for( ulong i=0UL; i<sizeof(buf); i++ ) buf[i] = (uchar)i;
+
+  ulong chk_cnt = fd_ulong_min( rec_cnt, 64UL );
+  for( ulong idx=0UL; idx<chk_cnt; idx++ ) {
+    fd_funk_rec_key_t key[1]; test_key( key, idx );
+    int err;
+    fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key, 0UL, &err ); FD_TEST( rec );
+    FD_TEST( rec->flags & FD_FUNK_REC_FLAG_SLAB );
+    ulong val_max = fd_funk_val_max( rec );
+    FD_TEST( fd_funk_val_sz( rec )==val_sz );
+
+    /* Shrink and grow in place */
+
+    FD_TEST( fd_funk_val_truncate( rec, 8UL, alloc, wksp, &err )==rec );
+    FD_TEST( (rec->flags & FD_FUNK_REC_FLAG_SLAB) && fd_funk_val_max( rec )==val_max && fd_funk_val_sz( rec )==8UL );
+    FD_TEST( FD_LOAD( ulong, fd_funk_val( rec, wksp ) )==idx );
+    FD_TEST( fd_funk_val_truncate( rec, val_max, alloc, wksp, &err )==rec );
+    FD_TEST( (rec->flags & FD_FUNK_REC_FLAG_SLAB) && fd_funk_val_sz( rec )==val_max );
+    for( ulong off=8UL; off<val_max; off++ ) FD_TEST( !((uchar *)fd_funk_val( rec, wksp ))[ off ] );
+
+    /* Copy in place, then copy / append / truncate out of the slab */
+
+    FD_TEST( fd_funk_val_copy( rec, buf, idx % val_max, val_max, alloc, wksp, &err )==rec );
+    FD_TEST( (rec->flags & FD_FUNK_REC_FLAG_SLAB) && fd_funk_val_max( rec )==val_max );
+    FD_TEST( !memcmp( fd_funk_val_const( rec, wksp ), buf, idx % val_max ) );
+    switch( idx % 3UL ) {
+    case 0UL: FD_TEST( fd_funk_val_copy    ( rec, buf, 600UL, 0UL,              alloc, wksp, &err )==rec ); break;
+    case 1UL: FD_TEST( fd_funk_val_append  ( rec, buf + (idx % val_max), 600UL, alloc, wksp, &err )==rec ); break;
+    default:  FD_TEST( fd_funk_val_truncate( rec, 600UL + (idx % val_max),      alloc, wksp, &err )==rec ); break;
+    }
+    FD_TEST( !(rec->flags & FD_FUNK_REC_FLAG_SLAB) );
+    FD_TEST( fd_funk_val_sz( rec )>=600UL );
+    if( (idx % 3UL)!=2UL ) FD_TEST( !memcmp( fd_funk_val_const( rec, wksp ), buf, 600UL ) );
+    FD_TEST( !fd_funk_verify( funk ) );
+  }
+
+  /* Erase a few accounts and create a few small ones */
+
+  for( ulong idx=chk_cnt; idx<2UL*chk_cnt && idx<rec_cnt; idx++ ) {
+    fd_funk_rec_key_t key[1]; test_key( key, idx );
+    fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key, 0UL, NULL ); FD_TEST( rec );
+    FD_TEST( !fd_funk_rec_remove( funk, rec, 1 ) );
+    FD_TEST( !(rec->flags & FD_FUNK_REC_FLAG_SLAB) );
+  }
+  for( ulong idx=rec_cnt; idx<rec_cnt+chk_cnt; idx++ ) {
+    fd_funk_rec_key_t key[1]; test_key( key, idx );
+    fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key, 1UL + (idx % 32UL), NULL ); FD_TEST( rec );
+    FD_TEST( (rec->flags & FD_FUNK_REC_FLAG_SLAB) && fd_funk_val_max( rec )==32UL );
+  }
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  FD_TEST( fd_funk_txn_cancel( funk, txn, 0 )==1UL );
+  FD_TEST( !fd_funk_verify( funk ) );
+  test_cmp( funk, ref, rec_cnt );
+
+  txn = fd_funk_txn_prepare( funk, NULL, xid, 0 ); FD_TEST( txn );
+  for( ulong idx=0UL; idx<chk_cnt; idx++ ) {
+    fd_funk_rec_key_t key[1]; test_key( key, idx );
+    fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key, 0UL, NULL ); FD_TEST( rec );
+    FD_TEST( fd_funk_val_append( rec, buf, 600UL, alloc, wksp, NULL )==rec );
+  }
+  FD_TEST( fd_funk_txn_publish( funk, txn, 0 )==1UL );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  /* Flush the published values */
+
+  for( ulong idx=0UL; idx<rec_cnt; idx++ ) {
+    fd_funk_rec_key_t key[1]; test_key( key, idx );
+    fd_funk_rec_t * rec = fd_funk_rec_modify( funk, fd_funk_rec_query( funk, NULL, key ) ); FD_TEST( rec );
+    FD_TEST( fd_funk_val_truncate( rec, 0UL, alloc, wksp, NULL )==rec );
+  }
+  FD_TEST( !fd_funk_verify( funk ) );
+  ulong chunk_sz = 0UL;
+  for( ulong class_idx=0UL; class_idx<slab->class_cnt; class_idx++ ) {
+    FD_TEST( !slab->class[ class_idx ].used_cnt );
+    chunk_sz += slab->class[ class_idx ].chunk_cnt*FD_FUNK_VAL_SLAB_CHUNK_SZ;
+  }
+
+  /* Reconfiguring frees the chunks */
+
+  ulong used1 = test_used_sz( wksp, tag );
+  FD_TEST( !fd_funk_val_slab_config( funk, class_sz, 4UL ) );
+  FD_TEST( test_used_sz( wksp, tag )+chunk_sz<=used1 );
+  FD_TEST( !fd_funk_verify( funk ) );
+
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk ) ) );
+  fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( ref  ) ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
@@ -8,7 +8,8 @@
 
 FD_STATIC_ASSERT( FD_CHUNK_SZ==64UL, unit_test );
 
-#define RX_MAX (128UL) /* Max _reliable_ (arb unreliable) */
+#define RX_MAX    (128UL) /* Max _reliable_ (arb unreliable) */
+#define BURST_MAX ( 64UL) /* Max frags published at a time */
 
 static uchar  fctl_mem[ FD_FCTL_FOOTPRINT( RX_MAX ) ] __attribute__((aligned(FD_FCTL_ALIGN)));
 static char * _fseq[ RX_MAX ];
@@ -26,11 +27,13 @@ main( int     argc,
   ulong        tx_idx  = fd_env_strip_cmdline_ulong( &argc, &argv, "--tx-idx", NULL, 0UL                  ); /* (opt) origin */
   uint         seed    = fd_env_strip_cmdline_uint ( &argc, &argv, "--seed",   NULL, (uint)fd_tickcount() ); /* (opt) rng seed */
   int          lazy    = fd_env_strip_cmdline_int  ( &argc, &argv, "--lazy",   NULL, 7                    ); /* (opt) lazyiness */
+  ulong        pub_burst = fd_env_strip_cmdline_ulong( &argc, &argv, "--pub-burst", NULL, 1UL           ); /* (opt) frags per publish, 0 sweeps 1,2,4,...,BURST_MAX */
 
   if( FD_UNLIKELY( !_cnc                         ) ) FD_LOG_ERR(( "--cnc not specified" ));
   if( FD_UNLIKELY( !_mcache                      ) ) FD_LOG_ERR(( "--mcache not specified" ));
   if( FD_UNLIKELY( !_dcache                      ) ) FD_LOG_ERR(( "--dcache not specified" ));
   if( FD_UNLIKELY( tx_idx>=FD_FRAG_META_ORIG_MAX ) ) FD_LOG_ERR(( "--tx-idx too large" ));
+  if( FD_UNLIKELY( pub_burst>BURST_MAX           ) ) FD_LOG_ERR(( "--pub-burst too large" ));
 
   ulong rx_cnt = fd_cstr_tokenize( _fseq, RX_MAX, (char *)_fseqs, ',' ); /* Note: argv isn't const to okay to cast away const */
   if( FD_UNLIKELY( rx_cnt>RX_MAX ) ) FD_LOG_ERR(( "--rx-cnt too large for this unit-test" ));
@@ -130,16 +133,22 @@ main( int     argc,
     FD_VOLATILE( fseq_diag[ FD_FSEQ_DIAG_SLOW_CNT ] ) = 0UL;
   }
 
-  /* cr_burst is 1 because we only send at most 1 fragment metadata
-     between checking cr_avail.  We use defaults for cr_max, cr_resume
-     and cr_refill. */
-  if( FD_UNLIKELY( !fd_fctl_cfg_done( fctl, 1UL, 0UL, 0UL, 0UL ) ) ) FD_LOG_ERR(( "fd_fctl_cfg_done failed" ));
+  /* cr_burst is BURST_MAX because we send at most BURST_MAX fragment
+     metadata between checking cr_avail.  We use defaults for cr_max,
+     cr_resume and cr_refill. */
+  if( FD_UNLIKELY( !fd_fctl_cfg_done( fctl, BURST_MAX, 0UL, 0UL, 0UL ) ) ) FD_LOG_ERR(( "fd_fctl_cfg_done failed" ));
   FD_LOG_NOTICE(( "cr_burst %lu cr_max %lu cr_resume %lu cr_refill %lu",
                   fd_fctl_cr_burst( fctl ), fd_fctl_cr_max( fctl ), fd_fctl_cr_resume( fctl ), fd_fctl_cr_refill( fctl ) ));
 
   ulong cr_avail = 0UL;
 
-  FD_LOG_NOTICE(( "Running --tx-idx %lu --init %lu (%s) --lazy %i", tx_idx, seq, _init ? "manual" : "auto", lazy ));
+  FD_LOG_NOTICE(( "Running --tx-idx %lu --init %lu (%s) --lazy %i --pub-burst %lu", tx_idx, seq, _init ? "manual" : "auto", lazy,
+                  pub_burst ));
+
+  int sweep = !pub_burst;
+  if( sweep ) pub_burst = 1UL;
+
+  fd_frag_meta_t burst[ BURST_MAX ] __attribute__((aligned(FD_FRAG_META_ALIGN)));
 
   ulong async_min = 1UL << lazy;
   ulong async_rem = 1UL; /* Do housekeeping on the first iteration */
@@ -173,7 +182,7 @@ main( int     argc,
       long dt = now - then;
       if( FD_UNLIKELY( dt > (long)1e9 ) ) {
         float mfps = (1e3f*(float)iter) / (float)dt;
-        FD_LOG_NOTICE(( "%7.3f Mfrag/s tx (in_backp %lu backp_cnt %lu)", (double)mfps,
+        FD_LOG_NOTICE(( "%7.3f Mfrag/s tx (pub_burst %lu in_backp %lu backp_cnt %lu)", (double)mfps, pub_burst,
                         FD_VOLATILE_CONST( cnc_diag[ FD_CNC_DIAG_IN_BACKP  ] ),
                         FD_VOLATILE_CONST( cnc_diag[ FD_CNC_DIAG_BACKP_CNT ] ) ));
         for( ulong rx_idx=0UL; rx_idx<rx_cnt; rx_idx++ ) {
@@ -184,6 +193,7 @@ main( int     argc,
         FD_VOLATILE( cnc_diag[ FD_CNC_DIAG_BACKP_CNT ] ) = 0UL;
         then = now;
         iter = 0UL;
+        if( sweep ) pub_burst = fd_ulong_if( pub_burst<BURST_MAX, pub_burst<<1, 1UL );
       }
 
       /* Receive command-and-control signals */
@@ -210,7 +220,7 @@ main( int     argc,
     async_rem--;
 
     /* Check if we are backpressured */
-    if( FD_UNLIKELY( !cr_avail ) ) {
+    if( FD_UNLIKELY( cr_avail<pub_burst ) ) {
       if( FD_UNLIKELY( !in_backp ) ) {
         FD_VOLATILE( cnc_diag[ FD_CNC_DIAG_IN_BACKP  ] ) = 0UL;
         FD_VOLATILE( cnc_diag[ FD_CNC_DIAG_BACKP_CNT ] ) = FD_VOLATILE_CONST( cnc_diag[ FD_CNC_DIAG_BACKP_CNT ] ) + 1UL;
@@ -233,62 +243,86 @@ main( int     argc,
        complete double cache lines).  We don't care if this is written
        atomic or not. */
 
-    ulong frag_sz = fd_ulong_min( burst_rem, pkt_payload_max );
-    burst_rem -= frag_sz;
-    int ctl_eom = !burst_rem;
-    int ctl_err = 0;
-
-    ulong sig    = seq; /* Test pattern */
-  /*ulong chunk  = ... already at location where next packet will be written ...; */
-    ulong sz     = pkt_framing + frag_sz;
-    ulong ctl    = fd_frag_meta_ctl( tx_idx, ctl_som, ctl_eom, ctl_err );
-    ulong tsorig = 0UL;
-    ulong tspub  = 0UL;
-
-    uchar * p   = (uchar *)fd_chunk_to_laddr( base, chunk );
-    __m256i avx = _mm256_set1_epi64x( (long)seq );
-    for( ulong off=0UL; off<sz; off+=128UL ) {
-      _mm256_store_si256( (__m256i *)(p     ), avx );
-      _mm256_store_si256( (__m256i *)(p+32UL), avx );
-      _mm256_store_si256( (__m256i *)(p+64UL), avx );
-      _mm256_store_si256( (__m256i *)(p+96UL), avx );
-      p += 128UL;
-    }
+    ulong seq0 = seq;
+    for( ulong burst_idx=0UL; burst_idx<pub_burst; burst_idx++ ) {
+
+      ulong frag_sz = fd_ulong_min( burst_rem, pkt_payload_max );
+      burst_rem -= frag_sz;
+      int ctl_eom = !burst_rem;
+      int ctl_err = 0;
+
+      ulong sig    = seq; /* Test pattern */
+    /*ulong chunk  = ... already at location where next packet will be written ...; */
+      ulong sz     = pkt_framing + frag_sz;
+      ulong ctl    = fd_frag_meta_ctl( tx_idx, ctl_som, ctl_eom, ctl_err );
+      ulong tsorig = 0UL;
+      ulong tspub  = 0UL;
+
+      uchar * p   = (uchar *)fd_chunk_to_laddr( base, chunk );
+      __m256i avx = _mm256_set1_epi64x( (long)seq );
+      for( ulong off=0UL; off<sz; off+=128UL ) {
+        _mm256_store_si256( (__m256i *)(p     ), avx );
+        _mm256_store_si256( (__m256i *)(p+32UL), avx );
+        _mm256_store_si256( (__m256i *)(p+64UL), avx );
+        _mm256_store_si256( (__m256i *)(p+96UL), avx );
+        p += 128UL;
+      }
 
-    /* We just "finished receiving" the next fragment of the burst from
-       the "NIC".  Publish to consumers as frag seq.  This implicitly
-       unpublishes frag seq-depth (cyclic) at the same time. */
+      /* We just "finished receiving" the next fragment of the burst
+         from the "NIC".  Stage it for publication to consumers as frag
+         seq.  Publishing implicitly unpublishes frag seq-depth (cyclic)
+         at the same time. */
 
-#   define PUBLISH_STYLE 0
+#     define PUBLISH_STYLE 3
 
-#   if PUBLISH_STYLE==0 /* Incompatible with WAIT_STYLE==2 */
+#     if PUBLISH_STYLE==0 /* Incompatible with WAIT_STYLE==2 */
 
-    fd_mcache_publish( mcache, depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
+      fd_mcache_publish( mcache, depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
 
-#   elif PUBLISH_STYLE==1 /* Incompatible with WAIT_STYLE==2 */
+#     elif PUBLISH_STYLE==1 /* Incompatible with WAIT_STYLE==2 */
 
-    fd_mcache_publish_sse( mcache, depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
+      fd_mcache_publish_sse( mcache, depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
 
-#   else /* Compatible with all wait styles, requires target with atomic
-            aligned AVX load/store support */
+#     elif PUBLISH_STYLE==2 /* Compatible with all wait styles, requires target with atomic
+                              aligned AVX load/store support */
 
-    fd_mcache_publish_avx( mcache, depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
+      fd_mcache_publish_avx( mcache, depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
 
-#   endif
+#     else /* Publish the whole burst at once below, incompatible with WAIT_STYLE==2 */
 
-    /* Wind up for the next iteration */
+      fd_frag_meta_t * meta = burst + burst_idx;
+      meta->sig    =         sig;
+      meta->chunk  = (uint  )chunk;
+      meta->sz     = (ushort)sz;
+      meta->ctl    = (ushort)ctl;
+      meta->tsorig = (uint  )tsorig;
+      meta->tspub  = (uint  )tspub;
+
+#     endif
 
-    chunk = fd_dcache_compact_next( chunk, sz, chunk0, wmark );
-    seq   = fd_seq_inc( seq, 1UL );
-    cr_avail--;
-    iter++;
-#   if RANDOMIZE_BURSTS
-    if( FD_UNLIKELY( ctl_eom ) )
-      do burst_rem = (ulong)(long)(0.5f + burst_avg*fd_rng_float_exp( rng )); while( FD_UNLIKELY( !burst_rem ) );
+      /* Wind up for the next frag */
+
+      chunk = fd_dcache_compact_next( chunk, sz, chunk0, wmark );
+      seq   = fd_seq_inc( seq, 1UL );
+#     if RANDOMIZE_BURSTS
+      if( FD_UNLIKELY( ctl_eom ) )
+        do burst_rem = (ulong)(long)(0.5f + burst_avg*fd_rng_float_exp( rng )); while( FD_UNLIKELY( !burst_rem ) );
+#     else
+      burst_rem = fd_ulong_if( ctl_eom, _burst_avg, burst_rem );
+#     endif
+      ctl_som = ctl_eom;
+    }
+
+#   if PUBLISH_STYLE==3
+    fd_mcache_publish_burst( mcache, depth, seq0, burst, pub_burst );
 #   else
-    burst_rem = fd_ulong_if( ctl_eom, _burst_avg, burst_rem );
+    (void)seq0; (void)burst;
 #   endif
-    ctl_som = ctl_eom;
+
+    /* Wind up for the next iteration */
+
+    cr_avail -= pub_burst;
+    iter     += pub_burst;
   }
 
   FD_LOG_NOTICE(( "Cleaning up" ));
@@ -377,6 +377,57 @@ fd_mcache_publish_avx( fd_frag_meta_t * mcache,   /* Assumed a current local joi
 
 #endif
 
+/* fd_mcache_publish_burst inserts the metadata for the cnt frags
+   seq0,seq0+1,...,seq0+cnt-1 (cyclic) into the given depth entry
+   mcache.  burst[j] holds the metadata (sig, chunk, sz, ctl, tsorig and
+   tspub ... burst[j].seq is ignored) for frag seq0+j.  cnt is assumed
+   in [0,depth].  This is compatible with FD_MCACHE_WAIT,
+   FD_MCACHE_WAIT_SSE, FD_MCACHE_WAIT_REG and FD_MCACHE_WAIT_BURST (but
+   not FD_MCACHE_WAIT_AVX).  This operation implies a compiler mfence to
+   the caller.
+
+   This is equivalent to cnt fd_mcache_publish calls but with the per
+   frag ordering hoisted out of the loop: all the lines are marked as in
+   the process of being written (in sequence order), then all the line
+   bodies are written, then the lines are exposed to consumers by a
+   single in order sweep of sequence number stores.  As such, there are
+   only 3 ordering points per burst instead of 3 per frag and the
+   compiler is free to schedule the body writes.  Consumers will observe
+   the frags of a burst becoming available in sequence order (typically
+   in rapid succession).  Note that the metadata for frags seq0-depth
+   through seq0+cnt-1-depth (cyclic) is evicted before any of the burst
+   becomes available (see FD_MCACHE_WAIT_BURST for why this ordering
+   matters for consumer overrun detection). */
+
+static inline void
+fd_mcache_publish_burst( fd_frag_meta_t *       mcache,   /* Assumed a current local join */
+                         ulong                  depth,    /* Assumed an integer power-of-2 >= BLOCK */
+                         ulong                  seq0,
+                         fd_frag_meta_t const * burst,    /* Indexed [0,cnt) */
+                         ulong                  cnt ) {   /* Assumed in [0,depth] */
+  FD_COMPILER_MFENCE();
+  for( ulong j=0UL; j<cnt; j++ ) {
+    ulong seq = fd_seq_inc( seq0, j );
+    mcache[ fd_mcache_line_idx( seq, depth ) ].seq = fd_seq_dec( seq, 1UL );
+  }
+  FD_COMPILER_MFENCE();
+  for( ulong j=0UL; j<cnt; j++ ) {
+    fd_frag_meta_t * meta = mcache + fd_mcache_line_idx( fd_seq_inc( seq0, j ), depth );
+    meta->sig    = burst[j].sig;
+    meta->chunk  = burst[j].chunk;
+    meta->sz     = burst[j].sz;
+    meta->ctl    = burst[j].ctl;
+    meta->tsorig = burst[j].tsorig;
+    meta->tspub  = burst[j].tspub;
+  }
+  FD_COMPILER_MFENCE();
+  for( ulong j=0UL; j<cnt; j++ ) {
+    ulong seq = fd_seq_inc( seq0, j );
+    mcache[ fd_mcache_line_idx( seq, depth ) ].seq = seq;
+  }
+  FD_COMPILER_MFENCE();
+}
+
 /* FD_MCACHE_WAIT does a bounded wait for a producer to transmit a
    particular frag.
 
@@ -726,6 +777,102 @@ fd_mcache_publish_avx( fd_frag_meta_t * mcache,   /* Assumed a current local joi
 
 #endif
 
+/* FD_MCACHE_WAIT_BURST: similar to FD_MCACHE_WAIT but, instead of
+   copying out the metadata for seq_expected, it determines how many
+   consecutive frags starting at seq_expected are available such that a
+   consumer can drain them with a single overrun check at the end.
+
+   mline, seq_found, seq_diff, poll_max, mcache, depth and seq_expected
+   are as in FD_MCACHE_WAIT.  cnt_max (ulong compatible) is the maximum
+   number of frags to return and should be in [1,depth].
+
+   On completion, if the WAIT did not time out and seq_diff is zero, cnt
+   (ulong compatible) will be in [1,cnt_max] and frags seq_expected
+   through seq_expected+cnt-1 (cyclic) were all available at some point
+   during the WAIT.  Their metadata is at the mcache lines
+   mcache + fd_mcache_line_idx( seq_expected+j, depth ) for j in
+   [0,cnt) and can be read directly (e.g. field by field or with SSE /
+   AVX loads) and speculatively processed.  Otherwise, cnt will be zero
+   (and the other outputs are as described in FD_MCACHE_WAIT).
+
+   After processing the burst, the caller should check it was not
+   overrun by the producer during the processing with:
+
+     if( FD_UNLIKELY( fd_seq_ne( fd_frag_meta_seq_query( mline ), seq_expected ) ) ) ... overrun ...
+
+   That is, only the line of the first frag of the burst needs to be
+   checked.  This works because producers (both fd_mcache_publish* and
+   fd_mcache_publish_burst) publish in sequence order and always mark
+   the line of frag seq as in the process of being written before
+   touching any line for a later sequence number.  Since the line for
+   seq_expected is the first line of the burst that gets reused by the
+   producer (for seq_expected+depth), if it still holds seq_expected
+   after processing, none of the lines of the burst were clobbered
+   while they were being read (the same x86-style ordering guarantees
+   discussed in FD_MCACHE_WAIT apply).
+
+   TL;DR  Typical usage:
+
+     ulong                  cnt;
+     fd_frag_meta_t const * mline;
+     ulong                  tx_seq;
+     long                   seq_diff;
+     FD_MCACHE_WAIT_BURST( cnt, mline, tx_seq, seq_diff, poll_max, mcache, depth, rx_seq, BURST_MAX );
+     if( FD_UNLIKELY( !poll_max ) ) { ... housekeeping ...; continue; }
+     if( FD_UNLIKELY( seq_diff  ) ) { ... overrun ...;      continue; }
+     for( ulong j=0UL; j<cnt; j++ ) {
+       fd_frag_meta_t const * meta = mcache + fd_mcache_line_idx( fd_seq_inc( rx_seq, j ), depth );
+       ... speculatively process meta ...
+     }
+     if( FD_UNLIKELY( fd_seq_ne( fd_frag_meta_seq_query( mline ), rx_seq ) ) ) { ... overrun ...; continue; }
+     rx_seq = fd_seq_inc( rx_seq, cnt );
+
+   This macro is robust (e.g. it evaluates its argument a minimal number
+   of times). */
+
+#define FD_MCACHE_WAIT_BURST( cnt, mline, seq_found, seq_diff, poll_max, mcache, depth, seq_expected, cnt_max ) do {       \
+    fd_frag_meta_t const * _fd_mcache_wait_mcache       = (mcache);                                                       \
+    ulong                  _fd_mcache_wait_depth        = (depth);                                                        \
+    ulong                  _fd_mcache_wait_seq_expected = (seq_expected);                                                 \
+    ulong                  _fd_mcache_wait_cnt_max      = (cnt_max);                                                      \
+    fd_frag_meta_t const * _fd_mcache_wait_mline        = _fd_mcache_wait_mcache                                          \
+                                                        + fd_mcache_line_idx( _fd_mcache_wait_seq_expected,               \
+                                                                              _fd_mcache_wait_depth );                    \
+    ulong                  _fd_mcache_wait_seq_found;                                                                     \
+    long                   _fd_mcache_wait_seq_diff;                                                                      \
+    ulong                  _fd_mcache_wait_poll_max     = (poll_max);                                                     \
+    ulong                  _fd_mcache_wait_cnt          = 0UL;                                                            \
+    for(;;) {                                                                                                             \
+      FD_COMPILER_MFENCE();                                                                                               \
+      _fd_mcache_wait_seq_found = _fd_mcache_wait_mline->seq; /* atomic */                                                \
+      FD_COMPILER_MFENCE();                                                                                               \
+      _fd_mcache_wait_seq_diff = fd_seq_diff( _fd_mcache_wait_seq_found, _fd_mcache_wait_seq_expected );                  \
+      int _fd_mcache_wait_done = (_fd_mcache_wait_seq_diff>=0L) | (!--_fd_mcache_wait_poll_max);                          \
+      FD_COMPILER_FORGET( _fd_mcache_wait_done ); /* inhibit compiler from turning this into branch nest */               \
+      if( FD_LIKELY( _fd_mcache_wait_done ) ) break; /* opt for exit, single exit to help spin_pause cpu hinting */       \
+      FD_SPIN_PAUSE();                                                                                                    \
+    }                                                                                                                     \
+    if( FD_LIKELY( (!!_fd_mcache_wait_poll_max) & (!_fd_mcache_wait_seq_diff) ) ) {                                       \
+      _fd_mcache_wait_cnt = 1UL;                                                                                          \
+      while( _fd_mcache_wait_cnt<_fd_mcache_wait_cnt_max ) {                                                              \
+        ulong _fd_mcache_wait_seq_next = fd_seq_inc( _fd_mcache_wait_seq_expected, _fd_mcache_wait_cnt );                 \
+        fd_frag_meta_t const * _fd_mcache_wait_mnext = _fd_mcache_wait_mcache                                             \
+                                                     + fd_mcache_line_idx( _fd_mcache_wait_seq_next,                      \
+                                                                           _fd_mcache_wait_depth );                       \
+        FD_COMPILER_MFENCE();                                                                                             \
+        ulong _fd_mcache_wait_seq_test = _fd_mcache_wait_mnext->seq; /* atomic */                                         \
+        FD_COMPILER_MFENCE();                                                                                             \
+        if( FD_UNLIKELY( fd_seq_ne( _fd_mcache_wait_seq_test, _fd_mcache_wait_seq_next ) ) ) break;                       \
+        _fd_mcache_wait_cnt++;                                                                                            \
+      }                                                                                                                   \
+    }                                                                                                                     \
+    (cnt)       = _fd_mcache_wait_cnt;                                                                                    \
+    (mline)     = _fd_mcache_wait_mline;                                                                                  \
+    (seq_found) = _fd_mcache_wait_seq_found;                                                                              \
+    (seq_diff)  = _fd_mcache_wait_seq_diff;                                                                               \
+    (poll_max)  = _fd_mcache_wait_poll_max;                                                                               \
+  } while(0)
+
 /* fd_mcache_query returns seq_query if seq_query is still in the mcache
    (assumed to be a current local mcache join) with depth entries (depth
    is assumed to be an integer power of two of at least
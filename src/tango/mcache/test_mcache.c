@@ -190,6 +190,73 @@ main( int     argc,
     fd_mcache_seq_update( _seq, fd_seq_inc( next, 1UL ) );
   }
 
+  /* Test burst publish and consume.  The consumer occasionally falls
+     behind by more than depth to exercise overrun detection. */
+
+  do {
+    fd_frag_meta_t burst[ 64 ];
+    ulong tx_seq = fd_mcache_seq_query( _seq_const );
+    ulong rx_seq = tx_seq;
+
+    for( ulong iter=0UL; iter<100000UL; iter++ ) {
+      ulong cnt = fd_rng_ulong_roll( rng, 65UL );
+      for( ulong j=0UL; j<cnt; j++ ) {
+        burst[j].seq    = 0UL; /* Ignored */
+        burst[j].sig    = fd_seq_inc( tx_seq, j );
+        burst[j].chunk  = (uint  )j;
+        burst[j].sz     = (ushort)cnt;
+        burst[j].ctl    = (ushort)0;
+        burst[j].tsorig = (uint  )iter;
+        burst[j].tspub  = (uint  )~iter;
+      }
+      fd_mcache_publish_burst( mcache, depth, tx_seq, burst, cnt );
+      for( ulong j=0UL; j<cnt; j++ ) {
+        ulong                  seq  = fd_seq_inc( tx_seq, j );
+        fd_frag_meta_t const * meta = mcache + fd_mcache_line_idx( seq, depth );
+        FD_TEST( fd_seq_eq( fd_mcache_query( mcache, depth, seq ), seq ) );
+        FD_TEST( meta->sig==seq && meta->chunk==(uint)j && meta->sz==(ushort)cnt && meta->tsorig==(uint)iter );
+      }
+      FD_TEST( fd_seq_lt( fd_mcache_query( mcache, depth, fd_seq_inc( tx_seq, cnt ) ), fd_seq_inc( tx_seq, cnt ) ) );
+      tx_seq = fd_seq_inc( tx_seq, cnt );
+
+      if( fd_rng_uint_roll( rng, 64U ) ) continue; /* Consume occasionally to let the producer lap the consumer */
+
+      for(;;) {
+        ulong                  cnt_max  = 1UL + fd_rng_ulong_roll( rng, 64UL );
+        ulong                  poll_max = 3UL;
+        ulong                  rx_cnt;
+        fd_frag_meta_t const * mline;
+        ulong                  seq_found;
+        long                   seq_diff;
+        FD_MCACHE_WAIT_BURST( rx_cnt, mline, seq_found, seq_diff, poll_max, mcache, depth, rx_seq, cnt_max );
+
+        long lag = fd_seq_diff( tx_seq, rx_seq );
+        if( !lag ) { /* Caught up, wait should time out */
+          FD_TEST( !poll_max && !rx_cnt );
+          break;
+        }
+        FD_TEST( poll_max==2UL );
+        FD_TEST( mline==mcache + fd_mcache_line_idx( rx_seq, depth ) );
+        if( lag>(long)depth ) { /* Overrun */
+          FD_TEST( seq_diff>0L && !rx_cnt );
+          FD_TEST( fd_seq_diff( seq_found, rx_seq )==seq_diff );
+          rx_seq = fd_seq_dec( tx_seq, fd_rng_ulong_roll( rng, depth+1UL ) );
+          continue;
+        }
+        FD_TEST( !seq_diff && fd_seq_eq( seq_found, rx_seq ) );
+        FD_TEST( rx_cnt==fd_ulong_min( cnt_max, (ulong)lag ) );
+        for( ulong j=0UL; j<rx_cnt; j++ ) {
+          ulong seq = fd_seq_inc( rx_seq, j );
+          FD_TEST( mcache[ fd_mcache_line_idx( seq, depth ) ].sig==seq );
+        }
+        FD_TEST( fd_seq_eq( fd_frag_meta_seq_query( mline ), rx_seq ) );
+        rx_seq = fd_seq_inc( rx_seq, rx_cnt );
+      }
+    }
+
+    fd_mcache_seq_update( _seq, tx_seq );
+  } while(0);
+
   /* Test mcache for corruption */
 
   FD_TEST( fd_mcache_depth          ( mcache )==depth      );
@@ -40,7 +40,8 @@ fd_quic_crypto_ctx_init( fd_quic_crypto_ctx_t * ctx ) {
   ctx->suites[ ID ].pkt_cipher = ctx->CIPHER_##PKT;        \
   ctx->suites[ ID ].hp_cipher  = ctx->CIPHER_##HP;         \
   ctx->suites[ ID ].hmac_fn    = fd_hmac_##HASHFN;         \
-  ctx->suites[ ID ].hash_sz    = FD_QUIC_HASH_SZ_##HASHFN;
+  ctx->suites[ ID ].hash_sz    = FD_QUIC_HASH_SZ_##HASHFN;  \
+  ctx->suites[ ID ].native     = FD_HAS_AESNI && FD_QUIC_CRYPTO_NATIVE_##PKT;
   FD_QUIC_CRYPTO_SUITE_LIST( EACH, )
 #undef EACH
 }
@@ -321,6 +322,13 @@ fd_quic_gen_keys(
   }
   keys->iv_sz = iv_sz;
 
+  if( suite->native ) {
+    if( FD_UNLIKELY( !fd_aes_gcm_init( keys->pkt_gcm, keys->pkt_key, key_sz ) ||
+                     !fd_aes_key_init( keys->hp_aes,  keys->hp_key,  key_sz ) ) ) {
+      return FD_QUIC_FAILED;
+    }
+  }
+
   /* initialize the cipher context */
   EVP_CIPHER_CTX * pkt_cipher_ctx = EVP_CIPHER_CTX_new();
   if( FD_UNLIKELY( !pkt_cipher_ctx ) ) {
@@ -400,6 +408,10 @@ fd_quic_gen_new_keys(
   }
   keys->iv_sz = iv_sz;
 
+  if( suite->native ) {
+    if( FD_UNLIKELY( !fd_aes_gcm_init( keys->pkt_gcm, keys->pkt_key, key_sz ) ) ) return FD_QUIC_FAILED;
+  }
+
   /* initialize the cipher context */
   EVP_CIPHER_CTX * pkt_cipher_ctx = EVP_CIPHER_CTX_new();
   if( FD_UNLIKELY( !pkt_cipher_ctx ) ) {
@@ -421,6 +433,77 @@ fd_quic_gen_new_keys(
 }
 
 
+/* fd_quic_crypto_hp_mask computes the header protection mask of the
+   FD_QUIC_HP_SAMPLE_SZ byte sample into mask (FD_QUIC_CRYPTO_BLOCK_BOUND
+   bytes) */
+
+static int
+fd_quic_crypto_hp_mask( fd_quic_crypto_suite_t * suite,
+                        fd_quic_crypto_keys_t *  keys,
+                        uchar const *            sample,
+                        uchar *                  mask ) {
+  if( suite->native ) {
+    fd_aes_encrypt_block( keys->hp_aes, mask, sample );
+    return FD_QUIC_SUCCESS;
+  }
+
+  EVP_CIPHER_CTX * hp_cipher_ctx = keys->hp_cipher_ctx;
+  if( FD_UNLIKELY( !hp_cipher_ctx ) ) {
+    FD_LOG_ERR(( "fd_quic_crypto_hp_mask: no hp cipher ctx" ));
+    return FD_QUIC_FAILED;
+  }
+
+  if( FD_UNLIKELY( EVP_CIPHER_block_size( suite->hp_cipher ) > FD_QUIC_CRYPTO_BLOCK_BOUND ) ) {
+    FD_LOG_ERR(( "fd_quic_crypto_hp_mask failed. HP cipher block size too big" ));
+  }
+
+  int hp_cipher_sz = 0;
+  if( FD_UNLIKELY( EVP_EncryptUpdate( hp_cipher_ctx, mask, &hp_cipher_sz, sample, FD_QUIC_HP_SAMPLE_SZ ) != 1 ) ) {
+    FD_LOG_ERR(( "fd_quic_crypto_hp_mask: EVP_EncryptUpdate failed cipher (hp)" ));
+  }
+
+  return FD_QUIC_SUCCESS;
+}
+
+/* native masks are gathered and computed in groups of at most
+   FD_QUIC_CRYPTO_HP_BATCH_MAX */
+
+#define FD_QUIC_CRYPTO_HP_BATCH_MAX (32UL)
+
+int
+fd_quic_crypto_hp_mask_batch(
+    fd_quic_crypto_suite_t * const * suite,
+    fd_quic_crypto_keys_t  * const * keys,
+    uchar const *            const * sample,
+    uchar *                  const * mask,
+    ulong                            cnt ) {
+  fd_aes_key_t const * batch_key   [ FD_QUIC_CRYPTO_HP_BATCH_MAX ];
+  void const *         batch_sample[ FD_QUIC_CRYPTO_HP_BATCH_MAX ];
+  void *               batch_mask  [ FD_QUIC_CRYPTO_HP_BATCH_MAX ];
+  ulong                batch_cnt = 0UL;
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    if( FD_LIKELY( suite[i]->native ) ) {
+      batch_key   [ batch_cnt ] = keys[i]->hp_aes;
+      batch_sample[ batch_cnt ] = sample[i];
+      batch_mask  [ batch_cnt ] = mask[i];
+      batch_cnt++;
+      if( FD_UNLIKELY( batch_cnt==FD_QUIC_CRYPTO_HP_BATCH_MAX ) ) {
+        fd_aes_ecb_encrypt_batch( batch_key, batch_sample, batch_mask, batch_cnt );
+        batch_cnt = 0UL;
+      }
+    } else {
+      uchar hp_cipher[ FD_QUIC_CRYPTO_BLOCK_BOUND ];
+      if( FD_UNLIKELY( fd_quic_crypto_hp_mask( suite[i], keys[i], sample[i], hp_cipher ) != FD_QUIC_SUCCESS ) ) return FD_QUIC_FAILED;
+      fd_memcpy( mask[i], hp_cipher, FD_QUIC_HP_SAMPLE_SZ );
+    }
+  }
+
+  if( batch_cnt ) fd_aes_ecb_encrypt_batch( batch_key, batch_sample, batch_mask, batch_cnt );
+
+  return FD_QUIC_SUCCESS;
+}
+
 /* encrypt a packet
 
    uses the keys in keys to encrypt the packet "pkt" with header "hdr"
@@ -494,12 +577,6 @@ fd_quic_crypto_encrypt(
   ulong pkt_number_sz = ( first & 0x03u ) + 1;
   uchar const * pkt_number = out + hdr_sz - pkt_number_sz;
 
-  EVP_CIPHER_CTX * pkt_cipher_ctx = pkt_keys->pkt_cipher_ctx;
-  if( FD_UNLIKELY( !pkt_cipher_ctx ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_encrypt: no cipher ctx" ));
-    return FD_QUIC_FAILED;
-  }
-
   // nonce is quic-iv XORed with packet-number
   // packet number is 1-4 bytes, so only XOR last pkt_number_sz bytes
   uchar nonce[FD_QUIC_NONCE_SZ] = {0};
@@ -511,64 +588,80 @@ fd_quic_crypto_encrypt(
     nonce[j] = quic_iv[j] ^ pkt_number[k];
   }
 
-  // Initial packets cipher uses AEAD_AES_128_GCM with keys derived from the Destination Connection ID field of the
-  // first Initial packet sent by the client; see rfc9001 Section 5.2.
+  /* cipher_text is start of encrypted packet bytes, which starts after the header */
+  uchar * cipher_text = out + hdr_sz;
+  ulong offset = 0;
 
-  if( FD_UNLIKELY( EVP_EncryptInit_ex( pkt_cipher_ctx, suite->pkt_cipher, NULL, pkt_keys->pkt_key, nonce ) != 1 ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_EncryptInit_ex failed" ));
-  }
+  if( suite->native ) {
 
-  /* auth data added with NULL output - still require out length */
-  int tmp = 0;
-  if( FD_UNLIKELY( EVP_EncryptUpdate( pkt_cipher_ctx, NULL, &tmp, hdr, (int)hdr_sz ) != 1 ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_EncryptUpdate failed auth_data" ));
-  }
-
-  /* EVP_EncryptUpdate requires "cipher_text" to point to a buffer large enough to contain
-     the cipher text.
-     The man page for EVP_EncryptUpdate says this about the size required:
-         EVP_EncryptUpdate() encrypts inl bytes from the buffer in and
-         writes the encrypted version to out. This function can be
-         called multiple times to encrypt successive blocks of data.
-         The amount of data written depends on the block alignment of
-         the encrypted data.  For most ciphers and modes, the amount
-         of data written can be anything from zero bytes to
-         (inl + cipher_block_size - 1) bytes.  For wrap cipher modes,
-         the amount of data written can be anything from zero bytes to
-         (inl + cipher_block_size) bytes.  For stream ciphers, the
-         amount of data written can be anything from zero bytes to inl
-         bytes.  Thus, out should contain sufficient room for the
-         operation being performed.  The actual number of bytes
-         written is placed in out_sz. It also checks if in and out are
-         partially overlapping, and if they are 0 is returned to
-         indicate failure.
-
-     I read this to mean the following should be enough for every cipher type:
-         pkt_sz + EVP_CIPHER_block_size( cipher_ctx )
+    fd_aes_gcm_encrypt( pkt_keys->pkt_gcm, cipher_text, pkt, pkt_sz, nonce, hdr, hdr_sz, cipher_text + pkt_sz );
+    offset = pkt_sz + FD_QUIC_CRYPTO_TAG_SZ;
 
-     */
+  } else {
 
-  /* cipher_text is start of encrypted packet bytes, which starts after the header */
-  uchar * cipher_text = out + hdr_sz;
-  ulong offset = 0;
-  int cipher_text_sz = 0;
-  if( FD_UNLIKELY( EVP_EncryptUpdate( pkt_cipher_ctx, cipher_text, &cipher_text_sz, pkt, (int)pkt_sz ) != 1 ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_EncryptUpdate failed" ));
-  }
+    EVP_CIPHER_CTX * pkt_cipher_ctx = pkt_keys->pkt_cipher_ctx;
+    if( FD_UNLIKELY( !pkt_cipher_ctx ) ) {
+      FD_LOG_ERR(( "fd_quic_crypto_encrypt: no cipher ctx" ));
+      return FD_QUIC_FAILED;
+    }
 
-  offset = (ulong)cipher_text_sz;
-  if( FD_UNLIKELY( EVP_EncryptFinal( pkt_cipher_ctx, cipher_text + offset, &cipher_text_sz ) != 1 ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_EncryptFinal failed" ));
-  }
+    // Initial packets cipher uses AEAD_AES_128_GCM with keys derived from the Destination Connection ID field of the
+    // first Initial packet sent by the client; see rfc9001 Section 5.2.
 
-  offset += (ulong)cipher_text_sz;
+    if( FD_UNLIKELY( EVP_EncryptInit_ex( pkt_cipher_ctx, suite->pkt_cipher, NULL, pkt_keys->pkt_key, nonce ) != 1 ) ) {
+      FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_EncryptInit_ex failed" ));
+    }
 
-  if( FD_UNLIKELY( EVP_CIPHER_CTX_ctrl( pkt_cipher_ctx, EVP_CTRL_AEAD_GET_TAG, FD_QUIC_CRYPTO_TAG_SZ, cipher_text + offset ) != 1 ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_CTRL_AEAD_GET_TAG failed" ));
-    return FD_QUIC_FAILED;
-  }
+    /* auth data added with NULL output - still require out length */
+    int tmp = 0;
+    if( FD_UNLIKELY( EVP_EncryptUpdate( pkt_cipher_ctx, NULL, &tmp, hdr, (int)hdr_sz ) != 1 ) ) {
+      FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_EncryptUpdate failed auth_data" ));
+    }
+
+    /* EVP_EncryptUpdate requires "cipher_text" to point to a buffer large enough to contain
+       the cipher text.
+       The man page for EVP_EncryptUpdate says this about the size required:
+           EVP_EncryptUpdate() encrypts inl bytes from the buffer in and
+           writes the encrypted version to out. This function can be
+           called multiple times to encrypt successive blocks of data.
+           The amount of data written depends on the block alignment of
+           the encrypted data.  For most ciphers and modes, the amount
+           of data written can be anything from zero bytes to
+           (inl + cipher_block_size - 1) bytes.  For wrap cipher modes,
+           the amount of data written can be anything from zero bytes to
+           (inl + cipher_block_size) bytes.  For stream ciphers, the
+           amount of data written can be anything from zero bytes to inl
+           bytes.  Thus, out should contain sufficient room for the
+           operation being performed.  The actual number of bytes
+           written is placed in out_sz. It also checks if in and out are
+           partially overlapping, and if they are 0 is returned to
+           indicate failure.
+
+       I read this to mean the following should be enough for every cipher type:
+           pkt_sz + EVP_CIPHER_block_size( cipher_ctx )
+
+       */
+
+    int cipher_text_sz = 0;
+    if( FD_UNLIKELY( EVP_EncryptUpdate( pkt_cipher_ctx, cipher_text, &cipher_text_sz, pkt, (int)pkt_sz ) != 1 ) ) {
+      FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_EncryptUpdate failed" ));
+    }
+
+    offset = (ulong)cipher_text_sz;
+    if( FD_UNLIKELY( EVP_EncryptFinal( pkt_cipher_ctx, cipher_text + offset, &cipher_text_sz ) != 1 ) ) {
+      FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_EncryptFinal failed" ));
+    }
+
+    offset += (ulong)cipher_text_sz;
+
+    if( FD_UNLIKELY( EVP_CIPHER_CTX_ctrl( pkt_cipher_ctx, EVP_CTRL_AEAD_GET_TAG, FD_QUIC_CRYPTO_TAG_SZ, cipher_text + offset ) != 1 ) ) {
+      FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_CTRL_AEAD_GET_TAG failed" ));
+      return FD_QUIC_FAILED;
+    }
 
-  offset += FD_QUIC_CRYPTO_TAG_SZ;
+    offset += FD_QUIC_CRYPTO_TAG_SZ;
+
+  }
 
   ulong enc_pkt_sz = offset; /* encrypted packet size, including tag */
 
@@ -576,23 +669,13 @@ fd_quic_crypto_encrypt(
 
   /* Header protection */
 
-  EVP_CIPHER_CTX * hp_cipher_ctx = hp_keys->hp_cipher_ctx;
-  if( FD_UNLIKELY( !hp_cipher_ctx ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_encrypt: no hp cipher ctx" ));
-    return FD_QUIC_FAILED;
-  }
-
   /* sample start is defined as 4 bytes after the start of the packet number
      so shorter packet numbers means sample starts later in the cipher text */
   uchar const * sample = pkt_number + 4;
 
   uchar hp_cipher[FD_QUIC_CRYPTO_BLOCK_BOUND] = {0};
-  if( FD_UNLIKELY( EVP_CIPHER_block_size( suite->hp_cipher ) > FD_QUIC_CRYPTO_BLOCK_BOUND ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_encrypt failed. HP cipher block size too big" ));
-  }
-  int hp_cipher_sz = 0;
-  if( FD_UNLIKELY( EVP_EncryptUpdate( hp_cipher_ctx, hp_cipher, &hp_cipher_sz, sample, FD_QUIC_HP_SAMPLE_SZ ) != 1 ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_encrypt: EVP_EncryptUpdate failed cipher (hp)" ));
+  if( FD_UNLIKELY( fd_quic_crypto_hp_mask( suite, hp_keys, sample, hp_cipher ) != FD_QUIC_SUCCESS ) ) {
+    return FD_QUIC_FAILED;
   }
 
   /* hp_cipher is mask */
@@ -670,6 +753,21 @@ fd_quic_crypto_decrypt(
     nonce[j] = (uchar)(quic_iv[j] ^ (uchar)( pkt_number >> ( (3u - k) * 8u ) ));
   }
 
+  if( suite->native ) {
+    if( FD_UNLIKELY( cipher_text_sz < hdr_sz + FD_QUIC_CRYPTO_TAG_SZ ) ) return FD_QUIC_FAILED;
+
+    ulong         payload_sz = cipher_text_sz - hdr_sz - FD_QUIC_CRYPTO_TAG_SZ;
+    uchar const * tag        = cipher_text + cipher_text_sz - FD_QUIC_CRYPTO_TAG_SZ;
+    if( FD_UNLIKELY( !fd_aes_gcm_decrypt( keys->pkt_gcm, plain_text + hdr_sz, cipher_text + hdr_sz, payload_sz,
+                                          nonce, hdr, hdr_sz, tag ) ) ) {
+      FD_DEBUG( FD_LOG_WARNING( ( "fd_quic_crypto_decrypt: authentication failed" ) ) );
+      return FD_QUIC_FAILED;
+    }
+
+    *plain_text_sz = payload_sz + hdr_sz;
+    return FD_QUIC_SUCCESS;
+  }
+
   EVP_CIPHER_CTX * cipher_ctx = keys->pkt_cipher_ctx;
   if( FD_UNLIKELY( !cipher_ctx ) ) {
     FD_LOG_ERR(( "fd_quic_crypto_decrypt: Error creating cipher ctx" ));
@@ -740,6 +838,32 @@ fd_quic_crypto_decrypt_hdr(
     fd_quic_crypto_suite_t * suite,
     fd_quic_crypto_keys_t *  keys ) {
 
+  ulong         sample_off = pkt_number_off + 4;
+  uchar const * sample     = cipher_text + sample_off;
+
+  if( FD_UNLIKELY( sample + FD_QUIC_HP_SAMPLE_SZ > cipher_text + cipher_text_sz ) ) {
+    FD_DEBUG( FD_LOG_WARNING( ( "fd_quic_crypto_decrypt: not enough bytes for a sample" ) ) );
+    return FD_QUIC_FAILED;
+  }
+
+  uchar hp_cipher[ FD_QUIC_CRYPTO_BLOCK_BOUND ] = {0};
+  if( FD_UNLIKELY( fd_quic_crypto_hp_mask( suite, keys, sample, hp_cipher ) != FD_QUIC_SUCCESS ) ) {
+    return FD_QUIC_FAILED;
+  }
+
+  return fd_quic_crypto_decrypt_hdr_mask( plain_text, plain_text_sz, cipher_text, cipher_text_sz, pkt_number_off, hp_cipher );
+}
+
+
+int
+fd_quic_crypto_decrypt_hdr_mask(
+    uchar *                  plain_text,
+    ulong *                  plain_text_sz,
+    uchar const *            cipher_text,
+    ulong                    cipher_text_sz,
+    ulong                    pkt_number_off,
+    uchar const *            mask ) {
+
   /* must have at least a short header */
   if( FD_UNLIKELY( cipher_text_sz < FD_QUIC_CRYPTO_TAG_SZ ) ) {
     FD_DEBUG( FD_LOG_WARNING( ( "fd_quic_crypto_decrypt: cipher text too small" ) ) );
@@ -755,26 +879,6 @@ fd_quic_crypto_decrypt_hdr(
   uint          first      = cipher_text[0]; /* first byte */
   uint          long_hdr   = first & 0x80u;  /* long header? (this bit is not encrypted) */
   ulong         sample_off = pkt_number_off + 4;
-  uchar const * sample     = cipher_text + sample_off;
-
-  EVP_CIPHER_CTX * hp_cipher_ctx = keys->hp_cipher_ctx;
-  if( FD_UNLIKELY( !hp_cipher_ctx ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_decrypt: Error creating cipher ctx" ));
-  }
-
-  uchar hp_cipher[ FD_QUIC_CRYPTO_BLOCK_BOUND ] = {0};
-  if( FD_UNLIKELY( EVP_CIPHER_block_size( suite->hp_cipher ) > FD_QUIC_CRYPTO_BLOCK_BOUND ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_decrypt failed. HP cipher block size too big" ));
-  }
-
-  if( FD_UNLIKELY( sample + FD_QUIC_HP_SAMPLE_SZ > cipher_text + cipher_text_sz ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_decrypt failed. Not enough bytes for a sample" ));
-  }
-
-  int hp_cipher_sz = 0;
-  if( FD_UNLIKELY( EVP_EncryptUpdate( hp_cipher_ctx, hp_cipher, &hp_cipher_sz, sample, FD_QUIC_HP_SAMPLE_SZ ) != 1 ) ) {
-    FD_LOG_ERR(( "fd_quic_crypto_decrypt: EVP_EncryptUpdate failed cipher (hp)" ));
-  }
 
   /* copy header, up to packet number, into output */
   if( sample_off > *plain_text_sz ) {
@@ -782,9 +886,6 @@ fd_quic_crypto_decrypt_hdr(
   }
   fd_memcpy( plain_text, cipher_text, sample_off );
 
-  /* hp_cipher is mask */
-  uchar const * mask = hp_cipher;
-
   /* undo first byte mask */
   first        ^= (uint)mask[0] & ( long_hdr ? 0x0fu : 0x1fu );
   plain_text[0] = (uchar)first;
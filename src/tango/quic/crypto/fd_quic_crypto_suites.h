@@ -5,6 +5,7 @@
 #include "../fd_quic_common.h"
 #include "../fd_quic_conn_id.h"
 #include "../../../ballet/hmac/fd_hmac.h"
+#include "../../../ballet/aes/fd_aes.h"
 
 /* Defines the crypto suites used by QUIC v1.
 
@@ -40,6 +41,16 @@
   X( 3, TLS_CHACHA20_POLY1305_SHA256,  0x13,  0x03,  CHACHA20_POLY1305, CHACHA20,    sha256, 32,     12, __VA_ARGS__ ) \
 
 
+/* FD_QUIC_CRYPTO_NATIVE_{cipher} is 1 if the cipher can be computed
+   natively by fd_aes instead of OpenSSL.  Suites whose packet cipher is
+   native use fd_aes for both packet and header protection on targets
+   with FD_HAS_AESNI (the portable fd_aes is not constant time). */
+
+#define FD_QUIC_CRYPTO_NATIVE_AES_128_GCM       1
+#define FD_QUIC_CRYPTO_NATIVE_AES_256_GCM       1
+#define FD_QUIC_CRYPTO_NATIVE_AES_128_CCM       0
+#define FD_QUIC_CRYPTO_NATIVE_CHACHA20_POLY1305 0
+
 #define FD_QUIC_ENC_LEVEL_LIST( X, ... ) \
   X( 0, initial,    ssl_encryption_initial,     __VA_ARGS__ ) \
   X( 1, early_data, ssl_encryption_early_data,  __VA_ARGS__ ) \
@@ -74,6 +85,8 @@ struct fd_quic_crypto_suite {
   EVP_CIPHER const * hp_cipher;   /* not owned */
   fd_hmac_fn_t       hmac_fn;     /* not owned */
   ulong              hash_sz;
+
+  int                native;      /* packet and header protection use fd_aes */
 };
 
 struct fd_quic_crypto_keys {
@@ -90,6 +103,10 @@ struct fd_quic_crypto_keys {
 
   EVP_CIPHER_CTX * pkt_cipher_ctx;
   EVP_CIPHER_CTX * hp_cipher_ctx;
+
+  /* expanded keys for suites with native set */
+  fd_aes_gcm_t pkt_gcm[1];
+  fd_aes_key_t hp_aes[1];
 };
 
 /* crypto context */
@@ -491,6 +508,42 @@ fd_quic_crypto_decrypt_hdr(
     fd_quic_crypto_keys_t *  keys );
 
 
+/* fd_quic_crypto_hp_mask_batch computes the header protection masks of
+   cnt received packets at once, packet i protected with suite[i] and
+   keys[i].  sample[i] points to the FD_QUIC_HP_SAMPLE_SZ byte sample of
+   packet i (starting 4 bytes after its packet number offset) and
+   mask[i] to FD_QUIC_HP_SAMPLE_SZ bytes of memory receiving its mask.
+   Masks of packets with native suites are computed in batches with
+   fd_aes_ecb_encrypt_batch (such that the block cipher latency is
+   amortized across the burst), others one at a time with OpenSSL.
+
+   returns
+     FD_QUIC_SUCCESS   if the operation succeeded
+     FD_QUIC_FAILED    otherwise */
+
+int
+fd_quic_crypto_hp_mask_batch(
+    fd_quic_crypto_suite_t * const * suite,
+    fd_quic_crypto_keys_t  * const * keys,
+    uchar const *            const * sample,
+    uchar *                  const * mask,
+    ulong                            cnt );
+
+
+/* fd_quic_crypto_decrypt_hdr_mask removes header protection like
+   fd_quic_crypto_decrypt_hdr, given the header protection mask of the
+   packet (e.g. computed by fd_quic_crypto_hp_mask_batch). */
+
+int
+fd_quic_crypto_decrypt_hdr_mask(
+    uchar *                  plain_text,
+    ulong *                  plain_text_sz,
+    uchar const *            cipher_text,
+    ulong                    cipher_text_sz,
+    ulong                    pkt_number_off,
+    uchar const *            mask );
+
+
 /* look up crypto suite by major/minor
 
    return
@@ -1961,8 +1961,17 @@ fd_quic_handle_v1_zero_rtt( fd_quic_t * quic, fd_quic_conn_t * conn, fd_quic_pkt
   return 0;
 }
 
+/* handle a one_rtt packet
+   hp_mask, if non-NULL, points to the FD_QUIC_HP_SAMPLE_SZ byte header
+   protection mask of this packet already computed by the caller (see
+   fd_quic_process_burst).  Otherwise, the mask is computed here. */
 ulong
-fd_quic_handle_v1_one_rtt( fd_quic_t * quic, fd_quic_conn_t * conn, fd_quic_pkt_t * pkt, uchar const * cur_ptr, ulong cur_sz ) {
+fd_quic_handle_v1_one_rtt( fd_quic_t *      quic,
+                           fd_quic_conn_t * conn,
+                           fd_quic_pkt_t *  pkt,
+                           uchar const *    cur_ptr,
+                           ulong            cur_sz,
+                           uchar const *    hp_mask ) {
   if( !conn ) {
     /* this can happen */
     return FD_QUIC_PARSE_FAIL;
@@ -2052,11 +2061,16 @@ fd_quic_handle_v1_one_rtt( fd_quic_t * quic, fd_quic_conn_t * conn, fd_quic_pkt_
     /* this decrypts the header */
     int server = conn->server;
 
-    if( fd_quic_crypto_decrypt_hdr( dec_hdr, &dec_hdr_sz,
-                                    cur_ptr, cur_sz,
-                                    pn_offset,
-                                    suite,
-                                    &conn->keys[enc_level][!server] ) != FD_QUIC_SUCCESS ) {
+    int hdr_rc = hp_mask ? fd_quic_crypto_decrypt_hdr_mask( dec_hdr, &dec_hdr_sz,
+                                                            cur_ptr, cur_sz,
+                                                            pn_offset,
+                                                            hp_mask )
+                         : fd_quic_crypto_decrypt_hdr( dec_hdr, &dec_hdr_sz,
+                                                       cur_ptr, cur_sz,
+                                                       pn_offset,
+                                                       suite,
+                                                       &conn->keys[enc_level][!server] );
+    if( hdr_rc != FD_QUIC_SUCCESS ) {
       /* remove connection from map, and insert into free list */
       FD_DEBUG( FD_LOG_DEBUG(( "fd_quic_crypto_decrypt_hdr failed" )) );
       quic->metrics.conn_err_tls_fail_cnt++;
@@ -2287,6 +2301,20 @@ fd_quic_reschedule_conn( fd_quic_conn_t * conn,
 }
 
 
+/* fd_quic_ack_reschedule_conn reschedules conn service such that the
+   ack queued for tx at ack_time gets sent.  While a receive burst is
+   processing conn, only the earliest ack time is recorded, and the
+   conn is rescheduled once at the end of the burst. */
+static inline void
+fd_quic_ack_reschedule_conn( fd_quic_conn_t * conn,
+                             ulong            ack_time ) {
+  if( conn->rx_burst ) {
+    conn->rx_burst_ack_time = fd_ulong_min( conn->rx_burst_ack_time, ack_time );
+    return;
+  }
+  fd_quic_reschedule_conn( conn, ack_time );
+}
+
 /* generate acks and add to queue for future tx */
 void
 fd_quic_ack_pkt( fd_quic_t * quic, fd_quic_conn_t * conn, fd_quic_pkt_t * pkt ) {
@@ -2363,7 +2391,7 @@ fd_quic_ack_pkt( fd_quic_t * quic, fd_quic_conn_t * conn, fd_quic_pkt_t * pkt )
       ack_time = tail_ack->tx_time;
     }
 
-    fd_quic_reschedule_conn( conn, ack_time );
+    fd_quic_ack_reschedule_conn( conn, ack_time );
 
     /* promote to mandatory, if necessary */
     tail_ack->flags = (uchar)( tail_ack->flags | ( ack_mandatory ? FD_QUIC_ACK_FLAGS_MANDATORY : 0 ) );
@@ -2455,7 +2483,7 @@ fd_quic_ack_pkt( fd_quic_t * quic, fd_quic_conn_t * conn, fd_quic_pkt_t * pkt )
     *acks_tx_end         = ack;
   }
 
-  fd_quic_reschedule_conn( conn, ack_time );
+  fd_quic_ack_reschedule_conn( conn, ack_time );
 
 }
 
@@ -2550,7 +2578,7 @@ fd_quic_process_quic_packet_v1( fd_quic_t *     quic,
 
     conn = entry->conn;
 
-    rc = fd_quic_handle_v1_one_rtt( quic, conn, pkt, cur_ptr, cur_sz );
+    rc = fd_quic_handle_v1_one_rtt( quic, conn, pkt, cur_ptr, cur_sz, NULL );
     if( rc == FD_QUIC_PARSE_FAIL ) return FD_QUIC_PARSE_FAIL;
   }
 
@@ -2566,16 +2594,15 @@ fd_quic_process_quic_packet_v1( fd_quic_t *     quic,
 }
 
 
-void
-fd_quic_process_packet( fd_quic_t *   quic,
-                        uchar const * data,
-                        ulong         data_sz ) {
-
-  fd_quic_state_t * state = fd_quic_get_state( quic );
-
-  ulong rc = 0;
+/* fd_quic_decode_net_hdrs decodes the eth, ip4 and udp headers of the
+   data_sz byte datagram at data into pkt.  Returns the number of header
+   bytes (i.e. the offset of the udp payload) or FD_QUIC_PARSE_FAIL if
+   the datagram should be discarded. */
+static ulong
+fd_quic_decode_net_hdrs( fd_quic_pkt_t * pkt,
+                         uchar const *   data,
+                         ulong           data_sz ) {
 
-  /* holds the remainder of the packet*/
   uchar const * cur_ptr = data;
   ulong         cur_sz  = data_sz;
 
@@ -2583,49 +2610,73 @@ fd_quic_process_packet( fd_quic_t *   quic,
     /* sanity check */
     FD_LOG_WARNING(( "unreasonably large packet received (%lu). Discarding",
                          (ulong)data_sz ));
-    return;
+    return FD_QUIC_PARSE_FAIL;
   }
 
-  fd_quic_pkt_t pkt = { .datagram_sz = (uint)data_sz };
-
-  pkt.rcv_time = fd_quic_now( quic );
-
-  /* parse eth, ip, udp */
-  rc = fd_quic_decode_eth( pkt.eth, cur_ptr, cur_sz );
+  ulong rc = fd_quic_decode_eth( pkt->eth, cur_ptr, cur_sz );
   if( rc == FD_QUIC_PARSE_FAIL ) {
     /* TODO count failure, log-debug failure */
-    return;
+    return FD_QUIC_PARSE_FAIL;
   }
 
   /* TODO support for vlan? */
 
-  if( pkt.eth->net_type != FD_ETH_HDR_TYPE_IP ) {
-    FD_DEBUG( FD_LOG_DEBUG(( "Invalid ethertype: %4.4x", pkt.eth->net_type )) );
-    return;
+  if( pkt->eth->net_type != FD_ETH_HDR_TYPE_IP ) {
+    FD_DEBUG( FD_LOG_DEBUG(( "Invalid ethertype: %4.4x", pkt->eth->net_type )) );
+    return FD_QUIC_PARSE_FAIL;
   }
 
   /* update pointer + size */
   cur_ptr += rc;
   cur_sz  -= rc;
 
-  rc = fd_quic_decode_ip4( pkt.ip4, cur_ptr, cur_sz );
+  rc = fd_quic_decode_ip4( pkt->ip4, cur_ptr, cur_sz );
   if( rc == FD_QUIC_PARSE_FAIL ) {
     /* TODO count failure, log-debug failure */
-    return;
+    return FD_QUIC_PARSE_FAIL;
   }
 
   /* check version, tot_len, protocol, checksum? */
-  if( ( pkt.ip4->protocol != FD_IP4_HDR_PROTOCOL_UDP ) ) {
-    return;
+  if( ( pkt->ip4->protocol != FD_IP4_HDR_PROTOCOL_UDP ) ) {
+    return FD_QUIC_PARSE_FAIL;
   }
 
   /* update pointer + size */
   cur_ptr += rc;
   cur_sz  -= rc;
 
-  rc = fd_quic_decode_udp( pkt.udp, cur_ptr, cur_sz );
+  rc = fd_quic_decode_udp( pkt->udp, cur_ptr, cur_sz );
   if( rc == FD_QUIC_PARSE_FAIL ) {
     /* TODO count failure, log-debug failure */
+    return FD_QUIC_PARSE_FAIL;
+  }
+
+  /* update pointer + size */
+  cur_ptr += rc;
+
+  return (ulong)( cur_ptr - data );
+}
+
+void
+fd_quic_process_packet( fd_quic_t *   quic,
+                        uchar const * data,
+                        ulong         data_sz ) {
+
+  fd_quic_state_t * state = fd_quic_get_state( quic );
+
+  ulong rc = 0;
+
+  /* holds the remainder of the packet*/
+  uchar const * cur_ptr = data;
+  ulong         cur_sz  = data_sz;
+
+  fd_quic_pkt_t pkt = { .datagram_sz = (uint)data_sz };
+
+  pkt.rcv_time = fd_quic_now( quic );
+
+  /* parse eth, ip, udp */
+  rc = fd_quic_decode_net_hdrs( &pkt, cur_ptr, cur_sz );
+  if( rc == FD_QUIC_PARSE_FAIL ) {
     return;
   }
 
@@ -2747,13 +2798,206 @@ fd_quic_process_packet( fd_quic_t *   quic,
 
 #if 0
     fd_quic_conn_t * conn  = entry->conn;
-    (void)fd_quic_handle_v1_one_rtt( quic, conn, &pkt, cur_ptr, cur_sz );
+    (void)fd_quic_handle_v1_one_rtt( quic, conn, &pkt, cur_ptr, cur_sz, NULL );
 #else
     (void)fd_quic_process_quic_packet_v1( quic, &pkt, cur_ptr, cur_sz );
 #endif
   }
 }
 
+/* fd_quic_process_burst processes a burst of burst_cnt (at most
+   FD_QUIC_RX_BURST_MAX) received datagrams, in arrival order.
+
+   Long header packets (handshakes) are rare and are processed
+   individually via fd_quic_process_packet.  Runs of short header
+   (1-RTT) packets between them are grouped by connection such that
+   - each connection is looked up in the conn map once per run
+   - the header protection masks of all packets of the run are
+     computed together, amortizing the block cipher latency
+   - acks generated while processing the run are coalesced, and the
+     service of each connection (which sends the acks via
+     fd_quic_conn_tx) is rescheduled once per run
+   A long header packet ends the run before it: the 1-RTT packets
+   received earlier are processed first, and the ones received later
+   are looked up only after it was processed (it can install keys or
+   change the conn ids of a connection). */
+
+#define FD_QUIC_RX_BURST_MAX (64UL)
+
+FD_STATIC_ASSERT( FD_QUIC_CONN_ID_SZ==sizeof(ulong), quic_conn_id_sz );
+
+/* fd_quic_rx_run_t holds a run of 1-RTT packets of a burst and the
+   connections they belong to */
+
+struct fd_quic_rx_run {
+  fd_quic_pkt_t    pkt        [ FD_QUIC_RX_BURST_MAX ];
+  uchar const *    pkt_ptr    [ FD_QUIC_RX_BURST_MAX ];
+  ulong            pkt_sz     [ FD_QUIC_RX_BURST_MAX ];
+  ulong            pkt_grp    [ FD_QUIC_RX_BURST_MAX ];
+  ulong            pkt_cnt;
+
+  /* connections of the run, keyed by our conn id */
+  ulong            grp_conn_id[ FD_QUIC_RX_BURST_MAX ];
+  fd_quic_conn_t * grp_conn   [ FD_QUIC_RX_BURST_MAX ];
+  ulong            grp_cnt;
+};
+typedef struct fd_quic_rx_run fd_quic_rx_run_t;
+
+/* fd_quic_process_run processes the packets of run in order and
+   empties it */
+
+static void
+fd_quic_process_run( fd_quic_t *        quic,
+                     fd_quic_rx_run_t * run ) {
+
+  uint  enc_level = fd_quic_enc_level_appdata_id;
+  ulong pkt_cnt   = run->pkt_cnt;
+  ulong grp_cnt   = run->grp_cnt;
+
+  run->pkt_cnt = 0UL;
+  run->grp_cnt = 0UL;
+
+  if( !pkt_cnt ) return;
+
+  /* compute header protection masks
+     the sample starts 4 bytes after the start of the packet number
+     (rfc9001 s5.4.2), which follows the first byte and the conn id */
+  ulong sample_off = 1UL + FD_QUIC_CONN_ID_SZ + 4UL;
+
+  uchar                    hp_mask  [ FD_QUIC_RX_BURST_MAX ][ FD_QUIC_HP_SAMPLE_SZ ];
+  uchar const *            pkt_mask [ FD_QUIC_RX_BURST_MAX ]; /* NULL if not computed */
+  fd_quic_crypto_suite_t * hp_suite [ FD_QUIC_RX_BURST_MAX ];
+  fd_quic_crypto_keys_t *  hp_keys  [ FD_QUIC_RX_BURST_MAX ];
+  uchar const *            hp_sample[ FD_QUIC_RX_BURST_MAX ];
+  uchar *                  hp_out   [ FD_QUIC_RX_BURST_MAX ];
+  ulong                    hp_cnt = 0UL;
+
+  for( ulong j=0UL; j<pkt_cnt; j++ ) {
+    fd_quic_conn_t *         conn  = run->grp_conn[ run->pkt_grp[ j ] ];
+    fd_quic_crypto_suite_t * suite = conn->suites[ enc_level ];
+
+    pkt_mask[ j ] = NULL;
+
+    /* leave anything unusual to fd_quic_handle_v1_one_rtt */
+    if( FD_UNLIKELY( !suite || run->pkt_sz[ j ] < sample_off + FD_QUIC_HP_SAMPLE_SZ ) ) continue;
+
+    hp_suite [ hp_cnt ] = suite;
+    hp_keys  [ hp_cnt ] = &conn->keys[ enc_level ][ !conn->server ];
+    hp_sample[ hp_cnt ] = run->pkt_ptr[ j ] + sample_off;
+    hp_out   [ hp_cnt ] = hp_mask[ j ];
+    pkt_mask [ j ]      = hp_mask[ j ];
+    hp_cnt++;
+  }
+
+  if( FD_UNLIKELY( fd_quic_crypto_hp_mask_batch( hp_suite, hp_keys, hp_sample, hp_out, hp_cnt )
+                   != FD_QUIC_SUCCESS ) ) {
+    /* compute masks individually instead */
+    for( ulong j=0UL; j<pkt_cnt; j++ ) pkt_mask[ j ] = NULL;
+  }
+
+  /* process the packets, deferring ack scheduling to the end of the
+     run */
+  for( ulong grp=0UL; grp<grp_cnt; grp++ ) {
+    run->grp_conn[ grp ]->rx_burst          = 1;
+    run->grp_conn[ grp ]->rx_burst_ack_time = ~0UL;
+  }
+
+  for( ulong j=0UL; j<pkt_cnt; j++ ) {
+    fd_quic_conn_t * conn    = run->grp_conn[ run->pkt_grp[ j ] ];
+    fd_quic_pkt_t *  cur_pkt = run->pkt + j;
+
+    cur_pkt->enc_level  = enc_level;
+    cur_pkt->pkt_number = FD_QUIC_PKT_NUM_UNUSED;
+
+    ulong rc = fd_quic_handle_v1_one_rtt( quic, conn, cur_pkt, run->pkt_ptr[ j ], run->pkt_sz[ j ], pkt_mask[ j ] );
+    if( rc == FD_QUIC_PARSE_FAIL ) continue;
+
+    /* if we get here we parsed all the frames, so ack the packet */
+    if( cur_pkt->pkt_number != FD_QUIC_PKT_NUM_UNUSED ) {
+      fd_quic_ack_pkt( quic, conn, cur_pkt );
+    }
+  }
+
+  for( ulong grp=0UL; grp<grp_cnt; grp++ ) {
+    fd_quic_conn_t * conn = run->grp_conn[ grp ];
+    conn->rx_burst = 0;
+    if( conn->rx_burst_ack_time != ~0UL ) {
+      fd_quic_reschedule_conn( conn, conn->rx_burst_ack_time );
+    }
+  }
+}
+
+static void
+fd_quic_process_burst( fd_quic_t *               quic,
+                       fd_aio_pkt_info_t const * burst,
+                       ulong                     burst_cnt ) {
+
+  fd_quic_state_t * state = fd_quic_get_state( quic );
+  ulong             now   = fd_quic_now( quic );
+
+  fd_quic_rx_run_t run[1];
+  run->pkt_cnt = 0UL;
+  run->grp_cnt = 0UL;
+
+  for( ulong j=0UL; j<burst_cnt; j++ ) {
+    uchar const * data    = burst[ j ].buf;
+    ulong         data_sz = burst[ j ].buf_sz;
+
+    fd_quic_pkt_t * cur_pkt = run->pkt + run->pkt_cnt;
+    fd_memset( cur_pkt, 0, sizeof( fd_quic_pkt_t ) );
+    cur_pkt->datagram_sz = (uint)data_sz;
+    cur_pkt->rcv_time    = now;
+
+    ulong rc = fd_quic_decode_net_hdrs( cur_pkt, data, data_sz );
+    if( rc == FD_QUIC_PARSE_FAIL ) continue;
+
+    uchar const * cur_ptr = data    + rc;
+    ulong         cur_sz  = data_sz - rc;
+
+    /* shortest valid quic payload? */
+    if( cur_sz < FD_QUIC_SHORTEST_PKT ) continue;
+
+    if( FD_UNLIKELY( cur_ptr[0] & 0x80u ) ) {
+      /* long header packet, ends the current run */
+      fd_quic_process_run( quic, run );
+      fd_quic_process_packet( quic, data, data_sz );
+      continue;
+    }
+
+    /* short header packet
+       find the group of the connection, looking it up on first use */
+    ulong conn_id;
+    fd_memcpy( &conn_id, cur_ptr+1, FD_QUIC_CONN_ID_SZ );
+
+    ulong grp;
+    for( grp=0UL; grp<run->grp_cnt; grp++ ) {
+      if( run->grp_conn_id[ grp ] == conn_id ) break;
+    }
+
+    if( grp == run->grp_cnt ) {
+      fd_quic_conn_id_t dst_conn_id = { FD_QUIC_CONN_ID_SZ, {0}, {0} };
+      fd_memcpy( &dst_conn_id.conn_id, cur_ptr+1, FD_QUIC_CONN_ID_SZ );
+
+      fd_quic_conn_entry_t * entry = fd_quic_conn_map_query( state->conn_map, &dst_conn_id );
+      if( !entry ) {
+        /* silently ignore */
+        continue;
+      }
+
+      run->grp_conn_id[ grp ] = conn_id;
+      run->grp_conn   [ grp ] = entry->conn;
+      run->grp_cnt++;
+    }
+
+    run->pkt_ptr[ run->pkt_cnt ] = cur_ptr;
+    run->pkt_sz [ run->pkt_cnt ] = cur_sz;
+    run->pkt_grp[ run->pkt_cnt ] = grp;
+    run->pkt_cnt++;
+  }
+
+  fd_quic_process_run( quic, run );
+}
+
 /* main receive-side entry point */
 int
 fd_quic_aio_cb_receive( void *                    context,
@@ -2766,10 +3010,20 @@ fd_quic_aio_cb_receive( void *                    context,
   fd_quic_t * quic = (fd_quic_t*)context;
 
   /* this aio interface is configured as one-packet per buffer
-     so batch[0] refers to one buffer
-     as such, we simply forward each individual packet to a handling function */
+     so batch[0] refers to one buffer */
+  if( quic->config.rx_burst ) {
+    /* process the batch in bursts of packets */
+    for( ulong j = 0; j < batch_cnt; j += FD_QUIC_RX_BURST_MAX ) {
+      fd_quic_process_burst( quic, batch + j, fd_ulong_min( batch_cnt - j, FD_QUIC_RX_BURST_MAX ) );
+    }
+  } else {
+    /* forward each individual packet to a handling function */
+    for( ulong j = 0; j < batch_cnt; ++j ) {
+      fd_quic_process_packet( quic, batch[ j ].buf, batch[ j ].buf_sz );
+    }
+  }
+
   for( ulong j = 0; j < batch_cnt; ++j ) {
-    fd_quic_process_packet( quic, batch[ j ].buf, batch[ j ].buf_sz );
     quic->metrics.net_rx_byte_cnt += batch[ j ].buf_sz;
   }
 
@@ -4909,6 +5163,8 @@ fd_quic_conn_create( fd_quic_t *               quic,
   conn->spin_bit             = 0;
   conn->upd_pkt_number       = 0;
   conn->base_timeout         = 0;
+  conn->rx_burst             = 0;
+  conn->rx_burst_ack_time    = ~0UL;
 
   /* initialize connection members */
   ulong our_conn_id_idx = 0;
@@ -5256,6 +5512,8 @@ fd_quic_reclaim_pkt_meta( fd_quic_conn_t *     conn,
       COPY_KEY(0,iv);
       COPY_KEY(1,pkt_key);
       COPY_KEY(1,iv);
+      COPY_KEY(0,pkt_gcm);
+      COPY_KEY(1,pkt_gcm);
       conn->keys[enc_level][0].pkt_cipher_ctx = conn->new_keys[0].pkt_cipher_ctx;
       conn->keys[enc_level][1].pkt_cipher_ctx = conn->new_keys[1].pkt_cipher_ctx;
 #     undef COPY_KEY
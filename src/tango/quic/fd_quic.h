@@ -232,6 +232,14 @@ struct __attribute__((aligned(16UL))) fd_quic_config {
    /* retry: whether address validation using retry packets is enabled (RFC 9000, Section 8.1.2) */
   int retry;
 
+  /* rx_burst: whether received aio batches are processed as bursts.
+     Packets are still processed in arrival order, but the 1-RTT
+     packets between two long header packets of a burst are grouped by
+     connection: each connection is looked up once, header protection
+     masks are computed for all of them at once, and ACK service is
+     rescheduled once per connection rather than once per packet. */
+  int rx_burst;
+
   /* TLS config ********************************************/
 
 # define FD_QUIC_CERT_PATH_LEN 1023UL
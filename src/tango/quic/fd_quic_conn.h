@@ -82,6 +82,8 @@ struct fd_quic_conn {
   ulong              next_service_time;   /* time service should be called next */
   ulong              sched_service_time;  /* time service is scheduled for, if in_service=1 */
   int                in_service;          /* whether the conn is in the service queue */
+  int                rx_burst;            /* whether a receive burst is processing this conn */
+  ulong              rx_burst_ack_time;   /* earliest ack time requested during the burst */
   uchar              called_conn_new;     /* whether we need to call conn_final on teardown */
 
   /* we can have multiple connection ids */
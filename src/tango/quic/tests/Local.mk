@@ -8,6 +8,7 @@ $(call make-unit-test,test_quic_conn,test_quic_conn,fd_aio fd_quic fd_ballet fd_
 $(call make-unit-test,test_quic_server,test_quic_server,fd_aio fd_ballet fd_quic fd_tango fd_util)
 $(call make-unit-test,test_quic_client_flood,test_quic_client_flood,fd_aio fd_quic fd_ballet fd_tango fd_util)
 $(call make-unit-test,test_quic_bw,test_quic_bw,fd_aio fd_quic fd_ballet fd_tango fd_util)
+$(call make-unit-test,test_quic_rx_burst,test_quic_rx_burst,fd_aio fd_quic fd_ballet fd_tango fd_util)
 $(call make-unit-test,test_quic_handshake,test_handshake,fd_aio fd_ballet fd_quic fd_util)
 $(call make-unit-test,test_quic_crypto,test_crypto,fd_quic fd_ballet fd_util)
 $(call make-unit-test,test_quic_frames,test_frames,fd_quic fd_util)
@@ -23,6 +24,7 @@ $(call make-unit-test,test_quic_retry_integration,test_quic_retry_integration,fd
 $(call run-unit-test,test_quic_hs)
 $(call run-unit-test,test_quic_streams)
 $(call run-unit-test,test_quic_conn)
+$(call run-unit-test,test_quic_rx_burst)
 $(call run-unit-test,test_quic_crypto)
 $(call run-unit-test,test_quic_frames)
 $(call run-unit-test,test_quic_layout)
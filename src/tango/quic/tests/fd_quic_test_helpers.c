@@ -226,6 +226,47 @@ fd_quic_test_keylog( fd_quic_virtual_pair_t const * pair,
   fd_pcapng_fwrite_tls_key_log( (uchar const *)line, (uint)strlen( line ), pair->quic_a2b.pcapng );
 }
 
+static int
+fd_quic_tx_batch_send( void *                    ctx,
+                       fd_aio_pkt_info_t const * batch,
+                       ulong                     batch_cnt,
+                       ulong *                   opt_batch_idx,
+                       int                       flush ) {
+  (void)flush;
+
+  fd_quic_tx_batch_t * tx_batch = (fd_quic_tx_batch_t *)ctx;
+
+  for( ulong j=0UL; j<batch_cnt; j++ ) {
+    if( tx_batch->pkt_cnt==FD_QUIC_TX_BATCH_MAX ) fd_quic_tx_batch_flush( tx_batch );
+
+    ulong sz = batch[ j ].buf_sz;
+    FD_TEST( sz<=FD_QUIC_MTU );
+
+    ulong idx = tx_batch->pkt_cnt++;
+    fd_memcpy( tx_batch->buf[ idx ], batch[ j ].buf, sz );
+    tx_batch->pkt[ idx ].buf    = tx_batch->buf[ idx ];
+    tx_batch->pkt[ idx ].buf_sz = (ushort)sz;
+  }
+
+  if( opt_batch_idx ) *opt_batch_idx = batch_cnt;
+  return FD_AIO_SUCCESS;
+}
+
+fd_aio_t const *
+fd_quic_tx_batch_init( fd_quic_tx_batch_t * batch,
+                       fd_aio_t const *     dst ) {
+  batch->dst     = dst;
+  batch->pkt_cnt = 0UL;
+  return fd_aio_join( fd_aio_new( batch->aio, batch, fd_quic_tx_batch_send ) );
+}
+
+void
+fd_quic_tx_batch_flush( fd_quic_tx_batch_t * batch ) {
+  ulong pkt_cnt = batch->pkt_cnt;
+  batch->pkt_cnt = 0UL;
+  if( pkt_cnt ) fd_aio_send( batch->dst, batch->pkt, pkt_cnt, NULL, 1 );
+}
+
 fd_quic_udpsock_t *
 fd_quic_udpsock_create( void *           _sock,
                         int *            pargc,
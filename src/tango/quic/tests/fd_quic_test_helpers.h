@@ -24,6 +24,24 @@ struct fd_quic_virtual_pair {
 };
 typedef struct fd_quic_virtual_pair fd_quic_virtual_pair_t;
 
+/* fd_quic_tx_batch_t is an aio that buffers the packets sent to it
+   instead of delivering them.  The buffered packets are delivered to
+   dst as a single multi-packet batch on flush (or once the buffer is
+   full), which is what a QUIC receiving from a real network driver
+   sees.  Tests may also inspect or reorder pkt[0,pkt_cnt) directly
+   before flushing. */
+
+#define FD_QUIC_TX_BATCH_MAX (256UL)
+
+struct fd_quic_tx_batch {
+  fd_aio_t          aio[1];  /* set as net tx of the sending QUIC */
+  fd_aio_t const *  dst;     /* flush target, e.g. the aio rx of the peer */
+  ulong             pkt_cnt;
+  fd_aio_pkt_info_t pkt[ FD_QUIC_TX_BATCH_MAX ];
+  uchar             buf[ FD_QUIC_TX_BATCH_MAX ][ FD_QUIC_MTU ];
+};
+typedef struct fd_quic_tx_batch fd_quic_tx_batch_t;
+
 FD_PROTOTYPES_BEGIN
 
 /* fd_quic_test_boot boots the QUIC test environment.
@@ -75,6 +93,18 @@ void
 fd_quic_test_keylog( fd_quic_virtual_pair_t const * pair,
                      char const *                   line );
 
+/* fd_quic_tx_batch_init initializes batch as an empty buffer flushing
+   to dst and returns its aio, to be installed with
+   fd_quic_set_aio_net_tx.  fd_quic_tx_batch_flush delivers all
+   buffered packets to dst in one fd_aio_send call and empties batch. */
+
+fd_aio_t const *
+fd_quic_tx_batch_init( fd_quic_tx_batch_t * batch,
+                       fd_aio_t const *     dst );
+
+void
+fd_quic_tx_batch_flush( fd_quic_tx_batch_t * batch );
+
 FD_PROTOTYPES_END
 
 /* fd_quic_udpsock is a command-line helper for creating an UDP channel
@@ -305,6 +305,52 @@ main( int     argc,
 
   FD_LOG_NOTICE(( "decrypted packet matches original packet" ));
 
+  /* protected header and start of the payload from rfc9001 A.2 */
+  uchar const expected_protected[] = {
+    0xc0, 0x00, 0x00, 0x00, 0x01, 0x08, 0x83, 0x94, 0xc8, 0xf0, 0x3e, 0x51,
+    0x57, 0x08, 0x00, 0x00, 0x44, 0x9e, 0x7b, 0x9a, 0xec, 0x34, 0xd1, 0xb1,
+    0xc9, 0x8d, 0xd7, 0x68, 0x9f, 0xb8, 0xec, 0x11, 0xd2, 0x42, 0xb1, 0x23,
+    0xdc, 0x9b };
+  FD_TEST( 0==memcmp( cipher_text, expected_protected, sizeof( expected_protected ) ) );
+
+  /* the same packet protected through OpenSSL (suites with native set
+     use fd_aes) */
+  fd_quic_crypto_suite_t evp_suite = *suite;
+  evp_suite.native = 0;
+  uchar evp_cipher_text[4096] = {0};
+  ulong evp_cipher_text_sz = sizeof( evp_cipher_text );
+  FD_TEST( fd_quic_crypto_encrypt( evp_cipher_text, &evp_cipher_text_sz, hdr, hdr_sz, pkt, pkt_sz,
+                                   &evp_suite, &client_keys, &client_keys )==FD_QUIC_SUCCESS );
+  FD_TEST( evp_cipher_text_sz==cipher_text_sz );
+  FD_TEST( 0==memcmp( evp_cipher_text, cipher_text, cipher_text_sz ) );
+
+  /* header protection masks in a batch match those of
+     fd_quic_crypto_decrypt_hdr */
+# define HP_BATCH_CNT 40UL
+  fd_quic_crypto_suite_t * batch_suite [ HP_BATCH_CNT ];
+  fd_quic_crypto_keys_t  * batch_keys  [ HP_BATCH_CNT ];
+  uchar const *            batch_sample[ HP_BATCH_CNT ];
+  uchar *                  batch_mask  [ HP_BATCH_CNT ];
+  uchar                    masks       [ HP_BATCH_CNT ][ FD_QUIC_HP_SAMPLE_SZ ];
+  for( ulong i=0UL; i<HP_BATCH_CNT; i++ ) {
+    batch_suite [i] = (i%3UL) ? suite : &evp_suite;
+    batch_keys  [i] = &client_keys;
+    batch_sample[i] = cipher_text + pn_offset + 4UL + i;
+    batch_mask  [i] = masks[i];
+  }
+  FD_TEST( fd_quic_crypto_hp_mask_batch( batch_suite, batch_keys, batch_sample, batch_mask, HP_BATCH_CNT )==FD_QUIC_SUCCESS );
+  for( ulong i=0UL; i<HP_BATCH_CNT; i++ ) {
+    uchar hdr_a[64]; ulong hdr_a_sz = sizeof( hdr_a );
+    uchar hdr_b[64]; ulong hdr_b_sz = sizeof( hdr_b );
+    FD_TEST( fd_quic_crypto_decrypt_hdr( hdr_a, &hdr_a_sz, cipher_text + i, cipher_text_sz - i, pn_offset,
+                                         suite, &client_keys )==FD_QUIC_SUCCESS );
+    FD_TEST( fd_quic_crypto_decrypt_hdr_mask( hdr_b, &hdr_b_sz, cipher_text + i, cipher_text_sz - i, pn_offset,
+                                              masks[i] )==FD_QUIC_SUCCESS );
+    FD_TEST( 0==memcmp( hdr_a, hdr_b, pn_offset + 4UL ) );
+  }
+# undef HP_BATCH_CNT
+  FD_LOG_NOTICE(( "batched header protection matches" ));
+
   fd_quic_free_keys( &client_keys );
   fd_quic_crypto_ctx_fini( &crypto_ctx );
 
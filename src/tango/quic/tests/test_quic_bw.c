@@ -5,6 +5,10 @@ uchar conn_final_cnt = 0;
 
 ulong rx_tot_sz = 0;
 
+/* client tx is buffered here and delivered to the server one batch per
+   client service call, so the server receives multi-packet batches */
+static fd_quic_tx_batch_t client_tx_batch[1];
+
 static void
 my_conn_final( fd_quic_conn_t * conn,
                void *           quic_ctx ) {
@@ -117,6 +121,9 @@ main( int     argc,
   fd_quic_virtual_pair_t vp;
   fd_quic_virtual_pair_init( &vp, server_quic, client_quic );
 
+  fd_aio_t client_tx = client_quic->aio_tx;
+  fd_quic_set_aio_net_tx( client_quic, fd_quic_tx_batch_init( client_tx_batch, &client_tx ) );
+
   FD_LOG_NOTICE(( "Initializing QUICs" ));
   FD_TEST( fd_quic_init( server_quic ) );
   FD_TEST( fd_quic_init( client_quic ) );
@@ -143,6 +150,7 @@ main( int     argc,
 
     FD_LOG_INFO(( "running services at %lu", next_wakeup ));
     fd_quic_service( client_quic );
+    fd_quic_tx_batch_flush( client_tx_batch );
     fd_quic_service( server_quic );
 
     if( server_complete && client_complete ) {
@@ -164,6 +172,7 @@ main( int     argc,
     }
 
     fd_quic_service( client_quic );
+    fd_quic_tx_batch_flush( client_tx_batch );
     fd_quic_service( server_quic );
   }
 
@@ -176,42 +185,76 @@ main( int     argc,
   fd_quic_stream_t * client_stream = fd_quic_conn_new_stream( client_conn, FD_QUIC_TYPE_BIDIR );
   FD_TEST( client_stream );
 
-  char buf[ 256UL ] = "Hello world!\x00-   ";
+  char buf[ 1024UL ] = "Hello world!\x00-   ";
   ulong buf_sz = sizeof(buf);
-  fd_aio_pkt_info_t batch[1] = {{ buf, (ushort)buf_sz }};
-  int rc = fd_quic_stream_send( client_stream, batch, 1, 0 );
 
-  FD_LOG_INFO(( "fd_quic_stream_send returned %d", rc ));
+  /* queue enough data per iteration that each client service sends
+     many packets, so the server receives real multi-packet batches */
+  fd_aio_pkt_info_t batch[ 32UL ];
+  ulong             batch_sz = sizeof(batch)/sizeof(batch[0]);
+  for( ulong j=0UL; j<batch_sz; j++ ) batch[ j ] = (fd_aio_pkt_info_t){ buf, (ushort)buf_sz };
 
-  ulong tot     = 0;
-  long last_ts = fd_log_wallclock();
-  long rprt_ts = fd_log_wallclock() + (long)1e9;
-
-  long start_ts = fd_log_wallclock();
-  long end_ts   = start_ts + (long)10e9; /* ten seconds */
-  while(1) {
-    fd_quic_service( client_quic );
-    fd_quic_service( server_quic );
-
-    rc = fd_quic_stream_send( client_stream, batch, 1, 0 );
-    if( rc == 1 ) {
-      tot += buf_sz;
-    }
-
-    long t = fd_log_wallclock();
-    if( t >= rprt_ts ) {
-      long dt = t - last_ts;
-      float bps = (float)tot / (float)dt;
-      FD_LOG_NOTICE(( "bw: %f  dt: %f  bytes: %f", (double)bps, (double)dt, (double)tot ));
+  int rc = fd_quic_stream_send( client_stream, batch, 1, 0 );
 
-      tot     = 0;
-      last_ts = t;
-      rprt_ts = t + (long)1e9;
+  FD_LOG_INFO(( "fd_quic_stream_send returned %d", rc ));
 
-      if( t > end_ts ) break;
+  /* run the transfer with per-packet receive processing, then with
+     burst receive processing (rx_burst is only consulted when a batch
+     of packets is received, so it can be switched between batches) */
+  float rx_pps      [2];
+  float rx_batch_avg[2];
+
+  for( int rx_burst=0; rx_burst<2; rx_burst++ ) {
+    server_quic->config.rx_burst = rx_burst;
+    client_quic->config.rx_burst = rx_burst;
+
+    FD_LOG_NOTICE(( "rx_burst %d", rx_burst ));
+
+    ulong tot     = 0;
+    ulong rx_pkt  = server_quic->metrics.net_rx_pkt_cnt;
+    long  last_ts = fd_log_wallclock();
+    long  rprt_ts = fd_log_wallclock() + (long)1e9;
+
+    ulong start_rx_pkt = rx_pkt;
+    ulong rx_batch_cnt = 0;
+    long  start_ts     = fd_log_wallclock();
+    long  end_ts       = start_ts + (long)5e9; /* five seconds */
+    while(1) {
+      fd_quic_service( client_quic );
+      rx_batch_cnt += !!client_tx_batch->pkt_cnt;
+      fd_quic_tx_batch_flush( client_tx_batch );
+      fd_quic_service( server_quic );
+
+      rc = fd_quic_stream_send( client_stream, batch, batch_sz, 0 );
+      if( rc > 0 ) {
+        tot += (ulong)rc * buf_sz;
+      }
+
+      long t = fd_log_wallclock();
+      if( t >= rprt_ts ) {
+        long  dt  = t - last_ts;
+        float bps = (float)tot / (float)dt;
+        ulong pkt = server_quic->metrics.net_rx_pkt_cnt - rx_pkt;
+        float pps = (float)pkt * 1e9f / (float)dt;
+        FD_LOG_NOTICE(( "bw: %f  pps: %f  dt: %f  bytes: %f", (double)bps, (double)pps, (double)dt, (double)tot ));
+
+        tot     = 0;
+        rx_pkt  = server_quic->metrics.net_rx_pkt_cnt;
+        last_ts = t;
+        rprt_ts = t + (long)1e9;
+
+        if( t > end_ts ) {
+          rx_pps      [ rx_burst ] = (float)( rx_pkt - start_rx_pkt ) * 1e9f / (float)( t - start_ts );
+          rx_batch_avg[ rx_burst ] = (float)( rx_pkt - start_rx_pkt ) / (float)fd_ulong_max( rx_batch_cnt, 1UL );
+          break;
+        }
+      }
     }
   }
 
+  FD_LOG_NOTICE(( "server rx pps: %f (per packet)  %f (burst)", (double)rx_pps[0], (double)rx_pps[1] ));
+  FD_LOG_NOTICE(( "server rx pkts per batch: %f (per packet)  %f (burst)", (double)rx_batch_avg[0], (double)rx_batch_avg[1] ));
+
   /* close the connections */
   fd_quic_conn_close( client_conn, 0 );
   fd_quic_conn_close( server_conn, 0 );
@@ -231,6 +274,7 @@ main( int     argc,
 
     FD_LOG_INFO(( "running services at %lu", next_wakeup ));
     fd_quic_service( client_quic );
+    fd_quic_tx_batch_flush( client_tx_batch );
     fd_quic_service( server_quic );
   }
 
@@ -0,0 +1,484 @@
+#include "../fd_quic.h"
+#include "fd_quic_test_helpers.h"
+#include "../../../util/net/fd_eth.h"
+#include "../../../util/net/fd_ip4.h"
+#include "../../../util/net/fd_udp.h"
+
+/* test_quic_rx_burst checks that burst receive processing
+   (config.rx_burst=1) leaves a server in the same state as per-packet
+   processing (config.rx_burst=0).
+
+   Each run sets up a fresh client/server pair on a fake clock,
+   establishes CONN_CNT connections, then captures the client's tx
+   instead of delivering it: 1-RTT stream data on every conn plus the
+   Initial of one more conn.  The captured packets are rearranged into
+   one aio batch that interleaves the conns, puts the long header
+   packets in the middle and mixes in packets with unknown conn ids,
+   truncated packets and packets failing authentication.  The batch is
+   larger than the rx burst size (64), so burst processing also splits
+   it.  The batch is delivered in a single aio call and the resulting
+   server state is recorded.  The run is done once per rx_burst mode
+   and the records are compared. */
+
+#define CONN_CNT      (3UL)  /* established conns sending 1-RTT data */
+#define ROUND_CNT     (2UL)  /* streams sent per conn */
+#define CHUNK_CNT     (12UL) /* stream_send buffers per stream */
+#define CHUNK_SZ      (1000UL)
+#define RX_BURST_MAX  (64UL) /* FD_QUIC_RX_BURST_MAX */
+#define RX_LOG_MAX    (1024UL)
+#define ACK_MAX       (64UL)
+#define BATCH_MAX     (2UL*FD_QUIC_TX_BATCH_MAX)
+
+static ulong now = (ulong)1e18;
+
+static ulong
+test_clock( void * ctx ) {
+  (void)ctx;
+  return now;
+}
+
+/* rx_rec_t records one stream receive callback on the server */
+
+struct rx_rec {
+  ulong conn_idx;
+  ulong stream_id;
+  ulong offset;
+  ulong data_sz;
+  ulong data_hash;
+  int   fin;
+};
+typedef struct rx_rec rx_rec_t;
+
+/* run_result_t is the server state recorded after a run.  Packet
+   numbers are relative to the conn's expected packet number before the
+   batch, as the absolute numbers depend on the handshake. */
+
+struct run_result {
+  ulong           rx_cnt;
+  rx_rec_t        rx[ RX_LOG_MAX ];
+
+  int             conn_state     [ CONN_CNT ];
+  ulong           exp_pkt_number [ CONN_CNT ];
+  ulong           ack_cnt        [ CONN_CNT ];
+  fd_quic_range_t ack            [ CONN_CNT ][ ACK_MAX ];
+  int             in_service     [ CONN_CNT ];
+  ulong           sched_delay    [ CONN_CNT ];
+  int             rx_burst_active[ CONN_CNT ];
+
+  ulong           conn_created_cnt;
+  long            conn_active_cnt;
+  ulong           hs_created_cnt;
+  ulong           stream_rx_byte_cnt;
+  ulong           net_rx_pkt_cnt;
+
+  ulong           batch_cnt;
+  ulong           long_cnt;
+  ulong           unknown_cnt;
+};
+typedef struct run_result run_result_t;
+
+static run_result_t result[2];
+static run_result_t * cur_result;
+
+static fd_quic_conn_t * server_conn[ CONN_CNT ];
+static ulong            server_conn_cnt;
+
+static fd_quic_tx_batch_t client_tx_batch[1];
+
+/* batch storage for the packets crafted from captured ones */
+static uchar extra_buf[ FD_QUIC_TX_BATCH_MAX ][ FD_QUIC_MTU ];
+static ulong extra_cnt;
+
+static void
+my_connection_new( fd_quic_conn_t * conn,
+                   void *           vp_context ) {
+  (void)vp_context;
+  FD_TEST( server_conn_cnt<CONN_CNT );
+  server_conn[ server_conn_cnt++ ] = conn;
+}
+
+static void
+my_stream_receive_cb( fd_quic_stream_t * stream,
+                      void *             ctx,
+                      uchar const *      data,
+                      ulong              data_sz,
+                      ulong              offset,
+                      int                fin ) {
+  (void)ctx;
+
+  if( !cur_result ) return;
+
+  ulong conn_idx;
+  for( conn_idx=0UL; conn_idx<server_conn_cnt; conn_idx++ ) {
+    if( server_conn[ conn_idx ]==stream->conn ) break;
+  }
+  FD_TEST( conn_idx<server_conn_cnt );
+
+  FD_TEST( cur_result->rx_cnt<RX_LOG_MAX );
+  rx_rec_t * rec = cur_result->rx + cur_result->rx_cnt++;
+  rec->conn_idx  = conn_idx;
+  rec->stream_id = stream->stream_id;
+  rec->offset    = offset;
+  rec->data_sz   = data_sz;
+  rec->data_hash = fd_hash( 0UL, data, data_sz );
+  rec->fin       = fin;
+}
+
+/* quic_payload returns the offset of the QUIC payload in the captured
+   eth/ip4/udp frame pkt */
+
+static ulong
+quic_payload( fd_aio_pkt_info_t const * pkt ) {
+  fd_ip4_hdr_t const * ip4 = (fd_ip4_hdr_t const *)( (uchar const *)pkt->buf + sizeof(fd_eth_hdr_t) );
+  ulong off = sizeof(fd_eth_hdr_t) + 4UL*ip4->ihl + sizeof(fd_udp_hdr_t);
+  FD_TEST( off<pkt->buf_sz );
+  return off;
+}
+
+/* extra_pkt appends to batch a copy of pkt truncated to sz bytes and
+   returns the copy */
+
+static uchar *
+extra_pkt( fd_aio_pkt_info_t *       batch,
+           ulong *                   batch_cnt,
+           fd_aio_pkt_info_t const * pkt,
+           ulong                     sz ) {
+  FD_TEST( extra_cnt<FD_QUIC_TX_BATCH_MAX && *batch_cnt<BATCH_MAX );
+  uchar * buf = extra_buf[ extra_cnt++ ];
+  fd_memcpy( buf, pkt->buf, sz );
+  batch[ *batch_cnt ] = (fd_aio_pkt_info_t){ .buf = buf, .buf_sz = (ushort)sz };
+  (*batch_cnt)++;
+  return buf;
+}
+
+static void
+service_pair( fd_quic_t * client_quic,
+              fd_quic_t * server_quic ) {
+  now += (ulong)100e3;
+  fd_quic_service( client_quic );
+  fd_quic_tx_batch_flush( client_tx_batch );
+  fd_quic_service( server_quic );
+}
+
+static void
+run( fd_wksp_t *              wksp,
+     fd_quic_limits_t const * quic_limits,
+     int                      rx_burst,
+     run_result_t *           res ) {
+
+  FD_LOG_NOTICE(( "run with rx_burst %d", rx_burst ));
+
+  now             = (ulong)1e18;
+  server_conn_cnt = 0UL;
+  extra_cnt       = 0UL;
+  cur_result      = NULL;
+  memset( res, 0, sizeof(run_result_t) );
+
+  fd_quic_t * server_quic = fd_quic_new_anonymous( wksp, quic_limits, FD_QUIC_ROLE_SERVER );
+  fd_quic_t * client_quic = fd_quic_new_anonymous( wksp, quic_limits, FD_QUIC_ROLE_CLIENT );
+  FD_TEST( server_quic );
+  FD_TEST( client_quic );
+
+  server_quic->cb.conn_new       = my_connection_new;
+  server_quic->cb.stream_receive = my_stream_receive_cb;
+  server_quic->cb.now            = test_clock;
+  client_quic->cb.now            = test_clock;
+
+  server_quic->config.idle_timeout = (ulong)10e9;
+  client_quic->config.idle_timeout = (ulong)10e9;
+  server_quic->config.initial_rx_max_stream_data = 1<<20;
+  client_quic->config.initial_rx_max_stream_data = 1<<20;
+
+  /* the handshakes are always done per packet */
+  server_quic->config.rx_burst = 0;
+
+  /* server tx goes straight to the client, client tx is buffered */
+  fd_quic_set_aio_net_tx( server_quic, fd_quic_get_aio_net_rx( client_quic ) );
+  fd_quic_set_aio_net_tx( client_quic, fd_quic_tx_batch_init( client_tx_batch, fd_quic_get_aio_net_rx( server_quic ) ) );
+
+  FD_TEST( fd_quic_init( server_quic ) );
+  FD_TEST( fd_quic_init( client_quic ) );
+
+  /* establish the conns one after the other, so that the server conn
+     indices match the client ones */
+  fd_quic_conn_t * client_conn[ CONN_CNT ];
+  for( ulong i=0UL; i<CONN_CNT; i++ ) {
+    client_conn[ i ] = fd_quic_connect( client_quic,
+                                        server_quic->config.net.ip_addr,
+                                        server_quic->config.net.listen_udp_port,
+                                        server_quic->config.sni );
+    FD_TEST( client_conn[ i ] );
+
+    for( ulong j=0UL; j<1000UL; j++ ) {
+      if( server_conn_cnt==i+1UL && client_conn[ i ]->state==FD_QUIC_CONN_STATE_ACTIVE ) break;
+      service_pair( client_quic, server_quic );
+    }
+    FD_TEST( server_conn_cnt==i+1UL );
+    FD_TEST( client_conn[ i ]->state==FD_QUIC_CONN_STATE_ACTIVE );
+  }
+
+  /* let the handshake acks settle */
+  for( ulong j=0UL; j<200UL; j++ ) service_pair( client_quic, server_quic );
+
+  /* capture client tx: stream data on every conn, with the Initial of
+     a new conn in between */
+  ulong server_rx_pkt_cnt = server_quic->metrics.net_rx_pkt_cnt;
+
+  uchar             chunk[ CHUNK_CNT ][ CHUNK_SZ ];
+  fd_aio_pkt_info_t chunk_batch[ CHUNK_CNT ];
+
+  for( ulong r=0UL; r<ROUND_CNT; r++ ) {
+    for( ulong i=0UL; i<CONN_CNT; i++ ) {
+      for( ulong k=0UL; k<CHUNK_CNT; k++ ) {
+        for( ulong b=0UL; b<CHUNK_SZ; b++ ) chunk[ k ][ b ] = (uchar)( 31UL*i + 7UL*r + 3UL*k + b );
+        chunk_batch[ k ] = (fd_aio_pkt_info_t){ .buf = chunk[ k ], .buf_sz = (ushort)CHUNK_SZ };
+      }
+
+      fd_quic_stream_t * stream = fd_quic_conn_new_stream( client_conn[ i ], FD_QUIC_TYPE_UNIDIR );
+      FD_TEST( stream );
+      FD_TEST( fd_quic_stream_send( stream, chunk_batch, CHUNK_CNT, 1 )==(int)CHUNK_CNT );
+
+      now += 1000UL;
+      fd_quic_service( client_quic );
+
+      if( r==0UL && i==0UL ) {
+        FD_TEST( fd_quic_connect( client_quic,
+                                  server_quic->config.net.ip_addr,
+                                  server_quic->config.net.listen_udp_port,
+                                  server_quic->config.sni ) );
+        now += 1000UL;
+        fd_quic_service( client_quic );
+      }
+    }
+  }
+
+  /* nothing may have been delivered yet */
+  FD_TEST( server_quic->metrics.net_rx_pkt_cnt==server_rx_pkt_cnt );
+
+  /* sort the captured packets into long header packets and the 1-RTT
+     packets of each conn (by dst conn id) */
+  fd_aio_pkt_info_t const * cap     = client_tx_batch->pkt;
+  ulong                     cap_cnt = client_tx_batch->pkt_cnt;
+
+  ulong grp_conn_id[ CONN_CNT ];
+  ulong grp_pkt    [ CONN_CNT ][ FD_QUIC_TX_BATCH_MAX ];
+  ulong grp_cnt    [ CONN_CNT ] = {0};
+  ulong grp_tot = 0UL;
+  ulong conn_grp_cnt = 0UL;
+  ulong long_pkt[ FD_QUIC_TX_BATCH_MAX ];
+  ulong long_cnt = 0UL;
+
+  for( ulong j=0UL; j<cap_cnt; j++ ) {
+    uchar const * payload = (uchar const *)cap[ j ].buf + quic_payload( cap+j );
+    if( payload[0] & 0x80u ) {
+      long_pkt[ long_cnt++ ] = j;
+      continue;
+    }
+    ulong conn_id;
+    fd_memcpy( &conn_id, payload+1, FD_QUIC_CONN_ID_SZ );
+    ulong g;
+    for( g=0UL; g<conn_grp_cnt; g++ ) if( grp_conn_id[ g ]==conn_id ) break;
+    if( g==conn_grp_cnt ) {
+      FD_TEST( conn_grp_cnt<CONN_CNT );
+      grp_conn_id[ conn_grp_cnt++ ] = conn_id;
+    }
+    grp_pkt[ g ][ grp_cnt[ g ]++ ] = j;
+    grp_tot++;
+  }
+
+  FD_TEST( conn_grp_cnt==CONN_CNT );
+  FD_TEST( long_cnt>0UL );
+
+  /* build the batch: the conns' 1-RTT packets round robin (keeping
+     each conn's order), the long header packets half way through, and
+     mixed in, copies with an unknown conn id, copies too short to
+     sample for header protection and copies failing authentication
+     (ahead of their original, so their packet number is still
+     expected) */
+  static fd_aio_pkt_info_t batch[ BATCH_MAX ];
+  ulong batch_cnt = 0UL;
+  ulong grp_next[ CONN_CNT ] = {0};
+  ulong emit_cnt = 0UL;
+
+  while( emit_cnt<grp_tot ) {
+    for( ulong g=0UL; g<CONN_CNT; g++ ) {
+      if( grp_next[ g ]==grp_cnt[ g ] ) continue;
+
+      fd_aio_pkt_info_t const * pkt = cap + grp_pkt[ g ][ grp_next[ g ]++ ];
+      ulong                     off = quic_payload( pkt );
+      emit_cnt++;
+
+      if( emit_cnt%24UL==16UL ) {
+        uchar * buf = extra_pkt( batch, &batch_cnt, pkt, pkt->buf_sz );
+        buf[ pkt->buf_sz-1UL ] ^= 0x01u;
+      }
+
+      FD_TEST( batch_cnt<BATCH_MAX );
+      batch[ batch_cnt++ ] = *pkt;
+
+      if( emit_cnt%24UL==0UL ) {
+        uchar * buf = extra_pkt( batch, &batch_cnt, pkt, pkt->buf_sz );
+        buf[ off+1UL ] ^= 0x5au;
+        res->unknown_cnt++;
+      }
+
+      if( emit_cnt%24UL==8UL ) {
+        extra_pkt( batch, &batch_cnt, pkt, off + 1UL + FD_QUIC_CONN_ID_SZ + 12UL );
+      }
+
+      if( emit_cnt==grp_tot/2UL ) {
+        for( ulong l=0UL; l<long_cnt; l++ ) {
+          FD_TEST( batch_cnt<BATCH_MAX );
+          batch[ batch_cnt++ ] = cap[ long_pkt[ l ] ];
+        }
+      }
+    }
+  }
+
+  res->batch_cnt = batch_cnt;
+  res->long_cnt  = long_cnt;
+  FD_TEST( batch_cnt>RX_BURST_MAX );
+
+  ulong base[ CONN_CNT ];
+  for( ulong i=0UL; i<CONN_CNT; i++ ) base[ i ] = server_conn[ i ]->exp_pkt_number[ 2 ];
+
+  /* deliver the batch in one aio call */
+  server_quic->config.rx_burst = rx_burst;
+  client_tx_batch->pkt_cnt     = 0UL;
+  cur_result                   = res;
+
+  ulong batch_idx = 0UL;
+  FD_TEST( fd_aio_send( fd_quic_get_aio_net_rx( server_quic ), batch, batch_cnt, &batch_idx, 1 )==FD_AIO_SUCCESS );
+  FD_TEST( batch_idx==batch_cnt );
+
+  cur_result = NULL;
+
+  /* record the server state */
+  for( ulong i=0UL; i<CONN_CNT; i++ ) {
+    fd_quic_conn_t * conn = server_conn[ i ];
+
+    res->conn_state     [ i ] = (int)conn->state;
+    res->exp_pkt_number [ i ] = conn->exp_pkt_number[ 2 ] - base[ i ];
+    res->in_service     [ i ] = conn->in_service;
+    res->sched_delay    [ i ] = conn->in_service ? conn->sched_service_time - now : 0UL;
+    res->rx_burst_active[ i ] = conn->rx_burst;
+
+    for( fd_quic_ack_t * ack = conn->acks_tx[ fd_quic_enc_level_appdata_id ]; ack; ack = ack->next ) {
+      if( ack->pkt_number.offset_hi<=base[ i ] ) continue;
+      FD_TEST( res->ack_cnt[ i ]<ACK_MAX );
+      fd_quic_range_t * range = res->ack[ i ] + res->ack_cnt[ i ]++;
+      range->offset_lo = fd_ulong_max( ack->pkt_number.offset_lo, base[ i ] ) - base[ i ];
+      range->offset_hi = ack->pkt_number.offset_hi - base[ i ];
+    }
+  }
+
+  res->conn_created_cnt   = server_quic->metrics.conn_created_cnt;
+  res->conn_active_cnt    = server_quic->metrics.conn_active_cnt;
+  res->hs_created_cnt     = server_quic->metrics.hs_created_cnt;
+  res->stream_rx_byte_cnt = server_quic->metrics.stream_rx_byte_cnt;
+  res->net_rx_pkt_cnt     = server_quic->metrics.net_rx_pkt_cnt - server_rx_pkt_cnt;
+
+  FD_LOG_NOTICE(( "batch: %lu pkts (%lu long header, %lu unknown conn id), %lu stream rx events, %lu stream bytes",
+                  res->batch_cnt, res->long_cnt, res->unknown_cnt, res->rx_cnt, res->stream_rx_byte_cnt ));
+
+  fd_quic_set_aio_net_tx( server_quic, NULL );
+  fd_quic_set_aio_net_tx( client_quic, NULL );
+  fd_wksp_free_laddr( fd_quic_delete( fd_quic_leave( fd_quic_fini( server_quic ) ) ) );
+  fd_wksp_free_laddr( fd_quic_delete( fd_quic_leave( fd_quic_fini( client_quic ) ) ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+
+  fd_boot          ( &argc, &argv );
+  fd_quic_test_boot( &argc, &argv );
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",   NULL, "gigantic"                   );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",  NULL, 2UL                          );
+  ulong        numa_idx  = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx",  NULL, fd_shmem_numa_idx( cpu_idx ) );
+
+  if( FD_UNLIKELY( argc>1 ) ) FD_LOG_ERR(( "unrecognized argument: %s", argv[ 1 ] ));
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu)", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  fd_quic_limits_t const quic_limits = {
+    .conn_cnt         = 10,
+    .conn_id_cnt      = 10,
+    .conn_id_sparsity = 4.0,
+    .handshake_cnt    = 10,
+    .stream_cnt       = { 0, 0, 10, 0 },
+    .inflight_pkt_cnt = 1024,
+    .tx_buf_sz        = 1<<15
+  };
+
+  run( wksp, &quic_limits, 0, result+0 );
+  run( wksp, &quic_limits, 1, result+1 );
+
+  run_result_t const * a = result+0;
+  run_result_t const * b = result+1;
+
+  /* same traffic */
+  FD_TEST( a->batch_cnt  ==b->batch_cnt   );
+  FD_TEST( a->long_cnt   ==b->long_cnt    );
+  FD_TEST( a->unknown_cnt==b->unknown_cnt );
+  FD_TEST( a->unknown_cnt>0UL );
+
+  /* same data delivered in the same order */
+  FD_TEST( a->rx_cnt==b->rx_cnt );
+  FD_TEST( a->rx_cnt>0UL );
+  for( ulong j=0UL; j<a->rx_cnt; j++ ) {
+    rx_rec_t const * x = a->rx + j;
+    rx_rec_t const * y = b->rx + j;
+    if( FD_UNLIKELY( x->conn_idx !=y->conn_idx  || x->stream_id!=y->stream_id ||
+                     x->offset   !=y->offset    || x->data_sz  !=y->data_sz   ||
+                     x->data_hash!=y->data_hash || x->fin      !=y->fin ) ) {
+      FD_LOG_ERR(( "stream rx %lu differs: conn %lu/%lu stream %lu/%lu offset %lu/%lu sz %lu/%lu",
+                   j, x->conn_idx, y->conn_idx, x->stream_id, y->stream_id,
+                   x->offset, y->offset, x->data_sz, y->data_sz ));
+    }
+  }
+  FD_TEST( a->stream_rx_byte_cnt==ROUND_CNT*CONN_CNT*CHUNK_CNT*CHUNK_SZ );
+  FD_TEST( a->stream_rx_byte_cnt==b->stream_rx_byte_cnt );
+
+  /* same conn state, same packets acked, ack service scheduled at the
+     same time */
+  for( ulong i=0UL; i<CONN_CNT; i++ ) {
+    FD_TEST( a->conn_state[ i ]==FD_QUIC_CONN_STATE_ACTIVE );
+    FD_TEST( a->conn_state[ i ]==b->conn_state[ i ] );
+    FD_TEST( !a->rx_burst_active[ i ] && !b->rx_burst_active[ i ] );
+    FD_TEST( a->exp_pkt_number[ i ]>0UL );
+    FD_TEST( a->exp_pkt_number[ i ]==b->exp_pkt_number[ i ] );
+    FD_TEST( a->in_service [ i ]==b->in_service [ i ] );
+    FD_TEST( a->sched_delay[ i ]==b->sched_delay[ i ] );
+    FD_TEST( a->ack_cnt[ i ]>0UL );
+    FD_TEST( a->ack_cnt[ i ]==b->ack_cnt[ i ] );
+    for( ulong k=0UL; k<a->ack_cnt[ i ]; k++ ) {
+      FD_TEST( a->ack[ i ][ k ].offset_lo==b->ack[ i ][ k ].offset_lo );
+      FD_TEST( a->ack[ i ][ k ].offset_hi==b->ack[ i ][ k ].offset_hi );
+    }
+  }
+
+  /* the Initial in the middle of the batch created a conn */
+  FD_TEST( a->conn_created_cnt==CONN_CNT+1UL );
+  FD_TEST( a->conn_created_cnt==b->conn_created_cnt );
+  FD_TEST( a->conn_active_cnt ==b->conn_active_cnt  );
+  FD_TEST( a->hs_created_cnt  ==b->hs_created_cnt   );
+  FD_TEST( a->net_rx_pkt_cnt  ==a->batch_cnt        );
+  FD_TEST( b->net_rx_pkt_cnt  ==b->batch_cnt        );
+
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_quic_test_halt();
+  fd_halt();
+  return 0;
+}
@@ -193,6 +193,26 @@ main( int     argc,
       } while( FD_UNLIKELY( found ) );
     }
 
+    if( !(rem & 15UL) ) { /* Occasionally check batch queries against individual queries */
+      ulong batch_tag[ FD_TCACHE_QUERY_BATCH_MAX ];
+      ulong batch_cnt = (ulong)(fd_rng_uint( rng ) % (uint)(FD_TCACHE_QUERY_BATCH_MAX+1UL));
+      for( ulong i=0UL; i<batch_cnt; i++ ) {
+        uint r = fd_rng_uint( rng ) & 3U;
+        batch_tag[ i ] = r==0U ? FD_TCACHE_TAG_NULL                            :
+                         r==1U ? fd_rng_ulong( rng )                           :
+                                 ring[ fd_rng_ulong_roll( rng, depth ) ]; /* Usually in the tcache */
+      }
+      int batch_found = fd_tcache_query_batch( map, map_cnt, batch_tag, batch_cnt );
+      FD_TEST( !(batch_found >> batch_cnt) );
+      for( ulong i=0UL; i<batch_cnt; i++ ) {
+        int   found = 0;
+        ulong map_idx;
+        if( !fd_tcache_tag_is_null( batch_tag[ i ] ) ) FD_TCACHE_QUERY( found, map_idx, map, map_cnt, batch_tag[ i ] );
+        (void)map_idx;
+        FD_TEST( ((batch_found>>i) & 1)==found );
+      }
+    }
+
     int dup;
     FD_TCACHE_INSERT( dup, oldest, ring, depth, map, map_cnt, tag );
     FD_TEST( dup==is_dup );
@@ -150,6 +150,17 @@
 #define FD_HAS_AVX 0
 #endif
 
+/* FD_HAS_AVX512 indicates the target supports Intel AVX-512 style SIMD
+   (specifically the AVX-512F/VL/BW/DQ subsets available on Skylake-SP,
+   Ice Lake and AMD Zen4 and newer).  Recommend using the
+   simd/fd_avx512.h APIs instead of raw Intel intrinsics for readability
+   and to facilitate portability to non-x86 platforms.  Implies
+   FD_HAS_AVX. */
+
+#ifndef FD_HAS_AVX512
+#define FD_HAS_AVX512 0
+#endif
+
 /* FD_HAS_SHANI indicates that the target supports Intel SHA extensions
    which accelerate SHA-1 and SHA-256 computation.  This extension is
    also called SHA-NI or SHA_NI (Secure Hash Algorithm New
@@ -169,6 +180,15 @@
 #define FD_HAS_GFNI 0
 #endif
 
+/* FD_HAS_AESNI indicates that the target supports Intel AES-NI and
+   PCLMULQDQ (carry-less multiply) instructions, which accelerate AES
+   and GCM (GHASH) computation.  Supported on Intel Westmere and AMD
+   Bulldozer and newer.  Implies FD_HAS_AVX. */
+
+#ifndef FD_HAS_AESNI
+#define FD_HAS_AESNI 0
+#endif
+
 /* FD_HAS_ASAN indicates that the build targed is using ASAN. */
 #ifndef FD_HAS_ASAN
 #define FD_HAS_ASAN 0
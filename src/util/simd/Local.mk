@@ -14,3 +14,7 @@ $(call run-unit-test,test_avx_8x32,)
 $(call run-unit-test,test_avx_4x64,)
 $(call run-unit-test,test_avx_32x8,)
 
+
+$(call add-hdrs,fd_avx512.h fd_avx512_wwc.h fd_avx512_wwv.h)
+$(call make-unit-test,test_avx512_8x64,test_avx512_8x64,fd_util)
+$(call run-unit-test,test_avx512_8x64,)
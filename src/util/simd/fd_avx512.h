@@ -0,0 +1,41 @@
+#ifndef HEADER_fd_src_util_simd_fd_avx512_h
+#define HEADER_fd_src_util_simd_fd_avx512_h
+
+#if FD_HAS_AVX512
+
+/* An API for writing vectorized C/C++ code using 8-wide 64-bit ulongs
+   and 8-wide lane masks assuming a platform with AVX-512 support
+   (specifically AVX-512F/VL/BW/DQ, i.e. Skylake-SP and newer).
+
+   This mirrors the fd_avx.h APIs (the "w" prefix becomes "ww" for the
+   512-bit wide types).  Only the operations needed by the AVX-512
+   accelerated kernels in the tree are currently provided; new ones
+   should follow the conventions of the corresponding fd_avx_w*.h
+   operations.
+
+   Unlike AVX, AVX-512 vector conditionals are held in dedicated mask
+   registers.  A wwc_t is such a mask (bit n of the mask is lane n). */
+
+#include "../bits/fd_bits.h"
+#include <x86intrin.h> /* Include the intrinsics we are going to patch up */
+
+/* Some useful constants */
+
+#define WW_WIDTH         (8) /* Vector width / element count / lanes (64-bit elements) */
+#define WW_FOOTPRINT    (64) /* Vector byte size */
+#define WW_ALIGN        (64) /* Vector byte alignment required for aligned operations */
+#define WW_LG_WIDTH      (3) /* log_2 WW_WIDTH */
+#define WW_LG_FOOTPRINT  (6) /* log_2 WW_FOOTPRINT */
+#define WW_LG_ALIGN      (6) /* log_2 WW_ALIGN */
+#define WW_ATTR         __attribute__((aligned(WW_ALIGN)))
+
+/* Include all the APIs */
+
+#include "fd_avx512_wwc.h" /* Vector conditional (lane mask) support */
+#include "fd_avx512_wwv.h" /* Vector ulong support */
+
+#else
+#error "Build target does not support AVX-512 wrappers"
+#endif
+
+#endif /* HEADER_fd_src_util_simd_fd_avx512_h */
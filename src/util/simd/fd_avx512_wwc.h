@@ -0,0 +1,40 @@
+#ifndef HEADER_fd_src_util_simd_fd_avx512_h
+#error "Do not include this directly; use fd_avx512.h"
+#endif
+
+/* Vector conditional API *********************************************/
+
+/* A wwc_t is an AVX-512 lane mask for 8 64-bit wide lanes.  Bit n of
+   the mask is true if lane n is true.  Since these live in mask
+   registers, most operations are just the usual integer operations on
+   the mask. */
+
+#define wwc_t __mmask8
+
+/* Given the int values, return ... */
+
+#define wwc_bcast(c0) ((__mmask8)(-!!(c0)))              /* [ c0 c0 ... c0 ] */
+#define wwc_unpack(b) ((__mmask8)(b))                    /* [ (b>>0)&1 (b>>1)&1 ... (b>>7)&1 ] */
+#define wwc_pack(c)   ((int)(uint)(uchar)(c))            /* (c0<<0) | (c1<<1) | ... (c7<<7) */
+
+/* Predefined constants */
+
+#define wwc_false() ((__mmask8)0)    /* [ 0 0 ... 0 ] */
+#define wwc_true()  ((__mmask8)0xff) /* [ 1 1 ... 1 ] */
+
+/* Logical operations */
+
+#define wwc_not(a)      ((__mmask8)~(a))          /* [  ~a0     ~a1    ...  ~a7    ] */
+#define wwc_and(a,b)    ((__mmask8)((a)&(b)))     /* [   a0& b0  a1& b1 ...  a7& b7 ] */
+#define wwc_andnot(a,b) ((__mmask8)((~(a))&(b)))  /* [ (~a0)&b0 (~a1)&b1 ... (~a7)&b7 ] */
+#define wwc_or(a,b)     ((__mmask8)((a)|(b)))     /* [   a0| b0  a1| b1 ...  a7| b7 ] */
+#define wwc_xor(a,b)    ((__mmask8)((a)^(b)))     /* [   a0^ b0  a1^ b1 ...  a7^ b7 ] */
+
+/* Reduction operations */
+
+#define wwc_any(c) (!!(c))       /* (c0 | c1 | ... c7) */
+#define wwc_all(c) ((c)==0xff)   /* (c0 & c1 & ... c7) */
+
+/* Misc operations */
+
+#define wwc_extract(c,n) ((int)(((uint)(c)>>(n)) & 1U)) /* c(n) */
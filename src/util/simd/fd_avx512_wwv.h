@@ -0,0 +1,145 @@
+#ifndef HEADER_fd_src_util_simd_fd_avx512_h
+#error "Do not include this directly; use fd_avx512.h"
+#endif
+
+/* Vector ulong API ***************************************************/
+
+/* A wwv_t is a vector where each 64-bit wide lane holds an unsigned
+   64-bit twos-complement integer (a "ulong").
+
+   These mirror the wv_t APIs as much as possible.  Macros are
+   preferred over static inlines when it is possible to do it robustly
+   to reduce the risk of the compiler mucking it up. */
+
+#define wwv_t __m512i
+
+/* Constructors */
+
+/* Given the ulong values, return ... */
+
+#define wwv(v0,v1,v2,v3,v4,v5,v6,v7) /* [ v0 v1 ... v7 ] */ \
+  _mm512_setr_epi64( (long)(v0), (long)(v1), (long)(v2), (long)(v3), (long)(v4), (long)(v5), (long)(v6), (long)(v7) )
+
+#define wwv_bcast(v0) _mm512_set1_epi64( (long)(v0) ) /* [ v0 v0 ... v0 ] */
+
+/* Predefined constants */
+
+#define wwv_zero() _mm512_setzero_si512()  /* Return [ 0UL 0UL ... 0UL ] */
+#define wwv_one()  _mm512_set1_epi64( 1L ) /* Return [ 1UL 1UL ... 1UL ] */
+
+/* Memory operations */
+
+/* wwv_ld return the 8 ulongs at the 64-byte aligned / 64-byte sized
+   location p as a vector ulong.  wwv_ldu is the same but p does not
+   have to be aligned.  wwv_st writes the vector ulong to the 64-byte
+   aligned / 64-byte sized location p as 8 ulongs.  wwv_stu is the same
+   but p does not have to be aligned.  In all these 64-bit lane l will
+   be at p[l]. */
+
+static inline wwv_t wwv_ld(  ulong const * p    ) { return _mm512_load_epi64(  p ); }
+static inline wwv_t wwv_ldu( ulong const * p    ) { return _mm512_loadu_epi64( p ); }
+static inline void  wwv_st(  ulong * p, wwv_t i ) { _mm512_store_epi64(  p, i ); }
+static inline void  wwv_stu( ulong * p, wwv_t i ) { _mm512_storeu_epi64( p, i ); }
+
+/* wwv_gather returns [ b[i0] b[i1] ... b[i7] ] where b points to an
+   array of ulongs and i is a vector of indices into it.  Each lane is
+   loaded independently such that the loads of all lanes are in flight
+   at the same time. */
+
+#define wwv_gather(b,i) _mm512_i64gather_epi64( (i), (b), 8 )
+
+/* Arithmetic operations */
+
+#define wwv_add(a,b) _mm512_add_epi64( (a), (b) ) /* [ a0+b0 a1+b1 ... a7+b7 ] */
+#define wwv_sub(a,b) _mm512_sub_epi64( (a), (b) ) /* [ a0-b0 a1-b1 ... a7-b7 ] */
+
+/* Binary operations */
+
+/* Note: wwv_shl/wwv_shr/wwv_rol/wwv_ror are a left/right shift/rotate
+   by imm bits; imm should be a compile time constant in 0:63. */
+
+#define wwv_not(a) _mm512_xor_epi64( _mm512_set1_epi64( -1L ), (a) ) /* [ ~a0 ~a1 ... ~a7 ] */
+
+#define wwv_shl(a,imm) _mm512_slli_epi64( (a), (uint)(imm) ) /* [ a0<<imm a1<<imm ... a7<<imm ] */
+#define wwv_shr(a,imm) _mm512_srli_epi64( (a), (uint)(imm) ) /* [ a0>>imm a1>>imm ... a7>>imm ] */
+#define wwv_rol(a,imm) _mm512_rol_epi64(  (a), (imm)       ) /* [ rotate_left ( a0, imm ) ... ] */
+#define wwv_ror(a,imm) _mm512_ror_epi64(  (a), (imm)       ) /* [ rotate_right( a0, imm ) ... ] */
+
+#define wwv_and(a,b)    _mm512_and_epi64(    (a), (b) ) /* [   a0 &b0    a1& b1 ...   a7& b7 ] */
+#define wwv_andnot(a,b) _mm512_andnot_epi64( (a), (b) ) /* [ (~a0)&b0  (~a1)&b1 ... (~a7)&b7 ] */
+#define wwv_or(a,b)     _mm512_or_epi64(     (a), (b) ) /* [   a0 |b0    a1 |b1 ...   a7 |b7 ] */
+#define wwv_xor(a,b)    _mm512_xor_epi64(    (a), (b) ) /* [   a0 ^b0    a1 ^b1 ...   a7 ^b7 ] */
+
+/* wwv_bswap returns the vector ulong with the bytes of each lane
+   reversed. */
+
+#define wwv_bswap(a) _mm512_shuffle_epi8( (a), _mm512_set_epi8(                                          \
+    56,57,58,59,60,61,62,63, 48,49,50,51,52,53,54,55, 40,41,42,43,44,45,46,47, 32,33,34,35,36,37,38,39, \
+    24,25,26,27,28,29,30,31, 16,17,18,19,20,21,22,23,  8, 9,10,11,12,13,14,15,  0, 1, 2, 3, 4, 5, 6, 7 ) )
+
+/* Logical operations (these return a lane mask) */
+
+#define wwv_eq(a,b) _mm512_cmpeq_epu64_mask(  (a), (b) ) /* [ a0==b0 a1==b1 ... a7==b7 ] */
+#define wwv_ne(a,b) _mm512_cmpneq_epu64_mask( (a), (b) ) /* [ a0!=b0 a1!=b1 ... a7!=b7 ] */
+#define wwv_lt(a,b) _mm512_cmplt_epu64_mask(  (a), (b) ) /* [ a0< b0 a1< b1 ... a7< b7 ] */
+#define wwv_gt(a,b) _mm512_cmpgt_epu64_mask(  (a), (b) ) /* [ a0> b0 a1> b1 ... a7> b7 ] */
+
+/* Conditional operations */
+
+#define wwv_czero(c,f)    _mm512_maskz_mov_epi64( wwc_not( c ), (f) )  /* [ c0?0UL:f0 c1?0UL:f1 ... c7?0UL:f7 ] */
+#define wwv_notczero(c,f) _mm512_maskz_mov_epi64( (c), (f) )           /* [ c0?f0:0UL c1?f1:0UL ... c7?f7:0UL ] */
+
+#define wwv_if(c,t,f) _mm512_mask_blend_epi64( (c), (f), (t) ) /* [ c0?t0:f0 c1?t1:f1 ... c7?t7:f7 ] */
+
+/* wwv_add_if returns [ c0?(a0+b0):f0 ... c7?(a7+b7):f7 ] and
+   wwv_sub_if returns [ c0?(a0-b0):f0 ... c7?(a7-b7):f7 ]. */
+
+#define wwv_add_if(c,a,b,f) _mm512_mask_add_epi64( (f), (c), (a), (b) )
+#define wwv_sub_if(c,a,b,f) _mm512_mask_sub_epi64( (f), (c), (a), (b) )
+
+/* Conversion operations */
+
+/* wwv_to_wwc returns [ !!v0 !!v1 ... !!v7 ] as a lane mask */
+
+#define wwv_to_wwc(a) _mm512_test_epi64_mask( (a), (a) )
+
+/* Misc operations */
+
+/* wwv_transpose_8x8 transposes the 8x8 matrix stored in wwv_t r0,...,r7
+   and stores the result in 8x8 matrix wwv_t c0,...,c7.  In-place
+   operation and/or using the same wwv_t to specify multiple rows of r
+   is fine. */
+
+#define wwv_transpose_8x8( r0,r1,r2,r3,r4,r5,r6,r7, c0,c1,c2,c3,c4,c5,c6,c7 ) do {                                       \
+    wwv_t _wwv_transpose_r0 = (r0); wwv_t _wwv_transpose_r1 = (r1);                                                     \
+    wwv_t _wwv_transpose_r2 = (r2); wwv_t _wwv_transpose_r3 = (r3);                                                     \
+    wwv_t _wwv_transpose_r4 = (r4); wwv_t _wwv_transpose_r5 = (r5);                                                     \
+    wwv_t _wwv_transpose_r6 = (r6); wwv_t _wwv_transpose_r7 = (r7);                                                     \
+    /* Transpose 1x1 blocks */                                                                                          \
+    wwv_t _wwv_transpose_t0 = _mm512_unpacklo_epi64( _wwv_transpose_r0, _wwv_transpose_r1 );                            \
+    wwv_t _wwv_transpose_t1 = _mm512_unpackhi_epi64( _wwv_transpose_r0, _wwv_transpose_r1 );                            \
+    wwv_t _wwv_transpose_t2 = _mm512_unpacklo_epi64( _wwv_transpose_r2, _wwv_transpose_r3 );                            \
+    wwv_t _wwv_transpose_t3 = _mm512_unpackhi_epi64( _wwv_transpose_r2, _wwv_transpose_r3 );                            \
+    wwv_t _wwv_transpose_t4 = _mm512_unpacklo_epi64( _wwv_transpose_r4, _wwv_transpose_r5 );                            \
+    wwv_t _wwv_transpose_t5 = _mm512_unpackhi_epi64( _wwv_transpose_r4, _wwv_transpose_r5 );                            \
+    wwv_t _wwv_transpose_t6 = _mm512_unpacklo_epi64( _wwv_transpose_r6, _wwv_transpose_r7 );                            \
+    wwv_t _wwv_transpose_t7 = _mm512_unpackhi_epi64( _wwv_transpose_r6, _wwv_transpose_r7 );                            \
+    /* Transpose 2x2 blocks */                                                                                          \
+    wwv_t _wwv_transpose_u0 = _mm512_shuffle_i64x2( _wwv_transpose_t0, _wwv_transpose_t2, 0x88 );                       \
+    wwv_t _wwv_transpose_u1 = _mm512_shuffle_i64x2( _wwv_transpose_t0, _wwv_transpose_t2, 0xdd );                       \
+    wwv_t _wwv_transpose_u2 = _mm512_shuffle_i64x2( _wwv_transpose_t1, _wwv_transpose_t3, 0x88 );                       \
+    wwv_t _wwv_transpose_u3 = _mm512_shuffle_i64x2( _wwv_transpose_t1, _wwv_transpose_t3, 0xdd );                       \
+    wwv_t _wwv_transpose_u4 = _mm512_shuffle_i64x2( _wwv_transpose_t4, _wwv_transpose_t6, 0x88 );                       \
+    wwv_t _wwv_transpose_u5 = _mm512_shuffle_i64x2( _wwv_transpose_t4, _wwv_transpose_t6, 0xdd );                       \
+    wwv_t _wwv_transpose_u6 = _mm512_shuffle_i64x2( _wwv_transpose_t5, _wwv_transpose_t7, 0x88 );                       \
+    wwv_t _wwv_transpose_u7 = _mm512_shuffle_i64x2( _wwv_transpose_t5, _wwv_transpose_t7, 0xdd );                       \
+    /* Transpose 4x4 blocks */                                                                                          \
+    (c0) = _mm512_shuffle_i64x2( _wwv_transpose_u0, _wwv_transpose_u4, 0x88 );                                          \
+    (c1) = _mm512_shuffle_i64x2( _wwv_transpose_u2, _wwv_transpose_u6, 0x88 );                                          \
+    (c2) = _mm512_shuffle_i64x2( _wwv_transpose_u1, _wwv_transpose_u5, 0x88 );                                          \
+    (c3) = _mm512_shuffle_i64x2( _wwv_transpose_u3, _wwv_transpose_u7, 0x88 );                                          \
+    (c4) = _mm512_shuffle_i64x2( _wwv_transpose_u0, _wwv_transpose_u4, 0xdd );                                          \
+    (c5) = _mm512_shuffle_i64x2( _wwv_transpose_u2, _wwv_transpose_u6, 0xdd );                                          \
+    (c6) = _mm512_shuffle_i64x2( _wwv_transpose_u1, _wwv_transpose_u5, 0xdd );                                          \
+    (c7) = _mm512_shuffle_i64x2( _wwv_transpose_u3, _wwv_transpose_u7, 0xdd );                                          \
+  } while(0)
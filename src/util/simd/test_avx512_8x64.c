@@ -0,0 +1,127 @@
+#include "../fd_util.h"
+
+#if FD_HAS_AVX512
+
+#include "fd_avx512.h"
+
+static int
+wwv_test( wwv_t v,
+          ulong v0, ulong v1, ulong v2, ulong v3, ulong v4, ulong v5, ulong v6, ulong v7 ) {
+  ulong m[25] WW_ATTR;
+  wwv_st ( m,    v );
+  wwv_stu( m+ 9, v );
+  ulong e[8] = { v0, v1, v2, v3, v4, v5, v6, v7 };
+  for( ulong i=0UL; i<8UL; i++ ) if( (m[i]!=e[i]) | (m[9UL+i]!=e[i]) ) return 0;
+  if( !wwc_all( wwv_eq( wwv_ld ( m    ), v ) ) ) return 0;
+  if( !wwc_all( wwv_eq( wwv_ldu( m+ 9 ), v ) ) ) return 0;
+  return 1;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+# define crand() (!(fd_rng_uint( rng ) & 1U))
+# define vrand() ((ulong)(fd_rng_uint( rng ) % 7U)-3UL) /* [2^64-3,2^64-2,2^64-1,0,1,2,3] */
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( wwv_test( wwv_zero(), 0UL, 0UL, 0UL, 0UL, 0UL, 0UL, 0UL, 0UL ) );
+  FD_TEST( wwv_test( wwv_one(),  1UL, 1UL, 1UL, 1UL, 1UL, 1UL, 1UL, 1UL ) );
+
+  for( int i=0; i<65536; i++ ) {
+    ulong x[8]; for( ulong l=0UL; l<8UL; l++ ) x[l] = fd_rng_uint( rng ) & 1U ? fd_rng_ulong( rng ) : vrand();
+    ulong y[8]; for( ulong l=0UL; l<8UL; l++ ) y[l] = fd_rng_uint( rng ) & 1U ? fd_rng_ulong( rng ) : vrand();
+    int   c[8]; for( ulong l=0UL; l<8UL; l++ ) c[l] = crand();
+    int   b = 0; for( ulong l=0UL; l<8UL; l++ ) b |= c[l]<<l;
+
+    wwv_t vx = wwv( x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7] );
+    wwv_t vy = wwv( y[0], y[1], y[2], y[3], y[4], y[5], y[6], y[7] );
+    wwc_t vc = wwc_unpack( b );
+
+    FD_TEST( wwc_pack( vc )==b );
+    for( ulong l=0UL; l<8UL; l++ ) FD_TEST( wwc_extract( vc, l )==c[l] );
+
+#   define EXPECT(expr,op) do {                                         \
+      ulong _e[8]; for( ulong l=0UL; l<8UL; l++ ) _e[l] = (op);         \
+      FD_TEST( wwv_test( (expr), _e[0], _e[1], _e[2], _e[3],            \
+                                 _e[4], _e[5], _e[6], _e[7] ) );        \
+    } while(0)
+
+    EXPECT( vx,                        x[l]                                 );
+    EXPECT( wwv_bcast( x[0] ),         x[0]                                 );
+    EXPECT( wwv_add( vx, vy ),         x[l]+y[l]                            );
+    EXPECT( wwv_sub( vx, vy ),         x[l]-y[l]                            );
+    EXPECT( wwv_not( vx ),             ~x[l]                                );
+    EXPECT( wwv_and( vx, vy ),         x[l]&y[l]                            );
+    EXPECT( wwv_andnot( vx, vy ),      (~x[l])&y[l]                         );
+    EXPECT( wwv_or( vx, vy ),          x[l]|y[l]                            );
+    EXPECT( wwv_xor( vx, vy ),         x[l]^y[l]                            );
+    EXPECT( wwv_shl( vx, 13 ),         x[l]<<13                             );
+    EXPECT( wwv_shr( vx, 13 ),         x[l]>>13                             );
+    EXPECT( wwv_rol( vx, 13 ),         fd_ulong_rotate_left ( x[l], 13 )    );
+    EXPECT( wwv_ror( vx, 13 ),         fd_ulong_rotate_right( x[l], 13 )    );
+    EXPECT( wwv_bswap( vx ),           fd_ulong_bswap( x[l] )               );
+    EXPECT( wwv_if( vc, vx, vy ),      c[l] ? x[l] : y[l]                   );
+    EXPECT( wwv_czero( vc, vx ),       c[l] ? 0UL  : x[l]                   );
+    EXPECT( wwv_notczero( vc, vx ),    c[l] ? x[l] : 0UL                    );
+    EXPECT( wwv_add_if( vc, vx, vy, vy ), c[l] ? x[l]+y[l] : y[l]           );
+    EXPECT( wwv_sub_if( vc, vx, vy, vy ), c[l] ? x[l]-y[l] : y[l]           );
+
+#   undef EXPECT
+
+    int eq = 0; int ne = 0; int lt = 0; int gt = 0; int nz = 0;
+    for( ulong l=0UL; l<8UL; l++ ) {
+      eq |= (x[l]==y[l])<<l; ne |= (x[l]!=y[l])<<l; lt |= (x[l]<y[l])<<l; gt |= (x[l]>y[l])<<l; nz |= (!!x[l])<<l;
+    }
+    FD_TEST( wwc_pack( wwv_eq( vx, vy ) )==eq );
+    FD_TEST( wwc_pack( wwv_ne( vx, vy ) )==ne );
+    FD_TEST( wwc_pack( wwv_lt( vx, vy ) )==lt );
+    FD_TEST( wwc_pack( wwv_gt( vx, vy ) )==gt );
+    FD_TEST( wwc_pack( wwv_to_wwc( vx ) )==nz );
+    FD_TEST( wwc_any( vc )==!!b );
+    FD_TEST( wwc_all( vc )==(b==255) );
+
+    /* Gather */
+
+    ulong g[16];
+    for( ulong k=0UL; k<16UL; k++ ) g[k] = fd_rng_ulong( rng );
+    ulong gi[8]; for( ulong l=0UL; l<8UL; l++ ) gi[l] = (ulong)(fd_rng_uint( rng ) & 15U);
+    wwv_t vg = wwv_gather( g, wwv( gi[0], gi[1], gi[2], gi[3], gi[4], gi[5], gi[6], gi[7] ) );
+    FD_TEST( wwv_test( vg, g[gi[0]], g[gi[1]], g[gi[2]], g[gi[3]], g[gi[4]], g[gi[5]], g[gi[6]], g[gi[7]] ) );
+
+    /* Transpose */
+
+    ulong m[64] WW_ATTR;
+    for( ulong k=0UL; k<64UL; k++ ) m[k] = fd_rng_ulong( rng );
+    wwv_t r0 = wwv_ld( m    ); wwv_t r1 = wwv_ld( m+ 8 ); wwv_t r2 = wwv_ld( m+16 ); wwv_t r3 = wwv_ld( m+24 );
+    wwv_t r4 = wwv_ld( m+32 ); wwv_t r5 = wwv_ld( m+40 ); wwv_t r6 = wwv_ld( m+48 ); wwv_t r7 = wwv_ld( m+56 );
+    wwv_transpose_8x8( r0,r1,r2,r3,r4,r5,r6,r7, r0,r1,r2,r3,r4,r5,r6,r7 );
+    wwv_t r[8] = { r0, r1, r2, r3, r4, r5, r6, r7 };
+    for( ulong k=0UL; k<8UL; k++ )
+      FD_TEST( wwv_test( r[k], m[k], m[8UL+k], m[16UL+k], m[24UL+k], m[32UL+k], m[40UL+k], m[48UL+k], m[56UL+k] ) );
+  }
+
+# undef vrand
+# undef crand
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_AVX512 capability" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
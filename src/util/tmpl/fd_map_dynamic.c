@@ -453,6 +453,7 @@ MAP_(clear)( MAP_T * map ) {
   MAP_T * slot = hdr->slot;
   for( ulong slot_idx=0UL; slot_idx<slot_cnt; slot_idx++ ) 
     slot[ slot_idx ].MAP_KEY = (MAP_KEY_NULL);
+  hdr->key_cnt = 0UL;
 }
 
 FD_FN_PURE FD_FN_UNUSED static MAP_T * /* Work around -Winline */
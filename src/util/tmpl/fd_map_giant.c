@@ -683,6 +683,7 @@ MAP_(insert)( MAP_T *           join,
   ulong * head = MAP_(private_list)( map ) + MAP_(private_list_idx)( key, map->seed, map->list_cnt );
   MAP_(key_copy)( &ele->MAP_KEY, key );
   ele->MAP_NEXT = MAP_(private_box_next)( MAP_(private_unbox_idx)( *head ), 0 );
+  FD_COMPILER_MFENCE(); /* Key and next are set before ele is reachable */
   *head = MAP_(private_box_next)( ele_idx, 0 );
 
   return ele;